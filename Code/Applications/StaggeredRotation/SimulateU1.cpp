@@ -98,6 +98,8 @@ INT SimulateStaggeredRotationU1(CParameters& params)
         sLatticeDecomp.AddItem(appIntToString(latticeDecomp[3]));
         params.SetStringVectorVaule(_T("LatticeLength"), sLatticeDecomp);
 
+        //Each Nt is a new lattice context, the device, the log and the tuner stay alive
+        appReleaseLatticeContext(appGetLatticeContext());
         if (!appInitialCLG(params))
         {
             appCrucial(_T("Initial Failed!\n"));
@@ -283,9 +285,8 @@ INT SimulateStaggeredRotationU1(CParameters& params)
         appSetLogDate(TRUE);
 
         appGeneral(_T("\n=====================================\n========= Nt=%d finished! ==========\n"), uiNt);
-        appQuitCLG();
-
     }
 
+    appQuitCLG();
     return 0;
 }
@@ -11,6 +11,30 @@
 
 enum { kExportDigital = 20, };
 
+//The csv files written, for CMeasurementFarm
+static TArray<CCString> _lstWrittenCSV;
+static TArray<CCString> _lstSharedCSV;
+
+void RecordCSV(const CCString& sFileName)
+{
+    if (INDEX_NONE == _lstWrittenCSV.FindItemIndex(sFileName) && INDEX_NONE == _lstSharedCSV.FindItemIndex(sFileName))
+    {
+        _lstWrittenCSV.AddItem(sFileName);
+    }
+}
+
+/**
+* The file is the same for all configurations
+*/
+void MarkSharedCSV(const CCString& sFileName)
+{
+    _lstWrittenCSV.RemoveItem(sFileName);
+    if (INDEX_NONE == _lstSharedCSV.FindItemIndex(sFileName))
+    {
+        _lstSharedCSV.AddItem(sFileName);
+    }
+}
+
 #if !_CLG_WIN
 
 void _gcvt_s(TCHAR* buff, UINT uiBuffLength, Real fVaule, UINT uiDigit)
@@ -24,11 +48,13 @@ void _gcvt_s(TCHAR* buff, UINT uiBuffLength, Real fVaule, UINT uiDigit)
 
 void WriteStringFile(const CCString& sFileName, const CCString& sContent)
 {
+    RecordCSV(sFileName);
     appGetFileSystem()->WriteAllText(sFileName, sContent);
 }
 
 void WriteStringFileRealArray(const CCString& sFileName, const TArray<Real>& lst, UBOOL bAppend = FALSE)
 {
+    RecordCSV(sFileName);
     const INT iDigital = static_cast<INT>(kExportDigital);
     std::ofstream file;
     if (!bAppend)
@@ -58,6 +84,7 @@ void WriteStringFileRealArray(const CCString& sFileName, const TArray<Real>& lst
 
 void WriteStringFileDoubleColumn(const CCString& sFileName, const TArray<Real>& lst1, const TArray<CLGComplex>& lst2, UBOOL bAppend = FALSE)
 {
+    RecordCSV(sFileName);
     const INT iDigital = static_cast<INT>(kExportDigital);
     std::ofstream file;
     if (!bAppend)
@@ -105,6 +132,7 @@ void WriteStringFileDoubleColumn(const CCString& sFileName, const TArray<Real>&
 
 void WriteStringFileRealArray2(const CCString& sFileName, const TArray<TArray<Real>>& lst, UBOOL bAppend = FALSE)
 {
+    RecordCSV(sFileName);
     const INT iDigital = static_cast<INT>(kExportDigital);
     std::ofstream file;
     if (!bAppend)
@@ -138,6 +166,7 @@ void WriteStringFileRealArray2(const CCString& sFileName, const TArray<TArray<Re
 
 void WriteStringFileComplexArray(const CCString& sFileName, const TArray<CLGComplex>& lst, UBOOL bAppend = FALSE)
 {
+    RecordCSV(sFileName);
     const INT iDigital = static_cast<INT>(kExportDigital);
     std::ofstream file;
     if (!bAppend)
@@ -183,6 +212,7 @@ void WriteStringFileComplexArray(const CCString& sFileName, const TArray<CLGComp
 
 void WriteStringFileComplexArray2(const CCString& sFileName, const TArray<TArray<CLGComplex>>& lst, UBOOL bAppend = FALSE)
 {
+    RecordCSV(sFileName);
     const INT iDigital = static_cast<INT>(kExportDigital);
     std::ofstream file;
     if (!bAppend)
@@ -233,6 +263,7 @@ void WriteStringFileComplexArray2(const CCString& sFileName, const TArray<TArray
 #if !_CLG_DOUBLEFLOAT
 void WriteStringFileRealArray(const CCString& sFileName, const TArray<DOUBLE>& lst, UBOOL bAppend = FALSE)
 {
+    RecordCSV(sFileName);
     const INT iDigital = static_cast<INT>(kExportDigital);
     std::ofstream file;
     if (!bAppend)
@@ -262,6 +293,7 @@ void WriteStringFileRealArray(const CCString& sFileName, const TArray<DOUBLE>& l
 
 void WriteStringFileDoubleColumn(const CCString& sFileName, const TArray<DOUBLE>& lst1, const TArray<cuDoubleComplex>& lst2, UBOOL bAppend = FALSE)
 {
+    RecordCSV(sFileName);
     const INT iDigital = static_cast<INT>(kExportDigital);
     std::ofstream file;
     if (!bAppend)
@@ -309,6 +341,7 @@ void WriteStringFileDoubleColumn(const CCString& sFileName, const TArray<DOUBLE>
 
 void WriteStringFileRealArray2(const CCString& sFileName, const TArray<TArray<DOUBLE>>& lst, UBOOL bAppend = FALSE)
 {
+    RecordCSV(sFileName);
     const INT iDigital = static_cast<INT>(kExportDigital);
     std::ofstream file;
     if (!bAppend)
@@ -342,6 +375,7 @@ void WriteStringFileRealArray2(const CCString& sFileName, const TArray<TArray<DO
 
 void WriteStringFileComplexArray(const CCString& sFileName, const TArray<cuDoubleComplex>& lst, UBOOL bAppend = FALSE)
 {
+    RecordCSV(sFileName);
     const INT iDigital = static_cast<INT>(kExportDigital);
     std::ofstream file;
     if (!bAppend)
@@ -387,6 +421,7 @@ void WriteStringFileComplexArray(const CCString& sFileName, const TArray<cuDoubl
 
 void WriteStringFileComplexArray2(const CCString& sFileName, const TArray<TArray<cuDoubleComplex>>& lst, UBOOL bAppend = FALSE)
 {
+    RecordCSV(sFileName);
     const INT iDigital = static_cast<INT>(kExportDigital);
     std::ofstream file;
     if (!bAppend)
@@ -469,71 +504,11 @@ WriteStringFileComplexArray2(sFileNameWrite##measureName##lstName, lstName##meas
 WriteStringFileComplexArray(sFileNameWrite##measureName##lstName##All, lstName##measureName##All); \
 WriteStringFileComplexArray(sFileNameWrite##measureName##lstName##In, lstName##measureName##In); 
 
-INT Measurement(CParameters& params)
+void MeasureConfigurations(EStaggeredSpectrumMeasure eJob, UINT iStartN, UINT iEndN,
+    UBOOL bDoSmearing, UBOOL bLoadDouble, UBOOL bZ4, UINT iFieldCount,
+    const CCString& sSavePrefix, const CCString& sCSVSavePrefix, CFieldGaugeSU3* pStaple)
 {
-
-#pragma region read parameters
-
-    appSetupLog(params);
-
-    INT iVaule = 1;
-    params.FetchValueINT(_T("StartN"), iVaule);
-    UINT iStartN = static_cast<UINT>(iVaule);
-
-    iVaule = 200;
-    params.FetchValueINT(_T("EndN"), iVaule);
-    UINT iEndN = static_cast<UINT>(iVaule);
-
-    iVaule = 1;
-    params.FetchValueINT(_T("DoSmearing"), iVaule);
-    UBOOL bDoSmearing = (0 != iVaule);
-
-    iVaule = 0;
-    params.FetchValueINT(_T("LoadDouble"), iVaule);
-    UBOOL bLoadDouble = (0 != iVaule);
-
-    iVaule = 0;
-    params.FetchValueINT(_T("UseZ4"), iVaule);
-    UBOOL bZ4 = 0 != iVaule;
-
-    iVaule = 10;
-    params.FetchValueINT(_T("StochasticFieldCount"), iVaule);
-    UINT iFieldCount = static_cast<UINT>(iVaule);
-
-    //iVaule = 1;
-    //params.FetchValueINT(_T("CheckGaugeFixing"), iVaule);
-    //UBOOL bCheckGaugeFixing = 0 != iVaule;
-
-    //iVaule = 0;
-    //params.FetchValueINT(_T("UseZ4"), iVaule);
-    //UBOOL bZ4 = 0 != iVaule;
-
-    CCString sValue = _T("ESSM_Polyakov");
-    params.FetchStringValue(_T("MeasureType"), sValue);
-    EStaggeredSpectrumMeasure eJob = __STRING_TO_ENUM(EStaggeredSpectrumMeasure, sValue);
-
-    CCString sSavePrefix;
-    params.FetchStringValue(_T("SavePrefix"), sSavePrefix);
-    appGeneral(_T("save prefix: %s\n"), sSavePrefix.c_str());
-
-    CCString sCSVSavePrefix;
-    params.FetchStringValue(_T("CSVSavePrefix"), sCSVSavePrefix);
-    appGeneral(_T("csv save prefix: %s\n"), sCSVSavePrefix.c_str());
-
-    CCString sSubFolderPrefix;
-    params.FetchStringValue(_T("SubFolderPrefix"), sSubFolderPrefix);
-    appGeneral(_T("sub folder prefix: %s\n"), sSubFolderPrefix.c_str());
-
-    if (!appInitialCLG(params))
-    {
-        appCrucial(_T("Initial Failed!\n"));
-        return 1;
-    }
-
-#pragma endregion
-
-    const UINT uiNewLine = (iEndN - iStartN + 1) / 5;
-    CFieldGaugeSU3* pStaple = dynamic_cast<CFieldGaugeSU3*>(appGetLattice()->m_pGaugeField->GetCopy());
+    const UINT uiNewLine = (iEndN - iStartN + 1) >= 5 ? (iEndN - iStartN + 1) / 5 : 1;
     CMeasureWilsonLoop* pPL = dynamic_cast<CMeasureWilsonLoop*>(appGetLattice()->m_pMeasurements->GetMeasureById(1));
     CMeasurePolyakovXY* pPXY = dynamic_cast<CMeasurePolyakovXY*>(appGetLattice()->m_pMeasurements->GetMeasureById(6));
     CMeasureMesonCorrelatorStaggered* pMC = dynamic_cast<CMeasureMesonCorrelatorStaggered*>(appGetLattice()->m_pMeasurements->GetMeasureById(2));
@@ -598,6 +573,7 @@ INT Measurement(CParameters& params)
                 CCString sRadiousFile;
                 sRadiousFile.Format(_T("%s_VR_R.csv"), sCSVSavePrefix.c_str());
                 WriteStringFileRealArray(sRadiousFile, lstRadius);
+                MarkSharedCSV(sRadiousFile);
             }
         }
         break;
@@ -732,6 +708,7 @@ INT Measurement(CParameters& params)
                 CCString sRadiousFile;
                 sRadiousFile.Format(_T("%s_VR_R.csv"), sCSVSavePrefix.c_str());
                 WriteStringFileRealArray(sRadiousFile, lstRadius);
+                MarkSharedCSV(sRadiousFile);
             }
         }
         break;
@@ -963,6 +940,104 @@ INT Measurement(CParameters& params)
     default:
         break;
     }
+}
+
+INT Measurement(CParameters& params)
+{
+
+#pragma region read parameters
+
+    appSetupLog(params);
+
+    INT iVaule = 1;
+    params.FetchValueINT(_T("StartN"), iVaule);
+    UINT iStartN = static_cast<UINT>(iVaule);
+
+    iVaule = 200;
+    params.FetchValueINT(_T("EndN"), iVaule);
+    UINT iEndN = static_cast<UINT>(iVaule);
+
+    iVaule = 1;
+    params.FetchValueINT(_T("DoSmearing"), iVaule);
+    UBOOL bDoSmearing = (0 != iVaule);
+
+    iVaule = 0;
+    params.FetchValueINT(_T("LoadDouble"), iVaule);
+    UBOOL bLoadDouble = (0 != iVaule);
+
+    iVaule = 0;
+    params.FetchValueINT(_T("UseZ4"), iVaule);
+    UBOOL bZ4 = 0 != iVaule;
+
+    iVaule = 10;
+    params.FetchValueINT(_T("StochasticFieldCount"), iVaule);
+    UINT iFieldCount = static_cast<UINT>(iVaule);
+
+    //iVaule = 1;
+    //params.FetchValueINT(_T("CheckGaugeFixing"), iVaule);
+    //UBOOL bCheckGaugeFixing = 0 != iVaule;
+
+    //iVaule = 0;
+    //params.FetchValueINT(_T("UseZ4"), iVaule);
+    //UBOOL bZ4 = 0 != iVaule;
+
+    CCString sValue = _T("ESSM_Polyakov");
+    params.FetchStringValue(_T("MeasureType"), sValue);
+    EStaggeredSpectrumMeasure eJob = __STRING_TO_ENUM(EStaggeredSpectrumMeasure, sValue);
+
+    CCString sSavePrefix;
+    params.FetchStringValue(_T("SavePrefix"), sSavePrefix);
+    appGeneral(_T("save prefix: %s\n"), sSavePrefix.c_str());
+
+    CCString sCSVSavePrefix;
+    params.FetchStringValue(_T("CSVSavePrefix"), sCSVSavePrefix);
+    appGeneral(_T("csv save prefix: %s\n"), sCSVSavePrefix.c_str());
+
+    CCString sSubFolderPrefix;
+    params.FetchStringValue(_T("SubFolderPrefix"), sSubFolderPrefix);
+    appGeneral(_T("sub folder prefix: %s\n"), sSubFolderPrefix.c_str());
+
+    if (!appInitialCLG(params))
+    {
+        appCrucial(_T("Initial Failed!\n"));
+        return 1;
+    }
+
+#pragma endregion
+
+    CFieldGaugeSU3* pStaple = dynamic_cast<CFieldGaugeSU3*>(appGetLattice()->m_pGaugeField->GetCopy());
+
+    if (params.Exist(_T("Farm")))
+    {
+        //Several workers measure StartN...EndN, worker 0 merges the results
+        CParameters farmParam = params.GetParameter(_T("Farm"));
+        CMeasurementFarm farm;
+        farm.Initial(farmParam, iStartN, iEndN);
+        UINT uiN = 0;
+        while (farm.ClaimNext(uiN))
+        {
+            _lstWrittenCSV.RemoveAll();
+            _lstSharedCSV.RemoveAll();
+            MeasureConfigurations(eJob, uiN, uiN, bDoSmearing, bLoadDouble, bZ4, iFieldCount, sSavePrefix, farm.GetPartPrefix(uiN), pStaple);
+            farm.Finish(uiN, _lstWrittenCSV, _lstSharedCSV);
+        }
+
+        iVaule = 1;
+        farmParam.FetchValueINT(_T("Merge"), iVaule);
+        if (0 != iVaule && farm.IsMerger())
+        {
+            iVaule = 86400;
+            farmParam.FetchValueINT(_T("MergeTimeOut"), iVaule);
+            if (farm.WaitAll(static_cast<UINT>(iVaule)))
+            {
+                farm.Merge(sCSVSavePrefix);
+            }
+        }
+    }
+    else
+    {
+        MeasureConfigurations(eJob, iStartN, iEndN, bDoSmearing, bLoadDouble, bZ4, iFieldCount, sSavePrefix, sCSVSavePrefix, pStaple);
+    }
 
     appGeneral(_T("\n"));
 
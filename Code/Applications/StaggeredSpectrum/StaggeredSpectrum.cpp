@@ -36,6 +36,11 @@ int main(int argc, char * argv[])
     case ESSJ_Measure:
     {
         CParameters workingParam2 = params.GetParameter(_T("JobMeasure"));
+        if (argc > 1 && workingParam2.Exist(_T("Farm")))
+        {
+            //"StaggeredSpectrum 3" is the worker 3, so that all workers share one yaml
+            workingParam2.GetParameter(_T("Farm")).SetStringVaule(_T("WorkerId"), CCString(argv[1]));
+        }
         res = Measurement(workingParam2);
     }
     break;
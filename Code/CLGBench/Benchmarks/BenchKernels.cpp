@@ -0,0 +1,295 @@
+//=============================================================================
+// FILENAME : BenchKernels.cpp
+//
+// DESCRIPTION:
+// The benchmarks of the core kernels, the fields not in the lattice are skipped
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#include "CLGBench.h"
+
+#define _BENCH_REAL static_cast<DOUBLE>(sizeof(Real))
+
+/**
+* Per site, D = 1 - kappa Dslash, Dslash = 1320 flops, read 8 links and 8 spinors, write 1 spinor
+* KS D = 2m + Dslash, Dslash = 570 flops, read 8 links and 8 color vectors, write 1 color vector
+* Asqtad, Dslash with the cached fat and Naik links, 16 links and 16 color vectors
+* P4, the fat links (1-link + 6 staples) and the 48 knight move paths are calculated on the fly,
+*   a 3-link path is 2 SU3 products (198 flops) and read 3 links, the 2 kernels write 2 color vectors
+* U1 KS, the links are complex numbers, 8 complex products (6 flops) and 8 sums (2 flops)
+*/
+static void GetFermionModel(const CField* pField, DOUBLE& fFlops, DOUBLE& fBytes)
+{
+    fFlops = 0.0;
+    fBytes = 0.0;
+    if (NULL != dynamic_cast<const CFieldFermionWilsonSquareSU3*>(pField))
+    {
+        fFlops = 1320.0 + 48.0;
+        fBytes = (8.0 * 18.0 + 8.0 * 24.0 + 24.0) * _BENCH_REAL;
+    }
+    else if (NULL != dynamic_cast<const CFieldFermionKSSU3Asqtad*>(pField))
+    {
+        fFlops = 16.0 * (66.0 + 6.0) - 6.0 + 12.0;
+        fBytes = (16.0 * 18.0 + 16.0 * 6.0 + 6.0) * _BENCH_REAL;
+    }
+    else if (NULL != dynamic_cast<const CFieldFermionKSSU3P4*>(pField))
+    {
+        //fat: for each mu, 2 links, each is scaled, add 6 staples, scaled and added, then 2 mat-vec, 2 scale and 2 sum
+        const DOUBLE fFatFlops = 4.0 * (2.0 * (18.0 + 6.0 * (2.0 * 198.0 + 18.0) + 2.0 * 18.0) + 2.0 * (66.0 + 6.0) + 12.0);
+        //knight move: 12 (mu, nu) pairs, 8 paths for each, each is 2 SU3 products, 1 mat-vec and 1 sum
+        const DOUBLE fKnightFlops = 12.0 * 8.0 * (2.0 * 198.0 + 66.0 + 6.0);
+        fFlops = fFatFlops + fKnightFlops + 24.0;
+        fBytes = (4.0 * (2.0 + 12.0 * 3.0) * 18.0 + 96.0 * 3.0 * 18.0 + (8.0 + 96.0 + 4.0) * 6.0) * _BENCH_REAL;
+    }
+    else if (NULL != dynamic_cast<const CFieldFermionKSU1*>(pField))
+    {
+        fFlops = 8.0 * (6.0 + 2.0) - 2.0 + 4.0;
+        fBytes = (8.0 * 2.0 + 8.0 * 2.0 + 2.0) * _BENCH_REAL;
+    }
+    else if (NULL != dynamic_cast<const CFieldFermionKSSU3*>(pField))
+    {
+        fFlops = 570.0 + 12.0;
+        fBytes = (8.0 * 18.0 + 8.0 * 6.0 + 6.0) * _BENCH_REAL;
+    }
+}
+
+/**
+* The number of reals per site
+*/
+static DOUBLE GetFermionReals(const CField* pField)
+{
+    if (NULL != dynamic_cast<const CFieldFermionWilsonSquareSU3*>(pField))
+    {
+        return 24.0;
+    }
+    if (NULL != dynamic_cast<const CFieldFermionKSSU3*>(pField))
+    {
+        return 6.0;
+    }
+    if (NULL != dynamic_cast<const CFieldFermionKSU1*>(pField))
+    {
+        return 2.0;
+    }
+    return 0.0;
+}
+
+static TArray<CFieldFermion*> GetAllFermions()
+{
+    TArray<CFieldFermion*> ret;
+    for (BYTE byId = 2; byId < kMaxFieldCount; ++byId)
+    {
+        CFieldFermion* pFermion = dynamic_cast<CFieldFermion*>(appGetLattice()->GetFieldById(byId));
+        if (NULL != pFermion)
+        {
+            ret.AddItem(pFermion);
+        }
+    }
+    return ret;
+}
+
+void BenchDslash(CParameters&, CBenchReport& report)
+{
+    TArray<CFieldFermion*> lstFermions = GetAllFermions();
+    CFieldGauge* pGauge = appGetLattice()->m_pGaugeField;
+    for (INT i = 0; i < lstFermions.Num(); ++i)
+    {
+        DOUBLE fFlops = 0.0;
+        DOUBLE fBytes = 0.0;
+        GetFermionModel(lstFermions[i], fFlops, fBytes);
+        CFieldFermion* pF = dynamic_cast<CFieldFermion*>(lstFermions[i]->GetCopy());
+        pF->InitialField(EFIT_RandomGaussian);
+        report.Run(CCString(_T("D_")) + pF->GetClass()->GetName(), fFlops, fBytes, [&]() { pF->D(pGauge); });
+        appSafeDelete(pF);
+    }
+}
+
+__REGIST_BENCH(BenchDslash, Dslash);
+
+/**
+* Per link, 6 staples, each is 2 SU3 products (198 flops) and 1 sum (18 flops)
+* read 18 links for the staples of one link without cache
+*/
+void BenchStaple(CParameters&, CBenchReport& report)
+{
+    CFieldGauge* pGauge = appGetLattice()->m_pGaugeField;
+    if (NULL == dynamic_cast<CFieldGaugeSU3*>(pGauge))
+    {
+        return;
+    }
+    const DOUBLE fDir = static_cast<DOUBLE>(_HC_Dir);
+    const DOUBLE fStaples = 2.0 * (fDir - 1.0);
+    const DOUBLE fStapleFlops = fDir * fStaples * (2.0 * 198.0 + 18.0);
+    const DOUBLE fStapleBytes = (fDir * fStaples * 3.0 * 18.0 + fDir * 18.0) * _BENCH_REAL;
+
+    CFieldGauge* pStaple = dynamic_cast<CFieldGauge*>(pGauge->GetCopy());
+    CFieldGauge* pForce = dynamic_cast<CFieldGauge*>(pGauge->GetCopy());
+    report.Run(_T("Staple"), fStapleFlops, fStapleBytes, [&]() { pGauge->CalculateOnlyStaple(pStaple); });
+
+    //force is U * staple (198) and the traceless anti-hermitian part, read U and force, write force and staple
+    pForce->Zero();
+    report.Run(_T("GaugeForce"), fStapleFlops + fDir * (198.0 + 36.0), fStapleBytes + fDir * 3.0 * 18.0 * _BENCH_REAL,
+        [&]() { pGauge->CalculateForceAndStaple(pForce, pStaple, F(0.1)); });
+
+    appSafeDelete(pStaple);
+    appSafeDelete(pForce);
+}
+
+__REGIST_BENCH(BenchStaple, Staple);
+
+/**
+* Per link, exp(aP) U, the product is 198 flops
+* ExpPrecision = N > 0: the Taylor series, 1 scaling (18 flops) and N - 1 times (scaling, product and 3 sums, 219 flops)
+* ExpPrecision = 0: QuickExp, the 3 SU(2) factors and their product, about 200 flops
+* read P and U, write U
+*/
+void BenchExpMult(CParameters&, CBenchReport& report)
+{
+    CFieldGauge* pGauge = appGetLattice()->m_pGaugeField;
+    if (NULL == dynamic_cast<CFieldGaugeSU3*>(pGauge))
+    {
+        return;
+    }
+    CFieldGauge* pMomentum = dynamic_cast<CFieldGauge*>(pGauge->GetCopy());
+    CFieldGauge* pU = dynamic_cast<CFieldGauge*>(pGauge->GetCopy());
+    pMomentum->InitialField(EFIT_RandomGenerator);
+
+    const DOUBLE fPrecision = static_cast<DOUBLE>(_HC_ExpPrecision);
+    const DOUBLE fExpFlops = fPrecision > 0.0 ? (18.0 + 3.0 + (fPrecision - 1.0) * (18.0 + 198.0 + 3.0)) : 200.0;
+    report.Run(_T("ExpMult"), _HC_Dir * (fExpFlops + 198.0), _HC_Dir * 3.0 * 18.0 * _BENCH_REAL, [&]() { pMomentum->ExpMult(F(0.01), pU); });
+
+    appSafeDelete(pMomentum);
+    appSafeDelete(pU);
+}
+
+__REGIST_BENCH(BenchExpMult, ExpMult);
+
+/**
+* y = y + a x: 2 flops per real, read x and y, write y
+* x^+ y: 2 flops per real, read x and y
+*/
+void BenchBLAS(CParameters&, CBenchReport& report)
+{
+    TArray<CFieldFermion*> lstFermions = GetAllFermions();
+    for (INT i = 0; i < lstFermions.Num(); ++i)
+    {
+        const DOUBLE fReals = GetFermionReals(lstFermions[i]);
+        CField* pX = lstFermions[i]->GetCopy();
+        CField* pY = lstFermions[i]->GetCopy();
+        pX->InitialField(EFIT_RandomGaussian);
+        pY->InitialField(EFIT_RandomGaussian);
+        const CCString sClass = pX->GetClass()->GetName();
+
+        report.Run(CCString(_T("Axpy_")) + sClass, 2.0 * fReals, 3.0 * fReals * _BENCH_REAL, [&]() { pY->Axpy(F(0.5), pX); });
+        report.Run(CCString(_T("Dot_")) + sClass, 2.0 * fReals, 2.0 * fReals * _BENCH_REAL, [&]() { pY->Dot(pX); });
+
+        appSafeDelete(pX);
+        appSafeDelete(pY);
+    }
+
+    CFieldGauge* pGauge = appGetLattice()->m_pGaugeField;
+    if (NULL != dynamic_cast<CFieldGaugeSU3*>(pGauge))
+    {
+        const DOUBLE fReals = _HC_Dir * 18.0;
+        CField* pX = pGauge->GetCopy();
+        CField* pY = pGauge->GetCopy();
+        report.Run(_T("Axpy_Gauge"), 2.0 * fReals, 3.0 * fReals * _BENCH_REAL, [&]() { pY->Axpy(F(0.5), pX); });
+        report.Run(_T("Dot_Gauge"), 2.0 * fReals, 2.0 * fReals * _BENCH_REAL, [&]() { pY->Dot(pX); });
+        report.Run(_T("PlaqutteEnergy"), 0.0, 0.0, [&]() { pGauge->CalculatePlaqutteEnergy(F(1.0)); });
+        appSafeDelete(pX);
+        appSafeDelete(pY);
+    }
+}
+
+__REGIST_BENCH(BenchBLAS, BLAS);
+
+/**
+* The time of one inversion of D with each solver in BenchSolvers,
+* the accuracy and the other parameters are the ones of the "Solver" block,
+* the source is copied before each call
+*/
+void BenchSolver(CParameters& params, CBenchReport& report)
+{
+    TArray<CCString> lstSolvers;
+    if (!params.FetchStringVectorValue(_T("BenchSolvers"), lstSolvers))
+    {
+        lstSolvers.AddItem(_T("CSLASolverBiCGStab"));
+        lstSolvers.AddItem(_T("CSLASolverGMRES"));
+        lstSolvers.AddItem(_T("CSLASolverGCR"));
+        lstSolvers.AddItem(_T("CSolverTFQMR"));
+    }
+    CParameters solverParam;
+    if (params.Exist(_T("Solver")))
+    {
+        solverParam = params.GetParameter(_T("Solver"));
+    }
+
+    TArray<CFieldFermion*> lstFermions = GetAllFermions();
+    CFieldGauge* pGauge = appGetLattice()->m_pGaugeField;
+    for (INT i = 0; i < lstFermions.Num(); ++i)
+    {
+        CFieldFermion* pSource = dynamic_cast<CFieldFermion*>(lstFermions[i]->GetCopy());
+        CFieldFermion* pF = dynamic_cast<CFieldFermion*>(lstFermions[i]->GetCopy());
+        pSource->InitialField(EFIT_RandomGaussian);
+        for (INT j = 0; j < lstSolvers.Num(); ++j)
+        {
+            CSLASolver* pSolver = dynamic_cast<CSLASolver*>(appCreate(lstSolvers[j]));
+            if (NULL == pSolver)
+            {
+                appCrucial(_T("CLGBench: %s is not a solver\n"), lstSolvers[j].c_str());
+                continue;
+            }
+            solverParam.SetStringVaule(_T("SolverName"), lstSolvers[j]);
+            pSolver->Configurate(solverParam);
+            pSolver->AllocateBuffers(pF);
+            report.Run(CCString(_T("InverseD_")) + pF->GetClass()->GetName() + _T("_") + lstSolvers[j], 0.0, 0.0,
+                [&]()
+                {
+                    pSolver->Solve(pF, pSource, pGauge, EFO_F_D);
+                });
+            appSafeDelete(pSolver);
+        }
+        appSafeDelete(pSource);
+        appSafeDelete(pF);
+    }
+}
+
+__REGIST_BENCH(BenchSolver, Solver);
+
+void BenchTrajectory(CParameters&, CBenchReport& report)
+{
+    CUpdator* pUpdator = appGetLattice()->m_pUpdator;
+    if (NULL == pUpdator)
+    {
+        return;
+    }
+    report.Run(CCString(_T("Trajectory_")) + pUpdator->GetClass()->GetName(), 0.0, 0.0, [&]() { pUpdator->Update(1, FALSE); });
+}
+
+__REGIST_BENCH(BenchTrajectory, Trajectory);
+
+/**
+* Write and read the gauge field with the CLG binary format
+*/
+void BenchFileIO(CParameters&, CBenchReport& report)
+{
+    CFieldGauge* pGauge = appGetLattice()->m_pGaugeField;
+    if (NULL == dynamic_cast<CFieldGaugeSU3*>(pGauge))
+    {
+        return;
+    }
+    CField* pRead = pGauge->GetCopy();
+    const CCString sFileName = _T("CLGBench_IO.con");
+    const DOUBLE fBytes = _HC_Dir * 18.0 * _BENCH_REAL;
+    report.Run(_T("SaveGauge"), 0.0, fBytes, [&]() { pGauge->SaveToFile(sFileName); });
+    report.Run(_T("LoadGauge"), 0.0, fBytes, [&]() { pRead->InitialFieldWithFile(sFileName, EFFT_CLGBin); });
+    remove(sFileName.c_str());
+    appSafeDelete(pRead);
+}
+
+__REGIST_BENCH(BenchFileIO, FileIO);
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
@@ -0,0 +1,152 @@
+//=============================================================================
+// FILENAME : CLGBench.cpp
+//
+// DESCRIPTION:
+// The non-interactive benchmark, run all benchmarks on all lattices and
+// sizes in CLGBench.yaml, and write the results to a json file
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#include "CLGBench.h"
+
+BenchList* _benchSuits;
+
+UBOOL CBenchReport::WriteJson(const CCString& sFileName) const
+{
+    INT iDevice = 0;
+    cudaDeviceProp deviceProp;
+    checkCudaErrors(cudaGetDevice(&iDevice));
+    checkCudaErrors(cudaGetDeviceProperties(&deviceProp, iDevice));
+
+    CCString sJson;
+    sJson.Format(_T("{\n  \"version\": \"%s\",\n  \"device\": \"%s\",\n  \"precision\": \"%s\",\n  \"warmup\": %d,\n  \"repeat\": %d,\n  \"results\": [\n"),
+        GetCLGVersion().c_str(),
+        deviceProp.name,
+#if _CLG_DOUBLEFLOAT
+        _T("double"),
+#else
+        _T("single"),
+#endif
+        m_uiWarmup,
+        m_uiRepeat);
+
+    for (INT i = 0; i < m_lstResults.Num(); ++i)
+    {
+        const SBenchResult& result = m_lstResults[i];
+        CCString sLine;
+        sLine.Format(_T("    {\"lattice\": \"%s\", \"name\": \"%s\", \"sites\": %d, \"average_ms\": %.6f, \"min_ms\": %.6f, \"flops_per_site\": %.1f, \"bytes_per_site\": %.1f, \"gflops\": %.4f, \"gbs\": %.4f, \"sites_per_s\": %.1f}%s\n"),
+            result.m_sLattice.c_str(),
+            result.m_sName.c_str(),
+            result.m_uiSites,
+            result.m_fAverageMs,
+            result.m_fMinMs,
+            result.m_fFlopsPerSite,
+            result.m_fBytesPerSite,
+            GetGFlops(result),
+            GetGBytes(result),
+            GetSitesPerSecond(result),
+            (i == m_lstResults.Num() - 1) ? _T("") : _T(","));
+        sJson = sJson + sLine;
+    }
+    sJson = sJson + _T("  ]\n}\n");
+    return appGetFileSystem()->WriteAllText(sFileName.c_str(), sJson);
+}
+
+int main(int argc, char * argv[])
+{
+    CParameters params;
+#if _CLG_DEBUG
+    CYAMLParser::ParseFile(_T("CLGBench.yaml"), params);
+#else
+    CYAMLParser::ParseFile(_T("../Debug/CLGBench.yaml"), params);
+#endif
+    appSetupLog(params);
+
+    CBenchReport report;
+    INT iValue = 2;
+    params.FetchValueINT(_T("Warmup"), iValue);
+    report.m_uiWarmup = iValue > 0 ? static_cast<UINT>(iValue) : 0;
+    iValue = 10;
+    params.FetchValueINT(_T("Repeat"), iValue);
+    report.m_uiRepeat = iValue > 0 ? static_cast<UINT>(iValue) : 1;
+
+    CCString sOutput = _T("CLGBench.json");
+    params.FetchStringValue(_T("Output"), sOutput);
+    if (argc > 1)
+    {
+        sOutput = argv[1];
+    }
+
+    TArray<CCString> lstLattices;
+    params.FetchStringVectorValue(_T("Lattices"), lstLattices);
+    TArray<CCString> lstOnly;
+    params.FetchStringVectorValue(_T("Benchmarks"), lstOnly);
+
+    iValue = 0;
+    params.FetchValueINT(_T("SizeCount"), iValue);
+    TArray<TArray<CCString>> lstSizes;
+    for (INT i = 1; i <= iValue; ++i)
+    {
+        CCString sSizeName;
+        sSizeName.Format(_T("Size%d"), i);
+        TArray<CCString> size;
+        if (params.FetchStringVectorValue(sSizeName, size) && 4 == size.Num())
+        {
+            lstSizes.AddItem(size);
+        }
+        else
+        {
+            appCrucial(_T("CLGBench: %s should be [Lx, Ly, Lz, Lt]\n"), sSizeName.c_str());
+        }
+    }
+
+    for (INT i = 0; i < lstLattices.Num(); ++i)
+    {
+        if (!params.Exist(lstLattices[i]))
+        {
+            appCrucial(_T("CLGBench: lattice %s not found\n"), lstLattices[i].c_str());
+            continue;
+        }
+
+        //without sizes, use the LatticeLength of the block
+        const INT iSizeCount = lstSizes.Num() > 0 ? lstSizes.Num() : 1;
+        for (INT j = 0; j < iSizeCount; ++j)
+        {
+            CParameters latticeParam = params.GetParameter(lstLattices[i]);
+            if (lstSizes.Num() > 0)
+            {
+                latticeParam.SetStringVectorVaule(_T("LatticeLength"), lstSizes[j]);
+            }
+            if (!appInitialCLG(latticeParam))
+            {
+                appCrucial(_T("CLGBench: initial %s failed\n"), lstLattices[i].c_str());
+                continue;
+            }
+            report.m_sLattice.Format(_T("%s_%dx%dx%dx%d"), lstLattices[i].c_str(), _HC_Lx, _HC_Ly, _HC_Lz, _HC_Lt);
+
+            for (BenchList* pBench = _benchSuits; NULL != pBench; pBench = pBench->m_pNext)
+            {
+                if (lstOnly.Num() > 0 && INDEX_NONE == lstOnly.FindItemIndex(CCString(pBench->m_sBenchName)))
+                {
+                    continue;
+                }
+                (*pBench->m_pfBench)(latticeParam, report);
+            }
+            appQuitCLG();
+        }
+    }
+
+    if (!report.WriteJson(sOutput))
+    {
+        appCrucial(_T("CLGBench: failed to write %s\n"), sOutput.c_str());
+        return 1;
+    }
+    COUT << _T("CLGBench: ") << report.m_lstResults.Num() << _T(" results written to ") << sOutput.c_str() << std::endl;
+    return 0;
+}
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
@@ -0,0 +1,128 @@
+//=============================================================================
+// FILENAME : CLGBench.h
+//
+// DESCRIPTION:
+// The non-interactive benchmark, see CLGBench.yaml
+//
+// Each benchmark is timed with "Warmup" calls and "Repeat" calls, every call
+// is followed by cudaDeviceSynchronize. The flops and bytes are per site
+// with the usual counting (for example 1320 + 48 flops for Wilson D), the
+// bytes are the minimum traffic without cache, so GB/s is comparable with
+// the bandwidth of the device. 0 means there is no model for the kernel,
+// only sites/s is reported.
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#include "CLGLib.h"
+
+#define __REGIST_BENCH(functionname, benchName) \
+struct SBenchSuits##benchName : public BenchList \
+{ \
+    SBenchSuits##benchName(benchfunction pf) \
+    { \
+        m_pfBench = pf; \
+        m_sBenchName = _T(#benchName); \
+        Link(_benchSuits); \
+    } \
+}; \
+static SBenchSuits##benchName registBench##benchName(functionname);
+
+struct SBenchResult
+{
+    CCString m_sLattice;
+    CCString m_sName;
+    UINT m_uiSites;
+    UINT m_uiRepeat;
+    DOUBLE m_fAverageMs;
+    DOUBLE m_fMinMs;
+    DOUBLE m_fFlopsPerSite;
+    DOUBLE m_fBytesPerSite;
+};
+
+class CBenchReport
+{
+public:
+    CBenchReport() : m_uiWarmup(2), m_uiRepeat(10) {}
+
+    /**
+    * Run pfCall (Warmup + Repeat) times and record the time
+    */
+    template<class Fn>
+    void Run(const CCString& sName, DOUBLE fFlopsPerSite, DOUBLE fBytesPerSite, Fn pfCall)
+    {
+        for (UINT i = 0; i < m_uiWarmup; ++i)
+        {
+            pfCall();
+            checkCudaErrors(cudaDeviceSynchronize());
+        }
+
+        DOUBLE fTotal = 0.0;
+        DOUBLE fMin = -1.0;
+        for (UINT i = 0; i < m_uiRepeat; ++i)
+        {
+            CTimer timer;
+            timer.Start();
+            pfCall();
+            checkCudaErrors(cudaDeviceSynchronize());
+            timer.Stop();
+            const DOUBLE fMs = static_cast<DOUBLE>(timer.Elapsed());
+            fTotal += fMs;
+            fMin = (fMin < 0.0 || fMs < fMin) ? fMs : fMin;
+        }
+
+        SBenchResult result;
+        result.m_sLattice = m_sLattice;
+        result.m_sName = sName;
+        result.m_uiSites = _HC_Volume;
+        result.m_uiRepeat = m_uiRepeat;
+        result.m_fAverageMs = m_uiRepeat > 0 ? fTotal / m_uiRepeat : 0.0;
+        result.m_fMinMs = fMin;
+        result.m_fFlopsPerSite = fFlopsPerSite;
+        result.m_fBytesPerSite = fBytesPerSite;
+        m_lstResults.AddItem(result);
+
+        appGeneral(_T("%s %s: %f ms (min %f ms), %f GFLOP/s, %f GB/s\n"),
+            m_sLattice.c_str(), sName.c_str(), result.m_fAverageMs, fMin,
+            GetGFlops(result), GetGBytes(result));
+    }
+
+    static DOUBLE GetGFlops(const SBenchResult& result)
+    {
+        return result.m_fMinMs > 0.0 ? result.m_fFlopsPerSite * result.m_uiSites / (result.m_fMinMs * 1.0e6) : 0.0;
+    }
+
+    static DOUBLE GetGBytes(const SBenchResult& result)
+    {
+        return result.m_fMinMs > 0.0 ? result.m_fBytesPerSite * result.m_uiSites / (result.m_fMinMs * 1.0e6) : 0.0;
+    }
+
+    static DOUBLE GetSitesPerSecond(const SBenchResult& result)
+    {
+        return result.m_fMinMs > 0.0 ? result.m_uiSites / (result.m_fMinMs * 1.0e-3) : 0.0;
+    }
+
+    UBOOL WriteJson(const CCString& sFileName) const;
+
+    UINT m_uiWarmup;
+    UINT m_uiRepeat;
+    CCString m_sLattice;
+    TArray<SBenchResult> m_lstResults;
+};
+
+typedef void (*benchfunction)(CParameters& params, CBenchReport& report);
+
+struct SBenchSuits
+{
+    benchfunction m_pfBench;
+    const TCHAR* m_sBenchName;
+};
+
+typedef TSimpleDoubleLinkedList<SBenchSuits> BenchList;
+
+extern BenchList* _benchSuits;
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
@@ -64,6 +64,7 @@
 
 #include "Tools/Tracer.h"
 #include "Tools/Timer.h"
+#include "Tools/Profiler.h"
 #include "Tools/CYAMLParser.h"
 
 #include "Core/CBase.h"
@@ -140,20 +141,20 @@ if (!sSite4.IsOdd()) \
 #define intokernalInt4 \
 SSmallInt4 sSite4; \
 const UINT _ixy = (threadIdx.x + blockIdx.x * blockDim.x); \
-sSite4.x = static_cast<SBYTE> (_ixy / _DC_Ly); \
-sSite4.y = static_cast<SBYTE> (_ixy % _DC_Ly); \
-sSite4.z = static_cast<SBYTE>(threadIdx.y + blockIdx.y * blockDim.y); \
-sSite4.w = static_cast<SBYTE>(threadIdx.z + blockIdx.z * blockDim.z); \
+sSite4.x = static_cast<SCOORD> (_ixy / _DC_Ly); \
+sSite4.y = static_cast<SCOORD> (_ixy % _DC_Ly); \
+sSite4.z = static_cast<SCOORD>(threadIdx.y + blockIdx.y * blockDim.y); \
+sSite4.w = static_cast<SCOORD>(threadIdx.z + blockIdx.z * blockDim.z); \
 const UINT uiSiteIndex = _ixy * _DC_GridDimZT + sSite4.z * _DC_Lt + sSite4.w; 
 
 
 #define intokernalOnlyInt4 \
 SSmallInt4 sSite4; \
 UINT _ixy = (threadIdx.x + blockIdx.x * blockDim.x); \
-sSite4.x = static_cast<SBYTE> (_ixy / _DC_Ly); \
-sSite4.y = static_cast<SBYTE> (_ixy % _DC_Ly); \
-sSite4.z = static_cast<SBYTE>(threadIdx.y + blockIdx.y * blockDim.y); \
-sSite4.w = static_cast<SBYTE>(threadIdx.z + blockIdx.z * blockDim.z); 
+sSite4.x = static_cast<SCOORD> (_ixy / _DC_Ly); \
+sSite4.y = static_cast<SCOORD> (_ixy % _DC_Ly); \
+sSite4.z = static_cast<SCOORD>(threadIdx.y + blockIdx.y * blockDim.y); \
+sSite4.w = static_cast<SCOORD>(threadIdx.z + blockIdx.z * blockDim.z); 
 
 #define _QUICK_AXPY_BLOCK 2
 
@@ -173,18 +174,18 @@ const dim3 threads(m_pHDecomp[3], m_pHDecomp[4], m_pHDecomp[5]);
 
 #define intokernalInt4_S \
 SSmallInt4 sSite4; \
-sSite4.x = static_cast<SBYTE>(threadIdx.x + blockIdx.x * blockDim.x); \
-sSite4.y = static_cast<SBYTE>(threadIdx.y + blockIdx.y * blockDim.y); \
-sSite4.z = static_cast<SBYTE>(threadIdx.z + blockIdx.z * blockDim.z); \
+sSite4.x = static_cast<SCOORD>(threadIdx.x + blockIdx.x * blockDim.x); \
+sSite4.y = static_cast<SCOORD>(threadIdx.y + blockIdx.y * blockDim.y); \
+sSite4.z = static_cast<SCOORD>(threadIdx.z + blockIdx.z * blockDim.z); \
 sSite4.w = uiT; \
 const UINT uiSiteIndex = sSite4.x * _DC_MultX + sSite4.y * _DC_MultY + sSite4.z * _DC_Lt + sSite4.w; \
 const UINT uiSiteIndex3D = (sSite4.x * _DC_Ly + sSite4.y) * _DC_Lz + sSite4.z;
 
 #define intokernalInt4_S_Only3D \
 SSmallInt4 sSite4; \
-sSite4.x = static_cast<SBYTE>(threadIdx.x + blockIdx.x * blockDim.x); \
-sSite4.y = static_cast<SBYTE>(threadIdx.y + blockIdx.y * blockDim.y); \
-sSite4.z = static_cast<SBYTE>(threadIdx.z + blockIdx.z * blockDim.z); \
+sSite4.x = static_cast<SCOORD>(threadIdx.x + blockIdx.x * blockDim.x); \
+sSite4.y = static_cast<SCOORD>(threadIdx.y + blockIdx.y * blockDim.y); \
+sSite4.z = static_cast<SCOORD>(threadIdx.z + blockIdx.z * blockDim.z); \
 sSite4.w = uiT; \
 const UINT uiSiteIndex3D = (sSite4.x * _DC_Ly + sSite4.y) * _DC_Lz + sSite4.z;
 
@@ -201,6 +202,7 @@ const UINT uiSiteIndex3D = (sSite4.x * _DC_Ly + sSite4.y) * _DC_Lz + sSite4.z;
 #include "Tools/Math/CRationalApproximation.h"
 
 #include "Data/CCommonData.h"
+#include "Tools/LaunchTuner.h"
 #include "Data/Boundary/CBoundaryCondition.h"
 #include "Data/Boundary/CBoundaryConditionTorusSquare.h"
 #include "Data/Boundary/CBoundaryConditionPeriodicAndDirichletSquare.h"
@@ -213,6 +215,7 @@ const UINT uiSiteIndex3D = (sSite4.x * _DC_Ly + sSite4.y) * _DC_Lz + sSite4.z;
 //=======================================================
 //Field
 #include "Data/Field/CField.h"
+#include "Data/Field/TFieldExpression.h"
 #include "Data/Field/BoundaryField/CFieldBoundary.h"
 
 #include "Data/Field/CFieldGauge.h"
@@ -222,6 +225,7 @@ const UINT uiSiteIndex3D = (sSite4.x * _DC_Ly + sSite4.y) * _DC_Lz + sSite4.z;
 #include "Data/Field/CFieldGaugeSU3D.h"
 #include "Data/Field/CFieldGaugeU1.h"
 #include "Data/Field/CFieldGaugeU1Real.h"
+#include "Data/Field/CFieldGaugeU1Angle.h"
 #include "Data/Field/CFieldGaugeZ2.h"
 #include "Data/Field/CFieldGaugeSU3TreeImproved.h"
 
@@ -231,6 +235,7 @@ const UINT uiSiteIndex3D = (sSite4.x * _DC_Ly + sSite4.y) * _DC_Lz + sSite4.z;
 
 #include "Data/Field/CFieldFermion.h"
 #include "Data/Field/CFieldFermionKS.h"
+#include "Data/Field/TFermionKSKernel.h"
 #include "Data/Field/BoundaryField/CFieldBoundaryWilsonSquareSU3.h"
 #include "Data/Field/CFieldFermionWilsonSquareSU3.h"
 #include "Data/Field/CFieldFermionWilsonSquareSU3D.h"
@@ -248,6 +253,7 @@ const UINT uiSiteIndex3D = (sSite4.x * _DC_Ly + sSite4.y) * _DC_Lz + sSite4.z;
 #include "Data/Field/CFieldFermionKSSU3DR.h"
 #include "Data/Field/CFieldFermionKSSU3EM.h"
 #include "Data/Field/CFieldFermionKSSU3P4.h"
+#include "Data/Field/CFieldFermionKSSU3Asqtad.h"
 #include "Data/Field/CFieldFermionKSU1.h"
 #include "Data/Field/CFieldFermionKSU1R.h"
 #include "Data/Field/CFieldFermionKSSU3REM.h"
@@ -255,6 +261,7 @@ const UINT uiSiteIndex3D = (sSite4.x * _DC_Ly + sSite4.y) * _DC_Lz + sSite4.z;
 //=====================================================
 
 #include "Data/Action/CAction.h"
+#include "Data/Action/CGaugePathTable.h"
 #include "Data/Action/CActionGaugePlaquette.h"
 #include "Data/Action/CActionFermionWilsonNf2.h"
 #include "Data/Action/CActionGaugePlaquetteRotating.h"
@@ -264,6 +271,7 @@ const UINT uiSiteIndex3D = (sSite4.x * _DC_Ly + sSite4.y) * _DC_Lz + sSite4.z;
 #include "Data/Action/CActionGaugePlaquetteRigidAcc.h"
 #include "Data/Action/CActionGaugePlaquetteRotatingU1.h"
 #include "Data/Action/CActionGaugePlaquetteBetaGradient.h"
+#include "Data/Action/CActionGaugePathTable.h"
 
 #include "SparseLinearAlgebra/CSLASolver.h"
 #include "SparseLinearAlgebra/CSolverBiCGstab.h"
@@ -303,6 +311,7 @@ const UINT uiSiteIndex3D = (sSite4.x * _DC_Ly + sSite4.y) * _DC_Lz + sSite4.z;
 #include "Measurement/CMeasureAngularMomentumKSREM.h"
 
 #include "Measurement/CMeasurementManager.h"
+#include "Measurement/CMeasurementFarm.h"
 #include "Measurement/GaugeSmearing/CGaugeSmearing.h"
 #include "Measurement/GaugeSmearing/CGaugeSmearingAPEProj.h"
 #include "Measurement/GaugeSmearing/CGaugeSmearingAPEStout.h"
@@ -313,6 +322,7 @@ const UINT uiSiteIndex3D = (sSite4.x * _DC_Ly + sSite4.y) * _DC_Lz + sSite4.z;
 #include "GaugeFixing/CGaugeFixingLandauLosAlamos.h"
 #include "GaugeFixing/CGaugeFixingCoulombLosAlamos.h"
 #include "GaugeFixing/CGaugeFixingRandom.h"
+#include "GaugeFixing/CGaugeFixingCopies.h"
 
 #include "Update/CUpdator.h"
 #include "Update/Continous/CIntegrator.h"
@@ -325,8 +335,14 @@ const UINT uiSiteIndex3D = (sSite4.x * _DC_Ly + sSite4.y) * _DC_Lz + sSite4.z;
 #include "Update/Continous/CIntegratorNestedForceGradient.h"
 #include "Update/Continous/CIntegratorMultiLevelNestedOmelyan.h"
 #include "Update/Continous/CIntegratorMultiLevelNestedForceGradient.h"
+#include "Update/Continous/CIntegratorTuner.h"
 #include "Update/Continous/CHMC.h"
+#include "Update/Discrete/CHeatbath.h"
+#include "Update/CEnsembleScheduler.h"
 
+#include "Core/CLatticeContext.h"
+#include "Core/CHaloTransport.h"
+#include "Core/CDomainDecomposition.h"
 #include "Core/CLGLibManager.h"
 
 #ifndef _CLG_PRIVATE
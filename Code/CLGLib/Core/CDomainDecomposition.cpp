@@ -0,0 +1,359 @@
+//=============================================================================
+// FILENAME : CDomainDecomposition.cpp
+//
+// DESCRIPTION:
+// This is the class to decompose the lattice into slabs of x on several ranks
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+#include "CLGLib_Private.h"
+
+__BEGIN_NAMESPACE
+
+CDomainDecomposition::CDomainDecomposition()
+    : m_pTransport(NULL)
+    , m_uiGlobalLx(0)
+    , m_uiLocalLx(0)
+    , m_uiPlaneSites(0)
+    , m_uiHalo(0)
+    , m_uiMaxBytes(0)
+    , m_uiSendBytes(0)
+    , m_pHostBuffer(NULL)
+    , m_sStream(NULL)
+    , m_sEvent(NULL)
+{
+
+}
+
+CDomainDecomposition::~CDomainDecomposition()
+{
+    Detach();
+    if (NULL != m_pHostBuffer)
+    {
+        checkCudaErrors(cudaFreeHost(m_pHostBuffer));
+    }
+    if (NULL != m_sStream)
+    {
+        checkCudaErrors(cudaStreamDestroy(m_sStream));
+    }
+    if (NULL != m_sEvent)
+    {
+        checkCudaErrors(cudaEventDestroy(m_sEvent));
+    }
+}
+
+UBOOL CDomainDecomposition::Initial(CHaloTransport* pTransport, UINT uiGlobalLx, UINT uiPlaneSites, UINT uiHalo, UINT uiMaxBytesPerSite)
+{
+    if (NULL == pTransport || 0 == pTransport->GetRankCount())
+    {
+        appCrucial(_T("CDomainDecomposition: transport is not set\n"));
+        return FALSE;
+    }
+    const UINT uiRankCount = pTransport->GetRankCount();
+    if (0 != (uiGlobalLx % uiRankCount))
+    {
+        appCrucial(_T("CDomainDecomposition: Lx = %d cannot be divided by %d ranks\n"), uiGlobalLx, uiRankCount);
+        return FALSE;
+    }
+    const UINT uiLocalLx = uiGlobalLx / uiRankCount;
+    if (uiLocalLx < uiHalo || 0 == uiHalo)
+    {
+        appCrucial(_T("CDomainDecomposition: local Lx = %d must be at least halo = %d (halo > 0)\n"), uiLocalLx, uiHalo);
+        return FALSE;
+    }
+    const QWORD uiSlotBytes = static_cast<QWORD>(uiHalo) * uiPlaneSites * uiMaxBytesPerSite;
+    if (uiSlotBytes > 0xFFFFFFFFULL)
+    {
+        appCrucial(_T("CDomainDecomposition: halo is too large\n"));
+        return FALSE;
+    }
+
+    m_pTransport = pTransport;
+    m_uiGlobalLx = uiGlobalLx;
+    m_uiLocalLx = uiLocalLx;
+    m_uiPlaneSites = uiPlaneSites;
+    m_uiHalo = uiHalo;
+    m_uiMaxBytes = uiMaxBytesPerSite;
+
+    if (NULL != m_pHostBuffer)
+    {
+        checkCudaErrors(cudaFreeHost(m_pHostBuffer));
+    }
+    checkCudaErrors(cudaMallocHost((void**)&m_pHostBuffer, static_cast<size_t>(uiSlotBytes) * 4));
+    if (NULL == m_sStream)
+    {
+        checkCudaErrors(cudaStreamCreateWithFlags(&m_sStream, cudaStreamNonBlocking));
+    }
+    if (NULL == m_sEvent)
+    {
+        checkCudaErrors(cudaEventCreate(&m_sEvent));
+    }
+
+    appGeneral(_T("CDomainDecomposition: rank %d / %d, x = [%d, %d), local lattice Lx = %d\n"),
+        pTransport->GetRank(), uiRankCount, GetGlobalXStart(), GetGlobalXStart() + m_uiLocalLx, GetLocalLx());
+    return TRUE;
+}
+
+void CDomainDecomposition::FillLatticeParameters(CParameters& params) const
+{
+    CCString sValue;
+    sValue.Format(_T("%d"), GetLocalXOrigin());
+    params.SetStringVaule(_T("XOrigin"), sValue);
+    sValue.Format(_T("%d"), m_uiGlobalLx);
+    params.SetStringVaule(_T("GlobalLx"), sValue);
+}
+
+void CDomainDecomposition::Attach()
+{
+    if (_HC_Lx != GetLocalLx() || _HC_XOrigin != GetLocalXOrigin())
+    {
+        appCrucial(_T("CDomainDecomposition: the lattice (Lx = %d, XOrigin = %d) is not the slab (Lx = %d, XOrigin = %d), use FillLatticeParameters\n"),
+            _HC_Lx, _HC_XOrigin, GetLocalLx(), GetLocalXOrigin());
+        _FAIL_EXIT;
+    }
+    appGetCudaHelper()->m_pDomainDecomposition = this;
+}
+
+void CDomainDecomposition::Detach()
+{
+    if (NULL != GCLGManager.m_pCudaHelper && this == GCLGManager.m_pCudaHelper->m_pDomainDecomposition)
+    {
+        GCLGManager.m_pCudaHelper->m_pDomainDecomposition = NULL;
+    }
+}
+
+void CDomainDecomposition::AllReduceSum(DOUBLE* pValues, UINT uiCount) const
+{
+    if (!m_pTransport->AllReduceSum(pValues, uiCount))
+    {
+        appCrucial(_T("CDomainDecomposition: rank %d failed to reduce\n"), m_pTransport->GetRank());
+        _FAIL_EXIT;
+    }
+}
+
+/**
+* Called by the stream after the boundary planes are copied to host, it must not call CUDA
+*/
+void CUDART_CB CDomainDecomposition::PostSends(void* pThis)
+{
+    CDomainDecomposition* pMe = static_cast<CDomainDecomposition*>(pThis);
+    const size_t uiSlotBytes = static_cast<size_t>(pMe->m_uiPlaneSites) * pMe->m_uiMaxBytes * pMe->m_uiHalo;
+    pMe->m_pTransport->Send(pMe->GetLeftRank(), 0, pMe->m_pHostBuffer, pMe->m_uiSendBytes);
+    pMe->m_pTransport->Send(pMe->GetRightRank(), 1, pMe->m_pHostBuffer + uiSlotBytes, pMe->m_uiSendBytes);
+}
+
+void CDomainDecomposition::BeginHaloExchange(const void* pDeviceData, UINT uiBytesPerSite)
+{
+    assert(uiBytesPerSite <= m_uiMaxBytes);
+    const size_t uiPlaneBytes = static_cast<size_t>(m_uiPlaneSites) * uiBytesPerSite;
+    const size_t uiHaloBytes = uiPlaneBytes * m_uiHalo;
+    const size_t uiSlotBytes = static_cast<size_t>(m_uiPlaneSites) * m_uiMaxBytes * m_uiHalo;
+    const BYTE* pDevice = static_cast<const BYTE*>(pDeviceData);
+
+    //The copy must wait for the kernels on the default stream which write the field
+    checkCudaErrors(cudaEventRecord(m_sEvent, 0));
+    checkCudaErrors(cudaStreamWaitEvent(m_sStream, m_sEvent, 0));
+
+    //the first interior planes go to the left, the last interior planes go to the right
+    checkCudaErrors(cudaMemcpyAsync(m_pHostBuffer, pDevice + uiHaloBytes, uiHaloBytes, cudaMemcpyDeviceToHost, m_sStream));
+    checkCudaErrors(cudaMemcpyAsync(m_pHostBuffer + uiSlotBytes, pDevice + uiPlaneBytes * m_uiLocalLx, uiHaloBytes, cudaMemcpyDeviceToHost, m_sStream));
+
+    //Do not wait here, the sends are posted by the stream when the copies are finished
+    m_uiSendBytes = static_cast<UINT>(uiHaloBytes);
+    checkCudaErrors(cudaLaunchHostFunc(m_sStream, PostSends, this));
+}
+
+UBOOL CDomainDecomposition::EndHaloExchange(void* pDeviceData, UINT uiBytesPerSite)
+{
+    assert(uiBytesPerSite <= m_uiMaxBytes);
+    const size_t uiPlaneBytes = static_cast<size_t>(m_uiPlaneSites) * uiBytesPerSite;
+    const size_t uiHaloBytes = uiPlaneBytes * m_uiHalo;
+    const size_t uiSlotBytes = static_cast<size_t>(m_uiPlaneSites) * m_uiMaxBytes * m_uiHalo;
+    BYTE* pDevice = static_cast<BYTE*>(pDeviceData);
+
+    //the left rank sends its last planes with tag 1, the right rank sends its first planes with tag 0
+    //the receive slots are not touched by PostSends, so they can be written before it is finished
+    BYTE* pLeftHalo = m_pHostBuffer + 2 * uiSlotBytes;
+    BYTE* pRightHalo = m_pHostBuffer + 3 * uiSlotBytes;
+    if (!m_pTransport->Receive(GetLeftRank(), 1, pLeftHalo, static_cast<UINT>(uiHaloBytes))
+     || !m_pTransport->Receive(GetRightRank(), 0, pRightHalo, static_cast<UINT>(uiHaloBytes)))
+    {
+        checkCudaErrors(cudaStreamSynchronize(m_sStream));
+        return FALSE;
+    }
+
+    checkCudaErrors(cudaMemcpyAsync(pDevice, pLeftHalo, uiHaloBytes, cudaMemcpyHostToDevice, m_sStream));
+    checkCudaErrors(cudaMemcpyAsync(pDevice + uiPlaneBytes * (m_uiHalo + m_uiLocalLx), pRightHalo, uiHaloBytes, cudaMemcpyHostToDevice, m_sStream));
+    checkCudaErrors(cudaStreamSynchronize(m_sStream));
+    return TRUE;
+}
+
+void CDomainDecomposition::ZeroHalo(void* pDeviceData, UINT uiBytesPerSite) const
+{
+    const size_t uiPlaneBytes = static_cast<size_t>(m_uiPlaneSites) * uiBytesPerSite;
+    const size_t uiHaloBytes = uiPlaneBytes * m_uiHalo;
+    BYTE* pDevice = static_cast<BYTE*>(pDeviceData);
+    checkCudaErrors(cudaMemset(pDevice, 0, uiHaloBytes));
+    checkCudaErrors(cudaMemset(pDevice + uiPlaneBytes * (m_uiHalo + m_uiLocalLx), 0, uiHaloBytes));
+}
+
+void appExchangeHalo(const void* pDeviceData, UINT uiBytesPerSite)
+{
+    CDomainDecomposition* pDecomposition = appGetCudaHelper()->m_pDomainDecomposition;
+    if (NULL != pDecomposition && !pDecomposition->ExchangeHalo(const_cast<void*>(pDeviceData), uiBytesPerSite))
+    {
+        appCrucial(_T("CDomainDecomposition: halo exchange failed\n"));
+        _FAIL_EXIT;
+    }
+}
+
+SXPlaneRange appBeginExchangeHalo(const void* pDeviceData, UINT uiBytesPerSite, UINT uiReach)
+{
+    CDomainDecomposition* pDecomposition = appGetCudaHelper()->m_pDomainDecomposition;
+    if (NULL == pDecomposition)
+    {
+        return SXPlaneRange::All();
+    }
+    pDecomposition->BeginHaloExchange(pDeviceData, uiBytesPerSite);
+    return pDecomposition->GetInnerPlanes(uiReach);
+}
+
+UBOOL appEndExchangeHalo(const void* pDeviceData, UINT uiBytesPerSite, SXPlaneRange& sRange)
+{
+    CDomainDecomposition* pDecomposition = appGetCudaHelper()->m_pDomainDecomposition;
+    if (NULL == pDecomposition || !sRange.m_bInside)
+    {
+        return FALSE;
+    }
+    if (!pDecomposition->EndHaloExchange(const_cast<void*>(pDeviceData), uiBytesPerSite))
+    {
+        appCrucial(_T("CDomainDecomposition: halo exchange failed\n"));
+        _FAIL_EXIT;
+    }
+    sRange.m_bInside = FALSE;
+    return TRUE;
+}
+
+CCString CDomainDecomposition::GetPartName(const CCString& sFileName, UINT uiRank) const
+{
+    CCString sRet;
+    sRet.Format(_T("%s_%d"), sFileName.c_str(), uiRank);
+    return sRet;
+}
+
+UBOOL CDomainDecomposition::ReadInterior(const CCString& sFileName, void* pDeviceData, UINT uiBytesPerSite, UINT uiHeaderBytes) const
+{
+    const size_t uiPlaneBytes = static_cast<size_t>(m_uiPlaneSites) * uiBytesPerSite;
+    const size_t uiInteriorBytes = uiPlaneBytes * m_uiLocalLx;
+    FILE* fp = NULL;
+    FOPEN(fp, sFileName.c_str(), "rb");
+    if (NULL == fp)
+    {
+        appCrucial(_T("CDomainDecomposition: cannot open %s\n"), sFileName.c_str());
+        return FALSE;
+    }
+
+    const QWORD uiOffset = static_cast<QWORD>(uiHeaderBytes) + static_cast<QWORD>(uiPlaneBytes) * GetGlobalXStart();
+    BYTE* byData = (BYTE*)malloc(uiInteriorBytes);
+    const UBOOL bRead = (0 == appFSeek64(fp, uiOffset))
+        && (uiInteriorBytes == fread(byData, 1, uiInteriorBytes, fp));
+    fclose(fp);
+    if (!bRead)
+    {
+        appCrucial(_T("CDomainDecomposition: %s is too short\n"), sFileName.c_str());
+        free(byData);
+        return FALSE;
+    }
+
+    checkCudaErrors(cudaMemcpy(static_cast<BYTE*>(pDeviceData) + uiPlaneBytes * m_uiHalo, byData, uiInteriorBytes, cudaMemcpyHostToDevice));
+    free(byData);
+    return TRUE;
+}
+
+UBOOL CDomainDecomposition::WriteInterior(const CCString& sFileName, const void* pDeviceData, UINT uiBytesPerSite) const
+{
+    const size_t uiPlaneBytes = static_cast<size_t>(m_uiPlaneSites) * uiBytesPerSite;
+    const size_t uiInteriorBytes = uiPlaneBytes * m_uiLocalLx;
+    BYTE* byData = (BYTE*)malloc(uiInteriorBytes);
+    checkCudaErrors(cudaMemcpy(byData, static_cast<const BYTE*>(pDeviceData) + uiPlaneBytes * m_uiHalo, uiInteriorBytes, cudaMemcpyDeviceToHost));
+    const CCString sPartName = GetPartName(sFileName, m_pTransport->GetRank());
+    const UBOOL bRet = CFileSystem::WriteAllBytesAtomic(sPartName.c_str(), byData, uiInteriorBytes);
+    free(byData);
+    if (!bRet)
+    {
+        appCrucial(_T("CDomainDecomposition: failed to write %s\n"), sPartName.c_str());
+    }
+    return bRet;
+}
+
+/**
+* The parts are copied in chunks, so the size of the global file is not limited by UINT or the memory
+*/
+UBOOL CDomainDecomposition::MergeInterior(const CCString& sFileName) const
+{
+    CCString sTemp;
+    sTemp.Format(_T("%s.tmp"), sFileName.c_str());
+    FILE* fpOut = NULL;
+    FOPEN(fpOut, sTemp.c_str(), "wb");
+    if (NULL == fpOut)
+    {
+        appCrucial(_T("CDomainDecomposition: failed to write %s\n"), sFileName.c_str());
+        return FALSE;
+    }
+
+    const size_t uiChunk = static_cast<size_t>(1) << 24;
+    BYTE* byChunk = (BYTE*)malloc(uiChunk);
+    UBOOL bRet = TRUE;
+    for (UINT i = 0; i < m_pTransport->GetRankCount() && bRet; ++i)
+    {
+        const CCString sPartName = GetPartName(sFileName, i);
+        FILE* fpIn = NULL;
+        FOPEN(fpIn, sPartName.c_str(), "rb");
+        if (NULL == fpIn)
+        {
+            appCrucial(_T("CDomainDecomposition: %s not found\n"), sPartName.c_str());
+            bRet = FALSE;
+            break;
+        }
+        size_t uiRead = 0;
+        while ((uiRead = fread(byChunk, 1, uiChunk, fpIn)) > 0)
+        {
+            if (uiRead != fwrite(byChunk, 1, uiRead, fpOut))
+            {
+                appCrucial(_T("CDomainDecomposition: failed to write %s\n"), sFileName.c_str());
+                bRet = FALSE;
+                break;
+            }
+        }
+        fclose(fpIn);
+    }
+    free(byChunk);
+    fflush(fpOut);
+    fclose(fpOut);
+
+    if (!bRet)
+    {
+        remove(sTemp.c_str());
+        return FALSE;
+    }
+#if _CLG_WIN
+    remove(sFileName.c_str());
+#endif
+    if (0 != rename(sTemp.c_str(), sFileName.c_str()))
+    {
+        appCrucial(_T("CDomainDecomposition: failed to write %s\n"), sFileName.c_str());
+        return FALSE;
+    }
+    for (UINT i = 0; i < m_pTransport->GetRankCount(); ++i)
+    {
+        remove(GetPartName(sFileName, i).c_str());
+    }
+    return TRUE;
+}
+
+__END_NAMESPACE
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
@@ -0,0 +1,240 @@
+//=============================================================================
+// FILENAME : CDomainDecomposition.h
+//
+// DESCRIPTION:
+// This is the class to decompose the lattice into slabs of x on several ranks
+//
+// The site index is x * MultX + ..., so one x-plane is continuous in the
+// memory for both sites and links (link index = site * dir + dir). Each
+// rank holds Lx / N planes, plus uiHalo planes on both sides, so the lattice
+// of the rank is (Lx / N + 2 halo) x Ly x Lz x Lt with
+// CBoundaryConditionTorusSquare. The kernels (Dslash, staples...) run on
+// the whole local lattice, after the halo exchange the results on the
+// interior planes are the same as on the global lattice. (1 halo plane is
+// enough for Wilson Dslash and staples, the Naik term of KS needs 3.)
+//
+// The local x = 0 is the global x = GetLocalXOrigin(), FillLatticeParameters
+// writes it (XOrigin) and the global Lx (GlobalLx) to the parameters of the
+// slab, so the parity, the staggered eta and the center (of the rotating
+// actions and measurements) are those of the global lattice.
+//
+// The boundary condition of x must be periodic, the twist of other
+// directions is not affected.
+//
+// BeginHaloExchange copies the boundary planes with a non-blocking stream,
+// the sends are posted by a host function of the stream when the copies
+// are finished, EndHaloExchange waits for the receives and copies the halo
+// to device. The work launched between them overlaps the exchange.
+//
+// After Attach:
+//  - The DOperator of CFieldFermionWilsonSquareSU3, CFieldFermionKSSU3 and
+//    CFieldFermionKSU1 begin the exchange of the fermion, run the Dslash on
+//    the planes not reading the halo, end the exchange, and run the Dslash
+//    on the rest (see appBeginExchangeHalo).
+//  - CFieldGauge::IncreaseVersion exchanges the halo of the links
+//    (CFieldGaugeSU3, CFieldGaugeU1, CFieldGaugeU1Angle), so the links are
+//    exchanged whenever they are changed (ExpMult, CopyTo, InitialField...).
+//    The momentum and force fields are also gauge fields, they are exchanged
+//    as well, it is two planes and not read.
+//  - CCudaHelper::ThreadBufferSum (Dot, DotReal, energies...) sums only the
+//    interior and then over the ranks.
+// So the solvers and the updators run on the slabs without change. All ranks
+// must change the gauge fields in the same order, as they do running the
+// same program.
+//
+// Or without Attach, call ZeroHalo on one of the fields, then the
+// reduction on the local lattice is the sum of interior, and AllReduceSum.
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#ifndef _CDOMAINDECOMPOSITION_H_
+#define _CDOMAINDECOMPOSITION_H_
+
+__BEGIN_NAMESPACE
+
+/**
+* The x-planes [m_iStart, m_iEnd) of the local lattice if m_bInside, otherwise the planes out of them.
+* The kernels split by the halo exchange return at once for the sites to skip.
+*/
+struct SXPlaneRange
+{
+    INT m_iStart;
+    INT m_iEnd;
+    UBOOL m_bInside;
+
+    __device__ __inline__ UBOOL Skip(INT iX) const
+    {
+        return m_bInside != (iX >= m_iStart && iX < m_iEnd);
+    }
+
+    /**
+    * Out of nothing, so nothing is skipped
+    */
+    static SXPlaneRange All()
+    {
+        SXPlaneRange ret;
+        ret.m_iStart = 0;
+        ret.m_iEnd = 0;
+        ret.m_bInside = FALSE;
+        return ret;
+    }
+};
+
+class CLGAPI CDomainDecomposition
+{
+public:
+    CDomainDecomposition();
+    ~CDomainDecomposition();
+
+    /**
+    * uiPlaneSites = Ly * Lz * Lt
+    * uiMaxBytesPerSite is the largest field to exchange, for example sizeof(deviceSU3) * dir
+    */
+    UBOOL Initial(class CHaloTransport* pTransport, UINT uiGlobalLx, UINT uiPlaneSites, UINT uiHalo, UINT uiMaxBytesPerSite);
+
+    /**
+    * The lattice length of x for appInitialCLG of this rank
+    */
+    UINT GetLocalLx() const { return m_uiLocalLx + 2 * m_uiHalo; }
+    UINT GetInteriorLx() const { return m_uiLocalLx; }
+    UINT GetHalo() const { return m_uiHalo; }
+
+    /**
+    * The global x of the first interior plane
+    */
+    UINT GetGlobalXStart() const { return m_pTransport->GetRank() * m_uiLocalLx; }
+
+    /**
+    * The global x of the local x = 0 (the first halo plane), can be negative
+    */
+    INT GetLocalXOrigin() const { return static_cast<INT>(GetGlobalXStart()) - static_cast<INT>(m_uiHalo); }
+
+    /**
+    * Set XOrigin and GlobalLx to the lattice parameters of this rank,
+    * LatticeLength of x should be GetLocalLx()
+    */
+    void FillLatticeParameters(CParameters& params) const;
+
+    /**
+    * Attach to the current lattice context, see the description at the beginning
+    */
+    void Attach();
+    void Detach();
+
+    /**
+    * The first interior site, and the number of interior sites
+    */
+    UINT GetInteriorSiteStart() const { return m_uiHalo * m_uiPlaneSites; }
+    UINT GetInteriorSiteCount() const { return m_uiLocalLx * m_uiPlaneSites; }
+
+    /**
+    * The planes of a stencil of length uiReach not reading the halo
+    */
+    SXPlaneRange GetInnerPlanes(UINT uiReach) const
+    {
+        assert(uiReach <= m_uiHalo);
+        SXPlaneRange ret;
+        ret.m_iStart = static_cast<INT>(m_uiHalo + uiReach);
+        ret.m_iEnd = static_cast<INT>(m_uiHalo + m_uiLocalLx) - static_cast<INT>(uiReach);
+        ret.m_bInside = TRUE;
+        return ret;
+    }
+
+    void BeginHaloExchange(const void* pDeviceData, UINT uiBytesPerSite);
+    UBOOL EndHaloExchange(void* pDeviceData, UINT uiBytesPerSite);
+    UBOOL ExchangeHalo(void* pDeviceData, UINT uiBytesPerSite)
+    {
+        BeginHaloExchange(pDeviceData, uiBytesPerSite);
+        return EndHaloExchange(pDeviceData, uiBytesPerSite);
+    }
+
+    void ZeroHalo(void* pDeviceData, UINT uiBytesPerSite) const;
+
+    /**
+    * A failed reduction (a rank is missing) exits, a partial sum is never returned
+    */
+    DOUBLE AllReduceSum(DOUBLE fValue) const
+    {
+        AllReduceSum(&fValue, 1);
+        return fValue;
+    }
+
+    cuDoubleComplex AllReduceSum(const cuDoubleComplex& cValue) const
+    {
+        DOUBLE fValues[2] = { cValue.x, cValue.y };
+        AllReduceSum(fValues, 2);
+        return make_cuDoubleComplex(fValues[0], fValues[1]);
+    }
+
+    void AllReduceSum(DOUBLE* pValues, UINT uiCount) const;
+
+    /**
+    * Partitioned IO, the file stores the sites of the global lattice in the order of site index,
+    * after uiHeaderBytes. Every rank only reads its interior planes.
+    */
+    UBOOL ReadInterior(const CCString& sFileName, void* pDeviceData, UINT uiBytesPerSite, UINT uiHeaderBytes = 0) const;
+
+    /**
+    * Every rank writes the interior planes to sFileName_rank,
+    * MergeInterior (on one rank, after a Barrier) joins them to the global file.
+    */
+    UBOOL WriteInterior(const CCString& sFileName, const void* pDeviceData, UINT uiBytesPerSite) const;
+    UBOOL MergeInterior(const CCString& sFileName) const;
+
+    class CHaloTransport* GetTransport() const { return m_pTransport; }
+
+protected:
+
+    static void CUDART_CB PostSends(void* pThis);
+
+    UINT GetLeftRank() const { return (m_pTransport->GetRank() + m_pTransport->GetRankCount() - 1) % m_pTransport->GetRankCount(); }
+    UINT GetRightRank() const { return (m_pTransport->GetRank() + 1) % m_pTransport->GetRankCount(); }
+    CCString GetPartName(const CCString& sFileName, UINT uiRank) const;
+
+    class CHaloTransport* m_pTransport;
+    UINT m_uiGlobalLx;
+    UINT m_uiLocalLx;
+    UINT m_uiPlaneSites;
+    UINT m_uiHalo;
+    UINT m_uiMaxBytes;
+    //the size of the halo being sent, read by PostSends
+    UINT m_uiSendBytes;
+
+    //pinned, [left send, right send, left receive, right receive]
+    BYTE* m_pHostBuffer;
+    cudaStream_t m_sStream;
+    cudaEvent_t m_sEvent;
+};
+
+/**
+* Called by the DOperator before the Dslash, exchange the halo of pDeviceData
+* if a CDomainDecomposition is attached to the current lattice.
+* Only the halo planes are written, so the buffer is const for the interior.
+*/
+extern CLGAPI void appExchangeHalo(const void* pDeviceData, UINT uiBytesPerSite);
+
+/**
+* The Dslash split by the halo exchange, uiReach is the length of the hopping:
+*
+*     SXPlaneRange sRange = appBeginExchangeHalo(pSource, uiBytes, 1);
+*     do
+*     {
+*         _kernel << <block, threads >> > (..., sRange);
+*     } while (appEndExchangeHalo(pSource, uiBytes, sRange));
+*
+* Without decomposition, sRange is all planes and the loop runs once.
+* Otherwise the first pass is on the inner planes, overlapping the exchange,
+* appEndExchangeHalo waits for the halo and turns sRange to the other planes.
+*/
+extern CLGAPI SXPlaneRange appBeginExchangeHalo(const void* pDeviceData, UINT uiBytesPerSite, UINT uiReach);
+extern CLGAPI UBOOL appEndExchangeHalo(const void* pDeviceData, UINT uiBytesPerSite, SXPlaneRange& sRange);
+
+__END_NAMESPACE
+
+#endif //#ifndef _CDOMAINDECOMPOSITION_H_
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
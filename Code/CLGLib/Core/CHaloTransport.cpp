@@ -0,0 +1,136 @@
+//=============================================================================
+// FILENAME : CHaloTransport.cpp
+//
+// DESCRIPTION:
+// This is the interconnect between the ranks of a decomposed lattice
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+#include "CLGLib_Private.h"
+
+__BEGIN_NAMESPACE
+
+CHaloTransportSharedFile::CHaloTransportSharedFile(const CCString& sDirectory, const CCString& sJob, UINT uiRank, UINT uiRankCount)
+    : CHaloTransport(uiRank, uiRankCount)
+    , m_uiTimeOut(600)
+{
+    m_sPrefix = sDirectory + _T("/") + sJob;
+    for (UINT i = 0; i < uiRankCount * kMaxTag; ++i)
+    {
+        m_lstSendSequence.AddItem(0);
+        m_lstReceiveSequence.AddItem(0);
+    }
+}
+
+CHaloTransportSharedFile::~CHaloTransportSharedFile()
+{
+
+}
+
+CCString CHaloTransportSharedFile::GetMessageName(UINT uiFromRank, UINT uiToRank, UINT uiTag, UINT uiSequence) const
+{
+    CCString sRet;
+    sRet.Format(_T("%s_%d_%d_%d_%d.halo"), m_sPrefix.c_str(), uiFromRank, uiToRank, uiTag, uiSequence);
+    return sRet;
+}
+
+void CHaloTransportSharedFile::Send(UINT uiToRank, UINT uiTag, const BYTE* pData, UINT uiSize)
+{
+    assert(uiToRank < m_uiRankCount && uiTag < kMaxTag);
+    const INT iKey = static_cast<INT>(uiToRank * kMaxTag + uiTag);
+    const CCString sFileName = GetMessageName(m_uiRank, uiToRank, uiTag, m_lstSendSequence[iKey]);
+    ++m_lstSendSequence[iKey];
+
+    //The receiver only sees the file after it is renamed, so it never reads a half written message
+    if (!CFileSystem::WriteAllBytesAtomic(sFileName.c_str(), pData, uiSize))
+    {
+        appCrucial(_T("CHaloTransportSharedFile: failed to write %s\n"), sFileName.c_str());
+    }
+}
+
+UBOOL CHaloTransportSharedFile::Receive(UINT uiFromRank, UINT uiTag, BYTE* pData, UINT uiSize)
+{
+    assert(uiFromRank < m_uiRankCount && uiTag < kMaxTag);
+    const INT iKey = static_cast<INT>(uiFromRank * kMaxTag + uiTag);
+    const CCString sFileName = GetMessageName(uiFromRank, m_uiRank, uiTag, m_lstReceiveSequence[iKey]);
+    ++m_lstReceiveSequence[iKey];
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while (!CFileSystem::IsFileExist(sFileName))
+    {
+        if (std::chrono::steady_clock::now() - start > std::chrono::seconds(m_uiTimeOut))
+        {
+            appCrucial(_T("CHaloTransportSharedFile: time out when waiting for %s\n"), sFileName.c_str());
+            return FALSE;
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(50));
+    }
+
+    UINT uiFileSize = 0;
+    BYTE* byData = appGetFileSystem()->ReadAllBytes(sFileName.c_str(), uiFileSize);
+    remove(sFileName.c_str());
+    if (NULL == byData || uiFileSize != uiSize)
+    {
+        appCrucial(_T("CHaloTransportSharedFile: %s has size %d, expecting %d\n"), sFileName.c_str(), uiFileSize, uiSize);
+        if (NULL != byData)
+        {
+            free(byData);
+        }
+        return FALSE;
+    }
+    memcpy(pData, byData, uiSize);
+    free(byData);
+    return TRUE;
+}
+
+/**
+* Every rank sends its values to all others, and sums in the order of rank.
+* The receivers delete the messages, so nothing is left in the directory.
+* A rank which is missing (time out) fails the reduction, the partial sum is never returned as a result.
+*/
+UBOOL CHaloTransportSharedFile::AllReduceSum(DOUBLE* pValues, UINT uiCount)
+{
+    const UINT uiSize = static_cast<UINT>(sizeof(DOUBLE) * uiCount);
+    for (UINT i = 0; i < m_uiRankCount; ++i)
+    {
+        if (i != m_uiRank)
+        {
+            Send(i, kReduceTag, reinterpret_cast<const BYTE*>(pValues), uiSize);
+        }
+    }
+
+    TArray<DOUBLE> mine;
+    TArray<DOUBLE> others;
+    for (UINT j = 0; j < uiCount; ++j)
+    {
+        mine.AddItem(pValues[j]);
+        others.AddItem(0.0);
+        pValues[j] = 0.0;
+    }
+
+    for (UINT i = 0; i < m_uiRankCount; ++i)
+    {
+        const DOUBLE* pAdd = mine.GetData();
+        if (i != m_uiRank)
+        {
+            if (!Receive(i, kReduceTag, reinterpret_cast<BYTE*>(others.GetData()), uiSize))
+            {
+                appCrucial(_T("CHaloTransportSharedFile: AllReduceSum failed, rank %d is missing\n"), i);
+                return FALSE;
+            }
+            pAdd = others.GetData();
+        }
+        for (UINT j = 0; j < uiCount; ++j)
+        {
+            pValues[j] += pAdd[j];
+        }
+    }
+    return TRUE;
+}
+
+__END_NAMESPACE
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
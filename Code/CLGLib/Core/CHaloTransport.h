@@ -0,0 +1,104 @@
+//=============================================================================
+// FILENAME : CHaloTransport.h
+//
+// DESCRIPTION:
+// This is the interconnect between the ranks of a decomposed lattice
+//
+// CHaloTransportSharedFile is the transport for several processes on one
+// box. The messages are files written atomically to a directory which
+// should be a shared memory file system (for example /dev/shm), so it can
+// be tested without MPI or several devices.
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#ifndef _CHALOTRANSPORT_H_
+#define _CHALOTRANSPORT_H_
+
+__BEGIN_NAMESPACE
+
+class CLGAPI CHaloTransport
+{
+public:
+    CHaloTransport(UINT uiRank, UINT uiRankCount)
+        : m_uiRank(uiRank)
+        , m_uiRankCount(uiRankCount)
+    {
+    }
+
+    virtual ~CHaloTransport() {}
+
+    /**
+    * Send does not wait for the receiver
+    */
+    virtual void Send(UINT uiToRank, UINT uiTag, const BYTE* pData, UINT uiSize) = 0;
+
+    /**
+    * Receive waits until the message with the tag from uiFromRank arrives
+    * return FALSE if time out or the size is wrong
+    */
+    virtual UBOOL Receive(UINT uiFromRank, UINT uiTag, BYTE* pData, UINT uiSize) = 0;
+
+    /**
+    * Sum over all ranks, the sum is in the order of rank, so all ranks have the same result
+    * return FALSE if any receive fails, pValues is then not a valid sum
+    */
+    virtual UBOOL AllReduceSum(DOUBLE* pValues, UINT uiCount) = 0;
+
+    virtual UBOOL Barrier()
+    {
+        DOUBLE fZero = 0.0;
+        return AllReduceSum(&fZero, 1);
+    }
+
+    UINT GetRank() const { return m_uiRank; }
+    UINT GetRankCount() const { return m_uiRankCount; }
+
+protected:
+
+    UINT m_uiRank;
+    UINT m_uiRankCount;
+};
+
+class CLGAPI CHaloTransportSharedFile : public CHaloTransport
+{
+public:
+
+    /**
+    * sJob is the name of the run, so that several runs can share one directory
+    */
+    CHaloTransportSharedFile(const CCString& sDirectory, const CCString& sJob, UINT uiRank, UINT uiRankCount);
+    ~CHaloTransportSharedFile();
+
+    void Send(UINT uiToRank, UINT uiTag, const BYTE* pData, UINT uiSize) override;
+    UBOOL Receive(UINT uiFromRank, UINT uiTag, BYTE* pData, UINT uiSize) override;
+    UBOOL AllReduceSum(DOUBLE* pValues, UINT uiCount) override;
+
+    /**
+    * In seconds
+    */
+    void SetTimeOut(UINT uiSeconds) { m_uiTimeOut = uiSeconds; }
+
+    enum { kMaxTag = 16, kReduceTag = kMaxTag - 1, };
+
+protected:
+
+    CCString GetMessageName(UINT uiFromRank, UINT uiToRank, UINT uiTag, UINT uiSequence) const;
+
+    CCString m_sPrefix;
+    UINT m_uiTimeOut;
+
+    //the messages with same (rank, tag) are received in the order they are sent
+    //indexed by rank * kMaxTag + tag
+    TArray<UINT> m_lstSendSequence;
+    TArray<UINT> m_lstReceiveSequence;
+};
+
+__END_NAMESPACE
+
+#endif //#ifndef _CHALOTRANSPORT_H_
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
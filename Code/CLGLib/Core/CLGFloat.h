@@ -26,6 +26,8 @@
 #define _hostlog10 log10
 #define _hostexp exp
 #define _hostsqrt sqrt
+#define _hostsin sin
+#define _hostcos cos
 
 #define _atan2 atan2
 #define _make_cuComplex make_cuDoubleComplex
@@ -39,6 +41,7 @@
 #define _cuCdivf cuCdiv
 #define F(v) v
 #if defined(__cplusplus) && defined(__CUDACC__)
+#define _sincos sincos
 #define _floor2int __double2int_rd
 #define _round2int __double2int_rn
 #else
@@ -55,6 +58,7 @@
 #define _pow __powf
 #define _sin __sinf
 #define _cos __cosf
+#define _sincos __sincosf
 #define __div __fdividef
 #define __rcp __frcp_rn
 #else
@@ -78,6 +82,8 @@
 #define _hostsqrt sqrtf
 #define _hostsqrtd sqrt
 #define _hostexpd exp
+#define _hostsin sinf
+#define _hostcos cosf
 
 #define _atan2 atan2f
 #define _make_cuComplex make_cuComplex
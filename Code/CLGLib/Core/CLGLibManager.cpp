@@ -93,14 +93,41 @@ void CCLGLibManager::InitialLatticeAndConstant(CParameters& params)
         intValues.AddItem(8);
     }
 
+    //The coordinates (with the edge of the index cache) are SCOORD, the site, link and index cache entries are UINT
+    QWORD uiBigVolume = 1;
+    QWORD uiVolume = 1;
+    for (INT i = 0; i < 4; ++i)
+    {
+        if (intValues[i] - 1 + CIndexData::kCacheIndexEdge > kMaxCoordinate)
+        {
+            appCrucial(_T("Lattice length %d is too large, the max is %d, compile with _CLG_LARGE_LATTICE = 1\n"), intValues[i], kMaxCoordinate + 1 - CIndexData::kCacheIndexEdge);
+            _FAIL_EXIT;
+        }
+        uiBigVolume = uiBigVolume * static_cast<QWORD>(intValues[i] + 2 * CIndexData::kCacheIndexEdge);
+        uiVolume = uiVolume * static_cast<QWORD>(intValues[i]);
+    }
+    //the staple cache is the largest table, volume * dir * 2(dir - 1) * 3
+    const QWORD uiDir = static_cast<QWORD>(m_InitialCache.constIntegers[ECI_Dir]);
+    if (uiBigVolume * uiDir > static_cast<QWORD>(MAXDWORD)
+     || uiVolume * uiDir * 6 * (uiDir - 1) > static_cast<QWORD>(MAXDWORD))
+    {
+        appCrucial(_T("Lattice volume is too large, the index of the links exceeds UINT\n"));
+        _FAIL_EXIT;
+    }
+
     m_InitialCache.constIntegers[ECI_Lx] = static_cast<UINT>(intValues[0]);
     m_InitialCache.constIntegers[ECI_Ly] = static_cast<UINT>(intValues[1]);
     m_InitialCache.constIntegers[ECI_Lz] = static_cast<UINT>(intValues[2]);
     m_InitialCache.constIntegers[ECI_Lt] = static_cast<UINT>(intValues[3]);
-    CCommonData::m_sCenter.x = static_cast<SBYTE>(m_InitialCache.constIntegers[ECI_Lx] / 2);
-    CCommonData::m_sCenter.y = static_cast<SBYTE>(m_InitialCache.constIntegers[ECI_Ly] / 2);
-    CCommonData::m_sCenter.z = static_cast<SBYTE>(m_InitialCache.constIntegers[ECI_Lz] / 2);
-    CCommonData::m_sCenter.w = static_cast<SBYTE>(m_InitialCache.constIntegers[ECI_Lt] / 2);
+    //For the slabs of CDomainDecomposition, the coordinates and the center are of the global lattice
+    __FetchIntWithDefault(_T("XOrigin"), 0);
+    m_InitialCache.constIntegers[ECI_XOrigin] = static_cast<UINT>(iVaules);
+    const INT iXOrigin = iVaules;
+    __FetchIntWithDefault(_T("GlobalLx"), intValues[0]);
+    CCommonData::m_sCenter.x = static_cast<SCOORD>(iVaules / 2 - iXOrigin);
+    CCommonData::m_sCenter.y = static_cast<SCOORD>(m_InitialCache.constIntegers[ECI_Ly] / 2);
+    CCommonData::m_sCenter.z = static_cast<SCOORD>(m_InitialCache.constIntegers[ECI_Lz] / 2);
+    CCommonData::m_sCenter.w = static_cast<SCOORD>(m_InitialCache.constIntegers[ECI_Lt] / 2);
     m_InitialCache.constIntegers[ECI_Volume] = static_cast<UINT>(intValues[0] * intValues[1] * intValues[2] * intValues[3]);
     m_InitialCache.constIntegers[ECI_Volume_xyz] = static_cast<UINT>(intValues[0] * intValues[1] * intValues[2]);
     m_InitialCache.constIntegers[ECI_MultX] = static_cast<UINT>(intValues[1] * intValues[2] * intValues[3]);
@@ -289,7 +316,7 @@ void CCLGLibManager::InitialLatticeAndConstant(CParameters& params)
     m_pCudaHelper->CreateGammaMatrix();
 }
 
-void CCLGLibManager::InitialRandom(CParameters &)
+void CCLGLibManager::InitialRandom(CParameters& params)
 {
     //INT iVaules = 0;
     //CCString sValues;
@@ -302,6 +329,13 @@ void CCLGLibManager::InitialRandom(CParameters &)
     m_pCudaHelper->CopyRandomPointer(m_pLatticeData->m_pDeviceRandom);
     m_pLatticeData->m_uiRandomType = static_cast<UINT>(m_InitialCache.eR);
     m_pLatticeData->m_uiRandomSeed = m_InitialCache.constIntegers[ECI_RandomSeed];
+
+    //For ER_PHILOX_COUNTER, start from (replay) a trajectory
+    INT iTrajectory = 0;
+    if (params.FetchValueINT(_T("RandomTrajectory"), iTrajectory))
+    {
+        m_pLatticeData->m_pRandom->SetTrajectory(static_cast<UINT>(iTrajectory));
+    }
 }
 
 void CCLGLibManager::CreateGaugeField(class CParameters& params) const
@@ -347,10 +381,10 @@ void CCLGLibManager::CreateGaugeField(class CParameters& params) const
     if (params.FetchValueArrayINT(_T("Period"), periodic))
     {
         SBoundCondition bc;
-        bc.m_sPeriodic.x = static_cast<SBYTE>(periodic[0]);
-        bc.m_sPeriodic.y = static_cast<SBYTE>(periodic[1]);
-        bc.m_sPeriodic.z = static_cast<SBYTE>(periodic[2]);
-        bc.m_sPeriodic.w = static_cast<SBYTE>(periodic[3]);
+        bc.m_sPeriodic.x = static_cast<SCOORD>(periodic[0]);
+        bc.m_sPeriodic.y = static_cast<SCOORD>(periodic[1]);
+        bc.m_sPeriodic.z = static_cast<SCOORD>(periodic[2]);
+        bc.m_sPeriodic.w = static_cast<SCOORD>(periodic[3]);
         m_pLatticeData->SetFieldBoundaryCondition(1, bc);
     }
 
@@ -424,10 +458,10 @@ void CCLGLibManager::CreateFermionFields(class CParameters& params) const
     if (params.FetchValueArrayINT(_T("Period"), periodic))
     {
         SBoundCondition bc;
-        bc.m_sPeriodic.x = static_cast<SBYTE>(periodic[0]);
-        bc.m_sPeriodic.y = static_cast<SBYTE>(periodic[1]);
-        bc.m_sPeriodic.z = static_cast<SBYTE>(periodic[2]);
-        bc.m_sPeriodic.w = static_cast<SBYTE>(periodic[3]);
+        bc.m_sPeriodic.x = static_cast<SCOORD>(periodic[0]);
+        bc.m_sPeriodic.y = static_cast<SCOORD>(periodic[1]);
+        bc.m_sPeriodic.z = static_cast<SCOORD>(periodic[2]);
+        bc.m_sPeriodic.w = static_cast<SCOORD>(periodic[3]);
         m_pLatticeData->SetFieldBoundaryCondition(byFieldId, bc);
     }
 
@@ -518,10 +552,10 @@ void CCLGLibManager::CreateOtherGaugeFields(class CParameters& params) const
     if (params.FetchValueArrayINT(_T("Period"), periodic))
     {
         SBoundCondition bc;
-        bc.m_sPeriodic.x = static_cast<SBYTE>(periodic[0]);
-        bc.m_sPeriodic.y = static_cast<SBYTE>(periodic[1]);
-        bc.m_sPeriodic.z = static_cast<SBYTE>(periodic[2]);
-        bc.m_sPeriodic.w = static_cast<SBYTE>(periodic[3]);
+        bc.m_sPeriodic.x = static_cast<SCOORD>(periodic[0]);
+        bc.m_sPeriodic.y = static_cast<SCOORD>(periodic[1]);
+        bc.m_sPeriodic.z = static_cast<SCOORD>(periodic[2]);
+        bc.m_sPeriodic.w = static_cast<SCOORD>(periodic[3]);
         m_pLatticeData->SetFieldBoundaryCondition(byFieldId, bc);
     }
 
@@ -581,6 +615,14 @@ void CCLGLibManager::CreateIndexAndBoundary(class CParameters& params) const
 
     appGeneral(_T("Create the index %s\n"), sValues.c_str());
 
+    INT iVaules = 0;
+    __FetchIntWithDefault(_T("DirectStencil"), 1);
+    pIndex->SetDirectStencil(0 != iVaules);
+    if (pIndex->m_bDirectStencil)
+    {
+        appGeneral(_T("The neighbours on torus are computed directly in the staple, plaqutte and Wilson kernels\n"));
+    }
+
     //Index Cache
     m_pLatticeData->m_pIndexCache = new CIndexData();
 }
@@ -646,6 +688,11 @@ void CCLGLibManager::CreateUpdator(class CParameters& params) const
         pHMC->m_pIntegrator = integrator;
         m_pLatticeData->m_pUpdator = pHMC;
     }
+    else if (NULL != updator && EUT_Heatbath == updator->GetUpdatorType())
+    {
+        updator->Initial(m_pLatticeData, params);
+        m_pLatticeData->m_pUpdator = updator;
+    }
     else
     {
         appCrucial(_T("Failed to create Updator! s = %s"), sValues.c_str());
@@ -747,6 +794,116 @@ void CCLGLibManager::CreateGaugeFixing(class CParameters& params) const
 
 #pragma region Caches
 
+/**
+* The key of the baked tables:
+* lattice, index and boundary condition class, boundary condition of fields,
+* field ids (gauge or not) and whether there is staggered fermion
+*/
+CCString CCLGLibManager::GetIndexCacheFileName() const
+{
+    TArray<BYTE> key;
+    //eta depends on the parity of the x origin
+    const UINT uiLattice[8] = { 2, _HC_Dim, _HC_Dir, _HC_Lx, _HC_Ly, _HC_Lz, _HC_Lt, static_cast<UINT>(_HC_XOrigin) & 1 };
+    INT iStart = key.AddSize(static_cast<INT>(sizeof(UINT) * 8));
+    memcpy(key.GetData() + iStart, uiLattice, sizeof(UINT) * 8);
+
+    //the staple, plaqutte, move and eta tables are not in the cache for the direct stencil
+    const CCString sClasses = CCString(m_pLatticeData->m_pIndex->GetClass()->GetName())
+        + _T("_") + m_pLatticeData->m_pIndex->m_pBoundaryCondition->GetClass()->GetName()
+        + (OnlyDirectStencil() ? _T("_Direct") : _T(""));
+    iStart = key.AddSize(sClasses.GetLength());
+    memcpy(key.GetData() + iStart, sClasses.c_str(), sClasses.GetLength());
+
+    for (BYTE i = 1; i < kMaxFieldCount; ++i)
+    {
+        const CField* pField = m_pLatticeData->GetFieldById(i);
+        if (NULL != pField)
+        {
+            const SSmallInt4& bc = m_pLatticeData->m_pIndex->m_pBoundaryCondition->GetFieldBC(i);
+            const BYTE byField[6] = {
+                i,
+                static_cast<BYTE>(pField->IsGaugeField() ? 1 : 0)
+              | static_cast<BYTE>((NULL != dynamic_cast<const CFieldFermionKS*>(pField)) ? 2 : 0),
+                static_cast<BYTE>(bc.x), static_cast<BYTE>(bc.y), static_cast<BYTE>(bc.z), static_cast<BYTE>(bc.w) };
+            iStart = key.AddSize(6);
+            memcpy(key.GetData() + iStart, byField, 6);
+        }
+    }
+
+    return m_InitialCache.sIndexCacheDirectory + _T("/IDX_")
+        + CLGMD5Hash(key.GetData(), static_cast<UINT>(key.Num())) + _T(".idx");
+}
+
+static UBOOL _isClass(const CBase* pObject, const TCHAR* sClassName)
+{
+    return NULL != pObject && 0 == appStrcmp(pObject->GetClass()->GetName(), sClassName);
+}
+
+/**
+* TRUE if all fields, actions, measurements and the updator only launch the kernels
+* with a direct stencil version (see CIndex::UseDirectStencil), so the staple, plaqutte,
+* move and eta tables are not baked. The derived classes are not listed, they may read the tables.
+* "BakeStencilTables : 1" bakes them anyway, for the programs calling other functions
+*/
+UBOOL CCLGLibManager::OnlyDirectStencil() const
+{
+    if (m_InitialCache.bBakeStencilTables
+     || NULL == m_pLatticeData->m_pIndex
+     || !m_pLatticeData->m_pIndex->UseDirectStencil(1)
+     || !_isClass(m_pLatticeData->m_pGaugeField, _T("CFieldGaugeSU3"))
+     || m_pLatticeData->m_pAllBoundaryFields.Num() > 0
+     || NULL != m_pLatticeData->m_pGaugeSmearing
+     || NULL != m_pLatticeData->m_pGaugeFixing)
+    {
+        return FALSE;
+    }
+
+    if (NULL != m_pLatticeData->m_pUpdator && !_isClass(m_pLatticeData->m_pUpdator, _T("CHMC")))
+    {
+        return FALSE;
+    }
+
+    for (INT i = 0; i < m_pLatticeData->m_pOtherFields.Num(); ++i)
+    {
+        const CField* pField = m_pLatticeData->m_pOtherFields[i];
+        if (_isClass(pField, _T("CFieldFermionWilsonSquareSU3")))
+        {
+            continue;
+        }
+        const CFieldFermionKS* pKS = dynamic_cast<const CFieldFermionKS*>(pField);
+        if (_isClass(pField, _T("CFieldFermionKSSU3")) && !pKS->m_bEachSiteEta)
+        {
+            continue;
+        }
+        return FALSE;
+    }
+
+    for (INT i = 0; i < m_pLatticeData->m_pActionList.Num(); ++i)
+    {
+        const CAction* pAction = m_pLatticeData->m_pActionList[i];
+        const CActionGaugePlaquette* pPlaqutte = dynamic_cast<const CActionGaugePlaquette*>(pAction);
+        if ((_isClass(pAction, _T("CActionGaugePlaquette")) && !pPlaqutte->m_bCloverEnergy)
+         || _isClass(pAction, _T("CActionFermionWilsonNf2"))
+         || _isClass(pAction, _T("CActionFermionKS")))
+        {
+            continue;
+        }
+        return FALSE;
+    }
+
+    if (NULL != m_pLatticeData->m_pMeasurements)
+    {
+        for (INT i = 0; i < m_pLatticeData->m_pMeasurements->m_lstAllMeasures.Num(); ++i)
+        {
+            if (!_isClass(m_pLatticeData->m_pMeasurements->m_lstAllMeasures[i], _T("CMeasurePlaqutteEnergy")))
+            {
+                return FALSE;
+            }
+        }
+    }
+    return TRUE;
+}
+
 void CCLGLibManager::InitialIndexBuffer() const
 {
     if (NULL == m_pLatticeData->m_pIndexCache)
@@ -755,8 +912,30 @@ void CCLGLibManager::InitialIndexBuffer() const
         return;
     }
 
+    if (!m_InitialCache.sIndexCacheDirectory.IsEmpty())
+    {
+        const CCString sFileName = GetIndexCacheFileName();
+        if (m_pLatticeData->m_pIndexCache->LoadCache(sFileName))
+        {
+            appGeneral(_T("Index tables loaded from %s\n"), sFileName.c_str());
+            m_pLatticeData->m_pIndexCache->m_sCacheFile = sFileName;
+            m_pLatticeData->m_pIndexCache->m_bLoadedFromCache = TRUE;
+            m_pLatticeData->m_pIndex->CalculateSiteCount(m_pLatticeData->m_pIndexCache);
+            m_pCudaHelper->SetDeviceIndex(m_pLatticeData->m_pIndexCache);
+            return;
+        }
+
+        //a broken cache may leave some tables allocated
+        appSafeDelete(m_pLatticeData->m_pIndexCache);
+        m_pLatticeData->m_pIndexCache = new CIndexData();
+    }
+
     m_pLatticeData->m_pIndex->BakeAllIndexBuffer(m_pLatticeData->m_pIndexCache);
-    if (NULL != m_pLatticeData->m_pGaugeField)
+    if (OnlyDirectStencil())
+    {
+        appGeneral(_T("Only the direct stencil is used, the staple, plaqutte, move and eta tables are not baked\n"));
+    }
+    else if (NULL != m_pLatticeData->m_pGaugeField)
     {
         UBOOL bHasStaggeredFermion = FALSE;
         assert(1 == m_pLatticeData->m_pGaugeField->m_byFieldId);
@@ -781,6 +960,20 @@ void CCLGLibManager::InitialIndexBuffer() const
     }
     m_pLatticeData->m_pIndex->CalculateSiteCount(m_pLatticeData->m_pIndexCache);
 
+    if (!m_InitialCache.sIndexCacheDirectory.IsEmpty())
+    {
+        const CCString sFileName = GetIndexCacheFileName();
+        m_pLatticeData->m_pIndexCache->m_sCacheFile = sFileName;
+        if (m_pLatticeData->m_pIndexCache->SaveCache(sFileName))
+        {
+            appGeneral(_T("Index tables saved to %s\n"), sFileName.c_str());
+        }
+        else
+        {
+            appGeneral(_T("Failed to save index tables to %s, is the directory created?\n"), sFileName.c_str());
+        }
+    }
+
     m_pCudaHelper->SetDeviceIndex(m_pLatticeData->m_pIndexCache);
 }
 
@@ -788,10 +981,65 @@ void CCLGLibManager::InitialIndexBuffer() const
 
 UBOOL CCLGLibManager::InitialWithParameter(CParameters &params)
 {
+    if (NULL == m_pFileSystem)
+    {
+        m_pFileSystem = new CFileSystem();
+
+        INT iProfile = 0;
+        params.FetchValueINT(_T("Profile"), iProfile);
+        if (0 != iProfile)
+        {
+#if _CLG_PROFILE
+            CCString sProfileFile = _T("profile.json");
+            params.FetchStringValue(_T("ProfileOutput"), sProfileFile);
+            INT iMaxTrace = 100000;
+            params.FetchValueINT(_T("ProfileMaxTrace"), iMaxTrace);
+            appInitialProfiler(sProfileFile, static_cast<UINT>(iMaxTrace));
+#else
+            appGeneral(_T("Profile is ignored, build with _CLG_PROFILE = 1 to enable it.\n"));
+#endif
+        }
+
+        INT iLaunchTune = 0;
+        params.FetchValueINT(_T("LaunchTune"), iLaunchTune);
+        if (0 != iLaunchTune)
+        {
+            CCString sTuneFile = _T("LaunchTune.txt");
+            params.FetchStringValue(_T("LaunchTuneFile"), sTuneFile);
+            INT iRepeat = 2;
+            params.FetchValueINT(_T("LaunchTuneRepeat"), iRepeat);
+            appInitialLaunchTuner(sTuneFile, static_cast<UINT>(iRepeat));
+        }
+    }
+
+    //each lattice can choose, EFFTB_Device if not set
+    CCString sFFTBackend = _T("EFFTB_Device");
+    params.FetchStringValue(_T("FFTBackend"), sFFTBackend);
+    CCLGFFTHelper::SetBackend(__STRING_TO_ENUM(EFFT_Backend, sFFTBackend));
+
+    return NULL != CreateContext(params);
+}
+
+CLatticeContext* CCLGLibManager::CreateContext(CParameters& params)
+{
+    //the new context starts from the default common data and constants
+    if (NULL != m_pCurrentContext)
+    {
+        m_pCurrentContext->StoreCommonData();
+    }
+    CLatticeContext* pContext = new CLatticeContext();
+    pContext->RestoreCommonData();
+    m_InitialCache = SCLGLibManangerInitialCache();
+
+    m_pCurrentContext = pContext;
     m_pCudaHelper = new CCudaHelper();
     m_pLatticeData = new CLatticeData();
-    m_pFileSystem = new CFileSystem();
     m_pBuffer = new CCudaBuffer();
+    pContext->m_pCudaHelper = m_pCudaHelper;
+    pContext->m_pLatticeData = m_pLatticeData;
+    pContext->m_pBuffer = m_pBuffer;
+    m_lstContexts.AddItem(pContext);
+
     UBOOL bGaugeBoundaryFieldCreated = FALSE;
     //Allocate Buffer
     Real fBufferSize = F(0.0);
@@ -803,6 +1051,10 @@ UBOOL CCLGLibManager::InitialWithParameter(CParameters &params)
         }
     }
 
+    params.FetchStringValue(_T("IndexCacheDirectory"), m_InitialCache.sIndexCacheDirectory);
+    INT iBakeStencilTables = 0;
+    params.FetchValueINT(_T("BakeStencilTables"), iBakeStencilTables);
+    m_InitialCache.bBakeStencilTables = (0 != iBakeStencilTables);
     InitialLatticeAndConstant(params);
     InitialRandom(params);
     checkCudaErrors(cudaGetLastError());
@@ -944,15 +1196,69 @@ UBOOL CCLGLibManager::InitialWithParameter(CParameters &params)
     checkCudaErrors(cudaGetLastError());
 
     appGeneral(_T("\n =========== Initialized ! ==============\n"));
-    return TRUE;
+    return pContext;
 }
 
-void CCLGLibManager::Quit()
+void CCLGLibManager::SetContext(CLatticeContext* pContext)
 {
+    if (pContext == m_pCurrentContext)
+    {
+        return;
+    }
+
+    if (NULL != m_pCurrentContext)
+    {
+        m_pCurrentContext->StoreCommonData();
+    }
+    m_pCurrentContext = pContext;
+    if (NULL == pContext)
+    {
+        m_pCudaHelper = NULL;
+        m_pLatticeData = NULL;
+        m_pBuffer = NULL;
+        return;
+    }
+
+    m_pCudaHelper = pContext->m_pCudaHelper;
+    m_pLatticeData = pContext->m_pLatticeData;
+    m_pBuffer = pContext->m_pBuffer;
+    pContext->RestoreCommonData();
+    m_pCudaHelper->CopyContextSymbols(m_pLatticeData->m_pDeviceRandom);
+}
+
+void CCLGLibManager::ReleaseContext(CLatticeContext* pContext)
+{
+    if (NULL == pContext || m_lstContexts.FindItemIndex(pContext) < 0)
+    {
+        return;
+    }
+
+    //the fields and solvers use appGetLattice() when deleting
+    CLatticeContext* pRestore = (pContext == m_pCurrentContext) ? NULL : m_pCurrentContext;
+    SetContext(pContext);
+
     appSafeDelete(m_pLatticeData);
     appSafeDelete(m_pCudaHelper);
-    appSafeDelete(m_pFileSystem);
     appSafeDelete(m_pBuffer);
+    m_lstContexts.RemoveItem(pContext);
+    m_pCurrentContext = NULL;
+    appSafeDelete(pContext);
+
+    SetContext(pRestore);
+}
+
+void CCLGLibManager::Quit()
+{
+    //before the device is reset
+    appProfilerReport();
+    appLaunchTunerRelease();
+
+    while (m_lstContexts.Num() > 0)
+    {
+        ReleaseContext(m_lstContexts[m_lstContexts.Num() - 1]);
+    }
+    appSafeDelete(m_pFileSystem);
+    CCLGFFTHelper::ReleasePlans();
 
     INT devCount;
     cudaGetDeviceCount(&devCount);
@@ -975,6 +1281,22 @@ UBOOL CLGAPI appInitialCLG(CParameters& params)
     return GCLGManager.InitialWithParameter(params);
 }
 
+CLatticeContext* CLGAPI appCreateLatticeContext(const TCHAR* paramFileName)
+{
+    CParameters params;
+    CYAMLParser::ParseFile(paramFileName, params);
+    return appCreateLatticeContext(params);
+}
+
+CLatticeContext* CLGAPI appCreateLatticeContext(CParameters& params)
+{
+    if (!GCLGManager.InitialWithParameter(params))
+    {
+        return NULL;
+    }
+    return GCLGManager.m_pCurrentContext;
+}
+
 void CLGAPI appQuitCLG() 
 { 
     GCLGManager.Quit(); 
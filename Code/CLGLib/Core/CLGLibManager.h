@@ -20,6 +20,8 @@ struct CLGAPI SCLGLibManangerInitialCache
     ERandom eR;
     UINT constIntegers[kContentLength];
     Real constFloats[kContentLength];
+    CCString sIndexCacheDirectory;
+    UBOOL bBakeStencilTables;
 };
 
 class CLGAPI CCLGLibManager
@@ -30,6 +32,7 @@ public:
         , m_pLatticeData(NULL)
         , m_pFileSystem(NULL)
         , m_pBuffer(NULL)
+        , m_pCurrentContext(NULL)
         , m_InitialCache()
     {
     }
@@ -46,11 +49,26 @@ public:
     */
     void Quit();
 
+    /**
+    * Create a lattice with the parameters, the new context is current
+    */
+    class CLatticeContext* CreateContext(class CParameters& params);
+    void SetContext(class CLatticeContext* pContext);
+
+    /**
+    * If pContext is current, no context is current after release
+    */
+    void ReleaseContext(class CLatticeContext* pContext);
+
+    //Those are the pointers of the current context
     class CCudaHelper* m_pCudaHelper;
     class CLatticeData* m_pLatticeData;
     class CFileSystem* m_pFileSystem;
     class CCudaBuffer* m_pBuffer;
 
+    class CLatticeContext* m_pCurrentContext;
+    TArray<class CLatticeContext*> m_lstContexts;
+
     void SetupLog(class CParameters& params);
 
 protected:
@@ -85,6 +103,8 @@ protected:
 
     //Requared
     void InitialIndexBuffer() const;
+    CCString GetIndexCacheFileName() const;
+    UBOOL OnlyDirectStencil() const;
 };
 
 extern CLGAPI CCLGLibManager GCLGManager;
@@ -100,6 +120,28 @@ extern UBOOL CLGAPI appInitialCLG(class CParameters& params);
 extern void CLGAPI appQuitCLG();
 extern void CLGAPI appFailQuitCLG();
 
+/**
+* appInitialCLG creates the first context,
+* more contexts can be created after appInitialCLG, all are released at appQuitCLG
+*/
+extern class CLatticeContext* CLGAPI appCreateLatticeContext(const TCHAR* paramFileName);
+extern class CLatticeContext* CLGAPI appCreateLatticeContext(class CParameters& params);
+
+inline void appSetLatticeContext(class CLatticeContext* pContext)
+{
+    GCLGManager.SetContext(pContext);
+}
+
+inline class CLatticeContext* appGetLatticeContext()
+{
+    return GCLGManager.m_pCurrentContext;
+}
+
+inline void appReleaseLatticeContext(class CLatticeContext* pContext)
+{
+    GCLGManager.ReleaseContext(pContext);
+}
+
 inline class CCudaHelper* appGetCudaHelper()
 {
     return GCLGManager.m_pCudaHelper;
@@ -63,6 +63,29 @@
 #endif
 
 
+//_CLG_PROFILE = 0 or 1.
+//With 1, the regions marked by appProfile are recorded when "Profile : 1" is set in the parameters.
+//With 0, all regions are compiled out.
+#ifndef _CLG_PROFILE
+#define _CLG_PROFILE 1
+#endif
+
+//_CLG_LARGE_LATTICE = 0 or 1.
+//With 0, the coordinates in SSmallInt4 are SBYTE, the lattice length is at most 128 - CIndexData::kCacheIndexEdge.
+//With 1, the coordinates are SWORD (SSmallInt4 is 8 bytes), for long extents such as Lz = 256.
+//The site and link index are always UINT, see CCLGLibManager::InitialLatticeAndConstant for the check.
+#ifndef _CLG_LARGE_LATTICE
+#define _CLG_LARGE_LATTICE 0
+#endif
+
+//_CLG_DIRECT_STENCIL = 0 or 1.
+//With 1, the staple, plaqutte and Wilson Dslash kernels have a version computing the neighbours
+//with coordinates (no SIndex gather), used on torus when "DirectStencil : 1" (default).
+//With 0, always use the baked tables.
+#ifndef _CLG_DIRECT_STENCIL
+#define _CLG_DIRECT_STENCIL 1
+#endif
+
 #endif //#ifndef _CLGSETUP_H_
 
 //=============================================================================
@@ -0,0 +1,73 @@
+//=============================================================================
+// FILENAME : CLatticeContext.cpp
+//
+// DESCRIPTION:
+// This is the class for one lattice (constants, index, fields, solvers...)
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+#include "CLGLib_Private.h"
+
+__BEGIN_NAMESPACE
+
+/**
+* The parameters are same as the initial values of CCommonData
+*/
+CLatticeContext::CLatticeContext()
+    : m_pCudaHelper(NULL)
+    , m_pLatticeData(NULL)
+    , m_pBuffer(NULL)
+    , m_fBeta(F(0.0))
+    , m_fOmega(F(0.0))
+    , m_fKai(F(0.0))
+    , m_bStoreStaple(TRUE)
+    , m_bStoreLastSolution(TRUE)
+    , m_bStochasticGaussian(FALSE)
+    , m_sCenter(0, 0, 0, 0)
+    , m_fG(F(0.0))
+    , m_uiMaxThreadPerBlock(0)
+    , m_fShiftedMass(F(0.0))
+    , m_fBz(F(0.0))
+    , m_fEz(F(0.0))
+{
+
+}
+
+void CLatticeContext::StoreCommonData()
+{
+    m_fBeta = CCommonData::m_fBeta;
+    m_fOmega = CCommonData::m_fOmega;
+    m_fKai = CCommonData::m_fKai;
+    m_bStoreStaple = CCommonData::m_bStoreStaple;
+    m_bStoreLastSolution = CCommonData::m_bStoreLastSolution;
+    m_bStochasticGaussian = CCommonData::m_bStochasticGaussian;
+    m_sCenter = CCommonData::m_sCenter;
+    m_fG = CCommonData::m_fG;
+    m_uiMaxThreadPerBlock = CCommonData::m_uiMaxThreadPerBlock;
+    m_fShiftedMass = CCommonData::m_fShiftedMass;
+    m_fBz = CCommonData::m_fBz;
+    m_fEz = CCommonData::m_fEz;
+}
+
+void CLatticeContext::RestoreCommonData() const
+{
+    CCommonData::m_fBeta = m_fBeta;
+    CCommonData::m_fOmega = m_fOmega;
+    CCommonData::m_fKai = m_fKai;
+    CCommonData::m_bStoreStaple = m_bStoreStaple;
+    CCommonData::m_bStoreLastSolution = m_bStoreLastSolution;
+    CCommonData::m_bStochasticGaussian = m_bStochasticGaussian;
+    CCommonData::m_sCenter = m_sCenter;
+    CCommonData::m_fG = m_fG;
+    CCommonData::m_uiMaxThreadPerBlock = m_uiMaxThreadPerBlock;
+    CCommonData::m_fShiftedMass = m_fShiftedMass;
+    CCommonData::m_fBz = m_fBz;
+    CCommonData::m_fEz = m_fEz;
+}
+
+__END_NAMESPACE
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
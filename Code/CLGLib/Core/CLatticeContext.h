@@ -0,0 +1,77 @@
+//=============================================================================
+// FILENAME : CLatticeContext.h
+//
+// DESCRIPTION:
+// This is the class for one lattice (constants, index, fields, solvers...)
+//
+// Several contexts can be alive in one process, one of them is current.
+// appGetLattice(), appGetCudaHelper() and the __constant__ memory
+// always refer to the current context.
+//
+// appSetLatticeContext re-uploads the constants, the random, index and
+// field pointers of the context, and swaps the commonly used parameters in
+// CCommonData, so switching costs several small memcpy, not a re-initial.
+// The kernels are all on the default stream, so the upload is ordered
+// after the kernels of the previous context.
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#ifndef _CLATTICECONTEXT_H_
+#define _CLATTICECONTEXT_H_
+
+__BEGIN_NAMESPACE
+
+class CLGAPI CLatticeContext
+{
+public:
+    CLatticeContext();
+
+    ~CLatticeContext()
+    {
+
+    }
+
+    /**
+    * Copy the parameters from CCommonData
+    */
+    void StoreCommonData();
+
+    /**
+    * Copy the parameters to CCommonData
+    */
+    void RestoreCommonData() const;
+
+    class CCudaHelper* m_pCudaHelper;
+    class CLatticeData* m_pLatticeData;
+    class CCudaBuffer* m_pBuffer;
+
+protected:
+
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE m_fBeta;
+    DOUBLE m_fOmega;
+#else
+    Real m_fBeta;
+    Real m_fOmega;
+#endif
+    Real m_fKai;
+    UBOOL m_bStoreStaple;
+    UBOOL m_bStoreLastSolution;
+    UBOOL m_bStochasticGaussian;
+    SSmallInt4 m_sCenter;
+    Real m_fG;
+    UINT m_uiMaxThreadPerBlock;
+    Real m_fShiftedMass;
+    Real m_fBz;
+    Real m_fEz;
+};
+
+__END_NAMESPACE
+
+#endif //#ifndef _CLATTICECONTEXT_H_
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
@@ -550,6 +550,21 @@ void CCudaHelper::SetFieldPointers()
     checkCudaErrors(cudaMemcpyToSymbol(__boundaryFieldPointers, m_deviceBoundaryFieldPointers, sizeof(CFieldBoundary*) * kMaxFieldCount));
 }
 
+/**
+* The symbols are shared by all contexts, so they are uploaded at every switch.
+* The copies are queued on the default stream (the pageable sources are staged at the call),
+* so a switch does not wait for the device, the kernels after it see the new symbols
+*/
+void CCudaHelper::CopyContextSymbols(const CRandom* r) const
+{
+    checkCudaErrors(cudaMemcpyToSymbolAsync(_constIntegers, m_ConstIntegers, sizeof(UINT) * kContentLength));
+    checkCudaErrors(cudaMemcpyToSymbolAsync(_constFloats, m_ConstFloats, sizeof(Real) * kContentLength));
+    checkCudaErrors(cudaMemcpyToSymbolAsync(__r, &r, sizeof(CRandom*)));
+    checkCudaErrors(cudaMemcpyToSymbolAsync(__idx, &m_pDevicePtrIndexData, sizeof(CIndexData*)));
+    checkCudaErrors(cudaMemcpyToSymbolAsync(__fieldPointers, m_deviceFieldPointers, sizeof(CField*) * kMaxFieldCount));
+    checkCudaErrors(cudaMemcpyToSymbolAsync(__boundaryFieldPointers, m_deviceBoundaryFieldPointers, sizeof(CFieldBoundary*) * kMaxFieldCount));
+}
+
 TArray<UINT> CCudaHelper::GetMaxThreadCountAndThreadPerblock()
 {
     TArray<UINT> ret;
@@ -611,12 +626,22 @@ void CCudaHelper::AllocateTemeraryBuffers(UINT uiThreadCount)
 #if !_CLG_DOUBLEFLOAT
 cuDoubleComplex CCudaHelper::ThreadBufferSum(cuDoubleComplex* pDeviceBuffer)
 {
-    return ReduceComplexWithThreadCount(pDeviceBuffer);
+    if (NULL == m_pDomainDecomposition)
+    {
+        return ReduceComplexWithThreadCount(pDeviceBuffer);
+    }
+    m_pDomainDecomposition->ZeroHalo(pDeviceBuffer, static_cast<UINT>(sizeof(cuDoubleComplex)));
+    return m_pDomainDecomposition->AllReduceSum(ReduceComplexWithThreadCount(pDeviceBuffer));
 }
 
 DOUBLE CCudaHelper::ThreadBufferSum(DOUBLE* pDeviceBuffer)
 {
-    return ReduceRealWithThreadCount(pDeviceBuffer);
+    if (NULL == m_pDomainDecomposition)
+    {
+        return ReduceRealWithThreadCount(pDeviceBuffer);
+    }
+    m_pDomainDecomposition->ZeroHalo(pDeviceBuffer, static_cast<UINT>(sizeof(DOUBLE)));
+    return m_pDomainDecomposition->AllReduceSum(ReduceRealWithThreadCount(pDeviceBuffer));
 }
 
 void CCudaHelper::ThreadBufferZero(cuDoubleComplex* pDeviceBuffer, cuDoubleComplex cInitial) const
@@ -701,12 +726,22 @@ cuDoubleComplex CCudaHelper::ReduceComplexWithThreadCount(cuDoubleComplex* devic
 */
 CLGComplex CCudaHelper::ThreadBufferSum(CLGComplex * pDeviceBuffer)
 {
-    return ReduceComplexWithThreadCount(pDeviceBuffer);
+    if (NULL == m_pDomainDecomposition)
+    {
+        return ReduceComplexWithThreadCount(pDeviceBuffer);
+    }
+    m_pDomainDecomposition->ZeroHalo(pDeviceBuffer, static_cast<UINT>(sizeof(CLGComplex)));
+    return m_pDomainDecomposition->AllReduceSum(ReduceComplexWithThreadCount(pDeviceBuffer));
 }
 
 Real CCudaHelper::ThreadBufferSum(Real * pDeviceBuffer)
 {
-    return ReduceRealWithThreadCount(pDeviceBuffer);
+    if (NULL == m_pDomainDecomposition)
+    {
+        return ReduceRealWithThreadCount(pDeviceBuffer);
+    }
+    m_pDomainDecomposition->ZeroHalo(pDeviceBuffer, static_cast<UINT>(sizeof(Real)));
+    return m_pDomainDecomposition->AllReduceSum(ReduceRealWithThreadCount(pDeviceBuffer));
 }
 
 void CCudaHelper::ThreadBufferZero(CLGComplex * pDeviceBuffer, CLGComplex cInitial) const
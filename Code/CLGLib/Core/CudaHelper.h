@@ -102,6 +102,7 @@ enum EConstIntId
     ECI_SummationDecompose,
     ECI_UseLogADefinition, // A = U.TA() ? or A = Log(U)
     ECI_OtherGaugeField,
+    ECI_XOrigin, //(INT) the global x of local x = 0, for the slabs of CDomainDecomposition
 
     ECI_ForceDWORD = 0x7fffffff,
 };
@@ -116,6 +117,7 @@ class CLGAPI CCudaHelper
 public:
     CCudaHelper()
         : m_pDevicePtrIndexData(NULL)
+        , m_pDomainDecomposition(NULL)
     {
         memset(m_ConstIntegers, 0, sizeof(UINT) * kContentLength);
         memset(m_ConstFloats, 0, sizeof(Real) * kContentLength);
@@ -153,6 +155,12 @@ public:
     void CopyRandomPointer(const class CRandom* r) const;
     void SetDeviceIndex(class CIndexData* ppIdx) const;
 
+    /**
+    * Copy the constants, random, index and field pointers (already created) to __constant__
+    * Used when switching the lattice context
+    */
+    void CopyContextSymbols(const class CRandom* r) const;
+
     class CIndexData* m_pDevicePtrIndexData;
 
     //we never need gamma matrix on host, so this is purely hiden in device
@@ -234,6 +242,12 @@ public:
     UINT m_uiThreadCount;
     UINT m_uiReducePower;
 
+    /**
+    * Set by CDomainDecomposition::Attach, ThreadBufferSum only sums the interior sites
+    * and then sums over the ranks
+    */
+    class CDomainDecomposition* m_pDomainDecomposition;
+
     #pragma endregion
 };
 
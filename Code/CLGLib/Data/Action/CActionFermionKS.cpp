@@ -16,9 +16,22 @@ __CLGIMPLEMENT_CLASS(CActionFermionKS)
 
 CActionFermionKS::CActionFermionKS()
     : CAction()
+    , m_pFerimionField(NULL)
+    , m_uiNthRoot(1)
+    , m_pEnergyField(NULL)
 {
 }
 
+CActionFermionKS::~CActionFermionKS()
+{
+    for (INT i = 0; i < m_lstPseudoFermions.Num(); ++i)
+    {
+        appSafeDelete(m_lstPseudoFermions[i]);
+    }
+    m_lstPseudoFermions.RemoveAll();
+    appSafeDelete(m_pEnergyField);
+}
+
 
 void CActionFermionKS::Initial(CLatticeData* pOwner, const CParameters& param, BYTE byId)
 {
@@ -32,12 +45,77 @@ void CActionFermionKS::Initial(CLatticeData* pOwner, const CParameters& param, B
     if (NULL == m_pFerimionField)
     {
         appCrucial(_T("CActionFermionKS work with only CFieldFermionKS!\n"));
+        return;
+    }
+
+    INT iPseudoFermionCount = 0;
+    param.FetchValueINT(_T("PseudoFermionCount"), iPseudoFermionCount);
+    INT iNthRoot = iPseudoFermionCount > 1 ? iPseudoFermionCount : 1;
+    param.FetchValueINT(_T("NthRoot"), iNthRoot);
+    if (iNthRoot < 1)
+    {
+        appCrucial(_T("CActionFermionKS: NthRoot must >= 1, but set to be %d!\n"), iNthRoot);
+        _FAIL_EXIT;
+    }
+    if (iPseudoFermionCount < 1)
+    {
+        iPseudoFermionCount = iNthRoot;
+    }
+    if (1 == iNthRoot && iPseudoFermionCount > 1)
+    {
+        appCrucial(_T("CActionFermionKS: PseudoFermionCount = %d needs NthRoot = %d, otherwise the determinant is counted %d times!\n"), iPseudoFermionCount, iPseudoFermionCount, iPseudoFermionCount);
+        _FAIL_EXIT;
+    }
+    if (iPseudoFermionCount > iNthRoot)
+    {
+        appCrucial(_T("CActionFermionKS: PseudoFermionCount = %d must <= NthRoot = %d!\n"), iPseudoFermionCount, iNthRoot);
+        _FAIL_EXIT;
+    }
+    m_uiNthRoot = static_cast<UINT>(iNthRoot);
+
+    if (1 == iPseudoFermionCount && 1 == iNthRoot)
+    {
+        return;
     }
+
+    //Since the rational approximations are changed, the pseudofermions cannot be the field itself
+    TArray<Real> md;
+    TArray<Real> mc;
+    if (m_uiNthRoot > 1)
+    {
+        if (!param.FetchValueArrayReal(_T("MD"), md) || !param.FetchValueArrayReal(_T("MC"), mc))
+        {
+            appCrucial(_T("CActionFermionKS: NthRoot = %d, MD and MC of the n-th root must be set!\n"), iNthRoot);
+            _FAIL_EXIT;
+        }
+    }
+
+    for (INT i = 0; i < iPseudoFermionCount; ++i)
+    {
+        CFieldFermionKS* pPhi = dynamic_cast<CFieldFermionKS*>(m_pFerimionField->GetCopy());
+        if (m_uiNthRoot > 1)
+        {
+            pPhi->SetRationalApproximation(md, mc);
+        }
+        m_lstPseudoFermions.AddItem(pPhi);
+    }
+    m_pEnergyField = dynamic_cast<CFieldFermionKS*>(m_lstPseudoFermions[0]->GetCopy());
+
+    appGeneral(_T("CActionFermionKS: %d pseudofermions, each is %d-th root\n"), iPseudoFermionCount, iNthRoot);
 }
 
 void CActionFermionKS::PrepareForHMC(const CFieldGauge* pGauge, UINT )
 {
-    m_pFerimionField->PrepareForHMC(pGauge);
+    if (0 == m_lstPseudoFermions.Num())
+    {
+        m_pFerimionField->PrepareForHMC(pGauge);
+        return;
+    }
+
+    for (INT i = 0; i < m_lstPseudoFermions.Num(); ++i)
+    {
+        m_lstPseudoFermions[i]->PrepareForHMC(pGauge);
+    }
 }
 
 /**
@@ -45,7 +123,21 @@ void CActionFermionKS::PrepareForHMC(const CFieldGauge* pGauge, UINT )
 */
 UBOOL CActionFermionKS::CalculateForceOnGauge(const CFieldGauge* pGauge, CFieldGauge* pForce, CFieldGauge * /*staple*/, ESolverPhase ePhase) const
 {
-    return m_pFerimionField->CalculateForce(pGauge, pForce, ePhase);
+    if (0 == m_lstPseudoFermions.Num())
+    {
+        return m_pFerimionField->CalculateForce(pGauge, pForce, ePhase);
+    }
+
+    //force is additive
+    UBOOL bRet = TRUE;
+    for (INT i = 0; i < m_lstPseudoFermions.Num(); ++i)
+    {
+        if (!m_lstPseudoFermions[i]->CalculateForce(pGauge, pForce, ePhase))
+        {
+            bRet = FALSE;
+        }
+    }
+    return bRet;
 }
 
 #if !_CLG_DOUBLEFLOAT
@@ -62,24 +154,44 @@ Real CActionFermionKS::Energy(UBOOL , const CFieldGauge* pGauge, const CFieldGau
     //pPooled->D_EN(pGauge);
     //const CLGComplex res = pPooled->Dot(pPooled);
 
-    CFieldFermionKS* pPooled = dynamic_cast<CFieldFermionKS*>(appGetLattice()->GetPooledFieldById(static_cast<BYTE>(m_pFerimionField->m_byFieldId)));
-    m_pFerimionField->CopyTo(pPooled);
-    pPooled->D_MD(pGauge);
 #if !_CLG_DOUBLEFLOAT
-    const cuDoubleComplex res = pPooled->Dot(m_pFerimionField);
+    cuDoubleComplex res = make_cuDoubleComplex(0.0, 0.0);
 #else
-    const CLGComplex res = pPooled->Dot(m_pFerimionField);
+    CLGComplex res = _zeroc;
 #endif
 
-    appDetailed(_T("CActionFermionKS : Energy = %f%s%fi\n"), res.x, res.y > 0 ? "+" : " ", res.y);
+    if (0 == m_lstPseudoFermions.Num())
+    {
+        CFieldFermionKS* pPooled = dynamic_cast<CFieldFermionKS*>(appGetLattice()->GetPooledFieldById(static_cast<BYTE>(m_pFerimionField->m_byFieldId)));
+        m_pFerimionField->CopyTo(pPooled);
+        pPooled->D_MD(pGauge);
+        res = pPooled->Dot(m_pFerimionField);
+        pPooled->Return();
+    }
+    else
+    {
+        //m_pEnergyField already has the n-th root approximation, only the data is copied
+        for (INT i = 0; i < m_lstPseudoFermions.Num(); ++i)
+        {
+            appFieldAssign(m_pEnergyField, appField(m_lstPseudoFermions[i]));
+            m_pEnergyField->D_MD(pGauge);
+#if !_CLG_DOUBLEFLOAT
+            res = cuCadd(res, m_pEnergyField->Dot(m_lstPseudoFermions[i]));
+#else
+            res = _cuCaddf(res, m_pEnergyField->Dot(m_lstPseudoFermions[i]));
+#endif
+        }
+    }
 
-    pPooled->Return();
+    appDetailed(_T("CActionFermionKS : Energy = %f%s%fi\n"), res.x, res.y > 0 ? "+" : " ", res.y);
     return res.x;
 }
 
 CCString CActionFermionKS::GetInfos(const CCString &tab) const
 {
     CCString sRet = tab + _T("Name : CFieldFermionKSSU3\n");
+    sRet = sRet + tab + _T("NthRoot : ") + appIntToString(static_cast<INT>(m_uiNthRoot)) + _T("\n");
+    sRet = sRet + tab + _T("PseudoFermionCount : ") + appIntToString(appMax(1, m_lstPseudoFermions.Num())) + _T("\n");
     return sRet;
 }
 
@@ -5,8 +5,15 @@
 // This is a naive KS fermion action, for Nf=1 or 2, or 1+1 etc,
 // Fermions are independent, not optimized for Nf=2+1 with a heavy fermion
 //
+// The determinant can be splitted into n-th roots, each with its own pseudofermion
+// det(D^+D)^{a} = [det(D^+D)^{a/n}]^n
+// Set "NthRoot : n" and the lower degree "MD", "MC" approximating x^{-a/n}, x^{a/2n}
+// "PseudoFermionCount : m" is the number of pseudofermions in this action (default n)
+// So the n copies can be in one action or in several actions on different nested levels
+//
 // REVISION:
 //  [06/30/2020 nbale]
+//  [10/19/2026 nbale] nth-root splitting with multiple pseudofermions
 //=============================================================================
 
 #ifndef _CACTIONFERMIONKS_H_
@@ -26,6 +33,7 @@ public:
     * Make sure this is called after lattice and fields are created.
     */
     CActionFermionKS();
+    ~CActionFermionKS();
 
 #if !_CLG_DOUBLEFLOAT
     DOUBLE Energy(UBOOL bBeforeEvolution, const class CFieldGauge* pGauge, const class CFieldGauge* pStable = NULL) override;
@@ -38,6 +46,19 @@ public:
     CCString GetInfos(const CCString &tab) const override;
     UBOOL IsFermion() const override { return TRUE; }
     class CFieldFermionKS* m_pFerimionField;
+
+protected:
+
+    /**
+     * Empty when NthRoot = 1 and PseudoFermionCount = 1, m_pFerimionField is used
+     */
+    TArray<class CFieldFermionKS*> m_lstPseudoFermions;
+    UINT m_uiNthRoot;
+
+    /**
+     * Has the n-th root approximation, to calculate the energy of the pseudofermions
+     */
+    class CFieldFermionKS* m_pEnergyField;
 };
 
 __END_NAMESPACE
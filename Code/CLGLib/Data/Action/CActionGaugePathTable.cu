@@ -0,0 +1,241 @@
+//=============================================================================
+// FILENAME : CActionGaugePathTable.cu
+// 
+// DESCRIPTION:
+//
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+#include "CLGLib_Private.h"
+
+__BEGIN_NAMESPACE
+
+__CLGIMPLEMENT_CLASS(CActionGaugePathTable)
+
+CActionGaugePathTable::CActionGaugePathTable()
+    : CAction()
+    , m_bShiftHalfCoord(FALSE)
+    , m_fLastEnergy(F(0.0))
+    , m_fNewEnergy(F(0.0))
+    , m_fBetaOverN(F(0.1))
+{
+}
+
+void CActionGaugePathTable::Initial(class CLatticeData* pOwner, const CParameters& param, BYTE byId)
+{
+    m_pOwner = pOwner;
+    m_byActionId = byId;
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE fBeta = 0.1;
+    param.FetchValueDOUBLE(_T("Beta"), fBeta);
+#else
+    Real fBeta = F(0.1);
+    param.FetchValueReal(_T("Beta"), fBeta);
+#endif
+    SetBeta(fBeta);
+
+    INT iShiftCoord = 0;
+    param.FetchValueINT(_T("ShiftCoord"), iShiftCoord);
+    m_bShiftHalfCoord = (0 != iShiftCoord);
+
+    //c0 = 1 - 8 c1
+    Real fPlaqutte = F(0.0);
+    Real fRectangle = F(0.0);
+    CCString sPreset = _T("EGPP_None");
+    param.FetchStringValue(_T("Preset"), sPreset);
+    const EGaugePathPreset ePreset = __STRING_TO_ENUM(EGaugePathPreset, sPreset);
+    switch (ePreset)
+    {
+    case EGPP_None:
+        break;
+    case EGPP_Wilson:
+        fPlaqutte = F(1.0);
+        break;
+    case EGPP_Iwasaki:
+        fRectangle = F(-0.331);
+        break;
+    case EGPP_Symanzik:
+        fRectangle = F(-1.0) / F(12.0);
+        break;
+    case EGPP_DBW2:
+        fRectangle = F(-1.4088);
+        break;
+    default:
+        appCrucial(_T("CActionGaugePathTable: preset %s not supported!\n"), sPreset.c_str());
+        break;
+    }
+    UBOOL bPlaqutte = (EGPP_None != ePreset);
+    UBOOL bRectangle = (EGPP_None != ePreset) && (EGPP_Wilson != ePreset);
+    if (bRectangle)
+    {
+        fPlaqutte = F(1.0) - F(8.0) * fRectangle;
+    }
+
+    Real fCoefficient = F(0.0);
+    if (param.FetchValueReal(_T("PlaqutteCoefficient"), fCoefficient))
+    {
+        fPlaqutte = fCoefficient;
+        bPlaqutte = TRUE;
+    }
+    if (param.FetchValueReal(_T("RectangleCoefficient"), fCoefficient))
+    {
+        fRectangle = fCoefficient;
+        bRectangle = TRUE;
+    }
+
+    if (bPlaqutte)
+    {
+        TArray<INT> plaqutte;
+        plaqutte.AddItem(1);
+        plaqutte.AddItem(2);
+        plaqutte.AddItem(-1);
+        plaqutte.AddItem(-2);
+        m_cTable.AddSymmetricLoops(plaqutte, fPlaqutte);
+    }
+
+    if (bRectangle)
+    {
+        TArray<INT> rectangle;
+        rectangle.AddItem(1);
+        rectangle.AddItem(1);
+        rectangle.AddItem(2);
+        rectangle.AddItem(-1);
+        rectangle.AddItem(-1);
+        rectangle.AddItem(-2);
+        m_cTable.AddSymmetricLoops(rectangle, fRectangle);
+    }
+
+    INT iPathCount = 0;
+    param.FetchValueINT(_T("PathCount"), iPathCount);
+    for (INT i = 0; i < iPathCount; ++i)
+    {
+        TArray<INT> path;
+        CCString sKey;
+        sKey.Format(_T("Path%d"), i);
+        if (!param.FetchValueArrayINT(sKey, path))
+        {
+            appCrucial(_T("CActionGaugePathTable: %s not found!\n"), sKey.c_str());
+            continue;
+        }
+
+        fCoefficient = F(1.0);
+        sKey.Format(_T("Coefficient%d"), i);
+        param.FetchValueReal(sKey, fCoefficient);
+
+        CCString sType = _T("EGPC_Constant");
+        sKey.Format(_T("CoefficientType%d"), i);
+        param.FetchStringValue(sKey, sType);
+        const EGaugePathCoefficient eType = __STRING_TO_ENUM(EGaugePathCoefficient, sType);
+
+        INT iAverage = 0;
+        sKey.Format(_T("AverageSites%d"), i);
+        param.FetchValueINT(sKey, iAverage);
+
+        INT iSymmetric = 0;
+        sKey.Format(_T("Symmetric%d"), i);
+        param.FetchValueINT(sKey, iSymmetric);
+
+        if (0 != iSymmetric)
+        {
+            m_cTable.AddSymmetricLoops(path, fCoefficient, eType, 0 != iAverage);
+        }
+        else
+        {
+            m_cTable.AddLoop(path, fCoefficient, eType, 0 != iAverage);
+        }
+    }
+
+    m_cTable.Compile();
+}
+
+#if !_CLG_DOUBLEFLOAT
+void CActionGaugePathTable::SetBeta(DOUBLE fBeta)
+#else
+void CActionGaugePathTable::SetBeta(Real fBeta)
+#endif
+{
+    CCommonData::m_fBeta = fBeta;
+    m_fBetaOverN = fBeta / static_cast<DOUBLE>(_HC_SUN);
+}
+
+void CActionGaugePathTable::PrepareForHMC(const CFieldGauge* pGauge, UINT uiUpdateIterate)
+{
+    if (0 == uiUpdateIterate)
+    {
+        m_fLastEnergy = CalculateEnergy(pGauge);
+    }
+}
+
+void CActionGaugePathTable::OnFinishTrajectory(UBOOL bAccepted)
+{
+    if (bAccepted)
+    {
+        m_fLastEnergy = m_fNewEnergy;
+    }
+}
+
+UBOOL CActionGaugePathTable::CalculateForceOnGauge(const CFieldGauge * pGauge, class CFieldGauge * pForce, class CFieldGauge * pStaple, ESolverPhase ePhase) const
+{
+    const CFieldGaugeSU3* pGaugeSU3 = dynamic_cast<const CFieldGaugeSU3*>(pGauge);
+    CFieldGaugeSU3* pForceSU3 = dynamic_cast<CFieldGaugeSU3*>(pForce);
+    if (NULL == pGaugeSU3 || NULL == pForceSU3)
+    {
+        appCrucial(_T("CActionGaugePathTable only work with SU3 now.\n"));
+        return TRUE;
+    }
+
+    m_cTable.Force(pGaugeSU3, pForceSU3, static_cast<Real>(m_fBetaOverN), CCommonData::m_sCenter, 
+        m_bShiftHalfCoord ? F(0.5) : F(0.0));
+
+    checkCudaErrors(cudaDeviceSynchronize());
+    return TRUE;
+}
+
+#if !_CLG_DOUBLEFLOAT
+DOUBLE CActionGaugePathTable::CalculateEnergy(const class CFieldGauge* pGauge) const
+#else
+Real CActionGaugePathTable::CalculateEnergy(const class CFieldGauge* pGauge) const
+#endif
+{
+    const CFieldGaugeSU3* pGaugeSU3 = dynamic_cast<const CFieldGaugeSU3*>(pGauge);
+    if (NULL == pGaugeSU3)
+    {
+        appCrucial(_T("CActionGaugePathTable only work with SU3 now.\n"));
+        return F(0.0);
+    }
+    return m_cTable.Energy(pGaugeSU3, m_fBetaOverN, CCommonData::m_sCenter, 
+        m_bShiftHalfCoord ? F(0.5) : F(0.0));
+}
+
+#if !_CLG_DOUBLEFLOAT
+DOUBLE CActionGaugePathTable::Energy(UBOOL bBeforeEvolution, const class CFieldGauge* pGauge, const class CFieldGauge* pStable)
+#else
+Real CActionGaugePathTable::Energy(UBOOL bBeforeEvolution, const class CFieldGauge* pGauge, const class CFieldGauge* pStable)
+#endif
+{
+    if (bBeforeEvolution)
+    {
+        return m_fLastEnergy;
+    }
+    m_fNewEnergy = CalculateEnergy(pGauge);
+    return m_fNewEnergy;
+}
+
+CCString CActionGaugePathTable::GetInfos(const CCString &tab) const
+{
+    CCString sRet;
+    sRet = tab + _T("Name : CActionGaugePathTable\n");
+    sRet = sRet + tab + _T("Beta : ") + appFloatToString(CCommonData::m_fBeta) + _T("\n");
+    sRet = sRet + tab + _T("ShiftCoord : ") + (m_bShiftHalfCoord ? _T("1\n") : _T("0\n"));
+    sRet = sRet + tab + _T("LoopCount : ") + appIntToString(static_cast<INT>(m_cTable.GetLoopCount())) + _T("\n");
+    sRet = sRet + m_cTable.GetInfos(tab);
+    return sRet;
+}
+
+__END_NAMESPACE
+
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
@@ -0,0 +1,93 @@
+//=============================================================================
+// FILENAME : CActionGaugePathTable.h
+// 
+// DESCRIPTION:
+// The gauge action given by a list of closed paths (see CGaugePathTable)
+//
+// Beta : beta
+// Preset : EGPP_Wilson, EGPP_Iwasaki, EGPP_Symanzik, EGPP_DBW2, set c0 and c1 with c0 = 1 - 8 c1
+// (Wilson: c0=1, c1=0, Iwasaki: c0=3.648, c1=-0.331, 
+//  tree-level Symanzik: c0=5/3, c1=-1/12, DBW2: c0=12.2704, c1=-1.4088)
+// PlaqutteCoefficient : c0 of all plaquttes, [1, 2, -1, -2] and images (overwrite the preset)
+// RectangleCoefficient : c1 of all rectangles, [1, 1, 2, -1, -1, -2] and images (overwrite the preset)
+//
+// PathCount : number of other paths, for each path i,
+//   Path{i} : [1, 2, -1, -2]
+//   Coefficient{i} : c
+//   CoefficientType{i} : EGPC_Constant, EGPC_X, ..., EGPC_R2, f(n) of x, y to the center, EGPC_T, EGPC_T2
+//   AverageSites{i} : 1 for f(n) averaged on sites of the path
+//   Symmetric{i} : 1 for adding all images under rotation and reflection
+// ShiftCoord : 1 for x, y with 1/2 shift
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#ifndef _CACTIONGAUGEPATHTABLE_H_
+#define _CACTIONGAUGEPATHTABLE_H_
+
+__BEGIN_NAMESPACE
+
+__DEFINE_ENUM(EGaugePathPreset,
+
+    EGPP_None,
+    EGPP_Wilson,
+    EGPP_Iwasaki,
+    EGPP_Symanzik,
+    EGPP_DBW2,
+
+    EGPP_ForceDWORD = 0x7fffffff,
+    )
+
+__CLG_REGISTER_HELPER_HEADER(CActionGaugePathTable)
+
+class CLGAPI CActionGaugePathTable : public CAction
+{
+    __CLGDECLARE_CLASS(CActionGaugePathTable)
+public:
+
+    CActionGaugePathTable();
+
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE Energy(UBOOL bBeforeEvolution, const class CFieldGauge* pGauge, const class CFieldGauge* pStable = NULL) override;
+#else
+    Real Energy(UBOOL bBeforeEvolution, const class CFieldGauge* pGauge, const class CFieldGauge* pStable = NULL) override;
+#endif
+    void Initial(class CLatticeData* pOwner, const CParameters& param, BYTE byId) override;
+
+    UBOOL CalculateForceOnGauge(const class CFieldGauge * pGauge, class CFieldGauge * pForce, class CFieldGauge * pStaple, ESolverPhase ePhase) const override;
+    void PrepareForHMC(const CFieldGauge* pGauge, UINT uiUpdateIterate) override;
+    void OnFinishTrajectory(UBOOL bAccepted) override;
+    CCString GetInfos(const CCString &tab) const override;
+
+#if !_CLG_DOUBLEFLOAT
+    void SetBeta(DOUBLE fBeta);
+#else
+    void SetBeta(Real fBeta);
+#endif
+
+    CGaugePathTable m_cTable;
+    UBOOL m_bShiftHalfCoord;
+
+protected:
+
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE CalculateEnergy(const class CFieldGauge* pGauge) const;
+    DOUBLE m_fLastEnergy;
+    DOUBLE m_fNewEnergy;
+    DOUBLE m_fBetaOverN;
+#else
+    Real CalculateEnergy(const class CFieldGauge* pGauge) const;
+    Real m_fLastEnergy;
+    Real m_fNewEnergy;
+    Real m_fBetaOverN;
+#endif
+};
+
+__END_NAMESPACE
+
+#endif //#ifndef _CACTIONGAUGEPATHTABLE_H_
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
@@ -38,8 +38,10 @@ public:
 
 #if !_CLG_DOUBLEFLOAT
     void SetBeta(DOUBLE fBeta);
+    DOUBLE GetBetaOverN() const { return m_fBetaOverN; }
 #else
     void SetBeta(Real fBeta);
+    Real GetBetaOverN() const { return m_fBetaOverN; }
 #endif
     //Real GetEnergyPerPlaqutte() const;
     UBOOL m_bCloverEnergy;
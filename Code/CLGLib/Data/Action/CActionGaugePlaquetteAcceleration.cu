@@ -15,343 +15,6 @@ __BEGIN_NAMESPACE
 __CLGIMPLEMENT_CLASS(CActionGaugePlaquetteAcceleration)
 
 
-#pragma region kernels
-
-
-/**
-* Using plaqutte and (f(n)+f(n+mu)+f(n+nu)+f(n+mu+nu))/4 
-*/
-__global__ void _CLG_LAUNCH_BOUND
-_kernelAdd4PlaqutteTermSU3_Acc(
-    const deviceSU3 * __restrict__ pDeviceData,
-    const SIndex* __restrict__ pCachedPlaqutte,
-    Real betaOverN, Real fGsq,
-#if !_CLG_DOUBLEFLOAT
-    DOUBLE* results
-#else
-    Real* results
-#endif
-)
-{
-    intokernalInt4;
-    UINT plaqLength = __idx->m_pSmallData[CIndexData::kPlaqLengthIdx];
-    UINT plaqCountAll = __idx->m_pSmallData[CIndexData::kPlaqPerSiteIdx] * plaqLength;
-    
-    //i=0: 12
-    //  1: 13
-    //  2: 14
-    //  3: 23
-    //  4: 24
-    //  5: 34
-    //0->2, 1->4
-
-    BYTE idx = 2;
-
-    //Real resThisThread = F(0.0);
-
-    //========================================
-    //find plaqutte 1-4, or 2-4
-    SIndex first = pCachedPlaqutte[idx * plaqLength + uiSiteIndex * plaqCountAll];
-    deviceSU3 toAdd(_deviceGetGaugeBCSU3(pDeviceData, first));
-    if (first.NeedToDagger())
-    {
-        toAdd.Dagger();
-    }
-    for (BYTE j = 1; j < plaqLength; ++j)
-    {
-        first = pCachedPlaqutte[idx * plaqLength + j + uiSiteIndex * plaqCountAll];
-        deviceSU3 toMul(_deviceGetGaugeBCSU3(pDeviceData, first));
-        if (first.NeedToDagger())
-        {
-            toAdd.MulDagger(toMul);
-        }
-        else
-        {
-            toAdd.Mul(toMul);
-        }
-    }
-#if !_CLG_DOUBLEFLOAT
-    results[uiSiteIndex] = static_cast<DOUBLE>(betaOverN * (F(3.0) - toAdd.ReTr()) * _deviceGnAcc(sSite4, fGsq));
-#else
-    results[uiSiteIndex] = betaOverN * (F(3.0) - toAdd.ReTr()) * _deviceGnAcc(sSite4, fGsq);
-#endif
-
-    idx = 4;
-    first = pCachedPlaqutte[idx * plaqLength + uiSiteIndex * plaqCountAll];
-    toAdd = _deviceGetGaugeBCSU3(pDeviceData, first);
-    if (first.NeedToDagger())
-    {
-        toAdd.Dagger();
-    }
-    for (BYTE j = 1; j < plaqLength; ++j)
-    {
-        first = pCachedPlaqutte[idx * plaqLength + j + uiSiteIndex * plaqCountAll];
-        deviceSU3 toMul(_deviceGetGaugeBCSU3(pDeviceData, first));
-        if (first.NeedToDagger())
-        {
-            toAdd.MulDagger(toMul);
-        }
-        else
-        {
-            toAdd.Mul(toMul);
-        }
-    }
-#if !_CLG_DOUBLEFLOAT
-    results[uiSiteIndex] += static_cast<DOUBLE>(betaOverN * (F(3.0) - toAdd.ReTr()) * _deviceGnAcc(sSite4, fGsq));
-#else
-    results[uiSiteIndex] += betaOverN * (F(3.0) - toAdd.ReTr()) * _deviceGnAcc(sSite4, fGsq);
-#endif
-
-}
-
-
-/**
-* 
-*/
-__global__ void _CLG_LAUNCH_BOUND
-_kernelAddChairTermSU3_Chair_Acc(
-    BYTE byFieldId,
-    const deviceSU3 * __restrict__ pDeviceData,
-    Real betaOverN, Real fG,
-#if !_CLG_DOUBLEFLOAT
-    DOUBLE* results
-#else
-    Real* results
-#endif
-)
-{
-    intokernalInt4;
-
-    const UINT uiN = __idx->_deviceGetBigIndex(sSite4);
-
-    betaOverN = F(0.125) * betaOverN;
-
-    //===============
-    //V413
-    const Real fV413 = _deviceChairTerm(pDeviceData, byFieldId, sSite4, 3, 0, 2, uiN);
-
-    //===============
-    //V423
-    const Real fV423 = _deviceChairTerm(pDeviceData, byFieldId, sSite4, 3, 1, 2, uiN);
-
-    results[uiSiteIndex] = (fV413 + fV423) * betaOverN * fG * sSite4.w;
-}
-
-/**
-* 
-*/
-__global__ void _CLG_LAUNCH_BOUND
-_kernelAddForce4PlaqutteTermSU3_Acc(
-    const deviceSU3 * __restrict__ pDeviceData,
-    deviceSU3 *pForceData,
-    Real betaOverN, 
-    Real fGSq,
-    BYTE byFieldId)
-{
-    intokernalInt4;
-
-    const UINT uiBigIdx = __idx->_deviceGetBigIndex(sSite4);
-
-    betaOverN = betaOverN * F(-0.5);
-    #pragma unroll
-    for (UINT idir = 0; idir < 3; ++idir)
-    {
-        if (2 == idir)
-        {
-            //We do not have z, BUT have T
-            idir = 3;
-            UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
-
-            //mu = idir, nu = i = sum _1-3
-            deviceSU3 stap(_deviceStapleTerm_Acc_T(byFieldId, pDeviceData, sSite4, fGSq, uiBigIdx, idir, 0));
-            stap.Add(_deviceStapleTerm_Acc_T(byFieldId, pDeviceData, sSite4, fGSq, uiBigIdx, idir, 1));
-            deviceSU3 force(pDeviceData[linkIndex]);
-            force.MulDagger(stap);
-            force.Ta();
-            force.MulReal(betaOverN);
-            pForceData[linkIndex].Add(force);
-        }
-        else
-        {
-            UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
-
-            //mu = idir, nu = 4, i = mu
-            deviceSU3 stap(_deviceStapleTerm_Acc_XY(pDeviceData, sSite4, fGSq, byFieldId, uiBigIdx, idir, 3));
-            deviceSU3 force(pDeviceData[linkIndex]);
-            force.MulDagger(stap);
-            force.Ta();
-            force.MulReal(betaOverN);
-            pForceData[linkIndex].Add(force);
-        }
-    }
-}
-
-
-/**
-* Split to 6 functions
-*/
-__global__ void _CLG_LAUNCH_BOUND
-_kernelAddForceChairTermSU3_Term413_3_Acc(
-    BYTE byFieldId,
-    const deviceSU3* __restrict__ pDeviceData,
-    deviceSU3* pForceData,
-    Real betaOverN, Real fG)
-{
-    intokernalInt4;
-
-    const UINT uiBigIdx = __idx->_deviceGetBigIndex(sSite4);
-
-    betaOverN = betaOverN * fG * F(0.125);
-
-    //===============
-    //g t V413
-    //add force for rho=3
-    UINT uiLink = _deviceGetLinkIndex(uiSiteIndex, 2);
-    const deviceSU3 staple_term = _deviceStapleChairTerm1_Acc(byFieldId, pDeviceData, sSite4, uiBigIdx,
-        2, 0, 3);
-    deviceSU3 force(pDeviceData[uiLink]);
-    force.MulDagger(staple_term);
-    force.Ta();
-    force.MulReal(betaOverN);
-    pForceData[uiLink].Add(force);
-}
-
-__global__ void _CLG_LAUNCH_BOUND
-_kernelAddForceChairTermSU3_Term413_4_Acc(
-    BYTE byFieldId,
-    const deviceSU3 * __restrict__ pDeviceData,
-    deviceSU3 *pForceData,
-    Real betaOverN, Real fG)
-{
-    intokernalInt4;
-
-    const UINT uiBigIdx = __idx->_deviceGetBigIndex(sSite4);
-
-    betaOverN = betaOverN * fG * F(0.125);
-
-    //===============
-    //g t V413
-    //add force for mu=4
-    UINT uiLink = _deviceGetLinkIndex(uiSiteIndex, 3);
-    const deviceSU3 staple_term = _deviceStapleChairTerm1_Acc(byFieldId, pDeviceData, sSite4, uiBigIdx,
-        3, 0, 2);
-    deviceSU3 force(pDeviceData[uiLink]);
-    force.MulDagger(staple_term);
-    force.Ta();
-    force.MulReal(betaOverN);
-    pForceData[uiLink].Add(force);
-}
-
-__global__ void _CLG_LAUNCH_BOUND
-_kernelAddForceChairTermSU3_Term413_1_Acc(
-    BYTE byFieldId,
-    const deviceSU3 * __restrict__ pDeviceData,
-    deviceSU3 *pForceData,
-    Real betaOverN, Real fG)
-{
-    intokernalInt4;
-
-    const UINT uiBigIdx = __idx->_deviceGetBigIndex(sSite4);
-
-    betaOverN = betaOverN * fG * F(0.125);
-
-    //===============
-    //+x Omega V413
-    //add force for nu=1
-    UINT uiLink = _deviceGetLinkIndex(uiSiteIndex, 0);
-
-    const deviceSU3 staple_term = _deviceStapleChairTerm2_Acc(byFieldId, pDeviceData, sSite4, uiBigIdx,
-        3, 0, 2);
-    deviceSU3 force(pDeviceData[uiLink]);
-    force.MulDagger(staple_term);
-    force.Ta();
-    force.MulReal(betaOverN);
-    pForceData[uiLink].Add(force);
-}
-
-__global__ void _CLG_LAUNCH_BOUND
-_kernelAddForceChairTermSU3_Term423_3_Acc(
-    BYTE byFieldId,
-    const deviceSU3* __restrict__ pDeviceData,
-    deviceSU3* pForceData,
-    Real betaOverN, Real fG)
-{
-    intokernalInt4;
-
-    const UINT uiBigIdx = __idx->_deviceGetBigIndex(sSite4);
-
-    betaOverN = betaOverN * fG * F(0.125);
-
-    //===============
-    //g t V413
-    //add force for rho=3
-    UINT uiLink = _deviceGetLinkIndex(uiSiteIndex, 2);
-    const deviceSU3 staple_term = _deviceStapleChairTerm1_Acc(byFieldId, pDeviceData, sSite4, uiBigIdx,
-        2, 1, 3);
-    deviceSU3 force(pDeviceData[uiLink]);
-    force.MulDagger(staple_term);
-    force.Ta();
-    force.MulReal(betaOverN);
-    pForceData[uiLink].Add(force);
-}
-
-__global__ void _CLG_LAUNCH_BOUND
-_kernelAddForceChairTermSU3_Term423_4_Acc(
-    BYTE byFieldId,
-    const deviceSU3* __restrict__ pDeviceData,
-    deviceSU3* pForceData,
-    Real betaOverN, Real fG)
-{
-    intokernalInt4;
-
-    const UINT uiBigIdx = __idx->_deviceGetBigIndex(sSite4);
-
-    betaOverN = betaOverN * fG * F(0.125);
-
-    //===============
-    //g t V413
-    //add force for mu=4
-    UINT uiLink = _deviceGetLinkIndex(uiSiteIndex, 3);
-    const deviceSU3 staple_term = _deviceStapleChairTerm1_Acc(byFieldId, pDeviceData, sSite4, uiBigIdx,
-        3, 1, 2);
-    deviceSU3 force(pDeviceData[uiLink]);
-    force.MulDagger(staple_term);
-    force.Ta();
-    force.MulReal(betaOverN);
-    pForceData[uiLink].Add(force);
-}
-
-__global__ void _CLG_LAUNCH_BOUND
-_kernelAddForceChairTermSU3_Term423_2_Acc(
-    BYTE byFieldId,
-    const deviceSU3* __restrict__ pDeviceData,
-    deviceSU3* pForceData,
-    Real betaOverN, Real fG)
-{
-    intokernalInt4;
-
-    const UINT uiBigIdx = __idx->_deviceGetBigIndex(sSite4);
-
-    betaOverN = betaOverN * fG * F(0.125);
-
-    //===============
-    //+x Omega V413
-    //add force for nu=1
-    UINT uiLink = _deviceGetLinkIndex(uiSiteIndex, 1);
-
-    const deviceSU3 staple_term = _deviceStapleChairTerm2_Acc(byFieldId, pDeviceData, 
-        sSite4, uiBigIdx,
-        3, 1, 2);
-    deviceSU3 force(pDeviceData[uiLink]);
-    force.MulDagger(staple_term);
-    force.Ta();
-    force.MulReal(betaOverN);
-    pForceData[uiLink].Add(force);
-}
-
-#pragma endregion
-
-
 CActionGaugePlaquetteAcceleration::CActionGaugePlaquetteAcceleration()
     : CAction()
     , m_fLastEnergy(F(0.0))
@@ -396,16 +59,43 @@ void CActionGaugePlaquetteAcceleration::Initial(class CLatticeData* pOwner, cons
     if (centerArray.Num() > 3)
     {
         SSmallInt4 sCenter;
-        sCenter.x = static_cast<SBYTE>(centerArray[0]);
-        sCenter.y = static_cast<SBYTE>(centerArray[1]);
-        sCenter.z = static_cast<SBYTE>(centerArray[2]);
-        sCenter.w = static_cast<SBYTE>(centerArray[3]);
+        sCenter.x = static_cast<SCOORD>(centerArray[0] - _HC_XOrigin);
+        sCenter.y = static_cast<SCOORD>(centerArray[1]);
+        sCenter.z = static_cast<SCOORD>(centerArray[2]);
+        sCenter.w = static_cast<SCOORD>(centerArray[3]);
         CCommonData::m_sCenter = sCenter;
     }
     else
     {
         CCommonData::m_sCenter.w = 0;
     }
+
+    BuildPathTable();
+}
+
+/**
+* g and g^2 is not in the table, so SetG is fine.
+* t is not shifted by the center, so the tables are used with center 0
+*/
+void CActionGaugePlaquetteAcceleration::BuildPathTable()
+{
+    //g^2 (t^2 + (t+1)^2)/2 Retr[1 - U_1,4], Retr[1 - U_2,4], which is the average of g^2 t^2
+    TArray<INT> plaqutte;
+    plaqutte.AddItem(1);
+    plaqutte.AddItem(4);
+    plaqutte.AddItem(-1);
+    plaqutte.AddItem(-4);
+    m_cGSqTable.AddLoop(plaqutte, F(1.0), EGPC_T2, TRUE);
+    plaqutte[0] = 2;
+    plaqutte[2] = -2;
+    m_cGSqTable.AddLoop(plaqutte, F(1.0), EGPC_T2, TRUE);
+
+    //(1/8) g t (V413 + V423)
+    m_cGTable.AddChairLoops(3, 0, 2, F(0.125), EGPC_T);
+    m_cGTable.AddChairLoops(3, 1, 2, F(0.125), EGPC_T);
+
+    m_cGSqTable.Compile();
+    m_cGTable.Compile();
 }
 
 void CActionGaugePlaquetteAcceleration::SetBeta(Real fBeta)
@@ -426,32 +116,9 @@ UBOOL CActionGaugePlaquetteAcceleration::CalculateForceOnGauge(const CFieldGauge
         return TRUE;
     }
 
-    preparethread;
-
-    _kernelAddForce4PlaqutteTermSU3_Acc << <block, threads >> >(
-        pGaugeSU3->m_pDeviceData, 
-        pForceSU3->m_pDeviceData, 
-        m_fBetaOverN, 
-        CCommonData::m_fG * CCommonData::m_fG,
-        pGauge->m_byFieldId);
-
-    _kernelAddForceChairTermSU3_Term413_3_Acc << <block, threads >> >(pGaugeSU3->m_byFieldId, pGaugeSU3->m_pDeviceData,
-        pForceSU3->m_pDeviceData, m_fBetaOverN, CCommonData::m_fG);
-
-    _kernelAddForceChairTermSU3_Term413_4_Acc << <block, threads >> >(pGaugeSU3->m_byFieldId, pGaugeSU3->m_pDeviceData,
-        pForceSU3->m_pDeviceData, m_fBetaOverN, CCommonData::m_fG);
-
-    _kernelAddForceChairTermSU3_Term413_1_Acc << <block, threads >> >(pGaugeSU3->m_byFieldId, pGaugeSU3->m_pDeviceData,
-        pForceSU3->m_pDeviceData, m_fBetaOverN, CCommonData::m_fG);
-
-    _kernelAddForceChairTermSU3_Term423_3_Acc << <block, threads >> >(pGaugeSU3->m_byFieldId, pGaugeSU3->m_pDeviceData,
-        pForceSU3->m_pDeviceData, m_fBetaOverN, CCommonData::m_fG);
-
-    _kernelAddForceChairTermSU3_Term423_4_Acc << <block, threads >> >(pGaugeSU3->m_byFieldId, pGaugeSU3->m_pDeviceData,
-        pForceSU3->m_pDeviceData, m_fBetaOverN, CCommonData::m_fG);
-
-    _kernelAddForceChairTermSU3_Term423_2_Acc << <block, threads >> >(pGaugeSU3->m_byFieldId, pGaugeSU3->m_pDeviceData,
-        pForceSU3->m_pDeviceData, m_fBetaOverN, CCommonData::m_fG);
+    const SSmallInt4 sOrigin(0, 0, 0, 0);
+    m_cGSqTable.Force(pGaugeSU3, pForceSU3, m_fBetaOverN * CCommonData::m_fG * CCommonData::m_fG, sOrigin, F(0.0));
+    m_cGTable.Force(pGaugeSU3, pForceSU3, m_fBetaOverN * CCommonData::m_fG, sOrigin, F(0.0));
 
     checkCudaErrors(cudaDeviceSynchronize());
     return TRUE;
@@ -476,28 +143,9 @@ Real CActionGaugePlaquetteAcceleration::Energy(UBOOL bBeforeEvolution, const cla
         return m_fNewEnergy;
     }
 
-    preparethread;
-
-    appGetCudaHelper()->ThreadBufferZero(_D_RealThreadBuffer);
-
-    _kernelAdd4PlaqutteTermSU3_Acc << <block, threads >> > (
-            pGaugeSU3->m_pDeviceData, 
-            appGetLattice()->m_pIndexCache->m_pPlaqutteCache,
-            m_fBetaOverN,
-            CCommonData::m_fG * CCommonData::m_fG,
-            _D_RealThreadBuffer);
-
-    m_fNewEnergy += appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
-
-    _kernelAddChairTermSU3_Chair_Acc << <block, threads >> > (
-        pGaugeSU3->m_byFieldId,
-        pGaugeSU3->m_pDeviceData,
-        m_fBetaOverN,
-        CCommonData::m_fG,
-        _D_RealThreadBuffer);
-
-     m_fNewEnergy += appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
-
+    const SSmallInt4 sOrigin(0, 0, 0, 0);
+    m_fNewEnergy += m_cGSqTable.Energy(pGaugeSU3, m_fBetaOverN * CCommonData::m_fG * CCommonData::m_fG, sOrigin, F(0.0));
+    m_fNewEnergy += m_cGTable.Energy(pGaugeSU3, m_fBetaOverN * CCommonData::m_fG, sOrigin, F(0.0));
     return m_fNewEnergy;
 }
 
@@ -14,153 +14,8 @@ __BEGIN_NAMESPACE
 
 __CLGIMPLEMENT_CLASS(CActionGaugePlaquetteGradient)
 
-#pragma region kernel
-
-__global__ void _CLG_LAUNCH_BOUND
-_kernelPlaqutteEnergySU3_UseCloverGradient(
-    BYTE byFieldId,
-    const deviceSU3* __restrict__ pDeviceData,
-#if !_CLG_DOUBLEFLOAT
-    const DOUBLE* __restrict__ fBetaOverN,
-    DOUBLE* results
-#else
-    const Real* __restrict__ fBetaOverN,
-    Real* results
-#endif
-)
-{
-    intokernalInt4;
-
-#if !_CLG_DOUBLEFLOAT
-    DOUBLE fRes = 0.0;
-#else
-    Real fRes = F(0.0);
-#endif
-    for (BYTE byDir1 = 0; byDir1 < _DC_Dir; ++byDir1)
-    {
-        for (BYTE byDir2 = byDir1 + 1; byDir2 < _DC_Dir; ++byDir2)
-        {
-            fRes += _deviceCloverRetr(pDeviceData, sSite4, __bi(sSite4), byDir1, byDir2, byFieldId);
-        }
-    }
-#if !_CLG_DOUBLEFLOAT
-    fRes = 18.0 - 0.25 * fRes;
-#else
-    fRes = F(18.0) - F(0.25) * fRes;
-#endif
-    results[uiSiteIndex] = fRes * fBetaOverN[sSite4.z];
-}
-
-__global__ void _CLG_LAUNCH_BOUND
-_kernelStapleAtSiteSU3CacheIndexGradient(
-    const deviceSU3* __restrict__ pDeviceData,
-    const SIndex* __restrict__ pCachedIndex,
-    UINT plaqLength, UINT plaqCount,
-    deviceSU3* pStapleData, //can be NULL
-    deviceSU3* pForceData,
-#if !_CLG_DOUBLEFLOAT
-    const DOUBLE* __restrict__ betaOverN
-#else
-    const Real* __restrict__ betaOverN
-#endif
-)
-{
-    intokernalInt4;
-    const BYTE uiDir = static_cast<BYTE>(_DC_Dir);
-
-    //Real test_force = F(0.0);
-    //betaOverN = betaOverN * F(-0.5);
-    const UINT plaqLengthm1 = plaqLength - 1;
-    UINT plaqCountAll = plaqCount * plaqLengthm1;
-
-    for (UINT idir = 0; idir < uiDir; ++idir)
-    {
-        UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
-        deviceSU3 res = deviceSU3::makeSU3Zero();
-
-        //there are 6 staples, each is sum of two plaquttes
-        SBYTE z1 = 0;
-        SBYTE z2 = 0;
-        BYTE zNotFound = 1;
-        for (INT i = 0; i < plaqCount; ++i)
-        {
-            const SIndex first = pCachedIndex[i * plaqLengthm1 + linkIndex * plaqCountAll];
-            deviceSU3 toAdd(pDeviceData[_deviceGetLinkIndex(first.m_uiSiteIndex, first.m_byDir)]);
-
-            const SSmallInt4 firstn = __deviceSiteIndexToInt4(first.m_uiSiteIndex);
-            z1 = firstn.z;
-            if (2 == first.m_byDir)
-            {
-                z2 = z1 + 1;
-                zNotFound = 0;
-            }
-
-            if (first.NeedToDagger())
-            {
-                toAdd.Dagger();
-            }
-
-            for (INT j = 1; j < plaqLengthm1; ++j)
-            {
-                const SIndex nextlink = pCachedIndex[i * plaqLengthm1 + j + linkIndex * plaqCountAll];
-                deviceSU3 toMul(pDeviceData[_deviceGetLinkIndex(nextlink.m_uiSiteIndex, nextlink.m_byDir)]);
-
-                if (nextlink.NeedToDagger())
-                {
-                    toAdd.MulDagger(toMul);
-                }
-                else
-                {
-                    toAdd.Mul(toMul);
-                }
-
-                if (zNotFound && nextlink.m_byDir == 2)
-                {
-                    zNotFound = 0;
-                    const SSmallInt4 nextlinkn = __deviceSiteIndexToInt4(nextlink.m_uiSiteIndex);
-                    z1 = nextlinkn.z;
-                    z2 = z1 + 1;
-                }
-            }
-
-            if (zNotFound)
-            {
-                toAdd.MulReal(betaOverN[z1] * F(-0.5));
-            }
-            else
-            {
-                if (z2 >= _DC_Lz)
-                {
-                    z2 = 0;
-                }
-                toAdd.MulReal(F(-0.25) * (betaOverN[z1] + betaOverN[z2]));
-            }
-            res.Add(toAdd);
-        }
-        if (NULL != pStapleData)
-        {
-            pStapleData[linkIndex] = res;
-        }
-
-        //staple calculated
-        deviceSU3 force(pDeviceData[linkIndex]);
-        force.MulDagger(res);
-        //test_force += F(-2.0) * betaOverN * __SU3Generators[8].MulC(force).ImTr();
-        force.Ta();
-
-        //this is the average over 4 cornels, so this is different for different dirs
-        //force.MulReal(betaOverN);
-
-        //force is additive
-        pForceData[linkIndex].Add(force);
-    }
-}
-
-#pragma endregion
-
 CActionGaugePlaquetteGradient::CActionGaugePlaquetteGradient()
     : CAction()
-    , m_pDeviceBetaArray(NULL)
     , m_fLastEnergy(F(0.0))
     , m_fNewEnergy(F(0.0))
     , m_uiPlaqutteCount(0)
@@ -173,32 +28,12 @@ DOUBLE CActionGaugePlaquetteGradient::CalculatePlaqutteEnergyUseClover(const CFi
 Real CActionGaugePlaquetteGradient::CalculatePlaqutteEnergyUseClover(const CFieldGaugeSU3* pGauge) const
 #endif
 {
-    assert(NULL != appGetLattice()->m_pIndexCache->m_pPlaqutteCache);
-
-    preparethread;
-    _kernelPlaqutteEnergySU3_UseCloverGradient << <block, threads >> > (
-        pGauge->m_byFieldId,
-        pGauge->m_pDeviceData,
-        m_pDeviceBetaArray,
-        _D_RealThreadBuffer);
-
-    return appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
+    return m_cTable.Energy(pGauge, F(1.0), CCommonData::m_sCenter, F(0.0));
 }
 
 void CActionGaugePlaquetteGradient::CalculateForceAndStaple(const CFieldGaugeSU3* pGauge, CFieldGaugeSU3* pForce) const
 {
-    preparethread;
-
-    assert(NULL != appGetLattice()->m_pIndexCache->m_pStappleCache);
-
-    _kernelStapleAtSiteSU3CacheIndexGradient << <block, threads >> > (
-        pGauge->m_pDeviceData,
-        appGetLattice()->m_pIndexCache->m_pStappleCache,
-        appGetLattice()->m_pIndexCache->m_uiPlaqutteLength,
-        appGetLattice()->m_pIndexCache->m_uiPlaqutteCountPerLink,
-        NULL,
-        pForce->m_pDeviceData,
-        m_pDeviceBetaArray);
+    m_cTable.Force(pGauge, pForce, F(1.0), CCommonData::m_sCenter, F(0.0));
 }
 
 void CActionGaugePlaquetteGradient::PrepareForHMC(const CFieldGauge* pGauge, UINT uiUpdateIterate)
@@ -212,7 +47,6 @@ void CActionGaugePlaquetteGradient::PrepareForHMC(const CFieldGauge* pGauge, UIN
             return;
         }
 
-        assert(NULL != appGetLattice()->m_pIndexCache->m_pPlaqutteCache);
         m_fLastEnergy = CalculatePlaqutteEnergyUseClover(pGaugeSU3);
     }
 }
@@ -272,15 +106,16 @@ void CActionGaugePlaquetteGradient::Initial(class CLatticeData* pOwner, const CP
 #endif
     m_uiPlaqutteCount = _HC_Volume * (_HC_Dir - 1) * (_HC_Dir - 2);
 
-#if !_CLG_DOUBLEFLOAT
-    checkCudaErrors(cudaMalloc((void**)&m_pDeviceBetaArray, sizeof(DOUBLE) * _HC_Lz));
-    checkCudaErrors(cudaMemcpy(m_pDeviceBetaArray, m_fBetaArray.GetData(), sizeof(DOUBLE) * _HC_Lz, cudaMemcpyHostToDevice));
-#else
-    checkCudaErrors(cudaMalloc((void**)&m_pDeviceBetaArray, sizeof(Real) * _HC_Lz));
-    checkCudaErrors(cudaMemcpy(m_pDeviceBetaArray, m_fBetaArray.GetData(), sizeof(Real) * _HC_Lz, cudaMemcpyHostToDevice));
-#endif
-
-
+    //all plaquttes, the clover at n is (1/4) of the 4 plaquttes with n as a corner,
+    //so it is the plaqutte with beta(z)/N averaged on the 4 corners
+    TArray<INT> plaqutte;
+    plaqutte.AddItem(1);
+    plaqutte.AddItem(2);
+    plaqutte.AddItem(-1);
+    plaqutte.AddItem(-2);
+    m_cTable.AddSymmetricLoops(plaqutte, F(1.0), EGPC_ZSlice, TRUE);
+    m_cTable.Compile();
+    UpdateSliceCoefficient();
 }
 
 #if !_CLG_DOUBLEFLOAT
@@ -309,7 +144,6 @@ void CActionGaugePlaquetteGradient::SetBeta(const TArray <Real>& fBeta)
             }
         }
     }
-    checkCudaErrors(cudaMemcpy(m_pDeviceBetaArray, m_fBetaArray.GetData(), sizeof(DOUBLE) * _HC_Lz, cudaMemcpyHostToDevice));
 #else
     for (INT i = 0; i < _HC_Lzi; ++i)
     {
@@ -329,9 +163,19 @@ void CActionGaugePlaquetteGradient::SetBeta(const TArray <Real>& fBeta)
             }
         }
     }
-    checkCudaErrors(cudaMemcpy(m_pDeviceBetaArray, m_fBetaArray.GetData(), sizeof(Real)* _HC_Lz, cudaMemcpyHostToDevice));
 #endif
 
+    UpdateSliceCoefficient();
+}
+
+void CActionGaugePlaquetteGradient::UpdateSliceCoefficient()
+{
+    TArray<Real> slice;
+    for (INT i = 0; i < _HC_Lzi; ++i)
+    {
+        slice.AddItem(static_cast<Real>(m_fBetaArray[i]));
+    }
+    m_cTable.SetSliceCoefficient(slice);
 }
 
 UBOOL CActionGaugePlaquetteGradient::CalculateForceOnGauge(const CFieldGauge * pGauge, CFieldGauge * pForce, class CFieldGauge * pStaple, ESolverPhase ePhase) const
@@ -4,6 +4,8 @@
 // DESCRIPTION:
 // This is the class for all fields, gauge, fermion and spin fields are inherent from it
 //
+// The plaquttes are in CGaugePathTable with beta(z) averaged on the corners
+//
 // REVISION:
 //  [08/15/2022 nbale]
 //=============================================================================
@@ -45,12 +47,10 @@ public:
 protected:
 
 #if !_CLG_DOUBLEFLOAT
-    DOUBLE* m_pDeviceBetaArray;
     DOUBLE m_fLastEnergy;
     DOUBLE m_fNewEnergy;
     TArray<DOUBLE> m_fBetaArray;
 #else
-    Real* m_pDeviceBetaArray;
     Real m_fLastEnergy;
     Real m_fNewEnergy;
     TArray<Real> m_fBetaArray;
@@ -67,6 +67,9 @@ protected:
 #endif
 
     void CalculateForceAndStaple(const CFieldGaugeSU3* pGauge, CFieldGaugeSU3* pForce) const;
+    void UpdateSliceCoefficient();
+
+    CGaugePathTable m_cTable;
 };
 
 __END_NAMESPACE
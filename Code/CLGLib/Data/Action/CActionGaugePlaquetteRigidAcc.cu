@@ -294,10 +294,10 @@ void CActionGaugePlaquetteRigidAcc::Initial(class CLatticeData* pOwner, const CP
     if (centerArray.Num() > 3)
     {
         SSmallInt4 sCenter;
-        sCenter.x = static_cast<SBYTE>(centerArray[0]);
-        sCenter.y = static_cast<SBYTE>(centerArray[1]);
-        sCenter.z = static_cast<SBYTE>(centerArray[2]);
-        sCenter.w = static_cast<SBYTE>(centerArray[3]);
+        sCenter.x = static_cast<SCOORD>(centerArray[0] - _HC_XOrigin);
+        sCenter.y = static_cast<SCOORD>(centerArray[1]);
+        sCenter.z = static_cast<SCOORD>(centerArray[2]);
+        sCenter.w = static_cast<SCOORD>(centerArray[3]);
         CCommonData::m_sCenter = sCenter;
     }
     else
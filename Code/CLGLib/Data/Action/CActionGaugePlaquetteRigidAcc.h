@@ -66,7 +66,7 @@ static __device__ __inline__ Real _deviceGnRigidAccLeft(const SSmallInt4& sSite,
 {
     if (mu == 2 || nu == 2)
     {
-        if (sSite.z == static_cast<SBYTE>(_DC_Lz) - 1)
+        if (sSite.z == static_cast<SCOORD>(_DC_Lz) - 1)
         {
             return (fG * sSite.z + F(1.0)) * F(0.5);
         }
@@ -86,7 +86,7 @@ static __device__ __inline__ Real _deviceGnRigidAccRight(const SSmallInt4& sSite
 {
     if (mu == 2)
     {
-        if (sSite.z == static_cast<SBYTE>(_DC_Lz) - 1)
+        if (sSite.z == static_cast<SCOORD>(_DC_Lz) - 1)
         {
             return (fG * sSite.z + F(1.0)) * F(0.5);
         }
@@ -120,7 +120,7 @@ static __device__ __inline__ Real _deviceGnRigidAccLeftTri(const SSmallInt4& sSi
     const Real ret = fG * sSite.z + F(1.0);
     if (mu == 2 || nu == 2)
     {
-        if (sSite.z == static_cast<SBYTE>(_DC_Lz) - 1)
+        if (sSite.z == static_cast<SCOORD>(_DC_Lz) - 1)
         {
             return ret * ret * ret * F(0.5);
         }
@@ -142,7 +142,7 @@ static __device__ __inline__ Real _deviceGnRigidAccRightTri(const SSmallInt4& sS
     const Real ret = fG * sSite.z + F(1.0);
     if (mu == 2)
     {
-        if (sSite.z == static_cast<SBYTE>(_DC_Lz) - 1)
+        if (sSite.z == static_cast<SCOORD>(_DC_Lz) - 1)
         {
             return ret * ret * ret * F(0.5);
         }
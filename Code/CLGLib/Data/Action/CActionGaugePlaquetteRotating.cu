@@ -20,6 +20,11 @@ __CLGIMPLEMENT_CLASS(CActionGaugePlaquetteRotating)
 
 #pragma region Clover terms
 
+/**
+* The energy and force on torus are in the path tables (BuildPathTable),
+* the two kernels of the Omega^2 plaqutte terms are only kept for XYTerm1 and XYTerm2
+*/
+
 /**
 * This is slower, just for testing
 * directly calculate Retr[1 - \hat{U}]
@@ -148,527 +153,6 @@ _kernelAdd4PlaqutteTermSU3(
     results[uiSiteIndex] = res;
 }
 
-
-/**
-*
-*/
-__global__ void _CLG_LAUNCH_BOUND
-_kernelAddForce4PlaqutteTermSU3_XY(
-    BYTE byFieldId,
-    const deviceSU3* __restrict__ pDeviceData,
-    SSmallInt4 sCenterSite,
-    deviceSU3* pForceData,
-#if !_CLG_DOUBLEFLOAT
-    DOUBLE betaOverN,
-    DOUBLE fOmegaSq
-#else
-    Real betaOverN,
-    Real fOmegaSq
-#endif
-)
-{
-    intokernalInt4;
-
-    const UINT uiBigIdx = __idx->_deviceGetBigIndex(sSite4);
-
-    betaOverN = betaOverN * F(-0.5);
-    BYTE idx[6] = { 1, 0, 2, 0, 1, 2};
-    BYTE byOtherDir[6] = {2, 1, 2, 0, 0, 1};
-    //deviceSU3 plaqSum = deviceSU3::makeSU3Zero();
-    #pragma unroll
-    for (BYTE idir = 0; idir < 3; ++idir)
-    {
-        if (__idx->_deviceIsBondOnSurface(uiBigIdx, idir))
-        {
-            continue;
-        }
-        const UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
-
-        //for xz, yz, i=1,2
-        //for xy, i = 0
-
-        deviceSU3 stap(_deviceStapleTermGfactor(byFieldId, pDeviceData, sCenterSite, sSite4, fOmegaSq, uiBigIdx, 
-            idir, 
-            byOtherDir[2 * idir],
-            idx[2 * idir]));
-        stap.Add(_deviceStapleTermGfactor(byFieldId, pDeviceData, sCenterSite, sSite4, fOmegaSq, uiBigIdx,
-            idir,
-            byOtherDir[2 * idir + 1],
-            idx[2 * idir + 1]));
-        deviceSU3 force(pDeviceData[linkIndex]);
-
-        force.MulDagger(stap);
-        force.Ta();
-        force.MulReal(betaOverN);
-        pForceData[linkIndex].Add(force);
-    }
-}
-
-#pragma endregion
-
-#pragma region Chair Energy
-
-/**
-* Split into 3 functions to avoid max-register problem
-*/
-__global__ void _CLG_LAUNCH_BOUND
-_kernelAddChairTermSU3_Term12(
-    BYTE byFieldId,
-    const deviceSU3 * __restrict__ pDeviceData,
-    SSmallInt4 sCenterSite,
-#if !_CLG_DOUBLEFLOAT
-    DOUBLE betaOverN, DOUBLE fOmega,
-    DOUBLE* results
-#else
-    Real betaOverN, Real fOmega,
-    Real* results
-#endif
-)
-{
-    intokernalInt4;
-
-    const UINT uiN = __idx->_deviceGetBigIndex(sSite4);
-
-    if (__idx->m_pDeviceIndexPositionToSIndex[byFieldId][uiN].IsDirichlet())
-    {
-        results[uiSiteIndex] = F(0.0);
-        return;
-    }
-
-    betaOverN = F(0.125) * betaOverN;
-    const Real fXOmega = -(sSite4.x - sCenterSite.x) * fOmega;
-
-    //===============
-    //+x Omega V412
-    const Real fV412 = fXOmega * _deviceChairTerm(pDeviceData, byFieldId, sSite4, 3, 0, 1, uiN);
-
-    //===============
-    //+x Omega V432
-    const Real fV432 = fXOmega * _deviceChairTerm(pDeviceData, byFieldId, sSite4, 3, 2, 1, uiN);
-
-    results[uiSiteIndex] = (fV412 + fV432) * betaOverN;
-}
-
-__global__ void _CLG_LAUNCH_BOUND
-_kernelAddChairTermSU3_Term34(
-    BYTE byFieldId,
-    const deviceSU3 * __restrict__ pDeviceData,
-    SSmallInt4 sCenterSite,
-#if !_CLG_DOUBLEFLOAT
-    DOUBLE betaOverN, DOUBLE fOmega,
-    DOUBLE* results
-#else
-    Real betaOverN, Real fOmega,
-    Real* results
-#endif
-)
-{
-    intokernalInt4;
-
-    const UINT uiN = __idx->_deviceGetBigIndex(sSite4);
-
-    if (__idx->m_pDeviceIndexPositionToSIndex[1][uiN].IsDirichlet())
-    {
-        results[uiSiteIndex] = F(0.0);
-        return;
-    }
-
-    betaOverN = F(0.125) * betaOverN;
-    const Real fYOmega = (sSite4.y - sCenterSite.y) * fOmega;
-
-    //===============
-    //-y Omega V421
-    const Real fV421 = fYOmega * _deviceChairTerm(pDeviceData, byFieldId, sSite4, 3, 1, 0, uiN);
-
-    //===============
-    //-y Omega V431
-    const Real fV431 = fYOmega * _deviceChairTerm(pDeviceData, byFieldId, sSite4, 3, 2, 0, uiN);
-
-    results[uiSiteIndex] = (fV421 + fV431) * betaOverN;
-}
-
-__global__ void _CLG_LAUNCH_BOUND
-_kernelAddChairTermSU3_Term5(
-    BYTE byFieldId,
-    const deviceSU3 * __restrict__ pDeviceData,
-    SSmallInt4 sCenterSite,
-#if !_CLG_DOUBLEFLOAT
-    DOUBLE betaOverN, DOUBLE fOmegaSq,
-    DOUBLE* results
-#else
-    Real betaOverN, Real fOmegaSq,
-    Real* results
-#endif
-)
-{
-    intokernalInt4;
-
-    const UINT uiN = __idx->_deviceGetBigIndex(sSite4);
-
-    if (__idx->m_pDeviceIndexPositionToSIndex[1][uiN].IsDirichlet())
-    {
-        results[uiSiteIndex] = F(0.0);
-        return;
-    }
-
-    betaOverN = F(0.125) * betaOverN;
-    const Real fXYOmega2 = -(sSite4.x - sCenterSite.x) * (sSite4.y - sCenterSite.y) * fOmegaSq;
-
-    //===============
-    //+Omega^2 xy V132
-    const Real fV132 = fXYOmega2 * _deviceChairTerm(pDeviceData, byFieldId, sSite4, 0, 2, 1, uiN);
-
-    results[uiSiteIndex] = fV132 * betaOverN;
-}
-
-
-#pragma endregion
-
-#pragma region Chair force
-
-/**
-* Split to 15 functions to avoid max-regcount
-*/
-__global__ void _CLG_LAUNCH_BOUND
-_kernelAddForceChairTermSU3_Term1(
-    BYTE byFieldId,
-    const deviceSU3 * __restrict__ pDeviceData,
-    SSmallInt4 sCenterSite,
-    deviceSU3 *pForceData,
-#if !_CLG_DOUBLEFLOAT
-    DOUBLE betaOverN, DOUBLE fOmega
-#else
-    Real betaOverN, Real fOmega
-#endif
-)
-{
-    intokernalInt4;
-
-    const UINT uiBigIdx = __idx->_deviceGetBigIndex(sSite4);
-
-    betaOverN = -betaOverN * F(0.5) * fOmega * F(0.125);
-
-    //===============
-    //+x Omega V412
-    //add force for dir=4
-    const UINT uiLink4 = _deviceGetLinkIndex(uiSiteIndex, 3);
-
-    if (!__idx->_deviceIsBondOnSurface(uiBigIdx, 3))
-    {
-        const deviceSU3 staple_term1_4 = _deviceStapleChairTerm1(byFieldId, pDeviceData, sCenterSite, sSite4, uiSiteIndex, uiBigIdx,
-            3, 0, 1, 0);
-        deviceSU3 force4(pDeviceData[uiLink4]);
-        force4.MulDagger(staple_term1_4);
-        force4.Ta();
-        force4.MulReal(betaOverN);
-        pForceData[uiLink4].Add(force4);
-    }
-
-    //===============
-    //+x Omega V412
-    //add force for dir=2
-    const UINT uiLink2 = _deviceGetLinkIndex(uiSiteIndex, 1);
-
-    if (!__idx->_deviceIsBondOnSurface(uiBigIdx, 1))
-    {
-        const deviceSU3 staple_term1_2 = _deviceStapleChairTerm1(byFieldId, pDeviceData, sCenterSite, sSite4, uiSiteIndex, uiBigIdx,
-            1, 0, 3, 0);
-        deviceSU3 force2(pDeviceData[uiLink2]);
-        force2.MulDagger(staple_term1_2);
-        force2.Ta();
-        force2.MulReal(betaOverN);
-        pForceData[uiLink2].Add(force2);
-    }
-
-    //===============
-    //+x Omega V412
-    //add force for dir=x
-    const UINT uiLink1 = _deviceGetLinkIndex(uiSiteIndex, 0);
-
-    if (!__idx->_deviceIsBondOnSurface(uiBigIdx, 0))
-    {
-        const deviceSU3 staple_term1_1 = _deviceStapleChairTerm2(byFieldId, pDeviceData, sCenterSite, sSite4, uiSiteIndex, uiBigIdx,
-            3, 0, 1, 0);
-        deviceSU3 force1(pDeviceData[uiLink1]);
-        force1.MulDagger(staple_term1_1);
-        force1.Ta();
-        force1.MulReal(betaOverN);
-        pForceData[uiLink1].Add(force1);
-    }
-}
-
-__global__ void _CLG_LAUNCH_BOUND
-_kernelAddForceChairTermSU3_Term2(
-    BYTE byFieldId,
-    const deviceSU3 * __restrict__ pDeviceData,
-    SSmallInt4 sCenterSite,
-    deviceSU3 *pForceData,
-#if !_CLG_DOUBLEFLOAT
-    DOUBLE betaOverN, DOUBLE fOmega
-#else
-    Real betaOverN, Real fOmega
-#endif
-)
-{
-    intokernalInt4;
-
-    const UINT uiBigIdx = __idx->_deviceGetBigIndex(sSite4);
-
-    betaOverN = -betaOverN * F(0.5) * fOmega * F(0.125);
-
-    //===============
-    //+x Omega V432
-    //add force for mu=4
-    const UINT uiLink4 = _deviceGetLinkIndex(uiSiteIndex, 3);
-
-    if (!__idx->_deviceIsBondOnSurface(uiBigIdx, 3))
-    {
-        const deviceSU3 staple_term2_4 = _deviceStapleChairTerm1(byFieldId, pDeviceData, sCenterSite, sSite4, uiSiteIndex, uiBigIdx,
-            3, 2, 1, 0);
-        deviceSU3 force4(pDeviceData[uiLink4]);
-        force4.MulDagger(staple_term2_4);
-        force4.Ta();
-        force4.MulReal(betaOverN);
-        pForceData[uiLink4].Add(force4);
-    }
-
-    //===============
-    //+x Omega V432
-    //add force for mu=4
-    const UINT uiLink2 = _deviceGetLinkIndex(uiSiteIndex, 1);
-
-    if (!__idx->_deviceIsBondOnSurface(uiBigIdx, 1))
-    {
-        const deviceSU3 staple_term2_2 = _deviceStapleChairTerm1(byFieldId, pDeviceData, sCenterSite, sSite4, uiSiteIndex, uiBigIdx,
-            1, 2, 3, 0);
-        deviceSU3 force2(pDeviceData[uiLink2]);
-        force2.MulDagger(staple_term2_2);
-        force2.Ta();
-        force2.MulReal(betaOverN);
-        pForceData[uiLink2].Add(force2);
-    }
-
-    //===============
-    //+x Omega V432
-    //add force for mu=4
-    const UINT uiLink3 = _deviceGetLinkIndex(uiSiteIndex, 2);
-
-    if (!__idx->_deviceIsBondOnSurface(uiBigIdx, 2))
-    {
-        const deviceSU3 staple_term2_3 = _deviceStapleChairTerm2(byFieldId, pDeviceData, sCenterSite, sSite4, uiSiteIndex, uiBigIdx,
-            3, 2, 1, 0);
-        deviceSU3 force3(pDeviceData[uiLink3]);
-        force3.MulDagger(staple_term2_3);
-        force3.Ta();
-        force3.MulReal(betaOverN);
-        pForceData[uiLink3].Add(force3);
-    }
-}
-
-__global__ void _CLG_LAUNCH_BOUND
-_kernelAddForceChairTermSU3_Term3(
-    BYTE byFieldId,
-    const deviceSU3 * __restrict__ pDeviceData,
-    SSmallInt4 sCenterSite,
-    deviceSU3 *pForceData,
-#if !_CLG_DOUBLEFLOAT
-    DOUBLE betaOverN, DOUBLE fOmega
-#else
-    Real betaOverN, Real fOmega
-#endif
-)
-{
-    intokernalInt4;
-
-    const UINT uiBigIdx = __idx->_deviceGetBigIndex(sSite4);
-
-    betaOverN = -betaOverN * F(0.5) * fOmega * F(0.125);
-
-    //===============
-    //-y Omega V421
-    //add force for mu=4
-    const UINT uiLink4 = _deviceGetLinkIndex(uiSiteIndex, 3);
-
-    if (!__idx->_deviceIsBondOnSurface(uiBigIdx, 3))
-    {
-        const deviceSU3 staple_term3_4 = _deviceStapleChairTerm1(byFieldId, pDeviceData, sCenterSite, sSite4, uiSiteIndex, uiBigIdx,
-            3, 1, 0, 1);
-        deviceSU3 force4(pDeviceData[uiLink4]);
-        force4.MulDagger(staple_term3_4);
-        force4.Ta();
-        force4.MulReal(betaOverN);
-        pForceData[uiLink4].Add(force4);
-    }
-
-    //===============
-    //-y Omega V421
-    //add force for mu=4
-    const UINT uiLink1 = _deviceGetLinkIndex(uiSiteIndex, 0);
-
-    if (!__idx->_deviceIsBondOnSurface(uiBigIdx, 0))
-    {
-        const deviceSU3 staple_term3_1 = _deviceStapleChairTerm1(byFieldId, pDeviceData, sCenterSite, sSite4, uiSiteIndex, uiBigIdx,
-            0, 1, 3, 1);
-        deviceSU3 force1(pDeviceData[uiLink1]);
-        force1.MulDagger(staple_term3_1);
-        force1.Ta();
-        force1.MulReal(betaOverN);
-        pForceData[uiLink1].Add(force1);
-    }
-
-    //===============
-    //-y Omega V421
-    //add force for mu=4
-    const UINT uiLink2 = _deviceGetLinkIndex(uiSiteIndex, 1);
-
-    if (!__idx->_deviceIsBondOnSurface(uiBigIdx, 1))
-    {
-        const deviceSU3 staple_term3_2 = _deviceStapleChairTerm2(byFieldId, pDeviceData, sCenterSite, sSite4, uiSiteIndex, uiBigIdx,
-            3, 1, 0, 1);
-        deviceSU3 force2(pDeviceData[uiLink2]);
-        force2.MulDagger(staple_term3_2);
-        force2.Ta();
-        force2.MulReal(betaOverN);
-        pForceData[uiLink2].Add(force2);
-    }
-
-}
-
-__global__ void _CLG_LAUNCH_BOUND
-_kernelAddForceChairTermSU3_Term4(
-    BYTE byFieldId,
-    const deviceSU3 * __restrict__ pDeviceData,
-    SSmallInt4 sCenterSite,
-    deviceSU3 *pForceData,
-#if !_CLG_DOUBLEFLOAT
-    DOUBLE betaOverN, DOUBLE fOmega
-#else
-    Real betaOverN, Real fOmega
-#endif
-)
-{
-    intokernalInt4;
-
-    const UINT uiBigIdx = __idx->_deviceGetBigIndex(sSite4);
-
-    betaOverN = -betaOverN * F(0.5) * fOmega * F(0.125);
-
-    //===============
-    //-y Omega V431
-    //add force for mu=4
-    const UINT uiLink4 = _deviceGetLinkIndex(uiSiteIndex, 3);
-
-    if (!__idx->_deviceIsBondOnSurface(uiBigIdx, 3))
-    {
-        const deviceSU3 staple_term4_4 = _deviceStapleChairTerm1(byFieldId, pDeviceData, sCenterSite, sSite4, uiSiteIndex, uiBigIdx,
-            3, 2, 0, 1);
-        deviceSU3 force4(pDeviceData[uiLink4]);
-        force4.MulDagger(staple_term4_4);
-        force4.Ta();
-        force4.MulReal(betaOverN);
-        pForceData[uiLink4].Add(force4);
-    }
-
-    //===============
-    //-y Omega V431
-    //add force for mu=4
-    const UINT uiLink1 = _deviceGetLinkIndex(uiSiteIndex, 0);
-
-    if (!__idx->_deviceIsBondOnSurface(uiBigIdx, 0))
-    {
-        const deviceSU3 staple_term4_1 = _deviceStapleChairTerm1(byFieldId, pDeviceData, sCenterSite, sSite4, uiSiteIndex, uiBigIdx,
-            0, 2, 3, 1);
-        deviceSU3 force1(pDeviceData[uiLink1]);
-        force1.MulDagger(staple_term4_1);
-        force1.Ta();
-        force1.MulReal(betaOverN);
-        pForceData[uiLink1].Add(force1);
-    }
-
-    //===============
-    //-y Omega V431
-    //add force for mu=4
-    const UINT uiLink3 = _deviceGetLinkIndex(uiSiteIndex, 2);
-
-    if (!__idx->_deviceIsBondOnSurface(uiBigIdx, 2))
-    {
-        const deviceSU3 staple_term4_3 = _deviceStapleChairTerm2(byFieldId, pDeviceData, sCenterSite, sSite4, uiSiteIndex, uiBigIdx,
-            3, 2, 0, 1);
-        deviceSU3 force3(pDeviceData[uiLink3]);
-        force3.MulDagger(staple_term4_3);
-        force3.Ta();
-        force3.MulReal(betaOverN);
-        pForceData[uiLink3].Add(force3);
-    }
-
-}
-
-__global__ void _CLG_LAUNCH_BOUND
-_kernelAddForceChairTermSU3_Term5(
-    BYTE byFieldId,
-    const deviceSU3 * __restrict__ pDeviceData,
-    SSmallInt4 sCenterSite,
-    deviceSU3 *pForceData,
-#if !_CLG_DOUBLEFLOAT
-    DOUBLE betaOverN, DOUBLE fOmegaSq
-#else
-    Real betaOverN, Real fOmegaSq
-#endif
-)
-{
-    intokernalInt4;
-
-    const UINT uiBigIdx = __idx->_deviceGetBigIndex(sSite4);
-
-    betaOverN = -betaOverN * F(0.5) * fOmegaSq * F(0.125);
-
-    //===============
-    //+Omega^2 xy V132
-    const UINT uiLink1 = _deviceGetLinkIndex(uiSiteIndex, 0);
-
-    if (!__idx->_deviceIsBondOnSurface(uiBigIdx, 0))
-    {
-        const deviceSU3 staple_term5_1 = _deviceStapleChairTerm1(byFieldId, pDeviceData, sCenterSite, sSite4, uiSiteIndex, uiBigIdx,
-            0, 2, 1, 2);
-        deviceSU3 force1(pDeviceData[uiLink1]);
-        force1.MulDagger(staple_term5_1);
-        force1.Ta();
-        force1.MulReal(betaOverN);
-        pForceData[uiLink1].Add(force1);
-    }
-
-    //===============
-    //+Omega^2 xy V132
-    const UINT uiLink2 = _deviceGetLinkIndex(uiSiteIndex, 1);
-
-    if (!__idx->_deviceIsBondOnSurface(uiBigIdx, 1))
-    {
-        const deviceSU3 staple_term5_2 = _deviceStapleChairTerm1(byFieldId, pDeviceData, sCenterSite, sSite4, uiSiteIndex, uiBigIdx,
-            1, 2, 0, 2);
-        deviceSU3 force2(pDeviceData[uiLink2]);
-        force2.MulDagger(staple_term5_2);
-        force2.Ta();
-        force2.MulReal(betaOverN);
-        pForceData[uiLink2].Add(force2);
-    }
-
-    //===============
-    //+Omega^2 xy V132
-    const UINT uiLink3 = _deviceGetLinkIndex(uiSiteIndex, 2);
-
-    if (!__idx->_deviceIsBondOnSurface(uiBigIdx, 2))
-    {
-        const deviceSU3 staple_term5_3 = _deviceStapleChairTerm2(byFieldId, pDeviceData, sCenterSite, sSite4, uiSiteIndex, uiBigIdx,
-            0, 2, 1, 2);
-        deviceSU3 force3(pDeviceData[uiLink3]);
-        force3.MulDagger(staple_term5_3);
-        force3.Ta();
-        force3.MulReal(betaOverN);
-        pForceData[uiLink3].Add(force3);
-    }
-
-}
-
 #pragma endregion
 
 #pragma region Projective plane
@@ -1652,10 +1136,10 @@ void CActionGaugePlaquetteRotating::Initial(class CLatticeData* pOwner, const CP
     if (centerArray.Num() > 3)
     {
         SSmallInt4 sCenter;
-        sCenter.x = static_cast<SBYTE>(centerArray[0]);
-        sCenter.y = static_cast<SBYTE>(centerArray[1]);
-        sCenter.z = static_cast<SBYTE>(centerArray[2]);
-        sCenter.w = static_cast<SBYTE>(centerArray[3]);
+        sCenter.x = static_cast<SCOORD>(centerArray[0] - _HC_XOrigin);
+        sCenter.y = static_cast<SCOORD>(centerArray[1]);
+        sCenter.z = static_cast<SCOORD>(centerArray[2]);
+        sCenter.w = static_cast<SCOORD>(centerArray[3]);
         CCommonData::m_sCenter = sCenter;
     }
 
@@ -1671,6 +1155,47 @@ void CActionGaugePlaquetteRotating::Initial(class CLatticeData* pOwner, const CP
     INT iShiftCoord = 0;
     param.FetchValueINT(_T("ShiftCoord"), iShiftCoord);
     m_bShiftHalfCoord = (0 != iShiftCoord);
+
+    //the path table does not follow the twisted links of the projective plane
+    if (!m_bShiftHalfCoord)
+    {
+        BuildPathTable(m_cOmegaTable, m_cOmegaSqTable);
+    }
+}
+
+/**
+* The betaOverN Omega and betaOverN Omega^2 is not in the table, so SetOmega is fine
+*/
+void CActionGaugePlaquetteRotating::BuildPathTable(CGaugePathTable& omegaTable, CGaugePathTable& omegaSqTable)
+{
+    //Omega^2 (x^2 + y^2) Retr[1 - U_1,2], Omega^2 y^2 Retr[1 - U_1,3], Omega^2 x^2 Retr[1 - U_2,3]
+    //with (f(n)+f(n+mu)+f(n+nu)+f(n+mu+nu))/4
+    TArray<INT> plaqutte;
+    plaqutte.AddItem(1);
+    plaqutte.AddItem(2);
+    plaqutte.AddItem(-1);
+    plaqutte.AddItem(-2);
+    omegaSqTable.AddLoop(plaqutte, F(1.0), EGPC_R2, TRUE);
+    plaqutte[1] = 3;
+    plaqutte[3] = -3;
+    omegaSqTable.AddLoop(plaqutte, F(1.0), EGPC_Y2, TRUE);
+    plaqutte[0] = 2;
+    plaqutte[2] = -2;
+    omegaSqTable.AddLoop(plaqutte, F(1.0), EGPC_X2, TRUE);
+
+    //-(1/8) Omega^2 xy V132
+    omegaSqTable.AddChairLoops(0, 2, 1, F(-0.125), EGPC_XY);
+
+    //-(1/8) x Omega (V412 + V432)
+    omegaTable.AddChairLoops(3, 0, 1, F(-0.125), EGPC_X);
+    omegaTable.AddChairLoops(3, 2, 1, F(-0.125), EGPC_X);
+
+    //(1/8) y Omega (V421 + V431)
+    omegaTable.AddChairLoops(3, 1, 0, F(0.125), EGPC_Y);
+    omegaTable.AddChairLoops(3, 2, 0, F(0.125), EGPC_Y);
+
+    omegaSqTable.Compile();
+    omegaTable.Compile();
 }
 
 #if !_CLG_DOUBLEFLOAT
@@ -1704,23 +1229,8 @@ UBOOL CActionGaugePlaquetteRotating::CalculateForceOnGauge(const CFieldGauge * p
 
     if (!m_bShiftHalfCoord)
     {
-        _kernelAddForce4PlaqutteTermSU3_XY << <block, threads >> > (pGaugeSU3->m_byFieldId, pGaugeSU3->m_pDeviceData, CCommonData::m_sCenter,
-            pForceSU3->m_pDeviceData, m_fBetaOverN, m_fOmega * m_fOmega);
-
-        _kernelAddForceChairTermSU3_Term1 << <block, threads >> > (pGaugeSU3->m_byFieldId, pGaugeSU3->m_pDeviceData, CCommonData::m_sCenter,
-            pForceSU3->m_pDeviceData, m_fBetaOverN, m_fOmega);
-
-        _kernelAddForceChairTermSU3_Term2 << <block, threads >> > (pGaugeSU3->m_byFieldId, pGaugeSU3->m_pDeviceData, CCommonData::m_sCenter,
-            pForceSU3->m_pDeviceData, m_fBetaOverN, m_fOmega);
-
-        _kernelAddForceChairTermSU3_Term3 << <block, threads >> > (pGaugeSU3->m_byFieldId, pGaugeSU3->m_pDeviceData, CCommonData::m_sCenter,
-            pForceSU3->m_pDeviceData, m_fBetaOverN, m_fOmega);
-
-        _kernelAddForceChairTermSU3_Term4 << <block, threads >> > (pGaugeSU3->m_byFieldId, pGaugeSU3->m_pDeviceData, CCommonData::m_sCenter,
-            pForceSU3->m_pDeviceData, m_fBetaOverN, m_fOmega);
-
-        _kernelAddForceChairTermSU3_Term5 << <block, threads >> > (pGaugeSU3->m_byFieldId, pGaugeSU3->m_pDeviceData, CCommonData::m_sCenter,
-            pForceSU3->m_pDeviceData, m_fBetaOverN, m_fOmega * m_fOmega);
+        m_cOmegaSqTable.Force(pGaugeSU3, pForceSU3, static_cast<Real>(m_fBetaOverN * m_fOmega * m_fOmega), CCommonData::m_sCenter, F(0.0));
+        m_cOmegaTable.Force(pGaugeSU3, pForceSU3, static_cast<Real>(m_fBetaOverN * m_fOmega), CCommonData::m_sCenter, F(0.0));
     }
     else
     {
@@ -1828,59 +1338,10 @@ Real CActionGaugePlaquetteRotating::Energy(UBOOL bBeforeEvolution, const class C
     }
     else
     {
-        //======== this is only for test ================
-        //_kernelAdd4PlaqutteTermSU3_Test << <block, threads >> > (
-        //    pGaugeSU3->m_byFieldId,
-        //    pGaugeSU3->m_pDeviceData,
-        //    CCommonData::m_sCenter,
-        //    m_fBetaOverN,
-        //    m_fOmega * m_fOmega,
-        //    _D_RealThreadBuffer);
-
-        _kernelAdd4PlaqutteTermSU3 << <block, threads >> > (
-            pGaugeSU3->m_byFieldId,
-            pGaugeSU3->m_pDeviceData,
-            appGetLattice()->m_pIndexCache->m_pPlaqutteCache,
-            CCommonData::m_sCenter,
-            m_fBetaOverN,
-            m_fOmega * m_fOmega,
-            _D_RealThreadBuffer);
-
-        m_fNewEnergy += appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
-
-        _kernelAddChairTermSU3_Term12 << <block, threads >> > (
-            pGaugeSU3->m_byFieldId,
-            pGaugeSU3->m_pDeviceData,
-            CCommonData::m_sCenter,
-            m_fBetaOverN,
-            m_fOmega,
-            _D_RealThreadBuffer);
-
-        m_fNewEnergy += appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
-
-        _kernelAddChairTermSU3_Term34 << <block, threads >> > (
-            pGaugeSU3->m_byFieldId,
-            pGaugeSU3->m_pDeviceData,
-            CCommonData::m_sCenter,
-            m_fBetaOverN,
-            m_fOmega,
-            _D_RealThreadBuffer);
-
-        m_fNewEnergy += appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
-
-        _kernelAddChairTermSU3_Term5 << <block, threads >> > (
-            pGaugeSU3->m_byFieldId,
-            pGaugeSU3->m_pDeviceData,
-            CCommonData::m_sCenter,
-            m_fBetaOverN,
-            m_fOmega * m_fOmega,
-            _D_RealThreadBuffer);
-
-        m_fNewEnergy += appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
-
+        m_fNewEnergy += m_cOmegaSqTable.Energy(pGaugeSU3, m_fBetaOverN * m_fOmega * m_fOmega, CCommonData::m_sCenter, F(0.0));
+        m_fNewEnergy += m_cOmegaTable.Energy(pGaugeSU3, m_fBetaOverN * m_fOmega, CCommonData::m_sCenter, F(0.0));
     }
 
-
     return m_fNewEnergy;
 }
 
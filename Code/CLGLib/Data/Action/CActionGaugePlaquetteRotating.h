@@ -5,6 +5,8 @@
 // This is the class for rotating guage action
 // Open boundary condition (identity Dirichlet boundary condition) is assumed 
 // 
+// The Omega terms are in CGaugePathTable,
+// ShiftCoord is using the kernels here (the path table does not support projective plane)
 //
 // REVISION:
 //  [05/07/2019 nbale]
@@ -58,6 +60,11 @@ public:
     DOUBLE XYTerm1(const class CFieldGauge* pGauge);
     DOUBLE XYTerm2(const class CFieldGauge* pGauge);
 
+    /**
+    * The Omega and Omega^2 terms on torus, also used by CActionGaugePlaquetteRotatingU1
+    */
+    static void BuildPathTable(CGaugePathTable& omegaTable, CGaugePathTable& omegaSqTable);
+
 protected:
 
 #if !_CLG_DOUBLEFLOAT
@@ -71,6 +78,10 @@ protected:
 #endif
 
     UINT m_uiPlaqutteCount;
+
+    //terms with Omega and Omega^2
+    CGaugePathTable m_cOmegaTable;
+    CGaugePathTable m_cOmegaSqTable;
 };
 
 //================= Put those device functions to header file because we will use them ==============
@@ -1042,7 +1053,7 @@ static __device__ __inline__ Real _deviceSiteCoeff(
     if (0 == byType)
     {
         //x
-        const UBOOL bOpposite = sSite4.x >= static_cast<SBYTE>(_DC_Lx) || sSite4.x < 0;
+        const UBOOL bOpposite = sSite4.x >= static_cast<SCOORD>(_DC_Lx) || sSite4.x < 0;
         sSite4 = __deviceSiteIndexToInt4(__idx->m_pDeviceIndexPositionToSIndex[byFieldId][__bi(sSite4)].m_uiSiteIndex);
         if (bOpposite)
         {
@@ -1053,7 +1064,7 @@ static __device__ __inline__ Real _deviceSiteCoeff(
     if (1 == byType)
     {
         //y
-        const UBOOL bOpposite = sSite4.y >= static_cast<SBYTE>(_DC_Ly) || sSite4.y < 0;
+        const UBOOL bOpposite = sSite4.y >= static_cast<SCOORD>(_DC_Ly) || sSite4.y < 0;
         sSite4 = __deviceSiteIndexToInt4(__idx->m_pDeviceIndexPositionToSIndex[byFieldId][__bi(sSite4)].m_uiSiteIndex);
         if (bOpposite)
         {
@@ -1069,8 +1080,8 @@ static __device__ __inline__ Real _deviceSiteCoeff(
     }
 
     //byType = 2 and this is XY
-    const BYTE bOppositeX = (sSite4.x >= static_cast<SBYTE>(_DC_Lx) || sSite4.x < 0) ? 1 : 0;
-    const BYTE bOppositeY = (sSite4.y >= static_cast<SBYTE>(_DC_Ly) || sSite4.y < 0) ? 1 : 0;
+    const BYTE bOppositeX = (sSite4.x >= static_cast<SCOORD>(_DC_Lx) || sSite4.x < 0) ? 1 : 0;
+    const BYTE bOppositeY = (sSite4.y >= static_cast<SCOORD>(_DC_Ly) || sSite4.y < 0) ? 1 : 0;
     sSite4 = __deviceSiteIndexToInt4(__idx->m_pDeviceIndexPositionToSIndex[byFieldId][__bi(sSite4)].m_uiSiteIndex);
     const Real fRet = (sSite4.x - sCenterSite.x + F(0.5)) * (sSite4.y - sCenterSite.y + F(0.5));
     if (0 != (bOppositeX ^ bOppositeY))
@@ -572,6 +572,249 @@ _kernelAddForceChairTermU1_Term5_Shifted(
 
 #pragma endregion
 
+#pragma region CFieldGaugeU1Angle
+
+/**
+* The same as the kernels above, on the angles of CFieldGaugeU1Angle,
+* the force is Im[U S^+] added to the angle of the force field
+*/
+__global__ void _CLG_LAUNCH_BOUND
+_kernelAdd4PlaqutteTermU1Angle_Shifted(
+    BYTE byFieldId,
+    const Real* __restrict__ pDeviceData,
+    SSmallInt4 sCenterSite,
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE betaOverN, DOUBLE fOmegaSq,
+    DOUBLE* results
+#else
+    Real betaOverN, Real fOmegaSq,
+    Real* results
+#endif
+)
+{
+    intokernalInt4;
+
+    const UINT uiBigIdx = __idx->_deviceGetBigIndex(sSite4);
+
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE fXSq = (sSite4.x - sCenterSite.x + 0.5);
+    fXSq = fXSq * fXSq;
+    DOUBLE fYSq = (sSite4.y - sCenterSite.y + 0.5);
+    fYSq = fYSq * fYSq;
+
+    const DOUBLE fU23 = fXSq * _device4PlaqutteTermU1Angle(pDeviceData, 1, 2, uiBigIdx, sSite4, byFieldId);
+    const DOUBLE fU13 = fYSq * _device4PlaqutteTermU1Angle(pDeviceData, 0, 2, uiBigIdx, sSite4, byFieldId);
+    const DOUBLE fU12 = (fXSq + fYSq) * _device4PlaqutteTermU1Angle(pDeviceData, 0, 1, uiBigIdx, sSite4, byFieldId);
+#else
+    Real fXSq = (sSite4.x - sCenterSite.x + F(0.5));
+    fXSq = fXSq * fXSq;
+    Real fYSq = (sSite4.y - sCenterSite.y + F(0.5));
+    fYSq = fYSq * fYSq;
+
+    const Real fU23 = fXSq * _device4PlaqutteTermU1Angle(pDeviceData, 1, 2, uiBigIdx, sSite4, byFieldId);
+    const Real fU13 = fYSq * _device4PlaqutteTermU1Angle(pDeviceData, 0, 2, uiBigIdx, sSite4, byFieldId);
+    const Real fU12 = (fXSq + fYSq) * _device4PlaqutteTermU1Angle(pDeviceData, 0, 1, uiBigIdx, sSite4, byFieldId);
+#endif
+
+    results[uiSiteIndex] = (fU23 + fU13 + fU12) * betaOverN * fOmegaSq;
+}
+
+__global__ void _CLG_LAUNCH_BOUND
+_kernelAddForce4PlaqutteTermU1Angle_XYZ_Shifted(
+    BYTE byFieldId,
+    const Real* __restrict__ pDeviceData,
+    SSmallInt4 sCenterSite,
+    Real* pForceData,
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE betaOverN, DOUBLE fOmegaSq
+#else
+    Real betaOverN, Real fOmegaSq
+#endif
+)
+{
+    intokernalInt4;
+
+    const UINT uiBigIdx = __idx->_deviceGetBigIndex(sSite4);
+
+    betaOverN = betaOverN * F(-0.5);
+    BYTE idx[6] = { 1, 0, 2, 0, 1, 2 };
+    BYTE byOtherDir[6] = { 2, 1, 2, 0, 0, 1 };
+
+    #pragma unroll
+    for (UINT idir = 0; idir < 3; ++idir)
+    {
+        const UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
+        const Real fTheta = pDeviceData[linkIndex];
+
+        const Real fForce = _deviceStapleTermGfactorU1Angle(byFieldId, pDeviceData, sCenterSite, sSite4, fTheta, fOmegaSq, uiBigIdx,
+            idir, byOtherDir[2 * idir], idx[2 * idir])
+            + _deviceStapleTermGfactorU1Angle(byFieldId, pDeviceData, sCenterSite, sSite4, fTheta, fOmegaSq, uiBigIdx,
+            idir, byOtherDir[2 * idir + 1], idx[2 * idir + 1]);
+
+        pForceData[linkIndex] = pForceData[linkIndex] + fForce * betaOverN;
+    }
+}
+
+__global__ void _CLG_LAUNCH_BOUND
+_kernelAddChairTermU1Angle_Term12_Shifted(
+    BYTE byFieldId,
+    const Real* __restrict__ pDeviceData,
+    SSmallInt4 sCenterSite,
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE betaOverN, DOUBLE fOmega,
+    DOUBLE* results
+#else
+    Real betaOverN, Real fOmega,
+    Real* results
+#endif
+)
+{
+    intokernalInt4;
+
+    const UINT uiN = __idx->_deviceGetBigIndex(sSite4);
+
+#if !_CLG_DOUBLEFLOAT
+    betaOverN = -0.125 * betaOverN;
+    const DOUBLE fXOmega = (sSite4.x - sCenterSite.x + 0.5) * fOmega;
+    const DOUBLE fV412 = fXOmega * _deviceChairTermU1Angle(pDeviceData, byFieldId, sSite4, 3, 0, 1, uiN);
+    const DOUBLE fV432 = fXOmega * _deviceChairTermU1Angle(pDeviceData, byFieldId, sSite4, 3, 2, 1, uiN);
+#else
+    betaOverN = -F(0.125) * betaOverN;
+    const Real fXOmega = (sSite4.x - sCenterSite.x + F(0.5)) * fOmega;
+    const Real fV412 = fXOmega * _deviceChairTermU1Angle(pDeviceData, byFieldId, sSite4, 3, 0, 1, uiN);
+    const Real fV432 = fXOmega * _deviceChairTermU1Angle(pDeviceData, byFieldId, sSite4, 3, 2, 1, uiN);
+#endif
+
+    results[uiSiteIndex] = (fV412 + fV432) * betaOverN;
+}
+
+__global__ void _CLG_LAUNCH_BOUND
+_kernelAddChairTermU1Angle_Term34_Shifted(
+    BYTE byFieldId,
+    const Real* __restrict__ pDeviceData,
+    SSmallInt4 sCenterSite,
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE betaOverN, DOUBLE fOmega,
+    DOUBLE* results
+#else
+    Real betaOverN, Real fOmega,
+    Real* results
+#endif
+)
+{
+    intokernalInt4;
+
+    const UINT uiN = __idx->_deviceGetBigIndex(sSite4);
+
+#if !_CLG_DOUBLEFLOAT
+    betaOverN = 0.125 * betaOverN;
+    const DOUBLE fYOmega = (sSite4.y - sCenterSite.y + 0.5) * fOmega;
+    const DOUBLE fV421 = fYOmega * _deviceChairTermU1Angle(pDeviceData, byFieldId, sSite4, 3, 1, 0, uiN);
+    const DOUBLE fV431 = fYOmega * _deviceChairTermU1Angle(pDeviceData, byFieldId, sSite4, 3, 2, 0, uiN);
+#else
+    betaOverN = F(0.125) * betaOverN;
+    const Real fYOmega = (sSite4.y - sCenterSite.y + F(0.5)) * fOmega;
+    const Real fV421 = fYOmega * _deviceChairTermU1Angle(pDeviceData, byFieldId, sSite4, 3, 1, 0, uiN);
+    const Real fV431 = fYOmega * _deviceChairTermU1Angle(pDeviceData, byFieldId, sSite4, 3, 2, 0, uiN);
+#endif
+
+    results[uiSiteIndex] = (fV421 + fV431) * betaOverN;
+}
+
+__global__ void _CLG_LAUNCH_BOUND
+_kernelAddChairTermU1Angle_Term5_Shifted(
+    BYTE byFieldId,
+    const Real* __restrict__ pDeviceData,
+    SSmallInt4 sCenterSite,
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE betaOverN, DOUBLE fOmegaSq,
+    DOUBLE* results
+#else
+    Real betaOverN, Real fOmegaSq,
+    Real* results
+#endif
+)
+{
+    intokernalInt4;
+
+    const UINT uiN = __idx->_deviceGetBigIndex(sSite4);
+
+#if !_CLG_DOUBLEFLOAT
+    betaOverN = -0.125 * betaOverN;
+    const DOUBLE fXYOmega2 = (sSite4.x - sCenterSite.x + 0.5) * (sSite4.y - sCenterSite.y + 0.5) * fOmegaSq;
+    const DOUBLE fV132 = fXYOmega2 * _deviceChairTermU1Angle(pDeviceData, byFieldId, sSite4, 0, 2, 1, uiN);
+#else
+    betaOverN = -F(0.125) * betaOverN;
+    const Real fXYOmega2 = (sSite4.x - sCenterSite.x + F(0.5)) * (sSite4.y - sCenterSite.y + F(0.5)) * fOmegaSq;
+    const Real fV132 = fXYOmega2 * _deviceChairTermU1Angle(pDeviceData, byFieldId, sSite4, 0, 2, 1, uiN);
+#endif
+
+    results[uiSiteIndex] = fV132 * betaOverN;
+}
+
+/**
+* The five chair force terms of the kernels above in one launch,
+* {link, mu, nu, rho, i, term1 or term2} of each staple
+*/
+__global__ void _CLG_LAUNCH_BOUND
+_kernelAddForceChairTermU1Angle_Shifted(
+    BYTE byFieldId,
+    const Real* __restrict__ pDeviceData,
+    SSmallInt4 sCenterSite,
+    Real* pForceData,
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE betaOverN, DOUBLE fOmega
+#else
+    Real betaOverN, Real fOmega
+#endif
+)
+{
+    intokernalInt4;
+
+    const UINT uiBigIdx = __idx->_deviceGetBigIndex(sSite4);
+
+    //Term1 to Term4 are O(Omega), Term5 is O(Omega^2)
+    const Real fCoeff = static_cast<Real>(-betaOverN * F(0.5) * fOmega * F(0.125));
+    const Real fCoeff5 = static_cast<Real>(fCoeff * fOmega);
+
+    const BYTE byTerms[15][6] = {
+        { 3, 3, 0, 1, 0, 1 }, { 1, 1, 0, 3, 0, 1 }, { 0, 3, 0, 1, 0, 2 },
+        { 3, 3, 2, 1, 0, 1 }, { 1, 1, 2, 3, 0, 1 }, { 2, 3, 2, 1, 0, 2 },
+        { 3, 3, 1, 0, 1, 1 }, { 0, 0, 1, 3, 1, 1 }, { 1, 3, 1, 0, 1, 2 },
+        { 3, 3, 2, 0, 1, 1 }, { 0, 0, 2, 3, 1, 1 }, { 2, 3, 2, 0, 1, 2 },
+        { 0, 0, 2, 1, 2, 1 }, { 1, 1, 2, 0, 2, 1 }, { 2, 0, 2, 1, 2, 2 },
+    };
+
+    Real fForce[4] = { F(0.0), F(0.0), F(0.0), F(0.0) };
+    const Real fTheta[4] = {
+        pDeviceData[_deviceGetLinkIndex(uiSiteIndex, 0)],
+        pDeviceData[_deviceGetLinkIndex(uiSiteIndex, 1)],
+        pDeviceData[_deviceGetLinkIndex(uiSiteIndex, 2)],
+        pDeviceData[_deviceGetLinkIndex(uiSiteIndex, 3)]
+    };
+
+    #pragma unroll
+    for (UINT uiTerm = 0; uiTerm < 15; ++uiTerm)
+    {
+        const BYTE byLink = byTerms[uiTerm][0];
+        const Real fStaple = (1 == byTerms[uiTerm][5])
+            ? _deviceStapleChairTerm1ShiftedU1Angle(byFieldId, pDeviceData, sCenterSite, sSite4, fTheta[byLink], uiBigIdx,
+                byTerms[uiTerm][1], byTerms[uiTerm][2], byTerms[uiTerm][3], byTerms[uiTerm][4])
+            : _deviceStapleChairTerm2ShiftedU1Angle(byFieldId, pDeviceData, sCenterSite, sSite4, fTheta[byLink], uiBigIdx,
+                byTerms[uiTerm][1], byTerms[uiTerm][2], byTerms[uiTerm][3], byTerms[uiTerm][4]);
+        fForce[byLink] += fStaple * (uiTerm < 12 ? fCoeff : fCoeff5);
+    }
+
+    #pragma unroll
+    for (BYTE byDir = 0; byDir < 4; ++byDir)
+    {
+        const UINT uiLink = _deviceGetLinkIndex(uiSiteIndex, byDir);
+        pForceData[uiLink] = pForceData[uiLink] + fForce[byDir];
+    }
+}
+
+#pragma endregion
+
 #pragma endregion
 
 CActionGaugePlaquetteRotatingU1::CActionGaugePlaquetteRotatingU1()
@@ -636,10 +879,10 @@ void CActionGaugePlaquetteRotatingU1::Initial(class CLatticeData* pOwner, const
     if (centerArray.Num() > 3)
     {
         SSmallInt4 sCenter;
-        sCenter.x = static_cast<SBYTE>(centerArray[0]);
-        sCenter.y = static_cast<SBYTE>(centerArray[1]);
-        sCenter.z = static_cast<SBYTE>(centerArray[2]);
-        sCenter.w = static_cast<SBYTE>(centerArray[3]);
+        sCenter.x = static_cast<SCOORD>(centerArray[0] - _HC_XOrigin);
+        sCenter.y = static_cast<SCOORD>(centerArray[1]);
+        sCenter.z = static_cast<SCOORD>(centerArray[2]);
+        sCenter.w = static_cast<SCOORD>(centerArray[3]);
         CCommonData::m_sCenter = sCenter;
     }
 
@@ -655,6 +898,12 @@ void CActionGaugePlaquetteRotatingU1::Initial(class CLatticeData* pOwner, const
     INT iShiftCoord = 0;
     param.FetchValueINT(_T("ShiftCoord"), iShiftCoord);
     m_bShiftHalfCoord = (0 != iShiftCoord);
+
+    //the path table does not follow the twisted links of the projective plane
+    if (!m_bShiftHalfCoord)
+    {
+        CActionGaugePlaquetteRotating::BuildPathTable(m_cOmegaTable, m_cOmegaSqTable);
+    }
 }
 
 #if !_CLG_DOUBLEFLOAT
@@ -675,43 +924,76 @@ UBOOL CActionGaugePlaquetteRotatingU1::CalculateForceOnGauge(const CFieldGauge *
     pGauge->CalculateForceAndStaple(pForce, pStaple, m_fBetaOverN);
 #endif
 
-    const CFieldGaugeU1* pGaugeU1 = dynamic_cast<const CFieldGaugeU1*>(pGauge);
-    CFieldGaugeU1* pForceU1 = dynamic_cast<CFieldGaugeU1*>(pForce);
-    if (NULL == pGaugeU1 || NULL == pForceU1)
+    if (!m_bShiftHalfCoord)
     {
-        appCrucial(_T("CActionGaugePlaquetteRotatingU1 only work with U1 now.\n"));
+        const Real fBetaOmegaSq = static_cast<Real>(m_fBetaOverN * m_fOmega * m_fOmega);
+        const Real fBetaOmega = static_cast<Real>(m_fBetaOverN * m_fOmega);
+        if (EFT_GaugeU1Angle == pGauge->GetFieldType() && EFT_GaugeU1Angle == pForce->GetFieldType())
+        {
+            const CFieldGaugeU1Angle* pGaugeAngle = dynamic_cast<const CFieldGaugeU1Angle*>(pGauge);
+            CFieldGaugeU1Angle* pForceAngle = dynamic_cast<CFieldGaugeU1Angle*>(pForce);
+            m_cOmegaSqTable.Force(pGaugeAngle, pForceAngle, fBetaOmegaSq, CCommonData::m_sCenter, F(0.0));
+            m_cOmegaTable.Force(pGaugeAngle, pForceAngle, fBetaOmega, CCommonData::m_sCenter, F(0.0));
+        }
+        else if (EFT_GaugeU1 == pGauge->GetFieldType() && EFT_GaugeU1 == pForce->GetFieldType())
+        {
+            const CFieldGaugeU1* pGaugeU1 = dynamic_cast<const CFieldGaugeU1*>(pGauge);
+            CFieldGaugeU1* pForceU1 = dynamic_cast<CFieldGaugeU1*>(pForce);
+            m_cOmegaSqTable.Force(pGaugeU1, pForceU1, fBetaOmegaSq, CCommonData::m_sCenter, F(0.0));
+            m_cOmegaTable.Force(pGaugeU1, pForceU1, fBetaOmega, CCommonData::m_sCenter, F(0.0));
+        }
+        else
+        {
+            appCrucial(_T("CActionGaugePlaquetteRotatingU1 only work with U1 now.\n"));
+        }
+        checkCudaErrors(cudaDeviceSynchronize());
         return TRUE;
     }
 
+    const BYTE byFieldId = pGauge->m_byFieldId;
     preparethread;
 
-
-    if (!m_bShiftHalfCoord)
+    if (EFT_GaugeU1Angle == pGauge->GetFieldType() && EFT_GaugeU1Angle == pForce->GetFieldType())
     {
-        appCrucial(_T("Dirichlet not supported yet"));
+        const CFieldGaugeU1Angle* pGaugeAngle = dynamic_cast<const CFieldGaugeU1Angle*>(pGauge);
+        CFieldGaugeU1Angle* pForceAngle = dynamic_cast<CFieldGaugeU1Angle*>(pForce);
+
+        _kernelAddForce4PlaqutteTermU1Angle_XYZ_Shifted << <block, threads >> > (byFieldId, pGaugeAngle->m_pDeviceData, CCommonData::m_sCenter,
+            pForceAngle->m_pDeviceData, m_fBetaOverN, m_fOmega * m_fOmega);
+
+        _kernelAddForceChairTermU1Angle_Shifted << <block, threads >> > (byFieldId, pGaugeAngle->m_pDeviceData, CCommonData::m_sCenter,
+            pForceAngle->m_pDeviceData, m_fBetaOverN, m_fOmega);
+
+        checkCudaErrors(cudaDeviceSynchronize());
+        return TRUE;
     }
-    else
+
+    if (EFT_GaugeU1 != pGauge->GetFieldType() || EFT_GaugeU1 != pForce->GetFieldType())
     {
+        appCrucial(_T("CActionGaugePlaquetteRotatingU1 only work with U1 now.\n"));
+        return TRUE;
+    }
+    const CLGComplex* pU1Links = dynamic_cast<const CFieldGaugeU1*>(pGauge)->m_pDeviceData;
+    CLGComplex* pForceBuffer = dynamic_cast<CFieldGaugeU1*>(pForce)->m_pDeviceData;
 
-        _kernelAddForce4PlaqutteTermU1_XYZ_Shifted << <block, threads >> > (pGaugeU1->m_byFieldId, pGaugeU1->m_pDeviceData, CCommonData::m_sCenter,
-            pForceU1->m_pDeviceData, m_fBetaOverN, m_fOmega * m_fOmega);
+    _kernelAddForce4PlaqutteTermU1_XYZ_Shifted << <block, threads >> > (byFieldId, pU1Links, CCommonData::m_sCenter,
+        pForceBuffer, m_fBetaOverN, m_fOmega * m_fOmega);
 
-        
-        _kernelAddForceChairTermU1_Term1_Shifted << <block, threads >> > (pGaugeU1->m_byFieldId, pGaugeU1->m_pDeviceData, CCommonData::m_sCenter,
-            pForceU1->m_pDeviceData, m_fBetaOverN, m_fOmega);
+    
+    _kernelAddForceChairTermU1_Term1_Shifted << <block, threads >> > (byFieldId, pU1Links, CCommonData::m_sCenter,
+        pForceBuffer, m_fBetaOverN, m_fOmega);
 
-        _kernelAddForceChairTermU1_Term2_Shifted << <block, threads >> > (pGaugeU1->m_byFieldId, pGaugeU1->m_pDeviceData, CCommonData::m_sCenter,
-            pForceU1->m_pDeviceData, m_fBetaOverN, m_fOmega);
-        
-        _kernelAddForceChairTermU1_Term3_Shifted << <block, threads >> > (pGaugeU1->m_byFieldId, pGaugeU1->m_pDeviceData, CCommonData::m_sCenter,
-            pForceU1->m_pDeviceData, m_fBetaOverN, m_fOmega);
+    _kernelAddForceChairTermU1_Term2_Shifted << <block, threads >> > (byFieldId, pU1Links, CCommonData::m_sCenter,
+        pForceBuffer, m_fBetaOverN, m_fOmega);
+    
+    _kernelAddForceChairTermU1_Term3_Shifted << <block, threads >> > (byFieldId, pU1Links, CCommonData::m_sCenter,
+        pForceBuffer, m_fBetaOverN, m_fOmega);
 
-        _kernelAddForceChairTermU1_Term4_Shifted << <block, threads >> > (pGaugeU1->m_byFieldId, pGaugeU1->m_pDeviceData, CCommonData::m_sCenter,
-            pForceU1->m_pDeviceData, m_fBetaOverN, m_fOmega);
+    _kernelAddForceChairTermU1_Term4_Shifted << <block, threads >> > (byFieldId, pU1Links, CCommonData::m_sCenter,
+        pForceBuffer, m_fBetaOverN, m_fOmega);
 
-        _kernelAddForceChairTermU1_Term5_Shifted << <block, threads >> > (pGaugeU1->m_byFieldId, pGaugeU1->m_pDeviceData, CCommonData::m_sCenter,
-            pForceU1->m_pDeviceData, m_fBetaOverN, m_fOmega * m_fOmega);
-    }
+    _kernelAddForceChairTermU1_Term5_Shifted << <block, threads >> > (byFieldId, pU1Links, CCommonData::m_sCenter,
+        pForceBuffer, m_fBetaOverN, m_fOmega * m_fOmega);
 
     checkCudaErrors(cudaDeviceSynchronize());
     return TRUE;
@@ -737,14 +1019,27 @@ Real CActionGaugePlaquetteRotatingU1::Energy(UBOOL bBeforeEvolution, const class
     }
     else
     {
-        //m_fNewEnergy = pGauge->CalculatePlaqutteEnergy(m_fBetaOverN);
-        appCrucial(_T("Dirichlet not supported yet"));
+        m_fNewEnergy = pGauge->CalculatePlaqutteEnergy(m_fBetaOverN);
     }
-    
-    const CFieldGaugeU1* pGaugeU1 = dynamic_cast<const CFieldGaugeU1*>(pGauge);
-    if (NULL == pGaugeU1)
+
+    if (!m_bShiftHalfCoord)
     {
-        appCrucial(_T("CActionGaugePlaquetteRotatingU1 only work with U1 now.\n"));
+        if (EFT_GaugeU1Angle == pGauge->GetFieldType())
+        {
+            const CFieldGaugeU1Angle* pGaugeAngle = dynamic_cast<const CFieldGaugeU1Angle*>(pGauge);
+            m_fNewEnergy += m_cOmegaSqTable.Energy(pGaugeAngle, m_fBetaOverN * m_fOmega * m_fOmega, CCommonData::m_sCenter, F(0.0));
+            m_fNewEnergy += m_cOmegaTable.Energy(pGaugeAngle, m_fBetaOverN * m_fOmega, CCommonData::m_sCenter, F(0.0));
+        }
+        else if (EFT_GaugeU1 == pGauge->GetFieldType())
+        {
+            const CFieldGaugeU1* pGaugeU1 = dynamic_cast<const CFieldGaugeU1*>(pGauge);
+            m_fNewEnergy += m_cOmegaSqTable.Energy(pGaugeU1, m_fBetaOverN * m_fOmega * m_fOmega, CCommonData::m_sCenter, F(0.0));
+            m_fNewEnergy += m_cOmegaTable.Energy(pGaugeU1, m_fBetaOverN * m_fOmega, CCommonData::m_sCenter, F(0.0));
+        }
+        else
+        {
+            appCrucial(_T("CActionGaugePlaquetteRotatingU1 only work with U1 now.\n"));
+        }
         return m_fNewEnergy;
     }
 
@@ -752,54 +1047,76 @@ Real CActionGaugePlaquetteRotatingU1::Energy(UBOOL bBeforeEvolution, const class
 
     appGetCudaHelper()->ThreadBufferZero(_D_RealThreadBuffer);
 
-    if (m_bShiftHalfCoord)
+    if (EFT_GaugeU1Angle == pGauge->GetFieldType())
     {
+        const Real* pAngles = dynamic_cast<const CFieldGaugeU1Angle*>(pGauge)->m_pDeviceData;
 
-        _kernelAdd4PlaqutteTermU1_Shifted << <block, threads >> > (
-            pGaugeU1->m_byFieldId,
-            pGaugeU1->m_pDeviceData,
-            CCommonData::m_sCenter,
-            m_fBetaOverN,
-            m_fOmega * m_fOmega,
-            _D_RealThreadBuffer);
-
+        _kernelAdd4PlaqutteTermU1Angle_Shifted << <block, threads >> > (
+            pGauge->m_byFieldId, pAngles, CCommonData::m_sCenter,
+            m_fBetaOverN, m_fOmega * m_fOmega, _D_RealThreadBuffer);
         m_fNewEnergy += appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
 
-        
-        _kernelAddChairTermU1_Term12_Shifted << <block, threads >> > (
-            pGaugeU1->m_byFieldId,
-            pGaugeU1->m_pDeviceData,
-            CCommonData::m_sCenter,
-            m_fBetaOverN, 
-            m_fOmega, 
-            _D_RealThreadBuffer);
+        _kernelAddChairTermU1Angle_Term12_Shifted << <block, threads >> > (
+            pGauge->m_byFieldId, pAngles, CCommonData::m_sCenter,
+            m_fBetaOverN, m_fOmega, _D_RealThreadBuffer);
         m_fNewEnergy += appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
 
-        
-        _kernelAddChairTermU1_Term34_Shifted << <block, threads >> > (
-            pGaugeU1->m_byFieldId,
-            pGaugeU1->m_pDeviceData,
-            CCommonData::m_sCenter,
-            m_fBetaOverN,
-            m_fOmega,
-            _D_RealThreadBuffer);
+        _kernelAddChairTermU1Angle_Term34_Shifted << <block, threads >> > (
+            pGauge->m_byFieldId, pAngles, CCommonData::m_sCenter,
+            m_fBetaOverN, m_fOmega, _D_RealThreadBuffer);
         m_fNewEnergy += appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
 
-        _kernelAddChairTermU1_Term5_Shifted << <block, threads >> > (
-            pGaugeU1->m_byFieldId,
-            pGaugeU1->m_pDeviceData,
-            CCommonData::m_sCenter,
-            m_fBetaOverN,
-            m_fOmega * m_fOmega,
-            _D_RealThreadBuffer);
+        _kernelAddChairTermU1Angle_Term5_Shifted << <block, threads >> > (
+            pGauge->m_byFieldId, pAngles, CCommonData::m_sCenter,
+            m_fBetaOverN, m_fOmega * m_fOmega, _D_RealThreadBuffer);
         m_fNewEnergy += appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
 
+        return m_fNewEnergy;
     }
-    else
+
+    if (EFT_GaugeU1 != pGauge->GetFieldType())
     {
-        appCrucial(_T("Dirichlet not supported yet"));
+        appCrucial(_T("CActionGaugePlaquetteRotatingU1 only work with U1 now.\n"));
+        return m_fNewEnergy;
     }
-
+    const CLGComplex* pU1Links = dynamic_cast<const CFieldGaugeU1*>(pGauge)->m_pDeviceData;
+
+    _kernelAdd4PlaqutteTermU1_Shifted << <block, threads >> > (
+        pGauge->m_byFieldId,
+        pU1Links,
+        CCommonData::m_sCenter,
+        m_fBetaOverN,
+        m_fOmega * m_fOmega,
+        _D_RealThreadBuffer);
+
+    m_fNewEnergy += appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
+
+    _kernelAddChairTermU1_Term12_Shifted << <block, threads >> > (
+        pGauge->m_byFieldId,
+        pU1Links,
+        CCommonData::m_sCenter,
+        m_fBetaOverN, 
+        m_fOmega, 
+        _D_RealThreadBuffer);
+    m_fNewEnergy += appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
+
+    _kernelAddChairTermU1_Term34_Shifted << <block, threads >> > (
+        pGauge->m_byFieldId,
+        pU1Links,
+        CCommonData::m_sCenter,
+        m_fBetaOverN,
+        m_fOmega,
+        _D_RealThreadBuffer);
+    m_fNewEnergy += appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
+
+    _kernelAddChairTermU1_Term5_Shifted << <block, threads >> > (
+        pGauge->m_byFieldId,
+        pU1Links,
+        CCommonData::m_sCenter,
+        m_fBetaOverN,
+        m_fOmega * m_fOmega,
+        _D_RealThreadBuffer);
+    m_fNewEnergy += appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
 
     return m_fNewEnergy;
 }
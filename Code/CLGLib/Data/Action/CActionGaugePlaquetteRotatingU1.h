@@ -5,6 +5,9 @@
 // This is the class for rotating guage action
 // Open boundary condition (identity Dirichlet boundary condition) is assumed 
 // 
+// Without ShiftCoord, the Omega terms are in CGaugePathTable (the same loops as CActionGaugePlaquetteRotating),
+// ShiftCoord is using the kernels here (the path table does not support projective plane),
+// with a copy of them on the angles for CFieldGaugeU1Angle
 //
 // REVISION:
 //  [10/01/2021 nbale]
@@ -71,6 +74,10 @@ protected:
 #endif
 
     UINT m_uiPlaqutteCount;
+
+    //terms with Omega and Omega^2
+    CGaugePathTable m_cOmegaTable;
+    CGaugePathTable m_cOmegaSqTable;
 };
 
 //================= Put those device functions to header file because we will use them ==============
@@ -1044,7 +1051,7 @@ static __device__ __inline__ CLGComplex _deviceStapleT2U1(
 //    if (0 == byType)
 //    {
 //        //x
-//        const UBOOL bOpposite = sSite4.x >= static_cast<SBYTE>(_DC_Lx) || sSite4.x < 0;
+//        const UBOOL bOpposite = sSite4.x >= static_cast<SCOORD>(_DC_Lx) || sSite4.x < 0;
 //        sSite4 = __deviceSiteIndexToInt4(__idx->m_pDeviceIndexPositionToSIndex[byFieldId][__bi(sSite4)].m_uiSiteIndex);
 //        if (bOpposite)
 //        {
@@ -1055,7 +1062,7 @@ static __device__ __inline__ CLGComplex _deviceStapleT2U1(
 //    if (1 == byType)
 //    {
 //        //y
-//        const UBOOL bOpposite = sSite4.y >= static_cast<SBYTE>(_DC_Ly) || sSite4.y < 0;
+//        const UBOOL bOpposite = sSite4.y >= static_cast<SCOORD>(_DC_Ly) || sSite4.y < 0;
 //        sSite4 = __deviceSiteIndexToInt4(__idx->m_pDeviceIndexPositionToSIndex[byFieldId][__bi(sSite4)].m_uiSiteIndex);
 //        if (bOpposite)
 //        {
@@ -1071,8 +1078,8 @@ static __device__ __inline__ CLGComplex _deviceStapleT2U1(
 //    }
 //
 //    //byType = 2 and this is XY
-//    const BYTE bOppositeX = (sSite4.x >= static_cast<SBYTE>(_DC_Lx) || sSite4.x < 0) ? 1 : 0;
-//    const BYTE bOppositeY = (sSite4.y >= static_cast<SBYTE>(_DC_Ly) || sSite4.y < 0) ? 1 : 0;
+//    const BYTE bOppositeX = (sSite4.x >= static_cast<SCOORD>(_DC_Lx) || sSite4.x < 0) ? 1 : 0;
+//    const BYTE bOppositeY = (sSite4.y >= static_cast<SCOORD>(_DC_Ly) || sSite4.y < 0) ? 1 : 0;
 //    sSite4 = __deviceSiteIndexToInt4(__idx->m_pDeviceIndexPositionToSIndex[byFieldId][__bi(sSite4)].m_uiSiteIndex);
 //    const Real fRet = (sSite4.x - sCenterSite.x + F(0.5)) * (sSite4.y - sCenterSite.y + F(0.5));
 //    if (0 != (bOppositeX ^ bOppositeY))
@@ -1254,6 +1261,356 @@ static __device__ __inline__ CLGComplex _deviceStapleChairTerm2ShiftedU1(
 
 #pragma endregion
 
+#pragma region device function for CFieldGaugeU1Angle
+
+/**
+* The same terms as above for CFieldGaugeU1Angle, without the exp(i theta) copy.
+* A product of links is a sum of angles (a dagger is a minus sign), so
+* Re[(e^{ia}-e^{ib})(e^{ic}-e^{id})] = cos(a+c) - cos(a+d) - cos(b+c) + cos(b+d)
+* For a staple S = sum_k g_k e^{iS_k}, the force is Im[U S^+] = sum_k g_k sin(theta - S_k),
+* so the staple functions take theta and return Im[U S^+].
+*/
+static __device__ __inline__ Real _deviceReDiffProductU1Angle(Real a, Real b, Real c, Real d)
+{
+    return _cos(_deviceWrapU1Angle(a + c)) - _cos(_deviceWrapU1Angle(a + d))
+         - _cos(_deviceWrapU1Angle(b + c)) + _cos(_deviceWrapU1Angle(b + d));
+}
+
+/**
+* Im[e^{i theta} (e^{i(a+e)}-e^{i(b+e)})^+]
+*/
+static __device__ __inline__ Real _deviceImDiffStapleU1Angle(Real fTheta, Real a, Real b, Real e)
+{
+    return _sin(_deviceWrapU1Angle(fTheta - a - e)) - _sin(_deviceWrapU1Angle(fTheta - b - e));
+}
+
+static __device__ __inline__ Real _device4PlaqutteTermU1Angle(const Real* __restrict__ pDeviceData,
+    BYTE byMu, BYTE byNu, UINT uiBigIndex, const SSmallInt4& sSite4, BYTE byFieldId)
+{
+    return F(1.0) - F(0.25) * _deviceCloverCosU1Angle(pDeviceData, sSite4, uiBigIndex, byMu, byNu, byFieldId);
+}
+
+/**
+* See _deviceChairTermU1
+*/
+static __device__ __inline__ Real _deviceChairTermU1Angle(const Real* __restrict__ pDeviceData,
+    BYTE byFieldId, const SSmallInt4& sSite,
+    BYTE mu, BYTE nu, BYTE rho, UINT uiBigIndex)
+{
+    const SIndex* __restrict__ pLinks = __idx->m_pDeviceIndexLinkToSIndex[byFieldId];
+    const SSmallInt4 n_p_mu = _deviceSmallInt4OffsetC(sSite, __fwd(mu));
+    const SSmallInt4 n_m_mu = _deviceSmallInt4OffsetC(sSite, __bck(mu));
+    const SSmallInt4 n_p_nu = _deviceSmallInt4OffsetC(sSite, __fwd(nu));
+    const SSmallInt4 n_m_nu = _deviceSmallInt4OffsetC(sSite, __bck(nu));
+    const SSmallInt4 n_p_rho = _deviceSmallInt4OffsetC(sSite, __fwd(rho));
+    const SSmallInt4 n_m_rho = _deviceSmallInt4OffsetC(sSite, __bck(rho));
+
+    const SSmallInt4 n_p_mu_m_nu = _deviceSmallInt4OffsetC(n_p_mu, __bck(nu));
+    const SSmallInt4 n_m_mu_p_nu = _deviceSmallInt4OffsetC(n_m_mu, __fwd(nu));
+    const SSmallInt4 n_m_mu_m_nu = _deviceSmallInt4OffsetC(n_m_mu, __bck(nu));
+    const SSmallInt4 n_m_rho_p_nu = _deviceSmallInt4OffsetC(n_m_rho, __fwd(nu));
+    const SSmallInt4 n_m_rho_m_nu = _deviceSmallInt4OffsetC(n_m_rho, __bck(nu));
+    const SSmallInt4 n_m_nu_p_rho = _deviceSmallInt4OffsetC(n_m_nu, __fwd(rho));
+
+    const UINT n_bi4 = uiBigIndex * _DC_Dir;
+    const UINT n_p_nu_bi4 = __bi4(n_p_nu);
+    const UINT n_m_mu_bi4 = __bi4(n_m_mu);
+    const UINT n_m_rho_bi4 = __bi4(n_m_rho);
+    const UINT n_m_nu_bi4 = __bi4(n_m_nu);
+    const UINT n_m_mu_m_nu_bi4 = __bi4(n_m_mu_m_nu);
+    const UINT n_m_rho_m_nu_bi4 = __bi4(n_m_rho_m_nu);
+
+    const Real n__mu = _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_bi4 + mu], byFieldId);
+    const Real n__rho = _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_bi4 + rho], byFieldId);
+    const Real n_m_mu__mu = _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_mu_bi4 + mu], byFieldId);
+    const Real n_m_rho__rho = _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_rho_bi4 + rho], byFieldId);
+
+    //U_{mu}(N) U_{nu}(N+mu) U^+_{mu}(n+nu) - U^+_{mu}(N-mu) U_{nu}(N-mu) U_{mu}(N-mu+nu)
+    const Real fTerm1Plus = n__mu
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_p_mu) + nu], byFieldId)
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_p_nu_bi4 + mu], byFieldId);
+    const Real fTerm1Minus = - n_m_mu__mu
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_mu_bi4 + nu], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_m_mu_p_nu) + mu], byFieldId);
+
+    //U_{rho}(N+nu) U^+_{nu}(N+rho) U^+_{rho}(N) - U^+_{rho}(N+nu-rho) U^+_{nu}(N-rho) U_{rho}(N-rho)
+    const Real fTerm2Plus = _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_p_nu_bi4 + rho], byFieldId)
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_p_rho) + nu], byFieldId)
+        - n__rho;
+    const Real fTerm2Minus = - _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_m_rho_p_nu) + rho], byFieldId)
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_rho_bi4 + nu], byFieldId)
+        + n_m_rho__rho;
+
+    //U_{mu}(N) U^+_{nu}(N+mu-nu) U^+_{mu}(N-nu) - U^+_{mu}(N-mu) U^+_{nu}(N-mu-nu) U_{mu}(N-mu-nu)
+    const Real fTerm3Plus = n__mu
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_p_mu_m_nu) + nu], byFieldId)
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_nu_bi4 + mu], byFieldId);
+    const Real fTerm3Minus = - n_m_mu__mu
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_mu_m_nu_bi4 + nu], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_mu_m_nu_bi4 + mu], byFieldId);
+
+    //U_{rho}(N-nu) U_{nu}(N-nu+rho) U^+_{rho}(N) - U^+_{rho}(N-rho-nu) U_{nu}(N-rho-nu) U_{rho}(N-rho)
+    const Real fTerm4Plus = _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_nu_bi4 + rho], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_m_nu_p_rho) + nu], byFieldId)
+        - n__rho;
+    const Real fTerm4Minus = - _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_rho_m_nu_bi4 + rho], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_rho_m_nu_bi4 + nu], byFieldId)
+        + n_m_rho__rho;
+
+    return _deviceReDiffProductU1Angle(fTerm1Plus, fTerm1Minus, fTerm2Plus, fTerm2Minus)
+         + _deviceReDiffProductU1Angle(fTerm3Plus, fTerm3Minus, fTerm4Plus, fTerm4Minus);
+}
+
+/**
+* See _deviceStapleTermGfactorU1, Im[U_mu(n) S^+] with the shifted coordinate
+*/
+static __device__ __inline__ Real _deviceStapleTermGfactorU1Angle(
+    BYTE byFieldId,
+    const Real* __restrict__ pDeviceData,
+    const SSmallInt4& sCenter, const SSmallInt4& sSite, Real fTheta, Real fOmegaSq,
+    UINT uiBigIndex, BYTE mu, BYTE nu, BYTE i)
+{
+    const SIndex* __restrict__ pLinks = __idx->m_pDeviceIndexLinkToSIndex[byFieldId];
+    const SSmallInt4 n_p_mu = _deviceSmallInt4OffsetC(sSite, __fwd(mu));
+    const SSmallInt4 n_p_nu = _deviceSmallInt4OffsetC(sSite, __fwd(nu));
+    const SSmallInt4 n_m_nu = _deviceSmallInt4OffsetC(sSite, __bck(nu));
+    const SSmallInt4 n_p_mu_m_nu = _deviceSmallInt4OffsetC(n_m_nu, __fwd(mu));
+    const UINT n_m_nu_bi4 = __bi4(n_m_nu);
+
+    //U_nu(n) U_mu(n+nu) U^+_nu(n+mu)
+    const Real fLeft = _deviceGetU1AngleSIndex(pDeviceData, pLinks[uiBigIndex * _DC_Dir + nu], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_p_nu) + mu], byFieldId)
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_p_mu) + nu], byFieldId);
+
+    //U^+_nu(n-nu) U_mu(n-nu) U_nu(n+mu-nu)
+    const Real fRight = - _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_nu_bi4 + nu], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_nu_bi4 + mu], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_p_mu_m_nu) + nu], byFieldId);
+
+    return (_sin(_deviceWrapU1Angle(fTheta - fLeft)) * _deviceFiShifted(byFieldId, sSite, sCenter, i, mu, nu)
+          + _sin(_deviceWrapU1Angle(fTheta - fRight)) * _deviceFiShifted(byFieldId, n_m_nu, sCenter, i, mu, nu)) * fOmegaSq;
+}
+
+/**
+* See _deviceStapleS1ShiftedU1, S1 = U(N) U(N+rho) U(N+nu) - U(N-rho) U(N-rho) U(N-rho+nu)
+*/
+static __device__ __inline__ Real _deviceStapleS1ShiftedU1Angle(
+    BYTE byFieldId,
+    const Real* __restrict__ pDeviceData,
+    const SSmallInt4& sCenter, const SSmallInt4& sSite, Real fTheta,
+    UINT uiBigIndex, BYTE mu, BYTE nu, BYTE rho, BYTE i)
+{
+    const SIndex* __restrict__ pLinks = __idx->m_pDeviceIndexLinkToSIndex[byFieldId];
+    const SSmallInt4 n_p_mu = _deviceSmallInt4OffsetC(sSite, __fwd(mu));
+    const SSmallInt4 n_p_nu = _deviceSmallInt4OffsetC(sSite, __fwd(nu));
+    const SSmallInt4 n_p_rho = _deviceSmallInt4OffsetC(sSite, __fwd(rho));
+    const SSmallInt4 n_m_rho = _deviceSmallInt4OffsetC(sSite, __bck(rho));
+    const SSmallInt4 n_m_rho_p_nu = _deviceSmallInt4OffsetC(n_m_rho, __fwd(nu));
+    const UINT n_p_nu_bi4 = __bi4(n_p_nu);
+    const UINT n_m_rho_bi4 = __bi4(n_m_rho);
+
+    const Real fPlus = _deviceGetU1AngleSIndex(pDeviceData, pLinks[uiBigIndex * _DC_Dir + rho], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_p_rho) + nu], byFieldId)
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_p_nu_bi4 + rho], byFieldId);
+    const Real fMinus = - _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_rho_bi4 + rho], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_rho_bi4 + nu], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_m_rho_p_nu) + rho], byFieldId);
+
+    //S1 U_mu(n+nu) U^+_nu(n+mu)
+    const Real fRest = _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_p_nu_bi4 + mu], byFieldId)
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_p_mu) + nu], byFieldId);
+
+    return _deviceHiShifted(byFieldId, sCenter, sSite, n_p_nu, i) * _deviceImDiffStapleU1Angle(fTheta, fPlus, fMinus, fRest);
+}
+
+/**
+* See _deviceStapleS2ShiftedU1, S2 = U(N) U(N-nu+rho) U(N-nu) - U(N-rho) U(N-rho-nu) U(N-rho-nu)
+*/
+static __device__ __inline__ Real _deviceStapleS2ShiftedU1Angle(
+    BYTE byFieldId,
+    const Real* __restrict__ pDeviceData,
+    const SSmallInt4& sCenter, const SSmallInt4& sSite, Real fTheta,
+    UINT uiBigIndex, BYTE mu, BYTE nu, BYTE rho, BYTE i)
+{
+    const SIndex* __restrict__ pLinks = __idx->m_pDeviceIndexLinkToSIndex[byFieldId];
+    const SSmallInt4 n_m_nu = _deviceSmallInt4OffsetC(sSite, __bck(nu));
+    const SSmallInt4 n_m_nu_p_mu = _deviceSmallInt4OffsetC(n_m_nu, __fwd(mu));
+    const SSmallInt4 n_m_nu_p_rho = _deviceSmallInt4OffsetC(n_m_nu, __fwd(rho));
+    const SSmallInt4 n_m_rho = _deviceSmallInt4OffsetC(sSite, __bck(rho));
+    const SSmallInt4 n_m_rho_m_nu = _deviceSmallInt4OffsetC(n_m_rho, __bck(nu));
+    const UINT n_m_nu_bi4 = __bi4(n_m_nu);
+    const UINT n_m_rho_m_nu_bi4 = __bi4(n_m_rho_m_nu);
+
+    const Real fPlus = _deviceGetU1AngleSIndex(pDeviceData, pLinks[uiBigIndex * _DC_Dir + rho], byFieldId)
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_m_nu_p_rho) + nu], byFieldId)
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_nu_bi4 + rho], byFieldId);
+    const Real fMinus = - _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_m_rho) + rho], byFieldId)
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_rho_m_nu_bi4 + nu], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_rho_m_nu_bi4 + rho], byFieldId);
+
+    //S2 U_mu(n-nu) U_nu(n-nu+mu)
+    const Real fRest = _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_nu_bi4 + mu], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_m_nu_p_mu) + nu], byFieldId);
+
+    return _deviceHiShifted(byFieldId, sCenter, sSite, n_m_nu, i) * _deviceImDiffStapleU1Angle(fTheta, fPlus, fMinus, fRest);
+}
+
+/**
+* See _deviceStapleS3ShiftedU1, S3 = U(N+mu-rho+nu) U(N+mu-rho) U(N+mu-rho) - U(N+mu+nu) U(N+mu+rho) U(N+mu)
+*/
+static __device__ __inline__ Real _deviceStapleS3ShiftedU1Angle(
+    BYTE byFieldId,
+    const Real* __restrict__ pDeviceData,
+    const SSmallInt4& sCenter, const SSmallInt4& sSite, Real fTheta,
+    UINT uiBigIndex, BYTE mu, BYTE nu, BYTE rho, BYTE i)
+{
+    const SIndex* __restrict__ pLinks = __idx->m_pDeviceIndexLinkToSIndex[byFieldId];
+    const SSmallInt4 n_p_mu = _deviceSmallInt4OffsetC(sSite, __fwd(mu));
+    const SSmallInt4 n_p_nu = _deviceSmallInt4OffsetC(sSite, __fwd(nu));
+    const SSmallInt4 n_p_mu_m_rho = _deviceSmallInt4OffsetC(n_p_mu, __bck(rho));
+    const SSmallInt4 n_p_mu_p_rho = _deviceSmallInt4OffsetC(n_p_mu, __fwd(rho));
+    const SSmallInt4 n_p_mu_p_nu = _deviceSmallInt4OffsetC(n_p_mu, __fwd(nu));
+    const SSmallInt4 n_p_mu_m_rho_p_nu = _deviceSmallInt4OffsetC(n_p_mu_m_rho, __fwd(nu));
+    const UINT n_p_mu_m_rho_bi4 = __bi4(n_p_mu_m_rho);
+
+    const Real fPlus = - _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_p_mu_m_rho_p_nu) + rho], byFieldId)
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_p_mu_m_rho_bi4 + nu], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_p_mu_m_rho_bi4 + rho], byFieldId);
+    const Real fMinus = _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_p_mu_p_nu) + rho], byFieldId)
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_p_mu_p_rho) + nu], byFieldId)
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_p_mu) + rho], byFieldId);
+
+    //U_nu(n) U_mu(n+nu) S3
+    const Real fRest = _deviceGetU1AngleSIndex(pDeviceData, pLinks[uiBigIndex * _DC_Dir + nu], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_p_nu) + mu], byFieldId);
+
+    return _deviceHiShifted(byFieldId, sCenter, n_p_mu, n_p_mu_p_nu, i) * _deviceImDiffStapleU1Angle(fTheta, fPlus, fMinus, fRest);
+}
+
+/**
+* See _deviceStapleS4ShiftedU1, S4 = U(N+mu-rho-nu) U(N+mu-rho-nu) U(N+mu-rho) - U(N+mu-nu) U(N+mu+rho-nu) U(N+mu)
+*/
+static __device__ __inline__ Real _deviceStapleS4ShiftedU1Angle(
+    BYTE byFieldId,
+    const Real* __restrict__ pDeviceData,
+    const SSmallInt4& sCenter, const SSmallInt4& sSite, Real fTheta,
+    UINT uiBigIndex, BYTE mu, BYTE nu, BYTE rho, BYTE i)
+{
+    const SIndex* __restrict__ pLinks = __idx->m_pDeviceIndexLinkToSIndex[byFieldId];
+    const SSmallInt4 n_p_mu = _deviceSmallInt4OffsetC(sSite, __fwd(mu));
+    const SSmallInt4 n_m_nu = _deviceSmallInt4OffsetC(sSite, __bck(nu));
+    const SSmallInt4 n_p_mu_m_rho = _deviceSmallInt4OffsetC(n_p_mu, __bck(rho));
+    const SSmallInt4 n_p_mu_m_nu = _deviceSmallInt4OffsetC(n_p_mu, __bck(nu));
+    const SSmallInt4 n_p_mu_m_rho_m_nu = _deviceSmallInt4OffsetC(n_p_mu_m_nu, __bck(rho));
+    const SSmallInt4 n_p_mu_p_rho_m_nu = _deviceSmallInt4OffsetC(n_p_mu_m_nu, __fwd(rho));
+    const UINT n_m_nu_bi4 = __bi4(n_m_nu);
+    const UINT n_p_mu_m_rho_m_nu_bi4 = __bi4(n_p_mu_m_rho_m_nu);
+
+    const Real fPlus = - _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_p_mu_m_rho_m_nu_bi4 + rho], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_p_mu_m_rho_m_nu_bi4 + nu], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_p_mu_m_rho) + rho], byFieldId);
+    const Real fMinus = _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_p_mu_m_nu) + rho], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_p_mu_p_rho_m_nu) + nu], byFieldId)
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_p_mu) + rho], byFieldId);
+
+    //U^+_nu(n-nu) U_mu(n-nu) S4
+    const Real fRest = - _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_nu_bi4 + nu], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_nu_bi4 + mu], byFieldId);
+
+    return _deviceHiShifted(byFieldId, sCenter, n_p_mu, n_p_mu_m_nu, i) * _deviceImDiffStapleU1Angle(fTheta, fPlus, fMinus, fRest);
+}
+
+/**
+* See _deviceStapleT1ShiftedU1, T1 = U(N+mu-rho) U(N+mu-rho) U(N+mu-rho+nu) - U(N+mu) U(N+mu+rho) U(N+mu+nu)
+*/
+static __device__ __inline__ Real _deviceStapleT1ShiftedU1Angle(
+    BYTE byFieldId,
+    const Real* __restrict__ pDeviceData,
+    const SSmallInt4& sCenter, const SSmallInt4& sSite, Real fTheta,
+    UINT uiBigIndex, BYTE mu, BYTE nu, BYTE rho, BYTE i)
+{
+    const SIndex* __restrict__ pLinks = __idx->m_pDeviceIndexLinkToSIndex[byFieldId];
+    const SSmallInt4 n_p_mu = _deviceSmallInt4OffsetC(sSite, __fwd(mu));
+    const SSmallInt4 n_p_nu = _deviceSmallInt4OffsetC(sSite, __fwd(nu));
+    const SSmallInt4 n_p_mu_m_rho = _deviceSmallInt4OffsetC(n_p_mu, __bck(rho));
+    const SSmallInt4 n_p_mu_p_rho = _deviceSmallInt4OffsetC(n_p_mu, __fwd(rho));
+    const SSmallInt4 n_p_mu_p_nu = _deviceSmallInt4OffsetC(n_p_mu, __fwd(nu));
+    const SSmallInt4 n_p_mu_m_rho_p_nu = _deviceSmallInt4OffsetC(n_p_mu_m_rho, __fwd(nu));
+    const UINT n_p_mu_m_rho_bi4 = __bi4(n_p_mu_m_rho);
+
+    const Real fPlus = - _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_p_mu_m_rho_bi4 + rho], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_p_mu_m_rho_bi4 + nu], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_p_mu_m_rho_p_nu) + rho], byFieldId);
+    const Real fMinus = _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_p_mu) + rho], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_p_mu_p_rho) + nu], byFieldId)
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_p_mu_p_nu) + rho], byFieldId);
+
+    //U_mu(n) T1 U^+_mu(n+nu)
+    const Real fRest = _deviceGetU1AngleSIndex(pDeviceData, pLinks[uiBigIndex * _DC_Dir + mu], byFieldId)
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_p_nu) + mu], byFieldId);
+
+    return _deviceHiShifted(byFieldId, sCenter, n_p_mu, n_p_mu_p_nu, i) * _deviceImDiffStapleU1Angle(fTheta, fPlus, fMinus, fRest);
+}
+
+/**
+* See _deviceStapleT2ShiftedU1, T2 = U(N-mu) U(N-mu+rho) U(N-mu+nu) - U(N-mu-rho) U(N-mu-rho) U(N-mu-rho+nu)
+*/
+static __device__ __inline__ Real _deviceStapleT2ShiftedU1Angle(
+    BYTE byFieldId,
+    const Real* __restrict__ pDeviceData,
+    const SSmallInt4& sCenter, const SSmallInt4& sSite, Real fTheta,
+    UINT uiBigIndex, BYTE mu, BYTE nu, BYTE rho, BYTE i)
+{
+    const SIndex* __restrict__ pLinks = __idx->m_pDeviceIndexLinkToSIndex[byFieldId];
+    const SSmallInt4 n_m_mu = _deviceSmallInt4OffsetC(sSite, __bck(mu));
+    const SSmallInt4 n_m_mu_m_rho = _deviceSmallInt4OffsetC(n_m_mu, __bck(rho));
+    const SSmallInt4 n_m_mu_p_rho = _deviceSmallInt4OffsetC(n_m_mu, __fwd(rho));
+    const SSmallInt4 n_m_mu_p_nu = _deviceSmallInt4OffsetC(n_m_mu, __fwd(nu));
+    const SSmallInt4 n_m_mu_p_nu_m_rho = _deviceSmallInt4OffsetC(n_m_mu_m_rho, __fwd(nu));
+    const UINT n_m_mu_bi4 = __bi4(n_m_mu);
+    const UINT n_m_mu_p_nu_bi4 = __bi4(n_m_mu_p_nu);
+    const UINT n_m_mu_m_rho_bi4 = __bi4(n_m_mu_m_rho);
+
+    const Real fPlus = _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_mu_bi4 + rho], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_m_mu_p_rho) + nu], byFieldId)
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_mu_p_nu_bi4 + rho], byFieldId);
+    const Real fMinus = - _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_mu_m_rho_bi4 + rho], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_mu_m_rho_bi4 + nu], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[__bi4(n_m_mu_p_nu_m_rho) + rho], byFieldId);
+
+    //U^+_mu(n-mu) T2 U_mu(n-mu+nu)
+    const Real fRest = - _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_mu_bi4 + mu], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[n_m_mu_p_nu_bi4 + mu], byFieldId);
+
+    return _deviceHiShifted(byFieldId, sCenter, n_m_mu, n_m_mu_p_nu, i) * _deviceImDiffStapleU1Angle(fTheta, fPlus, fMinus, fRest);
+}
+
+static __device__ __inline__ Real _deviceStapleChairTerm1ShiftedU1Angle(
+    BYTE byFieldId,
+    const Real* __restrict__ pDeviceData,
+    const SSmallInt4& sCenter, const SSmallInt4& sSite, Real fTheta,
+    UINT uiBigIndex, BYTE mu, BYTE nu, BYTE rho, BYTE i)
+{
+    return _deviceStapleS1ShiftedU1Angle(byFieldId, pDeviceData, sCenter, sSite, fTheta, uiBigIndex, mu, nu, rho, i)
+         + _deviceStapleS2ShiftedU1Angle(byFieldId, pDeviceData, sCenter, sSite, fTheta, uiBigIndex, mu, nu, rho, i)
+         + _deviceStapleS3ShiftedU1Angle(byFieldId, pDeviceData, sCenter, sSite, fTheta, uiBigIndex, mu, nu, rho, i)
+         + _deviceStapleS4ShiftedU1Angle(byFieldId, pDeviceData, sCenter, sSite, fTheta, uiBigIndex, mu, nu, rho, i);
+}
+
+static __device__ __inline__ Real _deviceStapleChairTerm2ShiftedU1Angle(
+    BYTE byFieldId,
+    const Real* __restrict__ pDeviceData,
+    const SSmallInt4& sCenter, const SSmallInt4& sSite, Real fTheta,
+    UINT uiBigIndex, BYTE mu, BYTE nu, BYTE rho, BYTE i)
+{
+    return _deviceStapleT1ShiftedU1Angle(byFieldId, pDeviceData, sCenter, sSite, fTheta, uiBigIndex, mu, nu, rho, i)
+         + _deviceStapleT2ShiftedU1Angle(byFieldId, pDeviceData, sCenter, sSite, fTheta, uiBigIndex, mu, nu, rho, i)
+         + _deviceStapleT1ShiftedU1Angle(byFieldId, pDeviceData, sCenter, sSite, fTheta, uiBigIndex, rho, nu, mu, i)
+         + _deviceStapleT2ShiftedU1Angle(byFieldId, pDeviceData, sCenter, sSite, fTheta, uiBigIndex, rho, nu, mu, i);
+}
+
+#pragma endregion
+
 __END_NAMESPACE
 
 #endif //#ifndef _CACTIONGAUGEPLAQUETTE_ROTATINGU1_H_
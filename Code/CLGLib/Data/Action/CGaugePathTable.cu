@@ -0,0 +1,842 @@
+//=============================================================================
+// FILENAME : CGaugePathTable.cu
+//
+// DESCRIPTION:
+//
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#include "CLGLib_Private.h"
+
+__BEGIN_NAMESPACE
+
+#pragma region kernel
+
+/**
+ * The links of SU3, U1 (complex) and U1 angle, for the U1 angle the product is the sum of angles
+ */
+static __device__ __inline__ deviceSU3 _deviceGaugePathLink(const deviceSU3* __restrict__ pGauge, const SIndex& idx, BYTE byFieldId)
+{
+    return _deviceGetGaugeBCSU3DirSIndex(pGauge, idx, byFieldId);
+}
+
+static __device__ __inline__ CLGComplex _deviceGaugePathLink(const CLGComplex* __restrict__ pGauge, const SIndex& idx, BYTE byFieldId)
+{
+    return _deviceGetGaugeBCU1DirSIndex(pGauge, idx, byFieldId);
+}
+
+static __device__ __inline__ Real _deviceGaugePathLink(const Real* __restrict__ pGauge, const SIndex& idx, BYTE byFieldId)
+{
+    return _deviceGetU1AngleSIndex(pGauge, idx, byFieldId);
+}
+
+static __device__ __inline__ void _deviceGaugePathId(deviceSU3& u) { u = deviceSU3::makeSU3Id(); }
+static __device__ __inline__ void _deviceGaugePathId(CLGComplex& u) { u = _onec; }
+static __device__ __inline__ void _deviceGaugePathId(Real& u) { u = F(0.0); }
+
+static __device__ __inline__ void _deviceGaugePathDagger(deviceSU3& u) { u.Dagger(); }
+static __device__ __inline__ void _deviceGaugePathDagger(CLGComplex& u) { u = _cuConjf(u); }
+static __device__ __inline__ void _deviceGaugePathDagger(Real& u) { u = -u; }
+
+static __device__ __inline__ void _deviceGaugePathMul(deviceSU3& u, const deviceSU3& v) { u.Mul(v); }
+static __device__ __inline__ void _deviceGaugePathMul(CLGComplex& u, const CLGComplex& v) { u = _cuCmulf(u, v); }
+static __device__ __inline__ void _deviceGaugePathMul(Real& u, Real v) { u = u + v; }
+
+/**
+ * N - Retr[L]
+ */
+static __device__ __inline__ Real _deviceGaugePathAction(const deviceSU3& u) { return F(3.0) - u.ReTr(); }
+static __device__ __inline__ Real _deviceGaugePathAction(const CLGComplex& u) { return F(1.0) - u.x; }
+static __device__ __inline__ Real _deviceGaugePathAction(Real u) { return F(1.0) - _cos(_deviceWrapU1Angle(u)); }
+
+/**
+ * Ta[L] = i Im[L] for U1
+ */
+static __device__ __inline__ Real _deviceGaugePathImU1(const CLGComplex& u) { return u.y; }
+static __device__ __inline__ Real _deviceGaugePathImU1(Real u) { return _sin(_deviceWrapU1Angle(u)); }
+
+static __device__ __inline__ void _deviceGaugePathAddU1Force(CLGComplex& f, Real v) { f.y = f.y + v; }
+static __device__ __inline__ void _deviceGaugePathAddU1Force(Real& f, Real v) { f = f + v; }
+
+/**
+ * Get the link and move, the same as one step of _deviceLinkLong,
+ * and the site is mapped into the lattice after a +dir move, so f(n) is f of a site in the lattice
+ */
+template<typename deviceLink>
+static __device__ __inline__ deviceLink _deviceGaugePathStep(
+    const deviceLink* __restrict__ pGauge,
+    BYTE byFieldId,
+    SSmallInt4& sSite,
+    INT iDir)
+{
+    const BYTE byDir = iDir > 0 ? static_cast<BYTE>(iDir - 1) : static_cast<BYTE>(-iDir - 1);
+    if (iDir < 0)
+    {
+        _deviceSmallInt4Offset(sSite, iDir);
+    }
+    const SIndex& newLink = __idx->m_pDeviceIndexLinkToSIndex[byFieldId][__bi4(sSite) + byDir];
+    deviceLink ret = _deviceGaugePathLink(pGauge, newLink, byFieldId);
+    if (iDir < 0)
+    {
+        _deviceGaugePathDagger(ret);
+    }
+    if (!newLink.IsDirichlet())
+    {
+        sSite = __deviceSiteIndexToInt4(newLink.m_uiSiteIndex);
+    }
+    if (iDir > 0)
+    {
+        _deviceSmallInt4Offset(sSite, iDir);
+        const SIndex& newSite = __idx->m_pDeviceIndexPositionToSIndex[byFieldId][__bi(sSite)];
+        if (!newSite.IsDirichlet())
+        {
+            sSite = __deviceSiteIndexToInt4(newSite.m_uiSiteIndex);
+        }
+    }
+    return ret;
+}
+
+static __device__ __inline__ Real _deviceGaugePathF(
+    BYTE byFieldId,
+    BYTE byType,
+    const SSmallInt4& sSite,
+    const SSmallInt4& sCenter,
+    Real fShift,
+    const Real* __restrict__ pSlice)
+{
+    const Real fT = static_cast<Real>(sSite.w - sCenter.w);
+    switch (byType)
+    {
+    case EGPC_T:
+        return fT;
+    case EGPC_T2:
+        return fT * fT;
+    case EGPC_ZSlice:
+        //a Dirichlet site is not mapped
+        return (sSite.z >= 0 && sSite.z < static_cast<SCOORD>(_DC_Lz)) ? pSlice[sSite.z] : F(0.0);
+    default:
+        break;
+    }
+
+    //x, y of Dirichlet sites are 0, the same as _deviceFi
+    if (__idx->m_pDeviceIndexPositionToSIndex[byFieldId][__bi(sSite)].IsDirichlet())
+    {
+        return F(0.0);
+    }
+
+    const Real fX = static_cast<Real>(sSite.x - sCenter.x) + fShift;
+    const Real fY = static_cast<Real>(sSite.y - sCenter.y) + fShift;
+    switch (byType)
+    {
+    case EGPC_X:
+        return fX;
+    case EGPC_Y:
+        return fY;
+    case EGPC_XY:
+        return fX * fY;
+    case EGPC_X2:
+        return fX * fX;
+    case EGPC_Y2:
+        return fY * fY;
+    case EGPC_R2:
+        return fX * fX + fY * fY;
+    default:
+        break;
+    }
+    return F(1.0);
+}
+
+/**
+ * L(n) of the entry, and c f(n)
+ * prefix1, prefix2 are the products of the first 1 and 2 links of the entry before it (site1, site2 are the sites after them),
+ * they are updated for the next entry
+ */
+template<typename deviceLink>
+static __device__ __inline__ deviceLink _deviceGaugePathEntry(
+    const deviceLink* __restrict__ pGauge,
+    BYTE byFieldId,
+    const SGaugePathEntry& entry,
+    const SSmallInt4& sSite4,
+    deviceLink& prefix1,
+    SSmallInt4& site1,
+    deviceLink& prefix2,
+    SSmallInt4& site2,
+    const SSmallInt4& sCenter,
+    Real fShift,
+    const Real* __restrict__ pSlice,
+    Real& fCoefficient)
+{
+    const BYTE byShared = entry.m_byShared;
+    const BYTE byLength = entry.m_byLength;
+    const UBOOL bConstant = (EGPC_Constant == entry.m_byCoefficientType);
+    const UBOOL bAverage = !bConstant && (0 != entry.m_byAverage);
+
+    deviceLink res = (byShared > 1) ? prefix2 : prefix1;
+    SSmallInt4 sSite = (byShared > 1) ? site2 : ((byShared > 0) ? site1 : sSite4);
+    SSmallInt4 sRoot = sSite4;
+    if (1 == entry.m_byRootIndex && byShared > 0)
+    {
+        sRoot = site1;
+    }
+    else if (2 == entry.m_byRootIndex && byShared > 1)
+    {
+        sRoot = site2;
+    }
+
+    Real fSum = F(0.0);
+    if (bAverage)
+    {
+        fSum = _deviceGaugePathF(byFieldId, entry.m_byCoefficientType, sSite4, sCenter, fShift, pSlice);
+        if (byShared > 0 && byLength > 1)
+        {
+            fSum += _deviceGaugePathF(byFieldId, entry.m_byCoefficientType, site1, sCenter, fShift, pSlice);
+        }
+        if (byShared > 1 && byLength > 2)
+        {
+            fSum += _deviceGaugePathF(byFieldId, entry.m_byCoefficientType, site2, sCenter, fShift, pSlice);
+        }
+    }
+
+    for (BYTE i = byShared; i < byLength; ++i)
+    {
+        const deviceLink link = _deviceGaugePathStep(pGauge, byFieldId, sSite, entry.m_iPath[i]);
+        if (0 == i)
+        {
+            res = link;
+            prefix1 = res;
+            site1 = sSite;
+        }
+        else
+        {
+            _deviceGaugePathMul(res, link);
+            if (1 == i)
+            {
+                prefix2 = res;
+                site2 = sSite;
+            }
+        }
+
+        //we are at the (i+1)-th site of the path
+        if (i + 1 < byLength)
+        {
+            if (i + 1 == entry.m_byRootIndex)
+            {
+                sRoot = sSite;
+            }
+            if (bAverage)
+            {
+                fSum += _deviceGaugePathF(byFieldId, entry.m_byCoefficientType, sSite, sCenter, fShift, pSlice);
+            }
+        }
+    }
+
+    if (bConstant)
+    {
+        fCoefficient = entry.m_fCoefficient;
+    }
+    else if (bAverage)
+    {
+        fCoefficient = entry.m_fCoefficient * fSum / byLength;
+    }
+    else
+    {
+        fCoefficient = entry.m_fCoefficient * _deviceGaugePathF(byFieldId, entry.m_byCoefficientType, sRoot, sCenter, fShift, pSlice);
+    }
+    return res;
+}
+
+/**
+ * The loops starting at a Dirichlet site are not skipped,
+ * they can contain links in the lattice, and they are in the force
+ */
+template<typename deviceLink>
+__global__ void _CLG_LAUNCH_BOUND
+_kernelGaugePathTableEnergy(
+    BYTE byFieldId,
+    const deviceLink* __restrict__ pGauge,
+    const SGaugePathEntry* __restrict__ pTable,
+    UINT uiCount,
+    SSmallInt4 sCenter,
+    Real fShift,
+    const Real* __restrict__ pSlice,
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE betaOverN,
+    DOUBLE* results
+#else
+    Real betaOverN,
+    Real* results
+#endif
+)
+{
+    intokernalInt4;
+
+    deviceLink prefix1;
+    deviceLink prefix2;
+    _deviceGaugePathId(prefix1);
+    _deviceGaugePathId(prefix2);
+    SSmallInt4 site1 = sSite4;
+    SSmallInt4 site2 = sSite4;
+
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE res = 0.0;
+#else
+    Real res = F(0.0);
+#endif
+    for (UINT i = 0; i < uiCount; ++i)
+    {
+        Real fCoefficient = F(0.0);
+        const deviceLink loop = _deviceGaugePathEntry(pGauge, byFieldId, pTable[i], sSite4, 
+            prefix1, site1, prefix2, site2, sCenter, fShift, pSlice, fCoefficient);
+#if !_CLG_DOUBLEFLOAT
+        res += static_cast<DOUBLE>(fCoefficient * _deviceGaugePathAction(loop));
+#else
+        res += fCoefficient * _deviceGaugePathAction(loop);
+#endif
+    }
+
+    results[uiSiteIndex] = res * betaOverN;
+}
+
+/**
+ * The entries are sorted by the first link, which is always +mu
+ */
+__global__ void _CLG_LAUNCH_BOUND
+_kernelGaugePathTableForce(
+    BYTE byFieldId,
+    const deviceSU3* __restrict__ pGauge,
+    deviceSU3* pForce,
+    const SGaugePathEntry* __restrict__ pTable,
+    UINT uiCount,
+    SSmallInt4 sCenter,
+    Real fShift,
+    const Real* __restrict__ pSlice,
+    Real fMinusHalfBetaOverN)
+{
+    intokernalInt4;
+
+    deviceSU3 prefix1 = deviceSU3::makeSU3Id();
+    deviceSU3 prefix2 = deviceSU3::makeSU3Id();
+    SSmallInt4 site1 = sSite4;
+    SSmallInt4 site2 = sSite4;
+    deviceSU3 res = deviceSU3::makeSU3Zero();
+
+    for (UINT i = 0; i < uiCount; ++i)
+    {
+        const BYTE byDir = static_cast<BYTE>(pTable[i].m_iPath[0] - 1);
+        Real fCoefficient = F(0.0);
+        deviceSU3 toAdd = _deviceGaugePathEntry<deviceSU3>(pGauge, byFieldId, pTable[i], sSite4,
+            prefix1, site1, prefix2, site2, sCenter, fShift, pSlice, fCoefficient);
+        toAdd.MulReal(fCoefficient);
+        res.Add(toAdd);
+
+        if (i + 1 == uiCount || pTable[i + 1].m_iPath[0] != pTable[i].m_iPath[0])
+        {
+            if (!__idx->m_pDeviceIndexLinkToSIndex[byFieldId][__bi4(sSite4) + byDir].IsDirichlet())
+            {
+                res.Ta();
+                res.MulReal(fMinusHalfBetaOverN);
+                pForce[_deviceGetLinkIndex(uiSiteIndex, byDir)].Add(res);
+            }
+            res = deviceSU3::makeSU3Zero();
+        }
+    }
+}
+
+/**
+ * Same as _kernelGaugePathTableForce, Ta[L] = i Im[L],
+ * the force of CFieldGaugeU1 is i F, and the force of CFieldGaugeU1Angle is F
+ */
+template<typename deviceLink>
+__global__ void _CLG_LAUNCH_BOUND
+_kernelGaugePathTableForceU1(
+    BYTE byFieldId,
+    const deviceLink* __restrict__ pGauge,
+    deviceLink* pForce,
+    const SGaugePathEntry* __restrict__ pTable,
+    UINT uiCount,
+    SSmallInt4 sCenter,
+    Real fShift,
+    const Real* __restrict__ pSlice,
+    Real fMinusHalfBetaOverN)
+{
+    intokernalInt4;
+
+    deviceLink prefix1;
+    deviceLink prefix2;
+    _deviceGaugePathId(prefix1);
+    _deviceGaugePathId(prefix2);
+    SSmallInt4 site1 = sSite4;
+    SSmallInt4 site2 = sSite4;
+    Real res = F(0.0);
+
+    for (UINT i = 0; i < uiCount; ++i)
+    {
+        const BYTE byDir = static_cast<BYTE>(pTable[i].m_iPath[0] - 1);
+        Real fCoefficient = F(0.0);
+        const deviceLink loop = _deviceGaugePathEntry(pGauge, byFieldId, pTable[i], sSite4,
+            prefix1, site1, prefix2, site2, sCenter, fShift, pSlice, fCoefficient);
+        res += fCoefficient * _deviceGaugePathImU1(loop);
+
+        if (i + 1 == uiCount || pTable[i + 1].m_iPath[0] != pTable[i].m_iPath[0])
+        {
+            if (!__idx->m_pDeviceIndexLinkToSIndex[byFieldId][__bi4(sSite4) + byDir].IsDirichlet())
+            {
+                _deviceGaugePathAddU1Force(pForce[_deviceGetLinkIndex(uiSiteIndex, byDir)], res * fMinusHalfBetaOverN);
+            }
+            res = F(0.0);
+        }
+    }
+}
+
+#pragma endregion
+
+CGaugePathTable::CGaugePathTable()
+    : m_pDeviceEnergyTable(NULL)
+    , m_pDeviceForceTable(NULL)
+    , m_pDeviceSliceCoefficient(NULL)
+    , m_uiEnergyCount(0)
+    , m_uiForceCount(0)
+{
+
+}
+
+CGaugePathTable::~CGaugePathTable()
+{
+    if (NULL != m_pDeviceEnergyTable)
+    {
+        checkCudaErrors(cudaFree(m_pDeviceEnergyTable));
+    }
+    if (NULL != m_pDeviceForceTable)
+    {
+        checkCudaErrors(cudaFree(m_pDeviceForceTable));
+    }
+    if (NULL != m_pDeviceSliceCoefficient)
+    {
+        checkCudaErrors(cudaFree(m_pDeviceSliceCoefficient));
+    }
+}
+
+void CGaugePathTable::AddLoop(const TArray<INT>& path, Real fCoefficient, EGaugePathCoefficient eType, UBOOL bAverage)
+{
+    if (path.Num() < 1 || path.Num() > SGaugePathEntry::_kMaxLength)
+    {
+        appCrucial(_T("CGaugePathTable: path length should be 1 to %d\n"), SGaugePathEntry::_kMaxLength);
+        return;
+    }
+
+    INT iOffset[4] = { 0, 0, 0, 0 };
+    SGaugePathEntry entry;
+    memset(&entry, 0, sizeof(SGaugePathEntry));
+    for (INT i = 0; i < path.Num(); ++i)
+    {
+        if (0 == path[i] || path[i] > _HC_Diri || path[i] < -_HC_Diri)
+        {
+            appCrucial(_T("CGaugePathTable: wrong direction %d\n"), path[i]);
+            return;
+        }
+        iOffset[(path[i] > 0 ? path[i] : -path[i]) - 1] += (path[i] > 0 ? 1 : -1);
+        entry.m_iPath[i] = path[i];
+    }
+    if (0 != iOffset[0] || 0 != iOffset[1] || 0 != iOffset[2] || 0 != iOffset[3])
+    {
+        appCrucial(_T("CGaugePathTable: the path is not closed\n"));
+        return;
+    }
+
+    entry.m_byLength = static_cast<BYTE>(path.Num());
+    entry.m_fCoefficient = fCoefficient;
+    entry.m_byCoefficientType = static_cast<BYTE>(eType);
+    entry.m_byAverage = bAverage ? 1 : 0;
+    m_lstLoops.AddItem(entry);
+}
+
+/**
+ * The smallest one of all start and both orientations
+ */
+TArray<INT> CGaugePathTable::Canonical(const TArray<INT>& path)
+{
+    const INT iLength = path.Num();
+    TArray<INT> ret = path;
+    for (INT iOrientation = 0; iOrientation < 2; ++iOrientation)
+    {
+        for (INT iStart = 0; iStart < iLength; ++iStart)
+        {
+            TArray<INT> candidate;
+            for (INT i = 0; i < iLength; ++i)
+            {
+                candidate.AddItem(0 == iOrientation
+                    ? path[(iStart + i) % iLength]
+                    : -path[(iStart + iLength - i) % iLength]);
+            }
+            for (INT i = 0; i < iLength; ++i)
+            {
+                if (candidate[i] != ret[i])
+                {
+                    if (candidate[i] < ret[i])
+                    {
+                        ret = candidate;
+                    }
+                    break;
+                }
+            }
+        }
+    }
+    return ret;
+}
+
+void CGaugePathTable::AddSymmetricLoops(const TArray<INT>& path, Real fCoefficient, EGaugePathCoefficient eType, UBOOL bAverage)
+{
+    const INT iDir = static_cast<INT>(_HC_Diri);
+    INT permutation[4] = { 0, 1, 2, 3 };
+    TArray<TArray<INT>> added;
+    do
+    {
+        for (INT iReflection = 0; iReflection < (1 << iDir); ++iReflection)
+        {
+            TArray<INT> image;
+            for (INT i = 0; i < path.Num(); ++i)
+            {
+                const INT iAbs = (path[i] > 0 ? path[i] : -path[i]) - 1;
+                const INT iNew = permutation[iAbs] + 1;
+                const INT iSign = ((iReflection >> permutation[iAbs]) & 1) ? -1 : 1;
+                image.AddItem(path[i] > 0 ? (iSign * iNew) : (-iSign * iNew));
+            }
+
+            const TArray<INT> canonical = Canonical(image);
+            UBOOL bFound = FALSE;
+            for (INT j = 0; j < added.Num() && !bFound; ++j)
+            {
+                if (added[j].Num() == canonical.Num())
+                {
+                    bFound = TRUE;
+                    for (INT k = 0; k < canonical.Num(); ++k)
+                    {
+                        if (added[j][k] != canonical[k])
+                        {
+                            bFound = FALSE;
+                            break;
+                        }
+                    }
+                }
+            }
+            if (!bFound)
+            {
+                added.AddItem(canonical);
+                AddLoop(image, fCoefficient, eType, bAverage);
+            }
+        }
+    } while (std::next_permutation(permutation, permutation + iDir));
+}
+
+/**
+ * left(n) = (A - B)(C - D), right(n) = (A' - B')(C' - D'), see _deviceChairTerm
+ * A = [mu, nu, -mu], B = [-mu, nu, mu], C = [rho, -nu, -rho], D = [-rho, -nu, rho]
+ * A' = [mu, -nu, -mu], B' = [-mu, -nu, mu], C' = [rho, nu, -rho], D' = [-rho, nu, rho]
+ * c f (N - Retr[L]) is added, the sum of signs is 0, so -c for +L
+ */
+void CGaugePathTable::AddChairLoops(BYTE byMu, BYTE byNu, BYTE byRho, Real fCoefficient, EGaugePathCoefficient eType)
+{
+    const INT m = byMu + 1;
+    const INT n = byNu + 1;
+    const INT r = byRho + 1;
+    const INT loops[8][6] = {
+        { m,  n, -m,  r, -n, -r },
+        { m,  n, -m, -r, -n,  r },
+        {-m,  n,  m,  r, -n, -r },
+        {-m,  n,  m, -r, -n,  r },
+        { m, -n, -m,  r,  n, -r },
+        { m, -n, -m, -r,  n,  r },
+        {-m, -n,  m,  r,  n, -r },
+        {-m, -n,  m, -r,  n,  r },
+    };
+    const Real signs[8] = { F(1.0), F(-1.0), F(-1.0), F(1.0), F(1.0), F(-1.0), F(-1.0), F(1.0) };
+    for (INT i = 0; i < 8; ++i)
+    {
+        TArray<INT> path;
+        for (INT j = 0; j < 6; ++j)
+        {
+            path.AddItem(loops[i][j]);
+        }
+        AddLoop(path, -signs[i] * fCoefficient, eType, FALSE);
+    }
+}
+
+void CGaugePathTable::SetSliceCoefficient(const TArray<Real>& coefficients)
+{
+    if (coefficients.Num() < _HC_Lzi)
+    {
+        appCrucial(_T("CGaugePathTable: slice coefficients should have %d values\n"), _HC_Lzi);
+        return;
+    }
+    if (NULL == m_pDeviceSliceCoefficient)
+    {
+        checkCudaErrors(cudaMalloc((void**)&m_pDeviceSliceCoefficient, sizeof(Real) * _HC_Lz));
+    }
+    checkCudaErrors(cudaMemcpy(m_pDeviceSliceCoefficient, coefficients.GetData(), sizeof(Real) * _HC_Lz, cudaMemcpyHostToDevice));
+}
+
+static bool _GaugePathEntryLess(const SGaugePathEntry& a, const SGaugePathEntry& b)
+{
+    const BYTE byLength = a.m_byLength < b.m_byLength ? a.m_byLength : b.m_byLength;
+    for (BYTE i = 0; i < byLength; ++i)
+    {
+        if (a.m_iPath[i] != b.m_iPath[i])
+        {
+            return a.m_iPath[i] < b.m_iPath[i];
+        }
+    }
+    return a.m_byLength < b.m_byLength;
+}
+
+void CGaugePathTable::SortAndShare(TArray<SGaugePathEntry>& entries)
+{
+    std::stable_sort(entries.GetData(), entries.GetData() + entries.Num(), _GaugePathEntryLess);
+    for (INT i = 0; i < entries.Num(); ++i)
+    {
+        BYTE byShared = 0;
+        if (i > 0)
+        {
+            const SGaugePathEntry& last = entries[i - 1];
+            while (byShared < entries[i].m_byLength && byShared < last.m_byLength
+                && entries[i].m_iPath[byShared] == last.m_iPath[byShared])
+            {
+                ++byShared;
+            }
+        }
+        if (byShared > SGaugePathEntry::_kMaxShared)
+        {
+            byShared = SGaugePathEntry::_kMaxShared;
+        }
+        entries[i].m_byShared = byShared;
+    }
+}
+
+SGaugePathEntry* CGaugePathTable::Upload(const TArray<SGaugePathEntry>& entries)
+{
+    if (0 == entries.Num())
+    {
+        return NULL;
+    }
+    SGaugePathEntry* pDevice = NULL;
+    checkCudaErrors(cudaMalloc((void**)&pDevice, sizeof(SGaugePathEntry) * entries.Num()));
+    checkCudaErrors(cudaMemcpy(pDevice, entries.GetData(), sizeof(SGaugePathEntry) * entries.Num(), cudaMemcpyHostToDevice));
+    return pDevice;
+}
+
+void CGaugePathTable::Compile()
+{
+    TArray<SGaugePathEntry> energy;
+    TArray<SGaugePathEntry> force;
+    for (INT i = 0; i < m_lstLoops.Num(); ++i)
+    {
+        const SGaugePathEntry& loop = m_lstLoops[i];
+        const BYTE byLength = loop.m_byLength;
+        energy.AddItem(loop);
+
+        //every link of the loop, rotate (and reverse) the loop to start with +mu
+        for (BYTE k = 0; k < byLength; ++k)
+        {
+            SGaugePathEntry rotated = loop;
+            if (loop.m_iPath[k] > 0)
+            {
+                for (BYTE i2 = 0; i2 < byLength; ++i2)
+                {
+                    rotated.m_iPath[i2] = loop.m_iPath[(k + i2) % byLength];
+                }
+                rotated.m_byRootIndex = static_cast<BYTE>((byLength - k) % byLength);
+            }
+            else
+            {
+                //the reversed loop r[i] = -p[L-1-i] start at the same site, and link k is r[L-1-k] = +mu
+                const BYTE byStart = static_cast<BYTE>(byLength - 1 - k);
+                for (BYTE i2 = 0; i2 < byLength; ++i2)
+                {
+                    rotated.m_iPath[i2] = -loop.m_iPath[(2 * byLength - 1 - byStart - i2) % byLength];
+                }
+                rotated.m_byRootIndex = static_cast<BYTE>((byLength - byStart) % byLength);
+            }
+            force.AddItem(rotated);
+        }
+    }
+
+    SortAndShare(energy);
+    SortAndShare(force);
+
+    if (NULL != m_pDeviceEnergyTable)
+    {
+        checkCudaErrors(cudaFree(m_pDeviceEnergyTable));
+    }
+    if (NULL != m_pDeviceForceTable)
+    {
+        checkCudaErrors(cudaFree(m_pDeviceForceTable));
+    }
+    m_pDeviceEnergyTable = Upload(energy);
+    m_pDeviceForceTable = Upload(force);
+    m_uiEnergyCount = static_cast<UINT>(energy.Num());
+    m_uiForceCount = static_cast<UINT>(force.Num());
+}
+
+#if !_CLG_DOUBLEFLOAT
+DOUBLE CGaugePathTable::Energy(const CFieldGaugeSU3* pGauge, DOUBLE fBetaOverN, const SSmallInt4& sCenter, Real fShift) const
+#else
+Real CGaugePathTable::Energy(const CFieldGaugeSU3* pGauge, Real fBetaOverN, const SSmallInt4& sCenter, Real fShift) const
+#endif
+{
+    if (0 == m_uiEnergyCount)
+    {
+        return F(0.0);
+    }
+
+    preparethread;
+    _kernelGaugePathTableEnergy<deviceSU3> << <block, threads >> > (
+        pGauge->m_byFieldId,
+        pGauge->m_pDeviceData,
+        m_pDeviceEnergyTable,
+        m_uiEnergyCount,
+        sCenter,
+        fShift,
+        m_pDeviceSliceCoefficient,
+        fBetaOverN,
+        _D_RealThreadBuffer);
+
+    return appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
+}
+
+void CGaugePathTable::Force(const CFieldGaugeSU3* pGauge, CFieldGaugeSU3* pForce, Real fBetaOverN, const SSmallInt4& sCenter, Real fShift) const
+{
+    if (0 == m_uiForceCount)
+    {
+        return;
+    }
+
+    preparethread;
+    _kernelGaugePathTableForce << <block, threads >> > (
+        pGauge->m_byFieldId,
+        pGauge->m_pDeviceData,
+        pForce->m_pDeviceData,
+        m_pDeviceForceTable,
+        m_uiForceCount,
+        sCenter,
+        fShift,
+        m_pDeviceSliceCoefficient,
+        fBetaOverN * F(-0.5));
+}
+
+#if !_CLG_DOUBLEFLOAT
+DOUBLE CGaugePathTable::Energy(const CFieldGaugeU1* pGauge, DOUBLE fBetaOverN, const SSmallInt4& sCenter, Real fShift) const
+#else
+Real CGaugePathTable::Energy(const CFieldGaugeU1* pGauge, Real fBetaOverN, const SSmallInt4& sCenter, Real fShift) const
+#endif
+{
+    if (0 == m_uiEnergyCount)
+    {
+        return F(0.0);
+    }
+
+    preparethread;
+    _kernelGaugePathTableEnergy<CLGComplex> << <block, threads >> > (
+        pGauge->m_byFieldId,
+        pGauge->m_pDeviceData,
+        m_pDeviceEnergyTable,
+        m_uiEnergyCount,
+        sCenter,
+        fShift,
+        m_pDeviceSliceCoefficient,
+        fBetaOverN,
+        _D_RealThreadBuffer);
+
+    return appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
+}
+
+#if !_CLG_DOUBLEFLOAT
+DOUBLE CGaugePathTable::Energy(const CFieldGaugeU1Angle* pGauge, DOUBLE fBetaOverN, const SSmallInt4& sCenter, Real fShift) const
+#else
+Real CGaugePathTable::Energy(const CFieldGaugeU1Angle* pGauge, Real fBetaOverN, const SSmallInt4& sCenter, Real fShift) const
+#endif
+{
+    if (0 == m_uiEnergyCount)
+    {
+        return F(0.0);
+    }
+
+    preparethread;
+    _kernelGaugePathTableEnergy<Real> << <block, threads >> > (
+        pGauge->m_byFieldId,
+        pGauge->m_pDeviceData,
+        m_pDeviceEnergyTable,
+        m_uiEnergyCount,
+        sCenter,
+        fShift,
+        m_pDeviceSliceCoefficient,
+        fBetaOverN,
+        _D_RealThreadBuffer);
+
+    return appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
+}
+
+void CGaugePathTable::Force(const CFieldGaugeU1* pGauge, CFieldGaugeU1* pForce, Real fBetaOverN, const SSmallInt4& sCenter, Real fShift) const
+{
+    if (0 == m_uiForceCount)
+    {
+        return;
+    }
+
+    preparethread;
+    _kernelGaugePathTableForceU1<CLGComplex> << <block, threads >> > (
+        pGauge->m_byFieldId,
+        pGauge->m_pDeviceData,
+        pForce->m_pDeviceData,
+        m_pDeviceForceTable,
+        m_uiForceCount,
+        sCenter,
+        fShift,
+        m_pDeviceSliceCoefficient,
+        fBetaOverN * F(-0.5));
+}
+
+void CGaugePathTable::Force(const CFieldGaugeU1Angle* pGauge, CFieldGaugeU1Angle* pForce, Real fBetaOverN, const SSmallInt4& sCenter, Real fShift) const
+{
+    if (0 == m_uiForceCount)
+    {
+        return;
+    }
+
+    preparethread;
+    _kernelGaugePathTableForceU1<Real> << <block, threads >> > (
+        pGauge->m_byFieldId,
+        pGauge->m_pDeviceData,
+        pForce->m_pDeviceData,
+        m_pDeviceForceTable,
+        m_uiForceCount,
+        sCenter,
+        fShift,
+        m_pDeviceSliceCoefficient,
+        fBetaOverN * F(-0.5));
+    pForce->IncreaseVersion();
+}
+
+CCString CGaugePathTable::GetInfos(const CCString& tab) const
+{
+    CCString sRet;
+    for (INT i = 0; i < m_lstLoops.Num(); ++i)
+    {
+        CCString sPath;
+        for (BYTE j = 0; j < m_lstLoops[i].m_byLength; ++j)
+        {
+            sPath = sPath + appIntToString(m_lstLoops[i].m_iPath[j]) + (j + 1 == m_lstLoops[i].m_byLength ? _T("") : _T(", "));
+        }
+        sRet = sRet + tab + _T("Path : [") + sPath + _T("] ")
+            + appFloatToString(m_lstLoops[i].m_fCoefficient) + _T(" ")
+            + __ENUM_TO_STRING(EGaugePathCoefficient, static_cast<EGaugePathCoefficient>(m_lstLoops[i].m_byCoefficientType))
+            + (m_lstLoops[i].m_byAverage ? _T(" (average)\n") : _T("\n"));
+    }
+    return sRet;
+}
+
+__END_NAMESPACE
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
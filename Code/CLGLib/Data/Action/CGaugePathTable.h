@@ -0,0 +1,156 @@
+//=============================================================================
+// FILENAME : CGaugePathTable.h
+//
+// DESCRIPTION:
+// A table of closed paths with coefficients depending on position,
+// S = beta/N sum _n sum _p c_p f_p(n) (N - Retr[L_p(n)])
+//
+// The paths are compiled into two tables:
+//  energy table: L_p start at n
+//  force table: every link of every path, rotated to start with U(n,mu)
+// Both are sorted, and the product of the shared beginning (at most 2 links) of neighbouring
+// paths is reused, so each term class is evaluated by one kernel.
+//
+// Paths longer than the cache edge are fine for torus, the site is mapped
+// into the lattice after every move (same as _deviceLinkLong), so do NOT use
+// it with projective plane.
+// f(n) is evaluated at the mapped site, and f(n) of x, y is 0 on Dirichlet sites (as _deviceFi).
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#ifndef _CGAUGEPATHTABLE_H_
+#define _CGAUGEPATHTABLE_H_
+
+__BEGIN_NAMESPACE
+
+__DEFINE_ENUM(EGaugePathCoefficient,
+
+    EGPC_Constant,
+    EGPC_X,
+    EGPC_Y,
+    EGPC_XY,
+    EGPC_X2,
+    EGPC_Y2,
+    EGPC_R2,
+    EGPC_T,
+    EGPC_T2,
+    EGPC_ZSlice,
+
+    EGPC_ForceDWORD = 0x7fffffff,
+    )
+
+struct SGaugePathEntry
+{
+    enum 
+    { 
+        _kMaxLength = 8,
+
+        //only the products of the first 1 and 2 links are kept for the next entry,
+        //they are in registers, a runtime indexed array of deviceSU3 will be put in local memory
+        _kMaxShared = 2,
+    };
+
+    INT m_iPath[_kMaxLength];
+    Real m_fCoefficient;
+    BYTE m_byLength;
+
+    //the first m_byShared (at most _kMaxShared) links are the same as the entry before it
+    BYTE m_byShared;
+
+    //f(n) is f of the m_byRootIndex-th site of the path
+    BYTE m_byRootIndex;
+    BYTE m_byCoefficientType;
+
+    //f(n) is the average of f on all sites of the path
+    BYTE m_byAverage;
+};
+
+class CLGAPI CGaugePathTable
+{
+public:
+
+    CGaugePathTable();
+    ~CGaugePathTable();
+
+    /**
+    * path is a closed path, with x,y,z,t : 1,2,3,4 and -x,-y,-z,-t: -1,-2,-3,-4
+    * f(n) is evaluated at the start of the path, or averaged on all sites of the path if bAverage
+    */
+    void AddLoop(const TArray<INT>& path, Real fCoefficient, EGaugePathCoefficient eType = EGPC_Constant, UBOOL bAverage = FALSE);
+
+    /**
+    * Add all images of the path under permutation and reflection of the _HC_Dir directions.
+    * The same loop (up to translation, start and orientation) is added once,
+    * for example, [1, 2, -1, -2] is all plaquttes
+    */
+    void AddSymmetricLoops(const TArray<INT>& path, Real fCoefficient, EGaugePathCoefficient eType = EGPC_Constant, UBOOL bAverage = FALSE);
+
+    /**
+    * c f(n) (U_{mu,nu}(n) - U_{-mu,nu}(n) - U_{mu,-nu}(n) + U_{-mu,-nu}(n)) (...)_{rho,nu}, the chair term of _deviceChairTerm,
+    * S = beta/N sum _n c f(n) Retr[chair(n)], it is 8 loops of length 6 with coefficients +-c
+    * mu, nu, rho are 0, 1, 2, 3
+    */
+    void AddChairLoops(BYTE byMu, BYTE byNu, BYTE byRho, Real fCoefficient, EGaugePathCoefficient eType = EGPC_Constant);
+
+    /**
+    * f(n) for EGPC_ZSlice, one value for each z
+    */
+    void SetSliceCoefficient(const TArray<Real>& coefficients);
+
+    /**
+    * Build the tables and copy them to device, call it after adding loops
+    */
+    void Compile();
+
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE Energy(const class CFieldGaugeSU3* pGauge, DOUBLE fBetaOverN, const SSmallInt4& sCenter, Real fShift) const;
+#else
+    Real Energy(const class CFieldGaugeSU3* pGauge, Real fBetaOverN, const SSmallInt4& sCenter, Real fShift) const;
+#endif
+
+    /**
+    * force = force - beta/2N sum c_p f_p Ta(L_p(n,mu))
+    */
+    void Force(const class CFieldGaugeSU3* pGauge, class CFieldGaugeSU3* pForce, Real fBetaOverN, const SSmallInt4& sCenter, Real fShift) const;
+
+    /**
+    * The same for U1, N - Retr[L] is 1 - cos(theta_L) and Ta(L) is i sin(theta_L),
+    * the U1 angle field is summed in angles
+    */
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE Energy(const class CFieldGaugeU1* pGauge, DOUBLE fBetaOverN, const SSmallInt4& sCenter, Real fShift) const;
+    DOUBLE Energy(const class CFieldGaugeU1Angle* pGauge, DOUBLE fBetaOverN, const SSmallInt4& sCenter, Real fShift) const;
+#else
+    Real Energy(const class CFieldGaugeU1* pGauge, Real fBetaOverN, const SSmallInt4& sCenter, Real fShift) const;
+    Real Energy(const class CFieldGaugeU1Angle* pGauge, Real fBetaOverN, const SSmallInt4& sCenter, Real fShift) const;
+#endif
+    void Force(const class CFieldGaugeU1* pGauge, class CFieldGaugeU1* pForce, Real fBetaOverN, const SSmallInt4& sCenter, Real fShift) const;
+    void Force(const class CFieldGaugeU1Angle* pGauge, class CFieldGaugeU1Angle* pForce, Real fBetaOverN, const SSmallInt4& sCenter, Real fShift) const;
+
+    UINT GetLoopCount() const { return static_cast<UINT>(m_lstLoops.Num()); }
+    CCString GetInfos(const CCString& tab) const;
+
+protected:
+
+    static TArray<INT> Canonical(const TArray<INT>& path);
+    static void SortAndShare(TArray<SGaugePathEntry>& entries);
+    static SGaugePathEntry* Upload(const TArray<SGaugePathEntry>& entries);
+
+    TArray<SGaugePathEntry> m_lstLoops;
+
+    SGaugePathEntry* m_pDeviceEnergyTable;
+    SGaugePathEntry* m_pDeviceForceTable;
+    Real* m_pDeviceSliceCoefficient;
+    UINT m_uiEnergyCount;
+    UINT m_uiForceCount;
+};
+
+__END_NAMESPACE
+
+#endif //#ifndef _CGAUGEPATHTABLE_H_
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
@@ -59,6 +59,14 @@ public:
 
     virtual UBOOL NeedToFixBoundary() const { return FALSE; }
 
+    /**
+    * TRUE if the neighbour of every site is just (x+mu) mod L, with sign m_FieldBC when crossing the boundary.
+    * In that case, the kernels can compute the neighbours without the baked tables.
+    */
+    virtual UBOOL IsPeriodic() const { return FALSE; }
+
+    const SSmallInt4& GetFieldBC(BYTE byFieldId) const { return m_FieldBC[byFieldId]; }
+
 protected:
 
     /**
@@ -30,6 +30,8 @@ public:
     void BakeBondInfo(const SSmallInt4* deviceMappingTable, BYTE* deviceTable) const override;
 
     void BakeBondGlue(BYTE byFieldId, const SSmallInt4* deviceMappingTable, SIndex* deviceTable) const override;
+
+    UBOOL IsPeriodic() const override { return TRUE; }
 };
 
 __END_NAMESPACE
@@ -81,7 +81,7 @@
 #define _HC_LinkCount (appGetCudaHelper()->m_ConstIntegers[ECI_LinkCount])
 #define _HC_ThreadConstraint (appGetCudaHelper()->m_ConstIntegers[ECI_ThreadConstaint])
 #define _HC_ThreadConstraintX (appGetCudaHelper()->m_ConstIntegers[ECI_ThreadConstaintX])
-#define _HC_ThreadConstraintY (appGetCudaHelper()->m_ConstIntegers[ECI_ThreadConstaintY)
+#define _HC_ThreadConstraintY (appGetCudaHelper()->m_ConstIntegers[ECI_ThreadConstaintY])
 #define _HC_ThreadConstraintZ (appGetCudaHelper()->m_ConstIntegers[ECI_ThreadConstaintZ])
 #define _HC_SummationDecompose (appGetCudaHelper()->m_ConstIntegers[ECI_SummationDecompose])
 
@@ -90,6 +90,10 @@
 #define _DC_ExpPrecision (_constIntegers[ECI_ExponentPrecision])
 #define _HC_ExpPrecision (appGetCudaHelper()->m_ConstIntegers[ECI_ExponentPrecision])
 
+//the global x of local x = 0, it is 0 unless the lattice is a slab of CDomainDecomposition
+#define _DC_XOrigin (static_cast<INT>(_constIntegers[ECI_XOrigin]))
+#define _HC_XOrigin (static_cast<INT>(appGetCudaHelper()->m_ConstIntegers[ECI_XOrigin]))
+
 #define _DC_ActionListL (_constIntegers[ECI_ActionListLength])
 #define _HC_ActionListL (appGetCudaHelper()->m_ConstIntegers[ECI_ActionListLength])
 
@@ -124,6 +128,7 @@ __DEFINE_ENUM(EFieldType,
     EFT_FermionStaggeredU1,
     EFT_GaugeU1,
     EFT_GaugeReal,
+    EFT_GaugeU1Angle,
     EFT_Max,
     EFT_ForceDword = 0x7fffffff,
 
@@ -144,23 +149,36 @@ __DEFINE_ENUM(ESolverPhase,
 
 #define _CSSMALLINT4(intd) ((const SSmallInt4*)(&intd))
 
+/**
+* The type of one coordinate in SSmallInt4
+*/
+#if _CLG_LARGE_LATTICE
+typedef SWORD SCOORD;
+typedef QWORD SCOORD4;
+enum { kMaxCoordinate = MAXSWORD };
+#else
+typedef SBYTE SCOORD;
+typedef UINT SCOORD4;
+enum { kMaxCoordinate = MAXSBYTE };
+#endif
+
 #if defined(__cplusplus)
     extern "C" {
 #endif /* __cplusplus */
     //instead of int4
-    struct CLGAPI alignas(4) SSmallInt4
+    struct CLGAPI alignas(sizeof(SCOORD4)) SSmallInt4
     {
         __device__ __host__ SSmallInt4() {}
         __device__ __host__ SSmallInt4(const SSmallInt4& other) : x(other.x), y(other.y), z(other.z), w(other.w) {}
-        __device__ __host__ SSmallInt4(SBYTE inx, SBYTE iny, SBYTE inz, SBYTE inw) : x(inx), y(iny), z(inz), w(inw) {}
+        __device__ __host__ SSmallInt4(SCOORD inx, SCOORD iny, SCOORD inz, SCOORD inw) : x(inx), y(iny), z(inz), w(inw) {}
 
         union
         {
-            UINT m_uiData;
-            SBYTE m_byData4[4];
+            SCOORD4 m_uiData;
+            SCOORD m_byData4[4];
             struct 
             {
-                SBYTE x, y, z, w;
+                SCOORD x, y, z, w;
             };
         };
 
@@ -181,17 +199,20 @@ __DEFINE_ENUM(ESolverPhase,
             return static_cast<INT>(w);
         }
 
+        /**
+         * The parity of the global coordinate, so the slabs of CDomainDecomposition agree with the global lattice
+         */
         __device__ __inline__ UBOOL IsOdd() const
         {
-            return (x + y + z + w) & 1;
+            return (x + y + z + w + _DC_XOrigin) & 1;
         }
 
         /**
-         * eta_{mu}(n) = (-1)^{sum (nu<mu)}
+         * eta_{mu}(n) = (-1)^{sum (nu<mu)}, also with the global x
          */
         __device__ __inline__ UBOOL EtaOdd(BYTE nu) const
         {
-            SWORD sSum = 0;
+            INT sSum = nu > 0 ? _DC_XOrigin : 0;
             for (BYTE byIdx = 0; byIdx < nu && byIdx < 4; ++byIdx)
             {
                 sSum += m_byData4[byIdx];
@@ -285,10 +306,10 @@ __device__ __inline__ static UINT _deviceGetFatIndex(UINT uiSiteIndex, BYTE dir_
 __device__ __inline__ static SSmallInt4 __deviceSiteIndexToInt4(UINT siteIndex)
 {
     SSmallInt4 xyzt;
-    xyzt.x = static_cast<SBYTE>(siteIndex / _DC_MultX);
-    xyzt.y = static_cast<SBYTE>((siteIndex % _DC_MultX) / _DC_MultY);
-    xyzt.z = static_cast<SBYTE>((siteIndex % _DC_MultY) / _DC_MultZ);
-    xyzt.w = static_cast<SBYTE>((siteIndex % _DC_MultZ));
+    xyzt.x = static_cast<SCOORD>(siteIndex / _DC_MultX);
+    xyzt.y = static_cast<SCOORD>((siteIndex % _DC_MultX) / _DC_MultY);
+    xyzt.z = static_cast<SCOORD>((siteIndex % _DC_MultY) / _DC_MultZ);
+    xyzt.w = static_cast<SCOORD>((siteIndex % _DC_MultZ));
     return xyzt;
 }
 
@@ -309,10 +330,10 @@ __device__ __inline__ static SSmallInt4 __deviceFatIndexToInt4(UINT fatIndex)
 inline static SSmallInt4 __hostSiteIndexToInt4(UINT siteIndex)
 {
     SSmallInt4 xyzt;
-    xyzt.x = static_cast<SBYTE>(siteIndex / _HC_MultX);
-    xyzt.y = static_cast<SBYTE>((siteIndex % _HC_MultX) / _HC_MultY);
-    xyzt.z = static_cast<SBYTE>((siteIndex % _HC_MultY) / _HC_MultZ);
-    xyzt.w = static_cast<SBYTE>((siteIndex % _HC_MultZ));
+    xyzt.x = static_cast<SCOORD>(siteIndex / _HC_MultX);
+    xyzt.y = static_cast<SCOORD>((siteIndex % _HC_MultX) / _HC_MultY);
+    xyzt.z = static_cast<SCOORD>((siteIndex % _HC_MultY) / _HC_MultZ);
+    xyzt.w = static_cast<SCOORD>((siteIndex % _HC_MultZ));
     return xyzt;
 }
 
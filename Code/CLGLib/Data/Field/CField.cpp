@@ -69,6 +69,104 @@ CCString CField::SaveToFile(const CCString& fileName, EFieldFileType eType) cons
     return _T("Not supported");
 }
 
+void CField::LinearCombine(UINT uiCount, const CField* const* pFields, const CLGComplex* pCoeffs)
+{
+    //scale me first if me is on the right, then add the others
+    UBOOL bHasMe = FALSE;
+    CLGComplex cMe = _make_cuComplex(F(0.0), F(0.0));
+    for (UINT i = 0; i < uiCount; ++i)
+    {
+        if (this == pFields[i])
+        {
+            bHasMe = TRUE;
+            cMe = _cuCaddf(cMe, pCoeffs[i]);
+        }
+    }
+
+    if (!bHasMe)
+    {
+        Zero();
+    }
+    else if (cMe.y != F(0.0))
+    {
+        ScalarMultply(cMe);
+    }
+    else if (cMe.x != F(1.0))
+    {
+        ScalarMultply(cMe.x);
+    }
+
+    for (UINT i = 0; i < uiCount; ++i)
+    {
+        if (this == pFields[i])
+        {
+            continue;
+        }
+        if (pCoeffs[i].y != F(0.0))
+        {
+            Axpy(pCoeffs[i], pFields[i]);
+        }
+        else if (F(1.0) == pCoeffs[i].x)
+        {
+            AxpyPlus(pFields[i]);
+        }
+        else if (F(-1.0) == pCoeffs[i].x)
+        {
+            AxpyMinus(pFields[i]);
+        }
+        else
+        {
+            Axpy(pCoeffs[i].x, pFields[i]);
+        }
+    }
+}
+
+UBOOL CField::ApplyOperatorFused(EFieldOperator op, const CField* otherfield, SOperatorFusion& fusion, EOperatorCoefficientType uiCoeffType, Real fCoeffReal, Real fCoeffImg, void* otherParameter)
+{
+    CField* pSource = NULL;
+    if (fusion.IsFused(EOF_DotSource))
+    {
+        pSource = appGetLattice()->GetPooledFieldById(m_byFieldId);
+        CopyTo(pSource);
+    }
+
+    //b - c D x = b + (-c) D x
+    if (fusion.IsFused(EOF_BMinus))
+    {
+        switch (uiCoeffType)
+        {
+        case EOCT_None:
+            uiCoeffType = EOCT_Minus;
+            break;
+        case EOCT_Minus:
+            uiCoeffType = EOCT_None;
+            break;
+        default:
+            fCoeffReal = -fCoeffReal;
+            fCoeffImg = -fCoeffImg;
+            break;
+        }
+    }
+
+    const UBOOL bRes = ApplyOperator(op, otherfield, uiCoeffType, fCoeffReal, fCoeffImg, otherParameter);
+    if (bRes && fusion.IsFused(EOF_BMinus))
+    {
+        AxpyPlus(fusion.m_pB);
+    }
+
+    if (NULL != pSource)
+    {
+        fusion.m_cDot = pSource->Dot(this);
+        pSource->Return();
+    }
+
+    if (fusion.IsFused(EOF_Norm))
+    {
+        fusion.m_fNorm = Dot(this).x;
+    }
+    return bRes;
+}
+
 CFieldFermion::CFieldFermion()
 : CField()
 , m_byEvenFieldId(-1)
@@ -143,16 +241,23 @@ void CFieldFermionKS::InitialOtherParameters(CParameters& params)
     params.FetchValueINT(_T("EachSiteEta"), iEachEta);
     m_bEachSiteEta = (0 != iEachEta);
 
-    TArray<Real> coeffs;
-    params.FetchValueArrayReal(_T("MD"), coeffs);
-    m_rMD.Initial(coeffs);
+    TArray<Real> md;
+    params.FetchValueArrayReal(_T("MD"), md);
 
-    params.FetchValueArrayReal(_T("MC"), coeffs);
-    m_rMC.Initial(coeffs);
+    TArray<Real> mc;
+    params.FetchValueArrayReal(_T("MC"), mc);
 
     //params.FetchValueArrayReal(_T("EN"), coeffs);
     //m_rEN.Initial(coeffs);
 
+    SetRationalApproximation(md, mc);
+}
+
+void CFieldFermionKS::SetRationalApproximation(const TArray<Real>& md, const TArray<Real>& mc)
+{
+    m_rMD.Initial(md);
+    m_rMC.Initial(mc);
+
     if (NULL != m_pMDNumerator)
     {
         checkCudaErrors(cudaFree(m_pMDNumerator));
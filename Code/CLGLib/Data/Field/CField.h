@@ -75,6 +75,70 @@ enum EOperatorCoefficientType
     EOCT_Complex, //Complex Number
 };
 
+/**
+* The BLAS following an operator can be fused into the last pass of the operator,
+* see ApplyOperatorFused. They can be combined, for example EOF_BMinus | EOF_Norm.
+*/
+enum EOperatorFusion
+{
+    EOF_None = 0x00,
+    EOF_BMinus = 0x01, // me = b - c D me
+    EOF_DotSource = 0x02, // m_cDot = <me_old, me_new>
+    EOF_Norm = 0x04, // m_fNorm = <me_new, me_new>
+};
+
+class CField;
+struct CLGAPI SOperatorFusion
+{
+    SOperatorFusion(UINT uiFusion, const CField* pB = NULL)
+        : m_uiFusion(uiFusion)
+        , m_pB(pB)
+#if !_CLG_DOUBLEFLOAT
+        , m_cDot(make_cuDoubleComplex(0.0, 0.0))
+        , m_fNorm(0.0)
+#else
+        , m_cDot(_make_cuComplex(F(0.0), F(0.0)))
+        , m_fNorm(F(0.0))
+#endif
+    {
+
+    }
+
+    UBOOL IsFused(EOperatorFusion eFusion) const { return 0 != (m_uiFusion & eFusion); }
+
+    /**
+    * For <x, c D D^+ x> = c |D^+ x|^2
+    */
+    void SetDotByNorm(DOUBLE fNorm, EOperatorCoefficientType eOCT, Real fRealCoeff, const CLGComplex& cCmpCoeff)
+    {
+        switch (eOCT)
+        {
+        case EOCT_Minus:
+            m_cDot = make_cuDoubleComplex(-fNorm, 0.0);
+            break;
+        case EOCT_Real:
+            m_cDot = make_cuDoubleComplex(fRealCoeff * fNorm, 0.0);
+            break;
+        case EOCT_Complex:
+            m_cDot = make_cuDoubleComplex(cCmpCoeff.x * fNorm, cCmpCoeff.y * fNorm);
+            break;
+        default:
+            m_cDot = make_cuDoubleComplex(fNorm, 0.0);
+            break;
+        }
+    }
+
+    UINT m_uiFusion;
+    const CField* m_pB;
+#if !_CLG_DOUBLEFLOAT
+    cuDoubleComplex m_cDot;
+    DOUBLE m_fNorm;
+#else
+    CLGComplex m_cDot;
+    Real m_fNorm;
+#endif
+};
+
 class CLGAPI CField : public CBase
 {
 public:
@@ -114,6 +178,16 @@ public:
     //This is a * me
     virtual void ScalarMultply(const CLGComplex& a) = 0;
     virtual void ScalarMultply(Real a) = 0;
+
+    /**
+    * me = sum _i coeff_i field_i, field_i can be me.
+    * Use appFieldAssign in TFieldExpression.h instead of calling it directly.
+    * This implementation uses ScalarMultply and Axpy (the real, +1 and -1 versions when possible, nothing for me * 1),
+    * the fields with the linear combine kernel override it to stream the fields only once.
+    */
+    enum { _kLinearCombineMaxTerm = 8 };
+    virtual void LinearCombine(UINT uiCount, const CField* const* pFields, const CLGComplex* pCoeffs);
+
     virtual CCString SaveToFile(const CCString &fileName, EFieldFileType eType = EFFT_CLGBin) const;
     virtual CCString SaveToCompressedFile(const CCString&) const { appCrucial(_T("Not supported compressed file format for this field!\n")); return _T("Not Supported"); }
     //Why we need this? because the data structure are aligned.
@@ -159,6 +233,12 @@ public:
 
     virtual UBOOL ApplyOperator(EFieldOperator op, const CField* otherfield, EOperatorCoefficientType uiCoeffType = EOCT_None, Real fCoeffReal = F(1.0), Real fCoeffImg = F(0.0), void* otherParameter = NULL) = 0;
 
+    /**
+    * ApplyOperator, and the BLAS in fusion, the results of dot and norm are written to fusion.
+    * This implementation is not fused, the fields with fused kernels override it.
+    */
+    virtual UBOOL ApplyOperatorFused(EFieldOperator op, const CField* otherfield, SOperatorFusion& fusion, EOperatorCoefficientType uiCoeffType = EOCT_None, Real fCoeffReal = F(1.0), Real fCoeffImg = F(0.0), void* otherParameter = NULL);
+
     virtual UBOOL IsGaugeField() const { return FALSE; }
     virtual UBOOL IsFermionField() const { return FALSE; }
     virtual UBOOL IsEvenField() const { return FALSE; }
@@ -257,6 +337,12 @@ public:
 
         //the real ID = 100 + action ID
         CachedForceFieldStart = 100,
+
+        //the real ID = 200 + fermion field ID, smeared links of improved staggered fermions
+        CachedFatLinkFieldStart = 200,
+        CachedLongLinkFieldStart = 300,
+        CachedFatLinkForceStart = 400,
+        CachedLongLinkForceStart = 500,
     };
 
     CFieldCache()
@@ -291,8 +377,52 @@ public:
         return NULL;
     }
 
+    /**
+    * For the fields calculated from a gauge field (for example the fat links).
+    * They are valid only for the same gauge field with the same version (see CFieldGauge::GetVersion).
+    * The pointers are only compared, the gauge field may be already deleted.
+    */
+    UBOOL IsCachedFieldValid(UINT uiID, const class CFieldGauge* pGauge, UINT uiVersion) const
+    {
+        return m_pCachedFieldMaps.Exist(uiID)
+            && m_pCachedFieldGauge.Exist(uiID)
+            && NULL != m_pCachedFieldGauge.GetAt(uiID)
+            && m_pCachedFieldGauge.GetAt(uiID) == pGauge
+            && m_uiCachedFieldVersion.GetAt(uiID) == uiVersion;
+    }
+
+    /**
+    * The operators only with the device buffer of the gauge field can use the cached field,
+    * when it is calculated from a known gauge field with the same buffer.
+    */
+    UBOOL IsCachedFieldValid(UINT uiID, const void* pGaugeBuffer) const
+    {
+        return m_pCachedFieldMaps.Exist(uiID)
+            && m_pCachedFieldGauge.Exist(uiID)
+            && NULL != m_pCachedFieldGauge.GetAt(uiID)
+            && m_pCachedFieldBuffer.GetAt(uiID) == pGaugeBuffer;
+    }
+
+    /**
+    * pGauge can be NULL when only the buffer is known, then it is rebuilt next time.
+    */
+    void SetCachedFieldGauge(UINT uiID, const class CFieldGauge* pGauge, UINT uiVersion, const void* pGaugeBuffer)
+    {
+        m_pCachedFieldGauge.SetAt(uiID, pGauge);
+        m_uiCachedFieldVersion.SetAt(uiID, uiVersion);
+        m_pCachedFieldBuffer.SetAt(uiID, pGaugeBuffer);
+    }
+
+    void InvalidateCachedField(UINT uiID)
+    {
+        SetCachedFieldGauge(uiID, NULL, 0, NULL);
+    }
+
     TArray<CField*> m_pCachedFields;
     THashMap<UINT, CField*> m_pCachedFieldMaps;
+    THashMap<UINT, const class CFieldGauge*> m_pCachedFieldGauge;
+    THashMap<UINT, UINT> m_uiCachedFieldVersion;
+    THashMap<UINT, const void*> m_pCachedFieldBuffer;
 };
 
 /**
@@ -59,6 +59,12 @@ public:
 
     Real GetMass() const { return m_f2am; }
 
+    /**
+     * md, mc are {c, a1, a2, ..., b1, b2, ...}, see CRatinalApproximation
+     * Used when the determinant is splitted to n-th roots, each with lower degree
+     */
+    virtual void SetRationalApproximation(const TArray<Real>& md, const TArray<Real>& mc);
+
     void CopyTo(CField* U) const override
     {
         CField::CopyTo(U);
@@ -162,6 +168,14 @@ static __device__ __inline__ void _devicePathDagger(const INT* __restrict__ path
     }
 }
 
+/**
+ * eta_1 eta_2 eta_4 = (-1)^{y+z}, used in the rotation terms
+ */
+static __device__ __inline__ Real _deviceEta124(const SSmallInt4& sSite)
+{
+    return (((sSite.y + sSite.z) & 1) > 0) ? (F(-1.0)) : (F(1.0));
+}
+
 #pragma endregion
 
 __END_NAMESPACE
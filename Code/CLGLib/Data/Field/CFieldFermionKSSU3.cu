@@ -18,293 +18,120 @@ __CLGIMPLEMENT_CLASS(CFieldFermionKSSU3)
 
 #pragma region DOperator
 
-#pragma region kernel
-
 /**
 * Dks = 2am + \sum _{\mu} \eta_{\mu} (n) (U_{\mu}(n) \delta _{n,n+\mu} -U^+_{\mu}(n-\mu) \delta _{n,n-\mu})
 * U act on su3
 * gamma act on spinor
 *
-* If bDagger, it is just \eta 5(n) Dks \eta _5(n)
-* A easier way is D_{ks}(m=0) is anti-Hermitian, so D^+ = - D_{ks,m=0} + 2am
-*
+* See TFermionKSKernel.h
 */
-__global__ void _CLG_LAUNCH_BOUND
-_kernelDFermionKS(
-    const deviceSU3Vector * __restrict__ pDeviceData,
-    const deviceSU3 * __restrict__ pGauge,
-    const SIndex * __restrict__ pGaugeMove,
-    const SIndex * __restrict__ pFermionMove,
-    const BYTE * __restrict__ pEtaTable,
-    deviceSU3Vector* pResultData,
-    Real f2am,
-    BYTE byFieldId,
-    UBOOL bDDagger,
-    EOperatorCoefficientType eCoeff,
-    Real fCoeff,
-    CLGComplex cCoeff)
+void CFieldFermionKSSU3::DOperatorKS(void* pTargetBuffer, const void * pBuffer,
+    const void * pGaugeBuffer, Real f2am,
+    UBOOL bDagger, EOperatorCoefficientType eOCT,
+    Real fRealCoeff, const CLGComplex& cCmpCoeff) const
 {
-    intokernaldir;
-
-    deviceSU3Vector result = deviceSU3Vector::makeZeroSU3Vector();
-    pResultData[uiSiteIndex] = pDeviceData[uiSiteIndex];
-
-    //idir = mu
-    for (UINT idir = 0; idir < uiDir; ++idir)
-    {
-        //Get Gamma mu
-        const Real eta_mu = (1 == ((pEtaTable[uiSiteIndex] >> idir) & 1)) ? F(-1.0) : F(1.0);
-
-        //x, mu
-        const UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
-
-        const SIndex& x_m_mu_Gauge = pGaugeMove[linkIndex];
-
-        const SIndex& x_p_mu_Fermion = pFermionMove[2 * linkIndex];
-        const SIndex& x_m_mu_Fermion = pFermionMove[2 * linkIndex + 1];
-
-        //Assuming periodic
-        //get U(x,mu), U^{dagger}(x-mu), 
-        const deviceSU3& x_Gauge_element = pGauge[linkIndex];
-        deviceSU3 x_m_mu_Gauge_element = pGauge[_deviceGetLinkIndex(x_m_mu_Gauge.m_uiSiteIndex, idir)];
-        if (x_m_mu_Gauge.NeedToDagger())
-        {
-            x_m_mu_Gauge_element.Dagger();
-        }
-
-        //U(x,mu) phi(x+ mu)
-        deviceSU3Vector u_phi_x_p_m = x_Gauge_element.MulVector(pDeviceData[x_p_mu_Fermion.m_uiSiteIndex]);
-        if (x_p_mu_Fermion.NeedToOpposite())
-        {
-            u_phi_x_p_m.MulReal(F(-1.0));
-        }
-
-        //U^{dagger}(x-mu) phi(x-mu)
-        deviceSU3Vector u_dagger_phi_x_m_m = x_m_mu_Gauge_element.MulVector(pDeviceData[x_m_mu_Fermion.m_uiSiteIndex]);
-        if (x_m_mu_Fermion.NeedToOpposite())
-        {
-            u_phi_x_p_m.Add(u_dagger_phi_x_m_m);
-        }
-        else
-        {
-            u_phi_x_p_m.Sub(u_dagger_phi_x_m_m);
-        }
-        u_phi_x_p_m.MulReal(eta_mu);
-        result.Add(u_phi_x_p_m);
-    }
-
-    pResultData[uiSiteIndex].MulReal(f2am);
-    if (bDDagger)
-    {
-        pResultData[uiSiteIndex].Sub(result);
-    }
-    else
-    {
-        pResultData[uiSiteIndex].Add(result);
-    }
-
-    switch (eCoeff)
-    {
-    case EOCT_Real:
-        pResultData[uiSiteIndex].MulReal(fCoeff);
-        break;
-    case EOCT_Complex:
-        pResultData[uiSiteIndex].MulComp(cCoeff);
-        break;
-    }
+    DOperatorKSFused(pTargetBuffer, pBuffer, pGaugeBuffer, f2am, bDagger, eOCT, fRealCoeff, cCmpCoeff, NULL, NULL, NULL);
 }
 
-/**
- * For some strange boundary condition
- */
-__global__ void _CLG_LAUNCH_BOUND
-_kernelDFermionKSPlusEta(
-    const deviceSU3Vector* __restrict__ pDeviceData,
-    const deviceSU3* __restrict__ pGauge,
-    const SIndex* __restrict__ pGaugeMove,
-    const SIndex* __restrict__ pFermionMove,
-    const BYTE* __restrict__ pEtaTable,
-    deviceSU3Vector* pResultData,
-    Real f2am,
-    BYTE byFieldId,
-    UBOOL bDDagger,
-    EOperatorCoefficientType eCoeff,
-    Real fCoeff,
-    CLGComplex cCoeff)
+void CFieldFermionKSSU3::DOperatorKSFused(void* pTargetBuffer, const void* pBuffer,
+    const void* pGaugeBuffer, Real f2am,
+    UBOOL bDagger, EOperatorCoefficientType eOCT,
+    Real fRealCoeff, const CLGComplex& cCmpCoeff,
+    const deviceSU3Vector* pB,
+#if !_CLG_DOUBLEFLOAT
+    cuDoubleComplex* pDot,
+    DOUBLE* pNorm
+#else
+    CLGComplex* pDot,
+    Real* pNorm
+#endif
+    ) const
 {
-    intokernaldir;
-
-    deviceSU3Vector result = deviceSU3Vector::makeZeroSU3Vector();
-    pResultData[uiSiteIndex] = pDeviceData[uiSiteIndex];
+    deviceSU3Vector* pTarget = (deviceSU3Vector*)pTargetBuffer;
+    const deviceSU3Vector* pSource = (const deviceSU3Vector*)pBuffer;
+    const deviceSU3* pGauge = (const deviceSU3*)pGaugeBuffer;
+    const UINT uiBytes = static_cast<UINT>(sizeof(deviceSU3Vector));
 
-    //idir = mu
-    for (UINT idir = 0; idir < uiDir; ++idir)
+#if _CLG_DIRECT_STENCIL
+    if (!m_bEachSiteEta && appGetLattice()->m_pIndex->UseDirectStencil(1))
     {
-        //x, mu
-        const UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
-
-        const SIndex& x_m_mu_Gauge = pGaugeMove[linkIndex];
-
-        const SIndex& x_p_mu_Fermion = pFermionMove[2 * linkIndex];
-        const SIndex& x_m_mu_Fermion = pFermionMove[2 * linkIndex + 1];
-
-        //This is in fact, -1 * eta(n + mu)
-        const Real eta_mu = (1 == ((pEtaTable[uiSiteIndex] >> idir) & 1)) ? F(-1.0) : F(1.0);
-        const Real eta_mu2 = (1 == ((pEtaTable[x_m_mu_Fermion.m_uiSiteIndex] >> idir) & 1)) ? F(-1.0) : F(1.0);
-
-        //Assuming periodic
-        //get U(x,mu), U^{dagger}(x-mu), 
-        const deviceSU3& x_Gauge_element = pGauge[linkIndex];
-        deviceSU3 x_m_mu_Gauge_element = pGauge[_deviceGetLinkIndex(x_m_mu_Gauge.m_uiSiteIndex, idir)];
-        if (x_m_mu_Gauge.NeedToDagger())
-        {
-            x_m_mu_Gauge_element.Dagger();
-        }
-
-        //U(x,mu) phi(x+ mu)
-        deviceSU3Vector u_phi_x_p_m = x_Gauge_element.MulVector(pDeviceData[x_p_mu_Fermion.m_uiSiteIndex]);
-        if (x_p_mu_Fermion.NeedToOpposite())
+        SKSStencilTorus stencil;
+        stencil.m_sBC = appGetLattice()->m_pIndex->m_pBoundaryCondition->GetFieldBC(m_byFieldId);
+        preparethread_tuned(_T("_kernelDFermionKST_Torus_SU3"));
+        //the inner planes overlap the halo exchange, see appBeginExchangeHalo
+        SXPlaneRange sRange = appBeginExchangeHalo(pBuffer, uiBytes, 1);
+        do
         {
-            u_phi_x_p_m.MulReal(F(-1.0) * eta_mu);
-        }
-        else
-        {
-            u_phi_x_p_m.MulReal(eta_mu);
-        }
-
-        //U^{dagger}(x-mu) phi(x-mu)
-        deviceSU3Vector u_dagger_phi_x_m_m = x_m_mu_Gauge_element.MulVector(pDeviceData[x_m_mu_Fermion.m_uiSiteIndex]);
-        u_dagger_phi_x_m_m.MulReal(eta_mu2);
-        if (x_m_mu_Fermion.NeedToOpposite())
+            _kernelDFermionKST<SKSGroupSU3, SKSStencilTorus, SKSPhaseNone> << <block, threads >> > (
+                pSource,
+                pGauge,
+                pTarget,
+                f2am,
+                bDagger,
+                eOCT,
+                fRealCoeff,
+                cCmpCoeff,
+                stencil,
+                SKSPhaseNone(),
+                sRange,
+                pB,
+                pDot,
+                pNorm);
+        } while (appEndExchangeHalo(pBuffer, uiBytes, sRange));
+        finishthread_tuned;
+        return;
+    }
+#endif
+    preparethread_tuned(_T("_kernelDFermionKST_SU3"));
+    SXPlaneRange sRange = appBeginExchangeHalo(pBuffer, uiBytes, 1);
+    do
+    {
+        if (m_bEachSiteEta)
         {
-            u_phi_x_p_m.Add(u_dagger_phi_x_m_m);
+            const SKSStencilCache<SKSEtaEachSite> stencil = {
+                appGetLattice()->m_pIndexCache->m_pGaugeMoveCache[m_byFieldId],
+                appGetLattice()->m_pIndexCache->m_pFermionMoveCache[m_byFieldId],
+                appGetLattice()->m_pIndexCache->m_pEtaMu };
+            _kernelDFermionKST<SKSGroupSU3, SKSStencilCache<SKSEtaEachSite>, SKSPhaseNone> << <block, threads >> > (
+                pSource,
+                pGauge,
+                pTarget,
+                f2am,
+                bDagger,
+                eOCT,
+                fRealCoeff,
+                cCmpCoeff,
+                stencil,
+                SKSPhaseNone(),
+                sRange,
+                pB,
+                pDot,
+                pNorm);
         }
         else
         {
-            u_phi_x_p_m.Sub(u_dagger_phi_x_m_m);
-        }
-        //u_phi_x_p_m.MulReal(eta_mu);
-        result.Add(u_phi_x_p_m);
-    }
-
-    pResultData[uiSiteIndex].MulReal(f2am);
-    if (bDDagger)
-    {
-        pResultData[uiSiteIndex].Sub(result);
-    }
-    else
-    {
-        pResultData[uiSiteIndex].Add(result);
-    }
-
-    switch (eCoeff)
-    {
-    case EOCT_Real:
-        pResultData[uiSiteIndex].MulReal(fCoeff);
-        break;
-    case EOCT_Complex:
-        pResultData[uiSiteIndex].MulComp(cCoeff);
-        break;
-    }
-}
-
-/**
- * Calculate Force
- */
-__global__ void _CLG_LAUNCH_BOUND
-_kernelDFermionKSForce(
-    const deviceSU3* __restrict__ pGauge,
-    deviceSU3* pForce,
-    const SIndex* __restrict__ pFermionMove,
-    const BYTE* __restrict__ pEtaTable,
-    const deviceSU3Vector* const* __restrict__ pFermionPointers,
-    const Real* __restrict__ pNumerators,
-    UINT uiRational,
-    BYTE byFieldId)
-{
-    intokernaldir;
-
-    //idir = mu
-    for (UINT idir = 0; idir < uiDir; ++idir)
-    {
-        //Get Gamma mu
-        const Real eta_mu = (1 == ((pEtaTable[uiSiteIndex] >> idir) & 1)) ? F(-1.0) : F(1.0);
-        //x, mu
-        const UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
-
-        const SIndex& x_p_mu_Fermion = pFermionMove[2 * linkIndex];
-
-        for (UINT uiR = 0; uiR < uiRational; ++uiR)
-        {
-            const deviceSU3Vector* phi_i = pFermionPointers[uiR];
-            const deviceSU3Vector* phi_id = pFermionPointers[uiR + uiRational];
-
-            deviceSU3Vector toContract = pGauge[linkIndex].MulVector(phi_i[x_p_mu_Fermion.m_uiSiteIndex]);
-            deviceSU3 thisTerm = deviceSU3::makeSU3ContractV(phi_id[uiSiteIndex], toContract);
-
-            toContract = pGauge[linkIndex].MulVector(phi_id[x_p_mu_Fermion.m_uiSiteIndex]);
-            thisTerm.Add(deviceSU3::makeSU3ContractV(toContract, phi_i[uiSiteIndex]));
-
-            if (x_p_mu_Fermion.NeedToOpposite())
-            {
-                thisTerm.MulReal(eta_mu * pNumerators[uiR] * F(-1.0));
-            }
-            else
-            {
-                thisTerm.MulReal(eta_mu * pNumerators[uiR]);
-            }
-
-            thisTerm.Ta();
-            pForce[linkIndex].Sub(thisTerm);
+            const SKSStencilCache<SKSEtaSite> stencil = {
+                appGetLattice()->m_pIndexCache->m_pGaugeMoveCache[m_byFieldId],
+                appGetLattice()->m_pIndexCache->m_pFermionMoveCache[m_byFieldId],
+                appGetLattice()->m_pIndexCache->m_pEtaMu };
+            _kernelDFermionKST<SKSGroupSU3, SKSStencilCache<SKSEtaSite>, SKSPhaseNone> << <block, threads >> > (
+                pSource,
+                pGauge,
+                pTarget,
+                f2am,
+                bDagger,
+                eOCT,
+                fRealCoeff,
+                cCmpCoeff,
+                stencil,
+                SKSPhaseNone(),
+                sRange,
+                pB,
+                pDot,
+                pNorm);
         }
-    }
-
-}
-
-#pragma endregion
-
-void CFieldFermionKSSU3::DOperatorKS(void* pTargetBuffer, const void * pBuffer,
-    const void * pGaugeBuffer, Real f2am,
-    UBOOL bDagger, EOperatorCoefficientType eOCT,
-    Real fRealCoeff, const CLGComplex& cCmpCoeff) const
-{
-    deviceSU3Vector* pTarget = (deviceSU3Vector*)pTargetBuffer;
-    const deviceSU3Vector* pSource = (const deviceSU3Vector*)pBuffer;
-    const deviceSU3* pGauge = (const deviceSU3*)pGaugeBuffer;
-
-    preparethread;
-    if (m_bEachSiteEta)
-    {
-        _kernelDFermionKSPlusEta << <block, threads >> > (
-            pSource,
-            pGauge,
-            appGetLattice()->m_pIndexCache->m_pGaugeMoveCache[m_byFieldId],
-            appGetLattice()->m_pIndexCache->m_pFermionMoveCache[m_byFieldId],
-            appGetLattice()->m_pIndexCache->m_pEtaMu,
-            pTarget,
-            f2am,
-            m_byFieldId,
-            bDagger,
-            eOCT,
-            fRealCoeff,
-            cCmpCoeff);
-    }
-    else
-    {
-        _kernelDFermionKS << <block, threads >> > (
-            pSource,
-            pGauge,
-            appGetLattice()->m_pIndexCache->m_pGaugeMoveCache[m_byFieldId],
-            appGetLattice()->m_pIndexCache->m_pFermionMoveCache[m_byFieldId],
-            appGetLattice()->m_pIndexCache->m_pEtaMu,
-            pTarget,
-            f2am,
-            m_byFieldId,
-            bDagger,
-            eOCT,
-            fRealCoeff,
-            cCmpCoeff);
-    }
+    } while (appEndExchangeHalo(pBuffer, uiBytes, sRange));
+    finishthread_tuned;
 }
 
 /**
@@ -315,16 +142,38 @@ void CFieldFermionKSSU3::DerivateD0(
     void* pForce, 
     const void* pGaugeBuffer) const
 {
-    preparethread;
-    _kernelDFermionKSForce << <block, threads >> > (
+#if _CLG_DIRECT_STENCIL
+    if (appGetLattice()->m_pIndex->UseDirectStencil(1))
+    {
+        SKSStencilTorus stencil;
+        stencil.m_sBC = appGetLattice()->m_pIndex->m_pBoundaryCondition->GetFieldBC(m_byFieldId);
+        preparethread_tuned(_T("_kernelDFermionKSForceT_Torus_SU3"));
+        _kernelDFermionKSForceT<SKSGroupSU3, SKSStencilTorus, SKSPhaseNone> << <block, threads >> > (
+            (const deviceSU3*)pGaugeBuffer,
+            (deviceSU3*)pForce,
+            m_pRationalFieldPointers,
+            m_pMDNumerator,
+            m_rMD.m_uiDegree,
+            stencil,
+            SKSPhaseNone());
+        finishthread_tuned;
+        return;
+    }
+#endif
+    const SKSStencilCache<SKSEtaSite> stencil = {
+        appGetLattice()->m_pIndexCache->m_pGaugeMoveCache[m_byFieldId],
+        appGetLattice()->m_pIndexCache->m_pFermionMoveCache[m_byFieldId],
+        appGetLattice()->m_pIndexCache->m_pEtaMu };
+    preparethread_tuned(_T("_kernelDFermionKSForceT_SU3"));
+    _kernelDFermionKSForceT<SKSGroupSU3, SKSStencilCache<SKSEtaSite>, SKSPhaseNone> << <block, threads >> > (
         (const deviceSU3*)pGaugeBuffer,
         (deviceSU3*)pForce,
-        appGetLattice()->m_pIndexCache->m_pFermionMoveCache[m_byFieldId],
-        appGetLattice()->m_pIndexCache->m_pEtaMu,
         m_pRationalFieldPointers,
         m_pMDNumerator,
         m_rMD.m_uiDegree,
-        m_byFieldId);
+        stencil,
+        SKSPhaseNone());
+    finishthread_tuned;
 }
 
 #pragma endregion
@@ -338,6 +187,7 @@ __global__ void _CLG_LAUNCH_BOUND
 _kernelInitialFermionKS(deviceSU3Vector* pDevicePtr, BYTE byFieldId, EFieldInitialType eInitialType)
 {
     intokernalInt4;
+    SRandomDraw uiDraw;
 
     switch (eInitialType)
     {
@@ -353,12 +203,12 @@ _kernelInitialFermionKS(deviceSU3Vector* pDevicePtr, BYTE byFieldId, EFieldIniti
     break;
     case EFIT_RandomGaussian:
     {
-        pDevicePtr[uiSiteIndex] = deviceSU3Vector::makeRandomGaussian(_deviceGetFatIndex(uiSiteIndex, 0));
+        pDevicePtr[uiSiteIndex] = deviceSU3Vector::makeRandomGaussian(_deviceGetFatIndex(uiSiteIndex, 0), uiDraw);
     }
     break;
     case EFIT_RandomZ4:
     {
-        pDevicePtr[uiSiteIndex] = deviceSU3Vector::makeRandomZ4(_deviceGetFatIndex(uiSiteIndex, 0));
+        pDevicePtr[uiSiteIndex] = deviceSU3Vector::makeRandomZ4(_deviceGetFatIndex(uiSiteIndex, 0), uiDraw);
     }
     break;
     default:
@@ -392,6 +242,7 @@ void CFieldFermionKSSU3::D_MC(const CField* pGauge)
 void CFieldFermionKSSU3::PrepareForHMC(const CFieldGauge* pGauge)
 {
     preparethread;
+    appGetLattice()->m_pRandom->NextLaunch();
     _kernelInitialFermionKS << <block, threads >> > (
         m_pDeviceData,
         m_byFieldId,
@@ -615,9 +466,9 @@ _kernelMakeWallSourceKS(deviceSU3Vector* pDeviceData,
       && (uiDesiredT < 0 || uiDesiredT == sSite4.w))
     {
         //sSite4 is no longer used
-        sSite4.x = sSite4.x + static_cast<SBYTE>(uiShift & 1);
-        sSite4.y = sSite4.y + static_cast<SBYTE>((uiShift >> 1) & 1);
-        sSite4.z = sSite4.z + static_cast<SBYTE>((uiShift >> 2) & 1);
+        sSite4.x = sSite4.x + static_cast<SCOORD>(uiShift & 1);
+        sSite4.y = sSite4.y + static_cast<SCOORD>((uiShift >> 1) & 1);
+        sSite4.z = sSite4.z + static_cast<SCOORD>((uiShift >> 2) & 1);
         const SIndex& sIdx = __idx->m_pDeviceIndexPositionToSIndex[byFieldID][__bi(sSite4)];
         if (!sIdx.IsDirichlet())
         {
@@ -1029,6 +880,7 @@ CFieldFermionKSSU3::~CFieldFermionKSSU3()
 void CFieldFermionKSSU3::InitialField(EFieldInitialType eInitialType)
 {
     preparethread;
+    appGetLattice()->m_pRandom->NextLaunch();
     _kernelInitialFermionKS << <block, threads >> > (m_pDeviceData, m_byFieldId, eInitialType);
 }
 
@@ -1083,6 +935,11 @@ void CFieldFermionKSSU3::InitialWithByte(BYTE* byData)
 void CFieldFermionKSSU3::InitialOtherParameters(CParameters& params)
 {
     CFieldFermionKS::InitialOtherParameters(params);
+}
+
+void CFieldFermionKSSU3::SetRationalApproximation(const TArray<Real>& md, const TArray<Real>& mc)
+{
+    CFieldFermionKS::SetRationalApproximation(md, mc);
 
     if (NULL != m_pRationalFieldPointers)
     {
@@ -1153,8 +1010,9 @@ void CFieldFermionKSSU3::AxpyPlus(const CField* x)
     }
     const CFieldFermionKSSU3* pField = dynamic_cast<const CFieldFermionKSSU3*>(x);
 
-    preparethread;
+    preparethread_tuned(_T("_kernelAxpyPlusFermionKS"));
     _kernelAxpyPlusFermionKS << <block, threads >> > (m_pDeviceData, pField->m_pDeviceData);
+    finishthread_tuned;
 }
 
 void CFieldFermionKSSU3::AxpyMinus(const CField* x)
@@ -1166,8 +1024,9 @@ void CFieldFermionKSSU3::AxpyMinus(const CField* x)
     }
     const CFieldFermionKSSU3* pField = dynamic_cast<const CFieldFermionKSSU3*>(x);
 
-    preparethread;
+    preparethread_tuned(_T("_kernelAxpyMinusFermionKS"));
     _kernelAxpyMinusFermionKS << <block, threads >> > (m_pDeviceData, pField->m_pDeviceData);
+    finishthread_tuned;
 }
 
 void CFieldFermionKSSU3::Axpy(Real a, const CField* x)
@@ -1179,8 +1038,9 @@ void CFieldFermionKSSU3::Axpy(Real a, const CField* x)
     }
     const CFieldFermionKSSU3* pField = dynamic_cast<const CFieldFermionKSSU3*>(x);
 
-    preparethread;
+    preparethread_tuned(_T("_kernelAxpyRealFermionKS"));
     _kernelAxpyRealFermionKS << <block, threads >> > (m_pDeviceData, pField->m_pDeviceData, a);
+    finishthread_tuned;
 }
 
 void CFieldFermionKSSU3::Axpy(const CLGComplex& a, const CField* x)
@@ -1192,8 +1052,9 @@ void CFieldFermionKSSU3::Axpy(const CLGComplex& a, const CField* x)
     }
     const CFieldFermionKSSU3* pField = dynamic_cast<const CFieldFermionKSSU3*>(x);
 
-    preparethread;
+    preparethread_tuned(_T("_kernelAxpyComplexFermionKS"));
     _kernelAxpyComplexFermionKS << <block, threads >> > (m_pDeviceData, pField->m_pDeviceData, a);
+    finishthread_tuned;
 }
 
 #if !_CLG_DOUBLEFLOAT
@@ -1226,6 +1087,22 @@ void CFieldFermionKSSU3::ScalarMultply(Real a)
     _kernelScalarMultiplyRealKS << <block, threads >> > (m_pDeviceData, a);
 }
 
+void CFieldFermionKSSU3::LinearCombine(UINT uiCount, const CField* const* pFields, const CLGComplex* pCoeffs)
+{
+    const CLGComplex* pData[_kLinearCombineMaxTerm];
+    for (UINT i = 0; i < uiCount; ++i)
+    {
+        if (i >= _kLinearCombineMaxTerm || NULL == pFields[i] || EFT_FermionStaggeredSU3 != pFields[i]->GetFieldType())
+        {
+            //let the ScalarMultply and Axpy report the wrong field
+            CField::LinearCombine(uiCount, pFields, pCoeffs);
+            return;
+        }
+        pData[i] = (const CLGComplex*)(dynamic_cast<const CFieldFermionKSSU3*>(pFields[i])->m_pDeviceData);
+    }
+    _LinearCombineComplex((CLGComplex*)m_pDeviceData, 3, uiCount, pData, pCoeffs);
+}
+
 void CFieldFermionKSSU3::ApplyGamma(EGammaMatrix eGamma)
 {
     appCrucial(_T("Not implemented yet...\n"));
@@ -1275,6 +1152,7 @@ void CFieldFermionKSSU3::D(const CField* pGauge, EOperatorCoefficientType eCoeff
         return;
     }
     const CFieldGaugeSU3* pFieldSU3 = dynamic_cast<const CFieldGaugeSU3*>(pGauge);
+    PrepareGauge(pFieldSU3);
     CFieldFermionKSSU3* pPooled = dynamic_cast<CFieldFermionKSSU3*>(appGetLattice()->GetPooledFieldById(m_byFieldId));
 
     checkCudaErrors(cudaMemcpy(pPooled->m_pDeviceData, m_pDeviceData, sizeof(deviceSU3Vector) * m_uiSiteCount, cudaMemcpyDeviceToDevice));
@@ -1301,6 +1179,7 @@ void CFieldFermionKSSU3::DWithMass(const CField* pGauge, Real fMass, EOperatorCo
         return;
     }
     const CFieldGaugeSU3* pFieldSU3 = dynamic_cast<const CFieldGaugeSU3*>(pGauge);
+    PrepareGauge(pFieldSU3);
     CFieldFermionKSSU3* pPooled = dynamic_cast<CFieldFermionKSSU3*>(appGetLattice()->GetPooledFieldById(m_byFieldId));
 
     checkCudaErrors(cudaMemcpy(pPooled->m_pDeviceData, m_pDeviceData, sizeof(deviceSU3Vector) * m_uiSiteCount, cudaMemcpyDeviceToDevice));
@@ -1327,6 +1206,7 @@ void CFieldFermionKSSU3::D0(const CField* pGauge)
         return;
     }
     const CFieldGaugeSU3* pFieldSU3 = dynamic_cast<const CFieldGaugeSU3*>(pGauge);
+    PrepareGauge(pFieldSU3);
     CFieldFermionKSSU3* pPooled = dynamic_cast<CFieldFermionKSSU3*>(appGetLattice()->GetPooledFieldById(m_byFieldId));
 
     checkCudaErrors(cudaMemcpy(pPooled->m_pDeviceData, m_pDeviceData, sizeof(deviceSU3Vector) * m_uiSiteCount, cudaMemcpyDeviceToDevice));
@@ -1414,6 +1294,7 @@ void CFieldFermionKSSU3::Ddagger(const CField* pGauge, EOperatorCoefficientType
         return;
     }
     const CFieldGaugeSU3* pFieldSU3 = dynamic_cast<const CFieldGaugeSU3*>(pGauge);
+    PrepareGauge(pFieldSU3);
     CFieldFermionKSSU3* pPooled = dynamic_cast<CFieldFermionKSSU3*>(appGetLattice()->GetPooledFieldById(m_byFieldId));
     checkCudaErrors(cudaMemcpy(pPooled->m_pDeviceData, m_pDeviceData, sizeof(deviceSU3Vector) * m_uiSiteCount, cudaMemcpyDeviceToDevice));
 
@@ -1440,6 +1321,7 @@ void CFieldFermionKSSU3::DdaggerWithMass(const CField* pGauge, Real fMass, EOper
         return;
     }
     const CFieldGaugeSU3* pFieldSU3 = dynamic_cast<const CFieldGaugeSU3*>(pGauge);
+    PrepareGauge(pFieldSU3);
     CFieldFermionKSSU3* pPooled = dynamic_cast<CFieldFermionKSSU3*>(appGetLattice()->GetPooledFieldById(m_byFieldId));
     checkCudaErrors(cudaMemcpy(pPooled->m_pDeviceData, m_pDeviceData, sizeof(deviceSU3Vector) * m_uiSiteCount, cudaMemcpyDeviceToDevice));
 
@@ -1466,6 +1348,7 @@ void CFieldFermionKSSU3::DDdagger(const CField* pGauge, EOperatorCoefficientType
         return;
     }
     const CFieldGaugeSU3* pFieldSU3 = dynamic_cast<const CFieldGaugeSU3*>(pGauge);
+    PrepareGauge(pFieldSU3);
 
     Real fRealCoeff = fCoeffReal;
     const CLGComplex cCompCoeff = _make_cuComplex(fCoeffReal, fCoeffImg);
@@ -1493,6 +1376,7 @@ void CFieldFermionKSSU3::DD(const CField* pGauge, EOperatorCoefficientType eCoef
         return;
     }
     const CFieldGaugeSU3* pFieldSU3 = dynamic_cast<const CFieldGaugeSU3*>(pGauge);
+    PrepareGauge(pFieldSU3);
 
     Real fRealCoeff = fCoeffReal;
     const CLGComplex cCompCoeff = _make_cuComplex(fCoeffReal, fCoeffImg);
@@ -1520,6 +1404,7 @@ void CFieldFermionKSSU3::DDdaggerWithMass(const CField* pGauge, Real fMass, EOpe
         return;
     }
     const CFieldGaugeSU3* pFieldSU3 = dynamic_cast<const CFieldGaugeSU3*>(pGauge);
+    PrepareGauge(pFieldSU3);
 
     Real fRealCoeff = fCoeffReal;
     const CLGComplex cCompCoeff = _make_cuComplex(fCoeffReal, fCoeffImg);
@@ -1547,6 +1432,7 @@ void CFieldFermionKSSU3::DDWithMass(const CField* pGauge, Real fMass, EOperatorC
         return;
     }
     const CFieldGaugeSU3* pFieldSU3 = dynamic_cast<const CFieldGaugeSU3*>(pGauge);
+    PrepareGauge(pFieldSU3);
 
     Real fRealCoeff = fCoeffReal;
     const CLGComplex cCompCoeff = _make_cuComplex(fCoeffReal, fCoeffImg);
@@ -1566,6 +1452,82 @@ void CFieldFermionKSSU3::DDWithMass(const CField* pGauge, Real fMass, EOperatorC
     pPooled->Return();
 }
 
+UBOOL CFieldFermionKSSU3::ApplyOperatorFused(EFieldOperator op, const CField* pGauge, SOperatorFusion& fusion,
+    EOperatorCoefficientType eCoeffType, Real fCoeffReal, Real fCoeffImg, void* pOtherParameters)
+{
+    const UBOOL bBMinus = fusion.IsFused(EOF_BMinus);
+    const UBOOL bDotSource = fusion.IsFused(EOF_DotSource);
+    const UBOOL bOnePass = (EFO_F_D == op || EFO_F_Ddagger == op || EFO_F_D_WithMass == op || EFO_F_Ddagger_WithMass == op);
+    const UBOOL bDDdagger = (EFO_F_DDdagger == op || EFO_F_DDdagger_WithMass == op);
+
+    //The last pass of DD does not see x, so <x, DD x> is not fused
+    if (CFieldFermionKSSU3::StaticClass() != GetClass()
+     || NULL == pGauge || EFT_GaugeSU3 != pGauge->GetFieldType()
+     || (bBMinus && (NULL == fusion.m_pB || EFT_FermionStaggeredSU3 != fusion.m_pB->GetFieldType()))
+     || (!bOnePass && !bDDdagger && EFO_F_DD != op && EFO_F_DD_WithMass != op)
+     || (bDotSource && !bOnePass && (!bDDdagger || bBMinus)))
+    {
+        return CFieldFermion::ApplyOperatorFused(op, pGauge, fusion, eCoeffType, fCoeffReal, fCoeffImg, pOtherParameters);
+    }
+
+    Real f2am = m_f2am;
+    if (EFO_F_D_WithMass == op || EFO_F_Ddagger_WithMass == op || EFO_F_DD_WithMass == op || EFO_F_DDdagger_WithMass == op)
+    {
+        f2am = (NULL == pOtherParameters) ? CCommonData::m_fShiftedMass : *((Real*)pOtherParameters);
+    }
+    const UBOOL bDagger = (EFO_F_Ddagger == op || EFO_F_Ddagger_WithMass == op || bDDdagger);
+
+    const CFieldGaugeSU3* pFieldSU3 = dynamic_cast<const CFieldGaugeSU3*>(pGauge);
+    const deviceSU3Vector* pB = bBMinus ? dynamic_cast<const CFieldFermionKSSU3*>(fusion.m_pB)->m_pDeviceData : NULL;
+#if !_CLG_DOUBLEFLOAT
+    cuDoubleComplex* pDot = bDotSource ? _D_ComplexThreadBuffer : NULL;
+    DOUBLE* pNorm = fusion.IsFused(EOF_Norm) ? _D_RealThreadBuffer : NULL;
+#else
+    CLGComplex* pDot = bDotSource ? _D_ComplexThreadBuffer : NULL;
+    Real* pNorm = fusion.IsFused(EOF_Norm) ? _D_RealThreadBuffer : NULL;
+#endif
+
+    Real fRealCoeff = fCoeffReal;
+    const CLGComplex cCompCoeff = _make_cuComplex(fCoeffReal, fCoeffImg);
+    if (EOCT_Minus == eCoeffType)
+    {
+        eCoeffType = EOCT_Real;
+        fRealCoeff = F(-1.0);
+    }
+    CFieldFermionKSSU3* pPooled = dynamic_cast<CFieldFermionKSSU3*>(appGetLattice()->GetPooledFieldById(m_byFieldId));
+
+    if (bOnePass)
+    {
+        checkCudaErrors(cudaMemcpy(pPooled->m_pDeviceData, m_pDeviceData, sizeof(deviceSU3Vector) * m_uiSiteCount, cudaMemcpyDeviceToDevice));
+        DOperatorKSFused(m_pDeviceData, pPooled->m_pDeviceData, pFieldSU3->m_pDeviceData, f2am,
+            bDagger, eCoeffType, fRealCoeff, cCompCoeff, pB, pDot, pNorm);
+        if (bDotSource)
+        {
+            fusion.m_cDot = appGetCudaHelper()->ThreadBufferSum(_D_ComplexThreadBuffer);
+        }
+    }
+    else
+    {
+        //<x, c D D^+ x> = c |D^+ x|^2, calculated in the first pass
+        DOperatorKSFused(pPooled->m_pDeviceData, m_pDeviceData, pFieldSU3->m_pDeviceData, f2am,
+            bDagger, EOCT_None, F(1.0), _make_cuComplex(F(1.0), F(0.0)),
+            NULL, NULL, bDotSource ? _D_RealThreadBuffer : NULL);
+        if (bDotSource)
+        {
+            fusion.SetDotByNorm(appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer), eCoeffType, fRealCoeff, cCompCoeff);
+        }
+        DOperatorKSFused(m_pDeviceData, pPooled->m_pDeviceData, pFieldSU3->m_pDeviceData, f2am,
+            FALSE, eCoeffType, fRealCoeff, cCompCoeff, pB, NULL, pNorm);
+    }
+
+    if (NULL != pNorm)
+    {
+        fusion.m_fNorm = appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
+    }
+    pPooled->Return();
+    return TRUE;
+}
+
 UBOOL CFieldFermionKSSU3::InverseD(const CField* pGauge)
 {
     if (NULL == pGauge || EFT_GaugeSU3 != pGauge->GetFieldType())
@@ -1767,6 +1729,7 @@ CCString CFieldFermionKSSU3::GetInfos(const CCString& tab) const
 void CFieldFermionKSSU3::PrepareForHMCOnlyRandomize()
 {
     preparethread;
+    appGetLattice()->m_pRandom->NextLaunch();
     _kernelInitialFermionKS << <block, threads >> > (
         m_pDeviceData,
         m_byFieldId,
@@ -36,6 +36,7 @@ public:
     void InitialFieldWithFile(const CCString&, EFieldFileType) override;
     void InitialWithByte(BYTE* byData) override;
     void InitialOtherParameters(CParameters& params) override;
+    void SetRationalApproximation(const TArray<Real>& md, const TArray<Real>& mc) override;
     void DebugPrintMe() const override;
 
     void Dagger() override;
@@ -47,6 +48,7 @@ public:
     void Axpy(const CLGComplex& a, const CField* x) override;
     void ScalarMultply(const CLGComplex& a) override;
     void ScalarMultply(Real a) override;
+    void LinearCombine(UINT uiCount, const CField* const* pFields, const CLGComplex* pCoeffs) override;
 #if !_CLG_DOUBLEFLOAT
     cuDoubleComplex Dot(const CField* other) const override;
 #else
@@ -63,6 +65,12 @@ public:
     void DdaggerWithMass(const CField* pGauge, Real fMass, EOperatorCoefficientType eCoeffType = EOCT_None, Real fCoeffReal = F(1.0), Real fCoeffImg = F(0.0)) override;
     void DDWithMass(const CField* pGauge, Real fMass, EOperatorCoefficientType eCoeffType = EOCT_None, Real fCoeffReal = F(1.0), Real fCoeffImg = F(0.0)) override;
     void DDdaggerWithMass(const CField* pGauge, Real fMass, EOperatorCoefficientType eCoeffType = EOCT_None, Real fCoeffReal = F(1.0), Real fCoeffImg = F(0.0)) override;
+
+    /**
+    * D, Ddagger, DD, DDdagger (and with mass) with the BLAS fused into the last pass
+    * The derived classes (with their own DOperatorKS) are not fused
+    */
+    UBOOL ApplyOperatorFused(EFieldOperator op, const CField* pGauge, SOperatorFusion& fusion, EOperatorCoefficientType eCoeffType = EOCT_None, Real fCoeffReal = F(1.0), Real fCoeffImg = F(0.0), void* pOtherParameters = NULL) override;
     UBOOL InverseD(const CField* pGauge) override;
     UBOOL InverseDdagger(const CField* pGauge) override;
     UBOOL InverseDD(const CField* pGauge) override;
@@ -118,6 +126,27 @@ public:
 
 protected:
 
+    /**
+    * Called with the gauge field before DOperatorKS in D, D^+ and DD^+,
+    * the improved fermions (for example asqtad) rebuild the smeared links here when the gauge field is changed
+    */
+    virtual void PrepareGauge(const CFieldGaugeSU3*) const {}
+
+    /**
+    * DOperatorKS with the BLAS in SOperatorFusion, pB, pDot and pNorm can be NULL
+    */
+    void DOperatorKSFused(void* pTargetBuffer, const void* pBuffer, const void* pGaugeBuffer, Real f2am,
+        UBOOL bDagger, EOperatorCoefficientType eOCT, Real fRealCoeff, const CLGComplex& cCmpCoeff,
+        const deviceSU3Vector* pB,
+#if !_CLG_DOUBLEFLOAT
+        cuDoubleComplex* pDot,
+        DOUBLE* pNorm
+#else
+        CLGComplex* pDot,
+        Real* pNorm
+#endif
+        ) const;
+
     static void Seperate(INT* full, INT iSep, INT* l, INT* r, BYTE& LL, BYTE& RL)
     {
         LL = static_cast<BYTE>(iSep);
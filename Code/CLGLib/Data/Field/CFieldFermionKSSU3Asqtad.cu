@@ -0,0 +1,636 @@
+//=============================================================================
+// FILENAME : CFieldFermionKSSU3Asqtad.cu
+//
+// DESCRIPTION:
+//
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#include "CLGLib_Private.h"
+
+__BEGIN_NAMESPACE
+
+__CLGIMPLEMENT_CLASS(CFieldFermionKSSU3Asqtad)
+
+#pragma region kernel
+
+/**
+ * Walk along the path, map to inside the lattice after every move
+ */
+static __device__ __inline__ UINT _deviceAsqtadWalk(
+    UINT uiSiteIndex, SSmallInt4 sSite4,
+    const INT* __restrict__ path, BYTE byLength, BYTE byFieldId)
+{
+    for (BYTE i = 0; i < byLength; ++i)
+    {
+        _deviceSmallInt4Offset(sSite4, path[i]);
+        uiSiteIndex = __idx->m_pDeviceIndexPositionToSIndex[byFieldId][__bi(sSite4)].m_uiSiteIndex;
+        sSite4 = __deviceSiteIndexToInt4(uiSiteIndex);
+    }
+    return uiSiteIndex;
+}
+
+/**
+ * W(n,mu) = sum _i c_i L_i(n), L_i is the path [mu * uiPathPerDir + i]
+ */
+__global__ void _CLG_LAUNCH_BOUND
+_kernelKSAsqtadSmearLink(
+    const deviceSU3* __restrict__ pGauge,
+    deviceSU3* pSmeared,
+    const INT* __restrict__ pPath,
+    const BYTE* __restrict__ pPathLength,
+    const Real* __restrict__ pPathCoefficient,
+    UINT uiPathPerDir,
+    BYTE byGaugeFieldId)
+{
+    intokernalInt4;
+
+    for (BYTE idir = 0; idir < _DC_Dir; ++idir)
+    {
+        deviceSU3 res = deviceSU3::makeSU3Zero();
+        for (UINT i = 0; i < uiPathPerDir; ++i)
+        {
+            const UINT uiPath = idir * uiPathPerDir + i;
+            if (F(0.0) != pPathCoefficient[uiPath])
+            {
+                deviceSU3 toAdd = _deviceLinkLong(pGauge, sSite4, pPathLength[uiPath], byGaugeFieldId,
+                    pPath + uiPath * CFieldFermionKSSU3Asqtad::_kAsqtadPathLength);
+                toAdd.MulReal(pPathCoefficient[uiPath]);
+                res.Add(toAdd);
+            }
+        }
+        pSmeared[_deviceGetLinkIndex(uiSiteIndex, idir)] = res;
+    }
+}
+
+/**
+ * Same as _kernelDFermionKST with SKSEtaEachSite, with fat link and Naik term
+ * Assuming periodic for gauge field
+ */
+__global__ void _CLG_LAUNCH_BOUND
+_kernelDFermionKSAsqtad(
+    const deviceSU3Vector* __restrict__ pDeviceData,
+    const deviceSU3* __restrict__ pFat,
+    const deviceSU3* __restrict__ pLong,
+    const SIndex* __restrict__ pFermionMove,
+    const BYTE* __restrict__ pEtaTable,
+    deviceSU3Vector* pResultData,
+    Real f2am,
+    BYTE byFieldId,
+    UBOOL bDDagger,
+    EOperatorCoefficientType eCoeff,
+    Real fCoeff,
+    CLGComplex cCoeff)
+{
+    intokernaldir;
+
+    deviceSU3Vector result = deviceSU3Vector::makeZeroSU3Vector();
+    pResultData[uiSiteIndex] = pDeviceData[uiSiteIndex];
+
+    //idir = mu
+    for (UINT idir = 0; idir < uiDir; ++idir)
+    {
+        //x, mu
+        const UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
+
+        const SIndex& x_p_mu_Fermion = pFermionMove[2 * linkIndex];
+        const SIndex& x_m_mu_Fermion = pFermionMove[2 * linkIndex + 1];
+        const SIndex& x_p_2mu_Fermion = pFermionMove[2 * _deviceGetLinkIndex(x_p_mu_Fermion.m_uiSiteIndex, idir)];
+        const SIndex& x_m_2mu_Fermion = pFermionMove[2 * _deviceGetLinkIndex(x_m_mu_Fermion.m_uiSiteIndex, idir) + 1];
+        const SIndex& x_p_3mu_Fermion = pFermionMove[2 * _deviceGetLinkIndex(x_p_2mu_Fermion.m_uiSiteIndex, idir)];
+        const SIndex& x_m_3mu_Fermion = pFermionMove[2 * _deviceGetLinkIndex(x_m_2mu_Fermion.m_uiSiteIndex, idir) + 1];
+
+        //the boundary sign of 3 moves
+        BYTE byOppositeP3 = 0;
+        BYTE byOppositeM3 = 0;
+        if (x_p_mu_Fermion.NeedToOpposite()) { ++byOppositeP3; }
+        if (x_p_2mu_Fermion.NeedToOpposite()) { ++byOppositeP3; }
+        if (x_p_3mu_Fermion.NeedToOpposite()) { ++byOppositeP3; }
+        if (x_m_mu_Fermion.NeedToOpposite()) { ++byOppositeM3; }
+        if (x_m_2mu_Fermion.NeedToOpposite()) { ++byOppositeM3; }
+        if (x_m_3mu_Fermion.NeedToOpposite()) { ++byOppositeM3; }
+
+        const Real eta_mu = (1 == ((pEtaTable[uiSiteIndex] >> idir) & 1)) ? F(-1.0) : F(1.0);
+        const Real eta_mu2 = (1 == ((pEtaTable[x_m_mu_Fermion.m_uiSiteIndex] >> idir) & 1)) ? F(-1.0) : F(1.0);
+        const Real eta_mu3 = (1 == ((pEtaTable[x_m_3mu_Fermion.m_uiSiteIndex] >> idir) & 1)) ? F(-1.0) : F(1.0);
+
+        //W(x,mu) phi(x+mu)
+        deviceSU3Vector u_phi_x_p_m = pFat[linkIndex].MulVector(pDeviceData[x_p_mu_Fermion.m_uiSiteIndex]);
+        u_phi_x_p_m.MulReal(x_p_mu_Fermion.NeedToOpposite() ? (F(-1.0) * eta_mu) : eta_mu);
+
+        //W^{dagger}(x-mu) phi(x-mu)
+        deviceSU3 x_m_mu_element = pFat[_deviceGetLinkIndex(x_m_mu_Fermion.m_uiSiteIndex, idir)];
+        x_m_mu_element.Dagger();
+        deviceSU3Vector u_dagger_phi_x_m_m = x_m_mu_element.MulVector(pDeviceData[x_m_mu_Fermion.m_uiSiteIndex]);
+        u_dagger_phi_x_m_m.MulReal(x_m_mu_Fermion.NeedToOpposite() ? (F(-1.0) * eta_mu2) : eta_mu2);
+        u_phi_x_p_m.Sub(u_dagger_phi_x_m_m);
+
+        //N(x,mu) phi(x+3mu)
+        deviceSU3Vector naik = pLong[linkIndex].MulVector(pDeviceData[x_p_3mu_Fermion.m_uiSiteIndex]);
+        naik.MulReal((byOppositeP3 & 1) ? (F(-1.0) * eta_mu) : eta_mu);
+        u_phi_x_p_m.Add(naik);
+
+        //N^{dagger}(x-3mu) phi(x-3mu)
+        x_m_mu_element = pLong[_deviceGetLinkIndex(x_m_3mu_Fermion.m_uiSiteIndex, idir)];
+        x_m_mu_element.Dagger();
+        naik = x_m_mu_element.MulVector(pDeviceData[x_m_3mu_Fermion.m_uiSiteIndex]);
+        naik.MulReal((byOppositeM3 & 1) ? (F(-1.0) * eta_mu3) : eta_mu3);
+        u_phi_x_p_m.Sub(naik);
+
+        result.Add(u_phi_x_p_m);
+    }
+
+    pResultData[uiSiteIndex].MulReal(f2am);
+    if (bDDagger)
+    {
+        pResultData[uiSiteIndex].Sub(result);
+    }
+    else
+    {
+        pResultData[uiSiteIndex].Add(result);
+    }
+
+    switch (eCoeff)
+    {
+    case EOCT_Real:
+        pResultData[uiSiteIndex].MulReal(fCoeff);
+        break;
+    case EOCT_Complex:
+        pResultData[uiSiteIndex].MulComp(cCoeff);
+        break;
+    }
+}
+
+/**
+ * Same as _kernelDFermionKSForceT, but the link is not multiplied
+ * The force of W(x,mu) is -Ta(W(x,mu) M(x,mu)), here we only calculate M(x,mu) of W and N
+ */
+__global__ void _CLG_LAUNCH_BOUND
+_kernelDFermionKSAsqtadForce(
+    const SIndex* __restrict__ pFermionMove,
+    const BYTE* __restrict__ pEtaTable,
+    const deviceSU3Vector* const* __restrict__ pFermionPointers,
+    const Real* __restrict__ pNumerators,
+    deviceSU3* pFatForce,
+    deviceSU3* pLongForce,
+    UINT uiRational,
+    BYTE byFieldId)
+{
+    intokernaldir;
+
+    //idir = mu
+    for (UINT idir = 0; idir < uiDir; ++idir)
+    {
+        const Real eta_mu = (1 == ((pEtaTable[uiSiteIndex] >> idir) & 1)) ? F(-1.0) : F(1.0);
+        const UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
+
+        const SIndex& x_p_mu_Fermion = pFermionMove[2 * linkIndex];
+        const SIndex& x_p_2mu_Fermion = pFermionMove[2 * _deviceGetLinkIndex(x_p_mu_Fermion.m_uiSiteIndex, idir)];
+        const SIndex& x_p_3mu_Fermion = pFermionMove[2 * _deviceGetLinkIndex(x_p_2mu_Fermion.m_uiSiteIndex, idir)];
+        BYTE byOppositeP3 = 0;
+        if (x_p_mu_Fermion.NeedToOpposite()) { ++byOppositeP3; }
+        if (x_p_2mu_Fermion.NeedToOpposite()) { ++byOppositeP3; }
+        if (x_p_3mu_Fermion.NeedToOpposite()) { ++byOppositeP3; }
+
+        const Real fFatSign = x_p_mu_Fermion.NeedToOpposite() ? (F(-1.0) * eta_mu) : eta_mu;
+        const Real fLongSign = (byOppositeP3 & 1) ? (F(-1.0) * eta_mu) : eta_mu;
+
+        deviceSU3 fatTerm = deviceSU3::makeSU3Zero();
+        deviceSU3 longTerm = deviceSU3::makeSU3Zero();
+        for (UINT uiR = 0; uiR < uiRational; ++uiR)
+        {
+            const deviceSU3Vector* phi_i = pFermionPointers[uiR];
+            const deviceSU3Vector* phi_id = pFermionPointers[uiR + uiRational];
+
+            //phi_i(x+mu) phi_id(x)^+ - phi_id(x+mu) phi_i(x)^+
+            deviceSU3 thisTerm = deviceSU3::makeSU3ContractV(phi_id[uiSiteIndex], phi_i[x_p_mu_Fermion.m_uiSiteIndex]);
+            thisTerm.Sub(deviceSU3::makeSU3ContractV(phi_i[uiSiteIndex], phi_id[x_p_mu_Fermion.m_uiSiteIndex]));
+            thisTerm.MulReal(fFatSign * pNumerators[uiR]);
+            fatTerm.Add(thisTerm);
+
+            thisTerm = deviceSU3::makeSU3ContractV(phi_id[uiSiteIndex], phi_i[x_p_3mu_Fermion.m_uiSiteIndex]);
+            thisTerm.Sub(deviceSU3::makeSU3ContractV(phi_i[uiSiteIndex], phi_id[x_p_3mu_Fermion.m_uiSiteIndex]));
+            thisTerm.MulReal(fLongSign * pNumerators[uiR]);
+            longTerm.Add(thisTerm);
+        }
+        pFatForce[linkIndex] = fatTerm;
+        pLongForce[linkIndex] = longTerm;
+    }
+}
+
+/**
+ * Chain rule of W(x,mu) = sum _i c_i L_i(x)
+ * For the link U(n) in L_i(x), L_i(x) = V(x,n) U(n) V(n+,y)
+ * the force is -c_i Ta(V(n,y) M(x,mu) V(x,n))
+ *
+ * Same as _kernelDFermionKSForce_WithLink, every site n only write the links start from n
+ */
+__global__ void _CLG_LAUNCH_BOUND
+_kernelKSAsqtadSmearForce(
+    const deviceSU3* __restrict__ pGauge,
+    const deviceSU3* __restrict__ pSmearedForce,
+    deviceSU3* pForce,
+    const INT* __restrict__ pPath,
+    const BYTE* __restrict__ pPathLength,
+    const Real* __restrict__ pPathCoefficient,
+    UINT uiPathPerDir,
+    BYTE byFieldId,
+    BYTE byGaugeFieldId)
+{
+    intokernalInt4;
+    INT pathLeft[CFieldFermionKSSU3Asqtad::_kAsqtadPathLength];
+    INT pathRight[CFieldFermionKSSU3Asqtad::_kAsqtadPathLength];
+
+    for (BYTE idir = 0; idir < _DC_Dir; ++idir)
+    {
+        for (UINT i = 0; i < uiPathPerDir; ++i)
+        {
+            const UINT uiPath = idir * uiPathPerDir + i;
+            const Real fCoefficient = pPathCoefficient[uiPath];
+            if (F(0.0) == fCoefficient)
+            {
+                continue;
+            }
+            const INT* path = pPath + uiPath * CFieldFermionKSSU3Asqtad::_kAsqtadPathLength;
+            const BYTE pathLength = pPathLength[uiPath];
+
+            for (BYTE iSeperation = 0; iSeperation <= pathLength; ++iSeperation)
+            {
+                BYTE LLength = 0;
+                BYTE RLength = 0;
+
+                _deviceSeperate(path, iSeperation, pathLength, pathLeft, pathRight, LLength, RLength);
+
+                const UBOOL bHasLeft = (LLength > 0) && (pathLeft[0] > 0);
+                const UBOOL bHasRight = (RLength > 0) && (pathRight[0] > 0);
+
+                if (bHasLeft || bHasRight)
+                {
+                    //x is the start of the path
+                    const UINT uiX = _deviceAsqtadWalk(uiSiteIndex, sSite4, pathLeft, LLength, byFieldId);
+                    const deviceSU3 vnn1 = _deviceLinkLong(pGauge, sSite4, LLength, byGaugeFieldId, pathLeft);
+                    deviceSU3 res = _deviceLinkLong(pGauge, sSite4, RLength, byGaugeFieldId, pathRight);
+                    res.Mul(pSmearedForce[_deviceGetLinkIndex(uiX, idir)]);
+                    res.MulDagger(vnn1);
+                    res.Ta();
+                    res.MulReal(fCoefficient);
+
+                    if (bHasLeft)
+                    {
+                        pForce[_deviceGetLinkIndex(uiSiteIndex, pathLeft[0] - 1)].Add(res);
+                    }
+
+                    if (bHasRight)
+                    {
+                        pForce[_deviceGetLinkIndex(uiSiteIndex, pathRight[0] - 1)].Sub(res);
+                    }
+                }
+            }
+        }
+    }
+}
+
+#pragma endregion
+
+#pragma region D and derivate
+
+void CFieldFermionKSSU3Asqtad::DOperatorKS(void* pTargetBuffer, const void* pBuffer,
+    const void* pGaugeBuffer, Real f2am,
+    UBOOL bDagger, EOperatorCoefficientType eOCT,
+    Real fRealCoeff, const CLGComplex& cCmpCoeff) const
+{
+    deviceSU3Vector* pTarget = (deviceSU3Vector*)pTargetBuffer;
+    const deviceSU3Vector* pSource = (const deviceSU3Vector*)pBuffer;
+    const deviceSU3* pFat = NULL;
+    const deviceSU3* pLong = NULL;
+    GetSmearedLinks(pGaugeBuffer, pFat, pLong);
+
+    preparethread;
+    _kernelDFermionKSAsqtad << <block, threads >> > (
+        pSource,
+        pFat,
+        pLong,
+        appGetLattice()->m_pIndexCache->m_pFermionMoveCache[m_byFieldId],
+        appGetLattice()->m_pIndexCache->m_pEtaMu,
+        pTarget,
+        f2am,
+        m_byFieldId,
+        bDagger,
+        eOCT,
+        fRealCoeff,
+        cCmpCoeff);
+}
+
+/**
+ * Make sure m_pMDNumerator and m_pRationalFieldPointers are filled
+ */
+void CFieldFermionKSSU3Asqtad::DerivateD0(
+    void* pForce,
+    const void* pGaugeBuffer) const
+{
+    deviceSU3* pFatForce = GetCachedLinks(CFieldCache::CachedFatLinkForceStart + m_byFieldId);
+    deviceSU3* pLongForce = GetCachedLinks(CFieldCache::CachedLongLinkForceStart + m_byFieldId);
+
+    preparethread;
+    _kernelDFermionKSAsqtadForce << <block, threads >> > (
+        appGetLattice()->m_pIndexCache->m_pFermionMoveCache[m_byFieldId],
+        appGetLattice()->m_pIndexCache->m_pEtaMu,
+        m_pRationalFieldPointers,
+        m_pMDNumerator,
+        pFatForce,
+        pLongForce,
+        m_rMD.m_uiDegree,
+        m_byFieldId);
+
+    _kernelKSAsqtadSmearForce << <block, threads >> > (
+        (const deviceSU3*)pGaugeBuffer,
+        pFatForce,
+        (deviceSU3*)pForce,
+        m_pDevicePath,
+        m_pDevicePathLength,
+        m_pDevicePathCoefficient,
+        _kFatPathPerDir,
+        m_byFieldId,
+        1);
+
+    if (F(0.0) != m_fNaik)
+    {
+        _kernelKSAsqtadSmearForce << <block, threads >> > (
+            (const deviceSU3*)pGaugeBuffer,
+            pLongForce,
+            (deviceSU3*)pForce,
+            m_pDevicePath + _kLongPathStart * _kAsqtadPathLength,
+            m_pDevicePathLength + _kLongPathStart,
+            m_pDevicePathCoefficient + _kLongPathStart,
+            1,
+            m_byFieldId,
+            1);
+    }
+}
+
+#pragma endregion
+
+#pragma region Smeared links
+
+deviceSU3* CFieldFermionKSSU3Asqtad::GetCachedLinks(UINT uiId) const
+{
+    CFieldCache* pCache = appGetLattice()->m_pFieldCache;
+    CFieldGaugeSU3* pField = dynamic_cast<CFieldGaugeSU3*>(pCache->GetCachedField(uiId));
+    if (NULL == pField)
+    {
+        pField = dynamic_cast<CFieldGaugeSU3*>(appGetLattice()->m_pGaugeField->GetCopy());
+        if (NULL == pField)
+        {
+            appCrucial(_T("CFieldFermionKSSU3Asqtad only support CFieldGaugeSU3!\n"));
+            return NULL;
+        }
+        pCache->CacheField(uiId, pField);
+    }
+    return pField->m_pDeviceData;
+}
+
+void CFieldFermionKSSU3Asqtad::SmearLinks(const void* pGaugeBuffer) const
+{
+    preparethread;
+    _kernelKSAsqtadSmearLink << <block, threads >> > (
+        (const deviceSU3*)pGaugeBuffer,
+        GetCachedLinks(CFieldCache::CachedFatLinkFieldStart + m_byFieldId),
+        m_pDevicePath,
+        m_pDevicePathLength,
+        m_pDevicePathCoefficient,
+        _kFatPathPerDir,
+        1);
+
+    _kernelKSAsqtadSmearLink << <block, threads >> > (
+        (const deviceSU3*)pGaugeBuffer,
+        GetCachedLinks(CFieldCache::CachedLongLinkFieldStart + m_byFieldId),
+        m_pDevicePath + _kLongPathStart * _kAsqtadPathLength,
+        m_pDevicePathLength + _kLongPathStart,
+        m_pDevicePathCoefficient + _kLongPathStart,
+        1,
+        1);
+}
+
+void CFieldFermionKSSU3Asqtad::PrepareGauge(const CFieldGaugeSU3* pGauge) const
+{
+    const UINT uiFatId = CFieldCache::CachedFatLinkFieldStart + m_byFieldId;
+    CFieldCache* pCache = appGetLattice()->m_pFieldCache;
+    if (!pCache->IsCachedFieldValid(uiFatId, pGauge, pGauge->GetVersion()))
+    {
+        SmearLinks(pGauge->m_pDeviceData);
+        pCache->SetCachedFieldGauge(uiFatId, pGauge, pGauge->GetVersion(), pGauge->m_pDeviceData);
+    }
+}
+
+void CFieldFermionKSSU3Asqtad::GetSmearedLinks(const void* pGaugeBuffer, const deviceSU3*& pFat, const deviceSU3*& pLong) const
+{
+    const UINT uiFatId = CFieldCache::CachedFatLinkFieldStart + m_byFieldId;
+    CFieldCache* pCache = appGetLattice()->m_pFieldCache;
+    if (!pCache->IsCachedFieldValid(uiFatId, pGaugeBuffer))
+    {
+        //Only the buffer is known, the version can not be checked, so it is not cached
+        SmearLinks(pGaugeBuffer);
+        pCache->SetCachedFieldGauge(uiFatId, NULL, 0, pGaugeBuffer);
+    }
+
+    pFat = GetCachedLinks(uiFatId);
+    pLong = GetCachedLinks(CFieldCache::CachedLongLinkFieldStart + m_byFieldId);
+}
+
+static void _AsqtadAddPath(INT* pPath, BYTE* pLength, Real* pCoefficient, UINT& uiIdx,
+    const INT* path, BYTE byLength, Real fCoefficient, Real fU0)
+{
+    Real fTadpole = F(1.0);
+    UBOOL bInLattice = TRUE;
+    for (BYTE i = 0; i < byLength; ++i)
+    {
+        pPath[uiIdx * CFieldFermionKSSU3Asqtad::_kAsqtadPathLength + i] = path[i];
+        if (i > 0)
+        {
+            fTadpole = fTadpole * fU0;
+        }
+        if (abs(path[i]) > static_cast<INT>(_HC_Dir))
+        {
+            bInLattice = FALSE;
+        }
+    }
+    pLength[uiIdx] = byLength;
+    //the paths with a direction not in the lattice are skipped by the kernels
+    pCoefficient[uiIdx] = bInLattice ? (fCoefficient / fTadpole) : F(0.0);
+    ++uiIdx;
+}
+
+void CFieldFermionKSSU3Asqtad::BuildPathTable()
+{
+    INT path[_kPathCount * _kAsqtadPathLength];
+    BYTE length[_kPathCount];
+    Real coefficient[_kPathCount];
+    memset(path, 0, sizeof(INT) * _kPathCount * _kAsqtadPathLength);
+
+    const INT sign[2] = { 1, -1 };
+    for (INT mu = 0; mu < 4; ++mu)
+    {
+        const INT d = mu + 1;
+        UINT uiIdx = mu * _kFatPathPerDir;
+
+        const INT onelink[1] = { d };
+        _AsqtadAddPath(path, length, coefficient, uiIdx, onelink, 1, m_fOneLink, m_fTadpoleU0);
+
+        for (INT nu = 0; nu < 4; ++nu)
+        {
+            if (nu == mu)
+            {
+                continue;
+            }
+            for (INT sn = 0; sn < 2; ++sn)
+            {
+                const INT n = sign[sn] * (nu + 1);
+                const INT staple3[3] = { n, d, -n };
+                _AsqtadAddPath(path, length, coefficient, uiIdx, staple3, 3, m_fThreeStaple, m_fTadpoleU0);
+                const INT lepage[5] = { n, n, d, -n, -n };
+                _AsqtadAddPath(path, length, coefficient, uiIdx, lepage, 5, m_fLepage, m_fTadpoleU0);
+
+                for (INT rho = 0; rho < 4; ++rho)
+                {
+                    if (rho == mu || rho == nu)
+                    {
+                        continue;
+                    }
+                    for (INT sr = 0; sr < 2; ++sr)
+                    {
+                        const INT r = sign[sr] * (rho + 1);
+                        const INT staple5[5] = { n, r, d, -r, -n };
+                        _AsqtadAddPath(path, length, coefficient, uiIdx, staple5, 5, m_fFiveStaple, m_fTadpoleU0);
+
+                        for (INT sigma = 0; sigma < 4; ++sigma)
+                        {
+                            if (sigma == mu || sigma == nu || sigma == rho)
+                            {
+                                continue;
+                            }
+                            for (INT ss = 0; ss < 2; ++ss)
+                            {
+                                const INT s = sign[ss] * (sigma + 1);
+                                const INT staple7[7] = { n, r, s, d, -s, -r, -n };
+                                _AsqtadAddPath(path, length, coefficient, uiIdx, staple7, 7, m_fSevenStaple, m_fTadpoleU0);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        assert(uiIdx == static_cast<UINT>((mu + 1) * _kFatPathPerDir));
+
+        uiIdx = _kLongPathStart + mu;
+        const INT naik[3] = { d, d, d };
+        _AsqtadAddPath(path, length, coefficient, uiIdx, naik, 3, m_fNaik, m_fTadpoleU0);
+    }
+
+    checkCudaErrors(cudaMemcpy(m_pDevicePath, path, sizeof(INT) * _kPathCount * _kAsqtadPathLength, cudaMemcpyHostToDevice));
+    checkCudaErrors(cudaMemcpy(m_pDevicePathLength, length, sizeof(BYTE) * _kPathCount, cudaMemcpyHostToDevice));
+    checkCudaErrors(cudaMemcpy(m_pDevicePathCoefficient, coefficient, sizeof(Real) * _kPathCount, cudaMemcpyHostToDevice));
+
+    //the coefficients are changed
+    if (NULL != appGetLattice() && NULL != appGetLattice()->m_pFieldCache)
+    {
+        appGetLattice()->m_pFieldCache->InvalidateCachedField(CFieldCache::CachedFatLinkFieldStart + m_byFieldId);
+    }
+}
+
+#pragma endregion
+
+/**
+ * The default is the tree level asqtad, the fat link is 9/8 and Naik is -1/24 for free field
+ */
+CFieldFermionKSSU3Asqtad::CFieldFermionKSSU3Asqtad()
+    : CFieldFermionKSSU3()
+    , m_fOneLink(F(0.625))
+    , m_fThreeStaple(F(0.0625))
+    , m_fFiveStaple(F(0.015625))
+    , m_fSevenStaple(F(1.0) / F(384.0))
+    , m_fLepage(F(-0.0625))
+    , m_fNaik(F(-1.0) / F(24.0))
+    , m_fTadpoleU0(F(1.0))
+    , m_pDevicePath(NULL)
+    , m_pDevicePathLength(NULL)
+    , m_pDevicePathCoefficient(NULL)
+{
+    checkCudaErrors(cudaMalloc((void**)&m_pDevicePath, sizeof(INT) * _kPathCount * _kAsqtadPathLength));
+    checkCudaErrors(cudaMalloc((void**)&m_pDevicePathLength, sizeof(BYTE) * _kPathCount));
+    checkCudaErrors(cudaMalloc((void**)&m_pDevicePathCoefficient, sizeof(Real) * _kPathCount));
+    BuildPathTable();
+}
+
+CFieldFermionKSSU3Asqtad::~CFieldFermionKSSU3Asqtad()
+{
+    checkCudaErrors(cudaFree(m_pDevicePath));
+    checkCudaErrors(cudaFree(m_pDevicePathLength));
+    checkCudaErrors(cudaFree(m_pDevicePathCoefficient));
+}
+
+void CFieldFermionKSSU3Asqtad::InitialOtherParameters(CParameters& params)
+{
+    CFieldFermionKSSU3::InitialOtherParameters(params);
+    m_bEachSiteEta = TRUE;
+
+    params.FetchValueReal(_T("OneLink"), m_fOneLink);
+    params.FetchValueReal(_T("ThreeStaple"), m_fThreeStaple);
+    params.FetchValueReal(_T("FiveStaple"), m_fFiveStaple);
+    params.FetchValueReal(_T("SevenStaple"), m_fSevenStaple);
+    params.FetchValueReal(_T("Lepage"), m_fLepage);
+    params.FetchValueReal(_T("Naik"), m_fNaik);
+    params.FetchValueReal(_T("TadpoleU0"), m_fTadpoleU0);
+    BuildPathTable();
+}
+
+void CFieldFermionKSSU3Asqtad::CopyTo(CField* U) const
+{
+    CFieldFermionKSSU3::CopyTo(U);
+    CFieldFermionKSSU3Asqtad* pField = dynamic_cast<CFieldFermionKSSU3Asqtad*>(U);
+    if (NULL != pField)
+    {
+        const UBOOL bChanged = (pField->m_fOneLink != m_fOneLink)
+            || (pField->m_fThreeStaple != m_fThreeStaple)
+            || (pField->m_fFiveStaple != m_fFiveStaple)
+            || (pField->m_fSevenStaple != m_fSevenStaple)
+            || (pField->m_fLepage != m_fLepage)
+            || (pField->m_fNaik != m_fNaik)
+            || (pField->m_fTadpoleU0 != m_fTadpoleU0);
+        pField->m_fOneLink = m_fOneLink;
+        pField->m_fThreeStaple = m_fThreeStaple;
+        pField->m_fFiveStaple = m_fFiveStaple;
+        pField->m_fSevenStaple = m_fSevenStaple;
+        pField->m_fLepage = m_fLepage;
+        pField->m_fNaik = m_fNaik;
+        pField->m_fTadpoleU0 = m_fTadpoleU0;
+        if (bChanged)
+        {
+            pField->BuildPathTable();
+        }
+    }
+}
+
+CCString CFieldFermionKSSU3Asqtad::GetInfos(const CCString& tab) const
+{
+    CCString sRet = tab + _T("Name : CFieldFermionKSSU3Asqtad\n");
+    sRet = sRet + tab + _T("Mass (2am) : ") + appFloatToString(m_f2am) + _T("\n");
+    sRet = sRet + tab + _T("MD Rational (c) : ") + appFloatToString(m_rMD.m_fC) + _T("\n");
+    sRet = sRet + tab + _T("MC Rational (c) : ") + appFloatToString(m_rMC.m_fC) + _T("\n");
+    sRet = sRet + tab + _T("OneLink : ") + appFloatToString(m_fOneLink) + _T("\n");
+    sRet = sRet + tab + _T("ThreeStaple : ") + appFloatToString(m_fThreeStaple) + _T("\n");
+    sRet = sRet + tab + _T("FiveStaple : ") + appFloatToString(m_fFiveStaple) + _T("\n");
+    sRet = sRet + tab + _T("SevenStaple : ") + appFloatToString(m_fSevenStaple) + _T("\n");
+    sRet = sRet + tab + _T("Lepage : ") + appFloatToString(m_fLepage) + _T("\n");
+    sRet = sRet + tab + _T("Naik : ") + appFloatToString(m_fNaik) + _T("\n");
+    sRet = sRet + tab + _T("TadpoleU0 : ") + appFloatToString(m_fTadpoleU0) + _T("\n");
+    return sRet;
+}
+
+__END_NAMESPACE
+
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
@@ -0,0 +1,101 @@
+//=============================================================================
+// FILENAME : CFieldFermionKSSU3Asqtad.h
+//
+// DESCRIPTION:
+// The asqtad improved staggered fermion
+//
+// D = 2am + sum _mu eta _mu(n) [W(n,mu) phi(n+mu) - W^+(n-mu,mu) phi(n-mu)]
+//           + sum _mu eta _mu(n) [N(n,mu) phi(n+3mu) - N^+(n-3mu,mu) phi(n-3mu)]
+//
+// W is the fat link: one link, 3-staple, 5-staple, 7-staple and Lepage
+// N is the Naik link: U(n,mu)U(n+mu,mu)U(n+2mu,mu)
+//
+// The smeared links are calculated once per gauge field (see CFieldCache),
+// and every application of D only reads W and N.
+// With the coefficients, it can also be fat7 (Lepage = Naik = 0).
+// The reunitarization of HISQ is not implemented.
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#ifndef _CFIELDFERMIONKSSU3ASQTAD_H_
+#define _CFIELDFERMIONKSSU3ASQTAD_H_
+
+__BEGIN_NAMESPACE
+
+__CLG_REGISTER_HELPER_HEADER(CFieldFermionKSSU3Asqtad)
+
+class CLGAPI CFieldFermionKSSU3Asqtad : public CFieldFermionKSSU3
+{
+    __CLGDECLARE_FIELD(CFieldFermionKSSU3Asqtad)
+
+public:
+
+    enum
+    {
+        _kAsqtadPathLength = 7,
+        //1 + 6 (3-staple) + 6 (Lepage) + 24 (5-staple) + 48 (7-staple)
+        _kFatPathPerDir = 85,
+        _kLongPathStart = 4 * _kFatPathPerDir,
+        _kPathCount = _kLongPathStart + 4,
+    };
+
+    CFieldFermionKSSU3Asqtad();
+    ~CFieldFermionKSSU3Asqtad();
+    void DerivateD0(void* pForce, const void* pGaugeBuffer) const override;
+    void DOperatorKS(void* pTargetBuffer, const void* pBuffer, const void* pGaugeBuffer, Real f2am,
+        UBOOL bDagger, EOperatorCoefficientType eOCT, Real fRealCoeff, const CLGComplex& cCmpCoeff) const override;
+
+    void InitialOtherParameters(CParameters& params) override;
+    CCString GetInfos(const CCString& tab) const override;
+
+    Real m_fOneLink;
+    Real m_fThreeStaple;
+    Real m_fFiveStaple;
+    Real m_fSevenStaple;
+    Real m_fLepage;
+    Real m_fNaik;
+    Real m_fTadpoleU0;
+
+protected:
+
+    /**
+    * Fill the path table with the coefficients (tadpole factor included)
+    * path of [mu * _kFatPathPerDir + i] is the i-th path of W(n,mu)
+    * path of [_kLongPathStart + mu] is N(n,mu)
+    */
+    void BuildPathTable();
+
+    /**
+    * The fields are in appGetLattice()->m_pFieldCache, created when first used
+    */
+    deviceSU3* GetCachedLinks(UINT uiId) const;
+
+    /**
+    * Calculate W and N of the gauge buffer
+    */
+    void SmearLinks(const void* pGaugeBuffer) const;
+
+    /**
+    * Rebuild W and N if the gauge field or its version (see CFieldGauge::GetVersion) is changed
+    */
+    void PrepareGauge(const CFieldGaugeSU3* pGauge) const override;
+
+    /**
+    * W and N of the gauge field in PrepareGauge, or rebuild W and N if it is another gauge buffer
+    */
+    void GetSmearedLinks(const void* pGaugeBuffer, const deviceSU3*& pFat, const deviceSU3*& pLong) const;
+
+    INT* m_pDevicePath;
+    BYTE* m_pDevicePathLength;
+    Real* m_pDevicePathCoefficient;
+};
+
+__END_NAMESPACE
+
+#endif //#ifndef _CFIELDFERMIONKSSU3ASQTAD_H_
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
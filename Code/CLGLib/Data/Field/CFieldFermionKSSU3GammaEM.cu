@@ -14,272 +14,6 @@ __BEGIN_NAMESPACE
 
 __CLGIMPLEMENT_CLASS(CFieldFermionKSSU3GammaEM)
 
-#pragma region normal kernels
-
-/**
-* Dks = 2am + \sum _{\mu} \eta_{\mu} (n) (U_{\mu}(n) \delta _{n,n+\mu} -U^+_{\mu}(n-\mu) \delta _{n,n-\mu})
-* U act on su3
-* gamma act on spinor
-*
-* If bDagger, it is just \eta 5(n) Dks \eta _5(n)
-* A easier way is D_{ks}(m=0) is anti-Hermitian, so D^+ = - D_{ks,m=0} + 2am
-*
-*/
-__global__ void _CLG_LAUNCH_BOUND
-_kernelDFermionKSEMField(
-    const deviceSU3Vector* __restrict__ pDeviceData,
-    const deviceSU3* __restrict__ pGauge,
-    const Real* __restrict__ pU1,
-    const SIndex* __restrict__ pGaugeMove,
-    const SIndex* __restrict__ pFermionMove,
-    const BYTE* __restrict__ pEtaTable,
-    deviceSU3Vector* pResultData,
-    Real f2am,
-    Real fCharge,
-    BYTE byFieldId,
-    UBOOL bDDagger,
-    EOperatorCoefficientType eCoeff,
-    Real fCoeff,
-    CLGComplex cCoeff)
-{
-    intokernaldir;
-
-    deviceSU3Vector result = deviceSU3Vector::makeZeroSU3Vector();
-    pResultData[uiSiteIndex] = pDeviceData[uiSiteIndex];
-
-    //idir = mu
-    for (UINT idir = 0; idir < uiDir; ++idir)
-    {
-        //Get Gamma mu
-        const Real eta_mu = (1 == ((pEtaTable[uiSiteIndex] >> idir) & 1)) ? F(-1.0) : F(1.0);
-
-        //x, mu
-        const UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
-
-        const SIndex& x_m_mu_Gauge = pGaugeMove[linkIndex];
-
-        const SIndex& x_p_mu_Fermion = pFermionMove[2 * linkIndex];
-        const SIndex& x_m_mu_Fermion = pFermionMove[2 * linkIndex + 1];
-
-        //Assuming periodic
-        //get U(x,mu), U^{dagger}(x-mu), 
-        deviceSU3 x_Gauge_element = pGauge[linkIndex];
-        const Real fPhaseForward = pU1[linkIndex] * fCharge;
-        x_Gauge_element.MulComp(_make_cuComplex(_cos(fPhaseForward), _sin(fPhaseForward)));
-        const UINT linkBackward = _deviceGetLinkIndex(x_m_mu_Gauge.m_uiSiteIndex, idir);
-        deviceSU3 x_m_mu_Gauge_element = pGauge[linkBackward];
-        const Real fPhaseBackward = pU1[linkBackward] * fCharge;
-        x_m_mu_Gauge_element.MulComp(_make_cuComplex(_cos(fPhaseBackward), _sin(fPhaseBackward)));
-
-        if (x_m_mu_Gauge.NeedToDagger())
-        {
-            x_m_mu_Gauge_element.Dagger();
-        }
-
-        //U(x,mu) phi(x+ mu)
-        deviceSU3Vector u_phi_x_p_m = x_Gauge_element.MulVector(pDeviceData[x_p_mu_Fermion.m_uiSiteIndex]);
-        if (x_p_mu_Fermion.NeedToOpposite())
-        {
-            u_phi_x_p_m.MulReal(F(-1.0));
-        }
-
-        //U^{dagger}(x-mu) phi(x-mu)
-        deviceSU3Vector u_dagger_phi_x_m_m = x_m_mu_Gauge_element.MulVector(pDeviceData[x_m_mu_Fermion.m_uiSiteIndex]);
-        if (x_m_mu_Fermion.NeedToOpposite())
-        {
-            u_phi_x_p_m.Add(u_dagger_phi_x_m_m);
-        }
-        else
-        {
-            u_phi_x_p_m.Sub(u_dagger_phi_x_m_m);
-        }
-        u_phi_x_p_m.MulReal(eta_mu);
-        result.Add(u_phi_x_p_m);
-    }
-
-    pResultData[uiSiteIndex].MulReal(f2am);
-    if (bDDagger)
-    {
-        pResultData[uiSiteIndex].Sub(result);
-    }
-    else
-    {
-        pResultData[uiSiteIndex].Add(result);
-    }
-
-    switch (eCoeff)
-    {
-    case EOCT_Real:
-        pResultData[uiSiteIndex].MulReal(fCoeff);
-        break;
-    case EOCT_Complex:
-        pResultData[uiSiteIndex].MulComp(cCoeff);
-        break;
-    }
-}
-
-/**
- * For some strange boundary condition
- */
-__global__ void _CLG_LAUNCH_BOUND
-_kernelDFermionKSPlusEtaEMField(
-    const deviceSU3Vector* __restrict__ pDeviceData,
-    const deviceSU3* __restrict__ pGauge,
-    const Real* __restrict__ pU1,
-    const SIndex* __restrict__ pGaugeMove,
-    const SIndex* __restrict__ pFermionMove,
-    const BYTE* __restrict__ pEtaTable,
-    deviceSU3Vector* pResultData,
-    Real f2am,
-    Real fCharge,
-    BYTE byFieldId,
-    UBOOL bDDagger,
-    EOperatorCoefficientType eCoeff,
-    Real fCoeff,
-    CLGComplex cCoeff)
-{
-    intokernaldir;
-
-    deviceSU3Vector result = deviceSU3Vector::makeZeroSU3Vector();
-    pResultData[uiSiteIndex] = pDeviceData[uiSiteIndex];
-
-    //idir = mu
-    for (UINT idir = 0; idir < uiDir; ++idir)
-    {
-        //x, mu
-        const UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
-
-        const SIndex& x_m_mu_Gauge = pGaugeMove[linkIndex];
-
-        const SIndex& x_p_mu_Fermion = pFermionMove[2 * linkIndex];
-        const SIndex& x_m_mu_Fermion = pFermionMove[2 * linkIndex + 1];
-
-        //This is in fact, -1 * eta(n + mu)
-        const Real eta_mu = (1 == ((pEtaTable[uiSiteIndex] >> idir) & 1)) ? F(-1.0) : F(1.0);
-        const Real eta_mu2 = (1 == ((pEtaTable[x_m_mu_Fermion.m_uiSiteIndex] >> idir) & 1)) ? F(-1.0) : F(1.0);
-
-        //Assuming periodic
-        //get U(x,mu), U^{dagger}(x-mu), 
-        deviceSU3 x_Gauge_element = pGauge[linkIndex];
-        const Real fPhaseForward = pU1[linkIndex] * fCharge;
-        x_Gauge_element.MulComp(_make_cuComplex(_cos(fPhaseForward), _sin(fPhaseForward)));
-        const UINT linkBackward = _deviceGetLinkIndex(x_m_mu_Gauge.m_uiSiteIndex, idir);
-        deviceSU3 x_m_mu_Gauge_element = pGauge[linkBackward];
-        const Real fPhaseBackward = pU1[linkBackward] * fCharge;
-        x_m_mu_Gauge_element.MulComp(_make_cuComplex(_cos(fPhaseBackward), _sin(fPhaseBackward)));
-
-        if (x_m_mu_Gauge.NeedToDagger())
-        {
-            x_m_mu_Gauge_element.Dagger();
-        }
-
-        //U(x,mu) phi(x+ mu)
-        deviceSU3Vector u_phi_x_p_m = x_Gauge_element.MulVector(pDeviceData[x_p_mu_Fermion.m_uiSiteIndex]);
-        if (x_p_mu_Fermion.NeedToOpposite())
-        {
-            u_phi_x_p_m.MulReal(F(-1.0) * eta_mu);
-        }
-        else
-        {
-            u_phi_x_p_m.MulReal(eta_mu);
-        }
-
-        //U^{dagger}(x-mu) phi(x-mu)
-        deviceSU3Vector u_dagger_phi_x_m_m = x_m_mu_Gauge_element.MulVector(pDeviceData[x_m_mu_Fermion.m_uiSiteIndex]);
-        u_dagger_phi_x_m_m.MulReal(eta_mu2);
-        if (x_m_mu_Fermion.NeedToOpposite())
-        {
-            u_phi_x_p_m.Add(u_dagger_phi_x_m_m);
-        }
-        else
-        {
-            u_phi_x_p_m.Sub(u_dagger_phi_x_m_m);
-        }
-        //u_phi_x_p_m.MulReal(eta_mu);
-        result.Add(u_phi_x_p_m);
-    }
-
-    pResultData[uiSiteIndex].MulReal(f2am);
-    if (bDDagger)
-    {
-        pResultData[uiSiteIndex].Sub(result);
-    }
-    else
-    {
-        pResultData[uiSiteIndex].Add(result);
-    }
-
-    switch (eCoeff)
-    {
-    case EOCT_Real:
-        pResultData[uiSiteIndex].MulReal(fCoeff);
-        break;
-    case EOCT_Complex:
-        pResultData[uiSiteIndex].MulComp(cCoeff);
-        break;
-    }
-}
-
-/**
- * Calculate Force
- */
-__global__ void _CLG_LAUNCH_BOUND
-_kernelDFermionKSForceEMField(
-    const deviceSU3* __restrict__ pGauge,
-    const Real* __restrict__ pU1,
-    deviceSU3* pForce,
-    const SIndex* __restrict__ pFermionMove,
-    const BYTE* __restrict__ pEtaTable,
-    const deviceSU3Vector* const* __restrict__ pFermionPointers,
-    const Real* __restrict__ pNumerators,
-    UINT uiRational,
-    Real fCharge,
-    BYTE byFieldId)
-{
-    intokernaldir;
-
-    //idir = mu
-    for (UINT idir = 0; idir < uiDir; ++idir)
-    {
-        //Get Gamma mu
-        const Real eta_mu = (1 == ((pEtaTable[uiSiteIndex] >> idir) & 1)) ? F(-1.0) : F(1.0);
-        //x, mu
-        const UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
-
-        const SIndex& x_p_mu_Fermion = pFermionMove[2 * linkIndex];
-
-        for (UINT uiR = 0; uiR < uiRational; ++uiR)
-        {
-            const deviceSU3Vector* phi_i = pFermionPointers[uiR];
-            const deviceSU3Vector* phi_id = pFermionPointers[uiR + uiRational];
-            deviceSU3 gauge = pGauge[linkIndex];
-            Real fPhase = pU1[linkIndex] * fCharge;
-            gauge.MulComp(_make_cuComplex(_cos(fPhase), _sin(fPhase)));
-
-            deviceSU3Vector toContract = gauge.MulVector(phi_i[x_p_mu_Fermion.m_uiSiteIndex]);
-            deviceSU3 thisTerm = deviceSU3::makeSU3ContractV(phi_id[uiSiteIndex], toContract);
-
-            toContract = gauge.MulVector(phi_id[x_p_mu_Fermion.m_uiSiteIndex]);
-            thisTerm.Add(deviceSU3::makeSU3ContractV(toContract, phi_i[uiSiteIndex]));
-
-            if (x_p_mu_Fermion.NeedToOpposite())
-            {
-                thisTerm.MulReal(eta_mu * pNumerators[uiR] * F(-1.0));
-            }
-            else
-            {
-                thisTerm.MulReal(eta_mu * pNumerators[uiR]);
-            }
-
-            thisTerm.Ta();
-            pForce[linkIndex].Sub(thisTerm);
-        }
-    }
-
-}
-
-#pragma endregion
-
 #pragma region gamma kernels
 
 /**
@@ -1668,45 +1402,57 @@ void CFieldFermionKSSU3GammaEM::DOperatorEM(
     Real fRealCoeff,
     CLGComplex cCmpCoeff,
     BYTE byFieldID,
+    BYTE byGaugeFieldID,
     BYTE byGaugeFieldID)
 {
-    preparethread;
+    SKSPhaseU1Real phase;
+    phase.m_pU1 = (const Real*)pEMFieldBuffer;
+    phase.m_fCharge = fCharge;
 
+    preparethread;
     if (bShiftCenter)
     {
-        _kernelDFermionKSPlusEtaEMField << <block, threads >> > (
-            (const deviceSU3Vector*)pBuffer,
-            (const deviceSU3*)pGaugeBuffer,
-            (const Real*)pEMFieldBuffer,
+        const SKSStencilCache<SKSEtaEachSite> stencil = {
             appGetLattice()->m_pIndexCache->m_pGaugeMoveCache[byFieldID],
             appGetLattice()->m_pIndexCache->m_pFermionMoveCache[byFieldID],
-            appGetLattice()->m_pIndexCache->m_pEtaMu,
+            appGetLattice()->m_pIndexCache->m_pEtaMu };
+        _kernelDFermionKST<SKSGroupSU3, SKSStencilCache<SKSEtaEachSite>, SKSPhaseU1Real> << <block, threads >> > (
+            (const deviceSU3Vector*)pBuffer,
+            (const deviceSU3*)pGaugeBuffer,
             (deviceSU3Vector*)pTargetBuffer,
             f2am,
-            fCharge,
-            byFieldID,
             bDagger,
             eOCT,
             fRealCoeff,
-            cCmpCoeff);
+            cCmpCoeff,
+            stencil,
+            phase,
+            SXPlaneRange::All(),
+            NULL,
+            NULL,
+            NULL);
     }
     else
     {
-        _kernelDFermionKSEMField << <block, threads >> > (
-            (const deviceSU3Vector*)pBuffer,
-            (const deviceSU3*)pGaugeBuffer,
-            (const Real*)pEMFieldBuffer,
+        const SKSStencilCache<SKSEtaSite> stencil = {
             appGetLattice()->m_pIndexCache->m_pGaugeMoveCache[byFieldID],
             appGetLattice()->m_pIndexCache->m_pFermionMoveCache[byFieldID],
-            appGetLattice()->m_pIndexCache->m_pEtaMu,
+            appGetLattice()->m_pIndexCache->m_pEtaMu };
+        _kernelDFermionKST<SKSGroupSU3, SKSStencilCache<SKSEtaSite>, SKSPhaseU1Real> << <block, threads >> > (
+            (const deviceSU3Vector*)pBuffer,
+            (const deviceSU3*)pGaugeBuffer,
             (deviceSU3Vector*)pTargetBuffer,
             f2am,
-            fCharge,
-            byFieldID,
             bDagger,
             eOCT,
             fRealCoeff,
-            cCmpCoeff);
+            cCmpCoeff,
+            stencil,
+            phase,
+            SXPlaneRange::All(),
+            NULL,
+            NULL,
+            NULL);
     }
 }
 
@@ -1720,18 +1466,23 @@ void CFieldFermionKSSU3GammaEM::KSForceEM(
     UINT uiRationalDegree,
     BYTE byFieldID)
 {
+    SKSPhaseU1Real phase;
+    phase.m_pU1 = (const Real*)pEMFieldBuffer;
+    phase.m_fCharge = fCharge;
+
+    const SKSStencilCache<SKSEtaSite> stencil = {
+        appGetLattice()->m_pIndexCache->m_pGaugeMoveCache[byFieldID],
+        appGetLattice()->m_pIndexCache->m_pFermionMoveCache[byFieldID],
+        appGetLattice()->m_pIndexCache->m_pEtaMu };
     preparethread;
-    _kernelDFermionKSForceEMField << <block, threads >> > (
+    _kernelDFermionKSForceT<SKSGroupSU3, SKSStencilCache<SKSEtaSite>, SKSPhaseU1Real> << <block, threads >> > (
         (const deviceSU3*)pGaugeBuffer,
-        (const Real*)pEMFieldBuffer,
         (deviceSU3*)pForce,
-        appGetLattice()->m_pIndexCache->m_pFermionMoveCache[byFieldID],
-        appGetLattice()->m_pIndexCache->m_pEtaMu,
         pRationalFields,
         pRationalNumerator,
         uiRationalDegree,
-        fCharge,
-        byFieldID);
+        stencil,
+        phase);
 }
 
 #pragma region DOperator
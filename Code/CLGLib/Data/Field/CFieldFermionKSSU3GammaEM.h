@@ -76,6 +76,9 @@ public:
         BYTE byFieldID,
         BYTE byGaugeFieldID);
 
+    /**
+     * _kernelDFermionKST with SKSPhaseU1Real
+     */
     static void DOperatorEM(
         void* pTargetBuffer,
         const void* pBuffer,
@@ -67,11 +67,6 @@ static __device__ __inline__ deviceSU3 _deviceVXXTau(
     return sRet;
 }
 
-static __device__ __inline__ Real _deviceEta124(const SSmallInt4& sSite)
-{
-    return (((sSite.y + sSite.z) & 1) > 0) ? (F(-1.0)) : (F(1.0));
-}
-
 static __device__ __inline__ deviceSU3 _deviceVXYT(
     const deviceSU3* __restrict__ pDeviceData,
     const SSmallInt4& sStartSite, BYTE byFieldId,
@@ -338,6 +333,30 @@ static __device__ __inline__ deviceSU3 _deviceVXYTOptimized(
     return sRet1;
 }
 
+/**
+ * The path policy of the rotation terms, see TFermionKSKernel.h
+ */
+struct SKSRotationPathSU3
+{
+    const deviceSU3* m_pGauge;
+    BYTE m_byGaugeFieldId;
+
+    __device__ __inline__ deviceSU3 XXTau(const SSmallInt4& sSite, UINT bXorY, UBOOL bPlusMu, UBOOL bPlusTau) const
+    {
+        return _deviceVXXTauOptimized(m_pGauge, sSite, m_byGaugeFieldId, bXorY, bPlusMu, bPlusTau);
+    }
+
+    __device__ __inline__ deviceSU3 XYTau(const SSmallInt4& sSite, UBOOL bPlusX, UBOOL bPlusY, UBOOL bPlusTau) const
+    {
+        return _deviceVXYTOptimized(m_pGauge, sSite, m_byGaugeFieldId, bPlusX, bPlusY, bPlusTau);
+    }
+
+    __device__ __inline__ deviceSU3 Link(const SSmallInt4& sSite, BYTE byLength, const INT* pDir) const
+    {
+        return _deviceLink(m_pGauge, sSite, byLength, m_byGaugeFieldId, pDir);
+    }
+};
+
 #pragma endregion
 
 __END_NAMESPACE
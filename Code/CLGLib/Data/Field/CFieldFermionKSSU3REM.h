@@ -307,6 +307,33 @@ static __device__ __inline__ deviceSU3 _deviceVXYTOptimizedEM(
     return sRet1;
 }
 
+/**
+ * The path policy of the rotation terms, see TFermionKSKernel.h
+ * The links are U(n,mu) exp(i q A(n,mu)) with A the CFieldGaugeU1Real background
+ */
+struct SKSRotationPathEM
+{
+    const deviceSU3* m_pGauge;
+    const Real* m_pU1;
+    Real m_fCharge;
+    BYTE m_byGaugeFieldId;
+
+    __device__ __inline__ deviceSU3 XXTau(const SSmallInt4& sSite, UINT bXorY, UBOOL bPlusMu, UBOOL bPlusTau) const
+    {
+        return _deviceVXXTauOptimizedEM(m_pGauge, m_pU1, sSite, m_fCharge, m_byGaugeFieldId, bXorY, bPlusMu, bPlusTau);
+    }
+
+    __device__ __inline__ deviceSU3 XYTau(const SSmallInt4& sSite, UBOOL bPlusX, UBOOL bPlusY, UBOOL bPlusTau) const
+    {
+        return _deviceVXYTOptimizedEM(m_pGauge, m_pU1, sSite, m_fCharge, m_byGaugeFieldId, bPlusX, bPlusY, bPlusTau);
+    }
+
+    __device__ __inline__ deviceSU3 Link(const SSmallInt4& sSite, BYTE byLength, const INT* pDir) const
+    {
+        return _deviceLinkEM(m_pGauge, m_pU1, m_fCharge, sSite, byLength, m_byGaugeFieldId, pDir);
+    }
+};
+
 #pragma endregion
 
 __END_NAMESPACE
@@ -18,270 +18,11 @@ __CLGIMPLEMENT_CLASS(CFieldFermionKSU1)
 
 #pragma region DOperator
 
-#pragma region kernel
-
 /**
 * Dks = 2am + \sum _{\mu} \eta_{\mu} (n) (U_{\mu}(n) \delta _{n,n+\mu} -U^+_{\mu}(n-\mu) \delta _{n,n-\mu})
-* U act on su3
-* gamma act on spinor
-*
-* If bDagger, it is just \eta 5(n) Dks \eta _5(n)
-* A easier way is D_{ks}(m=0) is anti-Hermitian, so D^+ = - D_{ks,m=0} + 2am
 *
+* See TFermionKSKernel.h
 */
-__global__ void _CLG_LAUNCH_BOUND
-_kernelDFermionKSU1(
-    const CLGComplex * __restrict__ pDeviceData,
-    const CLGComplex* __restrict__ pGauge,
-    const SIndex * __restrict__ pGaugeMove,
-    const SIndex * __restrict__ pFermionMove,
-    const BYTE * __restrict__ pEtaTable,
-    CLGComplex* pResultData,
-    Real f2am,
-    BYTE byFieldId,
-    UBOOL bDDagger,
-    EOperatorCoefficientType eCoeff,
-    Real fCoeff,
-    CLGComplex cCoeff)
-{
-    intokernaldir;
-
-    CLGComplex result = _zeroc;
-    //pResultData[uiSiteIndex] = pDeviceData[uiSiteIndex];
-
-    //idir = mu
-    for (UINT idir = 0; idir < uiDir; ++idir)
-    {
-        //Get Gamma mu
-        const Real eta_mu = (1 == ((pEtaTable[uiSiteIndex] >> idir) & 1)) ? F(-1.0) : F(1.0);
-
-        //x, mu
-        const UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
-
-        const SIndex& x_m_mu_Gauge = pGaugeMove[linkIndex];
-
-        const SIndex& x_p_mu_Fermion = pFermionMove[2 * linkIndex];
-        const SIndex& x_m_mu_Fermion = pFermionMove[2 * linkIndex + 1];
-
-        //Assuming periodic
-        //get U(x,mu), U^{dagger}(x-mu), 
-        const CLGComplex& x_Gauge_element = pGauge[linkIndex];
-        CLGComplex x_m_mu_Gauge_element = pGauge[_deviceGetLinkIndex(x_m_mu_Gauge.m_uiSiteIndex, idir)];
-        if (x_m_mu_Gauge.NeedToDagger())
-        {
-            x_m_mu_Gauge_element.y = -x_m_mu_Gauge_element.y;
-        }
-
-        //U(x,mu) phi(x+ mu)
-        CLGComplex u_phi_x_p_m = _cuCmulf(x_Gauge_element, pDeviceData[x_p_mu_Fermion.m_uiSiteIndex]);
-        if (x_p_mu_Fermion.NeedToOpposite())
-        {
-            u_phi_x_p_m.x = -u_phi_x_p_m.x;
-            u_phi_x_p_m.y = -u_phi_x_p_m.y;
-        }
-
-        //U^{dagger}(x-mu) phi(x-mu)
-        CLGComplex u_dagger_phi_x_m_m = _cuCmulf(x_m_mu_Gauge_element, pDeviceData[x_m_mu_Fermion.m_uiSiteIndex]);
-        if (x_m_mu_Fermion.NeedToOpposite())
-        {
-            u_phi_x_p_m.x += u_dagger_phi_x_m_m.x;
-            u_phi_x_p_m.y += u_dagger_phi_x_m_m.y;
-        }
-        else
-        {
-            u_phi_x_p_m.x -= u_dagger_phi_x_m_m.x;
-            u_phi_x_p_m.y -= u_dagger_phi_x_m_m.y;
-        }
-        u_phi_x_p_m.x *= eta_mu;
-        u_phi_x_p_m.y *= eta_mu;
-        result.x += u_phi_x_p_m.x;
-        result.y += u_phi_x_p_m.y;
-    }
-
-    pResultData[uiSiteIndex].x = pDeviceData[uiSiteIndex].x * f2am;
-    pResultData[uiSiteIndex].y = pDeviceData[uiSiteIndex].y * f2am;
-    if (bDDagger)
-    {
-        pResultData[uiSiteIndex].x -= result.x;
-        pResultData[uiSiteIndex].y -= result.y;
-    }
-    else
-    {
-        pResultData[uiSiteIndex].x += result.x;
-        pResultData[uiSiteIndex].y += result.y;
-    }
-
-    switch (eCoeff)
-    {
-    case EOCT_Real:
-        pResultData[uiSiteIndex].x *= fCoeff;
-        pResultData[uiSiteIndex].y *= fCoeff;
-        break;
-    case EOCT_Complex:
-        pResultData[uiSiteIndex] = _cuCmulf(pResultData[uiSiteIndex], cCoeff);
-        break;
-    }
-}
-
-/**
- * For some strange boundary condition
- */
-__global__ void _CLG_LAUNCH_BOUND
-_kernelDFermionKSPlusEtaU1(
-    const CLGComplex* __restrict__ pDeviceData,
-    const CLGComplex* __restrict__ pGauge,
-    const SIndex* __restrict__ pGaugeMove,
-    const SIndex* __restrict__ pFermionMove,
-    const BYTE* __restrict__ pEtaTable,
-    CLGComplex* pResultData,
-    Real f2am,
-    BYTE byFieldId,
-    UBOOL bDDagger,
-    EOperatorCoefficientType eCoeff,
-    Real fCoeff,
-    CLGComplex cCoeff)
-{
-    intokernaldir;
-
-    CLGComplex result = _zeroc;
-    pResultData[uiSiteIndex] = pDeviceData[uiSiteIndex];
-
-    //idir = mu
-    for (UINT idir = 0; idir < uiDir; ++idir)
-    {
-        //x, mu
-        const UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
-
-        const SIndex& x_m_mu_Gauge = pGaugeMove[linkIndex];
-
-        const SIndex& x_p_mu_Fermion = pFermionMove[2 * linkIndex];
-        const SIndex& x_m_mu_Fermion = pFermionMove[2 * linkIndex + 1];
-
-        //This is in fact, -1 * eta(n + mu)
-        const Real eta_mu = (1 == ((pEtaTable[uiSiteIndex] >> idir) & 1)) ? F(-1.0) : F(1.0);
-        const Real eta_mu2 = (1 == ((pEtaTable[x_m_mu_Fermion.m_uiSiteIndex] >> idir) & 1)) ? F(-1.0) : F(1.0);
-
-        //Assuming periodic
-        //get U(x,mu), U^{dagger}(x-mu), 
-        const CLGComplex& x_Gauge_element = pGauge[linkIndex];
-        CLGComplex x_m_mu_Gauge_element = pGauge[_deviceGetLinkIndex(x_m_mu_Gauge.m_uiSiteIndex, idir)];
-        if (x_m_mu_Gauge.NeedToDagger())
-        {
-            x_m_mu_Gauge_element.y = -x_m_mu_Gauge_element.y;
-        }
-
-        //U(x,mu) phi(x+ mu)
-        CLGComplex u_phi_x_p_m = _cuCmulf(x_Gauge_element, pDeviceData[x_p_mu_Fermion.m_uiSiteIndex]);
-        if (x_p_mu_Fermion.NeedToOpposite())
-        {
-            u_phi_x_p_m.x *= F(-1.0) * eta_mu;
-            u_phi_x_p_m.y *= F(-1.0) * eta_mu;
-        }
-        else
-        {
-            u_phi_x_p_m.x *= eta_mu;
-            u_phi_x_p_m.y *= eta_mu;
-        }
-
-        //U^{dagger}(x-mu) phi(x-mu)
-        CLGComplex u_dagger_phi_x_m_m = _cuCmulf(x_m_mu_Gauge_element, pDeviceData[x_m_mu_Fermion.m_uiSiteIndex]);
-        u_dagger_phi_x_m_m.x *= eta_mu2;
-        u_dagger_phi_x_m_m.y *= eta_mu2;
-        if (x_m_mu_Fermion.NeedToOpposite())
-        {
-            u_phi_x_p_m.x += u_dagger_phi_x_m_m.x;
-            u_phi_x_p_m.y += u_dagger_phi_x_m_m.y;
-        }
-        else
-        {
-            u_phi_x_p_m.x -= u_dagger_phi_x_m_m.x;
-            u_phi_x_p_m.y -= u_dagger_phi_x_m_m.y;
-        }
-        result.x += u_phi_x_p_m.x;
-        result.y += u_phi_x_p_m.y;
-    }
-
-    pResultData[uiSiteIndex].x *= f2am;
-    pResultData[uiSiteIndex].y *= f2am;
-    if (bDDagger)
-    {
-        pResultData[uiSiteIndex].x -= result.x;
-        pResultData[uiSiteIndex].y -= result.y;
-    }
-    else
-    {
-        pResultData[uiSiteIndex].x += result.x;
-        pResultData[uiSiteIndex].y += result.y;
-    }
-
-    switch (eCoeff)
-    {
-    case EOCT_Real:
-        pResultData[uiSiteIndex].x *= fCoeff;
-        pResultData[uiSiteIndex].y *= fCoeff;
-        break;
-    case EOCT_Complex:
-        pResultData[uiSiteIndex] = _cuCmulf(pResultData[uiSiteIndex], cCoeff);
-        break;
-    }
-}
-
-/**
- * Calculate Force
- */
-__global__ void _CLG_LAUNCH_BOUND
-_kernelDFermionKSForceU1(
-    const CLGComplex* __restrict__ pGauge,
-    CLGComplex* pForce,
-    const SIndex* __restrict__ pFermionMove,
-    const BYTE* __restrict__ pEtaTable,
-    const CLGComplex* const* __restrict__ pFermionPointers,
-    const Real* __restrict__ pNumerators,
-    UINT uiRational,
-    BYTE byFieldId)
-{
-    intokernaldir;
-
-    //idir = mu
-    for (UINT idir = 0; idir < uiDir; ++idir)
-    {
-        //Get Gamma mu
-        const Real eta_mu = (1 == ((pEtaTable[uiSiteIndex] >> idir) & 1)) ? F(-1.0) : F(1.0);
-        //x, mu
-        const UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
-
-        const SIndex& x_p_mu_Fermion = pFermionMove[2 * linkIndex];
-
-        for (UINT uiR = 0; uiR < uiRational; ++uiR)
-        {
-            const CLGComplex* phi_i = pFermionPointers[uiR];
-            const CLGComplex* phi_id = pFermionPointers[uiR + uiRational];
-
-            CLGComplex toContract = _cuCmulf(pGauge[linkIndex], phi_i[x_p_mu_Fermion.m_uiSiteIndex]);
-            CLGComplex thisTerm = _cuCmulf(_cuConjf(phi_id[uiSiteIndex]), toContract);
-
-            toContract = _cuCmulf(pGauge[linkIndex], phi_id[x_p_mu_Fermion.m_uiSiteIndex]);
-            toContract.y = -toContract.y;
-            thisTerm = _cuCaddf(thisTerm, _cuCmulf(toContract, phi_i[uiSiteIndex]));
-
-            //if (x_p_mu_Fermion.NeedToOpposite())
-            //{
-            //    thisTerm = cuCmulf_cr(thisTerm, eta_mu * pNumerators[uiR] * F(-1.0));
-            //}
-            //else
-            //{
-            //    thisTerm = cuCmulf_cr(thisTerm, eta_mu * pNumerators[uiR]);
-            //}
-
-            pForce[linkIndex].y -= thisTerm.y * (x_p_mu_Fermion.NeedToOpposite() ? 
-                (eta_mu * pNumerators[uiR] * F(-1.0)) : 
-                (eta_mu * pNumerators[uiR]));
-        }
-    }
-}
-
-#pragma endregion
-
 void CFieldFermionKSU1::DOperatorKS(void* pTargetBuffer, const void * pBuffer,
     const void * pGaugeBuffer, Real f2am,
     UBOOL bDagger, EOperatorCoefficientType eOCT,
@@ -290,44 +31,83 @@ void CFieldFermionKSU1::DOperatorKS(void* pTargetBuffer, const void * pBuffer,
     CLGComplex* pTarget = (CLGComplex*)pTargetBuffer;
     const CLGComplex* pSource = (const CLGComplex*)pBuffer;
     const CLGComplex* pGauge = (const CLGComplex*)pGaugeBuffer;
-    //appGeneral(_T("Shift: %d, am: %f\n"), m_bEachSiteEta, f2am);
+    const UINT uiBytes = static_cast<UINT>(sizeof(CLGComplex));
 
     preparethread;
-    if (m_bEachSiteEta)
-    {
-        _kernelDFermionKSPlusEtaU1 << <block, threads >> > (
-            pSource,
-            pGauge,
-            appGetLattice()->m_pIndexCache->m_pGaugeMoveCache[m_byFieldId],
-            appGetLattice()->m_pIndexCache->m_pFermionMoveCache[m_byFieldId],
-            appGetLattice()->m_pIndexCache->m_pEtaMu,
-            pTarget,
-            f2am,
-            m_byFieldId,
-            bDagger,
-            eOCT,
-            fRealCoeff,
-            cCmpCoeff);
-    }
-    else
+    //the inner planes overlap the halo exchange, see appBeginExchangeHalo
+    SXPlaneRange sRange = appBeginExchangeHalo(pBuffer, uiBytes, 1);
+    do
     {
-        _kernelDFermionKSU1 << <block, threads >> > (
-            pSource,
-            pGauge,
-            appGetLattice()->m_pIndexCache->m_pGaugeMoveCache[m_byFieldId],
-            appGetLattice()->m_pIndexCache->m_pFermionMoveCache[m_byFieldId],
-            appGetLattice()->m_pIndexCache->m_pEtaMu,
-            pTarget,
-            f2am,
-            m_byFieldId,
-            bDagger,
-            eOCT,
-            fRealCoeff,
-            cCmpCoeff);
-    }
+#if _CLG_DIRECT_STENCIL
+        if (!m_bEachSiteEta && appGetLattice()->m_pIndex->UseDirectStencil(1))
+        {
+            SKSStencilTorus stencil;
+            stencil.m_sBC = appGetLattice()->m_pIndex->m_pBoundaryCondition->GetFieldBC(m_byFieldId);
+            _kernelDFermionKST<SKSGroupU1, SKSStencilTorus, SKSPhaseNone> << <block, threads >> > (
+                pSource,
+                pGauge,
+                pTarget,
+                f2am,
+                bDagger,
+                eOCT,
+                fRealCoeff,
+                cCmpCoeff,
+                stencil,
+                SKSPhaseNone(),
+                sRange,
+                NULL,
+                NULL,
+                NULL);
+            continue;
+        }
+#endif
+        if (m_bEachSiteEta)
+        {
+            const SKSStencilCache<SKSEtaEachSite> stencil = {
+                appGetLattice()->m_pIndexCache->m_pGaugeMoveCache[m_byFieldId],
+                appGetLattice()->m_pIndexCache->m_pFermionMoveCache[m_byFieldId],
+                appGetLattice()->m_pIndexCache->m_pEtaMu };
+            _kernelDFermionKST<SKSGroupU1, SKSStencilCache<SKSEtaEachSite>, SKSPhaseNone> << <block, threads >> > (
+                pSource,
+                pGauge,
+                pTarget,
+                f2am,
+                bDagger,
+                eOCT,
+                fRealCoeff,
+                cCmpCoeff,
+                stencil,
+                SKSPhaseNone(),
+                sRange,
+                NULL,
+                NULL,
+                NULL);
+        }
+        else
+        {
+            const SKSStencilCache<SKSEtaSite> stencil = {
+                appGetLattice()->m_pIndexCache->m_pGaugeMoveCache[m_byFieldId],
+                appGetLattice()->m_pIndexCache->m_pFermionMoveCache[m_byFieldId],
+                appGetLattice()->m_pIndexCache->m_pEtaMu };
+            _kernelDFermionKST<SKSGroupU1, SKSStencilCache<SKSEtaSite>, SKSPhaseNone> << <block, threads >> > (
+                pSource,
+                pGauge,
+                pTarget,
+                f2am,
+                bDagger,
+                eOCT,
+                fRealCoeff,
+                cCmpCoeff,
+                stencil,
+                SKSPhaseNone(),
+                sRange,
+                NULL,
+                NULL,
+                NULL);
+        }
+    } while (appEndExchangeHalo(pBuffer, uiBytes, sRange));
 }
 
-
 /**
  * partial D_{st0} / partial omega
  * Make sure m_pMDNumerator and m_pRationalFieldPointers are filled
@@ -337,15 +117,34 @@ void CFieldFermionKSU1::DerivateD0(
     const void* pGaugeBuffer) const
 {
     preparethread;
-    _kernelDFermionKSForceU1 << <block, threads >> > (
+#if _CLG_DIRECT_STENCIL
+    if (appGetLattice()->m_pIndex->UseDirectStencil(1))
+    {
+        SKSStencilTorus stencil;
+        stencil.m_sBC = appGetLattice()->m_pIndex->m_pBoundaryCondition->GetFieldBC(m_byFieldId);
+        _kernelDFermionKSForceT<SKSGroupU1, SKSStencilTorus, SKSPhaseNone> << <block, threads >> > (
+            (const CLGComplex*)pGaugeBuffer,
+            (CLGComplex*)pForce,
+            m_pRationalFieldPointers,
+            m_pMDNumerator,
+            m_rMD.m_uiDegree,
+            stencil,
+            SKSPhaseNone());
+        return;
+    }
+#endif
+    const SKSStencilCache<SKSEtaSite> stencil = {
+        appGetLattice()->m_pIndexCache->m_pGaugeMoveCache[m_byFieldId],
+        appGetLattice()->m_pIndexCache->m_pFermionMoveCache[m_byFieldId],
+        appGetLattice()->m_pIndexCache->m_pEtaMu };
+    _kernelDFermionKSForceT<SKSGroupU1, SKSStencilCache<SKSEtaSite>, SKSPhaseNone> << <block, threads >> > (
         (const CLGComplex*)pGaugeBuffer,
         (CLGComplex*)pForce,
-        appGetLattice()->m_pIndexCache->m_pFermionMoveCache[m_byFieldId],
-        appGetLattice()->m_pIndexCache->m_pEtaMu,
         m_pRationalFieldPointers,
         m_pMDNumerator,
         m_rMD.m_uiDegree,
-        m_byFieldId);
+        stencil,
+        SKSPhaseNone());
 }
 
 #pragma endregion
@@ -359,6 +158,7 @@ __global__ void _CLG_LAUNCH_BOUND
 _kernelInitialFermionKSU1(CLGComplex *pDevicePtr, BYTE byFieldId, EFieldInitialType eInitialType)
 {
     intokernalInt4;
+    SRandomDraw uiDraw;
 
     switch (eInitialType)
     {
@@ -374,12 +174,12 @@ _kernelInitialFermionKSU1(CLGComplex *pDevicePtr, BYTE byFieldId, EFieldInitialT
     break;
     case EFIT_RandomGaussian:
     {
-        pDevicePtr[uiSiteIndex] = _deviceRandomGaussC(_deviceGetFatIndex(uiSiteIndex, 0));
+        pDevicePtr[uiSiteIndex] = _deviceRandomGaussC(_deviceGetFatIndex(uiSiteIndex, 0), uiDraw);
     }
     break;
     case EFIT_RandomZ4:
     {
-        pDevicePtr[uiSiteIndex] = _deviceRandomZ4(_deviceGetFatIndex(uiSiteIndex, 0));
+        pDevicePtr[uiSiteIndex] = _deviceRandomZ4(_deviceGetFatIndex(uiSiteIndex, 0), uiDraw);
     }
     break;
     default:
@@ -413,6 +213,7 @@ void CFieldFermionKSU1::D_MC(const CField* pGauge)
 void CFieldFermionKSU1::PrepareForHMC(const CFieldGauge* pGauge)
 {
     preparethread;
+    appGetLattice()->m_pRandom->NextLaunch();
     _kernelInitialFermionKSU1 << <block, threads >> > (
         m_pDeviceData,
         m_byFieldId,
@@ -436,14 +237,15 @@ UBOOL CFieldFermionKSU1::CalculateForce(
     CFieldGauge* pForce,
     ESolverPhase ePhase) const
 {
-    if (NULL == pGauge || EFT_GaugeU1 != pGauge->GetFieldType())
+    const CLGComplex* pU1Links = CFieldGaugeU1Angle::U1LinksOf(pGauge);
+    if (NULL == pU1Links)
     {
-        appCrucial(_T("CFieldFermionWilsonSquareSU3 can only play with gauge SU3!"));
+        appCrucial(_T("CFieldFermionKSU1 can only play with gauge U1!"));
         return FALSE;
     }
-    if (NULL == pForce || EFT_GaugeU1 != pForce->GetFieldType())
+    if (NULL == pForce || (EFT_GaugeU1 != pForce->GetFieldType() && EFT_GaugeU1Angle != pForce->GetFieldType()))
     {
-        appCrucial(_T("CFieldFermionWilsonSquareSU3 can only play with gauge SU3!"));
+        appCrucial(_T("CFieldFermionKSU1 can only play with gauge U1!"));
         return FALSE;
     }
 
@@ -484,10 +286,17 @@ UBOOL CFieldFermionKSU1::CalculateForce(
     }
     checkCudaErrors(cudaMemcpy(m_pRationalFieldPointers, hostPointers, uiBufferSize, cudaMemcpyHostToDevice));
 
-    const CFieldGaugeU1* pGaugeU1 = dynamic_cast<const CFieldGaugeU1*>(pGauge);
-    CFieldGaugeU1* pForceU1 = dynamic_cast<CFieldGaugeU1*>(pForce);
-
-    DerivateD0(pForceU1->m_pDeviceData, pGaugeU1->m_pDeviceData);
+    //for the angle field, the force is calculated as CFieldGaugeU1 and the imaginary part is added
+    CFieldGaugeU1Angle* pForceAngle = dynamic_cast<CFieldGaugeU1Angle*>(pForce);
+    if (NULL != pForceAngle)
+    {
+        DerivateD0(pForceAngle->PrepareU1Force(), pU1Links);
+        pForceAngle->AcceptU1Force();
+    }
+    else
+    {
+        DerivateD0(dynamic_cast<CFieldGaugeU1*>(pForce)->m_pDeviceData, pU1Links);
+    }
     //preparethread;
     //_kernelDFermionKSForce << <block, threads >> > (
     //    pGaugeSU3->m_pDeviceData,
@@ -623,9 +432,9 @@ _kernelMakeWallSourceKSU1(CLGComplex* pDeviceData,
       && (uiDesiredT < 0 || uiDesiredT == sSite4.w))
     {
         //sSite4 is no longer used
-        sSite4.x = sSite4.x + static_cast<SBYTE>(uiShift & 1);
-        sSite4.y = sSite4.y + static_cast<SBYTE>((uiShift >> 1) & 1);
-        sSite4.z = sSite4.z + static_cast<SBYTE>((uiShift >> 2) & 1);
+        sSite4.x = sSite4.x + static_cast<SCOORD>(uiShift & 1);
+        sSite4.y = sSite4.y + static_cast<SCOORD>((uiShift >> 1) & 1);
+        sSite4.z = sSite4.z + static_cast<SCOORD>((uiShift >> 2) & 1);
         const SIndex& sIdx = __idx->m_pDeviceIndexPositionToSIndex[byFieldID][__bi(sSite4)];
         if (!sIdx.IsDirichlet())
         {
@@ -1038,6 +847,7 @@ CFieldFermionKSU1::~CFieldFermionKSU1()
 void CFieldFermionKSU1::InitialField(EFieldInitialType eInitialType)
 {
     preparethread;
+    appGetLattice()->m_pRandom->NextLaunch();
     _kernelInitialFermionKSU1 << <block, threads >> > (m_pDeviceData, m_byFieldId, eInitialType);
 }
 
@@ -1079,6 +889,11 @@ void CFieldFermionKSU1::InitialWithByte(BYTE* byData)
 void CFieldFermionKSU1::InitialOtherParameters(CParameters& params)
 {
     CFieldFermionKS::InitialOtherParameters(params);
+}
+
+void CFieldFermionKSU1::SetRationalApproximation(const TArray<Real>& md, const TArray<Real>& mc)
+{
+    CFieldFermionKS::SetRationalApproximation(md, mc);
     if (NULL != m_pRationalFieldPointers)
     {
         checkCudaErrors(cudaFree(m_pRationalFieldPointers));
@@ -1214,6 +1029,22 @@ void CFieldFermionKSU1::ScalarMultply(Real a)
     _kernelScalarMultiplyRealKSU1 << <block, threads >> > (m_pDeviceData, a);
 }
 
+void CFieldFermionKSU1::LinearCombine(UINT uiCount, const CField* const* pFields, const CLGComplex* pCoeffs)
+{
+    const CLGComplex* pData[_kLinearCombineMaxTerm];
+    for (UINT i = 0; i < uiCount; ++i)
+    {
+        if (i >= _kLinearCombineMaxTerm || NULL == pFields[i] || EFT_FermionStaggeredU1 != pFields[i]->GetFieldType())
+        {
+            //let the ScalarMultply and Axpy report the wrong field
+            CField::LinearCombine(uiCount, pFields, pCoeffs);
+            return;
+        }
+        pData[i] = (const CLGComplex*)(dynamic_cast<const CFieldFermionKSU1*>(pFields[i])->m_pDeviceData);
+    }
+    _LinearCombineComplex((CLGComplex*)m_pDeviceData, 1, uiCount, pData, pCoeffs);
+}
+
 void CFieldFermionKSU1::ApplyGamma(EGammaMatrix eGamma)
 {
     appCrucial(_T("Not implemented yet...\n"));
@@ -1252,12 +1083,12 @@ void CFieldFermionKSU1::ApplyGammaKS(const CFieldGauge* pGauge, EGammaMatrix eGa
 
     if (iDir >= 0)
     {
-        if (NULL == pGauge || EFT_GaugeU1 != pGauge->GetFieldType())
+        const CLGComplex* pU1Links = CFieldGaugeU1Angle::U1LinksOf(pGauge);
+        if (NULL == pU1Links)
         {
             appCrucial(_T("CFieldFermionKSU1 can only play with gauge U1!"));
             return;
         }
-        const CFieldGaugeU1* pFieldU1 = dynamic_cast<const CFieldGaugeU1*>(pGauge);
         CFieldFermionKSU1* pPooled = dynamic_cast<CFieldFermionKSU1*>(appGetLattice()->GetPooledFieldById(m_byFieldId));
         checkCudaErrors(cudaMemcpy(pPooled->m_pDeviceData, m_pDeviceData, sizeof(CLGComplex) * m_uiSiteCount, cudaMemcpyDeviceToDevice));
         preparethread;
@@ -1266,7 +1097,7 @@ void CFieldFermionKSU1::ApplyGammaKS(const CFieldGauge* pGauge, EGammaMatrix eGa
             _kernelKSApplyGammaEtaU1 << <block, threads >> > (
                 m_pDeviceData,
                 pPooled->m_pDeviceData,
-                pFieldU1->m_pDeviceData,
+                pU1Links,
                 appGetLattice()->m_pIndexCache->m_pGaugeMoveCache[m_byFieldId],
                 appGetLattice()->m_pIndexCache->m_pFermionMoveCache[m_byFieldId],
                 appGetLattice()->m_pIndexCache->m_pEtaMu,
@@ -1277,7 +1108,7 @@ void CFieldFermionKSU1::ApplyGammaKS(const CFieldGauge* pGauge, EGammaMatrix eGa
             _kernelKSApplyGammaU1 << <block, threads >> > (
                 m_pDeviceData,
                 pPooled->m_pDeviceData,
-                pFieldU1->m_pDeviceData,
+                pU1Links,
                 appGetLattice()->m_pIndexCache->m_pGaugeMoveCache[m_byFieldId],
                 appGetLattice()->m_pIndexCache->m_pFermionMoveCache[m_byFieldId],
                 appGetLattice()->m_pIndexCache->m_pEtaMu,
@@ -1296,12 +1127,12 @@ void CFieldFermionKSU1::ApplyGammaKS(const CFieldGauge* pGauge, EGammaMatrix eGa
 //Kai should be part of D operator
 void CFieldFermionKSU1::D(const CField* pGauge, EOperatorCoefficientType eCoeffType, Real fCoeffReal, Real fCoeffImg)
 {
-    if (NULL == pGauge || EFT_GaugeU1 != pGauge->GetFieldType())
+    const CLGComplex* pU1Links = CFieldGaugeU1Angle::U1LinksOf(pGauge);
+    if (NULL == pU1Links)
     {
         appCrucial(_T("CFieldFermionKSU1 can only play with gauge U1!"));
         return;
     }
-    const CFieldGaugeU1* pFieldU1 = dynamic_cast<const CFieldGaugeU1*>(pGauge);
     CFieldFermionKSU1* pPooled = dynamic_cast<CFieldFermionKSU1*>(appGetLattice()->GetPooledFieldById(m_byFieldId));
 
     checkCudaErrors(cudaMemcpy(pPooled->m_pDeviceData, m_pDeviceData, sizeof(CLGComplex) * m_uiSiteCount, cudaMemcpyDeviceToDevice));
@@ -1314,7 +1145,7 @@ void CFieldFermionKSU1::D(const CField* pGauge, EOperatorCoefficientType eCoeffT
         fRealCoeff = F(-1.0);
     }
 
-    DOperator(m_pDeviceData, pPooled->m_pDeviceData, pFieldU1->m_pDeviceData,
+    DOperator(m_pDeviceData, pPooled->m_pDeviceData, pU1Links,
         FALSE, eCoeffType, fRealCoeff, cCompCoeff);
 
     pPooled->Return();
@@ -1322,12 +1153,12 @@ void CFieldFermionKSU1::D(const CField* pGauge, EOperatorCoefficientType eCoeffT
 
 void CFieldFermionKSU1::DWithMass(const CField* pGauge, Real fMass, EOperatorCoefficientType eCoeffType, Real fCoeffReal, Real fCoeffImg)
 {
-    if (NULL == pGauge || EFT_GaugeU1 != pGauge->GetFieldType())
+    const CLGComplex* pU1Links = CFieldGaugeU1Angle::U1LinksOf(pGauge);
+    if (NULL == pU1Links)
     {
         appCrucial(_T("CFieldFermionKSU1 can only play with gauge U1!"));
         return;
     }
-    const CFieldGaugeU1* pFieldU1 = dynamic_cast<const CFieldGaugeU1*>(pGauge);
     CFieldFermionKSU1* pPooled = dynamic_cast<CFieldFermionKSU1*>(appGetLattice()->GetPooledFieldById(m_byFieldId));
 
     checkCudaErrors(cudaMemcpy(pPooled->m_pDeviceData, m_pDeviceData, sizeof(CLGComplex) * m_uiSiteCount, cudaMemcpyDeviceToDevice));
@@ -1340,7 +1171,7 @@ void CFieldFermionKSU1::DWithMass(const CField* pGauge, Real fMass, EOperatorCoe
         fRealCoeff = F(-1.0);
     }
 
-    DOperatorKS(m_pDeviceData, pPooled->m_pDeviceData, pFieldU1->m_pDeviceData, fMass,
+    DOperatorKS(m_pDeviceData, pPooled->m_pDeviceData, pU1Links, fMass,
         FALSE, eCoeffType, fRealCoeff, cCompCoeff);
 
     pPooled->Return();
@@ -1348,17 +1179,17 @@ void CFieldFermionKSU1::DWithMass(const CField* pGauge, Real fMass, EOperatorCoe
 
 void CFieldFermionKSU1::D0(const CField* pGauge)
 {
-    if (NULL == pGauge || EFT_GaugeU1 != pGauge->GetFieldType())
+    const CLGComplex* pU1Links = CFieldGaugeU1Angle::U1LinksOf(pGauge);
+    if (NULL == pU1Links)
     {
         appCrucial(_T("CFieldFermionKSU1 can only play with gauge U1!"));
         return;
     }
-    const CFieldGaugeU1* pFieldU1 = dynamic_cast<const CFieldGaugeU1*>(pGauge);
     CFieldFermionKSU1* pPooled = dynamic_cast<CFieldFermionKSU1*>(appGetLattice()->GetPooledFieldById(m_byFieldId));
 
     checkCudaErrors(cudaMemcpy(pPooled->m_pDeviceData, m_pDeviceData, sizeof(CLGComplex) * m_uiSiteCount, cudaMemcpyDeviceToDevice));
 
-    DOperatorKS(m_pDeviceData, pPooled->m_pDeviceData, pFieldU1->m_pDeviceData, F(0.0),
+    DOperatorKS(m_pDeviceData, pPooled->m_pDeviceData, pU1Links, F(0.0),
         FALSE, EOCT_None, F(1.0), _onec);
 
     pPooled->Return();
@@ -1426,12 +1257,12 @@ UINT CFieldFermionKSU1::TestAntiHermitian(const CFieldGauge* pGauge) const
 //Kai should be part of D operator
 void CFieldFermionKSU1::Ddagger(const CField* pGauge, EOperatorCoefficientType eCoeffType, Real fCoeffReal, Real fCoeffImg)
 {
-    if (NULL == pGauge || EFT_GaugeU1 != pGauge->GetFieldType())
+    const CLGComplex* pU1Links = CFieldGaugeU1Angle::U1LinksOf(pGauge);
+    if (NULL == pU1Links)
     {
         appCrucial(_T("CFieldFermionKSU1 can only play with gauge U1!"));
         return;
     }
-    const CFieldGaugeU1* pFieldU1 = dynamic_cast<const CFieldGaugeU1*>(pGauge);
     CFieldFermionKSU1* pPooled = dynamic_cast<CFieldFermionKSU1*>(appGetLattice()->GetPooledFieldById(m_byFieldId));
     checkCudaErrors(cudaMemcpy(pPooled->m_pDeviceData, m_pDeviceData, sizeof(CLGComplex) * m_uiSiteCount, cudaMemcpyDeviceToDevice));
 
@@ -1443,7 +1274,7 @@ void CFieldFermionKSU1::Ddagger(const CField* pGauge, EOperatorCoefficientType e
         fRealCoeff = F(-1.0);
     }
 
-    DOperator(m_pDeviceData, pPooled->m_pDeviceData, pFieldU1->m_pDeviceData,
+    DOperator(m_pDeviceData, pPooled->m_pDeviceData, pU1Links,
         TRUE, eCoeffType, fRealCoeff, cCompCoeff);
 
 
@@ -1452,12 +1283,12 @@ void CFieldFermionKSU1::Ddagger(const CField* pGauge, EOperatorCoefficientType e
 
 void CFieldFermionKSU1::DdaggerWithMass(const CField* pGauge, Real fMass, EOperatorCoefficientType eCoeffType, Real fCoeffReal, Real fCoeffImg)
 {
-    if (NULL == pGauge || EFT_GaugeU1 != pGauge->GetFieldType())
+    const CLGComplex* pU1Links = CFieldGaugeU1Angle::U1LinksOf(pGauge);
+    if (NULL == pU1Links)
     {
         appCrucial(_T("CFieldFermionKSU1 can only play with gauge U1!"));
         return;
     }
-    const CFieldGaugeU1* pFieldU1 = dynamic_cast<const CFieldGaugeU1*>(pGauge);
     CFieldFermionKSU1* pPooled = dynamic_cast<CFieldFermionKSU1*>(appGetLattice()->GetPooledFieldById(m_byFieldId));
     checkCudaErrors(cudaMemcpy(pPooled->m_pDeviceData, m_pDeviceData, sizeof(CLGComplex) * m_uiSiteCount, cudaMemcpyDeviceToDevice));
 
@@ -1469,7 +1300,7 @@ void CFieldFermionKSU1::DdaggerWithMass(const CField* pGauge, Real fMass, EOpera
         fRealCoeff = F(-1.0);
     }
 
-    DOperatorKS(m_pDeviceData, pPooled->m_pDeviceData, pFieldU1->m_pDeviceData, fMass,
+    DOperatorKS(m_pDeviceData, pPooled->m_pDeviceData, pU1Links, fMass,
         TRUE, eCoeffType, fRealCoeff, cCompCoeff);
 
 
@@ -1478,12 +1309,12 @@ void CFieldFermionKSU1::DdaggerWithMass(const CField* pGauge, Real fMass, EOpera
 
 void CFieldFermionKSU1::DDdagger(const CField* pGauge, EOperatorCoefficientType eCoeffType, Real fCoeffReal, Real fCoeffImg)
 {
-    if (NULL == pGauge || EFT_GaugeU1 != pGauge->GetFieldType())
+    const CLGComplex* pU1Links = CFieldGaugeU1Angle::U1LinksOf(pGauge);
+    if (NULL == pU1Links)
     {
         appCrucial(_T("CFieldFermionKSU1 can only play with gauge U1!"));
         return;
     }
-    const CFieldGaugeU1* pFieldU1 = dynamic_cast<const CFieldGaugeU1*>(pGauge);
 
     Real fRealCoeff = fCoeffReal;
     const CLGComplex cCompCoeff = _make_cuComplex(fCoeffReal, fCoeffImg);
@@ -1494,10 +1325,10 @@ void CFieldFermionKSU1::DDdagger(const CField* pGauge, EOperatorCoefficientType
     }
     CFieldFermionKSU1* pPooled = dynamic_cast<CFieldFermionKSU1*>(appGetLattice()->GetPooledFieldById(m_byFieldId));
 
-    DOperator(pPooled->m_pDeviceData, m_pDeviceData, pFieldU1->m_pDeviceData,
+    DOperator(pPooled->m_pDeviceData, m_pDeviceData, pU1Links,
         TRUE, EOCT_None, F(1.0), _make_cuComplex(F(1.0), F(0.0)));
     //why only apply coeff in the next step?
-    DOperator(m_pDeviceData, pPooled->m_pDeviceData, pFieldU1->m_pDeviceData,
+    DOperator(m_pDeviceData, pPooled->m_pDeviceData, pU1Links,
         FALSE, eCoeffType, fRealCoeff, cCompCoeff);
 
     pPooled->Return();
@@ -1505,12 +1336,12 @@ void CFieldFermionKSU1::DDdagger(const CField* pGauge, EOperatorCoefficientType
 
 void CFieldFermionKSU1::DD(const CField* pGauge, EOperatorCoefficientType eCoeffType, Real fCoeffReal, Real fCoeffImg)
 {
-    if (NULL == pGauge || EFT_GaugeU1 != pGauge->GetFieldType())
+    const CLGComplex* pU1Links = CFieldGaugeU1Angle::U1LinksOf(pGauge);
+    if (NULL == pU1Links)
     {
         appCrucial(_T("CFieldFermionKSU1 can only play with gauge U1!"));
         return;
     }
-    const CFieldGaugeU1* pFieldU1 = dynamic_cast<const CFieldGaugeU1*>(pGauge);
 
     Real fRealCoeff = fCoeffReal;
     const CLGComplex cCompCoeff = _make_cuComplex(fCoeffReal, fCoeffImg);
@@ -1521,10 +1352,10 @@ void CFieldFermionKSU1::DD(const CField* pGauge, EOperatorCoefficientType eCoeff
     }
     CFieldFermionKSU1* pPooled = dynamic_cast<CFieldFermionKSU1*>(appGetLattice()->GetPooledFieldById(m_byFieldId));
 
-    DOperator(pPooled->m_pDeviceData, m_pDeviceData, pFieldU1->m_pDeviceData,
+    DOperator(pPooled->m_pDeviceData, m_pDeviceData, pU1Links,
         FALSE, EOCT_None, F(1.0), _make_cuComplex(F(1.0), F(0.0)));
     //why only apply coeff in the next step?
-    DOperator(m_pDeviceData, pPooled->m_pDeviceData, pFieldU1->m_pDeviceData,
+    DOperator(m_pDeviceData, pPooled->m_pDeviceData, pU1Links,
         FALSE, eCoeffType, fRealCoeff, cCompCoeff);
 
     pPooled->Return();
@@ -1532,12 +1363,12 @@ void CFieldFermionKSU1::DD(const CField* pGauge, EOperatorCoefficientType eCoeff
 
 void CFieldFermionKSU1::DDdaggerWithMass(const CField* pGauge, Real fMass, EOperatorCoefficientType eCoeffType, Real fCoeffReal, Real fCoeffImg)
 {
-    if (NULL == pGauge || EFT_GaugeU1 != pGauge->GetFieldType())
+    const CLGComplex* pU1Links = CFieldGaugeU1Angle::U1LinksOf(pGauge);
+    if (NULL == pU1Links)
     {
         appCrucial(_T("CFieldFermionKSU1 can only play with gauge U1!"));
         return;
     }
-    const CFieldGaugeU1* pFieldU1 = dynamic_cast<const CFieldGaugeU1*>(pGauge);
 
     Real fRealCoeff = fCoeffReal;
     const CLGComplex cCompCoeff = _make_cuComplex(fCoeffReal, fCoeffImg);
@@ -1548,10 +1379,10 @@ void CFieldFermionKSU1::DDdaggerWithMass(const CField* pGauge, Real fMass, EOper
     }
     CFieldFermionKSU1* pPooled = dynamic_cast<CFieldFermionKSU1*>(appGetLattice()->GetPooledFieldById(m_byFieldId));
 
-    DOperatorKS(pPooled->m_pDeviceData, m_pDeviceData, pFieldU1->m_pDeviceData, fMass,
+    DOperatorKS(pPooled->m_pDeviceData, m_pDeviceData, pU1Links, fMass,
         TRUE, EOCT_None, F(1.0), _make_cuComplex(F(1.0), F(0.0)));
     //why only apply coeff in the next step?
-    DOperatorKS(m_pDeviceData, pPooled->m_pDeviceData, pFieldU1->m_pDeviceData, fMass,
+    DOperatorKS(m_pDeviceData, pPooled->m_pDeviceData, pU1Links, fMass,
         FALSE, eCoeffType, fRealCoeff, cCompCoeff);
 
     pPooled->Return();
@@ -1559,12 +1390,12 @@ void CFieldFermionKSU1::DDdaggerWithMass(const CField* pGauge, Real fMass, EOper
 
 void CFieldFermionKSU1::DDWithMass(const CField* pGauge, Real fMass, EOperatorCoefficientType eCoeffType, Real fCoeffReal, Real fCoeffImg)
 {
-    if (NULL == pGauge || EFT_GaugeU1 != pGauge->GetFieldType())
+    const CLGComplex* pU1Links = CFieldGaugeU1Angle::U1LinksOf(pGauge);
+    if (NULL == pU1Links)
     {
         appCrucial(_T("CFieldFermionKSU1 can only play with gauge U1!"));
         return;
     }
-    const CFieldGaugeU1* pFieldU1 = dynamic_cast<const CFieldGaugeU1*>(pGauge);
 
     Real fRealCoeff = fCoeffReal;
     const CLGComplex cCompCoeff = _make_cuComplex(fCoeffReal, fCoeffImg);
@@ -1575,10 +1406,10 @@ void CFieldFermionKSU1::DDWithMass(const CField* pGauge, Real fMass, EOperatorCo
     }
     CFieldFermionKSU1* pPooled = dynamic_cast<CFieldFermionKSU1*>(appGetLattice()->GetPooledFieldById(m_byFieldId));
 
-    DOperatorKS(pPooled->m_pDeviceData, m_pDeviceData, pFieldU1->m_pDeviceData, fMass,
+    DOperatorKS(pPooled->m_pDeviceData, m_pDeviceData, pU1Links, fMass,
         FALSE, EOCT_None, F(1.0), _make_cuComplex(F(1.0), F(0.0)));
     //why only apply coeff in the next step?
-    DOperatorKS(m_pDeviceData, pPooled->m_pDeviceData, pFieldU1->m_pDeviceData, fMass,
+    DOperatorKS(m_pDeviceData, pPooled->m_pDeviceData, pU1Links, fMass,
         FALSE, eCoeffType, fRealCoeff, cCompCoeff);
 
     pPooled->Return();
@@ -1586,54 +1417,54 @@ void CFieldFermionKSU1::DDWithMass(const CField* pGauge, Real fMass, EOperatorCo
 
 UBOOL CFieldFermionKSU1::InverseD(const CField* pGauge)
 {
-    if (NULL == pGauge || EFT_GaugeU1 != pGauge->GetFieldType())
+    const CLGComplex* pU1Links = CFieldGaugeU1Angle::U1LinksOf(pGauge);
+    if (NULL == pU1Links)
     {
         appCrucial(_T("CFieldFermionWilsonSquareU1 can only play with gauge U1!"));
         return FALSE;
     }
-    const CFieldGaugeU1* pFieldU1 = dynamic_cast<const CFieldGaugeU1*>(pGauge);
 
     //Find a solver to solve me.
-    return appGetFermionSolver(m_byFieldId)->Solve(this, /*this is const*/this, pFieldU1, EFO_F_D);
+    return appGetFermionSolver(m_byFieldId)->Solve(this, /*this is const*/this, dynamic_cast<const CFieldGauge*>(pGauge), EFO_F_D);
 }
 
 UBOOL CFieldFermionKSU1::InverseDdagger(const CField* pGauge)
 {
-    if (NULL == pGauge || EFT_GaugeU1 != pGauge->GetFieldType())
+    const CLGComplex* pU1Links = CFieldGaugeU1Angle::U1LinksOf(pGauge);
+    if (NULL == pU1Links)
     {
         appCrucial(_T("CFieldFermionWilsonSquareU1 can only play with gauge U1!"));
         return FALSE;
     }
-    const CFieldGaugeU1* pFieldU1 = dynamic_cast<const CFieldGaugeU1*>(pGauge);
 
     //Find a solver to solve me.
-    return appGetFermionSolver(m_byFieldId)->Solve(this, /*this is const*/this, pFieldU1, EFO_F_Ddagger);
+    return appGetFermionSolver(m_byFieldId)->Solve(this, /*this is const*/this, dynamic_cast<const CFieldGauge*>(pGauge), EFO_F_Ddagger);
 }
 
 UBOOL CFieldFermionKSU1::InverseDDdagger(const CField* pGauge)
 {
-    if (NULL == pGauge || EFT_GaugeU1 != pGauge->GetFieldType())
+    const CLGComplex* pU1Links = CFieldGaugeU1Angle::U1LinksOf(pGauge);
+    if (NULL == pU1Links)
     {
         appCrucial(_T("CFieldFermionWilsonSquareU1 can only play with gauge U1!"));
         return FALSE;
     }
-    const CFieldGaugeU1* pFieldU1 = dynamic_cast<const CFieldGaugeU1*>(pGauge);
 
     //Find a solver to solve me.
-    return appGetFermionSolver(m_byFieldId)->Solve(this, /*this is const*/this, pFieldU1, EFO_F_DDdagger);
+    return appGetFermionSolver(m_byFieldId)->Solve(this, /*this is const*/this, dynamic_cast<const CFieldGauge*>(pGauge), EFO_F_DDdagger);
 }
 
 UBOOL CFieldFermionKSU1::InverseDD(const CField* pGauge)
 {
-    if (NULL == pGauge || EFT_GaugeU1 != pGauge->GetFieldType())
+    const CLGComplex* pU1Links = CFieldGaugeU1Angle::U1LinksOf(pGauge);
+    if (NULL == pU1Links)
     {
         appCrucial(_T("CFieldFermionWilsonSquareU1 can only play with gauge U1!"));
         return FALSE;
     }
-    const CFieldGaugeU1* pFieldU1 = dynamic_cast<const CFieldGaugeU1*>(pGauge);
 
     //Find a solver to solve me.
-    return appGetFermionSolver(m_byFieldId)->Solve(this, /*this is const*/this, pFieldU1, EFO_F_DD);
+    return appGetFermionSolver(m_byFieldId)->Solve(this, /*this is const*/this, dynamic_cast<const CFieldGauge*>(pGauge), EFO_F_DD);
 }
 
 void CFieldFermionKSU1::InitialAsSource(const SFermionSource& sourceData)
@@ -1757,6 +1588,7 @@ CCString CFieldFermionKSU1::GetInfos(const CCString& tab) const
 void CFieldFermionKSU1::PrepareForHMCOnlyRandomize()
 {
     preparethread;
+    appGetLattice()->m_pRandom->NextLaunch();
     _kernelInitialFermionKSU1 << <block, threads >> > (
         m_pDeviceData,
         m_byFieldId,
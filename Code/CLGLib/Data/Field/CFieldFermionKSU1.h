@@ -36,6 +36,7 @@ public:
     void InitialFieldWithFile(const CCString&, EFieldFileType) override;
     void InitialWithByte(BYTE* byData) override;
     void InitialOtherParameters(CParameters& params) override;
+    void SetRationalApproximation(const TArray<Real>& md, const TArray<Real>& mc) override;
     void DebugPrintMe() const override;
 
     void Dagger() override;
@@ -47,6 +48,7 @@ public:
     void Axpy(const CLGComplex& a, const CField* x) override;
     void ScalarMultply(const CLGComplex& a) override;
     void ScalarMultply(Real a) override;
+    void LinearCombine(UINT uiCount, const CField* const* pFields, const CLGComplex* pCoeffs) override;
 #if !_CLG_DOUBLEFLOAT
     cuDoubleComplex Dot(const CField* other) const override;
 #else
@@ -370,6 +370,30 @@ static __device__ __inline__ CLGComplex _deviceVXYTOptimizedU1(
     return sRet1;
 }
 
+/**
+ * The path policy of the rotation terms, see TFermionKSKernel.h
+ */
+struct SKSRotationPathU1
+{
+    const CLGComplex* m_pGauge;
+    BYTE m_byGaugeFieldId;
+
+    __device__ __inline__ CLGComplex XXTau(const SSmallInt4& sSite, UINT bXorY, UBOOL bPlusMu, UBOOL bPlusTau) const
+    {
+        return _deviceVXXTauOptimizedU1(m_pGauge, sSite, m_byGaugeFieldId, bXorY, bPlusMu, bPlusTau);
+    }
+
+    __device__ __inline__ CLGComplex XYTau(const SSmallInt4& sSite, UBOOL bPlusX, UBOOL bPlusY, UBOOL bPlusTau) const
+    {
+        return _deviceVXYTOptimizedU1(m_pGauge, sSite, m_byGaugeFieldId, bPlusX, bPlusY, bPlusTau);
+    }
+
+    __device__ __inline__ CLGComplex Link(const SSmallInt4& sSite, BYTE byLength, const INT* pDir) const
+    {
+        return _deviceLinkU1(m_pGauge, sSite, byLength, m_byGaugeFieldId, pDir);
+    }
+};
+
 #pragma endregion
 
 __END_NAMESPACE
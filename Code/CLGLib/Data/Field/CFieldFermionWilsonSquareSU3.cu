@@ -20,6 +20,46 @@ __CLGIMPLEMENT_CLASS(CFieldFermionWilsonSquareSU3)
 
 #pragma region kernel
 
+/**
+* The BLAS fused into D, see ApplyOperatorFused
+* res = b - res, pDot = <phi, res>, pNorm = <res, res>
+*/
+static __device__ __inline__ void _deviceFusionWilsonSquareSU3(
+    deviceWilsonVectorSU3& res,
+    const deviceWilsonVectorSU3& phi,
+    UINT uiSiteIndex,
+    const deviceWilsonVectorSU3* __restrict__ pB,
+#if !_CLG_DOUBLEFLOAT
+    cuDoubleComplex* pDot,
+    DOUBLE* pNorm
+#else
+    CLGComplex* pDot,
+    Real* pNorm
+#endif
+    )
+{
+    if (NULL != pB)
+    {
+        deviceWilsonVectorSU3 bMinus = pB[uiSiteIndex];
+        bMinus.Sub(res);
+        res = bMinus;
+    }
+
+    if (NULL != pDot)
+    {
+#if !_CLG_DOUBLEFLOAT
+        pDot[uiSiteIndex] = _cToDouble(phi.ConjugateDotC(res));
+#else
+        pDot[uiSiteIndex] = phi.ConjugateDotC(res);
+#endif
+    }
+
+    if (NULL != pNorm)
+    {
+        pNorm[uiSiteIndex] = res.ConjugateDotC(res).x;
+    }
+}
+
 /**
 * Dw phi(x) = phi(x) - kai sum _mu (1-gamma _mu) U(x,mu) phi(x+ mu) + (1+gamma _mu) U^{dagger}(x-mu) phi(x-mu)
 * U act on su3
@@ -40,9 +80,23 @@ _kernelDFermionWilsonSquareSU3(
     UBOOL bDDagger,
     EOperatorCoefficientType eCoeff,
     Real fCoeff,
-    CLGComplex cCoeff)
+    CLGComplex cCoeff,
+    SXPlaneRange sRange,
+    const deviceWilsonVectorSU3* __restrict__ pB,
+#if !_CLG_DOUBLEFLOAT
+    cuDoubleComplex* pDot,
+    DOUBLE* pNorm
+#else
+    CLGComplex* pDot,
+    Real* pNorm
+#endif
+    )
 {
     intokernaldir;
+    if (sRange.Skip(static_cast<INT>(uiSiteIndex / _DC_MultX)))
+    {
+        return;
+    }
 
     //const SSmallInt4 test = __deviceSiteIndexToInt4(uiSiteIndex);
 
@@ -159,6 +213,11 @@ _kernelDFermionWilsonSquareSU3(
         pResultData[uiSiteIndex].MulComp(cCoeff);
         break;
     }
+
+    if (NULL != pB || NULL != pDot || NULL != pNorm)
+    {
+        _deviceFusionWilsonSquareSU3(pResultData[uiSiteIndex], pDeviceData[uiSiteIndex], uiSiteIndex, pB, pDot, pNorm);
+    }
 }
 
 /**
@@ -229,31 +288,261 @@ _kernelDWilsonForceSU3(
     }
 }
 
+#if _CLG_DIRECT_STENCIL
+
+/**
+* Same as _kernelDFermionWilsonSquareSU3, but the neighbours are computed on torus.
+* sBC is the boundary condition of the fermion, the gauge field must be periodic
+*/
+__global__ void _CLG_LAUNCH_BOUND
+_kernelDFermionWilsonSquareSU3Torus(
+    const deviceWilsonVectorSU3* __restrict__ pDeviceData,
+    const deviceSU3* __restrict__ pGauge,
+    deviceWilsonVectorSU3* pResultData,
+    Real kai,
+    SSmallInt4 sBC,
+    UBOOL bDDagger,
+    EOperatorCoefficientType eCoeff,
+    Real fCoeff,
+    CLGComplex cCoeff,
+    SXPlaneRange sRange,
+    const deviceWilsonVectorSU3* __restrict__ pB,
+#if !_CLG_DOUBLEFLOAT
+    cuDoubleComplex* pDot,
+    DOUBLE* pNorm
+#else
+    CLGComplex* pDot,
+    Real* pNorm
+#endif
+    )
+{
+    intokernalInt4;
+    if (sRange.Skip(sSite4.x))
+    {
+        return;
+    }
+    const BYTE uiDir = static_cast<BYTE>(_DC_Dir);
+
+    const gammaMatrix & gamma5 = __chiralGamma[GAMMA5];
+    deviceWilsonVectorSU3 result = deviceWilsonVectorSU3::makeZeroWilsonVectorSU3();
+    pResultData[uiSiteIndex] = pDeviceData[uiSiteIndex];
+    if (bDDagger)
+    {
+        pResultData[uiSiteIndex] = gamma5.MulWilsonC(pResultData[uiSiteIndex]);
+    }
+
+    //idir = mu
+    for (BYTE idir = 0; idir < uiDir; ++idir)
+    {
+        //Get Gamma mu
+        const gammaMatrix & gammaMu = __chiralGamma[GAMMA1 + idir];
+
+        //x, mu
+        const UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
+
+        SSmallInt4 x_p_mu = sSite4;
+        const UBOOL bOppositeForward = _deviceTorusMove(x_p_mu, idir + 1, sBC);
+        SSmallInt4 x_m_mu = sSite4;
+        const UBOOL bOppositeBackward = _deviceTorusMove(x_m_mu, -static_cast<INT>(idir) - 1, sBC);
+        const UINT uiSite_m_mu = _deviceGetSiteIndex(x_m_mu);
+
+        //get U(x,mu), U^{dagger}(x-mu), 
+        const deviceSU3 & x_Gauge_element = pGauge[linkIndex];
+        deviceSU3 x_m_mu_Gauge_element = pGauge[_deviceGetLinkIndex(uiSite_m_mu, idir)];
+        x_m_mu_Gauge_element.Dagger();
+
+        deviceWilsonVectorSU3 x_p_mu_Fermion_element = pDeviceData[_deviceGetSiteIndex(x_p_mu)];
+        deviceWilsonVectorSU3 x_m_mu_Fermion_element = pDeviceData[uiSite_m_mu];
+
+        if (bDDagger)
+        {
+            x_p_mu_Fermion_element = gamma5.MulWilsonC(x_p_mu_Fermion_element);
+            x_m_mu_Fermion_element = gamma5.MulWilsonC(x_m_mu_Fermion_element);
+        }
+
+        //U(x,mu) phi(x+ mu)
+        deviceWilsonVectorSU3 u_phi_x_p_m = x_Gauge_element.MulWilsonVector(x_p_mu_Fermion_element);
+        if (bOppositeForward)
+        {
+            result.Sub(u_phi_x_p_m);
+            result.Add(gammaMu.MulWilsonC(u_phi_x_p_m));
+        }
+        else
+        {
+            result.Add(u_phi_x_p_m);
+            result.Sub(gammaMu.MulWilsonC(u_phi_x_p_m));
+        }
+
+        //U^{dagger}(x-mu) phi(x-mu)
+        deviceWilsonVectorSU3 u_dagger_phi_x_m_m = x_m_mu_Gauge_element.MulWilsonVector(x_m_mu_Fermion_element);
+        if (bOppositeBackward)
+        {
+            result.Sub(u_dagger_phi_x_m_m);
+            result.Sub(gammaMu.MulWilsonC(u_dagger_phi_x_m_m));
+        }
+        else
+        {
+            result.Add(u_dagger_phi_x_m_m);
+            result.Add(gammaMu.MulWilsonC(u_dagger_phi_x_m_m));
+        }
+    }
+
+    //result = phi(x) - kai sum _mu result
+    result.MulReal(kai);
+    pResultData[uiSiteIndex].Sub(result);
+
+    if (bDDagger)
+    {
+        pResultData[uiSiteIndex] = gamma5.MulWilsonC(pResultData[uiSiteIndex]);
+    }
+
+    switch (eCoeff)
+    {
+    case EOCT_Real:
+        pResultData[uiSiteIndex].MulReal(fCoeff);
+        break;
+    case EOCT_Complex:
+        pResultData[uiSiteIndex].MulComp(cCoeff);
+        break;
+    }
+
+    if (NULL != pB || NULL != pDot || NULL != pNorm)
+    {
+        _deviceFusionWilsonSquareSU3(pResultData[uiSiteIndex], pDeviceData[uiSiteIndex], uiSiteIndex, pB, pDot, pNorm);
+    }
+}
+
+/**
+* Same as _kernelDWilsonForceSU3, but the neighbours are computed on torus.
+*/
+__global__ void _CLG_LAUNCH_BOUND
+_kernelDWilsonForceSU3Torus(
+    const deviceWilsonVectorSU3* __restrict__ pInverseD,
+    const deviceWilsonVectorSU3* __restrict__ pInverseDDdagger,
+    const deviceSU3* __restrict__ pGauge,
+    deviceSU3* pForce,
+    Real fKai,
+    SSmallInt4 sBC)
+{
+    intokernalInt4;
+    const BYTE uiDir = static_cast<BYTE>(_DC_Dir);
+
+    const deviceWilsonVectorSU3 & x_Left  = pInverseDDdagger[uiSiteIndex];
+    const deviceWilsonVectorSU3 & x_Right = pInverseD[uiSiteIndex];
+
+    //idir = mu
+    for (BYTE idir = 0; idir < uiDir; ++idir)
+    {
+        //Get Gamma mu
+        const gammaMatrix & gammaMu = __chiralGamma[GAMMA1 + idir];
+
+        //x, mu
+        const UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
+
+        SSmallInt4 x_p_mu = sSite4;
+        const UBOOL bOpposite = _deviceTorusMove(x_p_mu, idir + 1, sBC);
+        const UINT uiSite_p_mu = _deviceGetSiteIndex(x_p_mu);
+
+        const deviceWilsonVectorSU3& x_p_mu_Right = pInverseD[uiSite_p_mu];
+        const deviceWilsonVectorSU3& x_p_mu_Left = pInverseDDdagger[uiSite_p_mu];
+
+        const deviceSU3& x_Gauge_element = pGauge[linkIndex];
+
+        deviceWilsonVectorSU3 right1(x_p_mu_Right);
+        right1.Sub(gammaMu.MulWilsonC(right1));
+        deviceSU3 mid = deviceSU3::makeSU3Contract(x_Left, right1);
+
+        deviceWilsonVectorSU3 right2(x_Right);
+        right2.Add(gammaMu.MulWilsonC(right2));
+        mid.Add(deviceSU3::makeSU3Contract(right2, x_p_mu_Left));
+
+        deviceSU3 forceOfThisLink = x_Gauge_element.MulC(mid);
+        forceOfThisLink.Ta();
+        forceOfThisLink.MulReal(bOpposite ? -fKai : fKai);
+
+        pForce[linkIndex].Add(forceOfThisLink);
+    }
+}
+
+#endif
+
 #pragma endregion
 
 void CFieldFermionWilsonSquareSU3::DOperator(void* pTargetBuffer, const void* pBuffer, 
     const void* pGaugeBuffer, 
     UBOOL bDagger, EOperatorCoefficientType eOCT, 
     Real fRealCoeff, const CLGComplex& cCmpCoeff) const
+{
+    DOperatorFused(pTargetBuffer, pBuffer, pGaugeBuffer, bDagger, eOCT, fRealCoeff, cCmpCoeff, NULL, NULL, NULL);
+}
+
+void CFieldFermionWilsonSquareSU3::DOperatorFused(void* pTargetBuffer, const void* pBuffer,
+    const void* pGaugeBuffer,
+    UBOOL bDagger, EOperatorCoefficientType eOCT,
+    Real fRealCoeff, const CLGComplex& cCmpCoeff,
+    const deviceWilsonVectorSU3* pB,
+#if !_CLG_DOUBLEFLOAT
+    cuDoubleComplex* pDot,
+    DOUBLE* pNorm
+#else
+    CLGComplex* pDot,
+    Real* pNorm
+#endif
+    ) const
 {
     deviceWilsonVectorSU3* pTarget = (deviceWilsonVectorSU3*)pTargetBuffer;
     const deviceWilsonVectorSU3* pSource = (deviceWilsonVectorSU3*)pBuffer;
     const deviceSU3* pGauge = (const deviceSU3*)pGaugeBuffer;
+    const UINT uiBytes = static_cast<UINT>(sizeof(deviceWilsonVectorSU3));
 
-    preparethread;
-    _kernelDFermionWilsonSquareSU3 << <block, threads >> > (
-        pSource,
-        pGauge,
-        appGetLattice()->m_pIndexCache->m_pGaugeMoveCache[m_byFieldId],
-        appGetLattice()->m_pIndexCache->m_pFermionMoveCache[m_byFieldId],
-        pTarget, 
-        m_fKai, 
-        m_byFieldId, 
-        bDagger,
-        eOCT,
-        fRealCoeff, 
-        cCmpCoeff);
-
+#if _CLG_DIRECT_STENCIL
+    if (appGetLattice()->m_pIndex->UseDirectStencil(1))
+    {
+        preparethread;
+        //the inner planes overlap the halo exchange, see appBeginExchangeHalo
+        SXPlaneRange sRange = appBeginExchangeHalo(pBuffer, uiBytes, 1);
+        do
+        {
+            _kernelDFermionWilsonSquareSU3Torus << <block, threads >> > (
+                pSource,
+                pGauge,
+                pTarget,
+                m_fKai,
+                appGetLattice()->m_pIndex->m_pBoundaryCondition->GetFieldBC(m_byFieldId),
+                bDagger,
+                eOCT,
+                fRealCoeff,
+                cCmpCoeff,
+                sRange,
+                pB,
+                pDot,
+                pNorm);
+        } while (appEndExchangeHalo(pBuffer, uiBytes, sRange));
+        return;
+    }
+#endif
+    preparethread_tuned(_T("_kernelDFermionWilsonSquareSU3"));
+    SXPlaneRange sRange = appBeginExchangeHalo(pBuffer, uiBytes, 1);
+    do
+    {
+        _kernelDFermionWilsonSquareSU3 << <block, threads >> > (
+            pSource,
+            pGauge,
+            appGetLattice()->m_pIndexCache->m_pGaugeMoveCache[m_byFieldId],
+            appGetLattice()->m_pIndexCache->m_pFermionMoveCache[m_byFieldId],
+            pTarget, 
+            m_fKai, 
+            m_byFieldId, 
+            bDagger,
+            eOCT,
+            fRealCoeff, 
+            cCmpCoeff,
+            sRange,
+            pB,
+            pDot,
+            pNorm);
+    } while (appEndExchangeHalo(pBuffer, uiBytes, sRange));
+    finishthread_tuned;
 }
 
 void CFieldFermionWilsonSquareSU3::DerivateDOperator(void* pForce, const void* pDphi, const void* pDDphi, const void* pGaugeBuffer) const
@@ -264,6 +553,19 @@ void CFieldFermionWilsonSquareSU3::DerivateDOperator(void* pForce, const void* p
     const deviceWilsonVectorSU3* pDDphiBuffer = (deviceWilsonVectorSU3*)pDDphi;
 
     preparethread;
+#if _CLG_DIRECT_STENCIL
+    if (appGetLattice()->m_pIndex->UseDirectStencil(1))
+    {
+        _kernelDWilsonForceSU3Torus << <block, threads >> > (
+            pDphiBuffer,
+            pDDphiBuffer,
+            pGauge,
+            pForceSU3,
+            m_fKai,
+            appGetLattice()->m_pIndex->m_pBoundaryCondition->GetFieldBC(m_byFieldId));
+        return;
+    }
+#endif
     _kernelDWilsonForceSU3 << <block, threads >> > (
         pDphiBuffer,
         pDDphiBuffer,
@@ -452,6 +754,7 @@ _kernelInitialFermionWilsonSquareSU3(
     EFieldInitialType eInitialType)
 {
     intokernalInt4;
+    SRandomDraw uiDraw;
 
     switch (eInitialType)
     {
@@ -467,12 +770,12 @@ _kernelInitialFermionWilsonSquareSU3(
     break;
     case EFIT_RandomGaussian:
     {
-        pDevicePtr[uiSiteIndex] = deviceWilsonVectorSU3::makeRandomGaussian(_deviceGetFatIndex(uiSiteIndex, 0));
+        pDevicePtr[uiSiteIndex] = deviceWilsonVectorSU3::makeRandomGaussian(_deviceGetFatIndex(uiSiteIndex, 0), uiDraw);
     }
     break;
     case EFIT_RandomZ4:
     {
-        pDevicePtr[uiSiteIndex] = deviceWilsonVectorSU3::makeRandomZ4(_deviceGetFatIndex(uiSiteIndex, 0));
+        pDevicePtr[uiSiteIndex] = deviceWilsonVectorSU3::makeRandomZ4(_deviceGetFatIndex(uiSiteIndex, 0), uiDraw);
     }
     break;
     default:
@@ -569,6 +872,7 @@ void CFieldFermionWilsonSquareSU3::InitialField(EFieldInitialType eInitialType)
 {
     preparethread;
 
+    appGetLattice()->m_pRandom->NextLaunch();
     _kernelInitialFermionWilsonSquareSU3 << <block, threads >> > (m_pDeviceData, m_byFieldId, eInitialType);
 }
 
@@ -825,6 +1129,22 @@ void CFieldFermionWilsonSquareSU3::ScalarMultply(Real a)
     _kernelScalarMultiplyReal << <block, threads >> >(m_pDeviceData, a);
 }
 
+void CFieldFermionWilsonSquareSU3::LinearCombine(UINT uiCount, const CField* const* pFields, const CLGComplex* pCoeffs)
+{
+    const CLGComplex* pData[_kLinearCombineMaxTerm];
+    for (UINT i = 0; i < uiCount; ++i)
+    {
+        if (i >= _kLinearCombineMaxTerm || NULL == pFields[i] || EFT_FermionWilsonSquareSU3 != pFields[i]->GetFieldType())
+        {
+            //let the ScalarMultply and Axpy report the wrong field
+            CField::LinearCombine(uiCount, pFields, pCoeffs);
+            return;
+        }
+        pData[i] = (const CLGComplex*)(dynamic_cast<const CFieldFermionWilsonSquareSU3*>(pFields[i])->m_pDeviceData);
+    }
+    _LinearCombineComplex((CLGComplex*)m_pDeviceData, 12, uiCount, pData, pCoeffs);
+}
+
 void CFieldFermionWilsonSquareSU3::ApplyGamma(EGammaMatrix eGamma)
 {
     preparethread;
@@ -844,6 +1164,7 @@ void CFieldFermionWilsonSquareSU3::PrepareForHMC(const CFieldGauge* pGauge)
     const CFieldGaugeSU3 * pFieldSU3 = dynamic_cast<const CFieldGaugeSU3*>(pGauge);
     CFieldFermionWilsonSquareSU3* pPooled = dynamic_cast<CFieldFermionWilsonSquareSU3*>(appGetLattice()->GetPooledFieldById(m_byFieldId));
     preparethread;
+    appGetLattice()->m_pRandom->NextLaunch();
     _kernelInitialFermionWilsonSquareSU3 << <block, threads >> > (
         pPooled->m_pDeviceData,
         m_byFieldId,
@@ -983,6 +1304,73 @@ void CFieldFermionWilsonSquareSU3::DD(const CField* pGauge, EOperatorCoefficient
     pPooled->Return();
 }
 
+UBOOL CFieldFermionWilsonSquareSU3::ApplyOperatorFused(EFieldOperator op, const CField* pGauge, SOperatorFusion& fusion,
+    EOperatorCoefficientType eCoeffType, Real fCoeffReal, Real fCoeffImg, void* pOtherParameters)
+{
+    const UBOOL bBMinus = fusion.IsFused(EOF_BMinus);
+    const UBOOL bDotSource = fusion.IsFused(EOF_DotSource);
+
+    //The last pass of DD does not see x, so <x, DD x> is not fused
+    if (CFieldFermionWilsonSquareSU3::StaticClass() != GetClass()
+     || NULL == pGauge || EFT_GaugeSU3 != pGauge->GetFieldType()
+     || (bBMinus && (NULL == fusion.m_pB || EFT_FermionWilsonSquareSU3 != fusion.m_pB->GetFieldType()))
+     || (EFO_F_D != op && EFO_F_Ddagger != op && EFO_F_DD != op && EFO_F_DDdagger != op)
+     || (bDotSource && (EFO_F_DD == op || (EFO_F_DDdagger == op && bBMinus))))
+    {
+        return CFieldFermion::ApplyOperatorFused(op, pGauge, fusion, eCoeffType, fCoeffReal, fCoeffImg, pOtherParameters);
+    }
+
+    const CFieldGaugeSU3* pFieldSU3 = dynamic_cast<const CFieldGaugeSU3*>(pGauge);
+    const deviceWilsonVectorSU3* pB = bBMinus ? dynamic_cast<const CFieldFermionWilsonSquareSU3*>(fusion.m_pB)->m_pDeviceData : NULL;
+#if !_CLG_DOUBLEFLOAT
+    cuDoubleComplex* pDot = bDotSource ? _D_ComplexThreadBuffer : NULL;
+    DOUBLE* pNorm = fusion.IsFused(EOF_Norm) ? _D_RealThreadBuffer : NULL;
+#else
+    CLGComplex* pDot = bDotSource ? _D_ComplexThreadBuffer : NULL;
+    Real* pNorm = fusion.IsFused(EOF_Norm) ? _D_RealThreadBuffer : NULL;
+#endif
+
+    Real fRealCoeff = fCoeffReal;
+    const CLGComplex cCompCoeff = _make_cuComplex(fCoeffReal, fCoeffImg);
+    if (EOCT_Minus == eCoeffType)
+    {
+        eCoeffType = EOCT_Real;
+        fRealCoeff = F(-1.0);
+    }
+    CFieldFermionWilsonSquareSU3* pPooled = dynamic_cast<CFieldFermionWilsonSquareSU3*>(appGetLattice()->GetPooledFieldById(m_byFieldId));
+
+    if (EFO_F_D == op || EFO_F_Ddagger == op)
+    {
+        checkCudaErrors(cudaMemcpy(pPooled->m_pDeviceData, m_pDeviceData, sizeof(deviceWilsonVectorSU3) * m_uiSiteCount, cudaMemcpyDeviceToDevice));
+        DOperatorFused(m_pDeviceData, pPooled->m_pDeviceData, pFieldSU3->m_pDeviceData,
+            EFO_F_Ddagger == op, eCoeffType, fRealCoeff, cCompCoeff, pB, pDot, pNorm);
+        if (bDotSource)
+        {
+            fusion.m_cDot = appGetCudaHelper()->ThreadBufferSum(_D_ComplexThreadBuffer);
+        }
+    }
+    else
+    {
+        //<x, c D D^+ x> = c |D^+ x|^2, calculated in the first pass
+        DOperatorFused(pPooled->m_pDeviceData, m_pDeviceData, pFieldSU3->m_pDeviceData,
+            EFO_F_DDdagger == op, EOCT_None, F(1.0), _make_cuComplex(F(1.0), F(0.0)),
+            NULL, NULL, bDotSource ? _D_RealThreadBuffer : NULL);
+        if (bDotSource)
+        {
+            fusion.SetDotByNorm(appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer), eCoeffType, fRealCoeff, cCompCoeff);
+        }
+        DOperatorFused(m_pDeviceData, pPooled->m_pDeviceData, pFieldSU3->m_pDeviceData,
+            FALSE, eCoeffType, fRealCoeff, cCompCoeff, pB, NULL, pNorm);
+    }
+
+    if (NULL != pNorm)
+    {
+        fusion.m_fNorm = appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
+    }
+    pPooled->Return();
+    return TRUE;
+}
+
 UBOOL CFieldFermionWilsonSquareSU3::InverseD(const CField* pGauge)
 {
     if (m_byEvenFieldId > 0)
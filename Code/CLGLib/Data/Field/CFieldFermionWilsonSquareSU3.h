@@ -52,6 +52,7 @@ public:
     void Axpy(const CLGComplex& a, const CField* x) override;
     void ScalarMultply(const CLGComplex& a) override;
     void ScalarMultply(Real a) override;
+    void LinearCombine(UINT uiCount, const CField* const* pFields, const CLGComplex* pCoeffs) override;
 #if !_CLG_DOUBLEFLOAT
     cuDoubleComplex Dot(const CField* other) const override;
 #else
@@ -75,6 +76,12 @@ public:
     void DD(const CField* pGauge, EOperatorCoefficientType eCoeffType = EOCT_None, Real fCoeffReal = F(1.0), Real fCoeffImg = F(0.0)) override;
     void DDdagger(const CField* pGauge, EOperatorCoefficientType eCoeffType = EOCT_None, Real fCoeffReal = F(1.0), Real fCoeffImg = F(0.0)) override;
 
+    /**
+    * D, Ddagger, DD and DDdagger with the BLAS fused into the last pass
+    * The derived classes (with their own DOperator) are not fused
+    */
+    UBOOL ApplyOperatorFused(EFieldOperator op, const CField* pGauge, SOperatorFusion& fusion, EOperatorCoefficientType eCoeffType = EOCT_None, Real fCoeffReal = F(1.0), Real fCoeffImg = F(0.0), void* pOtherParameters = NULL) override;
+
     void DWithMass(const CField* , Real , EOperatorCoefficientType , Real , Real ) override
     {
         appCrucial(_T("Not supported for Wilson direct fermion!\n"));
@@ -125,6 +132,21 @@ protected:
     UBOOL InverseDdagger_eo(const CField*) override;
     UBOOL InverseDDdagger_eo(const CField*) override;
 
+    /**
+    * DOperator with the BLAS in SOperatorFusion, pB, pDot and pNorm can be NULL
+    */
+    void DOperatorFused(void* pTargetBuffer, const void* pBuffer, const void* pGaugeBuffer,
+        UBOOL bDagger, EOperatorCoefficientType eOCT, Real fRealCoeff, const CLGComplex& cCmpCoeff,
+        const deviceWilsonVectorSU3* pB,
+#if !_CLG_DOUBLEFLOAT
+        cuDoubleComplex* pDot,
+        DOUBLE* pNorm
+#else
+        CLGComplex* pDot,
+        Real* pNorm
+#endif
+        ) const;
+
     Real m_fKai;
 
     //Not using, this is used in "Dot1" which create a thread for each element of a Wilson vector
@@ -289,6 +289,7 @@ _kernelInitialFermionWilsonSquareSU3ForHMC(
     BYTE byFieldId)
 {
     intokernalInt4;
+    SRandomDraw uiDraw;
 
     const UINT bigIdx = __idx->_deviceGetBigIndex(sSite4);
     const SIndex sIdx = __idx->m_pDeviceIndexPositionToSIndex[byFieldId][bigIdx];
@@ -298,7 +299,7 @@ _kernelInitialFermionWilsonSquareSU3ForHMC(
     }
     else
     {
-        pDevicePtr[uiSiteIndex] = deviceWilsonVectorSU3::makeRandomGaussian(_deviceGetFatIndex(uiSiteIndex, 0));
+        pDevicePtr[uiSiteIndex] = deviceWilsonVectorSU3::makeRandomGaussian(_deviceGetFatIndex(uiSiteIndex, 0), uiDraw);
     }
 }
 
@@ -331,6 +332,7 @@ void CFieldFermionWilsonSquareSU3D::PrepareForHMC(const CFieldGauge* pGauge)
     const CFieldGaugeSU3 * pFieldSU3 = dynamic_cast<const CFieldGaugeSU3*>(pGauge);
     CFieldFermionWilsonSquareSU3* pPooled = dynamic_cast<CFieldFermionWilsonSquareSU3*>(appGetLattice()->GetPooledFieldById(m_byFieldId));
     preparethread;
+    appGetLattice()->m_pRandom->NextLaunch();
     _kernelInitialFermionWilsonSquareSU3ForHMC << <block, threads >> > (
         pPooled->m_pDeviceData,
         m_byFieldId);
@@ -364,6 +366,7 @@ void CFieldFermionWilsonSquareSU3D::PrepareForHMC(const CFieldGauge* pGauge)
 void CFieldFermionWilsonSquareSU3D::PrepareForHMCOnlyRandomize()
 {
     preparethread;
+    appGetLattice()->m_pRandom->NextLaunch();
     _kernelInitialFermionWilsonSquareSU3ForHMC << <block, threads >> > (
         m_pDeviceData,
         m_byFieldId);
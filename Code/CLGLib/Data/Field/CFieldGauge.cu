@@ -15,8 +15,9 @@ __BEGIN_NAMESPACE
 CFieldGauge::CFieldGauge()
     : CField()
     , m_uiLinkeCount(_HC_Volume * _HC_Dir)
+    , m_uiVersion(0)
 {
-
+    IncreaseVersion();
 }
 
 CFieldGauge::~CFieldGauge()
@@ -36,6 +37,22 @@ void CFieldGauge::CopyTo(CField* U) const
     CField::CopyTo(U);
 
     pFieldGauge->m_uiLinkeCount = m_uiLinkeCount;
+    pFieldGauge->IncreaseVersion();
+}
+
+void CFieldGauge::LinearCombine(UINT uiCount, const CField* const* pFields, const CLGComplex* pCoeffs)
+{
+    CField::LinearCombine(uiCount, pFields, pCoeffs);
+    IncreaseVersion();
+}
+
+void CFieldGauge::IncreaseVersion()
+{
+    static std::atomic<UINT> uiLastVersion(0);
+    m_uiVersion = ++uiLastVersion;
+
+    //Called after the kernels changing the links are launched, the exchange is ordered after them
+    ExchangeHalo();
 }
 
 __END_NAMESPACE
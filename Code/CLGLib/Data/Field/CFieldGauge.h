@@ -104,12 +104,36 @@ public:
 
     void CopyTo(CField* U) const override;
 
+    /**
+    * The links are changed, so the version is increased.
+    * The fields without the linear combine kernel (U1Real, U1Angle, ...) use the ScalarMultply and Axpy here.
+    */
+    void LinearCombine(UINT uiCount, const CField* const* pFields, const CLGComplex* pCoeffs) override;
+
     UBOOL IsGaugeField() const override { return TRUE; }
     UBOOL IsFermionField() const override { return FALSE; }
 
+    /**
+    * The version is changed whenever the links are changed.
+    * The fields calculated from the links (for example the fat links of asqtad) keep the field and the version,
+    * and are rebuilt when either of them is different.
+    * The versions are unique among all gauge fields, so a new field at the same address never has an old version.
+    * Call it after changing the links in place outside of the field (for example gauge fixing and smearing)
+    * When a CDomainDecomposition is attached, it also exchanges the halo of the links.
+    */
+    void IncreaseVersion();
+    UINT GetVersion() const { return m_uiVersion; }
+
+    /**
+    * Exchange the halo planes of the links if a CDomainDecomposition is attached, see appExchangeHalo.
+    * Only the fields used as links by the decomposed Dslash implement it.
+    */
+    virtual void ExchangeHalo() {}
+
 protected:
 
     UINT m_uiLinkeCount;
+    UINT m_uiVersion;
 
 };
 
@@ -36,6 +36,7 @@ _kernelInitialSU3Feield(deviceSU3 *pDevicePtr, EFieldInitialType eInitialType)
     deviceSU3 zero = deviceSU3::makeSU3Zero();
 
     intokernaldir;
+    SRandomDraw uiDraw;
     for (UINT idir = 0; idir < uiDir; ++idir)
     {
         UINT uiLinkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
@@ -54,7 +55,7 @@ _kernelInitialSU3Feield(deviceSU3 *pDevicePtr, EFieldInitialType eInitialType)
         break;
         case EFIT_Random:
         {
-            pDevicePtr[uiLinkIndex] = deviceSU3::makeSU3Random(_deviceGetFatIndex(uiSiteIndex, idir + 1));
+            pDevicePtr[uiLinkIndex] = deviceSU3::makeSU3Random(_deviceGetFatIndex(uiSiteIndex, idir + 1), uiDraw);
             //Real fArg = __cuCargf(pDevicePtr[uiLinkIndex].Tr());
             //pDevicePtr[uiLinkIndex].MulComp(_make_cuComplex(_cos(fArg), -_sin(fArg)));
             //pDevicePtr[uiLinkIndex].Norm();
@@ -63,7 +64,7 @@ _kernelInitialSU3Feield(deviceSU3 *pDevicePtr, EFieldInitialType eInitialType)
         break;
         case EFIT_RandomGenerator:
         {
-            pDevicePtr[uiLinkIndex] = deviceSU3::makeSU3RandomGenerator(_deviceGetFatIndex(uiSiteIndex, idir + 1));
+            pDevicePtr[uiLinkIndex] = deviceSU3::makeSU3RandomGenerator(_deviceGetFatIndex(uiSiteIndex, idir + 1), uiDraw);
         }
         break;
         case EFIT_SumGenerator:
@@ -352,6 +353,151 @@ _kernelPlaqutteEnergySU3CacheIndex(
     //printf("  ---- energy: thread=%d, res=%f\n", __thread_id, results[__thread_id]);
 }
 
+#if _CLG_DIRECT_STENCIL
+
+#pragma region Direct stencil on torus
+
+/**
+* Same as the staple of pStappleCache, but the neighbours are computed on torus.
+* The order of the multiplications is same as the baked staple, so the result is same.
+*/
+static __device__ __inline__ deviceSU3 _deviceStapleSU3Torus(
+    const deviceSU3* __restrict__ pDeviceData,
+    const SSmallInt4& sSite4, UINT uiSiteIndex, BYTE byMu)
+{
+    const SSmallInt4 sPeriodic(1, 1, 1, 1);
+    const BYTE byDim = static_cast<BYTE>(_DC_Dim);
+    SSmallInt4 sWalking = sSite4;
+    _deviceTorusMove(sWalking, byMu + 1, sPeriodic);
+    const UINT uiSite_p_mu = _deviceGetSiteIndex(sWalking);
+
+    deviceSU3 res = deviceSU3::makeSU3Zero();
+    for (BYTE byNu = 0; byNu < byDim; ++byNu)
+    {
+        if (byNu == byMu)
+        {
+            continue;
+        }
+
+        //[site][nu], [site+nu][mu], [site+mu][nu]^+
+        sWalking = sSite4;
+        _deviceTorusMove(sWalking, byNu + 1, sPeriodic);
+        deviceSU3 forward(pDeviceData[_deviceGetLinkIndex(uiSiteIndex, byNu)]);
+        forward.Mul(pDeviceData[_deviceGetLinkIndex(_deviceGetSiteIndex(sWalking), byMu)]);
+        forward.MulDagger(pDeviceData[_deviceGetLinkIndex(uiSite_p_mu, byNu)]);
+        res.Add(forward);
+
+        //[site-nu][nu]^+, [site-nu][mu], [site-nu+mu][nu]
+        sWalking = sSite4;
+        _deviceTorusMove(sWalking, -static_cast<INT>(byNu) - 1, sPeriodic);
+        const UINT uiSite_m_nu = _deviceGetSiteIndex(sWalking);
+        _deviceTorusMove(sWalking, byMu + 1, sPeriodic);
+        deviceSU3 backward(pDeviceData[_deviceGetLinkIndex(uiSite_m_nu, byNu)]);
+        backward.Dagger();
+        backward.Mul(pDeviceData[_deviceGetLinkIndex(uiSite_m_nu, byMu)]);
+        backward.Mul(pDeviceData[_deviceGetLinkIndex(_deviceGetSiteIndex(sWalking), byNu)]);
+        res.Add(backward);
+    }
+    return res;
+}
+
+__global__ void _CLG_LAUNCH_BOUND
+_kernelStapleAtSiteSU3Torus(
+    const deviceSU3 * __restrict__ pDeviceData,
+    deviceSU3 *pStapleData, //can be NULL
+    deviceSU3 *pForceData,
+    Real betaOverN)
+{
+    intokernalInt4;
+    const BYTE uiDir = static_cast<BYTE>(_DC_Dir);
+
+    betaOverN = betaOverN * F(-0.5);
+    for (BYTE idir = 0; idir < uiDir; ++idir)
+    {
+        const UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
+        const deviceSU3 res = _deviceStapleSU3Torus(pDeviceData, sSite4, uiSiteIndex, idir);
+        if (NULL != pStapleData)
+        {
+            pStapleData[linkIndex] = res;
+        }
+
+        deviceSU3 force(pDeviceData[linkIndex]);
+        force.MulDagger(res);
+        force.Ta();
+        force.MulReal(betaOverN);
+        pForceData[linkIndex].Add(force);
+    }
+}
+
+__global__ void _CLG_LAUNCH_BOUND
+_kernelCalculateOnlyStapleTorus(
+    const deviceSU3 * __restrict__ pDeviceData,
+    deviceSU3 *pStapleData)
+{
+    intokernalInt4;
+    const BYTE uiDir = static_cast<BYTE>(_DC_Dir);
+
+    for (BYTE idir = 0; idir < uiDir; ++idir)
+    {
+        pStapleData[_deviceGetLinkIndex(uiSiteIndex, idir)] = _deviceStapleSU3Torus(pDeviceData, sSite4, uiSiteIndex, idir);
+    }
+}
+
+/**
+* Same as _kernelPlaqutteEnergySU3CacheIndex, the plaqutte is
+* [site][mu], [site+mu][nu], [site+nu][mu]^+, [site][nu]^+
+*/
+__global__ void _CLG_LAUNCH_BOUND
+_kernelPlaqutteEnergySU3Torus(
+    const deviceSU3 * __restrict__ pDeviceData,
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE betaOverN,
+    DOUBLE* results
+#else
+    Real betaOverN,
+    Real* results
+#endif
+)
+{
+    intokernalInt4;
+    const SSmallInt4 sPeriodic(1, 1, 1, 1);
+    const BYTE byDim = static_cast<BYTE>(_DC_Dim);
+
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE resThisThread = 0.0;
+#else
+    Real resThisThread = F(0.0);
+#endif
+    for (BYTE byMu = 0; byMu < byDim; ++byMu)
+    {
+        SSmallInt4 sWalking = sSite4;
+        _deviceTorusMove(sWalking, byMu + 1, sPeriodic);
+        const UINT uiSite_p_mu = _deviceGetSiteIndex(sWalking);
+        for (BYTE byNu = byMu + 1; byNu < byDim; ++byNu)
+        {
+            sWalking = sSite4;
+            _deviceTorusMove(sWalking, byNu + 1, sPeriodic);
+
+            deviceSU3 toAdd(pDeviceData[_deviceGetLinkIndex(uiSiteIndex, byMu)]);
+            toAdd.Mul(pDeviceData[_deviceGetLinkIndex(uiSite_p_mu, byNu)]);
+            toAdd.MulDagger(pDeviceData[_deviceGetLinkIndex(_deviceGetSiteIndex(sWalking), byMu)]);
+            toAdd.MulDagger(pDeviceData[_deviceGetLinkIndex(uiSiteIndex, byNu)]);
+
+#if !_CLG_DOUBLEFLOAT
+            resThisThread += (3.0 - toAdd.ReTr());
+#else
+            resThisThread += (F(3.0) - toAdd.ReTr());
+#endif
+        }
+    }
+
+    results[uiSiteIndex] = resThisThread * betaOverN;
+}
+
+#pragma endregion
+
+#endif
+
 __global__ void _CLG_LAUNCH_BOUND
 _kernelPlaqutteEnergySU3_UseClover(
     BYTE byFieldId,
@@ -907,6 +1053,7 @@ void CFieldGaugeSU3::AxpyPlus(const CField* x)
     const CFieldGaugeSU3* pSU3x = dynamic_cast<const CFieldGaugeSU3*>(x);
     preparethread;
     _kernelAxpyPlusSU3 << <block, threads >> > (m_pDeviceData, pSU3x->m_pDeviceData);
+    IncreaseVersion();
 }
 
 void CFieldGaugeSU3::AxpyMinus(const CField* x)
@@ -920,19 +1067,21 @@ void CFieldGaugeSU3::AxpyMinus(const CField* x)
     const CFieldGaugeSU3* pSU3x = dynamic_cast<const CFieldGaugeSU3*>(x);
     preparethread;
     _kernelAxpyMinusSU3 << <block, threads >> > (m_pDeviceData, pSU3x->m_pDeviceData);
-
+    IncreaseVersion();
 }
 
 void CFieldGaugeSU3::ScalarMultply(const CLGComplex& a)
 {
     preparethread;
     _kernelScalarMultiplySU3Complex << <block, threads >> > (m_pDeviceData, a);
+    IncreaseVersion();
 }
 
 void CFieldGaugeSU3::ScalarMultply(Real a)
 {
     preparethread;
     _kernelScalarMultiplySU3Real << <block, threads >> > (m_pDeviceData, a);
+    IncreaseVersion();
 }
 
 void CFieldGaugeSU3::Axpy(Real a, const CField* x)
@@ -946,6 +1095,7 @@ void CFieldGaugeSU3::Axpy(Real a, const CField* x)
     const CFieldGaugeSU3* pSU3x = dynamic_cast<const CFieldGaugeSU3*>(x);
     preparethread;
     _kernelAxpySU3Real << <block, threads >> > (m_pDeviceData, pSU3x->m_pDeviceData, a);
+    IncreaseVersion();
 }
 
 void CFieldGaugeSU3::Axpy(const CLGComplex& a, const CField* x)
@@ -959,6 +1109,25 @@ void CFieldGaugeSU3::Axpy(const CLGComplex& a, const CField* x)
     const CFieldGaugeSU3* pSU3x = dynamic_cast<const CFieldGaugeSU3*>(x);
     preparethread;
     _kernelAxpySU3A << <block, threads >> > (m_pDeviceData, pSU3x->m_pDeviceData, a);
+    IncreaseVersion();
+}
+
+void CFieldGaugeSU3::LinearCombine(UINT uiCount, const CField* const* pFields, const CLGComplex* pCoeffs)
+{
+    const CLGComplex* pData[_kLinearCombineMaxTerm];
+    for (UINT i = 0; i < uiCount; ++i)
+    {
+        if (i >= _kLinearCombineMaxTerm || NULL == pFields[i] || EFT_GaugeSU3 != pFields[i]->GetFieldType())
+        {
+            //let the ScalarMultply and Axpy report the wrong field
+            CFieldGauge::LinearCombine(uiCount, pFields, pCoeffs);
+            return;
+        }
+        pData[i] = (const CLGComplex*)(dynamic_cast<const CFieldGaugeSU3*>(pFields[i])->m_pDeviceData);
+    }
+    //only the 9 used elements of each link, the padding is not streamed
+    _LinearCombineComplex((CLGComplex*)m_pDeviceData, 9, uiCount, pData, pCoeffs, _HC_Dir, 16);
+    IncreaseVersion();
 }
 
 
@@ -966,24 +1135,29 @@ void CFieldGaugeSU3::Zero()
 {
     preparethread;
     _kernelInitialSU3Feield << <block, threads >> > (m_pDeviceData, EFIT_Zero);
+    IncreaseVersion();
 }
 
 void CFieldGaugeSU3::Identity()
 {
     preparethread;
     _kernelInitialSU3Feield << <block, threads >> > (m_pDeviceData, EFIT_Identity);
+    IncreaseVersion();
 }
 
 void CFieldGaugeSU3::Dagger()
 {
     preparethread;
     _kernelDaggerSU3 << <block, threads >> > (m_pDeviceData);
+    IncreaseVersion();
 }
 
 void CFieldGaugeSU3::MakeRandomGenerator()
 {
     preparethread;
+    appGetLattice()->m_pRandom->NextLaunch();
     _kernelInitialSU3Feield << <block, threads >> > (m_pDeviceData, EFIT_RandomGenerator);
+    IncreaseVersion();
 }
 
 /**
@@ -992,7 +1166,9 @@ void CFieldGaugeSU3::MakeRandomGenerator()
 void CFieldGaugeSU3::InitialField(EFieldInitialType eInitialType)
 {
     preparethread;
+    appGetLattice()->m_pRandom->NextLaunch();
     _kernelInitialSU3Feield << <block, threads >> > (m_pDeviceData, eInitialType);
+    IncreaseVersion();
 }
 
 void CFieldGaugeSU3::InitialFieldWithFile(const CCString& sFileName, EFieldFileType eType)
@@ -1115,6 +1291,7 @@ void CFieldGaugeSU3::InitialFieldWithFile(const CCString& sFileName, EFieldFileT
         break;
 
     }
+    IncreaseVersion();
 }
 
 void CFieldGaugeSU3::InitialWithByte(BYTE* byData)
@@ -1141,6 +1318,7 @@ void CFieldGaugeSU3::InitialWithByte(BYTE* byData)
     }
     checkCudaErrors(cudaMemcpy(m_pDeviceData, readData, sizeof(deviceSU3) * m_uiLinkeCount, cudaMemcpyHostToDevice));
     free(readData);
+    IncreaseVersion();
 }
 
 void CFieldGaugeSU3::InitialWithByteCompressed(BYTE* byData)
@@ -1176,6 +1354,7 @@ void CFieldGaugeSU3::InitialWithByteCompressed(BYTE* byData)
     preparethread;
     _kernelTransformToULog << <block, threads >> > (m_pDeviceData);
     checkCudaErrors(cudaDeviceSynchronize());
+    IncreaseVersion();
 }
 
 void CFieldGaugeSU3::SetByArray(Real* array)
@@ -1219,10 +1398,22 @@ void CFieldGaugeSU3::CalculateForceAndStaple(CFieldGauge* pForce, CFieldGauge* p
     CFieldGaugeSU3* pForceSU3 = dynamic_cast<CFieldGaugeSU3*>(pForce);
     CFieldGaugeSU3* pStableSU3 = NULL == pStable ? NULL : dynamic_cast<CFieldGaugeSU3*>(pStable);
 
-    preparethread;
+#if _CLG_DIRECT_STENCIL
+    if (appGetLattice()->m_pIndex->UseDirectStencil(m_byFieldId))
+    {
+        preparethread;
+        _kernelStapleAtSiteSU3Torus << <block, threads >> > (
+            m_pDeviceData,
+            NULL == pStableSU3 ? NULL : pStableSU3->m_pDeviceData,
+            pForceSU3->m_pDeviceData,
+            betaOverN);
+        return;
+    }
+#endif
 
     assert(NULL != appGetLattice()->m_pIndexCache->m_pStappleCache);
 
+    preparethread_tuned(_T("_kernelStapleAtSiteSU3CacheIndex"));
     _kernelStapleAtSiteSU3CacheIndex << <block, threads >> > (
         m_pDeviceData,
         appGetLattice()->m_pIndexCache->m_pStappleCache,
@@ -1231,6 +1422,7 @@ void CFieldGaugeSU3::CalculateForceAndStaple(CFieldGauge* pForce, CFieldGauge* p
         NULL == pStableSU3 ? NULL : pStableSU3->m_pDeviceData,
         pForceSU3->m_pDeviceData,
         betaOverN);
+    finishthread_tuned;
 }
 
 void CFieldGaugeSU3::CalculateOnlyStaple(CFieldGauge* pStable) const
@@ -1243,6 +1435,13 @@ void CFieldGaugeSU3::CalculateOnlyStaple(CFieldGauge* pStable) const
     CFieldGaugeSU3* pStableSU3 = dynamic_cast<CFieldGaugeSU3*>(pStable);
 
     preparethread;
+#if _CLG_DIRECT_STENCIL
+    if (appGetLattice()->m_pIndex->UseDirectStencil(m_byFieldId))
+    {
+        _kernelCalculateOnlyStapleTorus << <block, threads >> > (m_pDeviceData, pStableSU3->m_pDeviceData);
+        return;
+    }
+#endif
     _kernelCalculateOnlyStaple << <block, threads >> > (
         m_pDeviceData,
         appGetLattice()->m_pIndexCache->m_pStappleCache,
@@ -1257,9 +1456,22 @@ DOUBLE CFieldGaugeSU3::CalculatePlaqutteEnergy(DOUBLE betaOverN) const
 Real CFieldGaugeSU3::CalculatePlaqutteEnergy(Real betaOverN) const
 #endif
 {
+    preparethread;
+#if _CLG_DIRECT_STENCIL
+    if (appGetLattice()->m_pIndex->UseDirectStencil(m_byFieldId))
+    {
+        _kernelPlaqutteEnergySU3Torus << <block, threads >> > (
+            m_pDeviceData,
+            betaOverN,
+            _D_RealThreadBuffer
+            );
+
+        return appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
+    }
+#endif
+
     assert(NULL != appGetLattice()->m_pIndexCache->m_pPlaqutteCache);
 
-    preparethread;
     _kernelPlaqutteEnergySU3CacheIndex << <block, threads >> > (
         m_pDeviceData,
         appGetLattice()->m_pIndexCache->m_pPlaqutteCache,
@@ -1345,6 +1557,7 @@ void CFieldGaugeSU3::SetOneDirectionUnity(BYTE byDir)
     }
     preparethread;
     _kernelSetOneDirUnity << <block, threads >> >(m_pDeviceData, byDir);
+    IncreaseVersion();
 
     //for (SBYTE byz = 0; byz < _HC_Lz; ++byz)
     //{
@@ -1366,6 +1579,7 @@ void CFieldGaugeSU3::SetOneDirectionZero(BYTE byDir)
     }
     preparethread;
     _kernelSetOneDirZero << <block, threads >> > (m_pDeviceData, byDir);
+    IncreaseVersion();
     //for (SBYTE byz = 0; byz < _HC_Lz; ++byz)
     //{
     //    for (SBYTE byw = 0; byw < _HC_Lt; ++byw)
@@ -1407,13 +1621,20 @@ void CFieldGaugeSU3::ExpMult(Real a, CField* U) const
     {
         _kernelExpMultSU3Real << < block, threads >> > (m_pDeviceData, a, pUField->m_pDeviceData, static_cast<BYTE>(_HC_ExpPrecision));
     }
-    
+    //U is changed in place, the smeared links (fat links of improved staggered) should be rebuilt
+    pUField->IncreaseVersion();
 }
 
 void CFieldGaugeSU3::ElementNormalize()
 {
     preparethread;
     _kernelNormalizeSU3 << < block, threads >> > (m_pDeviceData);
+    IncreaseVersion();
+}
+
+void CFieldGaugeSU3::ExchangeHalo()
+{
+    appExchangeHalo(m_pDeviceData, static_cast<UINT>(sizeof(deviceSU3)) * _HC_Dir);
 }
 
 #if !_CLG_DOUBLEFLOAT
@@ -1460,6 +1681,7 @@ void CFieldGaugeSU3::TransformToIA()
     {
         _kernelTransformToIALog << <block, threads >> > (m_pDeviceData);
     }
+    IncreaseVersion();
 }
 
 
@@ -1474,7 +1696,7 @@ void CFieldGaugeSU3::TransformToU()
     {
         _kernelTransformToULog << <block, threads >> > (m_pDeviceData);
     }
-    
+    IncreaseVersion();
 }
 
 void CFieldGaugeSU3::CalculateE_Using_U(CFieldGauge* pResoult) const
@@ -73,6 +73,7 @@ public:
     void Axpy(const CLGComplex& a, const CField* x) override;
     void ScalarMultply(const CLGComplex& a) override;
     void ScalarMultply(Real a) override;
+    void LinearCombine(UINT uiCount, const CField* const* pFields, const CLGComplex* pCoeffs) override;
 
     void SetOneDirectionUnity(BYTE byDir) override;
     void SetOneDirectionZero(BYTE byDir) override;
@@ -100,6 +101,7 @@ public:
     void ExpMult(Real a, CField* U) const override;
 
     void ElementNormalize() override;
+    void ExchangeHalo() override;
 #if !_CLG_DOUBLEFLOAT
     cuDoubleComplex Dot(const CField* other) const override;
 #else
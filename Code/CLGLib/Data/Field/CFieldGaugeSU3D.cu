@@ -24,6 +24,7 @@ _kernelInitialSU3Generator_D(deviceSU3 *pDevicePtr)
     deviceSU3 zero = deviceSU3::makeSU3Zero();
 
     intokernalInt4;
+    SRandomDraw uiDraw;
 
     const BYTE uiDir = static_cast<BYTE>(_DC_Dir);
     const UINT uiBigIdx = __idx->_deviceGetBigIndex(sSite4);
@@ -37,7 +38,7 @@ _kernelInitialSU3Generator_D(deviceSU3 *pDevicePtr)
         }
         else
         {
-            pDevicePtr[uiLinkIndex] = deviceSU3::makeSU3RandomGenerator(_deviceGetFatIndex(uiSiteIndex, idir + 1));
+            pDevicePtr[uiLinkIndex] = deviceSU3::makeSU3RandomGenerator(_deviceGetFatIndex(uiSiteIndex, idir + 1), uiDraw);
         }
     }
 }
@@ -437,6 +438,7 @@ _kernelTransformToU_DLog(
 void CFieldGaugeSU3D::MakeRandomGenerator()
 {
     preparethread;
+    appGetLattice()->m_pRandom->NextLaunch();
     _kernelInitialSU3Generator_D << <block, threads >> > (m_pDeviceData);
 }
 
@@ -543,7 +545,7 @@ void CFieldGaugeSU3D::ExpMult(Real a, CField* U) const
     {
         _kernelExpMultSU3Real_D << < block, threads >> > (m_pDeviceData, a, pUField->m_pDeviceData, static_cast<BYTE>(_HC_ExpPrecision));
     }
-    
+    pUField->IncreaseVersion();
 }
 
 void CFieldGaugeSU3D::FixBoundary()
@@ -552,6 +554,7 @@ void CFieldGaugeSU3D::FixBoundary()
 
     preparethread;
     _kernelFixBoundarySU3_D << <block, threads >> > (m_pDeviceData);
+    IncreaseVersion();
 }
 
 void CFieldGaugeSU3D::TransformToIA()
@@ -565,6 +568,7 @@ void CFieldGaugeSU3D::TransformToIA()
     {
         _kernelTransformToIALog_D << <block, threads >> > (m_pDeviceData);
     }
+    IncreaseVersion();
 }
 
 void CFieldGaugeSU3D::TransformToU()
@@ -578,7 +582,7 @@ void CFieldGaugeSU3D::TransformToU()
     {
         _kernelTransformToU_DLog << <block, threads >> > (m_pDeviceData);
     }
-    
+    IncreaseVersion();
 }
 
 void CFieldGaugeSU3D::CopyTo(CField* pTarget) const
@@ -36,6 +36,8 @@ _kernelInitialU1Field(CLGComplex *pDevicePtr, EFieldInitialType eInitialType)
     CLGComplex zero = _zeroc;
 
     intokernaldir;
+    SRandomDraw uiDraw;
+    CLGComplex cGauss = zero;
     for (UINT idir = 0; idir < uiDir; ++idir)
     {
         UINT uiLinkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
@@ -54,13 +56,18 @@ _kernelInitialU1Field(CLGComplex *pDevicePtr, EFieldInitialType eInitialType)
         break;
         case EFIT_Random:
         {
-            const Real fArg = _deviceRandomF(_deviceGetFatIndex(uiSiteIndex, idir + 1)) * PI2;
+            const Real fArg = _deviceRandomF(_deviceGetFatIndex(uiSiteIndex, idir + 1), uiDraw) * PI2;
             pDevicePtr[uiLinkIndex] = _make_cuComplex(_cos(fArg), -_sin(fArg));
         }
         break;
         case EFIT_RandomGenerator:
         {
-            const Real r1 = _deviceRandomGaussFSqrt2(_deviceGetFatIndex(uiSiteIndex, idir + 1)) * PI2;
+            //both numbers of Box-Muller are used, for idir and idir + 1
+            if (0 == (idir & 1))
+            {
+                cGauss = _deviceRandomGaussCSqrt2(_deviceGetFatIndex(uiSiteIndex, idir + 1), uiDraw);
+            }
+            const Real r1 = (0 == (idir & 1) ? cGauss.x : cGauss.y) * PI2;
             pDevicePtr[uiLinkIndex] = _make_cuComplex(F(0.0), r1);
         }
         break;
@@ -772,6 +779,23 @@ void CFieldGaugeU1::Axpy(const CLGComplex& a, const CField* x)
     _kernelAxpyU1A << <block, threads >> > (m_pDeviceData, pSU3x->m_pDeviceData, a);
 }
 
+void CFieldGaugeU1::LinearCombine(UINT uiCount, const CField* const* pFields, const CLGComplex* pCoeffs)
+{
+    const CLGComplex* pData[_kLinearCombineMaxTerm];
+    for (UINT i = 0; i < uiCount; ++i)
+    {
+        if (i >= _kLinearCombineMaxTerm || NULL == pFields[i] || EFT_GaugeU1 != pFields[i]->GetFieldType())
+        {
+            //let the ScalarMultply and Axpy report the wrong field
+            CFieldGauge::LinearCombine(uiCount, pFields, pCoeffs);
+            return;
+        }
+        pData[i] = (const CLGComplex*)(dynamic_cast<const CFieldGaugeU1*>(pFields[i])->m_pDeviceData);
+    }
+    _LinearCombineComplex((CLGComplex*)m_pDeviceData, 1, uiCount, pData, pCoeffs, _HC_Dir, 1);
+    IncreaseVersion();
+}
+
 
 void CFieldGaugeU1::Zero()
 {
@@ -794,6 +818,7 @@ void CFieldGaugeU1::Dagger()
 void CFieldGaugeU1::MakeRandomGenerator()
 {
     preparethread;
+    appGetLattice()->m_pRandom->NextLaunch();
     _kernelInitialU1Field << <block, threads >> > (m_pDeviceData, EFIT_RandomGenerator);
 }
 
@@ -803,7 +828,9 @@ void CFieldGaugeU1::MakeRandomGenerator()
 void CFieldGaugeU1::InitialField(EFieldInitialType eInitialType)
 {
     preparethread;
+    appGetLattice()->m_pRandom->NextLaunch();
     _kernelInitialU1Field << <block, threads >> > (m_pDeviceData, eInitialType);
+    IncreaseVersion();
 }
 
 void CFieldGaugeU1::InitialFieldWithFile(const CCString& sFileName, EFieldFileType eType)
@@ -932,6 +959,7 @@ void CFieldGaugeU1::InitialWithByte(BYTE* byData)
     }
     checkCudaErrors(cudaMemcpy(m_pDeviceData, readData, sizeof(CLGComplex) * m_uiLinkeCount, cudaMemcpyHostToDevice));
     free(readData);
+    IncreaseVersion();
 }
 
 void CFieldGaugeU1::InitialWithByteCompressed(BYTE* byData)
@@ -1162,7 +1190,7 @@ void CFieldGaugeU1::SetOneDirectionZero(BYTE byDir)
 
 CFieldGaugeU1::CFieldGaugeU1() : CFieldGauge()
 {
-    checkCudaErrors(__cudaMalloc((void **)&m_pDeviceData, sizeof(deviceSU3) * m_uiLinkeCount));
+    checkCudaErrors(__cudaMalloc((void **)&m_pDeviceData, sizeof(CLGComplex) * m_uiLinkeCount));
 }
 
 CFieldGaugeU1::~CFieldGaugeU1()
@@ -1184,13 +1212,19 @@ void CFieldGaugeU1::ExpMult(Real a, CField* U) const
     _kernelExpMultU1Real << < block, threads >> > (m_pDeviceData, a, pUField->m_pDeviceData);
 
     pUField->ElementNormalize();
-    
+    pUField->IncreaseVersion();
 }
 
 void CFieldGaugeU1::ElementNormalize()
 {
     preparethread;
     _kernelNormalizeU1 << < block, threads >> > (m_pDeviceData);
+    IncreaseVersion();
+}
+
+void CFieldGaugeU1::ExchangeHalo()
+{
+    appExchangeHalo(m_pDeviceData, static_cast<UINT>(sizeof(CLGComplex)) * _HC_Dir);
 }
 
 #if !_CLG_DOUBLEFLOAT
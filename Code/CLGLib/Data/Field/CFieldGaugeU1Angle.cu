@@ -0,0 +1,973 @@
+//=============================================================================
+// FILENAME : CFieldGaugeU1Angle.cu
+//
+// DESCRIPTION:
+// This is the device implementations of compact U1 stored as angles
+//
+// All plaqutte, staple and force sums are sums of angles,
+// one _sincos for each staple instead of complex multiplications
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#include "CLGLib_Private.h"
+
+__BEGIN_NAMESPACE
+
+__CLGIMPLEMENT_CLASS(CFieldGaugeU1Angle)
+
+#pragma region Kernels
+
+/**
+ * sum of the angles of the links on the cached path
+ */
+static __device__ __inline__ Real _deviceU1AnglePath(
+    const Real* __restrict__ pDeviceData,
+    const SIndex* __restrict__ pCachedIndex,
+    UINT uiStart, UINT uiLength, BYTE byFieldId)
+{
+    Real fRes = F(0.0);
+    for (UINT j = 0; j < uiLength; ++j)
+    {
+        fRes += _deviceGetU1AngleSIndex(pDeviceData, pCachedIndex[uiStart + j], byFieldId);
+    }
+    return fRes;
+}
+
+__global__ void _CLG_LAUNCH_BOUND
+_kernelInitialU1AngleField(Real* pDevicePtr, EFieldInitialType eInitialType)
+{
+    intokernalInt4;
+    const BYTE uiDir = static_cast<BYTE>(_DC_Dir);
+    const UINT uiBigIdx = __idx->_deviceGetBigIndex(sSite4);
+    SRandomDraw uiDraw;
+    CLGComplex cGauss = _make_cuComplex(F(0.0), F(0.0));
+    for (UINT idir = 0; idir < uiDir; ++idir)
+    {
+        UINT uiLinkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
+
+        switch (eInitialType)
+        {
+        case EFIT_Zero:
+        case EFIT_Identity:
+        {
+            pDevicePtr[uiLinkIndex] = F(0.0);
+        }
+        break;
+        case EFIT_Random:
+        {
+            pDevicePtr[uiLinkIndex] = _deviceWrapU1Angle(_deviceRandomF(_deviceGetFatIndex(uiSiteIndex, idir + 1), uiDraw) * PI2);
+        }
+        break;
+        case EFIT_RandomGenerator:
+        {
+            //exp(-p^2), consistent with kinetic energy = sum p^2
+            //both numbers of Box-Muller are used, for idir and idir + 1
+            if (0 == (idir & 1))
+            {
+                cGauss = _deviceRandomGaussC(_deviceGetFatIndex(uiSiteIndex, idir + 1), uiDraw);
+            }
+            //the Dirichlet links are not evolved
+            pDevicePtr[uiLinkIndex] = __idx->_deviceIsBondOnSurface(uiBigIdx, idir) ? F(0.0) : ((0 == (idir & 1)) ? cGauss.x : cGauss.y);
+        }
+        break;
+        default:
+        {
+            printf("U1 Angle Field cannot be initialized with this type!");
+        }
+        break;
+        }
+    }
+}
+
+__global__ void _CLG_LAUNCH_BOUND
+_kernelDaggerU1Angle(Real* pDevicePtr)
+{
+    gaugeSU3KernelFuncionStart
+
+    pDevicePtr[uiLinkIndex] = -pDevicePtr[uiLinkIndex];
+
+    gaugeSU3KernelFuncionEnd
+}
+
+__global__ void _CLG_LAUNCH_BOUND
+_kernelAxpyU1AngleReal(Real* pDevicePtr, const Real* __restrict__ x, Real a)
+{
+    gaugeSU3KernelFuncionStart
+
+    pDevicePtr[uiLinkIndex] = pDevicePtr[uiLinkIndex] + x[uiLinkIndex] * a;
+
+    gaugeSU3KernelFuncionEnd
+}
+
+__global__ void _CLG_LAUNCH_BOUND
+_kernelScalarMultiplyU1AngleReal(Real* pDevicePtr, Real a)
+{
+    gaugeSU3KernelFuncionStart
+
+    pDevicePtr[uiLinkIndex] = pDevicePtr[uiLinkIndex] * a;
+
+    gaugeSU3KernelFuncionEnd
+}
+
+/**
+ * With S_i the angle of i-th staple,
+ * staple(n) = sum _i cos(theta - S_i) = Re[U S^+]
+ * force(n) += -beta/2N sum _i sin(theta - S_i)
+ * which is same as CFieldGaugeU1
+ */
+__global__ void _CLG_LAUNCH_BOUND
+_kernelStapleAtSiteU1AngleCacheIndex(
+    const Real* __restrict__ pDeviceData,
+    const SIndex* __restrict__ pCachedIndex,
+    UINT plaqLength, UINT plaqCount,
+    Real* pStapleData, //can be NULL
+    Real* pForceData,
+    Real betaOverN,
+    BYTE byFieldId)
+{
+    intokernaldir;
+
+    betaOverN = betaOverN * F(-0.5);
+    const UINT plaqLengthm1 = plaqLength - 1;
+    const UINT plaqCountAll = plaqCount * plaqLengthm1;
+
+    for (UINT idir = 0; idir < uiDir; ++idir)
+    {
+        const UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
+        const Real fTheta = pDeviceData[linkIndex];
+        Real fSin = F(0.0);
+        Real fCos = F(0.0);
+
+        for (UINT i = 0; i < plaqCount; ++i)
+        {
+            const Real fStaple = _deviceU1AnglePath(pDeviceData, pCachedIndex, i * plaqLengthm1 + linkIndex * plaqCountAll, plaqLengthm1, byFieldId);
+            Real s, c;
+            _sincos(_deviceWrapU1Angle(fTheta - fStaple), &s, &c);
+            fSin += s;
+            fCos += c;
+        }
+
+        if (NULL != pStapleData)
+        {
+            pStapleData[linkIndex] = fCos;
+        }
+
+        //force is additive
+        pForceData[linkIndex] = pForceData[linkIndex] + betaOverN * fSin;
+    }
+}
+
+__global__ void _CLG_LAUNCH_BOUND
+_kernelCalculateOnlyStapleU1Angle(
+    const Real* __restrict__ pDeviceData,
+    const SIndex* __restrict__ pCachedIndex,
+    UINT plaqLength, UINT plaqCount,
+    Real* pStapleData,
+    BYTE byFieldId)
+{
+    intokernaldir;
+
+    const UINT plaqLengthm1 = plaqLength - 1;
+    const UINT plaqCountAll = plaqCount * plaqLengthm1;
+
+    for (UINT idir = 0; idir < uiDir; ++idir)
+    {
+        const UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
+        const Real fTheta = pDeviceData[linkIndex];
+        Real fCos = F(0.0);
+
+        for (UINT i = 0; i < plaqCount; ++i)
+        {
+            fCos += _cos(_deviceWrapU1Angle(fTheta - _deviceU1AnglePath(pDeviceData, pCachedIndex, i * plaqLengthm1 + linkIndex * plaqCountAll, plaqLengthm1, byFieldId)));
+        }
+        pStapleData[linkIndex] = fCos;
+    }
+}
+
+__global__ void _CLG_LAUNCH_BOUND
+_kernelPlaqutteEnergyU1AngleCacheIndex(
+    const Real* __restrict__ pDeviceData,
+    const SIndex* __restrict__ pCachedIndex,
+    UINT plaqLength, UINT plaqCount,
+    BYTE byFieldId,
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE betaOverN,
+    DOUBLE* results
+#else
+    Real betaOverN,
+    Real* results
+#endif
+)
+{
+    intokernal;
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE resThisThread = 0.0;
+#else
+    Real resThisThread = F(0.0);
+#endif
+    const UINT plaqCountAll = plaqCount * plaqLength;
+    for (UINT i = 0; i < plaqCount; ++i)
+    {
+        const Real fPlaq = _deviceU1AnglePath(pDeviceData, pCachedIndex, i * plaqLength + uiSiteIndex * plaqCountAll, plaqLength, byFieldId);
+#if !_CLG_DOUBLEFLOAT
+        resThisThread += (1.0 - cos(static_cast<DOUBLE>(fPlaq)));
+#else
+        resThisThread += (F(1.0) - _cos(_deviceWrapU1Angle(fPlaq)));
+#endif
+    }
+
+    results[uiSiteIndex] = resThisThread * betaOverN;
+}
+
+__global__ void _CLG_LAUNCH_BOUND
+_kernelPlaqutteEnergyU1Angle_UseClover(
+    BYTE byFieldId,
+    const Real* __restrict__ pDeviceData,
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE fBetaOverN,
+    DOUBLE* results
+#else
+    Real fBetaOverN,
+    Real* results
+#endif
+)
+{
+    intokernalInt4;
+
+    Real fRes = F(0.0);
+    for (BYTE byDir1 = 0; byDir1 < _DC_Dir; ++byDir1)
+    {
+        for (BYTE byDir2 = byDir1 + 1; byDir2 < _DC_Dir; ++byDir2)
+        {
+            fRes += _deviceCloverCosU1Angle(pDeviceData, sSite4, __bi(sSite4), byDir1, byDir2, byFieldId);
+        }
+    }
+    fRes = F(6.0) - F(0.25) * fRes;
+    results[uiSiteIndex] = fRes * fBetaOverN;
+}
+
+/**
+ * Each plaqutte is counted 4 times, so it is 0.25 * sum (plaqCount - Re[U S^+])
+ */
+__global__ void _CLG_LAUNCH_BOUND
+_kernelPlaqutteEnergyUsingStableU1Angle(
+    const Real* __restrict__ pStableData,
+    UINT plaqCount,
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE betaOverN,
+    DOUBLE* results
+#else
+    Real betaOverN,
+    Real* results
+#endif
+)
+{
+    intokernaldir;
+
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE resThisThread = 0.0;
+    for (UINT idir = 0; idir < uiDir; ++idir)
+    {
+        resThisThread += (plaqCount - pStableData[_deviceGetLinkIndex(uiSiteIndex, idir)]);
+    }
+
+    results[uiSiteIndex] = resThisThread * betaOverN * 0.25;
+#else
+    Real resThisThread = F(0.0);
+    for (UINT idir = 0; idir < uiDir; ++idir)
+    {
+        resThisThread += (plaqCount - pStableData[_deviceGetLinkIndex(uiSiteIndex, idir)]);
+    }
+
+    results[uiSiteIndex] = resThisThread * betaOverN * F(0.25);
+#endif
+}
+
+/**
+ * U = exp(i a p) U is theta = theta + a p, normalized in the same kernel
+ */
+__global__ void _CLG_LAUNCH_BOUND
+_kernelExpMultU1Angle(
+    const Real* __restrict__ pMyDeviceData,
+    Real a,
+    Real* pU)
+{
+    gaugeSU3KernelFuncionStart
+
+    pU[uiLinkIndex] = _deviceWrapU1Angle(pU[uiLinkIndex] + a * pMyDeviceData[uiLinkIndex]);
+
+    gaugeSU3KernelFuncionEnd
+}
+
+__global__ void _CLG_LAUNCH_BOUND
+_kernelCalculateKinematicEnergyU1Angle(const Real* __restrict__ pDeviceData,
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE* results
+#else
+    Real* results
+#endif
+)
+{
+    intokernaldir;
+
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE resThisThread = 0.0;
+#else
+    Real resThisThread = F(0.0);
+#endif
+    for (UINT idir = 0; idir < uiDir; ++idir)
+    {
+        const Real fP = pDeviceData[_deviceGetLinkIndex(uiSiteIndex, idir)];
+        resThisThread += fP * fP;
+    }
+
+    results[uiSiteIndex] = resThisThread;
+}
+
+__global__ void _CLG_LAUNCH_BOUND
+_kernelNormalizeU1Angle(Real* pMyDeviceData)
+{
+    gaugeSU3KernelFuncionStart
+
+    pMyDeviceData[uiLinkIndex] = _deviceWrapU1Angle(pMyDeviceData[uiLinkIndex]);
+
+    gaugeSU3KernelFuncionEnd
+}
+
+__global__ void _CLG_LAUNCH_BOUND
+_kernelDotU1Angle(
+    const Real* __restrict__ pMyDeviceData,
+    const Real* __restrict__ pOtherDeviceData,
+#if !_CLG_DOUBLEFLOAT
+    cuDoubleComplex* result
+#else
+    CLGComplex* result
+#endif
+)
+{
+    intokernaldir;
+
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE resThisThread = 0.0;
+#else
+    Real resThisThread = F(0.0);
+#endif
+    for (UINT idir = 0; idir < uiDir; ++idir)
+    {
+        const UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
+        resThisThread += pMyDeviceData[linkIndex] * pOtherDeviceData[linkIndex];
+    }
+
+#if !_CLG_DOUBLEFLOAT
+    result[uiSiteIndex] = make_cuDoubleComplex(resThisThread, 0.0);
+#else
+    result[uiSiteIndex] = _make_cuComplex(resThisThread, F(0.0));
+#endif
+}
+
+__global__ void _CLG_LAUNCH_BOUND
+_kernelSetOneDirZero_U1Angle(Real* pDeviceData, BYTE byDir)
+{
+    intokernaldir;
+
+    for (BYTE dir = 0; dir < uiDir; ++dir)
+    {
+        if (0 != ((1 << dir) & byDir))
+        {
+            pDeviceData[_deviceGetLinkIndex(uiSiteIndex, dir)] = F(0.0);
+        }
+    }
+}
+
+__global__ void _CLG_LAUNCH_BOUND
+_kernelU1AngleToU1(const Real* __restrict__ pDeviceData, CLGComplex* pU1)
+{
+    gaugeSU3KernelFuncionStart
+
+    Real s, c;
+    _sincos(_deviceWrapU1Angle(pDeviceData[uiLinkIndex]), &s, &c);
+    pU1[uiLinkIndex] = _make_cuComplex(c, s);
+
+    gaugeSU3KernelFuncionEnd
+}
+
+/**
+ * The force of CFieldGaugeU1 is i F
+ */
+__global__ void _CLG_LAUNCH_BOUND
+_kernelAddU1ForceU1Angle(Real* pDeviceData, const CLGComplex* __restrict__ pU1Force)
+{
+    gaugeSU3KernelFuncionStart
+
+    pDeviceData[uiLinkIndex] = pDeviceData[uiLinkIndex] + pU1Force[uiLinkIndex].y;
+
+    gaugeSU3KernelFuncionEnd
+}
+
+__global__ void _CLG_LAUNCH_BOUND
+_kernelU1ToU1Angle(Real* pDeviceData, const CLGComplex* __restrict__ pU1)
+{
+    gaugeSU3KernelFuncionStart
+
+    pDeviceData[uiLinkIndex] = __cuCargf(pU1[uiLinkIndex]);
+
+    gaugeSU3KernelFuncionEnd
+}
+
+#pragma endregion
+
+void CFieldGaugeU1Angle::AxpyPlus(const CField* x)
+{
+    Axpy(F(1.0), x);
+}
+
+void CFieldGaugeU1Angle::AxpyMinus(const CField* x)
+{
+    Axpy(F(-1.0), x);
+}
+
+void CFieldGaugeU1Angle::ScalarMultply(const CLGComplex& a)
+{
+    ScalarMultply(a.x);
+}
+
+void CFieldGaugeU1Angle::ScalarMultply(Real a)
+{
+    preparethread;
+    _kernelScalarMultiplyU1AngleReal << <block, threads >> > (m_pDeviceData, a);
+    IncreaseVersion();
+}
+
+void CFieldGaugeU1Angle::Axpy(Real a, const CField* x)
+{
+    if (NULL == x || EFT_GaugeU1Angle != x->GetFieldType())
+    {
+        appCrucial("CFieldGaugeU1Angle: axpy failed because the otherfield is not U1 angle");
+        return;
+    }
+
+    const CFieldGaugeU1Angle* pU1x = dynamic_cast<const CFieldGaugeU1Angle*>(x);
+    preparethread;
+    _kernelAxpyU1AngleReal << <block, threads >> > (m_pDeviceData, pU1x->m_pDeviceData, a);
+    IncreaseVersion();
+}
+
+void CFieldGaugeU1Angle::Axpy(const CLGComplex& a, const CField* x)
+{
+    Axpy(a.x, x);
+}
+
+void CFieldGaugeU1Angle::Zero()
+{
+    checkCudaErrors(cudaMemset(m_pDeviceData, 0, sizeof(Real) * m_uiLinkeCount));
+    IncreaseVersion();
+}
+
+void CFieldGaugeU1Angle::Identity()
+{
+    checkCudaErrors(cudaMemset(m_pDeviceData, 0, sizeof(Real) * m_uiLinkeCount));
+    IncreaseVersion();
+}
+
+void CFieldGaugeU1Angle::Dagger()
+{
+    preparethread;
+    _kernelDaggerU1Angle << <block, threads >> > (m_pDeviceData);
+    IncreaseVersion();
+}
+
+void CFieldGaugeU1Angle::MakeRandomGenerator()
+{
+    preparethread;
+    appGetLattice()->m_pRandom->NextLaunch();
+    _kernelInitialU1AngleField << <block, threads >> > (m_pDeviceData, EFIT_RandomGenerator);
+    IncreaseVersion();
+}
+
+void CFieldGaugeU1Angle::InitialField(EFieldInitialType eInitialType)
+{
+    preparethread;
+    appGetLattice()->m_pRandom->NextLaunch();
+    _kernelInitialU1AngleField << <block, threads >> > (m_pDeviceData, eInitialType);
+    IncreaseVersion();
+}
+
+void CFieldGaugeU1Angle::InitialFieldWithFile(const CCString& sFileName, EFieldFileType eType)
+{
+    if (!CFileSystem::IsFileExist(sFileName))
+    {
+        appCrucial(_T("File not exist!!! %s \n"), sFileName.c_str());
+        _FAIL_EXIT;
+    }
+
+    switch (eType)
+    {
+    case EFFT_CLGBin:
+#if _CLG_DOUBLEFLOAT
+    case EFFT_CLGBinDouble:
+#else
+    case EFFT_CLGBinFloat:
+#endif
+    {
+        UINT uiSize = static_cast<UINT>(sizeof(Real) * 2 * m_uiLinkeCount);
+        BYTE* data = appGetFileSystem()->ReadAllBytes(sFileName.c_str(), uiSize);
+        InitialWithByte(data);
+        free(data);
+    }
+    break;
+#if _CLG_DOUBLEFLOAT
+    case EFFT_CLGBinFloat:
+    {
+        UINT uiSize = static_cast<UINT>(sizeof(Real) * 2 * m_uiLinkeCount);
+        BYTE* data = (BYTE*)malloc(uiSize);
+        Real* rdata = (Real*)data;
+        FLOAT* fdata = (FLOAT*)appGetFileSystem()->ReadAllBytes(sFileName.c_str(), uiSize);
+        for (UINT i = 0; i < 2 * m_uiLinkeCount; ++i)
+        {
+            rdata[i] = static_cast<Real>(fdata[i]);
+        }
+        InitialWithByte(data);
+        free(fdata);
+        free(data);
+    }
+    break;
+#else
+    case EFFT_CLGBinDouble:
+    {
+        UINT uiSize = static_cast<UINT>(sizeof(Real) * 2 * m_uiLinkeCount);
+        BYTE* data = (BYTE*)malloc(uiSize);
+        Real* rdata = (Real*)data;
+        DOUBLE* ddata = (DOUBLE*)appGetFileSystem()->ReadAllBytes(sFileName.c_str(), uiSize);
+        for (UINT i = 0; i < 2 * m_uiLinkeCount; ++i)
+        {
+            rdata[i] = static_cast<Real>(ddata[i]);
+        }
+        InitialWithByte(data);
+        free(ddata);
+        free(data);
+    }
+    break;
+#endif
+    default:
+        appCrucial(_T("Not supported input file type %s\n"), __ENUM_TO_STRING(EFieldFileType, eType).c_str());
+        break;
+    }
+}
+
+/**
+ * Same file format as CFieldGaugeU1
+ */
+void CFieldGaugeU1Angle::InitialWithByte(BYTE* byData)
+{
+    Real* readData = (Real*)malloc(sizeof(Real) * m_uiLinkeCount);
+    for (UINT i = 0; i < m_uiLinkeCount; ++i)
+    {
+        Real oneLink[2];
+        memcpy(oneLink, byData + sizeof(Real) * 2 * i, sizeof(Real) * 2);
+        readData[i] = _atan2(oneLink[1], oneLink[0]);
+    }
+    checkCudaErrors(cudaMemcpy(m_pDeviceData, readData, sizeof(Real) * m_uiLinkeCount, cudaMemcpyHostToDevice));
+    free(readData);
+    IncreaseVersion();
+}
+
+void CFieldGaugeU1Angle::CalculateForceAndStaple(CFieldGauge* pForce, CFieldGauge* pStable, Real betaOverN) const
+{
+    if (NULL == pForce || EFT_GaugeU1Angle != pForce->GetFieldType())
+    {
+        appCrucial("CFieldGaugeU1Angle: force field is not U1 angle");
+        return;
+    }
+    if (NULL != pStable && EFT_GaugeU1Angle != pStable->GetFieldType())
+    {
+        appCrucial("CFieldGaugeU1Angle: stape field is not U1 angle");
+        return;
+    }
+
+    CFieldGaugeU1Angle* pForceU1 = dynamic_cast<CFieldGaugeU1Angle*>(pForce);
+    CFieldGaugeU1Angle* pStableU1 = NULL == pStable ? NULL : dynamic_cast<CFieldGaugeU1Angle*>(pStable);
+
+    preparethread;
+
+    assert(NULL != appGetLattice()->m_pIndexCache->m_pStappleCache);
+
+    _kernelStapleAtSiteU1AngleCacheIndex << <block, threads >> > (
+        m_pDeviceData,
+        appGetLattice()->m_pIndexCache->m_pStappleCache,
+        appGetLattice()->m_pIndexCache->m_uiPlaqutteLength,
+        appGetLattice()->m_pIndexCache->m_uiPlaqutteCountPerLink,
+        NULL == pStableU1 ? NULL : pStableU1->m_pDeviceData,
+        pForceU1->m_pDeviceData,
+        betaOverN,
+        m_byFieldId);
+}
+
+void CFieldGaugeU1Angle::CalculateOnlyStaple(CFieldGauge* pStable) const
+{
+    if (NULL == pStable || EFT_GaugeU1Angle != pStable->GetFieldType())
+    {
+        appCrucial("CFieldGaugeU1Angle: stable field is not U1 angle");
+        return;
+    }
+    CFieldGaugeU1Angle* pStableU1 = dynamic_cast<CFieldGaugeU1Angle*>(pStable);
+
+    preparethread;
+    _kernelCalculateOnlyStapleU1Angle << <block, threads >> > (
+        m_pDeviceData,
+        appGetLattice()->m_pIndexCache->m_pStappleCache,
+        appGetLattice()->m_pIndexCache->m_uiPlaqutteLength,
+        appGetLattice()->m_pIndexCache->m_uiPlaqutteCountPerLink,
+        pStableU1->m_pDeviceData,
+        m_byFieldId);
+}
+
+#if !_CLG_DOUBLEFLOAT
+DOUBLE CFieldGaugeU1Angle::CalculatePlaqutteEnergy(DOUBLE betaOverN) const
+#else
+Real CFieldGaugeU1Angle::CalculatePlaqutteEnergy(Real betaOverN) const
+#endif
+{
+    assert(NULL != appGetLattice()->m_pIndexCache->m_pPlaqutteCache);
+
+    preparethread;
+    _kernelPlaqutteEnergyU1AngleCacheIndex << <block, threads >> > (
+        m_pDeviceData,
+        appGetLattice()->m_pIndexCache->m_pPlaqutteCache,
+        appGetLattice()->m_pIndexCache->m_uiPlaqutteLength,
+        appGetLattice()->m_pIndexCache->m_uiPlaqutteCountPerSite,
+        m_byFieldId,
+        betaOverN,
+        _D_RealThreadBuffer
+        );
+
+    return appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
+}
+
+#if !_CLG_DOUBLEFLOAT
+DOUBLE CFieldGaugeU1Angle::CalculatePlaqutteEnergyUseClover(DOUBLE betaOverN) const
+#else
+Real CFieldGaugeU1Angle::CalculatePlaqutteEnergyUseClover(Real betaOverN) const
+#endif
+{
+    preparethread;
+    _kernelPlaqutteEnergyU1Angle_UseClover << <block, threads >> > (
+        m_byFieldId,
+        m_pDeviceData,
+        betaOverN,
+        _D_RealThreadBuffer);
+
+    return appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
+}
+
+#if !_CLG_DOUBLEFLOAT
+DOUBLE CFieldGaugeU1Angle::CalculatePlaqutteEnergyUsingStable(DOUBLE betaOverN, const CFieldGauge *pStable) const
+#else
+Real CFieldGaugeU1Angle::CalculatePlaqutteEnergyUsingStable(Real betaOverN, const CFieldGauge* pStable) const
+#endif
+{
+    if (NULL == pStable || EFT_GaugeU1Angle != pStable->GetFieldType())
+    {
+        appCrucial("CFieldGaugeU1Angle: stape field is not U1 angle");
+        return F(0.0);
+    }
+    const CFieldGaugeU1Angle* pStableU1 = dynamic_cast<const CFieldGaugeU1Angle*>(pStable);
+
+    preparethread;
+    _kernelPlaqutteEnergyUsingStableU1Angle << <block, threads >> > (
+        pStableU1->m_pDeviceData,
+        appGetLattice()->m_pIndexCache->m_uiPlaqutteCountPerLink,
+        betaOverN,
+        _D_RealThreadBuffer);
+
+    return appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
+}
+
+#if !_CLG_DOUBLEFLOAT
+DOUBLE CFieldGaugeU1Angle::CalculateKinematicEnergy() const
+#else
+Real CFieldGaugeU1Angle::CalculateKinematicEnergy() const
+#endif
+{
+    preparethread;
+    _kernelCalculateKinematicEnergyU1Angle << <block, threads >> > (m_pDeviceData, _D_RealThreadBuffer);
+
+    return appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer);
+}
+
+void CFieldGaugeU1Angle::SetOneDirectionUnity(BYTE byDir)
+{
+    SetOneDirectionZero(byDir);
+}
+
+void CFieldGaugeU1Angle::SetOneDirectionZero(BYTE byDir)
+{
+    if (0 == (byDir & 15))
+    {
+        return;
+    }
+    preparethread;
+    _kernelSetOneDirZero_U1Angle << <block, threads >> > (m_pDeviceData, byDir);
+    IncreaseVersion();
+}
+
+CFieldGaugeU1Angle::CFieldGaugeU1Angle()
+    : CFieldGauge()
+    , m_pDeviceU1Links(NULL)
+    , m_uiU1LinksVersion(0)
+    , m_pDeviceU1Force(NULL)
+{
+    checkCudaErrors(__cudaMalloc((void **)&m_pDeviceData, sizeof(Real) * m_uiLinkeCount));
+}
+
+CFieldGaugeU1Angle::~CFieldGaugeU1Angle()
+{
+    checkCudaErrors(__cudaFree(m_pDeviceData));
+    if (NULL != m_pDeviceU1Links)
+    {
+        checkCudaErrors(__cudaFree(m_pDeviceU1Links));
+    }
+    if (NULL != m_pDeviceU1Force)
+    {
+        checkCudaErrors(__cudaFree(m_pDeviceU1Force));
+    }
+}
+
+void CFieldGaugeU1Angle::ExpMult(Real a, CField* U) const
+{
+    if (NULL == U || EFT_GaugeU1Angle != U->GetFieldType())
+    {
+        appCrucial("CFieldGaugeU1Angle: U field is not U1 angle");
+        return;
+    }
+
+    CFieldGaugeU1Angle* pUField = dynamic_cast<CFieldGaugeU1Angle*>(U);
+
+    preparethread;
+    _kernelExpMultU1Angle << < block, threads >> > (m_pDeviceData, a, pUField->m_pDeviceData);
+    pUField->IncreaseVersion();
+}
+
+void CFieldGaugeU1Angle::ElementNormalize()
+{
+    preparethread;
+    _kernelNormalizeU1Angle << < block, threads >> > (m_pDeviceData);
+    IncreaseVersion();
+}
+
+void CFieldGaugeU1Angle::ExchangeHalo()
+{
+    appExchangeHalo(m_pDeviceData, static_cast<UINT>(sizeof(Real)) * _HC_Dir);
+}
+
+#if !_CLG_DOUBLEFLOAT
+cuDoubleComplex CFieldGaugeU1Angle::Dot(const CField* other) const
+#else
+CLGComplex CFieldGaugeU1Angle::Dot(const CField* other) const
+#endif
+{
+    if (NULL == other || EFT_GaugeU1Angle != other->GetFieldType())
+    {
+        appCrucial("CFieldGaugeU1Angle: U field is not U1 angle");
+#if !_CLG_DOUBLEFLOAT
+        return make_cuDoubleComplex(0, 0);
+#else
+        return _make_cuComplex(0, 0);
+#endif
+    }
+
+    const CFieldGaugeU1Angle* pUField = dynamic_cast<const CFieldGaugeU1Angle*>(other);
+
+    preparethread;
+    _kernelDotU1Angle << < block, threads >> > (m_pDeviceData, pUField->m_pDeviceData, _D_ComplexThreadBuffer);
+    return appGetCudaHelper()->ThreadBufferSum(_D_ComplexThreadBuffer);
+}
+
+void CFieldGaugeU1Angle::CopyTo(CField* pTarget) const
+{
+    if (NULL == pTarget || EFT_GaugeU1Angle != pTarget->GetFieldType())
+    {
+        appCrucial("CFieldGaugeU1Angle: target field is not U1 angle");
+        return;
+    }
+
+    CFieldGauge::CopyTo(pTarget);
+
+    CFieldGaugeU1Angle* pTargetField = dynamic_cast<CFieldGaugeU1Angle*>(pTarget);
+    checkCudaErrors(cudaMemcpy(pTargetField->m_pDeviceData, m_pDeviceData, sizeof(Real) * m_uiLinkeCount, cudaMemcpyDeviceToDevice));
+}
+
+void CFieldGaugeU1Angle::CopyToU1(CFieldGaugeU1* pU1) const
+{
+    if (NULL == pU1)
+    {
+        return;
+    }
+    preparethread;
+    _kernelU1AngleToU1 << <block, threads >> > (m_pDeviceData, pU1->m_pDeviceData);
+}
+
+void CFieldGaugeU1Angle::InitialWithU1(const CFieldGaugeU1* pU1)
+{
+    if (NULL == pU1)
+    {
+        return;
+    }
+    preparethread;
+    _kernelU1ToU1Angle << <block, threads >> > (m_pDeviceData, pU1->m_pDeviceData);
+    IncreaseVersion();
+}
+
+const CLGComplex* CFieldGaugeU1Angle::GetU1Links() const
+{
+    if (NULL == m_pDeviceU1Links)
+    {
+        checkCudaErrors(__cudaMalloc((void**)&m_pDeviceU1Links, sizeof(CLGComplex) * m_uiLinkeCount));
+    }
+    else if (m_uiU1LinksVersion == GetVersion())
+    {
+        return m_pDeviceU1Links;
+    }
+
+    preparethread;
+    _kernelU1AngleToU1 << <block, threads >> > (m_pDeviceData, m_pDeviceU1Links);
+    m_uiU1LinksVersion = GetVersion();
+    return m_pDeviceU1Links;
+}
+
+CLGComplex* CFieldGaugeU1Angle::PrepareU1Force()
+{
+    if (NULL == m_pDeviceU1Force)
+    {
+        checkCudaErrors(__cudaMalloc((void**)&m_pDeviceU1Force, sizeof(CLGComplex) * m_uiLinkeCount));
+    }
+    checkCudaErrors(cudaMemset(m_pDeviceU1Force, 0, sizeof(CLGComplex) * m_uiLinkeCount));
+    return m_pDeviceU1Force;
+}
+
+void CFieldGaugeU1Angle::AcceptU1Force()
+{
+    if (NULL == m_pDeviceU1Force)
+    {
+        appCrucial(_T("CFieldGaugeU1Angle: AcceptU1Force without PrepareU1Force!\n"));
+        return;
+    }
+    preparethread;
+    _kernelAddU1ForceU1Angle << <block, threads >> > (m_pDeviceData, m_pDeviceU1Force);
+    IncreaseVersion();
+}
+
+const CLGComplex* CFieldGaugeU1Angle::U1LinksOf(const CField* pGauge)
+{
+    if (NULL == pGauge)
+    {
+        return NULL;
+    }
+    if (EFT_GaugeU1 == pGauge->GetFieldType())
+    {
+        return dynamic_cast<const CFieldGaugeU1*>(pGauge)->m_pDeviceData;
+    }
+    if (EFT_GaugeU1Angle == pGauge->GetFieldType())
+    {
+        return dynamic_cast<const CFieldGaugeU1Angle*>(pGauge)->GetU1Links();
+    }
+    return NULL;
+}
+
+void CFieldGaugeU1Angle::CalculateE_Using_U(CFieldGauge* pResoult) const
+{
+    appCrucial(_T("U1 Angle CalculateE_Using_U Not supported!\n"));
+}
+
+void CFieldGaugeU1Angle::CalculateNablaE_Using_U(CFieldGauge* pResoult, UBOOL bNaive) const
+{
+    appCrucial(_T("U1 Angle CalculateNablaE_Using_U Not supported!\n"));
+}
+
+void CFieldGaugeU1Angle::DebugPrintMe() const
+{
+    Real* pToPrint = (Real*)malloc(sizeof(Real) * m_uiLinkeCount);
+    checkCudaErrors(cudaMemcpy(pToPrint, m_pDeviceData, sizeof(Real) * m_uiLinkeCount, cudaMemcpyDeviceToHost));
+    UBOOL bLogDate = appGetLogDate();
+    appSetLogDate(FALSE);
+    for (UINT uiSite = 0; uiSite < m_uiLinkeCount / _HC_Dir; ++uiSite)
+    {
+        appGeneral(_T(" --- site: %d --- "), uiSite);
+        for (UINT uiDir = 0; uiDir < _HC_Dir; ++uiDir)
+        {
+            appGeneral(_T(" %f, "), pToPrint[uiSite * _HC_Dir + uiDir]);
+        }
+        appGeneral(_T("\n"));
+    }
+    appSetLogDate(bLogDate);
+    free(pToPrint);
+}
+
+BYTE* CFieldGaugeU1Angle::CopyDataOut(UINT &uiSize) const
+{
+    Real* toSave = (Real*)malloc(sizeof(Real) * m_uiLinkeCount);
+    checkCudaErrors(cudaMemcpy(toSave, m_pDeviceData, sizeof(Real) * m_uiLinkeCount, cudaMemcpyDeviceToHost));
+    uiSize = static_cast<UINT>(sizeof(Real) * m_uiLinkeCount * 2);
+    BYTE* byToSave = (BYTE*)malloc(static_cast<size_t>(uiSize));
+    for (UINT i = 0; i < m_uiLinkeCount; ++i)
+    {
+        Real oneLink[2];
+        oneLink[0] = static_cast<Real>(_hostcos(toSave[i]));
+        oneLink[1] = static_cast<Real>(_hostsin(toSave[i]));
+        memcpy(byToSave + i * sizeof(Real) * 2, oneLink, sizeof(Real) * 2);
+    }
+    free(toSave);
+
+    return byToSave;
+}
+
+BYTE* CFieldGaugeU1Angle::CopyDataOutFloat(UINT& uiSize) const
+{
+    Real* toSave = (Real*)malloc(sizeof(Real) * m_uiLinkeCount);
+    checkCudaErrors(cudaMemcpy(toSave, m_pDeviceData, sizeof(Real) * m_uiLinkeCount, cudaMemcpyDeviceToHost));
+    uiSize = static_cast<UINT>(sizeof(FLOAT) * m_uiLinkeCount * 2);
+    BYTE* byToSave = (BYTE*)malloc(static_cast<size_t>(uiSize));
+    for (UINT i = 0; i < m_uiLinkeCount; ++i)
+    {
+        FLOAT oneLink[2];
+        oneLink[0] = static_cast<FLOAT>(cos(static_cast<DOUBLE>(toSave[i])));
+        oneLink[1] = static_cast<FLOAT>(sin(static_cast<DOUBLE>(toSave[i])));
+        memcpy(byToSave + i * sizeof(FLOAT) * 2, oneLink, sizeof(FLOAT) * 2);
+    }
+    free(toSave);
+
+    return byToSave;
+}
+
+BYTE* CFieldGaugeU1Angle::CopyDataOutDouble(UINT& uiSize) const
+{
+    Real* toSave = (Real*)malloc(sizeof(Real) * m_uiLinkeCount);
+    checkCudaErrors(cudaMemcpy(toSave, m_pDeviceData, sizeof(Real) * m_uiLinkeCount, cudaMemcpyDeviceToHost));
+    uiSize = static_cast<UINT>(sizeof(DOUBLE) * m_uiLinkeCount * 2);
+    BYTE* byToSave = (BYTE*)malloc(static_cast<size_t>(uiSize));
+    for (UINT i = 0; i < m_uiLinkeCount; ++i)
+    {
+        DOUBLE oneLink[2];
+        oneLink[0] = cos(static_cast<DOUBLE>(toSave[i]));
+        oneLink[1] = sin(static_cast<DOUBLE>(toSave[i]));
+        memcpy(byToSave + i * sizeof(DOUBLE) * 2, oneLink, sizeof(DOUBLE) * 2);
+    }
+    free(toSave);
+
+    return byToSave;
+}
+
+CCString CFieldGaugeU1Angle::GetInfos(const CCString &tab) const
+{
+    CCString sRet;
+    sRet = tab + _T("Name : CFieldGaugeU1Angle\n");
+    return sRet;
+}
+
+__END_NAMESPACE
+
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
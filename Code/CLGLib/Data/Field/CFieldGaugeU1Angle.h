@@ -0,0 +1,243 @@
+//=============================================================================
+// FILENAME : CFieldGaugeU1Angle.h
+//
+// DESCRIPTION:
+// This is the compact U1 gauge field stored as angles, U_mu(n) = exp(i theta_mu(n))
+//
+// Only one Real per link is stored (CFieldGaugeU1 stores a complex),
+// the plaqutte is a sum of angles, S = beta/N sum (1 - cos theta_P),
+// the momentum and force are also angles, so ExpMult is theta = theta + a p.
+//
+// The staple is a sum of phases and cannot be stored as an angle,
+// the staple field of this class stores Re[U_mu(n) S^+_mu(n)] = sum cos theta_P,
+// which is all we need for the energy.
+//
+// The file format is the same as CFieldGaugeU1 (re, im of each link).
+// Dirichlet boundary links are arg of the CFieldBoundaryGaugeU1.
+// The gauge actions have their own kernels on the angles.
+// The fermions written for CFieldGaugeU1 use GetU1Links,
+// which is exp(i theta) cached until the version of the field changes,
+// and PrepareU1Force/AcceptU1Force for the force.
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#ifndef _CFIELDGAUGE_U1_ANGLE_H_
+#define _CFIELDGAUGE_U1_ANGLE_H_
+
+__BEGIN_NAMESPACE
+
+__CLG_REGISTER_HELPER_HEADER(CFieldGaugeU1Angle)
+
+class CLGAPI CFieldGaugeU1Angle : public CFieldGauge
+{
+    __CLGDECLARE_FIELD(CFieldGaugeU1Angle)
+
+public:
+    CFieldGaugeU1Angle();
+    ~CFieldGaugeU1Angle();
+
+    void InitialFieldWithFile(const CCString& sFileName, EFieldFileType eFileType) override;
+    void InitialWithByte(BYTE* byData) override;
+    void InitialField(EFieldInitialType eInitialType) override;
+    EFieldType GetFieldType() const override { return EFT_GaugeU1Angle; }
+    void DebugPrintMe() const override;
+
+#pragma region HMC
+
+    void CalculateForceAndStaple(CFieldGauge* pForce, CFieldGauge* pStaple, Real betaOverN) const override;
+    void CalculateOnlyStaple(CFieldGauge* pStaple) const override;
+    void MakeRandomGenerator() override;
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE CalculatePlaqutteEnergy(DOUBLE betaOverN) const override;
+    DOUBLE CalculatePlaqutteEnergyUseClover(DOUBLE betaOverN) const override;
+    DOUBLE CalculatePlaqutteEnergyUsingStable(DOUBLE betaOverN, const CFieldGauge* pStaple) const override;
+    DOUBLE CalculateKinematicEnergy() const override;
+#else
+    Real CalculatePlaqutteEnergy(Real betaOverN) const override;
+    Real CalculatePlaqutteEnergyUseClover(Real betaOverN) const override;
+    Real CalculatePlaqutteEnergyUsingStable(Real betaOverN, const CFieldGauge *pStaple) const override;
+    Real CalculateKinematicEnergy() const override;
+#endif
+
+#pragma endregion
+
+#pragma region BLAS
+
+    /**
+     * Both Zero and Identity are theta = 0
+     * For complex coefficient, only the real part is used
+     */
+    void Zero() override;
+    void Identity() override;
+    void Dagger() override;
+
+    void AxpyPlus(const CField* x) override;
+    void AxpyMinus(const CField* x) override;
+    void Axpy(Real a, const CField* x) override;
+    void Axpy(const CLGComplex& a, const CField* x) override;
+    void ScalarMultply(const CLGComplex& a) override;
+    void ScalarMultply(Real a) override;
+
+    void SetOneDirectionUnity(BYTE byDir) override;
+    void SetOneDirectionZero(BYTE byDir) override;
+
+#pragma endregion
+
+#pragma region Test Functions to test gauge invarience of angular momentum
+
+    /**
+     * The angle is already A, nothing to do
+     */
+    void TransformToIA() override { ; }
+    void TransformToU() override { ; }
+
+    void CalculateE_Using_U(CFieldGauge* pResoult) const override;
+
+    void CalculateNablaE_Using_U(CFieldGauge* pResoult, UBOOL bNaive = FALSE) const override;
+
+#pragma endregion
+
+    void ExpMult(Real a, CField* U) const override;
+
+    /**
+     * Wrap theta into [-pi, pi)
+     */
+    void ElementNormalize() override;
+
+    /**
+     * The angles are exchanged, GetU1Links is rebuilt from them with the halo
+     */
+    void ExchangeHalo() override;
+#if !_CLG_DOUBLEFLOAT
+    cuDoubleComplex Dot(const CField* other) const override;
+#else
+    CLGComplex Dot(const CField* other) const override;
+#endif
+    BYTE* CopyDataOut(UINT &uiSize) const override;
+    BYTE* CopyDataOutFloat(UINT& uiSize) const override;
+    BYTE* CopyDataOutDouble(UINT& uiSize) const override;
+    CCString GetInfos(const CCString &tab) const override;
+
+    /**
+     * U = exp(i theta), and theta = arg(U)
+     */
+    void CopyToU1(CFieldGaugeU1* pU1) const;
+    void InitialWithU1(const CFieldGaugeU1* pU1);
+
+    /**
+     * exp(i theta) in the layout of CFieldGaugeU1, rebuilt only when the version is changed
+     */
+    const CLGComplex* GetU1Links() const;
+
+    /**
+     * The force of CFieldGaugeU1 is i F.
+     * PrepareU1Force returns a zeroed buffer for the kernels of CFieldGaugeU1, AcceptU1Force adds F to this field.
+     */
+    CLGComplex* PrepareU1Force();
+    void AcceptU1Force();
+
+    /**
+     * m_pDeviceData of CFieldGaugeU1, GetU1Links of CFieldGaugeU1Angle, and NULL for other fields
+     */
+    static const CLGComplex* U1LinksOf(const CField* pGauge);
+
+    Real* m_pDeviceData;
+
+protected:
+
+    mutable CLGComplex* m_pDeviceU1Links;
+    mutable UINT m_uiU1LinksVersion;
+    CLGComplex* m_pDeviceU1Force;
+};
+
+#pragma region Helper device functions
+
+/**
+ * Same as _deviceGetGaugeBCU1DirSIndex, the Dirichlet links are read from the boundary field
+ */
+static __device__ __inline__ Real _deviceGetU1AngleSIndex(
+    const Real* __restrict__ pDeviceData,
+    const SIndex& idx,
+    BYTE byFieldId)
+{
+    const Real fTheta = idx.IsDirichlet() ?
+        __cuCargf(((CFieldBoundaryGaugeU1*)__boundaryFieldPointers[byFieldId])->m_pDeviceData[
+            __idx->_devcieExchangeBoundaryFieldSiteIndex(idx) * _DC_Dir + idx.m_byDir
+        ])
+        : pDeviceData[_deviceGetLinkIndex(idx.m_uiSiteIndex, idx.m_byDir)];
+    return idx.NeedToDagger() ? -fTheta : fTheta;
+}
+
+/**
+ * theta in [-pi, pi), the fast math sincos is only accurate for small angles
+ */
+static __device__ __inline__ Real _deviceWrapU1Angle(Real fTheta)
+{
+    return fTheta - PI2 * _floor2int(fTheta / PI2 + F(0.5));
+}
+
+/**
+ * sum of cos of the 4 leaves of the clover in mu-nu plane
+ * the orientation of the leaves does not matter for cos
+ */
+static __device__ __inline__ Real _deviceCloverCosU1Angle(
+    const Real* __restrict__ pDeviceData,
+    const SSmallInt4& sSite4, UINT uiBigIdx, BYTE byMu, BYTE byNu, BYTE byFieldId)
+{
+    const SIndex* __restrict__ pLinks = __idx->m_pDeviceIndexLinkToSIndex[byFieldId];
+    const SSmallInt4 n_p_mu = _deviceSmallInt4OffsetC(sSite4, byMu + 1);
+    const SSmallInt4 n_p_nu = _deviceSmallInt4OffsetC(sSite4, byNu + 1);
+    const SSmallInt4 n_m_mu = _deviceSmallInt4OffsetC(sSite4, -static_cast<INT>(byMu) - 1);
+    const SSmallInt4 n_m_nu = _deviceSmallInt4OffsetC(sSite4, -static_cast<INT>(byNu) - 1);
+    const SSmallInt4 n_m_mu_p_nu = _deviceSmallInt4OffsetC(n_m_mu, byNu + 1);
+    const SSmallInt4 n_m_nu_p_mu = _deviceSmallInt4OffsetC(n_m_nu, byMu + 1);
+    const SSmallInt4 n_m_mu_m_nu = _deviceSmallInt4OffsetC(n_m_mu, -static_cast<INT>(byNu) - 1);
+
+    const UINT uiB4 = uiBigIdx * _DC_Dir;
+    const UINT uiB4_m_mu = __idx->_deviceGetBigIndex(n_m_mu) * _DC_Dir;
+    const UINT uiB4_m_nu = __idx->_deviceGetBigIndex(n_m_nu) * _DC_Dir;
+    const UINT uiB4_m_mu_m_nu = __idx->_deviceGetBigIndex(n_m_mu_m_nu) * _DC_Dir;
+
+    const Real fMu = _deviceGetU1AngleSIndex(pDeviceData, pLinks[uiB4 + byMu], byFieldId);
+    const Real fNu = _deviceGetU1AngleSIndex(pDeviceData, pLinks[uiB4 + byNu], byFieldId);
+    const Real f_m_mu__mu = _deviceGetU1AngleSIndex(pDeviceData, pLinks[uiB4_m_mu + byMu], byFieldId);
+    const Real f_m_nu__nu = _deviceGetU1AngleSIndex(pDeviceData, pLinks[uiB4_m_nu + byNu], byFieldId);
+
+    //U_mu(n) U_nu(n+mu) U^+_mu(n+nu) U^+_nu(n)
+    const Real fPP = fMu
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[__idx->_deviceGetBigIndex(n_p_mu) * _DC_Dir + byNu], byFieldId)
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[__idx->_deviceGetBigIndex(n_p_nu) * _DC_Dir + byMu], byFieldId)
+        - fNu;
+
+    //U^+_mu(n-mu) U_nu(n-mu) U_mu(n-mu+nu) U^+_nu(n)
+    const Real fMP = - f_m_mu__mu
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[uiB4_m_mu + byNu], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[__idx->_deviceGetBigIndex(n_m_mu_p_nu) * _DC_Dir + byMu], byFieldId)
+        - fNu;
+
+    //U_mu(n) U^+_nu(n+mu-nu) U^+_mu(n-nu) U_nu(n-nu)
+    const Real fPM = fMu
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[__idx->_deviceGetBigIndex(n_m_nu_p_mu) * _DC_Dir + byNu], byFieldId)
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[uiB4_m_nu + byMu], byFieldId)
+        + f_m_nu__nu;
+
+    //U^+_mu(n-mu) U^+_nu(n-mu-nu) U_mu(n-mu-nu) U_nu(n-nu)
+    const Real fMM = - f_m_mu__mu
+        - _deviceGetU1AngleSIndex(pDeviceData, pLinks[uiB4_m_mu_m_nu + byNu], byFieldId)
+        + _deviceGetU1AngleSIndex(pDeviceData, pLinks[uiB4_m_mu_m_nu + byMu], byFieldId)
+        + f_m_nu__nu;
+
+    return _cos(_deviceWrapU1Angle(fPP)) + _cos(_deviceWrapU1Angle(fMP)) + _cos(_deviceWrapU1Angle(fPM)) + _cos(_deviceWrapU1Angle(fMM));
+}
+
+#pragma endregion
+
+__END_NAMESPACE
+
+#endif //#ifndef _CFIELDGAUGE_U1_ANGLE_H_
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
@@ -33,6 +33,8 @@ __global__ void _CLG_LAUNCH_BOUND
 _kernelInitialU1RealField(Real *pDevicePtr, EFieldInitialType eInitialType)
 {
     intokernaldir;
+    SRandomDraw uiDraw;
+    CLGComplex cGauss = _make_cuComplex(F(0.0), F(0.0));
     for (UINT idir = 0; idir < uiDir; ++idir)
     {
         UINT uiLinkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
@@ -51,12 +53,21 @@ _kernelInitialU1RealField(Real *pDevicePtr, EFieldInitialType eInitialType)
         break;
         case EFIT_Random:
         {
-            pDevicePtr[uiLinkIndex] = _deviceRandomF(_deviceGetFatIndex(uiSiteIndex, idir + 1)) * PI2 - PI;
+            pDevicePtr[uiLinkIndex] = _deviceRandomF(_deviceGetFatIndex(uiSiteIndex, idir + 1), uiDraw) * PI2 - PI;
         }
         break;
         case EFIT_RandomGenerator:
         {
-            pDevicePtr[uiLinkIndex] = _deviceRandomGaussFSqrt2(_deviceGetFatIndex(uiSiteIndex, idir + 1)) * PI2 - PI;
+            //both numbers of Box-Muller are used, for idir and idir + 1
+            if (0 == (idir & 1))
+            {
+                cGauss = _deviceRandomGaussCSqrt2(_deviceGetFatIndex(uiSiteIndex, idir + 1), uiDraw);
+                pDevicePtr[uiLinkIndex] = cGauss.x * PI2 - PI;
+            }
+            else
+            {
+                pDevicePtr[uiLinkIndex] = cGauss.y * PI2 - PI;
+            }
         }
         break;
         default:
@@ -834,6 +845,7 @@ void CFieldGaugeU1Real::Dagger()
 void CFieldGaugeU1Real::MakeRandomGenerator()
 {
     preparethread;
+    appGetLattice()->m_pRandom->NextLaunch();
     _kernelInitialU1RealField << <block, threads >> > (m_pDeviceData, EFIT_RandomGenerator);
 }
 
@@ -899,7 +911,9 @@ void CFieldGaugeU1Real::InitialField(EFieldInitialType eInitialType)
     }
 
     preparethread;
+    appGetLattice()->m_pRandom->NextLaunch();
     _kernelInitialU1RealField << <block, threads >> > (m_pDeviceData, eInitialType);
+    IncreaseVersion();
 }
 
 void CFieldGaugeU1Real::InitialFieldWithFile(const CCString& sFileName, EFieldFileType eType)
@@ -1026,6 +1040,7 @@ void CFieldGaugeU1Real::InitialWithByte(BYTE* byData)
     }
     checkCudaErrors(cudaMemcpy(m_pDeviceData, readData, sizeof(Real) * m_uiLinkeCount, cudaMemcpyHostToDevice));
     free(readData);
+    IncreaseVersion();
 }
 
 void CFieldGaugeU1Real::InitialU1Real(EU1RealType eChemicalType, EU1RealType eEType, EU1RealType eBType, Real fChemical, Real feEz, Real feBz)
@@ -1333,7 +1348,7 @@ void CFieldGaugeU1Real::ExpMult(Real a, CField* U) const
 
     preparethread;
     _kernelExpMultU1Real_R << < block, threads >> > (m_pDeviceData, a, pUField->m_pDeviceData);
-    
+    pUField->IncreaseVersion();
 }
 
 #if !_CLG_DOUBLEFLOAT
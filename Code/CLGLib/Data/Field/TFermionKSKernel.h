@@ -0,0 +1,829 @@
+//=============================================================================
+// FILENAME : TFermionKSKernel.h
+//
+// DESCRIPTION:
+// The staggered operator and force composed of policies
+//
+// D = 2am + sum _mu [eta_f U'(n,mu) phi(n+mu) - eta_b U'^+(n-mu,mu) phi(n-mu)]
+//
+// Group: the gauge group, SU3 or U1, the link and vector type with operations
+// Stencil: the neighbours n+mu, n-mu, eta and the sign of the boundary condition
+//   SKSStencilCache<Eta>: the move caches (NeedToDagger and NeedToOpposite) and the eta table,
+//     Eta is eta(n) for both, or eta(n) and eta(n-mu) (m_bEachSiteEta)
+//   SKSStencilTorus: on torus (CIndex::UseDirectStencil), computed from the coordinate,
+//     so the move caches and the eta table (3 x Dir SIndex and 1 byte per site) are not read
+// Phase: U'(n,mu) = U(n,mu) x phase, for example, the external U1 field
+//
+// Each combination is one kernel, so improvement on the hopping term is done here once for all variants.
+//
+// The field class launches _kernelDFermionKST<Group, Stencil, Phase>
+// and _kernelDFermionKSForceT<Group, Stencil, Phase>.
+// _kernelDFermionKST can also do the BLAS after D (b - D x, <x, D x>, |D x|^2),
+// pass NULL if not needed. It only writes the sites in sRange, so it can be split
+// by the halo exchange (see appBeginExchangeHalo), pass SXPlaneRange::All() if not.
+//
+// The rotation terms (CFieldFermionKSSU3R, CFieldFermionKSU1R, CFieldFermionKSSU3REM)
+// are _kernelDFermionKSRotationXYT and _kernelDFermionKSRotationXYTauT (with the force),
+// the 3-link transporters are given by a Path policy.
+//
+// Not composed here: Wilson (not staggered), Asqtad (fat links and Naik term, its own kernel),
+// and CFieldFermionKSSU3Gamma, P4, D, DR, whose extra terms are longer paths with their own kernels,
+// their hopping term is the one of CFieldFermionKSSU3.
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#ifndef _TFERMIONKSKERNEL_H_
+#define _TFERMIONKSKERNEL_H_
+
+#if defined(__cplusplus) && defined(__CUDACC__)
+
+__BEGIN_NAMESPACE
+
+#pragma region Group
+
+struct SKSGroupSU3
+{
+    typedef deviceSU3 deviceGauge;
+    typedef deviceSU3Vector deviceVector;
+
+    static __device__ __inline__ deviceVector Zero() { return deviceSU3Vector::makeZeroSU3Vector(); }
+    static __device__ __inline__ void Dagger(deviceGauge& u) { u.Dagger(); }
+    static __device__ __inline__ void MulComp(deviceGauge& u, const CLGComplex& c) { u.MulComp(c); }
+    static __device__ __inline__ deviceVector Mul(const deviceGauge& u, const deviceVector& v) { return u.MulVector(v); }
+    static __device__ __inline__ void Add(deviceVector& v, const deviceVector& other) { v.Add(other); }
+    static __device__ __inline__ void Sub(deviceVector& v, const deviceVector& other) { v.Sub(other); }
+    static __device__ __inline__ void MulReal(deviceVector& v, Real f) { v.MulReal(f); }
+    static __device__ __inline__ void MulCompV(deviceVector& v, const CLGComplex& c) { v.MulComp(c); }
+    static __device__ __inline__ CLGComplex Dot(const deviceVector& left, const deviceVector& right) { return left.ConjugateDotC(right); }
+
+    /**
+     * left^+ right, and add the other term
+     */
+    static __device__ __inline__ deviceGauge Contract(const deviceVector& left, const deviceVector& right)
+    {
+        return deviceSU3::makeSU3ContractV(left, right);
+    }
+    static __device__ __inline__ void AddGauge(deviceGauge& u, const deviceGauge& other) { u.Add(other); }
+
+    /**
+     * force = force - Ta[term] x f
+     */
+    static __device__ __inline__ void SubForce(deviceGauge& force, deviceGauge term, Real f)
+    {
+        term.MulReal(f);
+        term.Ta();
+        force.Sub(term);
+    }
+};
+
+struct SKSGroupU1
+{
+    typedef CLGComplex deviceGauge;
+    typedef CLGComplex deviceVector;
+
+    static __device__ __inline__ deviceVector Zero() { return _zeroc; }
+    static __device__ __inline__ void Dagger(deviceGauge& u) { u.y = -u.y; }
+    static __device__ __inline__ void MulComp(deviceGauge& u, const CLGComplex& c) { u = _cuCmulf(u, c); }
+    static __device__ __inline__ deviceVector Mul(const deviceGauge& u, const deviceVector& v) { return _cuCmulf(u, v); }
+    static __device__ __inline__ void Add(deviceVector& v, const deviceVector& other) { v.x += other.x; v.y += other.y; }
+    static __device__ __inline__ void Sub(deviceVector& v, const deviceVector& other) { v.x -= other.x; v.y -= other.y; }
+    static __device__ __inline__ void MulReal(deviceVector& v, Real f) { v.x *= f; v.y *= f; }
+    static __device__ __inline__ void MulCompV(deviceVector& v, const CLGComplex& c) { v = _cuCmulf(v, c); }
+    static __device__ __inline__ CLGComplex Dot(const deviceVector& left, const deviceVector& right) { return _cuCmulf(_cuConjf(left), right); }
+
+    static __device__ __inline__ deviceGauge Contract(const deviceVector& left, const deviceVector& right)
+    {
+        return _cuCmulf(_cuConjf(left), right);
+    }
+    static __device__ __inline__ void AddGauge(deviceGauge& u, const deviceGauge& other) { u.x += other.x; u.y += other.y; }
+
+    /**
+     * Ta of a complex number is i Im
+     */
+    static __device__ __inline__ void SubForce(deviceGauge& force, const deviceGauge& term, Real f)
+    {
+        force.y -= term.y * f;
+    }
+};
+
+#pragma endregion
+
+#pragma region Stencil
+
+/**
+ * eta(n) for both n+mu and n-mu
+ */
+struct SKSEtaSite
+{
+    static __device__ __inline__ Real Forward(const BYTE* __restrict__ pEtaTable, UINT uiSiteIndex, BYTE byDir)
+    {
+        return (1 == ((pEtaTable[uiSiteIndex] >> byDir) & 1)) ? F(-1.0) : F(1.0);
+    }
+
+    static __device__ __inline__ Real Backward(const BYTE* __restrict__ pEtaTable, UINT uiSiteIndex, UINT uiSiteMinusMu, BYTE byDir)
+    {
+        return (1 == ((pEtaTable[uiSiteIndex] >> byDir) & 1)) ? F(-1.0) : F(1.0);
+    }
+};
+
+/**
+ * For some strange boundary condition, eta(n) for n+mu and eta(n-mu) for n-mu
+ */
+struct SKSEtaEachSite
+{
+    static __device__ __inline__ Real Forward(const BYTE* __restrict__ pEtaTable, UINT uiSiteIndex, BYTE byDir)
+    {
+        return (1 == ((pEtaTable[uiSiteIndex] >> byDir) & 1)) ? F(-1.0) : F(1.0);
+    }
+
+    static __device__ __inline__ Real Backward(const BYTE* __restrict__ pEtaTable, UINT uiSiteIndex, UINT uiSiteMinusMu, BYTE byDir)
+    {
+        return (1 == ((pEtaTable[uiSiteMinusMu] >> byDir) & 1)) ? F(-1.0) : F(1.0);
+    }
+};
+
+/**
+ * The hopping term of n in direction mu is
+ * m_fPlus U(n,mu) phi(m_uiPlus) - m_fMinus U'(m_uiGaugeMinus,mu) phi(m_uiMinus)
+ * U' is U^+ when m_bDaggerMinus, m_fPlus and m_fMinus are eta with the sign of the boundary condition
+ */
+struct SKSHop
+{
+    UINT m_uiPlus;
+    UINT m_uiMinus;
+    UINT m_uiGaugeMinus;
+    UBOOL m_bDaggerMinus;
+    Real m_fPlus;
+    Real m_fMinus;
+};
+
+template<class Eta>
+struct SKSStencilCache
+{
+    const SIndex* m_pGaugeMove;
+    const SIndex* m_pFermionMove;
+    const BYTE* m_pEtaTable;
+
+    __device__ __inline__ SKSHop Hop(UINT uiSiteIndex, const SSmallInt4& sSite4, BYTE byDir) const
+    {
+        const UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, byDir);
+        const SIndex& x_m_mu_Gauge = m_pGaugeMove[linkIndex];
+        const SIndex& x_p_mu_Fermion = m_pFermionMove[2 * linkIndex];
+        const SIndex& x_m_mu_Fermion = m_pFermionMove[2 * linkIndex + 1];
+        const Real eta_mu = Eta::Forward(m_pEtaTable, uiSiteIndex, byDir);
+        const Real eta_mu2 = Eta::Backward(m_pEtaTable, uiSiteIndex, x_m_mu_Fermion.m_uiSiteIndex, byDir);
+
+        SKSHop hop;
+        hop.m_uiPlus = x_p_mu_Fermion.m_uiSiteIndex;
+        hop.m_uiMinus = x_m_mu_Fermion.m_uiSiteIndex;
+        hop.m_uiGaugeMinus = x_m_mu_Gauge.m_uiSiteIndex;
+        hop.m_bDaggerMinus = x_m_mu_Gauge.NeedToDagger();
+        hop.m_fPlus = x_p_mu_Fermion.NeedToOpposite() ? -eta_mu : eta_mu;
+        hop.m_fMinus = x_m_mu_Fermion.NeedToOpposite() ? -eta_mu2 : eta_mu2;
+        return hop;
+    }
+
+    /**
+     * n+mu and eta(n) with the sign, for the force
+     */
+    __device__ __inline__ Real Forward(UINT uiSiteIndex, const SSmallInt4& sSite4, BYTE byDir, UINT& uiPlus) const
+    {
+        const SIndex& x_p_mu_Fermion = m_pFermionMove[2 * _deviceGetLinkIndex(uiSiteIndex, byDir)];
+        const Real eta_mu = SKSEtaSite::Forward(m_pEtaTable, uiSiteIndex, byDir);
+        uiPlus = x_p_mu_Fermion.m_uiSiteIndex;
+        return x_p_mu_Fermion.NeedToOpposite() ? -eta_mu : eta_mu;
+    }
+};
+
+#if _CLG_DIRECT_STENCIL
+
+/**
+ * m_sBC is the boundary condition of the fermion, the gauge field must be periodic,
+ * so U(n-mu) always needs dagger
+ */
+struct SKSStencilTorus
+{
+    SSmallInt4 m_sBC;
+
+    __device__ __inline__ SKSHop Hop(UINT uiSiteIndex, const SSmallInt4& sSite4, BYTE byDir) const
+    {
+        SSmallInt4 x_p_mu = sSite4;
+        const UBOOL bOppositeForward = _deviceTorusMove(x_p_mu, static_cast<INT>(byDir) + 1, m_sBC);
+        SSmallInt4 x_m_mu = sSite4;
+        const UBOOL bOppositeBackward = _deviceTorusMove(x_m_mu, -static_cast<INT>(byDir) - 1, m_sBC);
+        const Real eta_mu = sSite4.EtaOdd(byDir) ? F(-1.0) : F(1.0);
+
+        SKSHop hop;
+        hop.m_uiPlus = _deviceGetSiteIndex(x_p_mu);
+        hop.m_uiMinus = _deviceGetSiteIndex(x_m_mu);
+        hop.m_uiGaugeMinus = hop.m_uiMinus;
+        hop.m_bDaggerMinus = TRUE;
+        hop.m_fPlus = bOppositeForward ? -eta_mu : eta_mu;
+        hop.m_fMinus = bOppositeBackward ? -eta_mu : eta_mu;
+        return hop;
+    }
+
+    __device__ __inline__ Real Forward(UINT uiSiteIndex, const SSmallInt4& sSite4, BYTE byDir, UINT& uiPlus) const
+    {
+        SSmallInt4 x_p_mu = sSite4;
+        const UBOOL bOpposite = _deviceTorusMove(x_p_mu, static_cast<INT>(byDir) + 1, m_sBC);
+        const Real eta_mu = sSite4.EtaOdd(byDir) ? F(-1.0) : F(1.0);
+        uiPlus = _deviceGetSiteIndex(x_p_mu);
+        return bOpposite ? -eta_mu : eta_mu;
+    }
+};
+
+#endif
+
+#pragma endregion
+
+#pragma region Phase
+
+struct SKSPhaseNone
+{
+    template<class Group>
+    __device__ __inline__ void Link(typename Group::deviceGauge& u, UINT uiSiteIndex, BYTE byDir) const
+    {
+    }
+};
+
+/**
+ * qBz: u_y = exp(i qBz x), u_x(L_x) = exp(-i qBz Lx y)
+ * qEz: u_t = exp(- i qEz z), u_z(L_z) = exp(i qEz Lz t)
+ */
+struct SKSPhaseEMSimple
+{
+    Real m_fqEz;
+    Real m_fqBz;
+    SSmallInt4 m_sCenter;
+
+    template<class Group>
+    __device__ __inline__ void Link(typename Group::deviceGauge& u, UINT uiSiteIndex, BYTE byDir) const
+    {
+        const SSmallInt4 sSite4 = __deviceSiteIndexToInt4(uiSiteIndex);
+        Real fPhase = F(0.0);
+        switch (byDir)
+        {
+        case 0:
+            if (sSite4.x == _DC_Lx - 1)
+            {
+                fPhase = -static_cast<Real>(sSite4.y - m_sCenter.y) * _DC_Lx * m_fqBz;
+            }
+            break;
+        case 1:
+            fPhase = static_cast<Real>(sSite4.x - m_sCenter.x) * m_fqBz;
+            break;
+        case 2:
+            if (sSite4.z == _DC_Lz - 1)
+            {
+                fPhase = static_cast<Real>(sSite4.w - m_sCenter.w) * _DC_Lz * m_fqEz;
+            }
+            break;
+        case 3:
+            fPhase = -static_cast<Real>(sSite4.z - m_sCenter.z) * m_fqEz;
+            break;
+        }
+        Group::MulComp(u, _make_cuComplex(_cos(fPhase), _sin(fPhase)));
+    }
+};
+
+/**
+ * U'(n,mu) = U(n,mu) exp(i q A(n,mu)), A is the CFieldGaugeU1Real background,
+ * for example, the magnetic field and the imaginary chemical potential
+ */
+struct SKSPhaseU1Real
+{
+    const Real* m_pU1;
+    Real m_fCharge;
+
+    template<class Group>
+    __device__ __inline__ void Link(typename Group::deviceGauge& u, UINT uiSiteIndex, BYTE byDir) const
+    {
+        const Real fPhase = m_pU1[_deviceGetLinkIndex(uiSiteIndex, byDir)] * m_fCharge;
+        Group::MulComp(u, _make_cuComplex(_cos(fPhase), _sin(fPhase)));
+    }
+};
+
+#pragma endregion
+
+#pragma region Kernels
+
+/**
+* If bDagger, it is just \eta 5(n) Dks \eta _5(n)
+* A easier way is D_{ks}(m=0) is anti-Hermitian, so D^+ = - D_{ks,m=0} + 2am
+*/
+template<class Group, class Stencil, class Phase>
+__global__ void _CLG_LAUNCH_BOUND
+_kernelDFermionKST(
+    const typename Group::deviceVector* __restrict__ pDeviceData,
+    const typename Group::deviceGauge* __restrict__ pGauge,
+    typename Group::deviceVector* pResultData,
+    Real f2am,
+    UBOOL bDDagger,
+    EOperatorCoefficientType eCoeff,
+    Real fCoeff,
+    CLGComplex cCoeff,
+    Stencil stencil,
+    Phase phase,
+    SXPlaneRange sRange,
+    const typename Group::deviceVector* __restrict__ pB,
+#if !_CLG_DOUBLEFLOAT
+    cuDoubleComplex* pDot,
+    DOUBLE* pNorm
+#else
+    CLGComplex* pDot,
+    Real* pNorm
+#endif
+    )
+{
+    intokernalInt4;
+    if (sRange.Skip(sSite4.x))
+    {
+        return;
+    }
+    const UINT uiDir = _DC_Dir;
+
+    typename Group::deviceVector result = Group::Zero();
+
+    //idir = mu
+    for (UINT idir = 0; idir < uiDir; ++idir)
+    {
+        const SKSHop hop = stencil.Hop(uiSiteIndex, sSite4, static_cast<BYTE>(idir));
+
+        //get U(x,mu), U^{dagger}(x-mu)
+        typename Group::deviceGauge x_Gauge_element = pGauge[_deviceGetLinkIndex(uiSiteIndex, idir)];
+        phase.template Link<Group>(x_Gauge_element, uiSiteIndex, static_cast<BYTE>(idir));
+        typename Group::deviceGauge x_m_mu_Gauge_element = pGauge[_deviceGetLinkIndex(hop.m_uiGaugeMinus, idir)];
+        phase.template Link<Group>(x_m_mu_Gauge_element, hop.m_uiGaugeMinus, static_cast<BYTE>(idir));
+        if (hop.m_bDaggerMinus)
+        {
+            Group::Dagger(x_m_mu_Gauge_element);
+        }
+
+        //U(x,mu) phi(x+ mu)
+        typename Group::deviceVector u_phi_x_p_m = Group::Mul(x_Gauge_element, pDeviceData[hop.m_uiPlus]);
+        Group::MulReal(u_phi_x_p_m, hop.m_fPlus);
+
+        //U^{dagger}(x-mu) phi(x-mu)
+        typename Group::deviceVector u_dagger_phi_x_m_m = Group::Mul(x_m_mu_Gauge_element, pDeviceData[hop.m_uiMinus]);
+        Group::MulReal(u_dagger_phi_x_m_m, hop.m_fMinus);
+        Group::Sub(u_phi_x_p_m, u_dagger_phi_x_m_m);
+        Group::Add(result, u_phi_x_p_m);
+    }
+
+    typename Group::deviceVector res = pDeviceData[uiSiteIndex];
+    Group::MulReal(res, f2am);
+    if (bDDagger)
+    {
+        Group::Sub(res, result);
+    }
+    else
+    {
+        Group::Add(res, result);
+    }
+
+    switch (eCoeff)
+    {
+    case EOCT_Real:
+        Group::MulReal(res, fCoeff);
+        break;
+    case EOCT_Complex:
+        Group::MulCompV(res, cCoeff);
+        break;
+    }
+
+    //the fused BLAS, res = b - res, <phi, res>, <res, res>
+    if (NULL != pB)
+    {
+        typename Group::deviceVector bMinus = pB[uiSiteIndex];
+        Group::Sub(bMinus, res);
+        res = bMinus;
+    }
+    if (NULL != pDot)
+    {
+#if !_CLG_DOUBLEFLOAT
+        pDot[uiSiteIndex] = _cToDouble(Group::Dot(pDeviceData[uiSiteIndex], res));
+#else
+        pDot[uiSiteIndex] = Group::Dot(pDeviceData[uiSiteIndex], res);
+#endif
+    }
+    if (NULL != pNorm)
+    {
+        pNorm[uiSiteIndex] = Group::Dot(res, res).x;
+    }
+    pResultData[uiSiteIndex] = res;
+}
+
+/**
+ * Calculate Force
+ * Only eta(n) is used for the link U(n,mu)
+ */
+template<class Group, class Stencil, class Phase>
+__global__ void _CLG_LAUNCH_BOUND
+_kernelDFermionKSForceT(
+    const typename Group::deviceGauge* __restrict__ pGauge,
+    typename Group::deviceGauge* pForce,
+    const typename Group::deviceVector* const* __restrict__ pFermionPointers,
+    const Real* __restrict__ pNumerators,
+    UINT uiRational,
+    Stencil stencil,
+    Phase phase)
+{
+    intokernalInt4;
+    const UINT uiDir = _DC_Dir;
+
+    //idir = mu
+    for (UINT idir = 0; idir < uiDir; ++idir)
+    {
+        UINT uiSite_p_mu = 0;
+        const Real eta_mu = stencil.Forward(uiSiteIndex, sSite4, static_cast<BYTE>(idir), uiSite_p_mu);
+        //x, mu
+        const UINT linkIndex = _deviceGetLinkIndex(uiSiteIndex, idir);
+
+        typename Group::deviceGauge x_Gauge_element = pGauge[linkIndex];
+        phase.template Link<Group>(x_Gauge_element, uiSiteIndex, static_cast<BYTE>(idir));
+
+        for (UINT uiR = 0; uiR < uiRational; ++uiR)
+        {
+            const typename Group::deviceVector* phi_i = pFermionPointers[uiR];
+            const typename Group::deviceVector* phi_id = pFermionPointers[uiR + uiRational];
+
+            typename Group::deviceVector toContract = Group::Mul(x_Gauge_element, phi_i[uiSite_p_mu]);
+            typename Group::deviceGauge thisTerm = Group::Contract(phi_id[uiSiteIndex], toContract);
+
+            toContract = Group::Mul(x_Gauge_element, phi_id[uiSite_p_mu]);
+            Group::AddGauge(thisTerm, Group::Contract(toContract, phi_i[uiSiteIndex]));
+
+            Group::SubForce(pForce[linkIndex], thisTerm, eta_mu * pNumerators[uiR]);
+        }
+    }
+}
+
+#pragma region Rotation
+
+/**
+ * Path: the averaged 3-link transporters of the rotation terms
+ *   deviceGauge XXTau(sSite, bXorY, bPlusMu, bPlusTau): n -> n + 2mu + tau
+ *   deviceGauge XYTau(sSite, bPlusX, bPlusY, bPlusTau): n -> n + x + y + tau
+ *   deviceGauge Link(sSite, byLength, pDir): the path given by directions
+ * For example, SKSRotationPathSU3, SKSRotationPathU1 and SKSRotationPathEM
+ *
+ * When link n and n+mu, the coordinate is stick with n
+ * When link n and n-mu, the coordinate is stick with n-mu
+ * Irrelavent with tau
+ */
+template<class Group, class Path>
+__global__ void _CLG_LAUNCH_BOUND
+_kernelDFermionKSRotationXYT(
+    const typename Group::deviceVector* __restrict__ pDeviceData,
+    const BYTE* __restrict__ pEtaTable,
+    typename Group::deviceVector* pResultData,
+    BYTE byFieldId,
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE fOmega,
+#else
+    Real fOmega,
+#endif
+    SSmallInt4 sCenter,
+    UBOOL bDDagger,
+    EOperatorCoefficientType eCoeff,
+    Real fCoeff,
+    CLGComplex cCoeff,
+    Path path)
+{
+    intokernalInt4;
+
+    typename Group::deviceVector result = Group::Zero();
+    const INT eta_tau = pEtaTable[uiSiteIndex] >> 3;
+
+    #pragma unroll
+    for (UINT idx = 0; idx < 8; ++idx)
+    {
+        const UBOOL bPlusMu = idx & 2;
+        const UBOOL bPlusTau = idx & 4;
+        //x or y, and y or x is the derivate, not coefficient
+        const UINT bXorY = idx & 1;
+        const UINT bYorX = 1 - bXorY;
+        SSmallInt4 sTargetSite = sSite4;
+        SSmallInt4 sMidSite = sSite4;
+        sTargetSite.m_byData4[bYorX] = sTargetSite.m_byData4[bYorX] + (bPlusMu ? 2 : -2);
+        sMidSite.m_byData4[bYorX] = sMidSite.m_byData4[bYorX] + (bPlusMu ? 1 : -1);
+        sTargetSite.w = sTargetSite.w + (bPlusTau ? 1 : -1);
+        //We have anti-periodic boundary, so we need to use index out of lattice to get the correct sign
+        const SIndex& sTargetBigIndex = __idx->m_pDeviceIndexPositionToSIndex[byFieldId][__bi(sTargetSite)];
+        const SIndex& sMiddleBigIndex = __idx->m_pDeviceIndexPositionToSIndex[byFieldId][__bi(sMidSite)];
+        sMidSite = __deviceSiteIndexToInt4(sMiddleBigIndex.m_uiSiteIndex);
+
+        //note that bYorX = 1, it is x partial_y term, therefore is '-'
+        INT this_eta_tau = (bPlusTau ? eta_tau : (pEtaTable[sTargetBigIndex.m_uiSiteIndex] >> 3))
+                         + bYorX;
+
+        if (sTargetBigIndex.NeedToOpposite())
+        {
+            this_eta_tau = this_eta_tau + 1;
+        }
+
+        typename Group::deviceVector right = Group::Mul(
+            path.XXTau(sSite4, bXorY, bPlusMu, bPlusTau),
+            pDeviceData[sTargetBigIndex.m_uiSiteIndex]);
+
+        //when bXorY = 1, it is y partial _x, so is [1]
+        //when bXorY = 0, it is x partial _y, so is [0]
+        Group::MulReal(right, sMidSite.m_byData4[bXorY] - sCenter.m_byData4[bXorY] + F(0.5));
+
+        if (!bPlusMu)
+        {
+            //for -2x, -2y terms, there is another minus sign
+            this_eta_tau = this_eta_tau + 1;
+        }
+
+        if (this_eta_tau & 1)
+        {
+            Group::Sub(result, right);
+        }
+        else
+        {
+            Group::Add(result, right);
+        }
+    }
+
+    Group::MulReal(result, static_cast<Real>(bDDagger ? (F(-0.25) * fOmega) : (F(0.25) * fOmega)));
+
+    switch (eCoeff)
+    {
+    case EOCT_Real:
+        Group::MulReal(result, fCoeff);
+        break;
+    case EOCT_Complex:
+        Group::MulCompV(result, cCoeff);
+        break;
+    }
+
+    Group::Add(pResultData[uiSiteIndex], result);
+}
+
+/**
+ * The polarization term
+ */
+template<class Group, class Path>
+__global__ void _CLG_LAUNCH_BOUND
+_kernelDFermionKSRotationXYTauT(
+    const typename Group::deviceVector* __restrict__ pDeviceData,
+    typename Group::deviceVector* pResultData,
+    BYTE byFieldId,
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE fOmega,
+#else
+    Real fOmega,
+#endif
+    UBOOL bDDagger,
+    EOperatorCoefficientType eCoeff,
+    Real fCoeff,
+    CLGComplex cCoeff,
+    Path path)
+{
+    intokernalInt4;
+
+    typename Group::deviceVector result = Group::Zero();
+
+    #pragma unroll
+    for (UINT idx = 0; idx < 8; ++idx)
+    {
+        const UBOOL bPlusX = (0 != (idx & 1));
+        const UBOOL bPlusY = (0 != (idx & 2));
+        const UBOOL bPlusT = (0 != (idx & 4));
+
+        SSmallInt4 sOffset = sSite4;
+        sOffset.x = sOffset.x + (bPlusX ? 1 : -1);
+        sOffset.y = sOffset.y + (bPlusY ? 1 : -1);
+        sOffset.w = sOffset.w + (bPlusT ? 1 : -1);
+
+        //We have anti-periodic boundary, so we need to use index out of lattice to get the correct sign
+        const SIndex& sTargetBigIndex = __idx->m_pDeviceIndexPositionToSIndex[byFieldId][__bi(sOffset)];
+
+        const typename Group::deviceVector right = Group::Mul(
+            path.XYTau(sSite4, bPlusX, bPlusY, bPlusT),
+            pDeviceData[sTargetBigIndex.m_uiSiteIndex]);
+        const SSmallInt4 site_target = __deviceSiteIndexToInt4(sTargetBigIndex.m_uiSiteIndex);
+
+        //eta124 of site is almost always -target, so use left or right is same
+        //The only exception is on the boundary
+        INT eta124 = bPlusT ? (sSite4.y + sSite4.z) : (site_target.y + site_target.z + 1);
+
+        if (sTargetBigIndex.NeedToOpposite())
+        {
+            eta124 = eta124 + 1;
+        }
+
+        if (eta124 & 1)
+        {
+            Group::Sub(result, right);
+        }
+        else
+        {
+            Group::Add(result, right);
+        }
+    }
+
+    Group::MulReal(result, static_cast<Real>(bDDagger ? (-F(0.125) * fOmega) : (F(0.125) * fOmega)));
+
+    switch (eCoeff)
+    {
+    case EOCT_Real:
+        Group::MulReal(result, fCoeff);
+        break;
+    case EOCT_Complex:
+        Group::MulCompV(result, cCoeff);
+        break;
+    }
+
+    Group::Add(pResultData[uiSiteIndex], result);
+}
+
+/**
+ * Have n, n->n1, n->n2,
+ * 1. we need to obtain V_(n, n1) , V_(n, n2)
+ * 2. we need phi(n1), phi(n2), phid(n1), phid(n2)
+ *
+ * byContribution: 0 for mu, 1 for tau, 2 for both mu and tau
+ *
+ * iTau = 1 for +t, -1 for -t
+ */
+template<class Group, class Path>
+__global__ void _CLG_LAUNCH_BOUND
+_kernelDFermionKSForceRotationXYT(
+    typename Group::deviceGauge* pForce,
+    const BYTE* __restrict__ pEtaTable,
+    const typename Group::deviceVector* const* __restrict__ pFermionPointers,
+    const Real* __restrict__ pNumerators,
+    UINT uiRational,
+    BYTE byFieldId,
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE fOmega,
+#else
+    Real fOmega,
+#endif
+    SSmallInt4 sCenter, BYTE byMu, INT iTau,
+    INT pathLdir1, INT pathLdir2, INT pathLdir3, BYTE Llength,
+    INT pathRdir1, INT pathRdir2, INT pathRdir3, BYTE Rlength,
+    BYTE byContribution,
+    Path path)
+{
+    intokernalInt4;
+
+    //=================================
+    // 1. Find n1, n2
+    INT Ldirs[3] = { pathLdir1, pathLdir2, pathLdir3 };
+    INT Rdirs[3] = { pathRdir1, pathRdir2, pathRdir3 };
+    SSmallInt4 site_n1 = _deviceSmallInt4OffsetC(sSite4, Ldirs, Llength);
+    const SIndex& sn1 = __idx->m_pDeviceIndexPositionToSIndex[byFieldId][__bi(site_n1)];
+    const SIndex& sn2 = __idx->m_pDeviceIndexPositionToSIndex[byFieldId][__bi(_deviceSmallInt4OffsetC(sSite4, Rdirs, Rlength))];
+    //From now on, site_n1 is smiddle
+    site_n1 = _deviceSmallInt4OffsetC(site_n1, byMu + 1);
+    const SIndex& smiddle = __idx->m_pDeviceIndexPositionToSIndex[byFieldId][__bi(site_n1)];
+
+    site_n1 = __deviceSiteIndexToInt4(smiddle.m_uiSiteIndex);
+    //y Dx and -x Dy
+    const Real fNv = (0 == byMu)
+        ? static_cast<Real>(site_n1.y - sCenter.y + F(0.5))
+        : static_cast<Real>(sCenter.x - site_n1.x - F(0.5));
+
+    //=================================
+    // 2. Find V(n,n1), V(n,n2)
+    const typename Group::deviceGauge vnn1 = path.Link(sSite4, Llength, Ldirs);
+    const typename Group::deviceGauge vnn2 = path.Link(sSite4, Rlength, Rdirs);
+
+    for (BYTE rfieldId = 0; rfieldId < uiRational; ++rfieldId)
+    {
+        const typename Group::deviceVector* phi_i = pFermionPointers[rfieldId];
+        const typename Group::deviceVector* phi_id = pFermionPointers[rfieldId + uiRational];
+        //=================================
+        // 3. Find phi_{1,2,3,4}(n1), phi_i(n2)
+        typename Group::deviceVector phi1 = Group::Mul(vnn1, phi_id[sn1.m_uiSiteIndex]);
+        typename Group::deviceVector phi2 = Group::Mul(vnn2, phi_i[sn2.m_uiSiteIndex]);
+        typename Group::deviceVector phi3 = Group::Mul(vnn1, phi_i[sn1.m_uiSiteIndex]);
+        typename Group::deviceVector phi4 = Group::Mul(vnn2, phi_id[sn2.m_uiSiteIndex]);
+        if (sn1.NeedToOpposite())
+        {
+            Group::MulReal(phi1, F(-1.0));
+            Group::MulReal(phi3, F(-1.0));
+        }
+        if (sn2.NeedToOpposite())
+        {
+            Group::MulReal(phi2, F(-1.0));
+            Group::MulReal(phi4, F(-1.0));
+        }
+        typename Group::deviceGauge res = Group::Contract(phi1, phi2);
+        Group::AddGauge(res, Group::Contract(phi4, phi3));
+        const Real eta_tau = (iTau > 0 ?
+            ((pEtaTable[sn1.m_uiSiteIndex] >> 3) & 1)
+            : ((pEtaTable[sn2.m_uiSiteIndex] >> 3) & 1))
+            ? F(-1.0) : F(1.0);
+        const Real fCoeff = OneOver12 * static_cast<Real>(fOmega) * fNv * pNumerators[rfieldId] * eta_tau;
+
+        //For mu
+        if (0 == byContribution || 2 == byContribution)
+        {
+            Group::SubForce(pForce[_deviceGetLinkIndex(uiSiteIndex, byMu)], res, fCoeff);
+        }
+
+        //For tau
+        if (1 == byContribution || 2 == byContribution)
+        {
+            Group::SubForce(pForce[_deviceGetLinkIndex(uiSiteIndex, 3)], res, iTau > 0 ? fCoeff : -fCoeff);
+        }
+    }
+}
+
+/**
+ * The force of the polarization term
+ */
+template<class Group, class Path>
+__global__ void _CLG_LAUNCH_BOUND
+_kernelDFermionKSForceRotationXYTauT(
+    typename Group::deviceGauge* pForce,
+    const typename Group::deviceVector* const* __restrict__ pFermionPointers,
+    const Real* __restrict__ pNumerators,
+    UINT uiRational,
+    BYTE byFieldId,
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE fOmega,
+#else
+    Real fOmega,
+#endif
+    INT pathLdir1, INT pathLdir2, INT pathLdir3, BYTE Llength,
+    INT pathRdir1, INT pathRdir2, INT pathRdir3, BYTE Rlength,
+    Path path)
+{
+    intokernalInt4;
+
+    //=================================
+    // 1. Find n1, n2
+    INT Ldirs[3] = { pathLdir1, pathLdir2, pathLdir3 };
+    INT Rdirs[3] = { pathRdir1, pathRdir2, pathRdir3 };
+    const SSmallInt4 siten1 = _deviceSmallInt4OffsetC(sSite4, Ldirs, Llength);
+    const SSmallInt4 siten2 = _deviceSmallInt4OffsetC(sSite4, Rdirs, Rlength);
+    const SIndex& sn1 = __idx->m_pDeviceIndexPositionToSIndex[byFieldId][__bi(siten1)];
+    const SIndex& sn2 = __idx->m_pDeviceIndexPositionToSIndex[byFieldId][__bi(siten2)];
+
+    const Real eta124 = _deviceEta124(__deviceSiteIndexToInt4(sn1.m_uiSiteIndex));
+    //=================================
+    // 2. Find V(n,n1), V(n,n2)
+    const typename Group::deviceGauge vnn1 = path.Link(sSite4, Llength, Ldirs);
+    const typename Group::deviceGauge vnn2 = path.Link(sSite4, Rlength, Rdirs);
+
+    for (BYTE rfieldId = 0; rfieldId < uiRational; ++rfieldId)
+    {
+        const typename Group::deviceVector* phi_i = pFermionPointers[rfieldId];
+        const typename Group::deviceVector* phi_id = pFermionPointers[rfieldId + uiRational];
+
+        //=================================
+        // 3. Find phi_{1,2,3,4}(n1), phi_i(n2)
+        typename Group::deviceVector phi1 = Group::Mul(vnn1, phi_id[sn1.m_uiSiteIndex]);
+        typename Group::deviceVector phi2 = Group::Mul(vnn2, phi_i[sn2.m_uiSiteIndex]);
+        typename Group::deviceVector phi3 = Group::Mul(vnn1, phi_i[sn1.m_uiSiteIndex]);
+        typename Group::deviceVector phi4 = Group::Mul(vnn2, phi_id[sn2.m_uiSiteIndex]);
+        if (sn1.NeedToOpposite())
+        {
+            Group::MulReal(phi1, F(-1.0));
+            Group::MulReal(phi3, F(-1.0));
+        }
+        if (sn2.NeedToOpposite())
+        {
+            Group::MulReal(phi2, F(-1.0));
+            Group::MulReal(phi4, F(-1.0));
+        }
+        //This was phi2 phi1+ * eta124(n1) - phi3 phi4+ * eta124(n2)
+        //However, eta124(n1) = -eta124(n2), so use Add directly.
+        typename Group::deviceGauge res = Group::Contract(phi1, phi2);
+        Group::AddGauge(res, Group::Contract(phi4, phi3));
+        const Real fCoeff = OneOver48 * static_cast<Real>(fOmega) * pNumerators[rfieldId] * eta124;
+
+        //Use eta124 of n1, Sub left and Add right
+        if (pathLdir1 > 0)
+        {
+            Group::SubForce(pForce[_deviceGetLinkIndex(uiSiteIndex, pathLdir1 - 1)], res, -fCoeff);
+        }
+
+        if (pathRdir1 > 0)
+        {
+            Group::SubForce(pForce[_deviceGetLinkIndex(uiSiteIndex, pathRdir1 - 1)], res, fCoeff);
+        }
+    }
+}
+
+#pragma endregion
+
+#pragma endregion
+
+__END_NAMESPACE
+
+#endif //#if defined(__cplusplus) && defined(__CUDACC__)
+
+#endif //#ifndef _TFERMIONKSKERNEL_H_
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
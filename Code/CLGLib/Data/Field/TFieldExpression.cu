@@ -0,0 +1,111 @@
+//=============================================================================
+// FILENAME : TFieldExpression.cu
+//
+// DESCRIPTION:
+// The kernel of linear combination, one kernel for each number of terms
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+#include "CLGLib_Private.h"
+
+__BEGIN_NAMESPACE
+
+#pragma region kernels
+
+/**
+* The pointers and coefficients are passed by value
+*/
+template<UINT N>
+struct SLinearCombineTerms
+{
+    const CLGComplex* m_pFields[N];
+    CLGComplex m_cCoeffs[N];
+};
+
+/**
+* pRes can be one of the fields, each thread reads all terms of its element before writing
+*/
+template<UINT N>
+__global__ void _CLG_LAUNCH_BOUND
+_kernelLinearCombine(CLGComplex* pRes, SLinearCombineTerms<N> terms, UINT uiElement, UINT uiGroup, UINT uiStride)
+{
+    intokernal;
+
+    for (UINT g = 0; g < uiGroup; ++g)
+    {
+        const UINT uiStart = (uiSiteIndex * uiGroup + g) * uiStride;
+        for (UINT i = 0; i < uiElement; ++i)
+        {
+            const UINT uiIdx = uiStart + i;
+            CLGComplex res = _cuCmulf(terms.m_cCoeffs[0], terms.m_pFields[0][uiIdx]);
+            #pragma unroll
+            for (UINT j = 1; j < N; ++j)
+            {
+                res = _cuCaddf(res, _cuCmulf(terms.m_cCoeffs[j], terms.m_pFields[j][uiIdx]));
+            }
+            pRes[uiIdx] = res;
+        }
+    }
+}
+
+#pragma endregion
+
+template<UINT N>
+static void _LinearCombineT(CLGComplex* pRes, UINT uiElement, const CLGComplex* const* pFields, const CLGComplex* pCoeffs, UINT uiGroup, UINT uiStride)
+{
+    SLinearCombineTerms<N> terms;
+    for (UINT i = 0; i < N; ++i)
+    {
+        terms.m_pFields[i] = pFields[i];
+        terms.m_cCoeffs[i] = pCoeffs[i];
+    }
+
+    preparethread;
+    _kernelLinearCombine<N> << <block, threads >> > (pRes, terms, uiElement, uiGroup, uiStride);
+}
+
+void _LinearCombineComplex(CLGComplex* pRes, UINT uiElement, UINT uiCount, const CLGComplex* const* pFields, const CLGComplex* pCoeffs, UINT uiGroup, UINT uiStride)
+{
+    if (0 == uiStride)
+    {
+        uiStride = uiElement;
+    }
+
+    switch (uiCount)
+    {
+    case 1:
+        _LinearCombineT<1>(pRes, uiElement, pFields, pCoeffs, uiGroup, uiStride);
+        break;
+    case 2:
+        _LinearCombineT<2>(pRes, uiElement, pFields, pCoeffs, uiGroup, uiStride);
+        break;
+    case 3:
+        _LinearCombineT<3>(pRes, uiElement, pFields, pCoeffs, uiGroup, uiStride);
+        break;
+    case 4:
+        _LinearCombineT<4>(pRes, uiElement, pFields, pCoeffs, uiGroup, uiStride);
+        break;
+    case 5:
+        _LinearCombineT<5>(pRes, uiElement, pFields, pCoeffs, uiGroup, uiStride);
+        break;
+    case 6:
+        _LinearCombineT<6>(pRes, uiElement, pFields, pCoeffs, uiGroup, uiStride);
+        break;
+    case 7:
+        _LinearCombineT<7>(pRes, uiElement, pFields, pCoeffs, uiGroup, uiStride);
+        break;
+    case 8:
+        _LinearCombineT<8>(pRes, uiElement, pFields, pCoeffs, uiGroup, uiStride);
+        break;
+    default:
+        appCrucial(_T("_LinearCombineComplex: %d terms is not supported (1 to %d)!\n"), uiCount, CField::_kLinearCombineMaxTerm);
+        break;
+    }
+}
+
+__END_NAMESPACE
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
@@ -0,0 +1,186 @@
+//=============================================================================
+// FILENAME : TFieldExpression.h
+//
+// DESCRIPTION:
+// The lazy expression for the BLAS of fields, for example
+//
+//     appFieldAssign(pX, a * appField(pX) + b * appField(pY) - c * appField(pZ));
+//
+// The right hand side is not evaluated when building the expression,
+// the terms are gathered (at compile time the number of terms is known)
+// and evaluated by CField::LinearCombine, which is one kernel of one pass
+// for the fermion fields and the SU3 and U1 gauge (momentum, force) fields,
+// instead of a chain of CopyTo, ScalarMultply and Axpy,
+// and no pooled field is needed for the temperary results.
+//
+// The left hand side can also appear on the right hand side.
+// The coefficients are CLGComplex or Real (or cuDoubleComplex when Real is float).
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#ifndef _TFIELDEXPRESSION_H_
+#define _TFIELDEXPRESSION_H_
+
+__BEGIN_NAMESPACE
+
+/**
+* pRes[n] = sum _i pCoeffs[i] pFields[i][n], with uiElement complex numbers on each site.
+* pFields[i] can be pRes. (Implemented in TFieldExpression.cu)
+* For the gauge fields, each site has uiGroup links, each link is uiStride complex numbers
+* and only the first uiElement are combined (deviceSU3 is 16 complex numbers, 9 are used).
+* uiStride = 0 means uiElement.
+*/
+extern CLGAPI void _LinearCombineComplex(CLGComplex* pRes, UINT uiElement, UINT uiCount, const CLGComplex* const* pFields, const CLGComplex* pCoeffs, UINT uiGroup = 1, UINT uiStride = 0);
+
+template<class Exp>
+class TFieldExpression
+{
+public:
+    const Exp& Get() const { return static_cast<const Exp&>(*this); }
+};
+
+/**
+* coeff x field
+*/
+class TFieldTerm : public TFieldExpression<TFieldTerm>
+{
+public:
+    enum { _kTermCount = 1 };
+
+    TFieldTerm(const CField* pField, const CLGComplex& cCoeff)
+        : m_pField(pField)
+        , m_cCoeff(cCoeff)
+    {
+
+    }
+
+    void Gather(const CField** pFields, CLGComplex* pCoeffs, const CLGComplex& cScale) const
+    {
+        pFields[0] = m_pField;
+        pCoeffs[0] = _cuCmulf(cScale, m_cCoeff);
+    }
+
+    const CField* m_pField;
+    CLGComplex m_cCoeff;
+};
+
+/**
+* coeff x (expression)
+*/
+template<class Exp>
+class TFieldScaled : public TFieldExpression<TFieldScaled<Exp> >
+{
+public:
+    enum { _kTermCount = Exp::_kTermCount };
+
+    TFieldScaled(const Exp& exp, const CLGComplex& cCoeff)
+        : m_kExp(exp)
+        , m_cCoeff(cCoeff)
+    {
+
+    }
+
+    void Gather(const CField** pFields, CLGComplex* pCoeffs, const CLGComplex& cScale) const
+    {
+        m_kExp.Gather(pFields, pCoeffs, _cuCmulf(cScale, m_cCoeff));
+    }
+
+    Exp m_kExp;
+    CLGComplex m_cCoeff;
+};
+
+/**
+* (expression) + (expression)
+*/
+template<class Left, class Right>
+class TFieldSum : public TFieldExpression<TFieldSum<Left, Right> >
+{
+public:
+    enum { _kTermCount = Left::_kTermCount + Right::_kTermCount };
+
+    TFieldSum(const Left& left, const Right& right)
+        : m_kLeft(left)
+        , m_kRight(right)
+    {
+
+    }
+
+    void Gather(const CField** pFields, CLGComplex* pCoeffs, const CLGComplex& cScale) const
+    {
+        m_kLeft.Gather(pFields, pCoeffs, cScale);
+        m_kRight.Gather(pFields + Left::_kTermCount, pCoeffs + Left::_kTermCount, cScale);
+    }
+
+    Left m_kLeft;
+    Right m_kRight;
+};
+
+#pragma region operators
+
+inline TFieldTerm appField(const CField* pField)
+{
+    return TFieldTerm(pField, _make_cuComplex(F(1.0), F(0.0)));
+}
+
+template<class Exp>
+inline TFieldScaled<Exp> operator*(const CLGComplex& cCoeff, const TFieldExpression<Exp>& exp)
+{
+    return TFieldScaled<Exp>(exp.Get(), cCoeff);
+}
+
+template<class Exp>
+inline TFieldScaled<Exp> operator*(Real fCoeff, const TFieldExpression<Exp>& exp)
+{
+    return TFieldScaled<Exp>(exp.Get(), _make_cuComplex(fCoeff, F(0.0)));
+}
+
+#if !_CLG_DOUBLEFLOAT
+template<class Exp>
+inline TFieldScaled<Exp> operator*(const cuDoubleComplex& cCoeff, const TFieldExpression<Exp>& exp)
+{
+    return TFieldScaled<Exp>(exp.Get(), _cToFloat(cCoeff));
+}
+#endif
+
+template<class Exp>
+inline TFieldScaled<Exp> operator-(const TFieldExpression<Exp>& exp)
+{
+    return TFieldScaled<Exp>(exp.Get(), _make_cuComplex(F(-1.0), F(0.0)));
+}
+
+template<class Left, class Right>
+inline TFieldSum<Left, Right> operator+(const TFieldExpression<Left>& left, const TFieldExpression<Right>& right)
+{
+    return TFieldSum<Left, Right>(left.Get(), right.Get());
+}
+
+template<class Left, class Right>
+inline TFieldSum<Left, TFieldScaled<Right> > operator-(const TFieldExpression<Left>& left, const TFieldExpression<Right>& right)
+{
+    return TFieldSum<Left, TFieldScaled<Right> >(left.Get(), TFieldScaled<Right>(right.Get(), _make_cuComplex(F(-1.0), F(0.0))));
+}
+
+#pragma endregion
+
+/**
+* pRes = exp
+*/
+template<class Exp>
+inline void appFieldAssign(CField* pRes, const TFieldExpression<Exp>& exp)
+{
+    static_assert(static_cast<INT>(Exp::_kTermCount) <= static_cast<INT>(CField::_kLinearCombineMaxTerm), "Too many terms in the field expression");
+    const CField* pFields[Exp::_kTermCount];
+    CLGComplex pCoeffs[Exp::_kTermCount];
+    exp.Get().Gather(pFields, pCoeffs, _make_cuComplex(F(1.0), F(0.0)));
+    pRes->LinearCombine(static_cast<UINT>(Exp::_kTermCount), pFields, pCoeffs);
+}
+
+__END_NAMESPACE
+
+#endif //#ifndef _TFIELDEXPRESSION_H_
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
@@ -56,7 +56,7 @@ class CLGAPI CIndex : public CBase
 {
 public:
 
-    CIndex() : m_pBoundaryCondition(NULL), m_bNeedToFixBoundary(FALSE) {  }
+    CIndex() : m_pBoundaryCondition(NULL), m_bNeedToFixBoundary(FALSE), m_bDirectStencil(FALSE) {  }
     ~CIndex()
     {
         appSafeDelete(m_pBoundaryCondition);
@@ -102,8 +102,35 @@ public:
 
     UBOOL NeedToFixBoundary() const { return m_bNeedToFixBoundary; }
 
+    /**
+    * Only used when the boundary condition is periodic
+    */
+    void SetDirectStencil(UBOOL bDirectStencil)
+    {
+#if _CLG_DIRECT_STENCIL
+        m_bDirectStencil = bDirectStencil && NULL != m_pBoundaryCondition && m_pBoundaryCondition->IsPeriodic();
+#else
+        m_bDirectStencil = FALSE;
+#endif
+    }
+
+    /**
+    * TRUE if the kernels can compute the neighbours with coordinates instead of the baked tables.
+    * The links of the gauge field must be periodic (no twist), the twist of fermion is applied in the kernel.
+    */
+    UBOOL UseDirectStencil(BYTE byGaugeFieldId) const
+    {
+        if (!m_bDirectStencil)
+        {
+            return FALSE;
+        }
+        const SSmallInt4& bc = m_pBoundaryCondition->GetFieldBC(byGaugeFieldId);
+        return bc.x > 0 && bc.y > 0 && bc.z > 0 && bc.w > 0;
+    }
+
     class CBoundaryCondition * m_pBoundaryCondition;
     UBOOL m_bNeedToFixBoundary;
+    UBOOL m_bDirectStencil;
 };
 
 
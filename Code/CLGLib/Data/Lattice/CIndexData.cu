@@ -320,6 +320,193 @@ void CIndexData::DebugEdgeGlue(BYTE byFieldId, const SSmallInt4& xyzt)
     appSafeFree(tb);
 }
 
+#pragma region Cache
+
+enum { _kIndexCacheMagic = 0x58444943, _kIndexCacheVersion = 2, _kIndexCacheHeader = 16, };
+
+static void _appendIndexCache(TArray<BYTE>& buffer, const void* pDeviceData, UINT uiSize)
+{
+    const INT iStart = buffer.AddSize(static_cast<INT>(uiSize));
+    checkCudaErrors(cudaMemcpy(buffer.GetData() + iStart, pDeviceData, uiSize, cudaMemcpyDeviceToHost));
+}
+
+static UBOOL _readIndexCache(const BYTE* byData, UINT uiSize, UINT& uiOffset, void* pDeviceData, UINT uiCount)
+{
+    if (uiOffset + uiCount > uiSize)
+    {
+        return FALSE;
+    }
+    checkCudaErrors(cudaMemcpy(pDeviceData, byData + uiOffset, uiCount, cudaMemcpyHostToDevice));
+    uiOffset += uiCount;
+    return TRUE;
+}
+
+static inline UINT _indexCacheBigVolume()
+{
+    return (_HC_Lx + 2 * CIndexData::kCacheIndexEdge) * (_HC_Ly + 2 * CIndexData::kCacheIndexEdge)
+         * (_HC_Lz + 2 * CIndexData::kCacheIndexEdge) * (_HC_Lt + 2 * CIndexData::kCacheIndexEdge);
+}
+
+/**
+* magic, version, sizeof(SIndex), sizeof(SSmallInt4), big volume, volume, dir
+* mask of position, link, gauge move, fermion move, plaqutte, eta
+* plaqutte length, count per site, count per link
+* small data, region table, mapping table, bond info
+* tables in the order of the masks
+*/
+UBOOL CIndexData::SaveCache(const CCString& sFileName) const
+{
+    const UINT uiBigVolume = _indexCacheBigVolume();
+    UINT uiMasks[6] = { 0, 0, 0, 0, 0, 0 };
+    for (UINT i = 0; i < kMaxFieldCount; ++i)
+    {
+        uiMasks[0] |= (NULL != m_pIndexPositionToSIndex[i]) ? (1U << i) : 0;
+        uiMasks[1] |= (NULL != m_pIndexLinkToSIndex[i]) ? (1U << i) : 0;
+        uiMasks[2] |= (NULL != m_pGaugeMoveCache[i]) ? (1U << i) : 0;
+        uiMasks[3] |= (NULL != m_pFermionMoveCache[i]) ? (1U << i) : 0;
+    }
+    uiMasks[4] = (NULL != m_pPlaqutteCache && NULL != m_pStappleCache) ? 1 : 0;
+    uiMasks[5] = (NULL != m_pEtaMu) ? 1 : 0;
+
+    const UINT header[_kIndexCacheHeader] = {
+        _kIndexCacheMagic, _kIndexCacheVersion, static_cast<UINT>(sizeof(SIndex)), static_cast<UINT>(sizeof(SSmallInt4)),
+        uiBigVolume, _HC_Volume, _HC_Dir,
+        uiMasks[0], uiMasks[1], uiMasks[2], uiMasks[3], uiMasks[4], uiMasks[5],
+        m_uiPlaqutteLength, m_uiPlaqutteCountPerSite, m_uiPlaqutteCountPerLink };
+
+    TArray<BYTE> buffer;
+    const INT iHeader = buffer.AddSize(static_cast<INT>(sizeof(UINT) * _kIndexCacheHeader));
+    memcpy(buffer.GetData() + iHeader, header, sizeof(UINT) * _kIndexCacheHeader);
+
+    _appendIndexCache(buffer, m_pSmallData, sizeof(UINT) * kCacheIndexSmallDataCount);
+    _appendIndexCache(buffer, m_byRegionTable, sizeof(UINT) * 256);
+    _appendIndexCache(buffer, m_pMappingTable, sizeof(SSmallInt4) * uiBigVolume);
+    _appendIndexCache(buffer, m_pBondInfoTable, sizeof(BYTE) * uiBigVolume * _HC_Dir);
+    for (UINT i = 0; i < kMaxFieldCount; ++i)
+    {
+        if (NULL != m_pIndexPositionToSIndex[i])
+        {
+            _appendIndexCache(buffer, m_pIndexPositionToSIndex[i], sizeof(SIndex) * uiBigVolume);
+        }
+        if (NULL != m_pIndexLinkToSIndex[i])
+        {
+            _appendIndexCache(buffer, m_pIndexLinkToSIndex[i], sizeof(SIndex) * uiBigVolume * _HC_Dir);
+        }
+        if (NULL != m_pGaugeMoveCache[i])
+        {
+            _appendIndexCache(buffer, m_pGaugeMoveCache[i], sizeof(SIndex) * _HC_Volume * _HC_Dir);
+        }
+        if (NULL != m_pFermionMoveCache[i])
+        {
+            _appendIndexCache(buffer, m_pFermionMoveCache[i], sizeof(SIndex) * _HC_Volume * _HC_Dir * 2);
+        }
+    }
+    if (0 != uiMasks[4])
+    {
+        _appendIndexCache(buffer, m_pPlaqutteCache, sizeof(SIndex) * _HC_Volume * m_uiPlaqutteCountPerSite * m_uiPlaqutteLength);
+        _appendIndexCache(buffer, m_pStappleCache, sizeof(SIndex) * _HC_Volume * _HC_Dim * m_uiPlaqutteCountPerLink * (m_uiPlaqutteLength - 1));
+    }
+    if (0 != uiMasks[5])
+    {
+        _appendIndexCache(buffer, m_pEtaMu, sizeof(BYTE) * _HC_Volume);
+    }
+
+    return CFileSystem::WriteAllBytesAtomic(sFileName.c_str(), buffer.GetData(), static_cast<UINT>(buffer.Num()));
+}
+
+UBOOL CIndexData::LoadCache(const CCString& sFileName)
+{
+    if (!CFileSystem::IsFileExist(sFileName))
+    {
+        return FALSE;
+    }
+
+    UINT uiSize = 0;
+    BYTE* byData = appGetFileSystem()->ReadAllBytes(sFileName.c_str(), uiSize);
+    if (NULL == byData)
+    {
+        return FALSE;
+    }
+
+    const UINT uiBigVolume = _indexCacheBigVolume();
+    UINT header[_kIndexCacheHeader];
+    if (uiSize < sizeof(UINT) * _kIndexCacheHeader)
+    {
+        free(byData);
+        return FALSE;
+    }
+    memcpy(header, byData, sizeof(UINT) * _kIndexCacheHeader);
+    if (_kIndexCacheMagic != header[0] || _kIndexCacheVersion != header[1] || sizeof(SIndex) != header[2] || sizeof(SSmallInt4) != header[3]
+     || uiBigVolume != header[4] || _HC_Volume != header[5] || _HC_Dir != header[6])
+    {
+        appGeneral(_T("Index cache %s does not match the lattice, ignored\n"), sFileName.c_str());
+        free(byData);
+        return FALSE;
+    }
+    const UINT* uiMasks = header + 7;
+    m_uiPlaqutteLength = static_cast<BYTE>(header[13]);
+    m_uiPlaqutteCountPerSite = static_cast<BYTE>(header[14]);
+    m_uiPlaqutteCountPerLink = static_cast<BYTE>(header[15]);
+
+    UINT uiOffset = sizeof(UINT) * _kIndexCacheHeader;
+    UBOOL bOk = _readIndexCache(byData, uiSize, uiOffset, m_pSmallData, sizeof(UINT) * kCacheIndexSmallDataCount)
+             && _readIndexCache(byData, uiSize, uiOffset, m_byRegionTable, sizeof(UINT) * 256)
+             && _readIndexCache(byData, uiSize, uiOffset, m_pMappingTable, sizeof(SSmallInt4) * uiBigVolume)
+             && _readIndexCache(byData, uiSize, uiOffset, m_pBondInfoTable, sizeof(BYTE) * uiBigVolume * _HC_Dir);
+
+    for (UINT i = 0; i < kMaxFieldCount && bOk; ++i)
+    {
+        if (0 != (uiMasks[0] & (1U << i)))
+        {
+            checkCudaErrors(cudaMalloc((void**)&m_pIndexPositionToSIndex[i], sizeof(SIndex) * uiBigVolume));
+            bOk = bOk && _readIndexCache(byData, uiSize, uiOffset, m_pIndexPositionToSIndex[i], sizeof(SIndex) * uiBigVolume);
+        }
+        if (0 != (uiMasks[1] & (1U << i)))
+        {
+            checkCudaErrors(cudaMalloc((void**)&m_pIndexLinkToSIndex[i], sizeof(SIndex) * uiBigVolume * _HC_Dir));
+            bOk = bOk && _readIndexCache(byData, uiSize, uiOffset, m_pIndexLinkToSIndex[i], sizeof(SIndex) * uiBigVolume * _HC_Dir);
+        }
+        if (0 != (uiMasks[2] & (1U << i)))
+        {
+            checkCudaErrors(cudaMalloc((void**)&m_pGaugeMoveCache[i], sizeof(SIndex) * _HC_Volume * _HC_Dir));
+            bOk = bOk && _readIndexCache(byData, uiSize, uiOffset, m_pGaugeMoveCache[i], sizeof(SIndex) * _HC_Volume * _HC_Dir);
+        }
+        if (0 != (uiMasks[3] & (1U << i)))
+        {
+            checkCudaErrors(cudaMalloc((void**)&m_pFermionMoveCache[i], sizeof(SIndex) * _HC_Volume * _HC_Dir * 2));
+            bOk = bOk && _readIndexCache(byData, uiSize, uiOffset, m_pFermionMoveCache[i], sizeof(SIndex) * _HC_Volume * _HC_Dir * 2);
+        }
+    }
+    if (bOk && 0 != uiMasks[4])
+    {
+        const UINT uiPlaqSize = sizeof(SIndex) * _HC_Volume * m_uiPlaqutteCountPerSite * m_uiPlaqutteLength;
+        const UINT uiStapleSize = sizeof(SIndex) * _HC_Volume * _HC_Dim * m_uiPlaqutteCountPerLink * (m_uiPlaqutteLength - 1);
+        checkCudaErrors(cudaMalloc((void**)&m_pPlaqutteCache, uiPlaqSize));
+        checkCudaErrors(cudaMalloc((void**)&m_pStappleCache, uiStapleSize));
+        bOk = _readIndexCache(byData, uiSize, uiOffset, m_pPlaqutteCache, uiPlaqSize)
+           && _readIndexCache(byData, uiSize, uiOffset, m_pStappleCache, uiStapleSize);
+    }
+    if (bOk && 0 != uiMasks[5])
+    {
+        checkCudaErrors(cudaMalloc((void**)&m_pEtaMu, sizeof(BYTE) * _HC_Volume));
+        bOk = _readIndexCache(byData, uiSize, uiOffset, m_pEtaMu, sizeof(BYTE) * _HC_Volume);
+    }
+    free(byData);
+
+    if (!bOk)
+    {
+        //the tables are partly allocated, the caller should create a new CIndexData and bake
+        appCrucial(_T("Index cache %s is broken\n"), sFileName.c_str());
+        return FALSE;
+    }
+
+    checkCudaErrors(cudaMemcpy(m_pDeviceIndexPositionToSIndex, m_pIndexPositionToSIndex, sizeof(SIndex*) * kMaxFieldCount, cudaMemcpyHostToDevice));
+    checkCudaErrors(cudaMemcpy(m_pDeviceIndexLinkToSIndex, m_pIndexLinkToSIndex, sizeof(SIndex*) * kMaxFieldCount, cudaMemcpyHostToDevice));
+    return TRUE;
+}
+
+#pragma endregion
+
 void CIndex::CalculateSiteCount(class CIndexData* pData) const
 {
     INT hostres[2] = { 0, 0 };
@@ -45,6 +45,7 @@ public:
         , m_uiSiteXYZT(1)
         , m_uiSiteXYZ(1)
         , m_uiLinkNumber(1)
+        , m_bLoadedFromCache(FALSE)
     {
         checkCudaErrors(cudaMalloc((void**)&m_pSmallData, sizeof(UINT) * kCacheIndexSmallDataCount));
         checkCudaErrors(cudaMalloc((void**)&m_pMappingTable, sizeof(SSmallInt4)
@@ -120,10 +121,10 @@ public:
     __device__ __inline__ SSmallInt4 _deviceBigIndexToInt4(UINT uiBigIdx) const
     {
         SSmallInt4 coord;
-        coord.x = static_cast<SBYTE>(uiBigIdx / m_pSmallData[kMultX]) - CIndexData::kCacheIndexEdge;
-        coord.y = static_cast<SBYTE>((uiBigIdx % m_pSmallData[kMultX]) / m_pSmallData[kMultY]) - CIndexData::kCacheIndexEdge;
-        coord.z = static_cast<SBYTE>((uiBigIdx % m_pSmallData[kMultY]) / m_pSmallData[kMultZ]) - CIndexData::kCacheIndexEdge;
-        coord.w = static_cast<SBYTE>(uiBigIdx % m_pSmallData[kMultZ]) - CIndexData::kCacheIndexEdge;
+        coord.x = static_cast<SCOORD>(uiBigIdx / m_pSmallData[kMultX]) - CIndexData::kCacheIndexEdge;
+        coord.y = static_cast<SCOORD>((uiBigIdx % m_pSmallData[kMultX]) / m_pSmallData[kMultY]) - CIndexData::kCacheIndexEdge;
+        coord.z = static_cast<SCOORD>((uiBigIdx % m_pSmallData[kMultY]) / m_pSmallData[kMultZ]) - CIndexData::kCacheIndexEdge;
+        coord.w = static_cast<SCOORD>(uiBigIdx % m_pSmallData[kMultZ]) - CIndexData::kCacheIndexEdge;
         return coord;
     }
 
@@ -181,6 +182,18 @@ public:
         return NULL == m_byRegionTable ? 0 : m_byRegionTable[site.m_byReginId];
     }
 
+    /**
+    * Write all baked tables to a file, so they can be loaded instead of baking next time
+    * The file is only valid for the same lattice, boundary condition and fields,
+    * see CCLGLibManager::InitialIndexBuffer for the key
+    */
+    UBOOL SaveCache(const CCString& sFileName) const;
+
+    /**
+    * Call this on a new created CIndexData, instead of baking
+    */
+    UBOOL LoadCache(const CCString& sFileName);
+
     static void DebugPlaqutteTable(const SSmallInt4& sSite);
 
     static void DebugPlaqutteTable();
@@ -232,6 +245,10 @@ public:
     UINT m_uiSiteXYZ;
     UINT m_uiLinkNumber;
 
+    //the file of IndexCacheDirectory (empty if not used), and whether the tables are loaded from it
+    CCString m_sCacheFile;
+    UBOOL m_bLoadedFromCache;
+
 };
 
 #pragma region device functions
@@ -247,10 +264,10 @@ static __device__ __inline__ UINT _deviceGetBigIndex(const SSmallInt4& sSite, co
 static __device__ __inline__ SSmallInt4 _deviceBigIndexToInt4(UINT uiBigIdx, const UINT* __restrict__ pSmallData)
 {
     SSmallInt4 coord;
-    coord.x = static_cast<SBYTE>(uiBigIdx / pSmallData[CIndexData::kMultX]) - CIndexData::kCacheIndexEdge;
-    coord.y = static_cast<SBYTE>((uiBigIdx % pSmallData[CIndexData::kMultX]) / pSmallData[CIndexData::kMultY]) - CIndexData::kCacheIndexEdge;
-    coord.z = static_cast<SBYTE>((uiBigIdx % pSmallData[CIndexData::kMultY]) / pSmallData[CIndexData::kMultZ]) - CIndexData::kCacheIndexEdge;
-    coord.w = static_cast<SBYTE>(uiBigIdx % pSmallData[CIndexData::kMultZ]) - CIndexData::kCacheIndexEdge;
+    coord.x = static_cast<SCOORD>(uiBigIdx / pSmallData[CIndexData::kMultX]) - CIndexData::kCacheIndexEdge;
+    coord.y = static_cast<SCOORD>((uiBigIdx % pSmallData[CIndexData::kMultX]) / pSmallData[CIndexData::kMultY]) - CIndexData::kCacheIndexEdge;
+    coord.z = static_cast<SCOORD>((uiBigIdx % pSmallData[CIndexData::kMultY]) / pSmallData[CIndexData::kMultZ]) - CIndexData::kCacheIndexEdge;
+    coord.w = static_cast<SCOORD>(uiBigIdx % pSmallData[CIndexData::kMultZ]) - CIndexData::kCacheIndexEdge;
     return coord;
 }
 
@@ -315,6 +332,32 @@ static __device__ __inline__ SSmallInt4 _deviceSmallInt4OffsetC(
     return ret;
 }
 
+/**
+ * Walk on torus without the baked tables (only when CIndex::UseDirectStencil)
+ * dir = 1,2,3,4 for +x,+y,+z,+t
+ * dir = -1,-2,-3,-4 for -x,-y,-z,-t
+ * return TRUE if the boundary is crossed with an anti-periodic sBC, i.e. NeedToOpposite
+ */
+static __device__ __inline__ UBOOL _deviceTorusMove(
+    SSmallInt4& sSite, INT dir, const SSmallInt4& sBC)
+{
+    const INT idx = dir < 0 ? (-dir - 1) : (dir - 1);
+    const INT iLength = static_cast<INT>(_constIntegers[ECI_Lx + idx]);
+    const INT iNew = static_cast<INT>(sSite.m_byData4[idx]) + (dir > 0 ? 1 : (-1));
+    if (iNew < 0)
+    {
+        sSite.m_byData4[idx] = static_cast<SCOORD>(iLength - 1);
+        return sBC.m_byData4[idx] < 0;
+    }
+    if (iNew >= iLength)
+    {
+        sSite.m_byData4[idx] = 0;
+        return sBC.m_byData4[idx] < 0;
+    }
+    sSite.m_byData4[idx] = static_cast<SCOORD>(iNew);
+    return FALSE;
+}
+
 #pragma endregion
 
 #pragma region Host Functions
@@ -329,10 +372,10 @@ inline static SSmallInt4 _hostBigIndexToInt4(UINT uiBigIdx)
     const UINT uiMZ = _HC_Lt + 2 * CIndexData::kCacheIndexEdge;
 
     SSmallInt4 coord;
-    coord.x = static_cast<SBYTE>(uiBigIdx / uiMX) - CIndexData::kCacheIndexEdge;
-    coord.y = static_cast<SBYTE>((uiBigIdx % uiMX) / uiMY) - CIndexData::kCacheIndexEdge;
-    coord.z = static_cast<SBYTE>((uiBigIdx % uiMY) / uiMZ) - CIndexData::kCacheIndexEdge;
-    coord.w = static_cast<SBYTE>(uiBigIdx % uiMZ) - CIndexData::kCacheIndexEdge;
+    coord.x = static_cast<SCOORD>(uiBigIdx / uiMX) - CIndexData::kCacheIndexEdge;
+    coord.y = static_cast<SCOORD>((uiBigIdx % uiMX) / uiMY) - CIndexData::kCacheIndexEdge;
+    coord.z = static_cast<SCOORD>((uiBigIdx % uiMY) / uiMZ) - CIndexData::kCacheIndexEdge;
+    coord.w = static_cast<SCOORD>(uiBigIdx % uiMZ) - CIndexData::kCacheIndexEdge;
     return coord;
 }
 
@@ -43,10 +43,10 @@ _kernalBakeMappingTable(SSmallInt4* pDeviceData, uint3 mods)
 {
     UINT idxAll = threadIdx.x + blockDim.x * blockIdx.x;
     SSmallInt4 coord;
-    coord.x = static_cast<SBYTE>(idxAll / mods.x) - CIndexData::kCacheIndexEdge;
-    coord.y = static_cast<SBYTE>((idxAll % mods.x) / mods.y) - CIndexData::kCacheIndexEdge;
-    coord.z = static_cast<SBYTE>((idxAll % mods.y) / mods.z) - CIndexData::kCacheIndexEdge;
-    coord.w = static_cast<SBYTE>(idxAll % mods.z) - CIndexData::kCacheIndexEdge;
+    coord.x = static_cast<SCOORD>(idxAll / mods.x) - CIndexData::kCacheIndexEdge;
+    coord.y = static_cast<SCOORD>((idxAll % mods.x) / mods.y) - CIndexData::kCacheIndexEdge;
+    coord.z = static_cast<SCOORD>((idxAll % mods.y) / mods.z) - CIndexData::kCacheIndexEdge;
+    coord.w = static_cast<SCOORD>(idxAll % mods.z) - CIndexData::kCacheIndexEdge;
 
     pDeviceData[idxAll] = coord;
 }
@@ -54,6 +54,20 @@ public:
     virtual Real CheckRes(const CFieldGauge* pGauge) = 0;
 #endif
 
+    /**
+     * Coulomb gauge only maximize the functional of spatial links
+     */
+    virtual UBOOL IsCoulomb() const { return FALSE; }
+
+    /**
+     * Only fix the time slice uiT, it changes the spatial links on uiT and the temporal links into and out of uiT.
+     * Used by the best copy selection of Coulomb gauge, which is done slice by slice.
+     */
+    virtual void GaugeFixingTimeSlice(CFieldGauge* pResGauge, SCOORD uiT)
+    {
+        appCrucial(_T("GaugeFixingTimeSlice is only implemented for Coulomb gauge!\n"));
+    }
+
     class CLatticeData* m_pOwner;
     Real m_fAccuracy;
     UINT m_iIterate;
@@ -62,6 +76,25 @@ public:
     UINT m_iShowErrorStep;
 };
 
+/**
+ * The Los Alamos step, W = sum _mu U_mu(n) + U^+_mu(n-mu)
+ * g = proj(omega W + (1-omega)) is overrelaxed with omega > 1,
+ * and with probability fStochastic, g = g^2 (stochastic overrelaxation, use with omega = 1)
+ */
+__device__ __inline__ static void _deviceGaugeFixingRelaxation(deviceSU3& g, Real fOmega, Real fStochastic, UINT uiSiteIndex)
+{
+    g.MulReal(fOmega);
+    g.Add(deviceSU3::makeSU3Id().MulRealC(F(1.0) - fOmega));
+    g.CabbiboMarinariProj();
+    //one draw for each site, NextLaunch is called for each sweep (the odd and even sites are different)
+    SRandomDraw uiDraw;
+    if (fStochastic > F(0.0) && _deviceRandomF(_deviceGetFatIndex(uiSiteIndex, 0), uiDraw) < fStochastic)
+    {
+        const deviceSU3 gcopy(g);
+        g.Mul(gcopy);
+    }
+}
+
 __END_NAMESPACE
 
 #endif //#ifndef _CGAUGEFIXING_H_
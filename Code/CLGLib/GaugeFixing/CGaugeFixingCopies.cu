@@ -0,0 +1,340 @@
+//=============================================================================
+// FILENAME : CGaugeFixingCopies.cu
+//
+// DESCRIPTION:
+//
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+#include "CLGLib_Private.h"
+
+__BEGIN_NAMESPACE
+
+#pragma region kernels
+
+/**
+ * res(n) = sum _mu Retr[U_mu(n)], mu < byDir
+ */
+__global__ void _CLG_LAUNCH_BOUND
+_kernelGaugeFixingFunctional(
+    const deviceSU3* __restrict__ pU,
+    BYTE byDir,
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE* pDeviceRes
+#else
+    Real* pDeviceRes
+#endif
+    )
+{
+    intokernalInt4;
+
+    const UINT uiBigIdx = __idx->_deviceGetBigIndex(sSite4);
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE fRes = 0.0;
+#else
+    Real fRes = F(0.0);
+#endif
+
+    for (BYTE dir = 0; dir < byDir; ++dir)
+    {
+        if (!__idx->_deviceIsBondOnSurface(uiBigIdx, dir))
+        {
+            fRes += pU[_deviceGetLinkIndex(uiSiteIndex, dir)].ReTr();
+        }
+    }
+    pDeviceRes[uiSiteIndex] = fRes;
+}
+
+/**
+ * res(n) = sum _i Retr[U_i(n)], i = x,y,z on the time slice uiT
+ */
+__global__ void _CLG_LAUNCH_BOUND
+_kernelGaugeFixingFunctionalTimeSlice(
+    const deviceSU3* __restrict__ pU,
+    SCOORD uiT,
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE* pDeviceRes
+#else
+    Real* pDeviceRes
+#endif
+    )
+{
+    intokernalInt4_S;
+
+    const UINT uiBigIdx = __idx->_deviceGetBigIndex(sSite4);
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE fRes = 0.0;
+#else
+    Real fRes = F(0.0);
+#endif
+
+    for (BYTE dir = 0; dir < _DC_Dir - 1; ++dir)
+    {
+        if (!__idx->_deviceIsBondOnSurface(uiBigIdx, dir))
+        {
+            fRes += pU[_deviceGetLinkIndex(uiSiteIndex, dir)].ReTr();
+        }
+    }
+    pDeviceRes[uiSiteIndex3D] = fRes;
+}
+
+#pragma endregion
+
+__CLGIMPLEMENT_CLASS(CGaugeFixingCopies)
+
+void CGaugeFixingCopies::Initial(class CLatticeData* pOwner, const CParameters& params)
+{
+    m_pOwner = pOwner;
+
+    INT iValue = static_cast<INT>(m_uiCopies);
+    if (!params.FetchValueINT(_T("GaugeCopies"), iValue))
+    {
+        appGeneral(_T("CGaugeFixingCopies: GaugeCopies not set, set to 1 by defualt."));
+    }
+    m_uiCopies = iValue > 0 ? static_cast<UINT>(iValue) : 1;
+
+    if (!params.Exist(_T("Fixing")))
+    {
+        appCrucial(_T("CGaugeFixingCopies: Fixing not set!\n"));
+        return;
+    }
+
+    CParameters fixing = const_cast<CParameters&>(params).GetParameter(_T("Fixing"));
+    CCString sFixingName = _T("CGaugeFixingLandauLosAlamos");
+    fixing.FetchStringValue(_T("Name"), sFixingName);
+    m_pFixing = dynamic_cast<CGaugeFixing*>(appCreate(sFixingName));
+    if (NULL == m_pFixing)
+    {
+        appCrucial(_T("CGaugeFixingCopies: %s is not a gauge fixing!\n"), sFixingName.c_str());
+        return;
+    }
+    m_pFixing->Initial(pOwner, fixing);
+    m_fAccuracy = m_pFixing->m_fAccuracy;
+    m_iMaxIterate = m_pFixing->m_iMaxIterate;
+
+    m_pRandom = new CGaugeFixingRandom();
+    m_pRandom->Initial(pOwner, params);
+}
+
+#if !_CLG_DOUBLEFLOAT
+DOUBLE CGaugeFixingCopies::CheckRes(const CFieldGauge* pGauge)
+#else
+Real CGaugeFixingCopies::CheckRes(const CFieldGauge* pGauge)
+#endif
+{
+    if (NULL == m_pFixing)
+    {
+#if !_CLG_DOUBLEFLOAT
+        return 0.0;
+#else
+        return F(0.0);
+#endif
+    }
+    return m_pFixing->CheckRes(pGauge);
+}
+
+#if !_CLG_DOUBLEFLOAT
+DOUBLE CGaugeFixingCopies::Functional(const CFieldGauge* pGauge) const
+#else
+Real CGaugeFixingCopies::Functional(const CFieldGauge* pGauge) const
+#endif
+{
+    if (NULL == pGauge || EFT_GaugeSU3 != pGauge->GetFieldType())
+    {
+        appCrucial(_T("CGaugeFixingCopies only implemented with gauge SU3!\n"));
+#if !_CLG_DOUBLEFLOAT
+        return 0.0;
+#else
+        return F(0.0);
+#endif
+    }
+    const CFieldGaugeSU3* pGaugeSU3 = dynamic_cast<const CFieldGaugeSU3*>(pGauge);
+    const BYTE byDir = static_cast<BYTE>(IsCoulomb() ? (_HC_Dir - 1) : _HC_Dir);
+
+    preparethread;
+    _kernelGaugeFixingFunctional << <block, threads >> > (pGaugeSU3->m_pDeviceData, byDir, _D_RealThreadBuffer);
+    return appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer) / (3 * byDir * _HC_Volume);
+}
+
+#if !_CLG_DOUBLEFLOAT
+DOUBLE CGaugeFixingCopies::FunctionalTimeSlice(const CFieldGauge* pGauge, SCOORD uiT) const
+#else
+Real CGaugeFixingCopies::FunctionalTimeSlice(const CFieldGauge* pGauge, SCOORD uiT) const
+#endif
+{
+    if (NULL == pGauge || EFT_GaugeSU3 != pGauge->GetFieldType())
+    {
+        appCrucial(_T("CGaugeFixingCopies only implemented with gauge SU3!\n"));
+#if !_CLG_DOUBLEFLOAT
+        return 0.0;
+#else
+        return F(0.0);
+#endif
+    }
+    const CFieldGaugeSU3* pGaugeSU3 = dynamic_cast<const CFieldGaugeSU3*>(pGauge);
+
+    preparethread_S;
+    _kernelGaugeFixingFunctionalTimeSlice << <block, threads >> > (pGaugeSU3->m_pDeviceData, uiT, _D_RealThreadBuffer);
+    return appGetCudaHelper()->ReduceReal(_D_RealThreadBuffer, _HC_Volume_xyz) / (3 * (_HC_Dir - 1) * _HC_Volume_xyz);
+}
+
+void CGaugeFixingCopies::GaugeFixing(CFieldGauge* pResGauge)
+{
+    if (NULL == m_pFixing || NULL == pResGauge)
+    {
+        return;
+    }
+
+    m_lstFunctional.RemoveAll();
+    m_lstBestCopyOfSlice.RemoveAll();
+    m_lstFunctionalOfSlice.RemoveAll();
+    m_uiBestCopy = 0;
+    m_iIterate = 0;
+    if (m_uiCopies < 2)
+    {
+        m_pFixing->GaugeFixing(pResGauge);
+        pResGauge->IncreaseVersion();
+        m_iIterate = m_pFixing->m_iIterate;
+        m_lstFunctional.AddItem(Functional(pResGauge));
+        return;
+    }
+
+    if (NULL == m_pOriginal)
+    {
+        m_pOriginal = dynamic_cast<CFieldGauge*>(pResGauge->GetCopy());
+        m_pBest = dynamic_cast<CFieldGauge*>(pResGauge->GetCopy());
+    }
+    else
+    {
+        pResGauge->CopyTo(m_pOriginal);
+    }
+
+    if (IsCoulomb())
+    {
+        GaugeFixingCoulomb(pResGauge);
+        return;
+    }
+
+    //a converged copy is always better than the one not converged
+    UBOOL bBestConverged = FALSE;
+    for (UINT i = 0; i < m_uiCopies; ++i)
+    {
+        if (i > 0)
+        {
+            m_pOriginal->CopyTo(pResGauge);
+            m_pRandom->GaugeFixing(pResGauge);
+        }
+        m_pFixing->GaugeFixing(pResGauge);
+        m_iIterate += m_pFixing->m_iIterate;
+
+        const UBOOL bConverged = (m_pFixing->CheckRes(pResGauge) < m_fAccuracy);
+#if !_CLG_DOUBLEFLOAT
+        const DOUBLE fFunctional = Functional(pResGauge);
+#else
+        const Real fFunctional = Functional(pResGauge);
+#endif
+        m_lstFunctional.AddItem(fFunctional);
+        appParanoiac(_T("CGaugeFixingCopies: copy %d, converged %d, functional = %2.12f\n"), i, bConverged, fFunctional);
+
+        if (0 == i
+         || (bConverged && !bBestConverged)
+         || (bConverged == bBestConverged && fFunctional > m_lstFunctional[m_uiBestCopy]))
+        {
+            m_uiBestCopy = i;
+            bBestConverged = bConverged;
+            pResGauge->CopyTo(m_pBest);
+        }
+    }
+
+    m_pBest->CopyTo(pResGauge);
+    pResGauge->IncreaseVersion();
+    appDetailed(_T("CGaugeFixingCopies: best copy %d with functional = %2.12f\n"), m_uiBestCopy, m_lstFunctional[m_uiBestCopy]);
+}
+
+/**
+ * Fixing the time slice t only changes the spatial links on t and the temporal links into and out of t,
+ * so the spatial functional of the slices before t is not changed, and the best copy of each slice can be kept.
+ * m_pOriginal is the field with the slices before t already fixed, every copy of t starts from it,
+ * (copy 0 as well, pResGauge is the last copy of t - 1 which is not always the best one).
+ */
+void CGaugeFixingCopies::GaugeFixingCoulomb(CFieldGauge* pResGauge)
+{
+    for (UINT i = 0; i < m_uiCopies; ++i)
+    {
+#if !_CLG_DOUBLEFLOAT
+        m_lstFunctional.AddItem(0.0);
+#else
+        m_lstFunctional.AddItem(F(0.0));
+#endif
+    }
+
+    for (SCOORD uiT = 0; uiT < static_cast<SCOORD>(_HC_Lt); ++uiT)
+    {
+        UINT uiBestCopy = 0;
+        UBOOL bBestConverged = FALSE;
+#if !_CLG_DOUBLEFLOAT
+        DOUBLE fBestFunctional = 0.0;
+#else
+        Real fBestFunctional = F(0.0);
+#endif
+        for (UINT i = 0; i < m_uiCopies; ++i)
+        {
+            m_pOriginal->CopyTo(pResGauge);
+            if (i > 0)
+            {
+                m_pRandom->GaugeFixingTimeSlice(pResGauge, uiT);
+            }
+            m_pFixing->GaugeFixingTimeSlice(pResGauge, uiT);
+            m_iIterate += m_pFixing->m_iIterate;
+
+            //the Coulomb fixings only stop before m_iMaxIterate when the slice is converged
+            const UBOOL bConverged = (m_pFixing->m_iIterate < m_pFixing->m_iMaxIterate);
+#if !_CLG_DOUBLEFLOAT
+            const DOUBLE fFunctional = FunctionalTimeSlice(pResGauge, uiT);
+#else
+            const Real fFunctional = FunctionalTimeSlice(pResGauge, uiT);
+#endif
+            m_lstFunctional[i] += fFunctional / _HC_Lt;
+            m_lstFunctionalOfSlice.AddItem(fFunctional);
+            appParanoiac(_T("CGaugeFixingCopies: t = %d, copy %d, converged %d, functional = %2.12f\n"), uiT, i, bConverged, fFunctional);
+
+            if (0 == i
+             || (bConverged && !bBestConverged)
+             || (bConverged == bBestConverged && fFunctional > fBestFunctional))
+            {
+                uiBestCopy = i;
+                bBestConverged = bConverged;
+                fBestFunctional = fFunctional;
+                pResGauge->CopyTo(m_pBest);
+            }
+        }
+
+        m_lstBestCopyOfSlice.AddItem(uiBestCopy);
+        m_pBest->CopyTo(m_pOriginal);
+    }
+
+    m_pOriginal->CopyTo(pResGauge);
+    pResGauge->IncreaseVersion();
+    appDetailed(_T("CGaugeFixingCopies: functional = %2.12f\n"), Functional(pResGauge));
+}
+
+CCString CGaugeFixingCopies::GetInfos(const CCString& tab) const
+{
+    CCString sRet;
+    sRet = sRet + tab + _T("Name : CGaugeFixingCopies\n");
+    sRet = sRet + tab + _T("GaugeCopies : ") + appIntToString(static_cast<INT>(m_uiCopies)) + _T("\n");
+    if (NULL != m_pFixing)
+    {
+        sRet = sRet + tab + _T("Fixing : \n");
+        sRet = sRet + m_pFixing->GetInfos(tab + _T("    "));
+    }
+    return sRet;
+}
+
+__END_NAMESPACE
+
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
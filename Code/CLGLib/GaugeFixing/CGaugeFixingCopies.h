@@ -0,0 +1,111 @@
+//=============================================================================
+// FILENAME : CGaugeFixingCopies.h
+//
+// DESCRIPTION:
+// Run a gauge fixing on several gauge copies and keep the one with the largest
+// functional F = Retr[sum _{n,mu} U_mu(n)] / (3 V d), (d=3 for Coulomb)
+// This is the usual best-copy selection against the Gribov copies.
+//
+// The copy 0 is the gauge field itself, others are random gauge transforms
+// of it, the copies are fixed one after another (each copy is a full fixing
+// of the whole lattice, so a copy already fills the device, and running the
+// copies together only needs N times the memory of the gauge field).
+//
+// For Coulomb gauge, the functional is a sum of independent functionals of
+// the time slices, so the best copy is selected for each time slice:
+// the slices are fixed one after another, on each slice the copies are the
+// random transforms of only that slice, all starting from the field with the
+// best copies of the slices before.
+//
+// GaugeFixing:
+//     Name : CGaugeFixingCopies
+//     GaugeCopies : 4
+//     Fixing:
+//         Name : CGaugeFixingLandauLosAlamos
+//         ...
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#ifndef _CGAUGEFIXINGCOPIES_H_
+#define _CGAUGEFIXINGCOPIES_H_
+
+__BEGIN_NAMESPACE
+
+__CLG_REGISTER_HELPER_HEADER(CGaugeFixingCopies)
+
+class CLGAPI CGaugeFixingCopies : public CGaugeFixing
+{
+    __CLGDECLARE_CLASS(CGaugeFixingCopies)
+public:
+
+    CGaugeFixingCopies()
+    : CGaugeFixing()
+    , m_pFixing(NULL)
+    , m_pRandom(NULL)
+    , m_uiCopies(1)
+    , m_uiBestCopy(0)
+    , m_pOriginal(NULL)
+    , m_pBest(NULL)
+    {
+    }
+
+    ~CGaugeFixingCopies()
+    {
+        appSafeDelete(m_pFixing);
+        appSafeDelete(m_pRandom);
+        appSafeDelete(m_pOriginal);
+        appSafeDelete(m_pBest);
+    }
+
+    void Initial(class CLatticeData* pOwner, const CParameters& params) override;
+    void GaugeFixing(CFieldGauge* pResGauge) override;
+#if !_CLG_DOUBLEFLOAT
+    DOUBLE CheckRes(const CFieldGauge* pGauge) override;
+    DOUBLE Functional(const CFieldGauge* pGauge) const;
+    DOUBLE FunctionalTimeSlice(const CFieldGauge* pGauge, SCOORD uiT) const;
+#else
+    Real CheckRes(const CFieldGauge* pGauge) override;
+    Real Functional(const CFieldGauge* pGauge) const;
+    Real FunctionalTimeSlice(const CFieldGauge* pGauge, SCOORD uiT) const;
+#endif
+    CCString GetInfos(const CCString& sTab) const override;
+    UBOOL IsCoulomb() const override { return NULL != m_pFixing && m_pFixing->IsCoulomb(); }
+
+    CGaugeFixing* m_pFixing;
+    CGaugeFixingRandom* m_pRandom;
+    UINT m_uiCopies;
+
+    //functional of each copy after the last GaugeFixing
+    //for Coulomb gauge, it is the average over time slices of the functional of copy i on each slice,
+    //and m_lstBestCopyOfSlice is the best copy of each time slice
+    UINT m_uiBestCopy;
+#if !_CLG_DOUBLEFLOAT
+    TArray<DOUBLE> m_lstFunctional;
+#else
+    TArray<Real> m_lstFunctional;
+#endif
+    TArray<UINT> m_lstBestCopyOfSlice;
+    //for Coulomb gauge, the functional of copy i on the time slice t is at [t * m_uiCopies + i]
+#if !_CLG_DOUBLEFLOAT
+    TArray<DOUBLE> m_lstFunctionalOfSlice;
+#else
+    TArray<Real> m_lstFunctionalOfSlice;
+#endif
+
+protected:
+
+    void GaugeFixingCoulomb(CFieldGauge* pResGauge);
+
+    CFieldGauge* m_pOriginal;
+    CFieldGauge* m_pBest;
+};
+
+__END_NAMESPACE
+
+#endif //#ifndef _CGAUGEFIXINGCOPIES_H_
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
@@ -21,7 +21,7 @@ __BEGIN_NAMESPACE
  */
 __global__ void _CLG_LAUNCH_BOUND
 _kernelCalculateA3D(
-    SBYTE uiT,
+    SCOORD uiT,
     const deviceSU3* __restrict__ pU,
     DOUBLE* pA11,
     cuDoubleComplex* pA12,
@@ -66,7 +66,7 @@ __global__ void _CLG_LAUNCH_BOUND_HALF
 __global__ void _CLG_LAUNCH_BOUND
 #endif
 _kernelCalculateA3DLog(
-    SBYTE uiT,
+    SCOORD uiT,
     const deviceSU3* __restrict__ pU,
     DOUBLE* pA11,
     cuDoubleComplex* pA12,
@@ -112,7 +112,7 @@ _kernelCalculateA3DLog(
 __global__ void _CLG_LAUNCH_BOUND
 _kernelCalculateAGradient3D(
     BYTE byFieldId,
-    SBYTE uiT,
+    SCOORD uiT,
     DOUBLE* pGamma11,
     cuDoubleComplex* pGamma12,
     cuDoubleComplex* pGamma13,
@@ -187,7 +187,7 @@ _kernelCalculateAGradient3D(
  */
 __global__ void _CLG_LAUNCH_BOUND
 _kernelCalculateG3D(
-    SBYTE uiT,
+    SCOORD uiT,
     deviceSU3* pG,
     const DOUBLE* __restrict__ pGamma11,
     const cuDoubleComplex* __restrict__ pGamma12,
@@ -221,7 +221,7 @@ _kernelCalculateG3D(
  */
 __global__ void _CLG_LAUNCH_BOUND
 _kernelCalculateA3D(
-        SBYTE uiT,
+        SCOORD uiT,
         const deviceSU3* __restrict__ pU,
         Real* pA11,
         CLGComplex* pA12,
@@ -266,7 +266,7 @@ __global__ void _CLG_LAUNCH_BOUND_HALF
 __global__ void _CLG_LAUNCH_BOUND
 #endif
 _kernelCalculateA3DLog(
-    SBYTE uiT,
+    SCOORD uiT,
     const deviceSU3* __restrict__ pU,
     Real* pA11,
     CLGComplex* pA12,
@@ -312,7 +312,7 @@ _kernelCalculateA3DLog(
 __global__ void _CLG_LAUNCH_BOUND
 _kernelCalculateAGradient3D(
     BYTE byFieldId,
-    SBYTE uiT,
+    SCOORD uiT,
     Real* pGamma11,
     CLGComplex* pGamma12,
     CLGComplex* pGamma13,
@@ -386,7 +386,7 @@ _kernelCalculateAGradient3D(
  */
 __global__ void _CLG_LAUNCH_BOUND
 _kernelCalculateG3D(
-    SBYTE uiT,
+    SCOORD uiT,
     deviceSU3* pG,
     const Real* __restrict__ pGamma11,
     const CLGComplex* __restrict__ pGamma12,
@@ -423,7 +423,7 @@ _kernelCalculateG3D(
 __global__ void _CLG_LAUNCH_BOUND
 _kernelGaugeTransform3D(
     BYTE byFieldId,
-    SBYTE uiT,
+    SCOORD uiT,
     const deviceSU3* __restrict__ pGx,
     deviceSU3* pGauge)
 {
@@ -462,7 +462,7 @@ _kernelGaugeTransform3D(
 __global__ void _CLG_LAUNCH_BOUND
 _kernelGaugeTransform3DT(
     BYTE byFieldId,
-    SBYTE uiT,
+    SCOORD uiT,
     const deviceSU3* __restrict__ pGx,
     deviceSU3* pGauge)
 {
@@ -511,7 +511,7 @@ _kernelGaugeTransform3DT(
 */
 __global__ void _CLG_LAUNCH_BOUND
 _kernelCalculateTrAGradientSq3D(
-    SBYTE uiT,
+    SCOORD uiT,
     DOUBLE* pDeviceRes,
     const DOUBLE* __restrict__ pDeltaA11,
     const cuDoubleComplex* __restrict__ pDeltaA12,
@@ -540,7 +540,7 @@ _kernelCalculateTrAGradientSq3D(
 */
 __global__ void _CLG_LAUNCH_BOUND
 _kernelCalculateTrAGradientSq3D(
-    SBYTE uiT,
+    SCOORD uiT,
     Real* pDeviceRes,
     const Real* __restrict__ pDeltaA11,
     const CLGComplex* __restrict__ pDeltaA12,
@@ -568,11 +568,12 @@ _kernelCalculateTrAGradientSq3D(
 
 #pragma region FFT accelaration
 
+
 #if !_CLG_DOUBLEFLOAT
 __global__ void _CLG_LAUNCH_BOUND
 _kernelBakeMomentumTable3D(DOUBLE* pP, UINT uiV)
 {
-    const SBYTE uiT = 0;
+    const SCOORD uiT = 0;
     intokernalInt4_S_Only3D;
 
     const BYTE uiDir = static_cast<BYTE>(_DC_Dir);
@@ -592,34 +593,63 @@ _kernelBakeMomentumTable3D(DOUBLE* pP, UINT uiV)
     pP[uiSiteIndex3D] = 6.0 / (fDenorm * uiV);
 }
 
+/**
+ * The FFT buffer is [site][4]: (Gamma11 + i Gamma22), Gamma12, Gamma13, Gamma23
+ * Gamma11 and Gamma22 are real, and the momentum table is real and even in p,
+ * so they are filtered together as one complex number.
+ * One 4-component FFT instead of 5 single-component FFTs.
+ */
 __global__ void _CLG_LAUNCH_BOUND
-_kernelFFTRtoC3D(const DOUBLE* __restrict__ realBuffer, cuDoubleComplex* complexBuffer)
+_kernelFFTPack3D(
+    const DOUBLE* __restrict__ pGamma11,
+    const cuDoubleComplex* __restrict__ pGamma12,
+    const cuDoubleComplex* __restrict__ pGamma13,
+    const DOUBLE* __restrict__ pGamma22,
+    const cuDoubleComplex* __restrict__ pGamma23,
+    cuDoubleComplex* pFFTBuffer)
 {
-    const SBYTE uiT = 0;
+    const SCOORD uiT = 0;
     intokernalInt4_S_Only3D;
-    complexBuffer[uiSiteIndex3D] = make_cuDoubleComplex(realBuffer[uiSiteIndex3D], 0.0);
+    pFFTBuffer[4 * uiSiteIndex3D] = make_cuDoubleComplex(pGamma11[uiSiteIndex3D], pGamma22[uiSiteIndex3D]);
+    pFFTBuffer[4 * uiSiteIndex3D + 1] = pGamma12[uiSiteIndex3D];
+    pFFTBuffer[4 * uiSiteIndex3D + 2] = pGamma13[uiSiteIndex3D];
+    pFFTBuffer[4 * uiSiteIndex3D + 3] = pGamma23[uiSiteIndex3D];
 }
 
 __global__ void _CLG_LAUNCH_BOUND
-_kernelFFTCtoR3D(const cuDoubleComplex* __restrict__ complexBuffer, DOUBLE* realBuffer)
+_kernelFFTUnpack3D(
+    const cuDoubleComplex* __restrict__ pFFTBuffer,
+    DOUBLE* pGamma11,
+    cuDoubleComplex* pGamma12,
+    cuDoubleComplex* pGamma13,
+    DOUBLE* pGamma22,
+    cuDoubleComplex* pGamma23)
 {
-    const SBYTE uiT = 0;
+    const SCOORD uiT = 0;
     intokernalInt4_S_Only3D;
-    realBuffer[uiSiteIndex3D] = complexBuffer[uiSiteIndex3D].x;
+    pGamma11[uiSiteIndex3D] = pFFTBuffer[4 * uiSiteIndex3D].x;
+    pGamma22[uiSiteIndex3D] = pFFTBuffer[4 * uiSiteIndex3D].y;
+    pGamma12[uiSiteIndex3D] = pFFTBuffer[4 * uiSiteIndex3D + 1];
+    pGamma13[uiSiteIndex3D] = pFFTBuffer[4 * uiSiteIndex3D + 2];
+    pGamma23[uiSiteIndex3D] = pFFTBuffer[4 * uiSiteIndex3D + 3];
 }
 
 __global__ void _CLG_LAUNCH_BOUND
 _kernelFFTScale3D(const DOUBLE* __restrict__ pP, cuDoubleComplex* fftRes)
 {
-    const SBYTE uiT = 0;
+    const SCOORD uiT = 0;
     intokernalInt4_S_Only3D;
-    fftRes[uiSiteIndex3D] = cuCmulf_cd(fftRes[uiSiteIndex3D], pP[uiSiteIndex3D]);
+    #pragma unroll
+    for (UINT i = 0; i < 4; ++i)
+    {
+        fftRes[4 * uiSiteIndex3D + i] = cuCmulf_cd(fftRes[4 * uiSiteIndex3D + i], pP[uiSiteIndex3D]);
+    }
 }
 #else
 __global__ void _CLG_LAUNCH_BOUND
 _kernelBakeMomentumTable3D(Real* pP, UINT uiV)
 {
-    const SBYTE uiT = 0;
+    const SCOORD uiT = 0;
     intokernalInt4_S_Only3D;
 
     const BYTE uiDir = static_cast<BYTE>(_DC_Dir);
@@ -640,27 +670,50 @@ _kernelBakeMomentumTable3D(Real* pP, UINT uiV)
 }
 
 __global__ void _CLG_LAUNCH_BOUND
-_kernelFFTRtoC3D(const Real* __restrict__ realBuffer, CLGComplex* complexBuffer)
+_kernelFFTPack3D(
+    const Real* __restrict__ pGamma11,
+    const CLGComplex* __restrict__ pGamma12,
+    const CLGComplex* __restrict__ pGamma13,
+    const Real* __restrict__ pGamma22,
+    const CLGComplex* __restrict__ pGamma23,
+    CLGComplex* pFFTBuffer)
 {
-    const SBYTE uiT = 0;
+    const SCOORD uiT = 0;
     intokernalInt4_S_Only3D;
-    complexBuffer[uiSiteIndex3D] = _make_cuComplex(realBuffer[uiSiteIndex3D], F(0.0));
+    pFFTBuffer[4 * uiSiteIndex3D] = _make_cuComplex(pGamma11[uiSiteIndex3D], pGamma22[uiSiteIndex3D]);
+    pFFTBuffer[4 * uiSiteIndex3D + 1] = pGamma12[uiSiteIndex3D];
+    pFFTBuffer[4 * uiSiteIndex3D + 2] = pGamma13[uiSiteIndex3D];
+    pFFTBuffer[4 * uiSiteIndex3D + 3] = pGamma23[uiSiteIndex3D];
 }
 
 __global__ void _CLG_LAUNCH_BOUND
-_kernelFFTCtoR3D(const CLGComplex* __restrict__ complexBuffer, Real* realBuffer)
+_kernelFFTUnpack3D(
+    const CLGComplex* __restrict__ pFFTBuffer,
+    Real* pGamma11,
+    CLGComplex* pGamma12,
+    CLGComplex* pGamma13,
+    Real* pGamma22,
+    CLGComplex* pGamma23)
 {
-    const SBYTE uiT = 0;
+    const SCOORD uiT = 0;
     intokernalInt4_S_Only3D;
-    realBuffer[uiSiteIndex3D] = complexBuffer[uiSiteIndex3D].x;
+    pGamma11[uiSiteIndex3D] = pFFTBuffer[4 * uiSiteIndex3D].x;
+    pGamma22[uiSiteIndex3D] = pFFTBuffer[4 * uiSiteIndex3D].y;
+    pGamma12[uiSiteIndex3D] = pFFTBuffer[4 * uiSiteIndex3D + 1];
+    pGamma13[uiSiteIndex3D] = pFFTBuffer[4 * uiSiteIndex3D + 2];
+    pGamma23[uiSiteIndex3D] = pFFTBuffer[4 * uiSiteIndex3D + 3];
 }
 
 __global__ void _CLG_LAUNCH_BOUND
 _kernelFFTScale3D(const Real* __restrict__ pP, CLGComplex* fftRes)
 {
-    const SBYTE uiT = 0;
+    const SCOORD uiT = 0;
     intokernalInt4_S_Only3D;
-    fftRes[uiSiteIndex3D] = cuCmulf_cr(fftRes[uiSiteIndex3D], pP[uiSiteIndex3D]);
+    #pragma unroll
+    for (UINT i = 0; i < 4; ++i)
+    {
+        fftRes[4 * uiSiteIndex3D + i] = cuCmulf_cr(fftRes[4 * uiSiteIndex3D + i], pP[uiSiteIndex3D]);
+    }
 }
 #endif
 #pragma endregion
@@ -689,6 +742,8 @@ void CGaugeFixingCoulombCornell::Initial(class CLatticeData* pOwner, const CPara
     m_lstDims.AddItem(_HC_Lx);
     m_lstDims.AddItem(_HC_Ly);
     m_lstDims.AddItem(_HC_Lz);
+    //one time slice, [x][y][z][1][c]
+    m_lstDims.AddItem(1);
 
     checkCudaErrors(cudaMalloc((void**)& m_pDDecomp, sizeof(UINT) * 6));
 
@@ -728,6 +783,13 @@ void CGaugeFixingCoulombCornell::Initial(class CLatticeData* pOwner, const CPara
     }
     m_iShowErrorStep = iValue;
 
+    iValue = static_cast<INT>(m_iCheckErrorStep);
+    if (!params.FetchValueINT(_T("CheckErrorStep"), iValue))
+    {
+        appParanoiac(_T("CGaugeFixingCoulombCornell: CheckErrorStep not set, set to 10 by defualt."));
+    }
+    m_iCheckErrorStep = iValue > 0 ? static_cast<UINT>(iValue) : 1;
+
     iValue = 1;
     if (!params.FetchValueINT(_T("FFT"), iValue))
     {
@@ -773,10 +835,10 @@ void CGaugeFixingCoulombCornell::Initial(class CLatticeData* pOwner, const CPara
     {
 #if !_CLG_DOUBLEFLOAT
         checkCudaErrors(cudaMalloc((void**)&m_pMomentumTable, _HC_Volume_xyz * sizeof(DOUBLE)));
-        checkCudaErrors(cudaMalloc((void**)&m_pTempFFTBuffer, _HC_Volume_xyz * sizeof(cuDoubleComplex)));
+        checkCudaErrors(cudaMalloc((void**)&m_pTempFFTBuffer, _HC_Volume_xyz * 4 * sizeof(cuDoubleComplex)));
 #else
         checkCudaErrors(cudaMalloc((void**)& m_pMomentumTable, _HC_Volume_xyz * sizeof(Real)));
-        checkCudaErrors(cudaMalloc((void**)& m_pTempFFTBuffer, _HC_Volume_xyz * sizeof(CLGComplex)));
+        checkCudaErrors(cudaMalloc((void**)& m_pTempFFTBuffer, _HC_Volume_xyz * 4 * sizeof(CLGComplex)));
 #endif
         preparethread_S;
         _kernelBakeMomentumTable3D << <block, threads >> > (m_pMomentumTable, _HC_Volume_xyz);
@@ -792,13 +854,26 @@ void CGaugeFixingCoulombCornell::GaugeFixing(CFieldGauge* pResGauge)
     }
     CFieldGaugeSU3* pGaugeSU3 = dynamic_cast<CFieldGaugeSU3*>(pResGauge);
     deviceSU3* pDeviceBufferPointer = pGaugeSU3->m_pDeviceData;
-    for (SBYTE uiT = 0; uiT < static_cast<SBYTE>(_HC_Lt); ++uiT)
+    for (SCOORD uiT = 0; uiT < static_cast<SCOORD>(_HC_Lt); ++uiT)
     {
         GaugeFixingOneTimeSlice(pDeviceBufferPointer, uiT, pGaugeSU3->m_byFieldId);
     }
+    pResGauge->IncreaseVersion();
 }
 
-void CGaugeFixingCoulombCornell::GaugeFixingOneTimeSlice(deviceSU3* pDeviceBufferPointer, SBYTE uiT, BYTE byFieldId)
+void CGaugeFixingCoulombCornell::GaugeFixingTimeSlice(CFieldGauge* pResGauge, SCOORD uiT)
+{
+    if (NULL == pResGauge || EFT_GaugeSU3 != pResGauge->GetFieldType())
+    {
+        appCrucial(_T("CGaugeFixingCoulombCornell only implemented with gauge SU3!\n"));
+        return;
+    }
+    CFieldGaugeSU3* pGaugeSU3 = dynamic_cast<CFieldGaugeSU3*>(pResGauge);
+    GaugeFixingOneTimeSlice(pGaugeSU3->m_pDeviceData, uiT, pGaugeSU3->m_byFieldId);
+    pResGauge->IncreaseVersion();
+}
+
+void CGaugeFixingCoulombCornell::GaugeFixingOneTimeSlice(deviceSU3* pDeviceBufferPointer, SCOORD uiT, BYTE byFieldId)
 {
     preparethread_S;
     m_iIterate = 0;
@@ -849,77 +924,42 @@ void CGaugeFixingCoulombCornell::GaugeFixingOneTimeSlice(deviceSU3* pDeviceBuffe
             m_pA23);
 
         //======= 2. Calculate Theta    =========
-        _kernelCalculateTrAGradientSq3D << <block, threads >> > (
-            uiT,
-            _D_RealThreadBuffer,
-            m_pGamma11,
-            m_pGamma12,
-            m_pGamma13,
-            m_pGamma22,
-            m_pGamma23);
-        fTheta = appGetCudaHelper()->ReduceReal(_D_RealThreadBuffer, _HC_Volume_xyz) / (3 * _HC_Volume_xyz);
-        if (m_iShowErrorStep > 0 && 0 == m_iIterate % m_iShowErrorStep)
+        if (0 == m_iIterate % m_iCheckErrorStep)
         {
-            appParanoiac(_T("Theta%d = %2.12f\n"), m_iIterate, fTheta);
-        }
+            _kernelCalculateTrAGradientSq3D << <block, threads >> > (
+                uiT,
+                _D_RealThreadBuffer,
+                m_pGamma11,
+                m_pGamma12,
+                m_pGamma13,
+                m_pGamma22,
+                m_pGamma23);
+            fTheta = appGetCudaHelper()->ReduceReal(_D_RealThreadBuffer, _HC_Volume_xyz) / (3 * _HC_Volume_xyz);
+            if (m_iShowErrorStep > 0 && 0 == m_iIterate % m_iShowErrorStep)
+            {
+                appParanoiac(_T("Theta%d = %2.12f\n"), m_iIterate, fTheta);
+            }
 
-        if (fTheta < m_fAccuracy)
-        {
-            return;
+            if (fTheta < m_fAccuracy)
+            {
+                return;
+            }
         }
 
         //======= 3. FFT =========
         if (m_bFA)
         {
+            _kernelFFTPack3D << <block, threads >> > (m_pGamma11, m_pGamma12, m_pGamma13, m_pGamma22, m_pGamma23, m_pTempFFTBuffer);
 #if !_CLG_DOUBLEFLOAT
-            CCLGFFTHelper::FFT3DWithXYZDouble(m_pGamma12, m_lstDims, TRUE);
-            _kernelFFTScale3D << <block, threads >> > (m_pMomentumTable, m_pGamma12);
-            CCLGFFTHelper::FFT3DWithXYZDouble(m_pGamma12, m_lstDims, FALSE);
-
-            CCLGFFTHelper::FFT3DWithXYZDouble(m_pGamma13, m_lstDims, TRUE);
-            _kernelFFTScale3D << <block, threads >> > (m_pMomentumTable, m_pGamma13);
-            CCLGFFTHelper::FFT3DWithXYZDouble(m_pGamma13, m_lstDims, FALSE);
-
-            CCLGFFTHelper::FFT3DWithXYZDouble(m_pGamma23, m_lstDims, TRUE);
-            _kernelFFTScale3D << <block, threads >> > (m_pMomentumTable, m_pGamma23);
-            CCLGFFTHelper::FFT3DWithXYZDouble(m_pGamma23, m_lstDims, FALSE);
-
-            _kernelFFTRtoC3D << <block, threads >> > (m_pGamma11, m_pTempFFTBuffer);
-            CCLGFFTHelper::FFT3DWithXYZDouble(m_pTempFFTBuffer, m_lstDims, TRUE);
+            CCLGFFTHelper::FFT3DWithXYZWComponentsDouble(m_pTempFFTBuffer, m_lstDims, 4, TRUE);
             _kernelFFTScale3D << <block, threads >> > (m_pMomentumTable, m_pTempFFTBuffer);
-            CCLGFFTHelper::FFT3DWithXYZDouble(m_pTempFFTBuffer, m_lstDims, FALSE);
-            _kernelFFTCtoR3D << <block, threads >> > (m_pTempFFTBuffer, m_pGamma11);
-
-            _kernelFFTRtoC3D << <block, threads >> > (m_pGamma22, m_pTempFFTBuffer);
-            CCLGFFTHelper::FFT3DWithXYZDouble(m_pTempFFTBuffer, m_lstDims, TRUE);
-            _kernelFFTScale3D << <block, threads >> > (m_pMomentumTable, m_pTempFFTBuffer);
-            CCLGFFTHelper::FFT3DWithXYZDouble(m_pTempFFTBuffer, m_lstDims, FALSE);
-            _kernelFFTCtoR3D << <block, threads >> > (m_pTempFFTBuffer, m_pGamma22); 
+            CCLGFFTHelper::FFT3DWithXYZWComponentsDouble(m_pTempFFTBuffer, m_lstDims, 4, FALSE);
 #else
-            CCLGFFTHelper::FFT3DWithXYZ(m_pGamma12, m_lstDims, TRUE);
-            _kernelFFTScale3D << <block, threads >> > (m_pMomentumTable, m_pGamma12);
-            CCLGFFTHelper::FFT3DWithXYZ(m_pGamma12, m_lstDims, FALSE);
-
-            CCLGFFTHelper::FFT3DWithXYZ(m_pGamma13, m_lstDims, TRUE);
-            _kernelFFTScale3D << <block, threads >> > (m_pMomentumTable, m_pGamma13);
-            CCLGFFTHelper::FFT3DWithXYZ(m_pGamma13, m_lstDims, FALSE);
-
-            CCLGFFTHelper::FFT3DWithXYZ(m_pGamma23, m_lstDims, TRUE);
-            _kernelFFTScale3D << <block, threads >> > (m_pMomentumTable, m_pGamma23);
-            CCLGFFTHelper::FFT3DWithXYZ(m_pGamma23, m_lstDims, FALSE);
-
-            _kernelFFTRtoC3D << <block, threads >> > (m_pGamma11, m_pTempFFTBuffer);
-            CCLGFFTHelper::FFT3DWithXYZ(m_pTempFFTBuffer, m_lstDims, TRUE);
-            _kernelFFTScale3D << <block, threads >> > (m_pMomentumTable, m_pTempFFTBuffer);
-            CCLGFFTHelper::FFT3DWithXYZ(m_pTempFFTBuffer, m_lstDims, FALSE);
-            _kernelFFTCtoR3D << <block, threads >> > (m_pTempFFTBuffer, m_pGamma11);
-
-            _kernelFFTRtoC3D << <block, threads >> > (m_pGamma22, m_pTempFFTBuffer);
-            CCLGFFTHelper::FFT3DWithXYZ(m_pTempFFTBuffer, m_lstDims, TRUE);
+            CCLGFFTHelper::FFT3DWithXYZWComponents(m_pTempFFTBuffer, m_lstDims, 4, TRUE);
             _kernelFFTScale3D << <block, threads >> > (m_pMomentumTable, m_pTempFFTBuffer);
-            CCLGFFTHelper::FFT3DWithXYZ(m_pTempFFTBuffer, m_lstDims, FALSE);
-            _kernelFFTCtoR3D << <block, threads >> > (m_pTempFFTBuffer, m_pGamma22);
+            CCLGFFTHelper::FFT3DWithXYZWComponents(m_pTempFFTBuffer, m_lstDims, 4, FALSE);
 #endif
+            _kernelFFTUnpack3D << <block, threads >> > (m_pTempFFTBuffer, m_pGamma11, m_pGamma12, m_pGamma13, m_pGamma22, m_pGamma23);
         }
 
         //======= 4. Gauge Transform    =========
@@ -959,7 +999,7 @@ Real CGaugeFixingCoulombCornell::CheckRes(const CFieldGauge* pGauge)
 #endif
 
     preparethread_S;
-    for (SBYTE uiT = 0; uiT < static_cast<SBYTE>(_HC_Lt); ++uiT)
+    for (SCOORD uiT = 0; uiT < static_cast<SCOORD>(_HC_Lt); ++uiT)
     {
         if (0 == _HC_ALog)
         {
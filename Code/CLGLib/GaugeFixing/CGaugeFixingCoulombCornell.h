@@ -38,6 +38,7 @@ public:
         , m_pMomentumTable(NULL)
         , m_pTempFFTBuffer(NULL)
         , m_bFA(TRUE)
+        , m_iCheckErrorStep(10)
     {
     }
 
@@ -66,9 +67,11 @@ public:
 #else
     Real CheckRes(const CFieldGauge* pGauge) override;
 #endif
-    void GaugeFixingOneTimeSlice(deviceSU3* pResGauge, SBYTE uiT, BYTE byFieldId);
+    void GaugeFixingOneTimeSlice(deviceSU3* pResGauge, SCOORD uiT, BYTE byFieldId);
+    void GaugeFixingTimeSlice(CFieldGauge* pResGauge, SCOORD uiT) override;
     
     CCString GetInfos(const CCString& sTab) const override;
+    UBOOL IsCoulomb() const override { return TRUE; }
 
 #if !_CLG_DOUBLEFLOAT
     DOUBLE m_fAlpha;
@@ -93,6 +96,7 @@ public:
     cuDoubleComplex* m_pGamma23;
     deviceSU3* m_pG;
     DOUBLE* m_pMomentumTable;
+    //[site][4]: (Gamma11 + i Gamma22), Gamma12, Gamma13, Gamma23
     cuDoubleComplex* m_pTempFFTBuffer;
 #else
     Real* m_pA11;
@@ -107,10 +111,14 @@ public:
     CLGComplex* m_pGamma23;
     deviceSU3* m_pG;
     Real* m_pMomentumTable;
+    //[site][4]: (Gamma11 + i Gamma22), Gamma12, Gamma13, Gamma23
     CLGComplex* m_pTempFFTBuffer;
 #endif
     //FFT accelaration not support now
     UBOOL m_bFA;
+
+    //Theta is reduced (with a device-host sync) every m_iCheckErrorStep iterations
+    UINT m_iCheckErrorStep;
     TArray<INT> m_lstDims;
 };
 
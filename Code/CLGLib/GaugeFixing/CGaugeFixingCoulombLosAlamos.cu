@@ -16,9 +16,10 @@ __BEGIN_NAMESPACE
 __global__ void _CLG_LAUNCH_BOUND
 _kernelCalculateGOdd_S(
     BYTE byFieldId,
-    SBYTE uiT,
+    SCOORD uiT,
     const deviceSU3* __restrict__ pU,
     Real fOmega,
+    Real fStochastic,
     UBOOL bMixed,
     deviceSU3* pG)
 {
@@ -59,17 +60,16 @@ _kernelCalculateGOdd_S(
         }
     }
 
-    pG[uiSiteIndex3D].MulReal(fOmega);
-    pG[uiSiteIndex3D].Add(su3Id.MulRealC(F(1.0) - fOmega));
-    pG[uiSiteIndex3D].CabbiboMarinariProj();
+    _deviceGaugeFixingRelaxation(pG[uiSiteIndex3D], fOmega, fStochastic, uiSiteIndex);
 }
 
 __global__ void _CLG_LAUNCH_BOUND
 _kernelCalculateGEven_S(
     BYTE byFieldId,
-    SBYTE uiT,
+    SCOORD uiT,
     const deviceSU3* __restrict__ pU,
     Real fOmega,
+    Real fStochastic,
     UBOOL bMixed,
     deviceSU3* pG)
 {
@@ -110,9 +110,7 @@ _kernelCalculateGEven_S(
         }
     }
 
-    pG[uiSiteIndex3D].MulReal(fOmega);
-    pG[uiSiteIndex3D].Add(su3Id.MulRealC(F(1.0) - fOmega));
-    pG[uiSiteIndex3D].CabbiboMarinariProj();
+    _deviceGaugeFixingRelaxation(pG[uiSiteIndex3D], fOmega, fStochastic, uiSiteIndex);
 }
 
 /**
@@ -122,7 +120,7 @@ _kernelCalculateGEven_S(
 __global__ void _CLG_LAUNCH_BOUND
 _kernelGaugeTransformOdd_S(
     BYTE byFieldId,
-    SBYTE uiT,
+    SCOORD uiT,
     const deviceSU3* __restrict__ pGx,
     deviceSU3* pGauge)
 {
@@ -166,7 +164,7 @@ _kernelGaugeTransformOdd_S(
 __global__ void _CLG_LAUNCH_BOUND
 _kernelGaugeTransformEven_S(
     BYTE byFieldId,
-    SBYTE uiT,
+    SCOORD uiT,
     const deviceSU3* __restrict__ pGx,
     deviceSU3* pGauge)
 {
@@ -210,7 +208,7 @@ _kernelGaugeTransformEven_S(
 __global__ void _CLG_LAUNCH_BOUND
 _kernelGaugeTransform3DTOdd(
     BYTE byFieldId,
-    SBYTE uiT,
+    SCOORD uiT,
     const deviceSU3* __restrict__ pGx,
     deviceSU3* pGauge)
 {
@@ -255,7 +253,7 @@ _kernelGaugeTransform3DTOdd(
 __global__ void _CLG_LAUNCH_BOUND
 _kernelGaugeTransform3DTEven(
     BYTE byFieldId,
-    SBYTE uiT,
+    SCOORD uiT,
     const deviceSU3* __restrict__ pGx,
     deviceSU3* pGauge)
 {
@@ -301,7 +299,7 @@ _kernelGaugeTransform3DTEven(
 __global__ void _CLG_LAUNCH_BOUND
 _kernelGaugeTransform3Dcpy(
     BYTE byFieldId,
-    SBYTE uiT,
+    SCOORD uiT,
     const deviceSU3* __restrict__ pGx,
     deviceSU3* pGauge)
 {
@@ -340,7 +338,7 @@ _kernelGaugeTransform3Dcpy(
 __global__ void _CLG_LAUNCH_BOUND
 _kernelGaugeTransform3DTcpy(
     BYTE byFieldId,
-    SBYTE uiT,
+    SCOORD uiT,
     const deviceSU3* __restrict__ pGx,
     deviceSU3* pGauge)
 {
@@ -388,7 +386,7 @@ _kernelGaugeTransform3DTcpy(
  */
 __global__ void _CLG_LAUNCH_BOUND
 _kernelCalculateASpace_S(
-        SBYTE uiT,
+        SCOORD uiT,
         const deviceSU3* __restrict__ pU,
         Real* pA11,
         CLGComplex* pA12,
@@ -433,7 +431,7 @@ _kernelCalculateASpace_S(
 __global__ void _CLG_LAUNCH_BOUND
 _kernelCalculateCoulombDivation_S(
     BYTE byFieldId,
-    SBYTE uiT,
+    SCOORD uiT,
 #if !_CLG_DOUBLEFLOAT
     DOUBLE* pDeviceRes,
 #else
@@ -556,6 +554,11 @@ void CGaugeFixingCoulombLosAlamos::Initial(class CLatticeData* pOwner, const CPa
         appGeneral(_T("CGaugeFixingCoulombLosAlamos: Omega not set, set to 1.0 by defualt."));
     }
 
+    if (!params.FetchValueReal(_T("StochasticProbability"), m_fStochastic))
+    {
+        appGeneral(_T("CGaugeFixingCoulombLosAlamos: StochasticProbability not set, set to 0.0 by defualt."));
+    }
+
     if (!params.FetchValueReal(_T("Accuracy"), m_fAccuracy))
     {
         appGeneral(_T("CGaugeFixingCoulombLosAlamos: Accuracy not set, set to 0.00000000001 by defualt."));
@@ -627,7 +630,7 @@ Real CGaugeFixingCoulombLosAlamos::CheckResDeviceBuffer(const deviceSU3* __restr
     Real fRes = F(0.0);
 #endif
     preparethread_S;
-    for (SBYTE uiT = 0; uiT < static_cast<SBYTE>(_HC_Lt); ++uiT)
+    for (SCOORD uiT = 0; uiT < static_cast<SCOORD>(_HC_Lt); ++uiT)
     {
         _kernelCalculateASpace_S << <block, threads >> > (
             uiT,
@@ -653,9 +656,9 @@ Real CGaugeFixingCoulombLosAlamos::CheckResDeviceBuffer(const deviceSU3* __restr
 }
 
 #if !_CLG_DOUBLEFLOAT
-DOUBLE CGaugeFixingCoulombLosAlamos::CheckResDeviceBufferOnlyT(const deviceSU3* __restrict__ pGauge, SBYTE uiT, BYTE byFieldId)
+DOUBLE CGaugeFixingCoulombLosAlamos::CheckResDeviceBufferOnlyT(const deviceSU3* __restrict__ pGauge, SCOORD uiT, BYTE byFieldId)
 #else
-Real CGaugeFixingCoulombLosAlamos::CheckResDeviceBufferOnlyT(const deviceSU3* __restrict__ pGauge, SBYTE uiT, BYTE byFieldId)
+Real CGaugeFixingCoulombLosAlamos::CheckResDeviceBufferOnlyT(const deviceSU3* __restrict__ pGauge, SCOORD uiT, BYTE byFieldId)
 #endif
 {
     preparethread_S;
@@ -691,15 +694,28 @@ void CGaugeFixingCoulombLosAlamos::GaugeFixing(CFieldGauge* pResGauge)
     CFieldGaugeSU3* pGaugeSU3 = dynamic_cast<CFieldGaugeSU3*>(pResGauge);
     deviceSU3* pDeviceBufferPointer = pGaugeSU3->m_pDeviceData;
 
-    for (SBYTE uiT = 0; uiT < static_cast<SBYTE>(_HC_Lt); ++uiT)
+    for (SCOORD uiT = 0; uiT < static_cast<SCOORD>(_HC_Lt); ++uiT)
     {
         GaugeFixingForT(pDeviceBufferPointer, uiT, pResGauge->m_byFieldId);
     }
+    pResGauge->IncreaseVersion();
 
     //appGeneral(_T("Gauge fixing failed with last error = %f\n"), fTheta);
 }
 
-void CGaugeFixingCoulombLosAlamos::GaugeFixingForT(deviceSU3* pDeviceBufferPointer, SBYTE uiT, BYTE byFieldId)
+void CGaugeFixingCoulombLosAlamos::GaugeFixingTimeSlice(CFieldGauge* pResGauge, SCOORD uiT)
+{
+    if (NULL == pResGauge || EFT_GaugeSU3 != pResGauge->GetFieldType())
+    {
+        appCrucial(_T("CGaugeFixingCoulombLosAlamos only implemented with gauge SU3!\n"));
+        return;
+    }
+    CFieldGaugeSU3* pGaugeSU3 = dynamic_cast<CFieldGaugeSU3*>(pResGauge);
+    GaugeFixingForT(pGaugeSU3->m_pDeviceData, uiT, pResGauge->m_byFieldId);
+    pResGauge->IncreaseVersion();
+}
+
+void CGaugeFixingCoulombLosAlamos::GaugeFixingForT(deviceSU3* pDeviceBufferPointer, SCOORD uiT, BYTE byFieldId)
 {
     preparethread_S;
     m_iIterate = 0;
@@ -721,7 +737,11 @@ void CGaugeFixingCoulombLosAlamos::GaugeFixingForT(deviceSU3* pDeviceBufferPoint
             }
         }
 
-        _kernelCalculateGOdd_S << <block, threads >> > (byFieldId, uiT, pDeviceBufferPointer, m_fOmega, m_bMixed, m_pG);
+        if (m_fStochastic > F(0.0))
+        {
+            appGetLattice()->m_pRandom->NextLaunch();
+        }
+        _kernelCalculateGOdd_S << <block, threads >> > (byFieldId, uiT, pDeviceBufferPointer, m_fOmega, m_fStochastic, m_bMixed, m_pG);
 
         if (m_bMixed)
         {
@@ -735,7 +755,7 @@ void CGaugeFixingCoulombLosAlamos::GaugeFixingForT(deviceSU3* pDeviceBufferPoint
         }
 
 
-        _kernelCalculateGEven_S << <block, threads >> > (byFieldId, uiT, pDeviceBufferPointer, m_fOmega, m_bMixed, m_pG);
+        _kernelCalculateGEven_S << <block, threads >> > (byFieldId, uiT, pDeviceBufferPointer, m_fOmega, m_fStochastic, m_bMixed, m_pG);
         if (m_bMixed)
         {
             _kernelGaugeTransform3Dcpy << <block, threads >> > (byFieldId, uiT, m_pG, pDeviceBufferPointer);
@@ -757,6 +777,7 @@ CCString CGaugeFixingCoulombLosAlamos::GetInfos(const CCString& tab) const
     CCString sRet;
     sRet = sRet + tab + _T("Name : CGaugeFixingCoulombLosAlamos\n");
     sRet = sRet + tab + _T("Omega : ") + appFloatToString(m_fOmega) + _T("\n");
+    sRet = sRet + tab + _T("StochasticProbability : ") + appFloatToString(m_fStochastic) + _T("\n");
     return sRet;
 }
 
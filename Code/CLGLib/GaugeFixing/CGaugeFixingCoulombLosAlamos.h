@@ -26,6 +26,7 @@ public:
     : CGaugeFixing()
     , m_pDDecomp(NULL)
     , m_fOmega(F(1.0))
+    , m_fStochastic(F(0.0))
     , m_iCheckErrorStep(1000)
     , m_pG(NULL)
     , m_pA11(NULL)
@@ -49,22 +50,27 @@ public:
 
     void Initial(class CLatticeData* pOwner, const CParameters& params) override;
     void GaugeFixing(CFieldGauge* pResGauge) override;
-    void GaugeFixingForT(deviceSU3* pResGauge, SBYTE uiT, BYTE byFieldId);
+    void GaugeFixingForT(deviceSU3* pResGauge, SCOORD uiT, BYTE byFieldId);
+    void GaugeFixingTimeSlice(CFieldGauge* pResGauge, SCOORD uiT) override;
 #if !_CLG_DOUBLEFLOAT
     DOUBLE CheckRes(const CFieldGauge* pGauge) override;
     DOUBLE CheckResDeviceBuffer(const deviceSU3* __restrict__ pGauge, BYTE byFieldId);
-    DOUBLE CheckResDeviceBufferOnlyT(const deviceSU3* __restrict__ pGauge, SBYTE uiT, BYTE byFieldId);
+    DOUBLE CheckResDeviceBufferOnlyT(const deviceSU3* __restrict__ pGauge, SCOORD uiT, BYTE byFieldId);
 #else
     Real CheckRes(const CFieldGauge* pGauge) override;
     Real CheckResDeviceBuffer(const deviceSU3* __restrict__ pGauge, BYTE byFieldId);
-    Real CheckResDeviceBufferOnlyT(const deviceSU3* __restrict__ pGauge, SBYTE uiT, BYTE byFieldId);
+    Real CheckResDeviceBufferOnlyT(const deviceSU3* __restrict__ pGauge, SCOORD uiT, BYTE byFieldId);
 #endif
     CCString GetInfos(const CCString& sTab) const override;
+    UBOOL IsCoulomb() const override { return TRUE; }
 
     UINT m_pHDecomp[6];
     UINT* m_pDDecomp;
 
     Real m_fOmega;
+
+    //probability of g -> g^2 in stochastic overrelaxation, 0 for off
+    Real m_fStochastic;
     UINT m_iCheckErrorStep;
     deviceSU3* m_pG;
     Real* m_pA11;
@@ -523,51 +523,100 @@ _kernelBakeMomentumTable(
 #endif
 }
 
+/**
+ * The FFT buffer is [site][4]: (Gamma11 + i Gamma22), Gamma12, Gamma13, Gamma23
+ * Gamma11 and Gamma22 are real, and the momentum table is real and even in p,
+ * so they are filtered together as one complex number.
+ * One 4-component FFT instead of 5 single-component FFTs.
+ */
 #if !_CLG_DOUBLEFLOAT
 __global__ void _CLG_LAUNCH_BOUND
-_kernelFFTRtoC(const DOUBLE* __restrict__ realBuffer, cuDoubleComplex* complexBuffer)
+_kernelFFTPack(
+    const DOUBLE* __restrict__ pGamma11,
+    const cuDoubleComplex* __restrict__ pGamma12,
+    const cuDoubleComplex* __restrict__ pGamma13,
+    const DOUBLE* __restrict__ pGamma22,
+    const cuDoubleComplex* __restrict__ pGamma23,
+    cuDoubleComplex* pFFTBuffer)
 {
     intokernal;
-    complexBuffer[uiSiteIndex] = make_cuDoubleComplex(realBuffer[uiSiteIndex], 0.0);
+    pFFTBuffer[4 * uiSiteIndex] = make_cuDoubleComplex(pGamma11[uiSiteIndex], pGamma22[uiSiteIndex]);
+    pFFTBuffer[4 * uiSiteIndex + 1] = pGamma12[uiSiteIndex];
+    pFFTBuffer[4 * uiSiteIndex + 2] = pGamma13[uiSiteIndex];
+    pFFTBuffer[4 * uiSiteIndex + 3] = pGamma23[uiSiteIndex];
 }
 
 __global__ void _CLG_LAUNCH_BOUND
-_kernelFFTCtoR(const cuDoubleComplex* __restrict__ complexBuffer, DOUBLE* realBuffer)
+_kernelFFTUnpack(
+    const cuDoubleComplex* __restrict__ pFFTBuffer,
+    DOUBLE* pGamma11,
+    cuDoubleComplex* pGamma12,
+    cuDoubleComplex* pGamma13,
+    DOUBLE* pGamma22,
+    cuDoubleComplex* pGamma23)
 {
     intokernal;
-    realBuffer[uiSiteIndex] = complexBuffer[uiSiteIndex].x;
+    pGamma11[uiSiteIndex] = pFFTBuffer[4 * uiSiteIndex].x;
+    pGamma22[uiSiteIndex] = pFFTBuffer[4 * uiSiteIndex].y;
+    pGamma12[uiSiteIndex] = pFFTBuffer[4 * uiSiteIndex + 1];
+    pGamma13[uiSiteIndex] = pFFTBuffer[4 * uiSiteIndex + 2];
+    pGamma23[uiSiteIndex] = pFFTBuffer[4 * uiSiteIndex + 3];
 }
 
 __global__ void _CLG_LAUNCH_BOUND
 _kernelFFTScale(const DOUBLE* __restrict__ pP, cuDoubleComplex* fftRes)
 {
     intokernal;
-    fftRes[uiSiteIndex] = cuCmulf_cd(fftRes[uiSiteIndex], pP[uiSiteIndex]);
+    #pragma unroll
+    for (UINT i = 0; i < 4; ++i)
+    {
+        fftRes[4 * uiSiteIndex + i] = cuCmulf_cd(fftRes[4 * uiSiteIndex + i], pP[uiSiteIndex]);
+    }
 }
 
 #else
 __global__ void _CLG_LAUNCH_BOUND
-_kernelFFTRtoC(const Real* __restrict__ realBuffer, CLGComplex* complexBuffer)
+_kernelFFTPack(
+    const Real* __restrict__ pGamma11,
+    const CLGComplex* __restrict__ pGamma12,
+    const CLGComplex* __restrict__ pGamma13,
+    const Real* __restrict__ pGamma22,
+    const CLGComplex* __restrict__ pGamma23,
+    CLGComplex* pFFTBuffer)
 {
     intokernal;
-    complexBuffer[uiSiteIndex] = _make_cuComplex(realBuffer[uiSiteIndex], F(0.0));
+    pFFTBuffer[4 * uiSiteIndex] = _make_cuComplex(pGamma11[uiSiteIndex], pGamma22[uiSiteIndex]);
+    pFFTBuffer[4 * uiSiteIndex + 1] = pGamma12[uiSiteIndex];
+    pFFTBuffer[4 * uiSiteIndex + 2] = pGamma13[uiSiteIndex];
+    pFFTBuffer[4 * uiSiteIndex + 3] = pGamma23[uiSiteIndex];
 }
 
 __global__ void _CLG_LAUNCH_BOUND
-_kernelFFTCtoR(
-    const CLGComplex* __restrict__ complexBuffer, 
-    Real* realBuffer
-)
+_kernelFFTUnpack(
+    const CLGComplex* __restrict__ pFFTBuffer,
+    Real* pGamma11,
+    CLGComplex* pGamma12,
+    CLGComplex* pGamma13,
+    Real* pGamma22,
+    CLGComplex* pGamma23)
 {
     intokernal;
-    realBuffer[uiSiteIndex] = complexBuffer[uiSiteIndex].x;
+    pGamma11[uiSiteIndex] = pFFTBuffer[4 * uiSiteIndex].x;
+    pGamma22[uiSiteIndex] = pFFTBuffer[4 * uiSiteIndex].y;
+    pGamma12[uiSiteIndex] = pFFTBuffer[4 * uiSiteIndex + 1];
+    pGamma13[uiSiteIndex] = pFFTBuffer[4 * uiSiteIndex + 2];
+    pGamma23[uiSiteIndex] = pFFTBuffer[4 * uiSiteIndex + 3];
 }
 
 __global__ void _CLG_LAUNCH_BOUND
 _kernelFFTScale(const Real* __restrict__ pP, CLGComplex* fftRes)
 {
     intokernal;
-    fftRes[uiSiteIndex] = cuCmulf_cr(fftRes[uiSiteIndex], pP[uiSiteIndex]);
+    #pragma unroll
+    for (UINT i = 0; i < 4; ++i)
+    {
+        fftRes[4 * uiSiteIndex + i] = cuCmulf_cr(fftRes[4 * uiSiteIndex + i], pP[uiSiteIndex]);
+    }
 }
 #endif
 
@@ -615,12 +664,24 @@ void CGaugeFixingLandauCornell::Initial(class CLatticeData* pOwner, const CParam
     }
     m_iShowErrorStep = iValue;
 
+    iValue = static_cast<INT>(m_iCheckErrorStep);
+    if (!params.FetchValueINT(_T("CheckErrorStep"), iValue))
+    {
+        appParanoiac(_T("CGaugeFixingLandauCornell: CheckErrorStep not set, set to 10 by defualt."));
+    }
+    m_iCheckErrorStep = iValue > 0 ? static_cast<UINT>(iValue) : 1;
+
     iValue = 1;
     if (!params.FetchValueINT(_T("FFT"), iValue))
     {
         appGeneral(_T("CGaugeFixingLandauCornell: FFT not set, set to 1 by defualt."));
     }
     m_bFA = (0 != iValue);
+    m_lstDims.RemoveAll();
+    m_lstDims.AddItem(_HC_Lx);
+    m_lstDims.AddItem(_HC_Ly);
+    m_lstDims.AddItem(_HC_Lz);
+    m_lstDims.AddItem(_HC_Lt);
 
     //========== Initial Buffers ==============
 #if !_CLG_DOUBLEFLOAT
@@ -653,10 +714,10 @@ void CGaugeFixingLandauCornell::Initial(class CLatticeData* pOwner, const CParam
     {
 #if !_CLG_DOUBLEFLOAT
         checkCudaErrors(cudaMalloc((void**)&m_pMomentumTable, _HC_Volume * sizeof(DOUBLE)));
-        checkCudaErrors(cudaMalloc((void**)&m_pTempFFTBuffer, _HC_Volume * sizeof(cuDoubleComplex)));
+        checkCudaErrors(cudaMalloc((void**)&m_pTempFFTBuffer, _HC_Volume * 4 * sizeof(cuDoubleComplex)));
 #else
         checkCudaErrors(cudaMalloc((void**)& m_pMomentumTable, _HC_Volume * sizeof(Real)));
-        checkCudaErrors(cudaMalloc((void**)& m_pTempFFTBuffer, _HC_Volume * sizeof(CLGComplex)));
+        checkCudaErrors(cudaMalloc((void**)& m_pTempFFTBuffer, _HC_Volume * 4 * sizeof(CLGComplex)));
 #endif
 
         preparethread;
@@ -673,6 +734,8 @@ void CGaugeFixingLandauCornell::GaugeFixing(CFieldGauge* pResGauge)
     }
     CFieldGaugeSU3* pGaugeSU3 = dynamic_cast<CFieldGaugeSU3*>(pResGauge);
     deviceSU3* pDeviceBufferPointer = pGaugeSU3->m_pDeviceData;
+    //the links are transformed in place, there are several returns when converged
+    pResGauge->IncreaseVersion();
 
     preparethread;
     m_iIterate = 0;
@@ -720,78 +783,41 @@ void CGaugeFixingLandauCornell::GaugeFixing(CFieldGauge* pResGauge)
             m_pA23);
 
         //======= 2. Calculate Theta    =========
-        _kernelCalculateTrAGradientSq << <block, threads >> > (
-            _D_RealThreadBuffer,
-            m_pGamma11,
-            m_pGamma12,
-            m_pGamma13,
-            m_pGamma22,
-            m_pGamma23);
-        fTheta = appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer) / (3 * _HC_Volume);
-        if (m_iShowErrorStep > 0 && 0 == m_iIterate % m_iShowErrorStep)
+        if (0 == m_iIterate % m_iCheckErrorStep)
         {
-            appParanoiac(_T("Theta%d = %2.12f\n"), m_iIterate, fTheta);
-        }
+            _kernelCalculateTrAGradientSq << <block, threads >> > (
+                _D_RealThreadBuffer,
+                m_pGamma11,
+                m_pGamma12,
+                m_pGamma13,
+                m_pGamma22,
+                m_pGamma23);
+            fTheta = appGetCudaHelper()->ThreadBufferSum(_D_RealThreadBuffer) / (3 * _HC_Volume);
+            if (m_iShowErrorStep > 0 && 0 == m_iIterate % m_iShowErrorStep)
+            {
+                appParanoiac(_T("Theta%d = %2.12f\n"), m_iIterate, fTheta);
+            }
         
-        if (fTheta < m_fAccuracy)
-        {
-            return;
+            if (fTheta < m_fAccuracy)
+            {
+                return;
+            }
         }
 
         //======= 3. FFT                =========
         if (m_bFA)
         {
+            _kernelFFTPack << <block, threads >> > (m_pGamma11, m_pGamma12, m_pGamma13, m_pGamma22, m_pGamma23, m_pTempFFTBuffer);
 #if !_CLG_DOUBLEFLOAT
-
-            CCLGFFTHelper::FFT4DDouble(m_pGamma12, TRUE);
-            _kernelFFTScale << <block, threads >> > (m_pMomentumTable, m_pGamma12);
-            CCLGFFTHelper::FFT4DDouble(m_pGamma12, FALSE);
-
-            CCLGFFTHelper::FFT4DDouble(m_pGamma13, TRUE);
-            _kernelFFTScale << <block, threads >> > (m_pMomentumTable, m_pGamma13);
-            CCLGFFTHelper::FFT4DDouble(m_pGamma13, FALSE);
-
-            CCLGFFTHelper::FFT4DDouble(m_pGamma23, TRUE);
-            _kernelFFTScale << <block, threads >> > (m_pMomentumTable, m_pGamma23);
-            CCLGFFTHelper::FFT4DDouble(m_pGamma23, FALSE);
-
-            _kernelFFTRtoC << <block, threads >> > (m_pGamma11, m_pTempFFTBuffer);
-            CCLGFFTHelper::FFT4DDouble(m_pTempFFTBuffer, TRUE);
-            _kernelFFTScale << <block, threads >> > (m_pMomentumTable, m_pTempFFTBuffer);
-            CCLGFFTHelper::FFT4DDouble(m_pTempFFTBuffer, FALSE);
-            _kernelFFTCtoR << <block, threads >> > (m_pTempFFTBuffer, m_pGamma11);
-
-            _kernelFFTRtoC << <block, threads >> > (m_pGamma22, m_pTempFFTBuffer);
-            CCLGFFTHelper::FFT4DDouble(m_pTempFFTBuffer, TRUE);
+            CCLGFFTHelper::FFT4DWithXYZWComponentsDouble(m_pTempFFTBuffer, m_lstDims, 4, TRUE);
             _kernelFFTScale << <block, threads >> > (m_pMomentumTable, m_pTempFFTBuffer);
-            CCLGFFTHelper::FFT4DDouble(m_pTempFFTBuffer, FALSE);
-            _kernelFFTCtoR << <block, threads >> > (m_pTempFFTBuffer, m_pGamma22);
-
+            CCLGFFTHelper::FFT4DWithXYZWComponentsDouble(m_pTempFFTBuffer, m_lstDims, 4, FALSE);
 #else
-            CCLGFFTHelper::FFT4D(m_pGamma12, TRUE);
-            _kernelFFTScale << <block, threads >> > (m_pMomentumTable, m_pGamma12);
-            CCLGFFTHelper::FFT4D(m_pGamma12, FALSE);
-
-            CCLGFFTHelper::FFT4D(m_pGamma13, TRUE);
-            _kernelFFTScale << <block, threads >> > (m_pMomentumTable, m_pGamma13);
-            CCLGFFTHelper::FFT4D(m_pGamma13, FALSE);
-
-            CCLGFFTHelper::FFT4D(m_pGamma23, TRUE);
-            _kernelFFTScale << <block, threads >> > (m_pMomentumTable, m_pGamma23);
-            CCLGFFTHelper::FFT4D(m_pGamma23, FALSE);
-
-            _kernelFFTRtoC << <block, threads >> > (m_pGamma11, m_pTempFFTBuffer);
-            CCLGFFTHelper::FFT4D(m_pTempFFTBuffer, TRUE);
-            _kernelFFTScale << <block, threads >> > (m_pMomentumTable, m_pTempFFTBuffer);
-            CCLGFFTHelper::FFT4D(m_pTempFFTBuffer, FALSE);
-            _kernelFFTCtoR << <block, threads >> > (m_pTempFFTBuffer, m_pGamma11);
-
-            _kernelFFTRtoC << <block, threads >> > (m_pGamma22, m_pTempFFTBuffer);
-            CCLGFFTHelper::FFT4D(m_pTempFFTBuffer, TRUE);
+            CCLGFFTHelper::FFT4DWithXYZWComponents(m_pTempFFTBuffer, m_lstDims, 4, TRUE);
             _kernelFFTScale << <block, threads >> > (m_pMomentumTable, m_pTempFFTBuffer);
-            CCLGFFTHelper::FFT4D(m_pTempFFTBuffer, FALSE);
-            _kernelFFTCtoR << <block, threads >> > (m_pTempFFTBuffer, m_pGamma22);
+            CCLGFFTHelper::FFT4DWithXYZWComponents(m_pTempFFTBuffer, m_lstDims, 4, FALSE);
 #endif
+            _kernelFFTUnpack << <block, threads >> > (m_pTempFFTBuffer, m_pGamma11, m_pGamma12, m_pGamma13, m_pGamma22, m_pGamma23);
         }
 
         //======= 4. Gauge Transform    =========
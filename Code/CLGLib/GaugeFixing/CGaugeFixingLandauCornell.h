@@ -37,6 +37,7 @@ public:
     , m_pMomentumTable(NULL)
     , m_pTempFFTBuffer(NULL)
     , m_bFA(TRUE)
+    , m_iCheckErrorStep(10)
     {
     }
 
@@ -82,6 +83,7 @@ public:
     cuDoubleComplex* m_pGamma23;
     deviceSU3* m_pG;
     DOUBLE* m_pMomentumTable;
+    //[site][4]: (Gamma11 + i Gamma22), Gamma12, Gamma13, Gamma23
     cuDoubleComplex* m_pTempFFTBuffer;
 #else
     Real m_fAlpha;
@@ -99,11 +101,16 @@ public:
     CLGComplex* m_pGamma23;
     deviceSU3* m_pG;
     Real* m_pMomentumTable;
+    //[site][4]: (Gamma11 + i Gamma22), Gamma12, Gamma13, Gamma23
     CLGComplex* m_pTempFFTBuffer;
 #endif
 
     //FFT accelaration
     UBOOL m_bFA;
+    TArray<INT> m_lstDims;
+
+    //Theta is reduced (with a device-host sync) every m_iCheckErrorStep iterations
+    UINT m_iCheckErrorStep;
 };
 
 __END_NAMESPACE
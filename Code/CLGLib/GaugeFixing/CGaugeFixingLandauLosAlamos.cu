@@ -18,6 +18,7 @@ _kernelCalculateGAL(
     BYTE byFieldId,
     const deviceSU3* __restrict__ pU,
     Real fOmega,
+    Real fStochastic,
     deviceSU3* pG)
 {
     intokernalInt4;
@@ -47,9 +48,7 @@ _kernelCalculateGAL(
         pG[uiSiteIndex].AddDagger(_deviceGetGaugeBCSU3DirOneSIndex(pU, site_m_mu));
     }
 
-    pG[uiSiteIndex].MulReal(fOmega);
-    pG[uiSiteIndex].Add(su3Id.MulRealC(F(1.0) - fOmega));
-    pG[uiSiteIndex].CabbiboMarinariProj();
+    _deviceGaugeFixingRelaxation(pG[uiSiteIndex], fOmega, fStochastic, uiSiteIndex);
 }
 
 __global__ void _CLG_LAUNCH_BOUND
@@ -57,6 +56,7 @@ _kernelCalculateGOdd(
     BYTE byFieldId,
     const deviceSU3* __restrict__ pU,
     Real fOmega,
+    Real fStochastic,
     deviceSU3* pG)
 {
     intokernalInt4;
@@ -86,9 +86,7 @@ _kernelCalculateGOdd(
         pG[uiSiteIndex].AddDagger(_deviceGetGaugeBCSU3DirOneSIndex(pU, site_m_mu));
     }
 
-    pG[uiSiteIndex].MulReal(fOmega);
-    pG[uiSiteIndex].Add(su3Id.MulRealC(F(1.0) - fOmega));
-    pG[uiSiteIndex].CabbiboMarinariProj();
+    _deviceGaugeFixingRelaxation(pG[uiSiteIndex], fOmega, fStochastic, uiSiteIndex);
 }
 
 __global__ void _CLG_LAUNCH_BOUND
@@ -96,6 +94,7 @@ _kernelCalculateGEven(
     BYTE byFieldId,
     const deviceSU3* __restrict__ pU,
     Real fOmega,
+    Real fStochastic,
     deviceSU3* pG)
 {
     intokernalInt4;
@@ -125,9 +124,7 @@ _kernelCalculateGEven(
         pG[uiSiteIndex].AddDagger(_deviceGetGaugeBCSU3DirOneSIndex(pU, site_m_mu));
     }
 
-    pG[uiSiteIndex].MulReal(fOmega);
-    pG[uiSiteIndex].Add(su3Id.MulRealC(F(1.0) - fOmega));
-    pG[uiSiteIndex].CabbiboMarinariProj();
+    _deviceGaugeFixingRelaxation(pG[uiSiteIndex], fOmega, fStochastic, uiSiteIndex);
 }
 
 /**
@@ -410,6 +407,11 @@ void CGaugeFixingLandauLosAlamos::Initial(class CLatticeData* pOwner, const CPar
         appGeneral(_T("CGaugeFixingLandauLosAlamos: Omega not set, set to 1.0 by defualt."));
     }
 
+    if (!params.FetchValueReal(_T("StochasticProbability"), m_fStochastic))
+    {
+        appGeneral(_T("CGaugeFixingLandauLosAlamos: StochasticProbability not set, set to 0.0 by defualt."));
+    }
+
     if (!params.FetchValueReal(_T("Accuracy"), m_fAccuracy))
     {
         appGeneral(_T("CGaugeFixingLandauCornell: Accuracy not set, set to 0.00000000001 by defualt."));
@@ -506,6 +508,8 @@ void CGaugeFixingLandauLosAlamos::GaugeFixing(CFieldGauge* pResGauge)
     }
     CFieldGaugeSU3* pGaugeSU3 = dynamic_cast<CFieldGaugeSU3*>(pResGauge);
     deviceSU3* pDeviceBufferPointer = pGaugeSU3->m_pDeviceData;
+    //the links are transformed in place, there are several returns when converged
+    pResGauge->IncreaseVersion();
 
     preparethread;
     m_iIterate = 0;
@@ -529,9 +533,13 @@ void CGaugeFixingLandauLosAlamos::GaugeFixing(CFieldGauge* pResGauge)
             }
         }
 
-        _kernelCalculateGOdd << <block, threads >> > (pResGauge->m_byFieldId, pDeviceBufferPointer, m_fOmega, m_pG);
+        if (m_fStochastic > F(0.0))
+        {
+            appGetLattice()->m_pRandom->NextLaunch();
+        }
+        _kernelCalculateGOdd << <block, threads >> > (pResGauge->m_byFieldId, pDeviceBufferPointer, m_fOmega, m_fStochastic, m_pG);
         _kernelGaugeTransformOdd << <block, threads >> > (pResGauge->m_byFieldId, m_pG, pDeviceBufferPointer);
-        _kernelCalculateGEven << <block, threads >> > (pResGauge->m_byFieldId, pDeviceBufferPointer, m_fOmega, m_pG);
+        _kernelCalculateGEven << <block, threads >> > (pResGauge->m_byFieldId, pDeviceBufferPointer, m_fOmega, m_fStochastic, m_pG);
         _kernelGaugeTransformEven << <block, threads >> > (pResGauge->m_byFieldId, m_pG, pDeviceBufferPointer);
 
         //_kernelCalculateGAL << <block, threads >> > (pDeviceBufferPointer, m_fOmega, m_pG);
@@ -548,6 +556,7 @@ CCString CGaugeFixingLandauLosAlamos::GetInfos(const CCString& tab) const
     CCString sRet;
     sRet = sRet + tab + _T("Name : CGaugeFixingLandauLosAlamos\n");
     sRet = sRet + tab + _T("Omega : ") + appFloatToString(m_fOmega) + _T("\n");
+    sRet = sRet + tab + _T("StochasticProbability : ") + appFloatToString(m_fStochastic) + _T("\n");
     return sRet;
 }
 
@@ -25,6 +25,7 @@ public:
     CGaugeFixingLandauLosAlamos()
     : CGaugeFixing()
     , m_fOmega(F(1.0))
+    , m_fStochastic(F(0.0))
     , m_iCheckErrorStep(1000)
     , m_pG(NULL)
     , m_pA11(NULL)
@@ -55,6 +56,9 @@ public:
     CCString GetInfos(const CCString& sTab) const override;
 
     Real m_fOmega;
+
+    //probability of g -> g^2 in stochastic overrelaxation, 0 for off
+    Real m_fStochastic;
     UINT m_iCheckErrorStep;
     deviceSU3* m_pG;
     Real* m_pA11;
@@ -13,21 +13,25 @@ __BEGIN_NAMESPACE
 
 #pragma region kernels
 
+/**
+ * uiT < 0 for all sites, otherwise g = 1 for sites not on the time slice uiT
+ */
 __global__ void _CLG_LAUNCH_BOUND
-_kernelRandomGauge(deviceSU3* pGx)
+_kernelRandomGauge(deviceSU3* pGx, SCOORD uiT)
 {
     intokernalInt4;
 
     const UINT uiBigIdx = __idx->_deviceGetBigIndex(sSite4);
     const SIndex site = __idx->m_pDeviceIndexPositionToSIndex[1][uiBigIdx];
 
-    if (site.IsDirichlet())
+    if (site.IsDirichlet() || (uiT >= 0 && sSite4.w != uiT))
     {
         pGx[uiSiteIndex] = deviceSU3::makeSU3Id();
     }
     else
     {
-        pGx[uiSiteIndex] = deviceSU3::makeSU3Random(_deviceGetFatIndex(uiSiteIndex, 0));
+        SRandomDraw uiDraw;
+        pGx[uiSiteIndex] = deviceSU3::makeSU3Random(_deviceGetFatIndex(uiSiteIndex, 0), uiDraw);
     }
 }
 
@@ -139,8 +143,27 @@ void CGaugeFixingRandom::GaugeFixing(CFieldGauge* pResGauge)
     CFieldGaugeSU3* pGaugeSU3 = dynamic_cast<CFieldGaugeSU3*>(pResGauge);
 
     preparethread;
-    _kernelRandomGauge << <block, threads >> > (m_pG);
+    appGetLattice()->m_pRandom->NextLaunch();
+    _kernelRandomGauge << <block, threads >> > (m_pG, -1);
+    _kernelGaugeTransformRandom << <block, threads >> > (m_pG, pGaugeSU3->m_pDeviceData);
+    pResGauge->IncreaseVersion();
+}
+
+void CGaugeFixingRandom::GaugeFixingTimeSlice(CFieldGauge* pResGauge, SCOORD uiT)
+{
+    if (NULL == pResGauge || EFT_GaugeSU3 != pResGauge->GetFieldType())
+    {
+        appCrucial(_T("CGaugeFixingRandom only implemented with gauge SU3!\n"));
+        return;
+    }
+    CFieldGaugeSU3* pGaugeSU3 = dynamic_cast<CFieldGaugeSU3*>(pResGauge);
+
+    //g = 1 away from uiT, so only the spatial links on uiT and the temporal links into and out of uiT are changed
+    preparethread;
+    appGetLattice()->m_pRandom->NextLaunch();
+    _kernelRandomGauge << <block, threads >> > (m_pG, uiT);
     _kernelGaugeTransformRandom << <block, threads >> > (m_pG, pGaugeSU3->m_pDeviceData);
+    pResGauge->IncreaseVersion();
 }
 
 void CGaugeFixingRandom::AlsoFixingFermion(CFieldFermion* pFermion) const
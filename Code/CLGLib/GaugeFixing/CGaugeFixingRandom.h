@@ -35,6 +35,7 @@ public:
 
     void Initial(class CLatticeData* pOwner, const CParameters& params) override;
     void GaugeFixing(CFieldGauge* pResGauge) override;
+    void GaugeFixingTimeSlice(CFieldGauge* pResGauge, SCOORD uiT) override;
 #if !_CLG_DOUBLEFLOAT
     DOUBLE CheckRes(const CFieldGauge* ) override { return 0.0; }
 #else
@@ -80,8 +80,8 @@ _kernelXY_To_R_C(
     SSmallInt4 sSite4;
     sSite4.z = sCenter.z;
     sSite4.w = sCenter.w;
-    sSite4.x = static_cast<SBYTE>(iX);
-    sSite4.y = static_cast<SBYTE>(iY);
+    sSite4.x = static_cast<SCOORD>(iX);
+    sSite4.y = static_cast<SCOORD>(iY);
     if (iC <= uiMax && !__idx->_deviceGetMappingIndex(sSite4, byFieldId).IsDirichlet())
     {
         if (NULL != pCount)
@@ -134,8 +134,8 @@ _kernelXY_To_R_R(
     SSmallInt4 sSite4;
     sSite4.z = sCenter.z;
     sSite4.w = sCenter.w;
-    sSite4.x = static_cast<SBYTE>(iX);
-    sSite4.y = static_cast<SBYTE>(iY);
+    sSite4.x = static_cast<SCOORD>(iX);
+    sSite4.y = static_cast<SCOORD>(iY);
     if (iC <= uiMax && !__idx->_deviceGetMappingIndex(sSite4, byFieldId).IsDirichlet())
     {
         if (NULL != pCount)
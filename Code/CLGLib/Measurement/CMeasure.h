@@ -13,6 +13,111 @@
 
 __BEGIN_NAMESPACE
 
+/**
+* Used by checkpoint, to save or load the accumulated data of the measurements.
+* The same SerializeAccumulators is used for both directions.
+*/
+class CLGAPI CMeasureArchive
+{
+public:
+    //for saving
+    CMeasureArchive(TArray<BYTE>* pBuffer)
+        : m_pBuffer(pBuffer)
+        , m_pData(NULL)
+        , m_uiSize(0)
+        , m_uiOffset(0)
+        , m_bOk(TRUE)
+    {
+    }
+
+    //for loading
+    CMeasureArchive(const BYTE* byData, UINT uiSize)
+        : m_pBuffer(NULL)
+        , m_pData(byData)
+        , m_uiSize(uiSize)
+        , m_uiOffset(0)
+        , m_bOk(TRUE)
+    {
+    }
+
+    UBOOL IsSaving() const { return NULL != m_pBuffer; }
+    UBOOL IsOk() const { return m_bOk; }
+    UINT GetOffset() const { return m_uiOffset; }
+
+    void Serialize(void* pData, UINT uiSize)
+    {
+        if (!m_bOk || 0 == uiSize)
+        {
+            return;
+        }
+        if (IsSaving())
+        {
+            const INT iStart = m_pBuffer->AddSize(static_cast<INT>(uiSize));
+            memcpy(m_pBuffer->GetData() + iStart, pData, uiSize);
+            return;
+        }
+        if (m_uiOffset + uiSize > m_uiSize)
+        {
+            m_bOk = FALSE;
+            return;
+        }
+        memcpy(pData, m_pData + m_uiOffset, uiSize);
+        m_uiOffset += uiSize;
+    }
+
+    template<class T>
+    void Serialize(T& value)
+    {
+        Serialize(&value, static_cast<UINT>(sizeof(T)));
+    }
+
+    template<class T>
+    void Serialize(TArray<T>& lst)
+    {
+        UINT uiCount = static_cast<UINT>(lst.Num());
+        Serialize(uiCount);
+        if (!IsSaving())
+        {
+            if (!m_bOk || m_uiOffset + uiCount * static_cast<UINT>(sizeof(T)) > m_uiSize)
+            {
+                m_bOk = FALSE;
+                return;
+            }
+            lst.SetSize(static_cast<INT>(uiCount));
+        }
+        Serialize(lst.GetData(), uiCount * static_cast<UINT>(sizeof(T)));
+    }
+
+    template<class T>
+    void Serialize(TArray<TArray<T>>& lst)
+    {
+        UINT uiCount = static_cast<UINT>(lst.Num());
+        Serialize(uiCount);
+        if (!IsSaving())
+        {
+            //each element has at least the count
+            if (!m_bOk || m_uiOffset + uiCount * static_cast<UINT>(sizeof(UINT)) > m_uiSize)
+            {
+                m_bOk = FALSE;
+                return;
+            }
+            lst.SetSize(static_cast<INT>(uiCount));
+        }
+        for (UINT i = 0; i < uiCount && m_bOk; ++i)
+        {
+            Serialize(lst[i]);
+        }
+    }
+
+protected:
+
+    TArray<BYTE>* m_pBuffer;
+    const BYTE* m_pData;
+    UINT m_uiSize;
+    UINT m_uiOffset;
+    UBOOL m_bOk;
+};
+
 class CLGAPI CMeasure : public CBase
 {
 public:
@@ -67,11 +172,23 @@ public:
     virtual void Report() = 0;
     virtual void Reset() = 0;
 
+    /**
+    * Used by checkpoint, save or load everything cleared by Reset, so that the average after resuming
+    * includes the configurations measured before the checkpoint.
+    * The default is for the measures without accumulated data.
+    */
+    virtual void SerializeAccumulators(CMeasureArchive& ar)
+    {
+        ar.Serialize(m_fLastRealResult);
+        ar.Serialize(m_cLastComplexResult);
+    }
+
     virtual UBOOL IsGaugeMeasurement() const = 0;
     virtual UBOOL IsSourceScanning() const = 0;
     virtual UBOOL IsZ4Source() const { return FALSE; }
     virtual UBOOL NeedGaugeSmearing() const { return m_bNeedSmearing; }
 
+    BYTE GetId() const { return m_byId; }
     BYTE GetFieldId() const { return m_byFieldId; }
 
 #if !_CLG_DOUBLEFLOAT
@@ -402,7 +402,7 @@ void CMeasureAMomentumJF::OnConfigurationAccepted(const CFieldGauge* pGauge, con
 
     //    deviceWilsonVectorSU3* pDevicePtr[12];
     //    SSmallInt4 sourceSite;
-    //    sourceSite.x = static_cast<SBYTE>(i);
+    //    sourceSite.x = static_cast<SCOORD>(i);
     //    sourceSite.y = CCommonData::m_sCenter.y;
     //    sourceSite.z = CCommonData::m_sCenter.z;
     //    sourceSite.w = CCommonData::m_sCenter.w;
@@ -584,7 +584,7 @@ void CMeasureAMomentumJF::SourceSanning(const class CFieldGauge* pGauge, const c
 
     checkCudaErrors(cudaFree(ppDevicePtr));
 
-    if (sourceSite.x == static_cast<SBYTE>(_HC_Lx) - 1)
+    if (sourceSite.x == static_cast<SCOORD>(_HC_Lx) - 1)
     {
         //all sites calculated
         ++m_uiConfigurationCount;
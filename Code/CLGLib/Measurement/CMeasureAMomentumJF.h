@@ -43,6 +43,11 @@ public:
     void Average(UINT uiConfigurationCount) override;
     void Report() override;
     void Reset() override;
+    void SerializeAccumulators(CMeasureArchive& ar) override
+    {
+        ar.Serialize(m_uiConfigurationCount);
+        ar.Serialize(m_lstAllRes);
+    }
 
     UBOOL IsGaugeMeasurement() const override { return FALSE; }
     UBOOL IsSourceScanning() const override { return TRUE; }
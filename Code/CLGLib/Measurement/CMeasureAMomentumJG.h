@@ -84,6 +84,39 @@ public:
     void Average(UINT uiConfigurationCount) override;
     void Report() override;
     void Reset() override;
+    void SerializeAccumulators(CMeasureArchive& ar) override
+    {
+        ar.Serialize(m_uiConfigurationCount);
+        ar.Serialize(m_lstRes);
+        ar.Serialize(m_lstResJGS);
+        ar.Serialize(m_lstResJGChen);
+        ar.Serialize(m_lstResJGChenApprox);
+        ar.Serialize(m_lstResJGChenApprox2);
+        ar.Serialize(m_lstResJGSurf);
+        ar.Serialize(m_lstResJGPot);
+        ar.Serialize(m_lstR);
+        ar.Serialize(m_lstJGAll);
+        ar.Serialize(m_lstJGInner);
+        ar.Serialize(m_lstJG);
+        ar.Serialize(m_lstJGSAll);
+        ar.Serialize(m_lstJGSInner);
+        ar.Serialize(m_lstJGS);
+        ar.Serialize(m_lstJGChenAll);
+        ar.Serialize(m_lstJGChenInner);
+        ar.Serialize(m_lstJGChen);
+        ar.Serialize(m_lstJGChenApproxAll);
+        ar.Serialize(m_lstJGChenApproxInner);
+        ar.Serialize(m_lstJGChenApprox);
+        ar.Serialize(m_lstJGChenApprox2All);
+        ar.Serialize(m_lstJGChenApprox2Inner);
+        ar.Serialize(m_lstJGChenApprox2);
+        ar.Serialize(m_lstJGSurfAll);
+        ar.Serialize(m_lstJGSurfInner);
+        ar.Serialize(m_lstJGSurf);
+        ar.Serialize(m_lstJGPotAll);
+        ar.Serialize(m_lstJGPotInner);
+        ar.Serialize(m_lstJGPot);
+    }
 
     UBOOL IsGaugeMeasurement() const override { return TRUE; }
     UBOOL IsSourceScanning() const override { return FALSE; }
@@ -71,6 +71,26 @@ public:
     void Average(UINT uiConfigurationCount) override;
     void Report() override;
     void Reset() override;
+    void SerializeAccumulators(CMeasureArchive& ar) override
+    {
+        ar.Serialize(m_uiConfigurationCount);
+        ar.Serialize(m_lstR);
+        ar.Serialize(m_lstJL);
+        ar.Serialize(m_lstJS);
+        ar.Serialize(m_lstJLPure);
+        ar.Serialize(m_lstJLJM);
+        ar.Serialize(m_lstJPot);
+        ar.Serialize(m_lstJLAll);
+        ar.Serialize(m_lstJLInner);
+        ar.Serialize(m_lstJSAll);
+        ar.Serialize(m_lstJSInner);
+        ar.Serialize(m_lstJLPureAll);
+        ar.Serialize(m_lstJLPureInner);
+        ar.Serialize(m_lstJLJMAll);
+        ar.Serialize(m_lstJLJMInner);
+        ar.Serialize(m_lstJPotAll);
+        ar.Serialize(m_lstJPotInner);
+    }
 
     UBOOL IsGaugeMeasurement() const override { return FALSE; }
     UBOOL IsZ4Source() const override  { return TRUE; }
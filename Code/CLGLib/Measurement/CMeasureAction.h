@@ -27,6 +27,11 @@ public:
     void Average(UINT uiConfigurationCount) override;
     void Report() override;
     void Reset() override;
+    void SerializeAccumulators(CMeasureArchive& ar) override
+    {
+        ar.Serialize(m_lstData);
+        ar.Serialize(m_fLastRealResult);
+    }
 
     UBOOL IsGaugeMeasurement() const override { return TRUE; }
     UBOOL IsSourceScanning() const override { return FALSE; }
@@ -58,6 +58,18 @@ public:
     void Average(UINT uiConfigurationCount) override;
     void Report() override;
     void Reset() override;
+    void SerializeAccumulators(CMeasureArchive& ar) override
+    {
+        ar.Serialize(m_uiConfigurationCount);
+        ar.Serialize(m_lstR);
+        for (UINT i = 0; i < EAngularMeasureMax; ++i)
+        {
+            ar.Serialize(m_lstCondAll[i]);
+            ar.Serialize(m_lstCondIn[i]);
+            ar.Serialize(m_lstCond[i]);
+            ar.Serialize(m_lstCondZSlice[i]);
+        }
+    }
 
     UBOOL IsGaugeMeasurement() const override { return FALSE; }
     UBOOL IsZ4Source() const override { return TRUE; }
@@ -169,9 +169,9 @@ _kernelBerryCurvatureU1(
 {
     SSmallInt4 sSite4; 
     const UINT _ixy = (threadIdx.x + blockIdx.x * blockDim.x); 
-    sSite4.x = static_cast<SBYTE> (_ixy / _DC_Ly); 
-    sSite4.y = static_cast<SBYTE> (_ixy % _DC_Ly); 
-    sSite4.z = static_cast<SBYTE>(threadIdx.y + blockIdx.y * blockDim.y); 
+    sSite4.x = static_cast<SCOORD> (_ixy / _DC_Ly); 
+    sSite4.y = static_cast<SCOORD> (_ixy % _DC_Ly); 
+    sSite4.z = static_cast<SCOORD>(threadIdx.y + blockIdx.y * blockDim.y); 
     sSite4.w = byT;
     const UINT uiSiteSpatial = _ixy * _DC_Lz + sSite4.z;
 
@@ -204,9 +204,9 @@ _kernelBerryCurvatureU1XY(
 {
     SSmallInt4 sSite4;
     const UINT _ixy = (threadIdx.x + blockIdx.x * blockDim.x);
-    sSite4.x = static_cast<SBYTE> (_ixy / _DC_Ly);
-    sSite4.y = static_cast<SBYTE> (_ixy % _DC_Ly);
-    sSite4.z = static_cast<SBYTE>(threadIdx.y + blockIdx.y * blockDim.y);
+    sSite4.x = static_cast<SCOORD> (_ixy / _DC_Ly);
+    sSite4.y = static_cast<SCOORD> (_ixy % _DC_Ly);
+    sSite4.z = static_cast<SCOORD>(threadIdx.y + blockIdx.y * blockDim.y);
     sSite4.w = byT;
     const UINT uiSiteSpatial = _ixy * _DC_Lz + sSite4.z;
 
@@ -228,9 +228,9 @@ _kernelBerryCurvatureU1ZT(
 {
     SSmallInt4 sSite4;
     const UINT _ixy = (threadIdx.x + blockIdx.x * blockDim.x);
-    sSite4.x = static_cast<SBYTE> (_ixy / _DC_Ly);
-    sSite4.y = static_cast<SBYTE> (_ixy % _DC_Ly);
-    sSite4.z = static_cast<SBYTE>(threadIdx.y + blockIdx.y * blockDim.y);
+    sSite4.x = static_cast<SCOORD> (_ixy / _DC_Ly);
+    sSite4.y = static_cast<SCOORD> (_ixy % _DC_Ly);
+    sSite4.z = static_cast<SCOORD>(threadIdx.y + blockIdx.y * blockDim.y);
     sSite4.w = byT;
     const UINT uiSiteSpatial = _ixy * _DC_Lz + sSite4.z;
 
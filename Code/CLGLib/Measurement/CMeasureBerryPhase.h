@@ -41,6 +41,13 @@ public:
     void Average(UINT uiConfigurationCount) override;
     void Report() override;
     void Reset() override;
+    void SerializeAccumulators(CMeasureArchive& ar) override
+    {
+        ar.Serialize(m_uiConfigurationCount);
+        ar.Serialize(m_lstData);
+        ar.Serialize(m_lstDataXY);
+        ar.Serialize(m_lstDataZT);
+    }
 
     UBOOL IsGaugeMeasurement() const override { return TRUE; }
     UBOOL IsSourceScanning() const override { return FALSE; }
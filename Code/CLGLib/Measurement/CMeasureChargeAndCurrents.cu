@@ -252,7 +252,7 @@ void CMeasureChargeAndCurrents::SourceSanning(const class CFieldGauge* pGauge, c
 
     checkCudaErrors(cudaFree(ppDevicePtr));
 
-    if (sourceSite.x == static_cast<SBYTE>(_HC_Lx) - 1)
+    if (sourceSite.x == static_cast<SCOORD>(_HC_Lx) - 1)
     {
         //all sites calculated
         ++m_uiConfigurationCount;
@@ -138,8 +138,8 @@ _kernelChiralCondensateMeasureDist(
     SSmallInt4 sSite4;
     sSite4.z = sCenter.z;
     sSite4.w = sCenter.w;
-    sSite4.x = static_cast<SBYTE>(uiX);
-    sSite4.y = static_cast<SBYTE>(uiY);
+    sSite4.x = static_cast<SCOORD>(uiX);
+    sSite4.y = static_cast<SCOORD>(uiY);
     if (uiC <= uiMax && !__idx->_deviceGetMappingIndex(sSite4, byFieldId).IsDirichlet())
     {
         if (bCalcR)
@@ -27,6 +27,12 @@ public:
     void Average(UINT uiConfigurationCount) override;
     void Report() override;
     void Reset() override;
+    void SerializeAccumulators(CMeasureArchive& ar) override
+    {
+        ar.Serialize(m_uiResoultCount);
+        ar.Serialize(m_lstResults);
+        ar.Serialize(m_lstResultsLastConf);
+    }
 
     UBOOL IsGaugeMeasurement() const override { return TRUE; }
     UBOOL IsSourceScanning() const override { return FALSE; }
@@ -529,7 +529,7 @@ void CMeasureMesonCorrelatorStaggered::SimplerVersion()
                     source.m_bySpinIndex = shift;
                     source.m_byColorIndex = c;
                     source.m_eSourceType = EFS_Wall;
-                    source.m_sSourcePoint = SSmallInt4(0, 0, 0, static_cast<SBYTE>(t));
+                    source.m_sSourcePoint = SSmallInt4(0, 0, 0, static_cast<SCOORD>(t));
                     sinks[idx]->InitialAsSource(source);
                 }
             }
@@ -47,6 +47,17 @@ public:
     void Average(UINT uiConfigurationCount) override;
     void Report() override;
     void Reset() override;
+    void SerializeAccumulators(CMeasureArchive& ar) override
+    {
+        ar.Serialize(m_uiConfigurationCount);
+        for (UINT i = 0; i < ECPCTTT_Max; ++i)
+        {
+            ar.Serialize(m_lstTraceRes[i]);
+        }
+        ar.Serialize(m_lstPolyakov);
+        ar.Serialize(m_lstPolyakovSOmega);
+        ar.Serialize(m_lstPolyakovSOmegaSq);
+    }
 
     UBOOL IsGaugeMeasurement() const override { return FALSE; }
     UBOOL IsZ4Source() const override { return TRUE; }
@@ -51,6 +51,15 @@ public:
     void Average(UINT uiConfigurationCount) override;
     void Report() override;
     void Reset() override;
+    void SerializeAccumulators(CMeasureArchive& ar) override
+    {
+        ar.Serialize(m_uiConfigurationCount);
+        ar.Serialize(m_lstR);
+        ar.Serialize(m_lstC);
+        ar.Serialize(m_lstAverageLoop);
+        ar.Serialize(m_cAverageLoop);
+        ar.Serialize(m_lstAverageC);
+    }
 
     UBOOL IsGaugeMeasurement() const override { return TRUE; }
     UBOOL IsSourceScanning() const override { return FALSE; }
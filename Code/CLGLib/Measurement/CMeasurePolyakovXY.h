@@ -65,6 +65,22 @@ public:
     void Average(UINT uiConfigurationCount) override;
     void Report() override;
     void Reset() override;
+    void SerializeAccumulators(CMeasureArchive& ar) override
+    {
+        ar.Serialize(m_uiConfigurationCount);
+        ar.Serialize(m_lstLoop);
+        ar.Serialize(m_lstLoopInner);
+        ar.Serialize(m_lstLoopDensity);
+        ar.Serialize(m_lstLoopZ);
+        ar.Serialize(m_lstLoopZInner);
+        ar.Serialize(m_lstLoopZDensity);
+        ar.Serialize(m_cAverageLoop);
+        ar.Serialize(m_lstAverageLoopDensity);
+        ar.Serialize(m_lstR);
+        ar.Serialize(m_lstP);
+        ar.Serialize(m_lstPZ);
+        ar.Serialize(m_lstPZSlice);
+    }
 
     UBOOL IsGaugeMeasurement() const override { return TRUE; }
     UBOOL IsSourceScanning() const override { return FALSE; }
@@ -97,10 +97,10 @@ void CMeasureWilsonLoopWithPath::Initial(CMeasurementManager* pOwner, CLatticeDa
         m_sPoint = CCommonData::m_sCenter;
         if (thePoint.Num() > 3)
         {
-            m_sPoint.x = static_cast<SBYTE>(thePoint[0]);
-            m_sPoint.y = static_cast<SBYTE>(thePoint[1]);
-            m_sPoint.z = static_cast<SBYTE>(thePoint[2]);
-            m_sPoint.w = static_cast<SBYTE>(thePoint[3]);
+            m_sPoint.x = static_cast<SCOORD>(thePoint[0]);
+            m_sPoint.y = static_cast<SCOORD>(thePoint[1]);
+            m_sPoint.z = static_cast<SCOORD>(thePoint[2]);
+            m_sPoint.w = static_cast<SCOORD>(thePoint[3]);
         }
     }
 
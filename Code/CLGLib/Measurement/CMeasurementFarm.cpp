@@ -0,0 +1,353 @@
+//=============================================================================
+// FILENAME : CMeasurementFarm.cpp
+//
+// DESCRIPTION:
+// This is the class to share the measurement of configurations
+// StartN ... EndN among several worker processes (or devices)
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+#include "CLGLib_Private.h"
+
+__BEGIN_NAMESPACE
+
+static QWORD _farmNow()
+{
+    return static_cast<QWORD>(std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+void CMeasurementFarm::Initial(CParameters& params, UINT uiStartN, UINT uiEndN)
+{
+    CCString sDirectory = _T(".");
+    params.FetchStringValue(_T("FarmDirectory"), sDirectory);
+    CCString sJob = _T("MeasureJob");
+    params.FetchStringValue(_T("FarmJob"), sJob);
+    m_sPrefix = sDirectory + _T("/") + sJob;
+
+    INT iValue = 1;
+    params.FetchValueINT(_T("WorkerCount"), iValue);
+    m_uiWorkerCount = iValue > 0 ? static_cast<UINT>(iValue) : 1;
+
+    iValue = 0;
+    m_bHasWorkerId = params.FetchValueINT(_T("WorkerId"), iValue);
+    if (m_bHasWorkerId)
+    {
+        //two workers with the same id take the claims of each other
+        if (iValue < 0 || static_cast<UINT>(iValue) >= m_uiWorkerCount)
+        {
+            appCrucial(_T("CMeasurementFarm: WorkerId %d is not in 0 ... %d\n"), iValue, m_uiWorkerCount - 1);
+            _FAIL_EXIT;
+        }
+        m_uiWorkerId = static_cast<UINT>(iValue);
+        m_sOwner.Format(_T("%d"), m_uiWorkerId);
+    }
+    else
+    {
+        //the counter separates the workers of one process (for example one for each device)
+        static std::atomic<UINT> uiWorkerInProcess(0);
+        TCHAR sTag[512];
+        appGetProcessTag(sTag, 512);
+        m_sOwner.Format(_T("%s-%d"), sTag, uiWorkerInProcess++);
+        m_sOwner = m_sOwner.Replace(_T(" "), _T("_"));
+        UINT uiHash = 2166136261U;
+        for (INT i = 0; i < m_sOwner.GetLength(); ++i)
+        {
+            uiHash = (uiHash ^ static_cast<UINT>(m_sOwner.GetAt(i))) * 16777619U;
+        }
+        m_uiWorkerId = uiHash % m_uiWorkerCount;
+    }
+
+    iValue = 600;
+    params.FetchValueINT(_T("ClaimTimeOut"), iValue);
+    m_uiClaimTimeOut = iValue > 0 ? static_cast<UINT>(iValue) : 0;
+
+    iValue = 60;
+    params.FetchValueINT(_T("ClaimHeartbeat"), iValue);
+    m_uiClaimHeartbeat = iValue > 0 ? static_cast<UINT>(iValue) : 1;
+    if (m_uiClaimTimeOut > 0 && 2 * m_uiClaimHeartbeat > m_uiClaimTimeOut)
+    {
+        //a running claim must be refreshed several times before it looks crashed
+        m_uiClaimHeartbeat = m_uiClaimTimeOut / 2 > 0 ? m_uiClaimTimeOut / 2 : 1;
+        appGeneral(_T("CMeasurementFarm: ClaimHeartbeat is too long for ClaimTimeOut, %d is used\n"), m_uiClaimHeartbeat);
+    }
+
+    m_uiStartN = uiStartN;
+    m_uiEndN = uiEndN < uiStartN ? uiStartN : uiEndN;
+
+    appGeneral(_T("CMeasurementFarm: worker %s (shard %d / %d), configurations %d - %d, %d already done\n"),
+        m_sOwner.c_str(), m_uiWorkerId, m_uiWorkerCount, m_uiStartN, m_uiEndN, GetFinishedCount());
+}
+
+CCString CMeasurementFarm::GetPartPrefix(UINT uiN) const
+{
+    CCString sRet;
+    sRet.Format(_T("%s_%d"), m_sPrefix.c_str(), uiN);
+    return sRet;
+}
+
+CCString CMeasurementFarm::GetClaimName(UINT uiN) const
+{
+    return GetPartPrefix(uiN) + _T(".claim");
+}
+
+CCString CMeasurementFarm::GetDoneName(UINT uiN) const
+{
+    return GetPartPrefix(uiN) + _T(".done");
+}
+
+UBOOL CMeasurementFarm::IsFinished(UINT uiN) const
+{
+    return CFileSystem::IsFileExist(GetDoneName(uiN));
+}
+
+UINT CMeasurementFarm::GetFinishedCount() const
+{
+    UINT uiRet = 0;
+    for (UINT uiN = m_uiStartN; uiN <= m_uiEndN; ++uiN)
+    {
+        if (IsFinished(uiN))
+        {
+            ++uiRet;
+        }
+    }
+    return uiRet;
+}
+
+UBOOL CMeasurementFarm::TryClaim(UINT uiN) const
+{
+    if (IsFinished(uiN))
+    {
+        return FALSE;
+    }
+
+    CCString sClaim;
+    sClaim.Format(_T("%s %llu"), m_sOwner.c_str(), _farmNow());
+    const CCString sClaimName = GetClaimName(uiN);
+    if (CFileSystem::CreateFileExclusive(sClaimName.c_str(), sClaim))
+    {
+        return TRUE;
+    }
+
+    //The claim of this owner is left by a crashed run of the same worker
+    //(for host-pid, the process with the same pid is gone),
+    //the claim of others is taken over after ClaimTimeOut
+    const CCString sOldClaim = appGetFileSystem()->ReadAllText(sClaimName.c_str());
+    const INT iSpace = sOldClaim.Find(_T(' '), 0);
+    QWORD uiOldTime = 0;
+    if (iSpace <= 0 || 1 != SSCANF(sOldClaim.c_str() + iSpace + 1, _T("%llu"), &uiOldTime))
+    {
+        //being written, or removed by others
+        return FALSE;
+    }
+    const CCString sOldOwner = sOldClaim.Left(iSpace);
+    const UBOOL bStale = (sOldOwner == m_sOwner)
+        || (m_uiClaimTimeOut > 0 && _farmNow() > uiOldTime + m_uiClaimTimeOut);
+    if (!bStale)
+    {
+        return FALSE;
+    }
+
+    //Another worker may have taken over (or the owner refreshed) the claim since it was read,
+    //so the moved file must still be the stale claim, otherwise it is moved back
+    CCString sStaleName;
+    sStaleName.Format(_T("%s.%s.stale"), sClaimName.c_str(), m_sOwner.c_str());
+    if (0 != rename(sClaimName.c_str(), sStaleName.c_str()))
+    {
+        return FALSE;
+    }
+    if (appGetFileSystem()->ReadAllText(sStaleName.c_str()) != sOldClaim)
+    {
+        rename(sStaleName.c_str(), sClaimName.c_str());
+        return FALSE;
+    }
+    remove(sStaleName.c_str());
+    if (IsFinished(uiN))
+    {
+        return FALSE;
+    }
+    if (CFileSystem::CreateFileExclusive(sClaimName.c_str(), sClaim))
+    {
+        appGeneral(_T("CMeasurementFarm: worker %s takes over %d from worker %s\n"), m_sOwner.c_str(), uiN, sOldOwner.c_str());
+        return TRUE;
+    }
+    return FALSE;
+}
+
+UBOOL CMeasurementFarm::ClaimNext(UINT& uiN)
+{
+    //start from the own shard, then go on to the shards of the following workers
+    const UINT uiCount = m_uiEndN - m_uiStartN + 1;
+    const UINT uiShard = (uiCount + m_uiWorkerCount - 1) / m_uiWorkerCount;
+    const UINT uiOwnStart = (m_uiWorkerId * uiShard) % uiCount;
+    for (UINT i = 0; i < uiCount; ++i)
+    {
+        const UINT uiCandidate = m_uiStartN + (uiOwnStart + i) % uiCount;
+        if (TryClaim(uiCandidate))
+        {
+            uiN = uiCandidate;
+            StartHeartbeat(uiN);
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+UBOOL CMeasurementFarm::Finish(UINT uiN, const TArray<CCString>& lstFiles, const TArray<CCString>& lstShared)
+{
+    const CCString sPartPrefix = GetPartPrefix(uiN);
+    const INT iPrefixLength = sPartPrefix.GetLength();
+    CCString sDone;
+    for (INT i = 0; i < lstFiles.Num() + lstShared.Num(); ++i)
+    {
+        const UBOOL bShared = (i >= lstFiles.Num());
+        const CCString& sFile = bShared ? lstShared[i - lstFiles.Num()] : lstFiles[i];
+        if (sFile.Left(iPrefixLength) != sPartPrefix)
+        {
+            appCrucial(_T("CMeasurementFarm: %s is not written with the prefix %s\n"), sFile.c_str(), sPartPrefix.c_str());
+            return FALSE;
+        }
+        sDone = sDone + (bShared ? _T("S ") : _T("P ")) + sFile.Mid(iPrefixLength) + _T("\n");
+    }
+
+    //the results are complete when .done appears
+    const CCString sDoneName = GetDoneName(uiN);
+    if (!CFileSystem::WriteAllBytesAtomic(sDoneName.c_str(), reinterpret_cast<const BYTE*>(sDone.c_str()), static_cast<UINT>(sDone.GetLength())))
+    {
+        appCrucial(_T("CMeasurementFarm: failed to write %s\n"), sDoneName.c_str());
+        return FALSE;
+    }
+    StopHeartbeat();
+    remove(GetClaimName(uiN).c_str());
+    return TRUE;
+}
+
+void CMeasurementFarm::StartHeartbeat(UINT uiN)
+{
+    StopHeartbeat();
+    m_uiHeartbeatN = uiN;
+    m_uiHeartbeatStop = 0;
+    m_pHeartbeat = new std::thread(&CMeasurementFarm::Heartbeat, this);
+}
+
+void CMeasurementFarm::StopHeartbeat()
+{
+    if (NULL != m_pHeartbeat)
+    {
+        m_uiHeartbeatStop = 1;
+        m_pHeartbeat->join();
+        appSafeDelete(m_pHeartbeat);
+    }
+}
+
+void CMeasurementFarm::Heartbeat()
+{
+    const CCString sClaimName = GetClaimName(m_uiHeartbeatN);
+    const CCString sOwnerHead = m_sOwner + _T(" ");
+    std::chrono::steady_clock::time_point last = std::chrono::steady_clock::now();
+    while (0 == m_uiHeartbeatStop)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        if (std::chrono::steady_clock::now() - last < std::chrono::seconds(m_uiClaimHeartbeat))
+        {
+            continue;
+        }
+        last = std::chrono::steady_clock::now();
+
+        //only the own claim is refreshed, a missing one is being checked by a worker taking over
+        const CCString sClaim = appGetFileSystem()->ReadAllText(sClaimName.c_str());
+        if (sClaim.Left(sOwnerHead.GetLength()) != sOwnerHead)
+        {
+            continue;
+        }
+        CCString sNewClaim;
+        sNewClaim.Format(_T("%s %llu"), m_sOwner.c_str(), _farmNow());
+        CFileSystem::WriteAllBytesAtomic(sClaimName.c_str(), reinterpret_cast<const BYTE*>(sNewClaim.c_str()), static_cast<size_t>(sNewClaim.GetLength()));
+    }
+}
+
+UBOOL CMeasurementFarm::WaitAll(UINT uiTimeOut) const
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    while (GetFinishedCount() < m_uiEndN - m_uiStartN + 1)
+    {
+        if (std::chrono::steady_clock::now() - start > std::chrono::seconds(uiTimeOut))
+        {
+            appCrucial(_T("CMeasurementFarm: time out, %d of %d are done\n"), GetFinishedCount(), m_uiEndN - m_uiStartN + 1);
+            return FALSE;
+        }
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+    }
+    return TRUE;
+}
+
+UBOOL CMeasurementFarm::Merge(const CCString& sOutPrefix, UBOOL bRemoveParts) const
+{
+    for (UINT uiN = m_uiStartN; uiN <= m_uiEndN; ++uiN)
+    {
+        if (!IsFinished(uiN))
+        {
+            appCrucial(_T("CMeasurementFarm: configuration %d is not done, cannot merge\n"), uiN);
+            return FALSE;
+        }
+    }
+
+    const CCString sDone = appGetFileSystem()->ReadAllText(GetDoneName(m_uiStartN).c_str());
+    const TArray<CCString> lstLines = appGetStringList(sDone, '\n', EGSLF_IgnorEmety);
+    for (INT i = 0; i < lstLines.Num(); ++i)
+    {
+        if (lstLines[i].GetLength() < 3)
+        {
+            continue;
+        }
+        const UBOOL bShared = (lstLines[i].Left(1) == _T("S"));
+        const CCString sSuffix = lstLines[i].Mid(2);
+
+        CCString sMerged;
+        for (UINT uiN = m_uiStartN; uiN <= m_uiEndN; ++uiN)
+        {
+            const CCString sPart = appGetFileSystem()->ReadAllText((GetPartPrefix(uiN) + sSuffix).c_str());
+            if (bShared || sPart.Right(1) == _T("\n"))
+            {
+                sMerged = sMerged + sPart;
+            }
+            else if (sPart.GetLength() > 0)
+            {
+                sMerged = sMerged + (sMerged.GetLength() > 0 ? _T(",") : _T("")) + sPart;
+            }
+            if (bShared)
+            {
+                break;
+            }
+        }
+        if (!appGetFileSystem()->WriteAllText((sOutPrefix + sSuffix).c_str(), sMerged))
+        {
+            appCrucial(_T("CMeasurementFarm: failed to write %s\n"), (sOutPrefix + sSuffix).c_str());
+            return FALSE;
+        }
+    }
+
+    if (bRemoveParts)
+    {
+        for (UINT uiN = m_uiStartN; uiN <= m_uiEndN; ++uiN)
+        {
+            for (INT i = 0; i < lstLines.Num(); ++i)
+            {
+                if (lstLines[i].GetLength() >= 3)
+                {
+                    remove((GetPartPrefix(uiN) + lstLines[i].Mid(2)).c_str());
+                }
+            }
+            remove(GetDoneName(uiN).c_str());
+        }
+    }
+    appGeneral(_T("CMeasurementFarm: merged %d files of %d configurations to %s\n"), lstLines.Num(), m_uiEndN - m_uiStartN + 1, sOutPrefix.c_str());
+    return TRUE;
+}
+
+__END_NAMESPACE
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
@@ -0,0 +1,149 @@
+//=============================================================================
+// FILENAME : CMeasurementFarm.h
+//
+// DESCRIPTION:
+// This is the class to share the measurement of configurations
+// StartN ... EndN among several worker processes (or devices)
+//
+// The queue is a directory shared by the workers:
+//  <job>_<N>.claim : created exclusively by the worker measuring N
+//  <job>_<N>_<suffix> : the results of N, written with the prefix GetPartPrefix(N)
+//  <job>_<N>.done : written atomically after all results of N are written
+//
+// Each worker first takes the configurations of its own shard, then steals
+// from the shards of other workers. A configuration with ".done" is never
+// measured again, so a crashed run is restarted by running the workers
+// again. While measuring, the worker refreshes the time in its claim every
+// ClaimHeartbeat seconds, a claim without ".done" not refreshed for
+// ClaimTimeOut belongs to a crashed worker, and is taken over.
+//
+// The claim records the owner. WorkerId must be unique among the running
+// workers (0 ... WorkerCount - 1), a claim of the same WorkerId is left by
+// a crashed run of this worker and is taken over at once. Without WorkerId
+// the owner is "host-pid-n" (n counts the workers of the process) and the
+// shard is chosen by the hash of it, the claims of others are only taken
+// over after ClaimTimeOut.
+//
+// Merge joins the parts in the order of N: a part ending with a new line
+// (one row per configuration) is appended, otherwise (one value per
+// configuration) the parts are joined by ",". The shared files (written
+// the same for every configuration, for example the radius) are copied once.
+//
+// Parameters:
+//  FarmDirectory : .
+//  FarmJob : MeasureJob
+//  WorkerId : (host-pid-n if not set)
+//  WorkerCount : 1
+//  ClaimTimeOut : 600
+//  ClaimHeartbeat : 60
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#ifndef _CMEASUREMENTFARM_H_
+#define _CMEASUREMENTFARM_H_
+
+__BEGIN_NAMESPACE
+
+class CLGAPI CMeasurementFarm
+{
+public:
+    CMeasurementFarm()
+        : m_uiStartN(0)
+        , m_uiEndN(0)
+        , m_uiWorkerId(0)
+        , m_bHasWorkerId(FALSE)
+        , m_uiWorkerCount(1)
+        , m_uiClaimTimeOut(600)
+        , m_uiClaimHeartbeat(60)
+        , m_uiHeartbeatN(0)
+        , m_pHeartbeat(NULL)
+        , m_uiHeartbeatStop(0)
+    {
+    }
+
+    ~CMeasurementFarm()
+    {
+        StopHeartbeat();
+    }
+
+    void Initial(class CParameters& params, UINT uiStartN, UINT uiEndN);
+
+    /**
+    * Claim the next configuration which is neither done nor claimed by a running worker
+    * return FALSE if nothing is left
+    */
+    UBOOL ClaimNext(UINT& uiN);
+
+    /**
+    * The results of N should be written to GetPartPrefix(N) + suffix
+    */
+    CCString GetPartPrefix(UINT uiN) const;
+
+    /**
+    * lstFiles are the files written for N with the prefix GetPartPrefix(N)
+    * lstShared are the ones which are the same for all configurations
+    */
+    UBOOL Finish(UINT uiN, const TArray<CCString>& lstFiles, const TArray<CCString>& lstShared);
+
+    UBOOL IsFinished(UINT uiN) const;
+    UINT GetFinishedCount() const;
+
+    /**
+    * Wait until all configurations are done, for the worker doing the merge
+    * return FALSE if time out (in seconds)
+    */
+    UBOOL WaitAll(UINT uiTimeOut) const;
+
+    /**
+    * Join the parts to sOutPrefix + suffix, and remove the parts if bRemoveParts
+    */
+    UBOOL Merge(const CCString& sOutPrefix, UBOOL bRemoveParts = TRUE) const;
+
+    /**
+    * The shard, it is the hash of the owner when WorkerId is not set
+    */
+    UINT GetWorkerId() const { return m_uiWorkerId; }
+    UINT GetWorkerCount() const { return m_uiWorkerCount; }
+    const CCString& GetOwner() const { return m_sOwner; }
+
+    /**
+    * The worker merging the results: WorkerId = 0, or the only worker
+    */
+    UBOOL IsMerger() const { return (m_bHasWorkerId && 0 == m_uiWorkerId) || 1 == m_uiWorkerCount; }
+
+protected:
+
+    CCString GetClaimName(UINT uiN) const;
+    CCString GetDoneName(UINT uiN) const;
+    UBOOL TryClaim(UINT uiN) const;
+
+    /**
+    * A thread refreshing the claim of N until StopHeartbeat (called by Finish)
+    */
+    void StartHeartbeat(UINT uiN);
+    void StopHeartbeat();
+    void Heartbeat();
+
+    CCString m_sPrefix;
+    UINT m_uiStartN;
+    UINT m_uiEndN;
+    UINT m_uiWorkerId;
+    UBOOL m_bHasWorkerId;
+    CCString m_sOwner;
+    UINT m_uiWorkerCount;
+    UINT m_uiClaimTimeOut;
+    UINT m_uiClaimHeartbeat;
+    UINT m_uiHeartbeatN;
+    std::thread* m_pHeartbeat;
+    std::atomic<UINT> m_uiHeartbeatStop;
+};
+
+__END_NAMESPACE
+
+#endif //#ifndef _CMEASUREMENTFARM_H_
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
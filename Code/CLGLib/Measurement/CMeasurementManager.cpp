@@ -20,6 +20,7 @@ void CMeasurementManager::OnConfigurationAccepted(const CFieldGauge* pAcceptGaug
     }
 
     ++m_iAcceptedConfigurationCount;
+    appGetLattice()->m_pRandom->SetPurpose(ERP_Measurement);
 
     CFieldGauge* pSmearing = NULL;
     CFieldGauge* pSmearingStaple = NULL;
@@ -36,6 +37,7 @@ void CMeasurementManager::OnConfigurationAccepted(const CFieldGauge* pAcceptGaug
             pSmearingStaple = dynamic_cast<CFieldGauge*>(pAcceptGauge->GetCopy());
             pAcceptGauge->CalculateOnlyStaple(pSmearingStaple);
         }
+        appProfile(_T("GaugeSmearing"));
         appGetGaugeSmearing()->GaugeSmearing(pSmearing, pSmearingStaple);
     }
 
@@ -44,6 +46,7 @@ void CMeasurementManager::OnConfigurationAccepted(const CFieldGauge* pAcceptGaug
     {
         if (NULL != m_lstAllMeasures[i] && m_lstAllMeasures[i]->IsGaugeMeasurement())
         {
+            appProfile(m_lstAllMeasures[i]->GetClass()->GetName());
             m_lstAllMeasures[i]->OnConfigurationAccepted(
                 m_lstAllMeasures[i]->NeedGaugeSmearing() ? pSmearing : pAcceptGauge,
                 m_lstAllMeasures[i]->NeedGaugeSmearing() ? pSmearingStaple : pCorrespondingStaple);
@@ -55,6 +58,7 @@ void CMeasurementManager::OnConfigurationAccepted(const CFieldGauge* pAcceptGaug
     const THashMap<BYTE, TArray<CMeasureStochastic*>> allZ4Fields = HasZ4(uiFieldCount);
     if (uiFieldCount > 0)
     {
+        appProfile(_T("MeasureZ4"));
         TArray<BYTE> allFieldIdsz4 = allZ4Fields.GetAllKeys();
         for (INT i = 0; i < allFieldIdsz4.Num(); ++i)
         {
@@ -99,6 +103,7 @@ void CMeasurementManager::OnConfigurationAccepted(const CFieldGauge* pAcceptGaug
     const THashMap<BYTE, TArray<CMeasure*>> allScanningFields = HasSourceScanning(bHasSourceScanning);
     if (bHasSourceScanning)
     {
+        appProfile(_T("MeasureSourceScanning"));
         TArray<BYTE> allFieldIds = allScanningFields.GetAllKeys();
         for (INT i = 0; i < allFieldIds.Num(); ++i)
         {
@@ -107,7 +112,7 @@ void CMeasurementManager::OnConfigurationAccepted(const CFieldGauge* pAcceptGaug
             for (UINT x = 1; x < _HC_Lx; ++x)
             {
                 SSmallInt4 sourceSite;
-                sourceSite.x = static_cast<SBYTE>(x);
+                sourceSite.x = static_cast<SCOORD>(x);
                 sourceSite.y = CCommonData::m_sCenter.y;
                 sourceSite.z = CCommonData::m_sCenter.z;
                 sourceSite.w = CCommonData::m_sCenter.w;
@@ -169,6 +174,78 @@ void CMeasurementManager::Reset()
     m_bEverResetted = TRUE;
 }
 
+void CMeasurementManager::SaveAccumulators(TArray<BYTE>& buffer)
+{
+    CMeasureArchive ar(&buffer);
+    UINT uiCount = static_cast<UINT>(m_lstAllMeasures.Num());
+    ar.Serialize(uiCount);
+    for (INT i = 0; i < m_lstAllMeasures.Num(); ++i)
+    {
+        UINT uiId = (NULL == m_lstAllMeasures[i]) ? 0xffffffffU : static_cast<UINT>(m_lstAllMeasures[i]->GetId());
+        ar.Serialize(uiId);
+
+        //size of the data is filled after the data
+        const INT iSizeIndex = buffer.AddSize(static_cast<INT>(sizeof(UINT)));
+        const INT iStart = buffer.Num();
+        if (NULL != m_lstAllMeasures[i])
+        {
+            m_lstAllMeasures[i]->SerializeAccumulators(ar);
+        }
+        const UINT uiDataSize = static_cast<UINT>(buffer.Num() - iStart);
+        memcpy(buffer.GetData() + iSizeIndex, &uiDataSize, sizeof(UINT));
+    }
+}
+
+UBOOL CMeasurementManager::LoadAccumulators(const BYTE* byData, UINT uiSize)
+{
+    UINT uiOffset = 0;
+    UINT uiCount = 0;
+    if (uiSize < sizeof(UINT))
+    {
+        return FALSE;
+    }
+    memcpy(&uiCount, byData, sizeof(UINT));
+    uiOffset += sizeof(UINT);
+    if (uiCount != static_cast<UINT>(m_lstAllMeasures.Num()))
+    {
+        appCrucial(_T("Measurement: the checkpoint has %d measures, but there are %d\n"), uiCount, m_lstAllMeasures.Num());
+        return FALSE;
+    }
+
+    for (INT i = 0; i < m_lstAllMeasures.Num(); ++i)
+    {
+        UINT idAndSize[2];
+        if (uiOffset + sizeof(UINT) * 2 > uiSize)
+        {
+            return FALSE;
+        }
+        memcpy(idAndSize, byData + uiOffset, sizeof(UINT) * 2);
+        uiOffset += sizeof(UINT) * 2;
+        if (uiOffset + idAndSize[1] > uiSize)
+        {
+            return FALSE;
+        }
+
+        if (NULL != m_lstAllMeasures[i])
+        {
+            if (idAndSize[0] != static_cast<UINT>(m_lstAllMeasures[i]->GetId()))
+            {
+                appCrucial(_T("Measurement: the measure %d of the checkpoint has id %d, but it is %d\n"), i, idAndSize[0], m_lstAllMeasures[i]->GetId());
+                return FALSE;
+            }
+            CMeasureArchive ar(byData + uiOffset, idAndSize[1]);
+            m_lstAllMeasures[i]->SerializeAccumulators(ar);
+            if (!ar.IsOk() || ar.GetOffset() != idAndSize[1])
+            {
+                appCrucial(_T("Measurement: failed to load the data of %s from the checkpoint\n"), m_lstAllMeasures[i]->GetClass()->GetName());
+                return FALSE;
+            }
+        }
+        uiOffset += idAndSize[1];
+    }
+    return uiOffset == uiSize;
+}
+
 void CMeasurementManager::Report()
 {
     for (INT i = 0; i < m_lstAllMeasures.Num(); ++i)
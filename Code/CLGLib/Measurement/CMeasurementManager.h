@@ -31,6 +31,26 @@ public:
 
     CMeasure* GetMeasureById(BYTE byId) const;
 
+    /**
+    * Used by checkpoint
+    */
+    UINT GetAcceptedConfigurationCount() const { return m_iAcceptedConfigurationCount; }
+    void SetAcceptedConfigurationCount(UINT uiCount)
+    {
+        m_iAcceptedConfigurationCount = uiCount;
+        if (!m_bEverResetted && uiCount > 0)
+        {
+            m_bNeedGaugeSmearing = NeedSmearing();
+        }
+    }
+
+    /**
+    * Used by checkpoint, the accumulated data of all measures,
+    * measure count, then (id, size of data, data) for each measure
+    */
+    void SaveAccumulators(TArray<BYTE>& buffer);
+    UBOOL LoadAccumulators(const BYTE* byData, UINT uiSize);
+
     TArray<CMeasure*> m_lstAllMeasures;
     THashMap<BYTE, CMeasure*> m_mapMeasures;
 
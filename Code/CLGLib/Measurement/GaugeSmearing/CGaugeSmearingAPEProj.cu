@@ -184,6 +184,7 @@ void CGaugeSmearingAPEProj::GaugeSmearing(CFieldGauge* pGauge, CFieldGauge* pSta
     {
         pGaugeSU3->CalculateOnlyStaple(pStaple);
     }
+    pGaugeSU3->IncreaseVersion();
 }
 
 CCString CGaugeSmearingAPEProj::GetInfos(const CCString &tab) const
@@ -111,6 +111,7 @@ void CGaugeSmearingAPEStout::GaugeSmearing(CFieldGauge* pGauge, CFieldGauge* pSt
     {
         pGaugeSU3->CalculateOnlyStaple(pStaple);
     }
+    pGaugeSU3->IncreaseVersion();
 }
 
 CCString CGaugeSmearingAPEStout::GetInfos(const CCString &tab) const
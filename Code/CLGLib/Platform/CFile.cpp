@@ -204,6 +204,48 @@ UBOOL CFileSystem::AppendAllText(const TCHAR* sFilename, const CCString& data)
     return TRUE;
 }
 
+UBOOL CFileSystem::WriteAllBytesAtomic(const TCHAR* sFilename, const BYTE* data, size_t uiSize)
+{
+    CCString sTemp;
+    sTemp.Format(_T("%s.tmp"), sFilename);
+    FILE* fp = NULL;
+    fopen_s(&fp, sTemp.c_str(), _T("wb"));
+    if (NULL == fp)
+    {
+        return FALSE;
+    }
+
+    const size_t uiWritten = fwrite(data, 1, uiSize, fp);
+    fflush(fp);
+    fclose(fp);
+    if (uiWritten != uiSize)
+    {
+        remove(sTemp.c_str());
+        return FALSE;
+    }
+
+#if _CLG_WIN
+    //rename does not replace an existing file on Windows
+    remove(sFilename);
+#endif
+    return 0 == rename(sTemp.c_str(), sFilename);
+}
+
+UBOOL CFileSystem::CreateFileExclusive(const TCHAR* sFilename, const CCString& data)
+{
+    //"x" fails if the file exists, the check and the creation are one operation
+    FILE* fp = NULL;
+    fopen_s(&fp, sFilename, _T("wx"));
+    if (NULL == fp)
+    {
+        return FALSE;
+    }
+    fwrite(data.c_str(), 1, data.GetLength(), fp);
+    fflush(fp);
+    fclose(fp);
+    return TRUE;
+}
+
 UBOOL CFileSystem::IsFileExist(const CCString& sFileName)
 {
     IFSTREAM f(sFileName.c_str());
@@ -36,6 +36,18 @@ public:
     static UBOOL IsFileExist(const CCString& sFileName);
 
     static UBOOL AppendAllText(const TCHAR* sFilename, const CCString& data);
+
+    /**
+    * Write to "sFilename.tmp" and then rename it to sFilename,
+    * so sFilename is either the old one or the complete new one
+    */
+    static UBOOL WriteAllBytesAtomic(const TCHAR* sFilename, const BYTE* data, size_t uiSize);
+
+    /**
+    * Create sFilename with the text only if it does not exist,
+    * when several processes try the same file, only one of them gets TRUE
+    */
+    static UBOOL CreateFileExclusive(const TCHAR* sFilename, const CCString& data);
     
     //UBOOL MakeDir(const CCString& dirPath);
 
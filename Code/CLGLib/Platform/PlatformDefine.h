@@ -168,6 +168,39 @@ FORCEINLINE void appGetTimeNow(TCHAR* outchar, UINT buffSize)
 #endif
 }
 
+/**
+* "host-pid", unique among the running processes sharing a file system
+*/
+FORCEINLINE void appGetProcessTag(TCHAR* outchar, UINT buffSize)
+{
+#if _CLG_WIN
+    char sHost[256];
+    size_t uiLength = 0;
+    if (0 != getenv_s(&uiLength, sHost, sizeof(sHost), "COMPUTERNAME") || 0 == uiLength)
+    {
+        strcpy_s(sHost, sizeof(sHost), "host");
+    }
+    sprintf_s(outchar, buffSize, "%s-%d", sHost, _getpid());
+#else
+    char sHost[256] = "host";
+    gethostname(sHost, sizeof(sHost));
+    sHost[sizeof(sHost) - 1] = 0;
+    snprintf(outchar, buffSize, "%s-%d", sHost, static_cast<INT>(getpid()));
+#endif
+}
+
+/**
+* fseek with a 64-bit offset from the beginning of the file
+*/
+FORCEINLINE INT appFSeek64(FILE* fp, QWORD uiOffset)
+{
+#if _CLG_WIN
+    return _fseeki64(fp, static_cast<__int64>(uiOffset), SEEK_SET);
+#else
+    return fseeko(fp, static_cast<off_t>(uiOffset), SEEK_SET);
+#endif
+}
+
 FORCEINLINE void appGetTimeUtc(TCHAR* outchar, UINT buffSize)
 {
     time_t now = time(0);
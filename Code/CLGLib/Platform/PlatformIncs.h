@@ -33,6 +33,12 @@
 #include <algorithm> //c++14
 #include <atomic> //replace interlock
 #include <chrono> //for timer
+#include <thread> //for background writer
+#if _CLG_WIN
+#include <process.h> //for _getpid
+#else
+#include <unistd.h> //for getpid, gethostname
+#endif
 
 #if _CLG_UNICODE
 
@@ -71,6 +71,8 @@ void CMultiShiftBiCGStab::ReleaseBuffers()
 
 UBOOL CMultiShiftBiCGStab::Solve(TArray<CField*>& pFieldX, const TArray<CLGComplex>& cn, const CField* pFieldB, const CFieldGauge* pGaugeFeild, EFieldOperator uiM, ESolverPhase ePhase, const CField* pStart)
 {
+    appProfile(GetClass()->GetName());
+    m_kSolveTimer.Start();
 #if !_CLG_DOUBLEFLOAT
     //When there is div, we use double instead of float
     appSetLogDate(FALSE);
@@ -126,6 +128,7 @@ UBOOL CMultiShiftBiCGStab::Solve(TArray<CField*>& pFieldX, const TArray<CLGCompl
     UBOOL bDone = FALSE;
     for (UINT i = 0; i < m_uiStepCount * m_uiDevationCheck; ++i)
     {
+        ++m_uiIterationCount;
         const cuDoubleComplex newbeta = cuCdiv(make_cuDoubleComplex(-1.0, 0.0), phi);
         for (INT n = 0; n < cn.Num(); ++n)
         {
@@ -162,8 +165,10 @@ UBOOL CMultiShiftBiCGStab::Solve(TArray<CField*>& pFieldX, const TArray<CLGCompl
         pR->CopyTo(pW);
         pW->Axpy(_cToFloat(beta), pSA);
         pW->CopyTo(pWA);
-        pWA->ApplyOperator(uiM, pGaugeFeild);
-        const cuDoubleComplex chi = cuCdivf_cd_host(pWA->Dot(pW), pWA->Dot(pWA).x);
+        //<wa, w> = <w, wa>^*
+        SOperatorFusion fusionWA(EOF_DotSource | EOF_Norm);
+        pWA->ApplyOperatorFused(uiM, pGaugeFeild, fusionWA);
+        const cuDoubleComplex chi = cuCdivf_cd_host(cuConj(fusionWA.m_cDot), fusionWA.m_fNorm);
         for (INT n = 0; n < cn.Num(); ++n)
         {
             if (sl[n] < m_fAccuracy * fBLength)
@@ -250,6 +255,7 @@ UBOOL CMultiShiftBiCGStab::Solve(TArray<CField*>& pFieldX, const TArray<CLGCompl
     pSA->Return();
     pWA->Return();
     appSetLogDate(TRUE);
+    m_kSolveTimer.Stop();
     return bDone;
 #else
     appSetLogDate(FALSE);
@@ -305,6 +311,7 @@ UBOOL CMultiShiftBiCGStab::Solve(TArray<CField*>& pFieldX, const TArray<CLGCompl
     UBOOL bDone = FALSE;
     for (UINT i = 0; i < m_uiStepCount * m_uiDevationCheck; ++i)
     {
+        ++m_uiIterationCount;
         const CLGComplex newbeta = _cuCdivf(_make_cuComplex(-F(1.0), F(0.0)), phi);
         for (INT n = 0; n < cn.Num(); ++n)
         {
@@ -341,8 +348,10 @@ UBOOL CMultiShiftBiCGStab::Solve(TArray<CField*>& pFieldX, const TArray<CLGCompl
         pR->CopyTo(pW);
         pW->Axpy(beta, pSA);
         pW->CopyTo(pWA);
-        pWA->ApplyOperator(uiM, pGaugeFeild);
-        const CLGComplex chi = cuCdivf_cr_host(pWA->Dot(pW), pWA->Dot(pWA).x);
+        //<wa, w> = <w, wa>^*
+        SOperatorFusion fusionWA(EOF_DotSource | EOF_Norm);
+        pWA->ApplyOperatorFused(uiM, pGaugeFeild, fusionWA);
+        const CLGComplex chi = cuCdivf_cr_host(_cuConjf(fusionWA.m_cDot), fusionWA.m_fNorm);
         for (INT n = 0; n < cn.Num(); ++n)
         {
             if (sl[n] < m_fAccuracy * fBLength)
@@ -428,6 +437,7 @@ UBOOL CMultiShiftBiCGStab::Solve(TArray<CField*>& pFieldX, const TArray<CLGCompl
     pSA->Return();
     pWA->Return();
     appSetLogDate(TRUE);
+    m_kSolveTimer.Stop();
     return bDone;
 #endif
 }
@@ -95,6 +95,8 @@ void CMultiShiftFOM::ReleaseBuffers()
 
 UBOOL CMultiShiftFOM::Solve(TArray<CField*>& pFieldX, const TArray<CLGComplex>& cn, const CField* pFieldB, const CFieldGauge* pGaugeFeild, EFieldOperator uiM, ESolverPhase ePhase, const CField* pStart)
 {
+    appProfile(GetClass()->GetName());
+    m_kSolveTimer.Start();
     appSetLogDate(FALSE);
     assert(0 == m_lstVectors.Num());
     for (UINT i = 0; i < m_uiMaxDim; ++i)
@@ -160,6 +162,7 @@ UBOOL CMultiShiftFOM::Solve(TArray<CField*>& pFieldX, const TArray<CLGComplex>&
 
         for (UINT j = 0; j < m_uiMaxDim; ++j)
         {
+            ++m_uiIterationCount;
             //w = A v[j]
             m_lstVectors[j]->CopyTo(pW);
             pW->ApplyOperator(uiM, pGaugeFeild);
@@ -247,6 +250,7 @@ UBOOL CMultiShiftFOM::Solve(TArray<CField*>& pFieldX, const TArray<CLGComplex>&
                 m_lstVectors[k]->Return();
             }
             m_lstVectors.RemoveAll();
+            m_kSolveTimer.Stop();
             return TRUE;
         }
 
@@ -261,6 +265,7 @@ UBOOL CMultiShiftFOM::Solve(TArray<CField*>& pFieldX, const TArray<CLGComplex>&
         m_lstVectors[i]->Return();
     }
     m_lstVectors.RemoveAll();
+    m_kSolveTimer.Stop();
     return FALSE;
 }
 
@@ -110,6 +110,8 @@ void CMultiShiftGMRES::ReleaseBuffers()
 
 UBOOL CMultiShiftGMRES::Solve(TArray<CField*>& pFieldX, const TArray<CLGComplex>& cn, const CField* pFieldB, const CFieldGauge* pGaugeFeild, EFieldOperator uiM, ESolverPhase ePhase, const CField* pStart)
 {
+    appProfile(GetClass()->GetName());
+    m_kSolveTimer.Start();
     appSetLogDate(FALSE);
     assert(0 == m_lstVectors.Num());
     for (UINT i = 0; i < m_uiMaxDim; ++i)
@@ -161,8 +163,8 @@ UBOOL CMultiShiftGMRES::Solve(TArray<CField*>& pFieldX, const TArray<CLGComplex>
         else
         {
             pX->CopyTo(pR); //x0 need to be preserved
-            pR->ApplyOperator(uiM, pGaugeFeild, EOCT_Minus); //x0 = -A x0
-            pR->AxpyPlus(pFieldB); //x0 = b-Ax0
+            SOperatorFusion fusion(EOF_BMinus, pFieldB);
+            pR->ApplyOperatorFused(uiM, pGaugeFeild, fusion); //x0 = b-Ax0
         }
 #if !_CLG_DOUBLEFLOAT
         m_fBeta = static_cast<Real>(_sqrtd(m_lstVectors[0]->Dot(m_lstVectors[0]).x));
@@ -173,6 +175,7 @@ UBOOL CMultiShiftGMRES::Solve(TArray<CField*>& pFieldX, const TArray<CLGComplex>
         
         for (UINT j = 0; j < m_uiMaxDim; ++j)
         {
+            ++m_uiIterationCount;
             //w = A v[j]
             m_lstVectors[j]->CopyTo(pW);
             pW->ApplyOperator(uiM, pGaugeFeild);
@@ -307,6 +310,7 @@ UBOOL CMultiShiftGMRES::Solve(TArray<CField*>& pFieldX, const TArray<CLGComplex>
                 m_lstVectors[k]->Return();
             }
             m_lstVectors.RemoveAll();
+            m_kSolveTimer.Stop();
             return TRUE;
         }
 
@@ -321,6 +325,7 @@ UBOOL CMultiShiftGMRES::Solve(TArray<CField*>& pFieldX, const TArray<CLGComplex>
         m_lstVectors[i]->Return();
     }
     m_lstVectors.RemoveAll();
+    m_kSolveTimer.Stop();
     return FALSE;
 }
 
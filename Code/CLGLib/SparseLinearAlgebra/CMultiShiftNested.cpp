@@ -67,6 +67,8 @@ void CMultiShiftNested::AllocateBuffers(const CField*)
 
 UBOOL CMultiShiftNested::Solve(TArray<CField*>& pFieldX, const TArray<CLGComplex>& cn, const CField* pFieldB, const CFieldGauge* pGaugeFeild, EFieldOperator uiM, ESolverPhase , const CField* )
 {
+    //It calls the CSLASolver of the field, the statistics is recorded there
+    appProfile(GetClass()->GetName());
     appSetLogDate(FALSE);
 #if _CLG_DEBUG
     if (cn.Num() > 2)
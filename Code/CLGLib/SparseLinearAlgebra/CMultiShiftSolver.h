@@ -17,7 +17,7 @@ class CLGAPI CMultiShiftSolver : public CBase
 {
 public:
 
-    CMultiShiftSolver() : m_pOwner(NULL), m_bAbsoluteAccuracy(FALSE) { }
+    CMultiShiftSolver() : m_pOwner(NULL), m_bAbsoluteAccuracy(FALSE), m_uiIterationCount(0) { }
 
     virtual void Configurate(const CParameters& param) = 0;
 
@@ -51,11 +51,26 @@ public:
 
     UBOOL IsAbsoluteAccuracy() const { return m_bAbsoluteAccuracy; }
 
+    /**
+    * Statistics of solves, accumulated until ResetStatistics, time in ms
+    */
+    void ResetStatistics()
+    {
+        m_kSolveTimer.Reset();
+        m_uiIterationCount = 0;
+    }
+    UINT GetSolveCount() const { return m_kSolveTimer.GetCounter(); }
+    UINT GetIterationCount() const { return m_uiIterationCount; }
+    FLOAT GetSolveTime() const { return m_kSolveTimer.Elapsed(); }
+
 protected:
 
     UINT m_uiAccurayCheckInterval;
     Real m_fAccuracy;
     UBOOL m_bAbsoluteAccuracy;
+
+    CTimer m_kSolveTimer;
+    UINT m_uiIterationCount;
 };
 
 __END_NAMESPACE
@@ -401,6 +401,8 @@ UBOOL CSLASolverBiCGStab::Solve1(CField* pFieldX, const CField* pFieldB, const C
 //It is tested this is better, the main difference is to let p0 = r0, and rho = r0^* by Yousef Saad.
 UBOOL CSLASolverBiCGStab::Solve(CField* pFieldX, const CField* pFieldB, const CFieldGauge* pGaugeFeild, EFieldOperator uiM, ESolverPhase ePhase, const CField* pStart)
 {
+    appProfile(GetClass()->GetName());
+    m_kSolveTimer.Start();
     //CField* pB = appGetLattice()->GetPooledFieldById(pFieldB->m_byFieldId);
     CField* pX = appGetLattice()->GetPooledFieldById(pFieldB->m_byFieldId);
     CField* pP = appGetLattice()->GetPooledFieldById(pFieldB->m_byFieldId);
@@ -447,10 +449,8 @@ UBOOL CSLASolverBiCGStab::Solve(CField* pFieldX, const CField* pFieldB, const CF
     {
         //appGeneral(_T(" ============================ pR ===================\n"));
         //pR->DebugPrintMe();
-        pR->ApplyOperator(uiM, pGaugeFeild, EOCT_Minus); //-A x_0
-        //appGeneral(_T(" ============================ pR2 ===================\n"));
-        //pR->DebugPrintMe();
-        pR->AxpyPlus(pFieldB); //pR->AxpyPlus(pB); //b - A x_0
+        SOperatorFusion fusionR(EOF_BMinus, pFieldB);
+        pR->ApplyOperatorFused(uiM, pGaugeFeild, fusionR); //b - A x_0
         //appGeneral(_T(" ============================ pR3 ===================\n"));
         //pR->DebugPrintMe();
         //appGeneral(_T(" ============================ ==== ===================\n"));
@@ -473,6 +473,7 @@ UBOOL CSLASolverBiCGStab::Solve(CField* pFieldX, const CField* pFieldB, const CF
 
         for (UINT j = 0; j < m_uiStepCount * m_uiDevationCheck; ++j)
         {
+            ++m_uiIterationCount;
             //==========
             //One step
             if (0 == j)
@@ -505,12 +506,7 @@ UBOOL CSLASolverBiCGStab::Solve(CField* pFieldX, const CField* pFieldB, const CF
 #endif
             
             //s=r(i-1) - alpha v(i)
-            pR->CopyTo(pS);
-#if !_CLG_DOUBLEFLOAT
-            pS->Axpy(_make_cuComplex(-static_cast<Real>(alpha.x), -static_cast<Real>(alpha.y)), pV);
-#else
-            pS->Axpy(_make_cuComplex(-alpha.x, -alpha.y), pV);
-#endif
+            appFieldAssign(pS, appField(pR) - alpha * appField(pV));
 
             if (0 == (j + 1) % m_uiDevationCheck)
             {
@@ -530,55 +526,41 @@ UBOOL CSLASolverBiCGStab::Solve(CField* pFieldX, const CField* pFieldB, const CF
                     pRh->Return();
                     pS->Return();
                     pT->Return();
+                    m_kSolveTimer.Stop();
                     return TRUE;
                 }
             }
             //after this step, there is precondition for s
 
-            //t=As
+            //t=As, with ts and tt
             pS->CopyTo(pT);
-            pT->ApplyOperator(uiM, pGaugeFeild);
+            SOperatorFusion fusionT(EOF_DotSource | EOF_Norm);
+            pT->ApplyOperatorFused(uiM, pGaugeFeild, fusionT);
 
 #if !_CLG_DOUBLEFLOAT
-            omega = cuCdivf_cd_host(pS->Dot(pT), pT->Dot(pT).x);//omega = ts / tt
+            omega = cuCdivf_cd_host(fusionT.m_cDot, fusionT.m_fNorm);//omega = ts / tt
 #else
-            omega = cuCdivf_cr_host(pS->Dot(pT), pT->Dot(pT).x);//omega = ts / tt
+            omega = cuCdivf_cr_host(fusionT.m_cDot, fusionT.m_fNorm);//omega = ts / tt
 #endif
 
             //r(i)=s-omega t
-            pS->CopyTo(pR);
-            
+            appFieldAssign(pR, appField(pS) - omega * appField(pT));
+
 #if !_CLG_DOUBLEFLOAT
-            pR->Axpy(_make_cuComplex(-static_cast<Real>(omega.x), -static_cast<Real>(omega.y)), pT);
             beta = cuCdiv(alpha, cuCmul(omega, rho));
             rho = pRh->Dot(pR);
             beta = cuCmul(beta, rho);
-
-            //x(i)=x(i-1) + alpha p + omega s
-            pX->Axpy(_cToFloat(alpha), pP);
-            pX->Axpy(_cToFloat(omega), pS);
-
-            //p(i) = r(i-1)+beta( p(i-1) - last_omega v(i-1) )
-            pV->ScalarMultply(_cToFloat(omega));
-            pP->AxpyMinus(pV);
-            pP->ScalarMultply(_cToFloat(beta));
-            pP->AxpyPlus(pR);
 #else
-            pR->Axpy(_make_cuComplex(-omega.x, -omega.y), pT);
             beta = _cuCdivf(alpha, _cuCmulf(omega, rho));
             rho = pRh->Dot(pR);
             beta = _cuCmulf(beta, rho);
+#endif
 
             //x(i)=x(i-1) + alpha p + omega s
-            pX->Axpy(alpha, pP);
-            pX->Axpy(omega, pS);
+            appFieldAssign(pX, appField(pX) + alpha * appField(pP) + omega * appField(pS));
 
             //p(i) = r(i-1)+beta( p(i-1) - last_omega v(i-1) )
-            pV->ScalarMultply(omega);
-            pP->AxpyMinus(pV);
-            pP->ScalarMultply(beta);
-            pP->AxpyPlus(pR);
-#endif
+            appFieldAssign(pP, appField(pR) + beta * (appField(pP) - omega * appField(pV)));
 
 
         }
@@ -600,6 +582,7 @@ UBOOL CSLASolverBiCGStab::Solve(CField* pFieldX, const CField* pFieldB, const CF
     pRh->Return();
     pS->Return();
     pT->Return();
+    m_kSolveTimer.Stop();
     return FALSE;
 }
 
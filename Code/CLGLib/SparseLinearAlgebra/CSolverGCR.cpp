@@ -84,6 +84,8 @@ void CSLASolverGCR::ReleaseBuffers()
 
 UBOOL CSLASolverGCR::Solve(CField* pFieldX, const CField* pFieldB, const CFieldGauge* pGaugeFeild, EFieldOperator uiM, ESolverPhase ePhase, const CField* pStart)
 {
+    appProfile(GetClass()->GetName());
+    m_kSolveTimer.Start();
     TArray<CField*> pP;
     TArray<CField*> pAP;
     TArray<Real> length_AP;
@@ -128,22 +130,24 @@ UBOOL CSLASolverGCR::Solve(CField* pFieldX, const CField* pFieldB, const CFieldG
     {
         //r = b - A x0, p0 = r
         pX->CopyTo(pR); 
-        pR->ApplyOperator(uiM, pGaugeFeild, EOCT_Minus); //r = -A x0
-        pR->AxpyPlus(pFieldB); //r = b-Ax0
+        SOperatorFusion fusionR(EOF_BMinus, pFieldB);
+        pR->ApplyOperatorFused(uiM, pGaugeFeild, fusionR); //r = b-Ax0
         pR->CopyTo(pP[0]);
 
         for (UINT jj = 0; jj < m_uiIterateNumber; ++jj)
         {
+            ++m_uiIterationCount;
             const UINT j = jj % m_uiMaxDim;
 
             pP[j]->CopyTo(pAP[j]);
-            pAP[j]->ApplyOperator(uiM, pGaugeFeild);
+            SOperatorFusion fusionAP(EOF_Norm);
+            pAP[j]->ApplyOperatorFused(uiM, pGaugeFeild, fusionAP);
             //appParanoiac(_T("length p = %f ap = %f r = %f\n"), pP[j]->Dot(pP[j]).x, length_AP[j], pR->Dot(pR).x);
 #if !_CLG_DOUBLEFLOAT
-            length_AP[j] = static_cast<Real>(pAP[j]->Dot(pAP[j]).x);
+            length_AP[j] = static_cast<Real>(fusionAP.m_fNorm);
             CLGComplex al = cuCdivf_cr_host(_cToFloat(pAP[j]->Dot(pR)), length_AP[j]);
 #else
-            length_AP[j] = pAP[j]->Dot(pAP[j]).x;
+            length_AP[j] = fusionAP.m_fNorm;
             CLGComplex al = cuCdivf_cr_host(pAP[j]->Dot(pR), length_AP[j]);
 #endif
 
@@ -170,6 +174,7 @@ UBOOL CSLASolverGCR::Solve(CField* pFieldX, const CField* pFieldB, const CFieldG
                         pP[k]->Return();
                         pAP[k]->Return();
                     }
+                    m_kSolveTimer.Stop();
                     return TRUE;
                 }
             }
@@ -211,6 +216,7 @@ UBOOL CSLASolverGCR::Solve(CField* pFieldX, const CField* pFieldB, const CFieldG
         pP[k]->Return();
         pAP[k]->Return();
     }
+    m_kSolveTimer.Stop();
     return FALSE;
 }
 
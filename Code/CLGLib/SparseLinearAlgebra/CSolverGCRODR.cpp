@@ -200,6 +200,8 @@ void CSLASolverGCRODR::ReleaseBuffers()
 
 UBOOL CSLASolverGCRODR::Solve(CField* pFieldX, const CField* pFieldB, const CFieldGauge* pFieldGauge, EFieldOperator uiM, ESolverPhase ePhase, const CField* pStart)
 {
+    appProfile(GetClass()->GetName());
+    m_kSolveTimer.Start();
     //use it to estimate relative error
     Real fBLength = F(1.0);
     if (!m_bAbsoluteAccuracy)
@@ -251,6 +253,7 @@ UBOOL CSLASolverGCRODR::Solve(CField* pFieldX, const CField* pFieldB, const CFie
         pX->Return();
         pW->Return();
         ReleasePooledFields();
+        m_kSolveTimer.Stop();
         return TRUE;
     }
 
@@ -275,6 +278,7 @@ UBOOL CSLASolverGCRODR::Solve(CField* pFieldX, const CField* pFieldB, const CFie
         //Arnoldi
         for (UINT j = m_uiKDim; j < m_uiMDim; ++j)
         {
+            ++m_uiIterationCount;
             CField* vj = GetW(j);
             CField* vjp1 = GetW(j + 1);
             vj->CopyTo(pW);
@@ -345,13 +349,9 @@ UBOOL CSLASolverGCRODR::Solve(CField* pFieldX, const CField* pFieldB, const CFie
         {
             //============== This is the accurate result, though, slower and not stable =================
             pX->CopyTo(pW);
-            pW->ApplyOperator(uiM, pFieldGauge, EOCT_Minus); //x0 = -A x0
-            pW->AxpyPlus(pFieldB); //x0 = b-Ax0
-#if !_CLG_DOUBLEFLOAT
-            m_cLastDiviation = _cToFloat(pW->Dot(pW));
-#else
-            m_cLastDiviation = pW->Dot(pW);
-#endif
+            SOperatorFusion fusion(EOF_BMinus | EOF_Norm, pFieldB);
+            pW->ApplyOperatorFused(uiM, pFieldGauge, fusion); //x0 = b-Ax0
+            m_cLastDiviation = _make_cuComplex(static_cast<Real>(fusion.m_fNorm), F(0.0));
             m_fDiviation = _hostsqrt(m_cLastDiviation.x);
         }
         else
@@ -386,6 +386,7 @@ UBOOL CSLASolverGCRODR::Solve(CField* pFieldX, const CField* pFieldB, const CFie
             pX->Return();
             pW->Return();
             ReleasePooledFields();
+            m_kSolveTimer.Stop();
             return TRUE;
         }
         appParanoiac(_T("-- GCRODR::Solve operator: After %d step |residue|=%1.15f ----\n"), i, m_fDiviation);
@@ -397,6 +398,7 @@ UBOOL CSLASolverGCRODR::Solve(CField* pFieldX, const CField* pFieldB, const CFie
     pX->Return();
     pW->Return();
     ReleasePooledFields();
+    m_kSolveTimer.Stop();
     return FALSE;
 }
 
@@ -410,12 +412,12 @@ void CSLASolverGCRODR::FirstTimeGMERESSolve(CField* pX, CField* pR, const CField
 
     CField* v0 = GetW(0);
     pX->CopyTo(v0); //x0 need to be preserved
-    v0->ApplyOperator(uiM, pGaugeFeild, EOCT_Minus); //x0 = -A x0
-    v0->AxpyPlus(pFieldB); //x0 = b-Ax0
+    SOperatorFusion fusion(EOF_BMinus | EOF_Norm, pFieldB);
+    v0->ApplyOperatorFused(uiM, pGaugeFeild, fusion); //x0 = b-Ax0
 #if !_CLG_DOUBLEFLOAT
-    m_fBeta = static_cast<Real>(_hostsqrtd(v0->Dot(v0).x));
+    m_fBeta = static_cast<Real>(_hostsqrtd(fusion.m_fNorm));
 #else
-    m_fBeta = _hostsqrt(v0->Dot(v0).x);
+    m_fBeta = _hostsqrt(fusion.m_fNorm);
 #endif
     v0->ScalarMultply(F(1.0) / m_fBeta);  //v[0] = (b - A x0).normalize
     memcpy(m_pHostHmGm, m_pHostZeroMatrix, sizeof(CLGComplex) * (m_uiMDim + 1) * m_uiMDim);
@@ -423,6 +425,7 @@ void CSLASolverGCRODR::FirstTimeGMERESSolve(CField* pX, CField* pR, const CField
     //Arnoldi
     for (UINT j = 0; j < m_uiMDim; ++j)
     {
+        ++m_uiIterationCount;
         CField* vj = GetW(j);
         CField* vjp1 = GetW(j + 1);
         vj->CopyTo(vjp1);
@@ -486,13 +489,9 @@ void CSLASolverGCRODR::FirstTimeGMERESSolve(CField* pX, CField* pR, const CField
     else
     {
         pX->CopyTo(pR);
-        pR->ApplyOperator(uiM, pGaugeFeild, EOCT_Minus); //x0 = -A x0
-        pR->AxpyPlus(pFieldB); //x0 = b-Ax0
-#if !_CLG_DOUBLEFLOAT
-        m_cLastDiviation = _cToFloat(pR->Dot(pR));
-#else
-        m_cLastDiviation = pR->Dot(pR);
-#endif
+        SOperatorFusion fusionR(EOF_BMinus | EOF_Norm, pFieldB);
+        pR->ApplyOperatorFused(uiM, pGaugeFeild, fusionR); //x0 = b-Ax0
+        m_cLastDiviation = _make_cuComplex(static_cast<Real>(fusionR.m_fNorm), F(0.0));
         m_fDiviation = _hostsqrt(m_cLastDiviation.x);
     }
 
@@ -509,6 +508,7 @@ void CSLASolverGCRODR::QRFactorAY(const CFieldGauge* pGaugeField, EFieldOperator
         }
 
         //transform Y to AY
+        ++m_uiIterationCount;
         m_lstU[i]->CopyTo(m_lstC[i]);
         m_lstC[i]->ApplyOperator(uiM, pGaugeField);
     }
@@ -825,14 +825,10 @@ void CSLASolverGCRODR::GenerateCUFirstTime(CField* pX, CField* pR, const CField*
     //CField* v0 = m_lstV[0];
 
     pX->CopyTo(pR);
-    pR->ApplyOperator(uiM, pGaugeField, EOCT_Minus); //r0 = -A x0
-    pR->AxpyPlus(pFieldB); //r0 = b-Ax0
+    SOperatorFusion fusion(EOF_BMinus | EOF_Norm, pFieldB);
+    pR->ApplyOperatorFused(uiM, pGaugeField, fusion); //r0 = b-Ax0
 
-#if !_CLG_DOUBLEFLOAT
-    m_cLastDiviation = _cToFloat(pR->Dot(pR));
-#else
-    m_cLastDiviation = pR->Dot(pR);
-#endif
+    m_cLastDiviation = _make_cuComplex(static_cast<Real>(fusion.m_fNorm), F(0.0));
     m_fDiviation = _hostsqrt(__cuCabsSqf(m_cLastDiviation));
 }
 
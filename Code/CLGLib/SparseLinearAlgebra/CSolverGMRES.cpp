@@ -109,6 +109,8 @@ void CSLASolverGMRES::ReleaseBuffers()
 
 UBOOL CSLASolverGMRES::Solve(CField* pFieldX, const CField* pFieldB, const CFieldGauge* pGaugeFeild, EFieldOperator uiM, ESolverPhase ePhase, const CField* pStart)
 {
+    appProfile(GetClass()->GetName());
+    m_kSolveTimer.Start();
     assert(0 == m_lstVectors.Num());
     for (UINT i = 0; i < m_uiMaxDim; ++i)
     {
@@ -153,18 +155,19 @@ UBOOL CSLASolverGMRES::Solve(CField* pFieldX, const CField* pFieldB, const CFiel
         //v[0] = r.normalize
         //s = x0
         pX->CopyTo(pR); //x0 need to be preserved
-        pR->ApplyOperator(uiM, pGaugeFeild, EOCT_Minus); //x0 = -A x0
-        pR->AxpyPlus(pFieldB); //x0 = b-Ax0
+        SOperatorFusion fusion(EOF_BMinus | EOF_Norm, pFieldB);
+        pR->ApplyOperatorFused(uiM, pGaugeFeild, fusion); //x0 = b-Ax0
 #if !_CLG_DOUBLEFLOAT
-        m_fBeta = _sqrtd(m_lstVectors[0]->Dot(m_lstVectors[0]).x);
+        m_fBeta = _sqrtd(fusion.m_fNorm);
         m_lstVectors[0]->ScalarMultply(static_cast<Real>(1.0 / m_fBeta));  //v[0] = (b - A x0).normalize
 #else
-        m_fBeta = _sqrt(m_lstVectors[0]->Dot(m_lstVectors[0]).x);
+        m_fBeta = _sqrt(fusion.m_fNorm);
         m_lstVectors[0]->ScalarMultply(F(1.0) / m_fBeta);  //v[0] = (b - A x0).normalize
 #endif
         
         for (UINT j = 0; j < m_uiMaxDim; ++j)
         {
+            ++m_uiIterationCount;
             //w = A v[j]
             m_lstVectors[j]->CopyTo(pW);
             pW->ApplyOperator(uiM, pGaugeFeild);
@@ -238,6 +241,7 @@ UBOOL CSLASolverGMRES::Solve(CField* pFieldX, const CField* pFieldB, const CFiel
                 m_lstVectors[k]->Return();
             }
             m_lstVectors.RemoveAll();
+            m_kSolveTimer.Stop();
             return TRUE;
         }
         appParanoiac(_T("CSLASolverGMRES::Solve deviation: ---- restart ----. last divation = %8.15f\n"), fLastDiavation);
@@ -253,6 +257,7 @@ UBOOL CSLASolverGMRES::Solve(CField* pFieldX, const CField* pFieldB, const CFiel
         m_lstVectors[i]->Return();
     }
     m_lstVectors.RemoveAll();
+    m_kSolveTimer.Stop();
     return FALSE;
 }
 
@@ -17,9 +17,10 @@ void CSLASolverGMRESMDR::GenerateCUFirstTime(CField* pX, CField* pR, const CFiel
 {
     QRFactorizationOfUk();
 
-    //Change Ck to AQk
+    //Change Ck to AQk, each is one operator application, counted as iteration
     for (UINT i = 0; i < m_uiKDim; ++i)
     {
+        ++m_uiIterationCount;
         m_lstU[i]->CopyTo(m_lstC[i]);
         m_lstC[i]->ApplyOperator(uiM, pGaugeField);
     }
@@ -120,14 +121,10 @@ void CSLASolverGMRESMDR::GenerateCUFirstTime(CField* pX, CField* pR, const CFiel
 
     //Initial X and R
     pX->CopyTo(pR);
-    pR->ApplyOperator(uiM, pGaugeField, EOCT_Minus); //r0 = -A x0
-    pR->AxpyPlus(pFieldB); //r0 = b-Ax0
+    SOperatorFusion fusion(EOF_BMinus | EOF_Norm, pFieldB);
+    pR->ApplyOperatorFused(uiM, pGaugeField, fusion); //r0 = b-Ax0
 
-#if !_CLG_DOUBLEFLOAT
-    m_cLastDiviation = _cToFloat(pR->Dot(pR));
-#else
-    m_cLastDiviation = pR->Dot(pR);
-#endif
+    m_cLastDiviation = _make_cuComplex(static_cast<Real>(fusion.m_fNorm), F(0.0));
     m_fDiviation = _hostsqrt(__cuCabsSqf(m_cLastDiviation));
 }
 
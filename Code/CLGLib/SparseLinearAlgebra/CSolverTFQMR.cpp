@@ -71,6 +71,8 @@ void CSolverTFQMR::ReleaseBuffers()
 
 UBOOL CSolverTFQMR::Solve(CField* pFieldX, const CField* pFieldB, const CFieldGauge* pGaugeFeild, EFieldOperator uiM, ESolverPhase ePhase, const CField* pStart)
 {
+    appProfile(GetClass()->GetName());
+    m_kSolveTimer.Start();
     CField* pX = appGetLattice()->GetPooledFieldById(pFieldB->m_byFieldId);
     CField* pD = appGetLattice()->GetPooledFieldById(pFieldB->m_byFieldId);
     CField* pV = appGetLattice()->GetPooledFieldById(pFieldB->m_byFieldId);
@@ -110,8 +112,8 @@ UBOOL CSolverTFQMR::Solve(CField* pFieldX, const CField* pFieldB, const CFieldGa
     UBOOL bDone = FALSE;
     for (UINT i = 0; i < m_uiReTry; ++i)
     {
-        pV->ApplyOperator(uiM, pGaugeFeild, EOCT_Minus); //-A x_0
-        pV->AxpyPlus(pFieldB); //pR->AxpyPlus(pB); //b - A x_0
+        SOperatorFusion fusionR(EOF_BMinus | EOF_Norm, pFieldB);
+        pV->ApplyOperatorFused(uiM, pGaugeFeild, fusionR); //b - A x_0
         pV->CopyTo(pRh);
         pRh->Dagger();
 
@@ -122,9 +124,9 @@ UBOOL CSolverTFQMR::Solve(CField* pFieldX, const CField* pFieldB, const CFieldGa
 
         Real thetaSq = F(0.0);
 #if !_CLG_DOUBLEFLOAT
-        Real tau = static_cast<Real>(_sqrtd(pU->Dot(pU).x));
+        Real tau = static_cast<Real>(_sqrtd(fusionR.m_fNorm));
 #else
-        Real tau = _sqrt(pU->Dot(pU).x);
+        Real tau = _sqrt(fusionR.m_fNorm);
 #endif
 
 #if !_CLG_DOUBLEFLOAT
@@ -137,6 +139,7 @@ UBOOL CSolverTFQMR::Solve(CField* pFieldX, const CField* pFieldB, const CFieldGa
 
         for (UINT j = 0; j < m_uiStepCount * m_uiDevationCheck; ++j)
         {
+            ++m_uiIterationCount;
             //==========
             //One step
             const Real fErrorRho = __cuCabsSqf(rho);
@@ -166,8 +169,7 @@ UBOOL CSolverTFQMR::Solve(CField* pFieldX, const CField* pFieldB, const CFieldGa
             }
             else
             {
-                pD->ScalarMultply(_cuCmulf(_cuCdivf(_make_cuComplex(thetaSq, F(0.0)), alpha), eta));
-                pD->AxpyPlus(pU);
+                appFieldAssign(pD, _cuCmulf(_cuCdivf(_make_cuComplex(thetaSq, F(0.0)), alpha), eta) * appField(pD) + appField(pU));
             }
 #if !_CLG_DOUBLEFLOAT
             thetaSq = static_cast<Real>(pW->Dot(pW).x / (tau * tau));
@@ -189,12 +191,8 @@ UBOOL CSolverTFQMR::Solve(CField* pFieldX, const CField* pFieldB, const CFieldGa
 #endif
                 CLGComplex beta = _cuCdivf(newRho, rho);
                 rho = newRho;
-                pU->ScalarMultply(beta);
-                pU->AxpyPlus(pW);
-
-                pV->ScalarMultply(beta);
-                pV->AxpyPlus(pAU);
-                pV->ScalarMultply(beta); //v = beta (Au(m) + beta v(m))
+                appFieldAssign(pU, beta * appField(pU) + appField(pW));
+                appFieldAssign(pV, beta * (appField(pAU) + beta * appField(pV))); //v = beta (Au(m) + beta v(m))
 
                 pU->CopyTo(pAU);
                 pAU->ApplyOperator(uiM, pGaugeFeild);
@@ -245,6 +243,7 @@ UBOOL CSolverTFQMR::Solve(CField* pFieldX, const CField* pFieldB, const CFieldGa
     pU->Return();
     pW->Return();
     pRh->Return();
+    m_kSolveTimer.Stop();
     return bDone;
 }
 
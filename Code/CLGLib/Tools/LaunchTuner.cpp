@@ -0,0 +1,368 @@
+//=============================================================================
+// FILENAME : LaunchTuner.cpp
+//
+// DESCRIPTION:
+// This is the launch configuration autotuner
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#include "CLGLib_Private.h"
+
+__BEGIN_NAMESPACE
+
+CLGAPI CLaunchTuner GLaunchTuner;
+
+void CLaunchTuner::Initial(const CCString& sTuneFile, UINT uiRepeat)
+{
+    if (m_bEnabled)
+    {
+        Release();
+    }
+    m_sTuneFile = sTuneFile;
+    m_uiRepeat = uiRepeat > 0 ? uiRepeat : 1;
+    m_lstTunes.RemoveAll();
+    m_lstCandidates.RemoveAll();
+    memset(m_uiCandidateLattice, 0, sizeof(UINT) * 4);
+
+    checkCudaErrors(cudaEventCreate(&m_pStart));
+    checkCudaErrors(cudaEventCreate(&m_pStop));
+    Load();
+    m_bEnabled = TRUE;
+}
+
+void CLaunchTuner::UpdateCandidates()
+{
+    const UINT uiLattice[4] = { _HC_Lx, _HC_Ly, _HC_Lz, _HC_Lt };
+    if (m_lstCandidates.Num() > 0 && 0 == memcmp(uiLattice, m_uiCandidateLattice, sizeof(UINT) * 4))
+    {
+        return;
+    }
+    memcpy(m_uiCandidateLattice, uiLattice, sizeof(UINT) * 4);
+    m_lstCandidates.RemoveAll();
+
+    UINT uiMaxThread = _HC_ThreadConstraint;
+    if (uiMaxThread > _CLG_LAUNCH_MAX_THREAD)
+    {
+        uiMaxThread = _CLG_LAUNCH_MAX_THREAD;
+    }
+    const TArray<UINT> factorsOfX = _getFactors(uiLattice[0] * uiLattice[1]);
+    const TArray<UINT> factorsOfY = _getFactors(uiLattice[2]);
+    const TArray<UINT> factorsOfZ = _getFactors(uiLattice[3]);
+    for (INT i = 0; i < factorsOfX.Num(); ++i)
+    {
+        for (INT j = 0; j < factorsOfY.Num(); ++j)
+        {
+            for (INT k = 0; k < factorsOfZ.Num(); ++k)
+            {
+                const UBOOL bDefault = (factorsOfX[i] == _HC_DecompLx && factorsOfY[j] == _HC_DecompLy && factorsOfZ[k] == _HC_DecompLz);
+                const UINT uiThreadPerBlock = factorsOfX[i] * factorsOfY[j] * factorsOfZ[k];
+
+                //only full warps, the default is always a candidate
+                if (bDefault
+                 || (factorsOfX[i] <= _HC_ThreadConstraintX
+                  && factorsOfY[j] <= _HC_ThreadConstraintY
+                  && factorsOfZ[k] <= _HC_ThreadConstraintZ
+                  && uiThreadPerBlock <= uiMaxThread
+                  && 0 == (uiThreadPerBlock & 31)))
+                {
+                    m_lstCandidates.AddItem(factorsOfX[i]);
+                    m_lstCandidates.AddItem(factorsOfY[j]);
+                    m_lstCandidates.AddItem(factorsOfZ[k]);
+                }
+            }
+        }
+    }
+}
+
+void CLaunchTuner::UpdateDevice()
+{
+    if (m_sDevice.IsEmpty())
+    {
+        INT iDevice = 0;
+        checkCudaErrors(cudaGetDevice(&iDevice));
+        cudaDeviceProp prop;
+        checkCudaErrors(cudaGetDeviceProperties(&prop, iDevice));
+        TCHAR buff[256];
+        appSprintf(buff, 256, _T("%s"), prop.name);
+        for (INT i = 0; 0 != buff[i]; ++i)
+        {
+            if (_T(' ') == buff[i] || _T('\t') == buff[i])
+            {
+                buff[i] = _T('_');
+            }
+        }
+        m_sDevice = buff;
+    }
+}
+
+UBOOL CLaunchTuner::IsTuned(const TCHAR* sName)
+{
+    UpdateDevice();
+    const UINT uiLattice[4] = { _HC_Lx, _HC_Ly, _HC_Lz, _HC_Lt };
+    for (INT i = 0; i < m_lstTunes.Num(); ++i)
+    {
+        const SLaunchTune& tune = m_lstTunes[i];
+        if (0 == memcmp(uiLattice, tune.m_uiLattice, sizeof(UINT) * 4)
+         && tune.m_sDevice == m_sDevice
+         && 0 == appStrcmp(tune.m_sName.c_str(), sName))
+        {
+            return tune.m_bTuned;
+        }
+    }
+    return FALSE;
+}
+
+INT CLaunchTuner::FindTune(const TCHAR* sName)
+{
+    UpdateDevice();
+
+    const UINT uiLattice[4] = { _HC_Lx, _HC_Ly, _HC_Lz, _HC_Lt };
+    for (INT i = 0; i < m_lstTunes.Num(); ++i)
+    {
+        SLaunchTune& tune = m_lstTunes[i];
+        if (0 != memcmp(uiLattice, tune.m_uiLattice, sizeof(UINT) * 4)
+         || tune.m_sDevice != m_sDevice
+         || 0 != appStrcmp(tune.m_sName.c_str(), sName))
+        {
+            continue;
+        }
+
+        if (tune.m_bLoaded)
+        {
+            tune.m_bLoaded = FALSE;
+            const UINT uiThreadPerBlock = tune.m_uiThreads[0] * tune.m_uiThreads[1] * tune.m_uiThreads[2];
+            if (uiThreadPerBlock > _HC_ThreadConstraint || uiThreadPerBlock > _CLG_LAUNCH_MAX_THREAD)
+            {
+                appGeneral(_T("CLaunchTuner: %s in %s exceeds the thread constraint, tune again.\n"), sName, m_sTuneFile.c_str());
+                tune.m_bTuned = FALSE;
+            }
+        }
+        return i;
+    }
+
+    SLaunchTune newTune;
+    newTune.m_sName = sName;
+    newTune.m_sDevice = m_sDevice;
+    memcpy(newTune.m_uiLattice, uiLattice, sizeof(UINT) * 4);
+    newTune.m_uiThreads[0] = _HC_DecompLx;
+    newTune.m_uiThreads[1] = _HC_DecompLy;
+    newTune.m_uiThreads[2] = _HC_DecompLz;
+    newTune.m_bTuned = FALSE;
+    newTune.m_bLoaded = FALSE;
+    newTune.m_iCandidate = -1;
+    newTune.m_uiRepeat = 0;
+    newTune.m_fTime = 0.0f;
+    newTune.m_fBestTime = 0.0f;
+    return m_lstTunes.AddItem(newTune);
+}
+
+void CLaunchTuner::PrepareTune(const TCHAR* sName, SLaunchTuneCall& call)
+{
+    const INT iTune = FindTune(sName);
+    SLaunchTune& tune = m_lstTunes[iTune];
+    if (!tune.m_bTuned)
+    {
+        UpdateCandidates();
+        if (m_lstCandidates.Num() < 6)
+        {
+            //nothing to choose
+            tune.m_bTuned = TRUE;
+        }
+    }
+
+    if (tune.m_bTuned)
+    {
+        for (BYTE i = 0; i < 3; ++i)
+        {
+            call.m_uiThreads[i] = tune.m_uiThreads[i];
+        }
+        call.m_uiBlocks[0] = tune.m_uiLattice[0] * tune.m_uiLattice[1] / tune.m_uiThreads[0];
+        call.m_uiBlocks[1] = tune.m_uiLattice[2] / tune.m_uiThreads[1];
+        call.m_uiBlocks[2] = tune.m_uiLattice[3] / tune.m_uiThreads[2];
+        return;
+    }
+
+    //the first launch is a warm up with the default
+    if (tune.m_iCandidate >= 0)
+    {
+        const UINT* pCandidate = m_lstCandidates.GetData() + 3 * tune.m_iCandidate;
+        for (BYTE i = 0; i < 3; ++i)
+        {
+            call.m_uiThreads[i] = pCandidate[i];
+        }
+        call.m_uiBlocks[0] = m_uiCandidateLattice[0] * m_uiCandidateLattice[1] / pCandidate[0];
+        call.m_uiBlocks[1] = m_uiCandidateLattice[2] / pCandidate[1];
+        call.m_uiBlocks[2] = m_uiCandidateLattice[3] / pCandidate[2];
+    }
+    call.m_iTune = iTune;
+    checkCudaErrors(cudaEventRecord(m_pStart, 0));
+}
+
+void CLaunchTuner::FinishTune(const SLaunchTuneCall& call)
+{
+    checkCudaErrors(cudaEventRecord(m_pStop, 0));
+    checkCudaErrors(cudaEventSynchronize(m_pStop));
+
+    SLaunchTune& tune = m_lstTunes[call.m_iTune];
+    if (tune.m_iCandidate < 0)
+    {
+        tune.m_iCandidate = 0;
+        return;
+    }
+
+    FLOAT fTime = 0.0f;
+    checkCudaErrors(cudaEventElapsedTime(&fTime, m_pStart, m_pStop));
+    tune.m_fTime += fTime;
+    ++tune.m_uiRepeat;
+    if (tune.m_uiRepeat < m_uiRepeat)
+    {
+        return;
+    }
+
+    const FLOAT fAverage = tune.m_fTime / tune.m_uiRepeat;
+    if (0 == tune.m_iCandidate || fAverage < tune.m_fBestTime)
+    {
+        tune.m_fBestTime = fAverage;
+        for (BYTE i = 0; i < 3; ++i)
+        {
+            tune.m_uiThreads[i] = call.m_uiThreads[i];
+        }
+    }
+    tune.m_fTime = 0.0f;
+    tune.m_uiRepeat = 0;
+    ++tune.m_iCandidate;
+
+    if (3 * tune.m_iCandidate >= m_lstCandidates.Num())
+    {
+        tune.m_bTuned = TRUE;
+        appDetailed(_T("CLaunchTuner: %s tuned with (xy %d x z %d x t %d) threads per block, %f ms, default is (xy %d x z %d x t %d)\n"),
+            tune.m_sName.c_str(),
+            tune.m_uiThreads[0], tune.m_uiThreads[1], tune.m_uiThreads[2],
+            tune.m_fBestTime,
+            _HC_DecompLx, _HC_DecompLy, _HC_DecompLz);
+        Save();
+    }
+}
+
+/**
+* One line for each kernel:
+* name device Lx Ly Lz Lt threadxy threadz threadt time(ms)
+*/
+void CLaunchTuner::Load()
+{
+    if (m_sTuneFile.IsEmpty() || !CFileSystem::IsFileExist(m_sTuneFile))
+    {
+        return;
+    }
+
+    const CCString sContent = appGetFileSystem()->ReadAllText(m_sTuneFile.c_str());
+    TArray<INT> lineSeps;
+    lineSeps.AddItem(_T('\n'));
+    lineSeps.AddItem(_T('\r'));
+    TArray<INT> wordSeps;
+    wordSeps.AddItem(_T(' '));
+    wordSeps.AddItem(_T('\t'));
+    const TArray<CCString> sLines = appGetStringList(sContent, lineSeps, EGSLF_IgnorEmety);
+    for (INT i = 0; i < sLines.Num(); ++i)
+    {
+        const TArray<CCString> sWords = appGetStringList(sLines[i], wordSeps, EGSLF_IgnorEmety);
+        if (10 != sWords.Num() || _T('#') == sWords[0].c_str()[0])
+        {
+            continue;
+        }
+
+        SLaunchTune tune;
+        tune.m_sName = sWords[0];
+        tune.m_sDevice = sWords[1];
+        for (INT j = 0; j < 4; ++j)
+        {
+            tune.m_uiLattice[j] = static_cast<UINT>(appStrToINT(sWords[2 + j]));
+        }
+        for (INT j = 0; j < 3; ++j)
+        {
+            tune.m_uiThreads[j] = static_cast<UINT>(appStrToINT(sWords[6 + j]));
+        }
+        tune.m_bTuned = TRUE;
+        tune.m_bLoaded = TRUE;
+        tune.m_iCandidate = -1;
+        tune.m_uiRepeat = 0;
+        tune.m_fTime = 0.0f;
+        tune.m_fBestTime = static_cast<FLOAT>(appStrToDOUBLE(sWords[9]));
+
+        if (0 == tune.m_uiThreads[0] || 0 == tune.m_uiThreads[1] || 0 == tune.m_uiThreads[2]
+         || !__Divisible(tune.m_uiLattice[0] * tune.m_uiLattice[1], tune.m_uiThreads[0])
+         || !__Divisible(tune.m_uiLattice[2], tune.m_uiThreads[1])
+         || !__Divisible(tune.m_uiLattice[3], tune.m_uiThreads[2]))
+        {
+            appGeneral(_T("CLaunchTuner: line %d of %s is invalid, ignored.\n"), i, m_sTuneFile.c_str());
+            continue;
+        }
+        m_lstTunes.AddItem(tune);
+    }
+    appGeneral(_T("CLaunchTuner: %d launch configurations loaded from %s\n"), m_lstTunes.Num(), m_sTuneFile.c_str());
+}
+
+void CLaunchTuner::Save() const
+{
+    if (m_sTuneFile.IsEmpty())
+    {
+        return;
+    }
+
+    OFSTREAM file(m_sTuneFile.c_str());
+    if (!file.good())
+    {
+        appCrucial(_T("CLaunchTuner: cannot open %s\n"), m_sTuneFile.c_str());
+        return;
+    }
+
+    file << _T("# name device Lx Ly Lz Lt threadxy threadz threadt time(ms)\n");
+    TCHAR buff[1024];
+    for (INT i = 0; i < m_lstTunes.Num(); ++i)
+    {
+        const SLaunchTune& tune = m_lstTunes[i];
+        if (!tune.m_bTuned)
+        {
+            continue;
+        }
+        appSprintf(buff, 1024, _T("%s %s %d %d %d %d %d %d %d %f\n"),
+            tune.m_sName.c_str(), tune.m_sDevice.c_str(),
+            tune.m_uiLattice[0], tune.m_uiLattice[1], tune.m_uiLattice[2], tune.m_uiLattice[3],
+            tune.m_uiThreads[0], tune.m_uiThreads[1], tune.m_uiThreads[2],
+            tune.m_fBestTime);
+        file << buff;
+    }
+    file.flush();
+    file.close();
+}
+
+void CLaunchTuner::Release()
+{
+    if (!m_bEnabled)
+    {
+        return;
+    }
+
+    Save();
+    if (NULL != m_pStart)
+    {
+        cudaEventDestroy(m_pStart);
+        m_pStart = NULL;
+    }
+    if (NULL != m_pStop)
+    {
+        cudaEventDestroy(m_pStop);
+        m_pStop = NULL;
+    }
+    m_lstTunes.RemoveAll();
+    m_lstCandidates.RemoveAll();
+    m_bEnabled = FALSE;
+}
+
+__END_NAMESPACE
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
@@ -0,0 +1,168 @@
+//=============================================================================
+// FILENAME : LaunchTuner.h
+//
+// DESCRIPTION:
+// This is the launch configuration autotuner
+//
+// preparethread uses one block shape (_getDecompose) for all kernels,
+// the kernels using preparethread_tuned(name) get their own block shape.
+//
+// The first launches of a kernel on a lattice try the candidate block shapes
+// one after another (each is a valid decompose of the lattice, so the results
+// are not changed), timed with cuda events.
+// When all candidates are tried, the fastest one is used and is written to
+// the "LaunchTuneFile", the file is read next time, so the tuning is only done
+// once for each kernel, lattice and device.
+// The entries are keyed by the kernel name (not the address of the literal),
+// so the same name in different translation units is the same entry.
+//
+// It is enabled by "LaunchTune : 1" in the parameters.
+//
+// The kernel must use intokernal, intokernaldir or intokernalInt4,
+// and must be _CLG_LAUNCH_BOUND (the candidates use up to _CLG_LAUNCH_MAX_THREAD threads)
+//
+//     preparethread_tuned(_T("_kernelAxpyPlusFermionKS"));
+//     _kernelAxpyPlusFermionKS << <block, threads >> > (...);
+//     finishthread_tuned;
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#ifndef _LAUNCHTUNER_H_
+#define _LAUNCHTUNER_H_
+
+__BEGIN_NAMESPACE
+
+struct CLGAPI SLaunchTune
+{
+    CCString m_sName;
+    CCString m_sDevice;
+    UINT m_uiLattice[4];
+    //threads per block in xy, z, t
+    UINT m_uiThreads[3];
+    UBOOL m_bTuned;
+    //loaded from file and the thread constraint is not checked yet
+    UBOOL m_bLoaded;
+
+    //tuning state
+    INT m_iCandidate;
+    UINT m_uiRepeat;
+    FLOAT m_fTime;
+    //in ms, average of one launch
+    FLOAT m_fBestTime;
+};
+
+struct CLGAPI SLaunchTuneCall
+{
+    //-1 if not timing
+    INT m_iTune;
+    UINT m_uiBlocks[3];
+    UINT m_uiThreads[3];
+};
+
+class CLGAPI CLaunchTuner
+{
+public:
+    CLaunchTuner()
+        : m_bEnabled(FALSE)
+        , m_uiRepeat(2)
+        , m_pStart(NULL)
+        , m_pStop(NULL)
+    {
+        memset(m_uiCandidateLattice, 0, sizeof(UINT) * 4);
+    }
+
+    ~CLaunchTuner()
+    {
+    }
+
+    void Initial(const CCString& sTuneFile, UINT uiRepeat);
+    inline UBOOL IsEnabled() const { return m_bEnabled; }
+
+    /**
+    * Whether the kernel has a tuned block shape on the current lattice and device
+    */
+    UBOOL IsTuned(const TCHAR* sName);
+
+    inline SLaunchTuneCall Prepare(const TCHAR* sName)
+    {
+        SLaunchTuneCall ret;
+        ret.m_iTune = -1;
+        ret.m_uiBlocks[0] = _HC_DecompX;
+        ret.m_uiBlocks[1] = _HC_DecompY;
+        ret.m_uiBlocks[2] = _HC_DecompZ;
+        ret.m_uiThreads[0] = _HC_DecompLx;
+        ret.m_uiThreads[1] = _HC_DecompLy;
+        ret.m_uiThreads[2] = _HC_DecompLz;
+        if (m_bEnabled)
+        {
+            PrepareTune(sName, ret);
+        }
+        return ret;
+    }
+
+    inline void Finish(const SLaunchTuneCall& call)
+    {
+        if (call.m_iTune >= 0)
+        {
+            FinishTune(call);
+        }
+    }
+
+    /**
+    * Save and release the events, must be called before the device is reset.
+    */
+    void Release();
+
+protected:
+
+    void PrepareTune(const TCHAR* sName, SLaunchTuneCall& call);
+    void FinishTune(const SLaunchTuneCall& call);
+
+    INT FindTune(const TCHAR* sName);
+    void UpdateDevice();
+    void UpdateCandidates();
+    void Load();
+    void Save() const;
+
+    UBOOL m_bEnabled;
+    UINT m_uiRepeat;
+    CCString m_sTuneFile;
+    CCString m_sDevice;
+    cudaEvent_t m_pStart;
+    cudaEvent_t m_pStop;
+
+    TArray<SLaunchTune> m_lstTunes;
+
+    //threads per block (xy, z, t) of the current lattice
+    UINT m_uiCandidateLattice[4];
+    TArray<UINT> m_lstCandidates;
+};
+
+extern CLGAPI CLaunchTuner GLaunchTuner;
+
+inline void appInitialLaunchTuner(const CCString& sTuneFile, UINT uiRepeat)
+{
+    GLaunchTuner.Initial(sTuneFile, uiRepeat);
+}
+
+inline void appLaunchTunerRelease()
+{
+    GLaunchTuner.Release();
+}
+
+#define preparethread_tuned(name) \
+const SLaunchTuneCall _tuneCall = GLaunchTuner.Prepare(name); \
+const dim3 block(_tuneCall.m_uiBlocks[0], _tuneCall.m_uiBlocks[1], _tuneCall.m_uiBlocks[2]); \
+const dim3 threads(_tuneCall.m_uiThreads[0], _tuneCall.m_uiThreads[1], _tuneCall.m_uiThreads[2]);
+
+#define finishthread_tuned GLaunchTuner.Finish(_tuneCall);
+
+__END_NAMESPACE
+
+#endif //#ifndef _LAUNCHTUNER_H_
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
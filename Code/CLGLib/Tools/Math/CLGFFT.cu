@@ -20,24 +20,13 @@ __BEGIN_NAMESPACE
 #pragma region kernel
 
 __global__ void _CLG_LAUNCH_BOUND
-_kernelScale(CLGComplex* res, Real fScale)
+_kernelScaleComponents(CLGComplex* res, UINT uiComponents, Real fScale)
 {
     intokernal;
-    res[uiSiteIndex] = cuCmulf_cr(res[uiSiteIndex], fScale);
-}
-
-__global__ void _CLG_LAUNCH_BOUND
-_kernelCopyElementSU3ToC(deviceSU3* su3, CLGComplex* res, BYTE idx)
-{
-    intokernal;
-    res[uiSiteIndex] = su3[uiSiteIndex].m_me[idx];
-}
-
-__global__ void _CLG_LAUNCH_BOUND
-_kernelCopyElementCToSU3(deviceSU3* su3, CLGComplex* res, BYTE idx)
-{
-    intokernal;
-    su3[uiSiteIndex].m_me[idx] = res[uiSiteIndex];
+    for (UINT i = 0; i < uiComponents; ++i)
+    {
+        res[uiSiteIndex * uiComponents + i] = cuCmulf_cr(res[uiSiteIndex * uiComponents + i], fScale);
+    }
 }
 
 #if !_CLG_DOUBLEFLOAT
@@ -52,17 +41,75 @@ _kernelScaleDouble(cuDoubleComplex* res, DOUBLE fScale)
 
 #pragma endregion
 
-UBOOL CCLGFFTHelper::FFT3DWithXYZ(CLGComplex* copied, TArray<INT> dims, UBOOL bForward)
+#pragma region Plan cache
+
+/**
+ * cufftPlanMany is expensive (it may allocate work area), and the plans are
+ * the same for every call with the same lattice, so the plans are created once.
+ * A plan can do both forward and inverse, so the direction is not in the key.
+ */
+struct SCLGFFTPlan
 {
-    cufftHandle plan3d;
-    INT n[3] = { dims[0], dims[1], dims[2] };
+    INT m_iDevice;
+    INT m_iType;
+    INT m_iRank;
+    INT m_iN[3];
+    INT m_iInEmbed[3];
+    INT m_iOutEmbed[3];
+    INT m_iStride;
+    INT m_iDist;
+    INT m_iBatch;
+    cufftHandle m_hPlan;
+};
+
+static TArray<SCLGFFTPlan> _lstFFTPlans;
 
-#if _CLG_DOUBLEFLOAT
+/**
+ * The output has the same stride and dist, outembed = NULL means the same as inembed
+ */
+static UBOOL _getFFTPlan(cufftHandle& plan, cufftType eType, INT iRank, const INT* n,
+    const INT* inembed, const INT* outembed, INT iStride, INT iDist, INT iBatch)
+{
+    if (NULL == outembed)
+    {
+        outembed = inembed;
+    }
+
+    SCLGFFTPlan key;
+    memset(&key, 0, sizeof(SCLGFFTPlan));
+    checkCudaErrors(cudaGetDevice(&key.m_iDevice));
+    key.m_iType = static_cast<INT>(eType);
+    key.m_iRank = iRank;
+    for (INT i = 0; i < iRank; ++i)
+    {
+        key.m_iN[i] = n[i];
+        key.m_iInEmbed[i] = inembed[i];
+        key.m_iOutEmbed[i] = outembed[i];
+    }
+    key.m_iStride = iStride;
+    key.m_iDist = iDist;
+    key.m_iBatch = iBatch;
 
-    const cufftResult planRes = cufftPlanMany(&plan3d, 3, n,
-        n, 1, 1,
-        n, 1, 1,
-        CUFFT_Z2Z, 1);
+    for (INT i = 0; i < _lstFFTPlans.Num(); ++i)
+    {
+        key.m_hPlan = _lstFFTPlans[i].m_hPlan;
+        if (0 == memcmp(&key, &_lstFFTPlans[i], sizeof(SCLGFFTPlan)))
+        {
+            plan = key.m_hPlan;
+            return TRUE;
+        }
+    }
+
+    INT iN[3] = { 0, 0, 0 };
+    INT iInEmbed[3] = { 0, 0, 0 };
+    INT iOutEmbed[3] = { 0, 0, 0 };
+    memcpy(iN, key.m_iN, sizeof(INT) * 3);
+    memcpy(iInEmbed, key.m_iInEmbed, sizeof(INT) * 3);
+    memcpy(iOutEmbed, key.m_iOutEmbed, sizeof(INT) * 3);
+    const cufftResult planRes = cufftPlanMany(&key.m_hPlan, iRank, iN,
+        iInEmbed, iStride, iDist,
+        iOutEmbed, iStride, iDist,
+        eType, iBatch);
 
     if (CUFFT_SUCCESS != planRes)
     {
@@ -70,38 +117,295 @@ UBOOL CCLGFFTHelper::FFT3DWithXYZ(CLGComplex* copied, TArray<INT> dims, UBOOL bF
         return FALSE;
     }
 
-    const cufftResult res3D = cufftExecZ2Z(plan3d, copied, copied, bForward ? CUFFT_FORWARD : CUFFT_INVERSE);
-    if (CUFFT_SUCCESS != res3D)
+    _lstFFTPlans.AddItem(key);
+    plan = key.m_hPlan;
+    return TRUE;
+}
+
+static UBOOL _execFFT(cufftHandle plan, CLGComplex* data, UBOOL bForward)
+{
+#if _CLG_DOUBLEFLOAT
+    const cufftResult res = cufftExecZ2Z(plan, data, data, bForward ? CUFFT_FORWARD : CUFFT_INVERSE);
+#else
+    const cufftResult res = cufftExecC2C(plan, data, data, bForward ? CUFFT_FORWARD : CUFFT_INVERSE);
+#endif
+    if (CUFFT_SUCCESS != res)
     {
-        appCrucial(_T("cufftResult failed! %d\n"), res3D);
+        appCrucial(_T("cufftResult failed! %d\n"), res);
         return FALSE;
     }
+    return TRUE;
+}
 
+#if !_CLG_DOUBLEFLOAT
+static UBOOL _execFFT(cufftHandle plan, cuDoubleComplex* data, UBOOL bForward)
+{
+    const cufftResult res = cufftExecZ2Z(plan, data, data, bForward ? CUFFT_FORWARD : CUFFT_INVERSE);
+    if (CUFFT_SUCCESS != res)
+    {
+        appCrucial(_T("cufftResult failed! %d\n"), res);
+        return FALSE;
+    }
+    return TRUE;
+}
+#endif
+
+#if _CLG_DOUBLEFLOAT
+#define _CLG_FFT_C2C CUFFT_Z2Z
+#define _CLG_FFT_R2C CUFFT_D2Z
+#define _CLG_FFT_C2R CUFFT_Z2D
 #else
+#define _CLG_FFT_C2C CUFFT_C2C
+#define _CLG_FFT_R2C CUFFT_R2C
+#define _CLG_FFT_C2R CUFFT_C2R
+#endif
 
-    const cufftResult planRes = cufftPlanMany(&plan3d, 3, n,
-        n, 1, 1,
-        n, 1, 1,
-        CUFFT_C2C, 1);
+void CCLGFFTHelper::ReleasePlans()
+{
+    for (INT i = 0; i < _lstFFTPlans.Num(); ++i)
+    {
+        cufftDestroy(_lstFFTPlans[i].m_hPlan);
+    }
+    _lstFFTPlans.RemoveAll();
+}
 
-    if (CUFFT_SUCCESS != planRes)
+UINT CCLGFFTHelper::GetPlanCount()
+{
+    return static_cast<UINT>(_lstFFTPlans.Num());
+}
+
+#pragma endregion
+
+#pragma region Host backend
+
+static EFFT_Backend _eFFTBackend = EFFTB_Device;
+
+void CCLGFFTHelper::SetBackend(EFFT_Backend eBackend)
+{
+    _eFFTBackend = eBackend;
+}
+
+EFFT_Backend CCLGFFTHelper::GetBackend()
+{
+    return _eFFTBackend;
+}
+
+static void _hostSetComplex(CLGComplex& c, const cuDoubleComplex& v)
+{
+    c = _make_cuComplex(static_cast<Real>(v.x), static_cast<Real>(v.y));
+}
+
+#if !_CLG_DOUBLEFLOAT
+static void _hostSetComplex(cuDoubleComplex& c, const cuDoubleComplex& v)
+{
+    c = v;
+}
+#endif
+
+/**
+ * DFT on one axis, the lines are [before][axis][after]
+ * It is O(L) for each element, for the lattice size it is fast enough
+ * Complex is CLGComplex or cuDoubleComplex, the sum is always in double
+ */
+template<class Complex>
+static void _hostDFTAxis(Complex* data, INT iBefore, INT iLength, INT iAfter, UBOOL bForward)
+{
+    const DOUBLE fSign = bForward ? -2.0 * acos(-1.0) : 2.0 * acos(-1.0);
+    DOUBLE* pCos = (DOUBLE*)malloc(sizeof(DOUBLE) * iLength);
+    DOUBLE* pSin = (DOUBLE*)malloc(sizeof(DOUBLE) * iLength);
+    cuDoubleComplex* pLine = (cuDoubleComplex*)malloc(sizeof(cuDoubleComplex) * iLength);
+    for (INT k = 0; k < iLength; ++k)
     {
-        appCrucial(_T("cufftPlanMany failed! %d\n"), planRes);
-        return FALSE;
+        pCos[k] = cos(fSign * k / iLength);
+        pSin[k] = sin(fSign * k / iLength);
     }
 
-    const cufftResult res3D = cufftExecC2C(plan3d, copied, copied, bForward ? CUFFT_FORWARD : CUFFT_INVERSE);
-    if (CUFFT_SUCCESS != res3D)
+    for (INT b = 0; b < iBefore; ++b)
     {
-        appCrucial(_T("cufftResult failed! %d\n"), res3D);
-        return FALSE;
+        for (INT a = 0; a < iAfter; ++a)
+        {
+            Complex* pStart = data + b * iLength * iAfter + a;
+            for (INT k = 0; k < iLength; ++k)
+            {
+                DOUBLE fRe = 0.0;
+                DOUBLE fIm = 0.0;
+                for (INT j = 0; j < iLength; ++j)
+                {
+                    const INT iPhase = (j * k) % iLength;
+                    const DOUBLE fX = static_cast<DOUBLE>(pStart[j * iAfter].x);
+                    const DOUBLE fY = static_cast<DOUBLE>(pStart[j * iAfter].y);
+                    fRe += fX * pCos[iPhase] - fY * pSin[iPhase];
+                    fIm += fX * pSin[iPhase] + fY * pCos[iPhase];
+                }
+                pLine[k] = make_cuDoubleComplex(fRe, fIm);
+            }
+            for (INT k = 0; k < iLength; ++k)
+            {
+                _hostSetComplex(pStart[k * iAfter], pLine[k]);
+            }
+        }
     }
 
-#endif
+    free(pCos);
+    free(pSin);
+    free(pLine);
+}
+
+/**
+ * uiAxisMask: 1 << i for transform on dims[i], the data is [dims[0]]...[dims[n-1]][uiComponents]
+ */
+template<class Complex>
+static void _hostFFT(Complex* hostData, const TArray<INT>& dims, UINT uiAxisMask, UINT uiComponents, UBOOL bForward)
+{
+    for (INT iAxis = 0; iAxis < dims.Num(); ++iAxis)
+    {
+        if (0 == (uiAxisMask & (1U << iAxis)))
+        {
+            continue;
+        }
+        INT iBefore = 1;
+        INT iAfter = static_cast<INT>(uiComponents);
+        for (INT i = 0; i < iAxis; ++i)
+        {
+            iBefore *= dims[i];
+        }
+        for (INT i = iAxis + 1; i < dims.Num(); ++i)
+        {
+            iAfter *= dims[i];
+        }
+        _hostDFTAxis(hostData, iBefore, dims[iAxis], iAfter, bForward);
+    }
+}
+
+static UINT _getFFTSize(const TArray<INT>& dims, UINT uiComponents)
+{
+    UINT uiSize = uiComponents;
+    for (INT i = 0; i < dims.Num(); ++i)
+    {
+        uiSize = uiSize * static_cast<UINT>(dims[i]);
+    }
+    return uiSize;
+}
+
+/**
+ * The device transforms with EFFTB_Host: copy to host, FFTHost, copy back
+ */
+template<class Complex>
+static UBOOL _hostFFTOnDevice(Complex* deviceData, const TArray<INT>& dims, UINT uiAxisMask, UINT uiComponents, UBOOL bForward)
+{
+    const UINT uiSize = _getFFTSize(dims, uiComponents);
+    Complex* hostData = (Complex*)malloc(sizeof(Complex) * uiSize);
+    checkCudaErrors(cudaMemcpy(hostData, deviceData, sizeof(Complex) * uiSize, cudaMemcpyDeviceToHost));
+    _hostFFT(hostData, dims, uiAxisMask, uiComponents, bForward);
+    checkCudaErrors(cudaMemcpy(deviceData, hostData, sizeof(Complex) * uiSize, cudaMemcpyHostToDevice));
+    free(hostData);
+    return TRUE;
+}
+
+static TArray<INT> _getXYZDims(const TArray<INT>& dims)
+{
+    TArray<INT> ret;
+    ret.AddItem(dims[0]);
+    ret.AddItem(dims[1]);
+    ret.AddItem(dims[2]);
+    return ret;
+}
 
+/**
+ * R2C with EFFTB_Host, res is [x][y][z/2+1]
+ */
+static UBOOL _hostFFTR2COnDevice(const Real* source, CLGComplex* res, const TArray<INT>& dims)
+{
+    const TArray<INT> xyz = _getXYZDims(dims);
+    const UINT uiSize = _getFFTSize(xyz, 1);
+    const INT iHalfZ = dims[2] / 2 + 1;
+    Real* hostReal = (Real*)malloc(sizeof(Real) * uiSize);
+    CLGComplex* hostData = (CLGComplex*)malloc(sizeof(CLGComplex) * uiSize);
+    CLGComplex* hostHalf = (CLGComplex*)malloc(sizeof(CLGComplex) * dims[0] * dims[1] * iHalfZ);
+    checkCudaErrors(cudaMemcpy(hostReal, source, sizeof(Real) * uiSize, cudaMemcpyDeviceToHost));
+    for (UINT i = 0; i < uiSize; ++i)
+    {
+        hostData[i] = _make_cuComplex(hostReal[i], F(0.0));
+    }
+    _hostFFT(hostData, xyz, 7, 1, TRUE);
+    for (INT x = 0; x < dims[0]; ++x)
+    {
+        for (INT y = 0; y < dims[1]; ++y)
+        {
+            for (INT z = 0; z < iHalfZ; ++z)
+            {
+                hostHalf[(x * dims[1] + y) * iHalfZ + z] = hostData[(x * dims[1] + y) * dims[2] + z];
+            }
+        }
+    }
+    checkCudaErrors(cudaMemcpy(res, hostHalf, sizeof(CLGComplex) * dims[0] * dims[1] * iHalfZ, cudaMemcpyHostToDevice));
+    free(hostReal);
+    free(hostData);
+    free(hostHalf);
     return TRUE;
 }
 
+/**
+ * C2R with EFFTB_Host, the missing z > Lz/2 are conj(f(-k))
+ */
+static UBOOL _hostFFTC2ROnDevice(const CLGComplex* source, Real* res, const TArray<INT>& dims)
+{
+    const TArray<INT> xyz = _getXYZDims(dims);
+    const UINT uiSize = _getFFTSize(xyz, 1);
+    const INT iHalfZ = dims[2] / 2 + 1;
+    CLGComplex* hostHalf = (CLGComplex*)malloc(sizeof(CLGComplex) * dims[0] * dims[1] * iHalfZ);
+    CLGComplex* hostData = (CLGComplex*)malloc(sizeof(CLGComplex) * uiSize);
+    Real* hostReal = (Real*)malloc(sizeof(Real) * uiSize);
+    checkCudaErrors(cudaMemcpy(hostHalf, source, sizeof(CLGComplex) * dims[0] * dims[1] * iHalfZ, cudaMemcpyDeviceToHost));
+    for (INT x = 0; x < dims[0]; ++x)
+    {
+        for (INT y = 0; y < dims[1]; ++y)
+        {
+            for (INT z = 0; z < dims[2]; ++z)
+            {
+                if (z < iHalfZ)
+                {
+                    hostData[(x * dims[1] + y) * dims[2] + z] = hostHalf[(x * dims[1] + y) * iHalfZ + z];
+                }
+                else
+                {
+                    const INT iMx = (dims[0] - x) % dims[0];
+                    const INT iMy = (dims[1] - y) % dims[1];
+                    hostData[(x * dims[1] + y) * dims[2] + z] = _cuConjf(hostHalf[(iMx * dims[1] + iMy) * iHalfZ + dims[2] - z]);
+                }
+            }
+        }
+    }
+    _hostFFT(hostData, xyz, 7, 1, FALSE);
+    for (UINT i = 0; i < uiSize; ++i)
+    {
+        hostReal[i] = hostData[i].x;
+    }
+    checkCudaErrors(cudaMemcpy(res, hostReal, sizeof(Real) * uiSize, cudaMemcpyHostToDevice));
+    free(hostHalf);
+    free(hostData);
+    free(hostReal);
+    return TRUE;
+}
+
+#pragma endregion
+
+UBOOL CCLGFFTHelper::FFT3DWithXYZ(CLGComplex* copied, TArray<INT> dims, UBOOL bForward)
+{
+    if (EFFTB_Host == _eFFTBackend)
+    {
+        return _hostFFTOnDevice(copied, _getXYZDims(dims), 7, 1, bForward);
+    }
+
+    cufftHandle plan3d;
+    const INT n[3] = { dims[0], dims[1], dims[2] };
+    if (!_getFFTPlan(plan3d, _CLG_FFT_C2C, 3, n, n, NULL, 1, 1, 1))
+    {
+        return FALSE;
+    }
+    return _execFFT(plan3d, copied, bForward);
+}
+
 /**
 * 1D
 * input [b * idist + x * istride]
@@ -115,231 +419,242 @@ UBOOL CCLGFFTHelper::FFT3DWithXYZ(CLGComplex* copied, TArray<INT> dims, UBOOL bF
 */
 UBOOL CCLGFFTHelper::FFT3DWithXYZW(CLGComplex* copied, TArray<INT> dims, UBOOL bForward)
 {
-    cufftHandle plan4d1;
-    INT n[3] = { dims[0], dims[1], dims[2] };
-    INT inembed[3] = { dims[0], dims[1], dims[2] };
-    const INT stride = dims[3];
-
-#if _CLG_DOUBLEFLOAT
-
-    const cufftResult planRes = cufftPlanMany(&plan4d1, 3, n,
-        inembed, stride, 1,
-        inembed, stride, 1,
-        CUFFT_Z2Z, stride);
+    return FFT3DWithXYZWComponents(copied, dims, 1, bForward);
+}
 
-    if (CUFFT_SUCCESS != planRes)
+UBOOL CCLGFFTHelper::FFT4DWithXYZW(CLGComplex* copied, TArray<INT> dims, UBOOL bForward)
+{
+    if (EFFTB_Host == _eFFTBackend)
     {
-        appCrucial(_T("cufftPlanMany failed! %d\n"), planRes);
-        return FALSE;
+        return _hostFFTOnDevice(copied, dims, 15, 1, bForward);
     }
 
-    const cufftResult res4D1 = cufftExecZ2Z(plan4d1, copied, copied, bForward ? CUFFT_FORWARD : CUFFT_INVERSE);
-    if (CUFFT_SUCCESS != res4D1)
+    cufftHandle plan4d1;
+    const INT n[3] = { dims[1], dims[2], dims[3] };
+    const INT dist = dims[1] * dims[2] * dims[3];
+    cufftHandle plan4d2;
+    const INT n2[1] = { dims[0] };
+
+    if (!_getFFTPlan(plan4d1, _CLG_FFT_C2C, 3, n, n, NULL, 1, dist, dims[0]))
     {
-        appCrucial(_T("cufftResult failed! %d\n"), res4D1);
         return FALSE;
     }
-
-#else
-
-    const cufftResult planRes = cufftPlanMany(&plan4d1, 3, n,
-        inembed, stride, 1,
-        inembed, stride, 1,
-        CUFFT_C2C, stride);
-
-    if (CUFFT_SUCCESS != planRes)
+    if (!_execFFT(plan4d1, copied, bForward))
     {
-        appCrucial(_T("cufftPlanMany failed! %d\n"), planRes);
         return FALSE;
     }
 
-    const cufftResult res4D1 = cufftExecC2C(plan4d1, copied, copied, bForward ? CUFFT_FORWARD : CUFFT_INVERSE);
-    if (CUFFT_SUCCESS != res4D1)
+    //note that if it was null, it will ignore the stride
+    if (!_getFFTPlan(plan4d2, _CLG_FFT_C2C, 1, n2, n2, NULL, dist, 1, dist))
     {
-        appCrucial(_T("cufftResult failed! %d\n"), res4D1);
         return FALSE;
     }
-
-#endif
-    return TRUE;
+    //in out can be the same
+    return _execFFT(plan4d2, copied, bForward);
 }
 
-UBOOL CCLGFFTHelper::FFT4DWithXYZW(CLGComplex* copied, TArray<INT> dims, UBOOL bForward)
+/**
+ * [x][y][z][w][c], FFT on xyz, one plan for all w and c
+ */
+UBOOL CCLGFFTHelper::FFT3DWithXYZWComponents(CLGComplex* copied, TArray<INT> dims, UINT uiComponents, UBOOL bForward)
 {
-    cufftHandle plan4d1;
-    INT n[3] = { dims[1], dims[2], dims[3] };
-    INT inembed[3] = { dims[1], dims[2], dims[3] };
-    const INT dist = dims[1] * dims[2] * dims[3];
-    cufftHandle plan4d2;
-    INT n2[1] = { dims[0] };
-
-#if _CLG_DOUBLEFLOAT
-
-    const cufftResult planRes = cufftPlanMany(&plan4d1, 3, n,
-        inembed, 1, dist,
-        inembed, 1, dist,
-        CUFFT_Z2Z, dims[0]);
-
-    if (CUFFT_SUCCESS != planRes)
+    if (EFFTB_Host == _eFFTBackend)
     {
-        appCrucial(_T("cufftPlanMany failed! %d\n"), planRes);
-        return FALSE;
+        return _hostFFTOnDevice(copied, dims, 7, uiComponents, bForward);
     }
 
-
-    const cufftResult res4D1 = cufftExecZ2Z(plan4d1, copied, copied, bForward ? CUFFT_FORWARD : CUFFT_INVERSE);
-    if (CUFFT_SUCCESS != res4D1)
+    cufftHandle plan;
+    const INT n[3] = { dims[0], dims[1], dims[2] };
+    const INT stride = dims[3] * static_cast<INT>(uiComponents);
+    if (!_getFFTPlan(plan, _CLG_FFT_C2C, 3, n, n, NULL, stride, 1, stride))
     {
-        appCrucial(_T("cufftResult failed! %d\n"), res4D1);
         return FALSE;
     }
+    return _execFFT(plan, copied, bForward);
+}
 
-    //note that if it was null, it will ignore the stride
-    const cufftResult planRes1 = cufftPlanMany(&plan4d2, 1, n2,
-        n2, dist, 1,
-        n2, dist, 1,
-        CUFFT_Z2Z, dist);
+/**
+ * [x][y][z][w][c]
+ * First FFT on x, it is one plan with batch of all (y,z,w,c)
+ * Then FFT on yzw with batch of c, for each x
+ */
+UBOOL CCLGFFTHelper::FFT4DWithXYZWComponents(CLGComplex* copied, TArray<INT> dims, UINT uiComponents, UBOOL bForward)
+{
+    if (EFFTB_Host == _eFFTBackend)
+    {
+        return _hostFFTOnDevice(copied, dims, 15, uiComponents, bForward);
+    }
 
-    if (CUFFT_SUCCESS != planRes1)
+    if (1 == uiComponents)
     {
-        appCrucial(_T("cufftPlanMany failed! %d\n"), planRes);
-        return FALSE;
+        return FFT4DWithXYZW(copied, dims, bForward);
     }
 
-    //in out can be the same
-    const cufftResult res4D2 = cufftExecZ2Z(plan4d2, copied, copied, bForward ? CUFFT_FORWARD : CUFFT_INVERSE);
-    if (CUFFT_SUCCESS != res4D2)
+    const INT iComponents = static_cast<INT>(uiComponents);
+    const INT dist = dims[1] * dims[2] * dims[3] * iComponents;
+    cufftHandle planx;
+    const INT nx[1] = { dims[0] };
+    if (!_getFFTPlan(planx, _CLG_FFT_C2C, 1, nx, nx, NULL, dist, 1, dist))
     {
-        appCrucial(_T("cufftResult failed! %d\n"), res4D2);
         return FALSE;
     }
-
-#else
-
-    const cufftResult planRes = cufftPlanMany(&plan4d1, 3, n,
-        inembed, 1, dist,
-        inembed, 1, dist,
-        CUFFT_C2C, dims[0]);
-
-    if (CUFFT_SUCCESS != planRes)
+    if (!_execFFT(planx, copied, bForward))
     {
-        appCrucial(_T("cufftPlanMany failed! %d\n"), planRes);
         return FALSE;
     }
 
-
-    const cufftResult res4D1 = cufftExecC2C(plan4d1, copied, copied, bForward ? CUFFT_FORWARD : CUFFT_INVERSE);
-    if (CUFFT_SUCCESS != res4D1)
+    cufftHandle planyzw;
+    const INT n[3] = { dims[1], dims[2], dims[3] };
+    if (!_getFFTPlan(planyzw, _CLG_FFT_C2C, 3, n, n, NULL, iComponents, 1, iComponents))
     {
-        appCrucial(_T("cufftResult failed! %d\n"), res4D1);
         return FALSE;
     }
+    for (INT x = 0; x < dims[0]; ++x)
+    {
+        if (!_execFFT(planyzw, copied + x * dist, bForward))
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
 
-    //note that if it was null, it will ignore the stride
-    const cufftResult planRes2 = cufftPlanMany(&plan4d2, 1, n2,
-        n2, dist, 1,
-        n2, dist, 1,
-        CUFFT_C2C, dist);
-
-    if (CUFFT_SUCCESS != planRes2)
+/**
+ * res is [x][y][z/2+1]
+ */
+UBOOL CCLGFFTHelper::FFT3DWithXYZR2C(Real* source, CLGComplex* res, TArray<INT> dims)
+{
+    if (EFFTB_Host == _eFFTBackend)
     {
-        appCrucial(_T("cufftPlanMany failed! %d\n"), planRes2);
-        return FALSE;
+        return _hostFFTR2COnDevice(source, res, dims);
     }
 
-    //in out can be the same
-    const cufftResult res4D2 = cufftExecC2C(plan4d2, copied, copied, bForward ? CUFFT_FORWARD : CUFFT_INVERSE);
-    if (CUFFT_SUCCESS != res4D2)
+    cufftHandle plan;
+    const INT n[3] = { dims[0], dims[1], dims[2] };
+    const INT outembed[3] = { dims[0], dims[1], dims[2] / 2 + 1 };
+    if (!_getFFTPlan(plan, _CLG_FFT_R2C, 3, n, n, outembed, 1, 1, 1))
     {
-        appCrucial(_T("cufftResult failed! %d\n"), res4D2);
         return FALSE;
     }
-
+#if _CLG_DOUBLEFLOAT
+    const cufftResult ret = cufftExecD2Z(plan, source, res);
+#else
+    const cufftResult ret = cufftExecR2C(plan, source, res);
 #endif
-
+    if (CUFFT_SUCCESS != ret)
+    {
+        appCrucial(_T("cufftResult failed! %d\n"), ret);
+        return FALSE;
+    }
     return TRUE;
 }
 
-UBOOL CCLGFFTHelper::FFT3D(CLGComplex* copied, UBOOL bForward, EFFT_Scale eScale)
+/**
+ * source is [x][y][z/2+1], it is changed by cufft
+ */
+UBOOL CCLGFFTHelper::FFT3DWithXYZC2R(CLGComplex* source, Real* res, TArray<INT> dims)
 {
-    TArray<INT> dims;
-    dims.AddItem(static_cast<INT>(_HC_Lx));
-    dims.AddItem(static_cast<INT>(_HC_Ly));
-    dims.AddItem(static_cast<INT>(_HC_Lz));
-    dims.AddItem(static_cast<INT>(_HC_Lt));
-    if (!FFT3DWithXYZW(copied, dims, bForward))
+    if (EFFTB_Host == _eFFTBackend)
+    {
+        return _hostFFTC2ROnDevice(source, res, dims);
+    }
+
+    cufftHandle plan;
+    const INT n[3] = { dims[0], dims[1], dims[2] };
+    const INT inembed[3] = { dims[0], dims[1], dims[2] / 2 + 1 };
+    if (!_getFFTPlan(plan, _CLG_FFT_C2R, 3, n, inembed, n, 1, 1, 1))
     {
         return FALSE;
     }
+#if _CLG_DOUBLEFLOAT
+    const cufftResult ret = cufftExecZ2D(plan, source, res);
+#else
+    const cufftResult ret = cufftExecC2R(plan, source, res);
+#endif
+    if (CUFFT_SUCCESS != ret)
+    {
+        appCrucial(_T("cufftResult failed! %d\n"), ret);
+        return FALSE;
+    }
+    return TRUE;
+}
 
+static Real _getFFTScale(UBOOL bForward, EFFT_Scale eScale, UINT uiN)
+{
     if (bForward)
     {
         if (ES_1OverNForward == eScale)
         {
-            preparethread;
-            _kernelScale << <block, threads >> > (copied, F(1.0) / _HC_Volume_xyz);
+            return F(1.0) / uiN;
         }
-        else if (ES_1OverSqrtNBoth == eScale)
+        if (ES_1OverSqrtNBoth == eScale)
         {
-            preparethread;
-            _kernelScale << <block, threads >> > (copied, F(1.0) / _hostsqrt(static_cast<Real>(_HC_Volume_xyz)));
+            return F(1.0) / _hostsqrt(static_cast<Real>(uiN));
         }
     }
     else
     {
         if (ES_1OverNInverse == eScale)
         {
-            preparethread;
-            _kernelScale << <block, threads >> > (copied, F(1.0) / _HC_Volume_xyz);
+            return F(1.0) / uiN;
         }
-        else if (ES_1OverSqrtNBoth == eScale)
+        if (ES_1OverSqrtNBoth == eScale)
         {
-            preparethread;
-            _kernelScale << <block, threads >> > (copied, F(1.0) / _hostsqrt(static_cast<Real>(_HC_Volume_xyz)));
+            return F(1.0) / _hostsqrt(static_cast<Real>(uiN));
         }
     }
-    return TRUE;
+    return F(1.0);
 }
 
-UBOOL CCLGFFTHelper::FFT4D(CLGComplex* copied, UBOOL bForward, EFFT_Scale eScale)
+static TArray<INT> _getLatticeDims()
 {
     TArray<INT> dims;
     dims.AddItem(static_cast<INT>(_HC_Lx));
     dims.AddItem(static_cast<INT>(_HC_Ly));
     dims.AddItem(static_cast<INT>(_HC_Lz));
     dims.AddItem(static_cast<INT>(_HC_Lt));
-    if (!FFT4DWithXYZW(copied, dims, bForward))
+    return dims;
+}
+
+UBOOL CCLGFFTHelper::FFT3D(CLGComplex* copied, UBOOL bForward, EFFT_Scale eScale)
+{
+    return FFT3DComponents(copied, 1, bForward, eScale);
+}
+
+UBOOL CCLGFFTHelper::FFT4D(CLGComplex* copied, UBOOL bForward, EFFT_Scale eScale)
+{
+    return FFT4DComponents(copied, 1, bForward, eScale);
+}
+
+UBOOL CCLGFFTHelper::FFT3DComponents(CLGComplex* copied, UINT uiComponents, UBOOL bForward, EFFT_Scale eScale)
+{
+    if (!FFT3DWithXYZWComponents(copied, _getLatticeDims(), uiComponents, bForward))
     {
         return FALSE;
     }
 
-    if (bForward)
+    const Real fScale = _getFFTScale(bForward, eScale, _HC_Volume_xyz);
+    if (F(1.0) != fScale)
     {
-        if (ES_1OverNForward == eScale)
-        {
-            preparethread;
-            _kernelScale << <block, threads >> > (copied, F(1.0) / _HC_Volume);
-        }
-        else if (ES_1OverSqrtNBoth == eScale)
-        {
-            preparethread;
-            _kernelScale << <block, threads >> > (copied, F(1.0) / _hostsqrt(static_cast<Real>(_HC_Volume)));
-        }
+        preparethread;
+        _kernelScaleComponents << <block, threads >> > (copied, uiComponents, fScale);
     }
-    else
+    return TRUE;
+}
+
+UBOOL CCLGFFTHelper::FFT4DComponents(CLGComplex* copied, UINT uiComponents, UBOOL bForward, EFFT_Scale eScale)
+{
+    if (!FFT4DWithXYZWComponents(copied, _getLatticeDims(), uiComponents, bForward))
     {
-        if (ES_1OverNInverse == eScale)
-        {
-            preparethread;
-            _kernelScale << <block, threads >> > (copied, F(1.0) / _HC_Volume);
-        }
-        else if (ES_1OverSqrtNBoth == eScale)
-        {
-            preparethread;
-            _kernelScale << <block, threads >> > (copied, F(1.0) / _hostsqrt(static_cast<Real>(_HC_Volume)));
-        }
+        return FALSE;
     }
 
+    const Real fScale = _getFFTScale(bForward, eScale, _HC_Volume);
+    if (F(1.0) != fScale)
+    {
+        preparethread;
+        _kernelScaleComponents << <block, threads >> > (copied, uiComponents, fScale);
+    }
     return TRUE;
 }
 
@@ -347,17 +662,15 @@ UBOOL CCLGFFTHelper::FFT4D(CLGComplex* copied, UBOOL bForward, EFFT_Scale eScale
 
 UBOOL CCLGFFTHelper::FFT3DWithXYZDouble(cuDoubleComplex* copied, TArray<INT> dims, UBOOL bForward)
 {
-    cufftHandle plan3d;
-    INT n[3] = { dims[0], dims[1], dims[2] };
-
-    const cufftResult planRes = cufftPlanMany(&plan3d, 3, n,
-        n, 1, 1,
-        n, 1, 1,
-        CUFFT_Z2Z, 1);
+    if (EFFTB_Host == _eFFTBackend)
+    {
+        return _hostFFTOnDevice(copied, _getXYZDims(dims), 7, 1, bForward);
+    }
 
-    if (CUFFT_SUCCESS != planRes)
+    cufftHandle plan3d;
+    const INT n[3] = { dims[0], dims[1], dims[2] };
+    if (!_getFFTPlan(plan3d, CUFFT_Z2Z, 3, n, n, NULL, 1, 1, 1))
     {
-        appCrucial(_T("cufftPlanMany failed! %d\n"), planRes);
         return FALSE;
     }
 
@@ -373,25 +686,22 @@ UBOOL CCLGFFTHelper::FFT3DWithXYZDouble(cuDoubleComplex* copied, TArray<INT> dim
 
 UBOOL CCLGFFTHelper::FFT4DWithXYZWDouble(cuDoubleComplex* copied, TArray<INT> dims, UBOOL bForward)
 {
+    if (EFFTB_Host == _eFFTBackend)
+    {
+        return _hostFFTOnDevice(copied, dims, 15, 1, bForward);
+    }
+
     cufftHandle plan4d1;
-    INT n[3] = { dims[1], dims[2], dims[3] };
-    INT inembed[3] = { dims[1], dims[2], dims[3] };
+    const INT n[3] = { dims[1], dims[2], dims[3] };
     const INT dist = dims[1] * dims[2] * dims[3];
     cufftHandle plan4d2;
-    INT n2[1] = { dims[0] };
+    const INT n2[1] = { dims[0] };
 
-    const cufftResult planRes = cufftPlanMany(&plan4d1, 3, n,
-        inembed, 1, dist,
-        inembed, 1, dist,
-        CUFFT_Z2Z, dims[0]);
-
-    if (CUFFT_SUCCESS != planRes)
+    if (!_getFFTPlan(plan4d1, CUFFT_Z2Z, 3, n, n, NULL, 1, dist, dims[0]))
     {
-        appCrucial(_T("cufftPlanMany failed! %d\n"), planRes);
         return FALSE;
     }
 
-
     const cufftResult res4D1 = cufftExecZ2Z(plan4d1, copied, copied, bForward ? CUFFT_FORWARD : CUFFT_INVERSE);
     if (CUFFT_SUCCESS != res4D1)
     {
@@ -400,14 +710,8 @@ UBOOL CCLGFFTHelper::FFT4DWithXYZWDouble(cuDoubleComplex* copied, TArray<INT> di
     }
 
     //note that if it was null, it will ignore the stride
-    const cufftResult planRes1 = cufftPlanMany(&plan4d2, 1, n2,
-        n2, dist, 1,
-        n2, dist, 1,
-        CUFFT_Z2Z, dist);
-
-    if (CUFFT_SUCCESS != planRes1)
+    if (!_getFFTPlan(plan4d2, CUFFT_Z2Z, 1, n2, n2, NULL, dist, 1, dist))
     {
-        appCrucial(_T("cufftPlanMany failed! %d\n"), planRes);
         return FALSE;
     }
 
@@ -422,93 +726,158 @@ UBOOL CCLGFFTHelper::FFT4DWithXYZWDouble(cuDoubleComplex* copied, TArray<INT> di
     return TRUE;
 }
 
+/**
+ * The same as FFT3DWithXYZWComponents and FFT4DWithXYZWComponents
+ */
+UBOOL CCLGFFTHelper::FFT3DWithXYZWComponentsDouble(cuDoubleComplex* copied, TArray<INT> dims, UINT uiComponents, UBOOL bForward)
+{
+    if (EFFTB_Host == _eFFTBackend)
+    {
+        return _hostFFTOnDevice(copied, dims, 7, uiComponents, bForward);
+    }
+
+    cufftHandle plan;
+    const INT n[3] = { dims[0], dims[1], dims[2] };
+    const INT stride = dims[3] * static_cast<INT>(uiComponents);
+    if (!_getFFTPlan(plan, CUFFT_Z2Z, 3, n, n, NULL, stride, 1, stride))
+    {
+        return FALSE;
+    }
+    return _execFFT(plan, copied, bForward);
+}
+
+UBOOL CCLGFFTHelper::FFT4DWithXYZWComponentsDouble(cuDoubleComplex* copied, TArray<INT> dims, UINT uiComponents, UBOOL bForward)
+{
+    if (EFFTB_Host == _eFFTBackend)
+    {
+        return _hostFFTOnDevice(copied, dims, 15, uiComponents, bForward);
+    }
+
+    if (1 == uiComponents)
+    {
+        return FFT4DWithXYZWDouble(copied, dims, bForward);
+    }
+
+    const INT iComponents = static_cast<INT>(uiComponents);
+    const INT dist = dims[1] * dims[2] * dims[3] * iComponents;
+    cufftHandle planx;
+    const INT nx[1] = { dims[0] };
+    if (!_getFFTPlan(planx, CUFFT_Z2Z, 1, nx, nx, NULL, dist, 1, dist))
+    {
+        return FALSE;
+    }
+    if (!_execFFT(planx, copied, bForward))
+    {
+        return FALSE;
+    }
+
+    cufftHandle planyzw;
+    const INT n[3] = { dims[1], dims[2], dims[3] };
+    if (!_getFFTPlan(planyzw, CUFFT_Z2Z, 3, n, n, NULL, iComponents, 1, iComponents))
+    {
+        return FALSE;
+    }
+    for (INT x = 0; x < dims[0]; ++x)
+    {
+        if (!_execFFT(planyzw, copied + x * dist, bForward))
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
 
 UBOOL CCLGFFTHelper::FFT4DDouble(cuDoubleComplex* copied, UBOOL bForward, EFFT_Scale eScale)
 {
-    TArray<INT> dims;
-    dims.AddItem(static_cast<INT>(_HC_Lx));
-    dims.AddItem(static_cast<INT>(_HC_Ly));
-    dims.AddItem(static_cast<INT>(_HC_Lz));
-    dims.AddItem(static_cast<INT>(_HC_Lt));
-    if (!FFT4DWithXYZWDouble(copied, dims, bForward))
+    if (!FFT4DWithXYZWDouble(copied, _getLatticeDims(), bForward))
     {
         return FALSE;
     }
 
+    DOUBLE fScale = 1.0;
     if (bForward)
     {
         if (ES_1OverNForward == eScale)
         {
-            preparethread;
-            _kernelScaleDouble << <block, threads >> > (copied, 1.0 / _HC_Volume);
+            fScale = 1.0 / _HC_Volume;
         }
         else if (ES_1OverSqrtNBoth == eScale)
         {
-            preparethread;
-            _kernelScaleDouble << <block, threads >> > (copied, 1.0 / _hostsqrtd(static_cast<DOUBLE>(_HC_Volume)));
+            fScale = 1.0 / _hostsqrtd(static_cast<DOUBLE>(_HC_Volume));
         }
     }
     else
     {
         if (ES_1OverNInverse == eScale)
         {
-            preparethread;
-            _kernelScaleDouble << <block, threads >> > (copied, 1.0 / _HC_Volume);
+            fScale = 1.0 / _HC_Volume;
         }
         else if (ES_1OverSqrtNBoth == eScale)
         {
-            preparethread;
-            _kernelScaleDouble << <block, threads >> > (copied, 1.0 / _hostsqrtd(static_cast<DOUBLE>(_HC_Volume)));
+            fScale = 1.0 / _hostsqrtd(static_cast<DOUBLE>(_HC_Volume));
         }
     }
 
-    return TRUE;
-}
-#endif
-
-void CCLGFFTHelper::CheckBuffer()
-{
-    if (NULL == m_pDeviceBuffer)
+    if (1.0 != fScale)
     {
-        checkCudaErrors(cudaMalloc((void**)& m_pDeviceBuffer, _HC_Volume * sizeof(CLGComplex)));
+        preparethread;
+        _kernelScaleDouble << <block, threads >> > (copied, fScale);
     }
+
+    return TRUE;
 }
+#endif
 
 /**
- * To save memory, we do the FFT element by element
+ * All 9 elements (with the padding) are transformed by one plan
  */
 UBOOL CCLGFFTHelper::FFT3DSU3(deviceSU3* res, UBOOL bForward, EFFT_Scale eScale)
 {
-    CheckBuffer();
-    preparethread;
-    for (BYTE i = 0; i < 9; ++i)
+    return FFT3DComponents((CLGComplex*)res, sizeof(deviceSU3) / sizeof(CLGComplex), bForward, eScale);
+}
+
+UBOOL CCLGFFTHelper::FFT4DSU3(deviceSU3* res, UBOOL bForward, EFFT_Scale eScale)
+{
+    return FFT4DComponents((CLGComplex*)res, sizeof(deviceSU3) / sizeof(CLGComplex), bForward, eScale);
+}
+
+#pragma region Host
+
+void CCLGFFTHelper::FFTHost(CLGComplex* hostData, const TArray<INT>& dims, UINT uiAxisMask, UINT uiComponents, UBOOL bForward)
+{
+    _hostFFT(hostData, dims, uiAxisMask, uiComponents, bForward);
+}
+
+UBOOL CCLGFFTHelper::FFT3DHost(CLGComplex* hostRes, UINT uiComponents, UBOOL bForward, EFFT_Scale eScale)
+{
+    FFTHost(hostRes, _getLatticeDims(), 7, uiComponents, bForward);
+    const Real fScale = _getFFTScale(bForward, eScale, _HC_Volume_xyz);
+    if (F(1.0) != fScale)
     {
-        _kernelCopyElementSU3ToC << <block, threads>> > (res, m_pDeviceBuffer, i);
-        if (!FFT3D(m_pDeviceBuffer, bForward, eScale))
+        for (UINT i = 0; i < _HC_Volume * uiComponents; ++i)
         {
-            return FALSE;
+            hostRes[i] = cuCmulf_cr(hostRes[i], fScale);
         }
-        _kernelCopyElementCToSU3 << <block, threads >> > (res, m_pDeviceBuffer, i);
     }
     return TRUE;
 }
 
-UBOOL CCLGFFTHelper::FFT4DSU3(deviceSU3* res, UBOOL bForward, EFFT_Scale eScale)
+UBOOL CCLGFFTHelper::FFT4DHost(CLGComplex* hostRes, UINT uiComponents, UBOOL bForward, EFFT_Scale eScale)
 {
-    CheckBuffer();
-    preparethread;
-    for (BYTE i = 0; i < 9; ++i)
+    FFTHost(hostRes, _getLatticeDims(), 15, uiComponents, bForward);
+    const Real fScale = _getFFTScale(bForward, eScale, _HC_Volume);
+    if (F(1.0) != fScale)
     {
-        _kernelCopyElementSU3ToC << <block, threads >> > (res, m_pDeviceBuffer, i);
-        if (!FFT4D(m_pDeviceBuffer, bForward, eScale))
+        for (UINT i = 0; i < _HC_Volume * uiComponents; ++i)
         {
-            return FALSE;
+            hostRes[i] = cuCmulf_cr(hostRes[i], fScale);
         }
-        _kernelCopyElementCToSU3 << <block, threads >> > (res, m_pDeviceBuffer, i);
     }
     return TRUE;
 }
 
+#pragma endregion
+
 void CCLGFFTHelper::GenerateTestArray(CLGComplex * hostArray, INT iSize)
 {
     for (INT i = 0; i < iSize; ++i)
@@ -25,40 +25,78 @@ enum EFFT_Scale
     ES_1OverSqrtNBoth,
 };
 
+/**
+ * EFFTB_Host is the plain DFT on host, see CCLGFFTHelper
+ */
+__DEFINE_ENUM(EFFT_Backend,
+    EFFTB_Device,
+    EFFTB_Host,
+
+    EFFTB_ForceDWORD = 0x7fffffff,
+    )
+
+/**
+ * The plans are created once and kept until ReleasePlans (called at appQuitCLG)
+ *
+ * Components: the site has uiComponents complex numbers, [x][y][z][w][c],
+ * all components are transformed together (for example deviceSU3, with padding)
+ *
+ * Host: the same transform on host memory, it is a plain DFT (slow but exact),
+ * used when no GPU is wanted and to check the device results
+ *
+ * Backend: with EFFTB_Host, the device functions copy the data to host,
+ * use the host DFT and copy back, so the callers do not change
+ */
 class CLGAPI CCLGFFTHelper
 {
 public:
 
-    CCLGFFTHelper()
-    : m_pDeviceBuffer(NULL)
-    {
-        
-    }
-
-    ~CCLGFFTHelper()
-    {
-        if (NULL != m_pDeviceBuffer)
-        {
-            checkCudaErrors(cudaFree(m_pDeviceBuffer));
-        }
-    }
-
     /**
      * copied is the copy of the source, will be changed
      */
     static UBOOL FFT3DWithXYZ(CLGComplex* copied, TArray<INT> dims, UBOOL bForward);
     static UBOOL FFT3DWithXYZW(CLGComplex* copied, TArray<INT> dims, UBOOL bForward);
     static UBOOL FFT4DWithXYZW(CLGComplex* copied, TArray<INT> dims, UBOOL bForward);
+    static UBOOL FFT3DWithXYZWComponents(CLGComplex* copied, TArray<INT> dims, UINT uiComponents, UBOOL bForward);
+    static UBOOL FFT4DWithXYZWComponents(CLGComplex* copied, TArray<INT> dims, UINT uiComponents, UBOOL bForward);
     static UBOOL FFT3D(CLGComplex* res, UBOOL bForward, EFFT_Scale eScale = ES_None);
     static UBOOL FFT4D(CLGComplex* res, UBOOL bForward, EFFT_Scale eScale = ES_None);
+    static UBOOL FFT3DComponents(CLGComplex* res, UINT uiComponents, UBOOL bForward, EFFT_Scale eScale = ES_None);
+    static UBOOL FFT4DComponents(CLGComplex* res, UINT uiComponents, UBOOL bForward, EFFT_Scale eScale = ES_None);
+
+    /**
+     * Real to complex (forward) and complex to real (inverse) on [x][y][z],
+     * the complex one is [x][y][z/2+1]
+     */
+    static UBOOL FFT3DWithXYZR2C(Real* source, CLGComplex* res, TArray<INT> dims);
+    static UBOOL FFT3DWithXYZC2R(CLGComplex* source, Real* res, TArray<INT> dims);
+
 #if !_CLG_DOUBLEFLOAT
     static UBOOL FFT3DWithXYZDouble(cuDoubleComplex* copied, TArray<INT> dims, UBOOL bForward);
     static UBOOL FFT4DWithXYZWDouble(cuDoubleComplex* copied, TArray<INT> dims, UBOOL bForward);
+    static UBOOL FFT3DWithXYZWComponentsDouble(cuDoubleComplex* copied, TArray<INT> dims, UINT uiComponents, UBOOL bForward);
+    static UBOOL FFT4DWithXYZWComponentsDouble(cuDoubleComplex* copied, TArray<INT> dims, UINT uiComponents, UBOOL bForward);
     static UBOOL FFT4DDouble(cuDoubleComplex* res, UBOOL bForward, EFFT_Scale eScale = ES_None);
 #endif
 
-    UBOOL FFT3DSU3(deviceSU3* res, UBOOL bForward, EFFT_Scale eScale = ES_None);
-    UBOOL FFT4DSU3(deviceSU3* res, UBOOL bForward, EFFT_Scale eScale = ES_None);
+    static UBOOL FFT3DSU3(deviceSU3* res, UBOOL bForward, EFFT_Scale eScale = ES_None);
+    static UBOOL FFT4DSU3(deviceSU3* res, UBOOL bForward, EFFT_Scale eScale = ES_None);
+
+    /**
+     * uiAxisMask: 1 << i for transform on dims[i]
+     */
+    static void FFTHost(CLGComplex* hostData, const TArray<INT>& dims, UINT uiAxisMask, UINT uiComponents, UBOOL bForward);
+    static UBOOL FFT3DHost(CLGComplex* hostRes, UINT uiComponents, UBOOL bForward, EFFT_Scale eScale = ES_None);
+    static UBOOL FFT4DHost(CLGComplex* hostRes, UINT uiComponents, UBOOL bForward, EFFT_Scale eScale = ES_None);
+
+    /**
+     * Set by "FFTBackend" in the parameters (EFFTB_Device by default)
+     */
+    static void SetBackend(EFFT_Backend eBackend);
+    static EFFT_Backend GetBackend();
+
+    static void ReleasePlans();
+    static UINT GetPlanCount();
 
     /**
      * Test function
@@ -70,9 +108,6 @@ private:
     static void GenerateTestArray(CLGComplex* hostArray, INT iSize);
     static void PrintTestArray3D(CLGComplex* hostArray);
     static void PrintTestArray4D(CLGComplex* hostArray);
-    void CheckBuffer();
-
-    CLGComplex* m_pDeviceBuffer;
 };
 
 __END_NAMESPACE
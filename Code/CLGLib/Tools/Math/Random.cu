@@ -78,6 +78,7 @@ _kernalInitialScrambledSobel32(curandStateScrambledSobol32* states, UINT* consts
 
 CRandom::~CRandom()
 {
+    appSafeDeleteArray(m_pHostBuffer);
 
     switch (m_eRandomType)
     {
@@ -86,24 +87,26 @@ CRandom::~CRandom()
             checkCudaErrors(__cudaFree(m_pDeviceSeedTable));
         }
         break;
+    case ER_PHILOX_COUNTER:
+        {
+            checkCudaErrors(__cudaFree(m_pDeviceCounterKey));
+        }
+        break;
     case ER_MRG32K3A:
         {
             CURAND_CALL(curandDestroyGenerator(m_HGen));
-            checkCudaErrors(__cudaFree(m_deviceBuffer));
             checkCudaErrors(__cudaFree(m_pDeviceRandStatesMRG));
         }
         break;
     case ER_PHILOX4_32_10:
         {
             CURAND_CALL(curandDestroyGenerator(m_HGen));
-            checkCudaErrors(__cudaFree(m_deviceBuffer));
             checkCudaErrors(__cudaFree(m_pDeviceRandStatesPhilox));
         }
         break;
     case ER_QUASI_SOBOL32:
         {
             CURAND_CALL(curandDestroyGenerator(m_HGen));
-            checkCudaErrors(__cudaFree(m_deviceBuffer));
             checkCudaErrors(__cudaFree(m_pDeviceRandStatesSobol32));
             checkCudaErrors(__cudaFree(m_pDeviceSobolDirVec));
         }
@@ -111,7 +114,6 @@ CRandom::~CRandom()
     case ER_SCRAMBLED_SOBOL32:
         {
             CURAND_CALL(curandDestroyGenerator(m_HGen));
-            checkCudaErrors(__cudaFree(m_deviceBuffer));
             checkCudaErrors(__cudaFree(m_pDeviceRandStatesScrambledSobol32));
             checkCudaErrors(__cudaFree(m_pDeviceSobolDirVec));
             checkCudaErrors(__cudaFree(m_pDeviceSobelConsts));
@@ -121,7 +123,6 @@ CRandom::~CRandom()
         default:
         {
             CURAND_CALL(curandDestroyGenerator(m_HGen));
-            checkCudaErrors(__cudaFree(m_deviceBuffer));
             checkCudaErrors(__cudaFree(m_pDeviceRandStatesXORWOW));
         }
         break;
@@ -236,11 +237,270 @@ void CRandom::InitialTableSchrage(UINT )
     _kernalAllocateSeedTable << <block, threads >> > (m_pDeviceSeedTable);
 }
 
+void CRandom::InitialCounter(UINT )
+{
+    checkCudaErrors(__cudaMalloc((void **)&m_pDeviceCounterKey, sizeof(UINT) * 4));
+    CopyCounterKey();
+}
+
+void CRandom::CopyCounterKey()
+{
+    m_uiHostCounterKey[0] = m_uiTrajectory;
+    m_uiHostCounterKey[1] = m_uiPurpose;
+    m_uiHostCounterKey[2] = m_uiStream;
+    m_uiHostCounterKey[3] = m_uiLaunch;
+    checkCudaErrors(cudaMemcpyAsync(m_pDeviceCounterKey, m_uiHostCounterKey, sizeof(UINT) * 4, cudaMemcpyHostToDevice));
+}
+
+void CRandom::SetTrajectory(UINT uiTrajectory)
+{
+    if (ER_PHILOX_COUNTER != m_eRandomType)
+    {
+        return;
+    }
+    m_uiTrajectory = uiTrajectory;
+    m_uiPurpose = static_cast<UINT>(ERP_Update);
+    m_uiLaunch = 0;
+    m_uiHostCounter = 0;
+    m_uiHostCachedBlock = 0xffffffffU;
+    CopyCounterKey();
+}
+
+void CRandom::SetPurpose(ERandomPurpose ePurpose)
+{
+    if (ER_PHILOX_COUNTER != m_eRandomType || static_cast<UINT>(ePurpose) == m_uiPurpose)
+    {
+        return;
+    }
+    //the launch is not reset, so that a purpose used twice in one trajectory gives different numbers
+    m_uiPurpose = static_cast<UINT>(ePurpose);
+    m_uiHostCachedBlock = 0xffffffffU;
+    CopyCounterKey();
+}
+
+void CRandom::NextLaunch()
+{
+    if (ER_PHILOX_COUNTER != m_eRandomType)
+    {
+        return;
+    }
+    ++m_uiLaunch;
+    CopyCounterKey();
+}
+
+void CRandom::SetStream(UINT uiStream)
+{
+    if (ER_PHILOX_COUNTER != m_eRandomType)
+    {
+        return;
+    }
+    m_uiStream = uiStream;
+    m_uiHostCachedBlock = 0xffffffffU;
+    CopyCounterKey();
+}
+
+void CRandom::FillRandomF(Real* pBuffer, UINT uiCount)
+{
+    for (UINT i = 0; i < uiCount; ++i)
+    {
+        pBuffer[i] = GetRandomF();
+    }
+}
+
+void CRandom::FillRandomGaussF(Real* pBuffer, UINT uiCount)
+{
+    for (UINT i = 0; i < uiCount; i += 2)
+    {
+        const Real f1 = GetRandomF();
+        const Real f2 = GetRandomF() * PI2;
+
+        const Real oneMinusf1 = F(1.0) - f1;
+        const Real inSqrt = -F(2.0) * _hostlog(oneMinusf1 > F(0.0) ? oneMinusf1 : (_CLG_FLT_MIN));
+        const Real amplitude = (inSqrt > F(0.0) ? _hostsqrt(inSqrt) : F(0.0)) * InvSqrt2;
+        pBuffer[i] = _hostcos(f2) * amplitude;
+        if (i + 1 < uiCount)
+        {
+            pBuffer[i + 1] = _hostsin(f2) * amplitude;
+        }
+    }
+}
+
+void CRandom::GetDeviceState(BYTE*& pDeviceState, UINT& uiStateSize) const
+{
+    switch (m_eRandomType)
+    {
+    case ER_Schrage:
+        pDeviceState = (BYTE*)m_pDeviceSeedTable;
+        uiStateSize = static_cast<UINT>(sizeof(UINT) * _HC_Volume * (_HC_Dir + 1));
+        break;
+    case ER_PHILOX_COUNTER:
+        //no state on device
+        pDeviceState = NULL;
+        uiStateSize = 0;
+        break;
+    case ER_MRG32K3A:
+        pDeviceState = (BYTE*)m_pDeviceRandStatesMRG;
+        uiStateSize = static_cast<UINT>(sizeof(curandStateMRG32k3a) * _HC_Volume * (_HC_Dir + 1));
+        break;
+    case ER_PHILOX4_32_10:
+        pDeviceState = (BYTE*)m_pDeviceRandStatesPhilox;
+        uiStateSize = static_cast<UINT>(sizeof(curandStatePhilox4_32_10_t) * _HC_Volume * (_HC_Dir + 1));
+        break;
+    case ER_QUASI_SOBOL32:
+        pDeviceState = (BYTE*)m_pDeviceRandStatesSobol32;
+        uiStateSize = static_cast<UINT>(sizeof(curandStateSobol32) * _HC_Volume);
+        break;
+    case ER_SCRAMBLED_SOBOL32:
+        pDeviceState = (BYTE*)m_pDeviceRandStatesScrambledSobol32;
+        uiStateSize = static_cast<UINT>(sizeof(curandStateScrambledSobol32) * _HC_Volume);
+        break;
+    case ER_XORWOW:
+    default:
+        pDeviceState = (BYTE*)m_pDeviceRandStatesXORWOW;
+        uiStateSize = static_cast<UINT>(sizeof(curandState) * _HC_Volume);
+        break;
+    }
+}
+
+/**
+* type, seed, trajectory, purpose, stream, launch, host counter, host seed, host batch count, host buffer index, device state size
+* followed by the device state
+*/
+BYTE* CRandom::CopyStateOut(UINT& uiSize) const
+{
+    BYTE* pDeviceState = NULL;
+    UINT uiStateSize = 0;
+    GetDeviceState(pDeviceState, uiStateSize);
+
+    const UINT header[11] = {
+        static_cast<UINT>(m_eRandomType), m_uiSeed, m_uiTrajectory, m_uiPurpose, m_uiStream, m_uiLaunch,
+        m_uiHostCounter, m_uiHostSeed, m_uiHostBatchCount, m_uiHostBufferIndex, uiStateSize };
+    uiSize = static_cast<UINT>(sizeof(UINT) * 11) + uiStateSize;
+    BYTE* byToSave = (BYTE*)malloc(static_cast<size_t>(uiSize));
+    memcpy(byToSave, header, sizeof(UINT) * 11);
+    if (uiStateSize > 0)
+    {
+        checkCudaErrors(cudaMemcpy(byToSave + sizeof(UINT) * 11, pDeviceState, uiStateSize, cudaMemcpyDeviceToHost));
+    }
+    return byToSave;
+}
+
+UBOOL CRandom::InitialStateWithByte(const BYTE* byData, UINT uiSize)
+{
+    BYTE* pDeviceState = NULL;
+    UINT uiStateSize = 0;
+    GetDeviceState(pDeviceState, uiStateSize);
+
+    UINT header[11];
+    if (uiSize < sizeof(UINT) * 11)
+    {
+        appCrucial(_T("CRandom: random state is too short!\n"));
+        return FALSE;
+    }
+    memcpy(header, byData, sizeof(UINT) * 11);
+    if (header[0] != static_cast<UINT>(m_eRandomType) || header[1] != m_uiSeed
+     || header[10] != uiStateSize || uiSize != sizeof(UINT) * 11 + uiStateSize)
+    {
+        appCrucial(_T("CRandom: random state does not match the random type, seed or lattice!\n"));
+        return FALSE;
+    }
+
+    m_uiTrajectory = header[2];
+    m_uiPurpose = header[3];
+    m_uiStream = header[4];
+    m_uiLaunch = header[5];
+    m_uiHostCounter = header[6];
+    m_uiHostSeed = header[7];
+    m_uiHostBatchCount = header[8];
+    m_uiHostBufferIndex = header[9];
+    if (uiStateSize > 0)
+    {
+        checkCudaErrors(cudaMemcpy(pDeviceState, byData + sizeof(UINT) * 11, uiStateSize, cudaMemcpyHostToDevice));
+    }
+
+    if (ER_PHILOX_COUNTER == m_eRandomType)
+    {
+        m_uiHostCachedBlock = 0xffffffffU;
+        CopyCounterKey();
+    }
+    else if (ER_Schrage != m_eRandomType && m_uiHostBatchCount > 0)
+    {
+        //regenerate the current batch of the host generator
+        if (CURAND_STATUS_SUCCESS != curandSetGeneratorOffset(m_HGen, static_cast<ULONGLONG>(m_uiHostBatchCount - 1) * __HOST_RANDOM_BATCH)
+         || CURAND_STATUS_SUCCESS != curandGenerateUniform(m_HGen, m_pHostBuffer, __HOST_RANDOM_BATCH))
+        {
+            appCrucial(_T("CRandom: failed to restore the host random!\n"));
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
 Real GetRandomReal()
 {
     return appGetLattice()->m_pRandom->GetRandomF();
 }
 
+#pragma region Device fill
+
+/**
+* Each thread fills uiPerThread numbers, [uiSiteIndex * uiPerThread, (uiSiteIndex + 1) * uiPerThread)
+*/
+__global__ void _CLG_LAUNCH_BOUND
+_kernelFillRandomF(Real* pDeviceBuffer, UINT uiCount, UINT uiPerThread)
+{
+    intokernal;
+    const UINT uiFatIndex = _deviceGetFatIndex(uiSiteIndex, 0);
+    SRandomDraw uiDraw;
+    const UINT uiStart = uiSiteIndex * uiPerThread;
+    for (UINT i = 0; i < uiPerThread && uiStart + i < uiCount; ++i)
+    {
+        pDeviceBuffer[uiStart + i] = _deviceRandomF(uiFatIndex, uiDraw);
+    }
+}
+
+/**
+* uiPerThread is even, both of the Box-Muller numbers are used
+*/
+__global__ void _CLG_LAUNCH_BOUND
+_kernelFillRandomGaussF(Real* pDeviceBuffer, UINT uiCount, UINT uiPerThread)
+{
+    intokernal;
+    const UINT uiFatIndex = _deviceGetFatIndex(uiSiteIndex, 0);
+    SRandomDraw uiDraw;
+    const UINT uiStart = uiSiteIndex * uiPerThread;
+    for (UINT i = 0; i < uiPerThread && uiStart + i < uiCount; i += 2)
+    {
+        const CLGComplex c = _deviceRandomGaussC(uiFatIndex, uiDraw);
+        pDeviceBuffer[uiStart + i] = c.x;
+        if (uiStart + i + 1 < uiCount)
+        {
+            pDeviceBuffer[uiStart + i + 1] = c.y;
+        }
+    }
+}
+
+void CRandom::FillDeviceRandomF(Real* pDeviceBuffer, UINT uiCount)
+{
+    const UINT uiVolume = static_cast<UINT>(_HC_Volume);
+    const UINT uiPerThread = (uiCount + uiVolume - 1) / uiVolume;
+    NextLaunch();
+    preparethread;
+    _kernelFillRandomF << <block, threads >> > (pDeviceBuffer, uiCount, uiPerThread);
+}
+
+void CRandom::FillDeviceRandomGaussF(Real* pDeviceBuffer, UINT uiCount)
+{
+    const UINT uiVolume = static_cast<UINT>(_HC_Volume);
+    UINT uiPerThread = (uiCount + uiVolume - 1) / uiVolume;
+    uiPerThread = uiPerThread + (uiPerThread & 1);
+    NextLaunch();
+    preparethread;
+    _kernelFillRandomGaussF << <block, threads >> > (pDeviceBuffer, uiCount, uiPerThread);
+}
+
+#pragma endregion
+
 #pragma region Test
 
 __global__ void _CLG_LAUNCH_BOUND
@@ -252,10 +512,12 @@ _kernelMCPi(UINT* output, UINT lengthyz, UINT lengthz, UINT uiLoop, UINT uithrea
     UINT uiToAdd2 = 0;
     //We have a very large grid, but for a block, it is always smaller (or equval to volumn)
     const UINT fatIndex = threadIdx.x * lengthyz + threadIdx.y * lengthz + threadIdx.z;
+    //fatIndex is shared by the blocks, for ER_PHILOX_COUNTER, each block starts from a different draw
+    SRandomDraw uiDraw(((blockIdx.x * gridDim.y + blockIdx.y) * gridDim.z + blockIdx.z) * uiLoop * 2);
     for (UINT i = 0; i < uiLoop; ++i)
     {
-        const Real x = _deviceRandomF(fatIndex) * F(2.0) - F(1.0);
-        const Real y = _deviceRandomF(fatIndex) * F(2.0) - F(1.0);
+        const Real x = _deviceRandomF(fatIndex, uiDraw) * F(2.0) - F(1.0);
+        const Real y = _deviceRandomF(fatIndex, uiDraw) * F(2.0) - F(1.0);
         if (x * x + y * y < F(1.0))
         {
             ++uiToAdd;
@@ -289,9 +551,10 @@ _kernelMCE(Real* output, UINT lengthyz, UINT lengthz, UINT uiLoop, UINT uithread
     Real fToAdd = 0;
     Real fToAdd2 = 0;
     const UINT fatIndex = threadIdx.x * lengthyz + threadIdx.y * lengthz + threadIdx.z;
+    SRandomDraw uiDraw(((blockIdx.x * gridDim.y + blockIdx.y) * gridDim.z + blockIdx.z) * uiLoop * 2);
     for (UINT i = 0; i < uiLoop; ++i)
     {
-        const CLGComplex c = _deviceRandomGaussC(fatIndex);
+        const CLGComplex c = _deviceRandomGaussC(fatIndex, uiDraw);
         fToAdd += (c.x + c.y);
         fToAdd2 += (c.x * c.x + c.y * c.y);
     }
@@ -332,6 +595,7 @@ Real CLGAPI CalculatePi(const TArray<UINT> & decompose)
     checkCudaErrors(cudaMalloc((void**)&outPut, sizeof(UINT) * 2));
     checkCudaErrors(cudaMemcpy(outPut, outPutHost, sizeof(UINT) * 2, cudaMemcpyHostToDevice));
 
+    appGetLattice()->m_pRandom->NextLaunch();
     _kernelMCPi << <blocknumber, threadnumber >> > (outPut, lengthyz, lengthz, uiLoop, threadCount);
     checkCudaErrors(cudaGetLastError());
     checkCudaErrors(cudaDeviceSynchronize());
@@ -361,6 +625,7 @@ Real CLGAPI CalculateE(const TArray<UINT> & decompose)
     checkCudaErrors(cudaMalloc((void**)&outPut, sizeof(Real) * 2));
     checkCudaErrors(cudaMemcpy(outPut, outPutHost, sizeof(Real) * 2, cudaMemcpyHostToDevice));
 
+    appGetLattice()->m_pRandom->NextLaunch();
     _kernelMCE << <blocknumber, threadnumber >> > (outPut, lengthyz, lengthz, uiLoop, threadCount);
     checkCudaErrors(cudaGetLastError());
     checkCudaErrors(cudaDeviceSynchronize());
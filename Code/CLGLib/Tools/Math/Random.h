@@ -15,9 +15,12 @@
 
 #define __SOBEL_OFFSET_MAX (4096)
 
-#define __DefineRandomFuncion(rettype, funcname) __device__ __inline__ static rettype _deviceRandom##funcname(UINT uiFatIndex) \
+//host random numbers are generated on the host in batches of this size
+#define __HOST_RANDOM_BATCH (4096)
+
+#define __DefineRandomFuncion(rettype, funcname) __device__ __inline__ static rettype _deviceRandom##funcname(UINT uiFatIndex, SRandomDraw& uiDraw) \
 { \
-    return __r->_deviceRandom##funcname(uiFatIndex); \
+    return __r->_deviceRandom##funcname(uiFatIndex, uiDraw); \
 }
 
 
@@ -27,6 +30,25 @@
 
 __BEGIN_NAMESPACE
 
+/**
+* The numbers drawn by one thread in one launch.
+* m_uiDraw is the index of the next number. For ER_PHILOX_COUNTER, one Philox4x32-10 gives 4 numbers,
+* the 4 words are kept so that the 10 rounds run once for every 4 draws.
+*/
+struct SRandomDraw
+{
+    __host__ __device__ SRandomDraw(UINT uiDraw = 0)
+        : m_uiDraw(uiDraw)
+        , m_uiCachedBlock(0xffffffffU)
+    {
+
+    }
+
+    UINT m_uiDraw;
+    UINT m_uiCachedBlock;
+    UINT m_uiWords[4];
+};
+
 __DEFINE_ENUM (ERandom,
     ER_Schrage,
 
@@ -36,10 +58,23 @@ __DEFINE_ENUM (ERandom,
     ER_PHILOX4_32_10,
     ER_QUASI_SOBOL32,
     ER_SCRAMBLED_SOBOL32,
+    ER_PHILOX_COUNTER,
 
     ER_ForceDWORD = 0x7fffffff,
     )
 
+/**
+* For ER_PHILOX_COUNTER, the purpose is part of the counter
+*/
+__DEFINE_ENUM (ERandomPurpose,
+    ERP_Update,
+    ERP_Momentum,
+    ERP_PseudoFermion,
+    ERP_Measurement,
+
+    ERP_ForceDWORD = 0x7fffffff,
+    )
+
 __DEFINE_ENUM (ERandomSeedType,
     ERST_Number,
     ERST_Timestamp,
@@ -69,8 +104,19 @@ public:
     * CURAND_RNG_QUASI_SCRAMBLED_SOBOL64 is a scrambled Sobol generator of 64-bit sequences.
     */
     CRandom(UINT uiSeed, ERandom er) 
-        : m_eRandomType(er)
+        : m_pHostBuffer(NULL)
+        , m_uiHostBufferIndex(__HOST_RANDOM_BATCH)
+        , m_uiHostBatchCount(0)
+        , m_eRandomType(er)
         , m_uiFatIdDivide(1)
+        , m_uiSeed(uiSeed)
+        , m_uiTrajectory(0)
+        , m_uiPurpose(0)
+        , m_uiStream(0)
+        , m_uiLaunch(0)
+        , m_uiHostCounter(0)
+        , m_uiHostCachedBlock(0xffffffffU)
+        , m_pDeviceCounterKey(NULL)
         , m_uiHostSeed(uiSeed)
     { 
         switch (er)
@@ -80,49 +126,52 @@ public:
                     InitialTableSchrage(uiSeed);
                 }
                 break;
+            case ER_PHILOX_COUNTER:
+                {
+                    InitialCounter(uiSeed);
+                }
+                break;
             case ER_MRG32K3A:
                 {
-                    CURAND_CALL(curandCreateGenerator(&m_HGen, CURAND_RNG_PSEUDO_MRG32K3A));
+                    CURAND_CALL(curandCreateGeneratorHost(&m_HGen, CURAND_RNG_PSEUDO_MRG32K3A));
                     CURAND_CALL(curandSetPseudoRandomGeneratorSeed(m_HGen, uiSeed));
-                    checkCudaErrors(cudaMalloc((void**)&m_deviceBuffer, sizeof(FLOAT)));
                     InitialStatesMRG(uiSeed);
                 }
                 break;
             case ER_PHILOX4_32_10:
                 {
-                    CURAND_CALL(curandCreateGenerator(&m_HGen, CURAND_RNG_PSEUDO_PHILOX4_32_10));
+                    CURAND_CALL(curandCreateGeneratorHost(&m_HGen, CURAND_RNG_PSEUDO_PHILOX4_32_10));
                     CURAND_CALL(curandSetPseudoRandomGeneratorSeed(m_HGen, uiSeed));
-                    checkCudaErrors(cudaMalloc((void**)&m_deviceBuffer, sizeof(FLOAT)));
                     InitialStatesPhilox(uiSeed);
                 }
                 break;
             case ER_QUASI_SOBOL32:
                 {
-                    //for sobol, on the host, we use XORWOW
-                    CURAND_CALL(curandCreateGenerator(&m_HGen, CURAND_RNG_QUASI_SOBOL32));
-                    checkCudaErrors(cudaMalloc((void**)&m_deviceBuffer, sizeof(FLOAT)));
+                    CURAND_CALL(curandCreateGeneratorHost(&m_HGen, CURAND_RNG_QUASI_SOBOL32));
                     InitialStatesSobol32(uiSeed);
                 }
                 break;
             case ER_SCRAMBLED_SOBOL32:
                 {
-                    //for sobol, on the host, we use XORWOW
-                    CURAND_CALL(curandCreateGenerator(&m_HGen, CURAND_RNG_QUASI_SCRAMBLED_SOBOL32));
-                    checkCudaErrors(cudaMalloc((void**)&m_deviceBuffer, sizeof(FLOAT)));
+                    CURAND_CALL(curandCreateGeneratorHost(&m_HGen, CURAND_RNG_QUASI_SCRAMBLED_SOBOL32));
                     InitialStatesScrambledSobol32(uiSeed);
                 }
                 break;
             case ER_XORWOW:
             default:
                 {
-                    CURAND_CALL(curandCreateGenerator(&m_HGen, CURAND_RNG_PSEUDO_XORWOW));
+                    CURAND_CALL(curandCreateGeneratorHost(&m_HGen, CURAND_RNG_PSEUDO_XORWOW));
                     CURAND_CALL(curandSetPseudoRandomGeneratorSeed(m_HGen, uiSeed));
-                    checkCudaErrors(cudaMalloc((void**)&m_deviceBuffer, sizeof(FLOAT)));
                     InitialStatesXORWOW(uiSeed);
                 }
                 break;
         }
 
+        if (ER_Schrage != er && ER_PHILOX_COUNTER != er)
+        {
+            m_pHostBuffer = new FLOAT[__HOST_RANDOM_BATCH];
+        }
+
         checkCudaErrors(cudaGetLastError());
     }
 
@@ -130,13 +179,17 @@ public:
 
     /**
     * Note that this gives [0, 1), and curand_uniform gives (0, 1]
+    * uiDraw is the numbers drawn by the thread at fatIndex in this launch,
+    * it is increased by each call. Only ER_PHILOX_COUNTER uses it, others keep a state for each fatIndex.
     */
-    __device__ __inline__ Real _deviceRandomF(UINT fatIndex) const
+    __device__ __inline__ Real _deviceRandomF(UINT fatIndex, SRandomDraw& uiDraw) const
     {
         switch (m_eRandomType)
         {
             case ER_Schrage:
                 return AM * _deviceRandomUISchrage(fatIndex);
+            case ER_PHILOX_COUNTER:
+                return _deviceRandomCounter(fatIndex, uiDraw);
             case ER_MRG32K3A:
                 return 1 - curand_uniform(&(m_pDeviceRandStatesMRG[fatIndex]));
             case ER_PHILOX4_32_10:
@@ -157,10 +210,10 @@ public:
     * Although in bridge++, it says the deviation is 1/_sqrt(2)
     * In fact, the standard deviation of it is 1
     */
-    __device__ __inline__ Real _deviceRandomGaussF(UINT fatIndex) const
+    __device__ __inline__ Real _deviceRandomGaussF(UINT fatIndex, SRandomDraw& uiDraw) const
     {
-        const Real f1 = _deviceRandomF(fatIndex);
-        const Real f2 = _deviceRandomF(fatIndex) * PI2;
+        const Real f1 = _deviceRandomF(fatIndex, uiDraw);
+        const Real f2 = _deviceRandomF(fatIndex, uiDraw) * PI2;
 
         const Real oneMinusf1 = F(1.0) - f1;
         const Real inSqrt = -F(2.0) * _log(oneMinusf1 > F(0.0) ? oneMinusf1 : (_CLG_FLT_MIN));
@@ -168,10 +221,10 @@ public:
         return _cos(f2) * amplitude;
     }
 
-    __device__ __inline__ Real _deviceRandomGaussFSqrt2(UINT fatIndex) const
+    __device__ __inline__ Real _deviceRandomGaussFSqrt2(UINT fatIndex, SRandomDraw& uiDraw) const
     {
-        const Real f1 = _deviceRandomF(fatIndex);
-        const Real f2 = _deviceRandomF(fatIndex) * PI2;
+        const Real f1 = _deviceRandomF(fatIndex, uiDraw);
+        const Real f2 = _deviceRandomF(fatIndex, uiDraw) * PI2;
 
         const Real oneMinusf1 = F(1.0) - f1;
         const Real inSqrt = -F(2.0) * _log(oneMinusf1 > F(0.0) ? oneMinusf1 : (_CLG_FLT_MIN));
@@ -179,10 +232,10 @@ public:
         return _cos(f2) * amplitude;
     }
 
-    __device__ __inline__ CLGComplex _deviceRandomGaussC(UINT fatIndex) const
+    __device__ __inline__ CLGComplex _deviceRandomGaussC(UINT fatIndex, SRandomDraw& uiDraw) const
     {
-        const Real f1 = _deviceRandomF(fatIndex);
-        const Real f2 = _deviceRandomF(fatIndex) * PI2;
+        const Real f1 = _deviceRandomF(fatIndex, uiDraw);
+        const Real f2 = _deviceRandomF(fatIndex, uiDraw) * PI2;
 
         const Real oneMinusf1 = F(1.0) - f1;
         const Real inSqrt = -F(2.0) * _log(oneMinusf1 > F(0.0) ? oneMinusf1 : (_CLG_FLT_MIN));
@@ -190,9 +243,23 @@ public:
         return _make_cuComplex(_cos(f2) * amplitude, _sin(f2) * amplitude);
     }
 
-    __device__ __inline__ CLGComplex _deviceRandomZ4(UINT fatIndex) const
+    /**
+    * Two Gaussian numbers of _deviceRandomGaussFSqrt2, from one Box-Muller
+    */
+    __device__ __inline__ CLGComplex _deviceRandomGaussCSqrt2(UINT fatIndex, SRandomDraw& uiDraw) const
+    {
+        const Real f1 = _deviceRandomF(fatIndex, uiDraw);
+        const Real f2 = _deviceRandomF(fatIndex, uiDraw) * PI2;
+
+        const Real oneMinusf1 = F(1.0) - f1;
+        const Real inSqrt = -F(2.0) * _log(oneMinusf1 > F(0.0) ? oneMinusf1 : (_CLG_FLT_MIN));
+        const Real amplitude = (inSqrt > F(0.0) ? _sqrt(inSqrt) : F(0.0)) * F(0.5);
+        return _make_cuComplex(_cos(f2) * amplitude, _sin(f2) * amplitude);
+    }
+
+    __device__ __inline__ CLGComplex _deviceRandomZ4(UINT fatIndex, SRandomDraw& uiDraw) const
     {
-        const INT byRandom = _floor2int(F(4.0) * _deviceRandomF(fatIndex));
+        const INT byRandom = _floor2int(F(4.0) * _deviceRandomF(fatIndex, uiDraw));
 
         if (0 == byRandom)
         {
@@ -216,19 +283,70 @@ public:
             return AM * GetRandomUISchrage();
         }
 
-        curandGenerateUniform(m_HGen, m_deviceBuffer, 1);
-        checkCudaErrors(cudaMemcpy(m_hostBuffer, m_deviceBuffer, sizeof(FLOAT), cudaMemcpyDeviceToHost));
-        return (Real)m_hostBuffer[0];
+        if (ER_PHILOX_COUNTER == m_eRandomType)
+        {
+            //the host random numbers use the site 0xffffffff
+            const UINT uiBlock = m_uiHostCounter >> 2;
+            if (uiBlock != m_uiHostCachedBlock)
+            {
+                _philox4x32(m_uiSeed, m_uiStream, uiBlock, 0xffffffffU, m_uiTrajectory, m_uiPurpose, m_uiHostWords);
+                m_uiHostCachedBlock = uiBlock;
+            }
+            const UINT uiRandom = m_uiHostWords[m_uiHostCounter & 3];
+            ++m_uiHostCounter;
+            return _counterToReal(uiRandom);
+        }
+
+        //the generator is a host generator, so there is no device synchronization
+        if (m_uiHostBufferIndex >= __HOST_RANDOM_BATCH)
+        {
+            curandGenerateUniform(m_HGen, m_pHostBuffer, __HOST_RANDOM_BATCH);
+            m_uiHostBufferIndex = 0;
+            ++m_uiHostBatchCount;
+        }
+        //curand_uniform gives (0, 1]
+        return F(1.0) - static_cast<Real>(m_pHostBuffer[m_uiHostBufferIndex++]);
     }
 
-    FLOAT* m_deviceBuffer;
-    FLOAT m_hostBuffer[1];
+    /**
+    * Fill the host array with uniform [0, 1)
+    */
+    void FillRandomF(Real* pBuffer, UINT uiCount);
+
+    /**
+    * Fill the host array with the same distribution as _deviceRandomGaussF,
+    * both of the Box-Muller numbers are used
+    */
+    void FillRandomGaussF(Real* pBuffer, UINT uiCount);
+
+    /**
+    * Same as FillRandomF and FillRandomGaussF, but the buffer is on device.
+    * The numbers are generated by one launch of volume threads, each thread fills
+    * ceil(uiCount / volume) consecutive numbers (rounded to even for Gaussian),
+    * so uiCount can be larger than the volume.
+    */
+    void FillDeviceRandomF(Real* pDeviceBuffer, UINT uiCount);
+    void FillDeviceRandomGaussF(Real* pDeviceBuffer, UINT uiCount);
+
+    /**
+    * All states of the host and device random, used by checkpoint
+    * Need to free the pointer
+    */
+    BYTE* CopyStateOut(UINT& uiSize) const;
+    UBOOL InitialStateWithByte(const BYTE* byData, UINT uiSize);
+
+    FLOAT* m_pHostBuffer;
+    UINT m_uiHostBufferIndex;
+    //number of batches generated, to restore the host generator
+    UINT m_uiHostBatchCount;
     curandGenerator_t m_HGen;
     ERandom m_eRandomType;
     UINT m_uiFatIdDivide;
 
 protected:
 
+    void GetDeviceState(BYTE*& pDeviceState, UINT& uiStateSize) const;
+
     void InitialStatesXORWOW(UINT uiSeed);
     void InitialStatesPhilox(UINT uiSeed);
     void InitialStatesMRG(UINT uiSeed);
@@ -244,6 +362,112 @@ protected:
     UINT* m_pDeviceSobelConsts;
     curandStateScrambledSobol32* m_pDeviceRandStatesScrambledSobol32;
 
+#pragma region Counter
+
+public:
+
+    /**
+    * For ER_PHILOX_COUNTER, the k-th random number drawn by the thread of a site in the l-th launch of a trajectory is
+    * Philox4x32-10 with key = (seed, stream), and counter = (k / 4, site, trajectory, purpose + 256 l)
+    * so it depends neither on the thread decomposition nor on the history of the chain.
+    * There is no state on device, k is counted by the thread (uiDraw of _deviceRandomF),
+    * l is counted on host, NextLaunch must be called before each kernel using random numbers.
+    *
+    * For other random types, these functions do nothing.
+    */
+    void SetTrajectory(UINT uiTrajectory);
+    void NextTrajectory() { SetTrajectory(m_uiTrajectory + 1); }
+    UINT GetTrajectory() const { return m_uiTrajectory; }
+    void SetPurpose(ERandomPurpose ePurpose);
+    void SetStream(UINT uiStream);
+    UINT GetStream() const { return m_uiStream; }
+    void NextLaunch();
+
+    /**
+    * Philox4x32-10, same on host and device, the 4 words of the counter (uiBlock, site, trajectory, purpose)
+    */
+    __host__ __device__ __inline__ static void _philox4x32(UINT uiSeed, UINT uiStream, UINT uiBlock, UINT uiSite, UINT uiTrajectory, UINT uiPurpose, UINT* pWords)
+    {
+        UINT c0 = uiBlock;
+        UINT c1 = uiSite;
+        UINT c2 = uiTrajectory;
+        UINT c3 = uiPurpose;
+        UINT k0 = uiSeed;
+        UINT k1 = uiStream;
+        for (BYTE byRound = 0; byRound < 10; ++byRound)
+        {
+            const ULONGLONG p0 = static_cast<ULONGLONG>(0xD2511F53U) * c0;
+            const ULONGLONG p1 = static_cast<ULONGLONG>(0xCD9E8D57U) * c2;
+            c0 = static_cast<UINT>(p1 >> 32) ^ c1 ^ k0;
+            c1 = static_cast<UINT>(p1);
+            c2 = static_cast<UINT>(p0 >> 32) ^ c3 ^ k1;
+            c3 = static_cast<UINT>(p0);
+            k0 += 0x9E3779B9U;
+            k1 += 0xBB67AE85U;
+        }
+        pWords[0] = c0;
+        pWords[1] = c1;
+        pWords[2] = c2;
+        pWords[3] = c3;
+    }
+
+    /**
+    * [0, 1)
+    */
+    __host__ __device__ __inline__ static Real _counterToReal(UINT uiRandom)
+    {
+#if _CLG_DOUBLEFLOAT
+        return uiRandom * F(2.3283064365386962890625e-10);
+#else
+        return (uiRandom >> 8) * F(5.9604644775390625e-08);
+#endif
+    }
+
+protected:
+
+    void InitialCounter(UINT uiSeed);
+
+    /**
+    * The k-th number is the word k % 4 of the block k / 4, a new block is generated every 4 draws
+    */
+    __device__ __inline__ Real _deviceRandomCounter(UINT fatIndex, SRandomDraw& uiDraw) const
+    {
+        const UINT uiBlock = uiDraw.m_uiDraw >> 2;
+        if (uiBlock != uiDraw.m_uiCachedBlock)
+        {
+            _philox4x32(m_uiSeed, m_pDeviceCounterKey[2], uiBlock, fatIndex, m_pDeviceCounterKey[0], m_pDeviceCounterKey[1] + (m_pDeviceCounterKey[3] << 8), uiDraw.m_uiWords);
+            uiDraw.m_uiCachedBlock = uiBlock;
+        }
+        //select without a dynamic index, so that the words stay in registers
+        const UINT uiWord = uiDraw.m_uiDraw & 3;
+        ++uiDraw.m_uiDraw;
+        return _counterToReal(0 == uiWord ? uiDraw.m_uiWords[0]
+            : (1 == uiWord ? uiDraw.m_uiWords[1]
+            : (2 == uiWord ? uiDraw.m_uiWords[2] : uiDraw.m_uiWords[3])));
+    }
+
+    /**
+    * The key is copied with cudaMemcpyAsync from m_uiHostCounterKey, which is a pageable member,
+    * so the value is staged when called and the later changes do not affect the copy in the stream.
+    * It is not blocking, the kernels after it in the default stream see the new key.
+    */
+    void CopyCounterKey();
+
+    UINT m_uiSeed;
+    UINT m_uiTrajectory;
+    UINT m_uiPurpose;
+    UINT m_uiStream;
+    UINT m_uiLaunch;
+    UINT m_uiHostCounter;
+    //the Philox words of the block m_uiHostCounter / 4, same as SRandomDraw
+    UINT m_uiHostCachedBlock;
+    UINT m_uiHostWords[4];
+    //trajectory, purpose, stream, launch, the device copy of CRandom is not updated, so they are on device
+    UINT m_uiHostCounterKey[4];
+    UINT* m_pDeviceCounterKey;
+
+#pragma endregion
+
 #pragma region Schrage
 
 public:
@@ -288,6 +512,8 @@ __DefineRandomFuncion(Real, GaussFSqrt2)
 
 __DefineRandomFuncion(CLGComplex, GaussC)
 
+__DefineRandomFuncion(CLGComplex, GaussCSqrt2)
+
 __DefineRandomFuncion(CLGComplex, Z4)
 
 extern CLGAPI Real GetRandomReal();
@@ -158,20 +158,20 @@ extern "C" {
 
         /**
         * can be called only after CLatticeData is created
-        * ret = random
+        * ret = random, uiDraw is the draw index of _deviceRandomF
         */
-        __device__ __inline__ static deviceSU3 makeSU3Random(UINT fatIndex)
+        __device__ __inline__ static deviceSU3 makeSU3Random(UINT fatIndex, SRandomDraw& uiDraw)
         {
             deviceSU3 ret;
-            ret.m_me[0] = _make_cuComplex(_deviceRandomF(fatIndex) - F(0.5), _deviceRandomF(fatIndex) - F(0.5));
-            ret.m_me[1] = _make_cuComplex(_deviceRandomF(fatIndex) - F(0.5), _deviceRandomF(fatIndex) - F(0.5));
-            ret.m_me[2] = _make_cuComplex(_deviceRandomF(fatIndex) - F(0.5), _deviceRandomF(fatIndex) - F(0.5));
-            ret.m_me[3] = _make_cuComplex(_deviceRandomF(fatIndex) - F(0.5), _deviceRandomF(fatIndex) - F(0.5));
-            ret.m_me[4] = _make_cuComplex(_deviceRandomF(fatIndex) - F(0.5), _deviceRandomF(fatIndex) - F(0.5));
-            ret.m_me[5] = _make_cuComplex(_deviceRandomF(fatIndex) - F(0.5), _deviceRandomF(fatIndex) - F(0.5));
-            ret.m_me[6] = _make_cuComplex(_deviceRandomF(fatIndex) - F(0.5), _deviceRandomF(fatIndex) - F(0.5));
-            ret.m_me[7] = _make_cuComplex(_deviceRandomF(fatIndex) - F(0.5), _deviceRandomF(fatIndex) - F(0.5));
-            ret.m_me[8] = _make_cuComplex(_deviceRandomF(fatIndex) - F(0.5), _deviceRandomF(fatIndex) - F(0.5));
+            ret.m_me[0] = _make_cuComplex(_deviceRandomF(fatIndex, uiDraw) - F(0.5), _deviceRandomF(fatIndex, uiDraw) - F(0.5));
+            ret.m_me[1] = _make_cuComplex(_deviceRandomF(fatIndex, uiDraw) - F(0.5), _deviceRandomF(fatIndex, uiDraw) - F(0.5));
+            ret.m_me[2] = _make_cuComplex(_deviceRandomF(fatIndex, uiDraw) - F(0.5), _deviceRandomF(fatIndex, uiDraw) - F(0.5));
+            ret.m_me[3] = _make_cuComplex(_deviceRandomF(fatIndex, uiDraw) - F(0.5), _deviceRandomF(fatIndex, uiDraw) - F(0.5));
+            ret.m_me[4] = _make_cuComplex(_deviceRandomF(fatIndex, uiDraw) - F(0.5), _deviceRandomF(fatIndex, uiDraw) - F(0.5));
+            ret.m_me[5] = _make_cuComplex(_deviceRandomF(fatIndex, uiDraw) - F(0.5), _deviceRandomF(fatIndex, uiDraw) - F(0.5));
+            ret.m_me[6] = _make_cuComplex(_deviceRandomF(fatIndex, uiDraw) - F(0.5), _deviceRandomF(fatIndex, uiDraw) - F(0.5));
+            ret.m_me[7] = _make_cuComplex(_deviceRandomF(fatIndex, uiDraw) - F(0.5), _deviceRandomF(fatIndex, uiDraw) - F(0.5));
+            ret.m_me[8] = _make_cuComplex(_deviceRandomF(fatIndex, uiDraw) - F(0.5), _deviceRandomF(fatIndex, uiDraw) - F(0.5));
             ret.Norm();
             return ret;
         }
@@ -187,16 +187,21 @@ extern "C" {
         *     r4+ir5           r6+ir7      -2r8/sqrt3
         *
         */
-        __device__ __inline__ static deviceSU3 makeSU3RandomGenerator(UINT fatIndex)
+        __device__ __inline__ static deviceSU3 makeSU3RandomGenerator(UINT fatIndex, SRandomDraw& uiDraw)
         {
-            const Real r1 = _deviceRandomGaussFSqrt2(fatIndex);
-            const Real r2 = _deviceRandomGaussFSqrt2(fatIndex);
-            const Real r3 = _deviceRandomGaussFSqrt2(fatIndex);
-            const Real r4 = _deviceRandomGaussFSqrt2(fatIndex);
-            const Real r5 = _deviceRandomGaussFSqrt2(fatIndex);
-            const Real r6 = _deviceRandomGaussFSqrt2(fatIndex);
-            const Real r7 = _deviceRandomGaussFSqrt2(fatIndex);
-            const Real r8 = _deviceRandomGaussFSqrt2(fatIndex);
+            //both numbers of Box-Muller are used
+            const CLGComplex r12 = _deviceRandomGaussCSqrt2(fatIndex, uiDraw);
+            const CLGComplex r34 = _deviceRandomGaussCSqrt2(fatIndex, uiDraw);
+            const CLGComplex r56 = _deviceRandomGaussCSqrt2(fatIndex, uiDraw);
+            const CLGComplex r78 = _deviceRandomGaussCSqrt2(fatIndex, uiDraw);
+            const Real r1 = r12.x;
+            const Real r2 = r12.y;
+            const Real r3 = r34.x;
+            const Real r4 = r34.y;
+            const Real r5 = r56.x;
+            const Real r6 = r56.y;
+            const Real r7 = r78.x;
+            const Real r8 = r78.y;
 
             deviceSU3 ret;
             //we directly generate i ra Ta instead of ra Ta
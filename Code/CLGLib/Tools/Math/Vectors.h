@@ -59,21 +59,21 @@ extern "C" {
             );
         }
 
-        __device__ __inline__ static deviceSU3Vector makeRandomGaussian(UINT fatIndex)
+        __device__ __inline__ static deviceSU3Vector makeRandomGaussian(UINT fatIndex, SRandomDraw& uiDraw)
         {
             deviceSU3Vector ret;
-            ret.m_ve[0] = _deviceRandomGaussC(fatIndex);
-            ret.m_ve[1] = _deviceRandomGaussC(fatIndex);
-            ret.m_ve[2] = _deviceRandomGaussC(fatIndex);
+            ret.m_ve[0] = _deviceRandomGaussC(fatIndex, uiDraw);
+            ret.m_ve[1] = _deviceRandomGaussC(fatIndex, uiDraw);
+            ret.m_ve[2] = _deviceRandomGaussC(fatIndex, uiDraw);
             return ret;
         }
 
-        __device__ __inline__ static deviceSU3Vector makeRandomZ4(UINT fatIndex)
+        __device__ __inline__ static deviceSU3Vector makeRandomZ4(UINT fatIndex, SRandomDraw& uiDraw)
         {
             deviceSU3Vector ret;
-            ret.m_ve[0] = _deviceRandomZ4(fatIndex);
-            ret.m_ve[1] = _deviceRandomZ4(fatIndex);
-            ret.m_ve[2] = _deviceRandomZ4(fatIndex);
+            ret.m_ve[0] = _deviceRandomZ4(fatIndex, uiDraw);
+            ret.m_ve[1] = _deviceRandomZ4(fatIndex, uiDraw);
+            ret.m_ve[2] = _deviceRandomZ4(fatIndex, uiDraw);
             return ret;
         }
 
@@ -314,23 +314,23 @@ extern "C" {
             m_d[3].Conjugate();
         }
 
-        __device__ __inline__ static deviceWilsonVectorSU3 makeRandomGaussian(UINT fatIndex)
+        __device__ __inline__ static deviceWilsonVectorSU3 makeRandomGaussian(UINT fatIndex, SRandomDraw& uiDraw)
         {
             deviceWilsonVectorSU3 ret;
-            ret.m_d[0] = deviceSU3Vector::makeRandomGaussian(fatIndex);
-            ret.m_d[1] = deviceSU3Vector::makeRandomGaussian(fatIndex);
-            ret.m_d[2] = deviceSU3Vector::makeRandomGaussian(fatIndex);
-            ret.m_d[3] = deviceSU3Vector::makeRandomGaussian(fatIndex);
+            ret.m_d[0] = deviceSU3Vector::makeRandomGaussian(fatIndex, uiDraw);
+            ret.m_d[1] = deviceSU3Vector::makeRandomGaussian(fatIndex, uiDraw);
+            ret.m_d[2] = deviceSU3Vector::makeRandomGaussian(fatIndex, uiDraw);
+            ret.m_d[3] = deviceSU3Vector::makeRandomGaussian(fatIndex, uiDraw);
             return ret;
         }
 
-        __device__ __inline__ static deviceWilsonVectorSU3 makeRandomZ4(UINT fatIndex)
+        __device__ __inline__ static deviceWilsonVectorSU3 makeRandomZ4(UINT fatIndex, SRandomDraw& uiDraw)
         {
             deviceWilsonVectorSU3 ret;
-            ret.m_d[0] = deviceSU3Vector::makeRandomZ4(fatIndex);
-            ret.m_d[1] = deviceSU3Vector::makeRandomZ4(fatIndex);
-            ret.m_d[2] = deviceSU3Vector::makeRandomZ4(fatIndex);
-            ret.m_d[3] = deviceSU3Vector::makeRandomZ4(fatIndex);
+            ret.m_d[0] = deviceSU3Vector::makeRandomZ4(fatIndex, uiDraw);
+            ret.m_d[1] = deviceSU3Vector::makeRandomZ4(fatIndex, uiDraw);
+            ret.m_d[2] = deviceSU3Vector::makeRandomZ4(fatIndex, uiDraw);
+            ret.m_d[3] = deviceSU3Vector::makeRandomZ4(fatIndex, uiDraw);
             return ret;
         }
 
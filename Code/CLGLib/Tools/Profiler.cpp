@@ -0,0 +1,299 @@
+//=============================================================================
+// FILENAME : Profiler.cpp
+//
+// DESCRIPTION:
+// This is the hierarchical scoped profiler
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#include "CLGLib_Private.h"
+
+__BEGIN_NAMESPACE
+
+CLGAPI CProfiler GProfiler;
+
+void CProfiler::Initial(const CCString& sTraceFile, UINT uiMaxTrace)
+{
+    if (m_bEnabled)
+    {
+        Release();
+    }
+    m_sTraceFile = sTraceFile;
+    m_uiMaxTrace = uiMaxTrace;
+    m_uiDroppedTrace = 0;
+    m_lstRegions.RemoveAll();
+    m_lstOpenCalls.RemoveAll();
+    m_lstFinishedCalls.RemoveAll();
+    m_lstTrace.RemoveAll();
+
+    m_kHostStart = std::chrono::steady_clock::now();
+    checkCudaErrors(cudaEventCreate(&m_pReference));
+    checkCudaErrors(cudaEventRecord(m_pReference, 0));
+    m_bEnabled = TRUE;
+}
+
+ULONGLONG CProfiler::GetHostTime() const
+{
+    return static_cast<ULONGLONG>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_kHostStart).count());
+}
+
+cudaEvent_t CProfiler::GetEvent()
+{
+    if (m_lstFreeEvents.Num() > 0)
+    {
+        const cudaEvent_t pEvent = m_lstFreeEvents[m_lstFreeEvents.Num() - 1];
+        m_lstFreeEvents.RemoveAt(m_lstFreeEvents.Num() - 1);
+        return pEvent;
+    }
+    cudaEvent_t pEvent;
+    checkCudaErrors(cudaEventCreate(&pEvent));
+    return pEvent;
+}
+
+INT CProfiler::FindRegion(INT iParent, const TCHAR* sName)
+{
+    for (INT i = 0; i < m_lstRegions.Num(); ++i)
+    {
+        if (m_lstRegions[i].m_iParent == iParent
+         && (m_lstRegions[i].m_sName == sName || 0 == appStrcmp(m_lstRegions[i].m_sName, sName)))
+        {
+            return i;
+        }
+    }
+
+    SProfilerRegion newRegion;
+    newRegion.m_sName = sName;
+    newRegion.m_iParent = iParent;
+    newRegion.m_iDepth = (iParent < 0) ? 0 : (m_lstRegions[iParent].m_iDepth + 1);
+    newRegion.m_uiCount = 0;
+    newRegion.m_fHostTime = 0.0;
+    newRegion.m_fDeviceTime = 0.0;
+    newRegion.m_ulBytes = 0;
+    return m_lstRegions.AddItem(newRegion);
+}
+
+void CProfiler::BeginRegion(const TCHAR* sName)
+{
+    if (!m_bEnabled)
+    {
+        return;
+    }
+    const INT iParent = (m_lstOpenCalls.Num() > 0) ? m_lstOpenCalls[m_lstOpenCalls.Num() - 1].m_iRegion : -1;
+
+    SProfilerCall newCall;
+    newCall.m_iRegion = FindRegion(iParent, sName);
+    newCall.m_pStart = GetEvent();
+    newCall.m_pStop = GetEvent();
+    checkCudaErrors(cudaEventRecord(newCall.m_pStart, 0));
+    newCall.m_ulHostEnd = 0;
+    newCall.m_ulHostStart = GetHostTime();
+    m_lstOpenCalls.AddItem(newCall);
+}
+
+void CProfiler::EndRegion()
+{
+    if (!m_bEnabled || m_lstOpenCalls.Num() < 1)
+    {
+        return;
+    }
+
+    SProfilerCall finishedCall = m_lstOpenCalls[m_lstOpenCalls.Num() - 1];
+    finishedCall.m_ulHostEnd = GetHostTime();
+    checkCudaErrors(cudaEventRecord(finishedCall.m_pStop, 0));
+    m_lstOpenCalls.RemoveAt(m_lstOpenCalls.Num() - 1);
+    m_lstFinishedCalls.AddItem(finishedCall);
+
+    if (0 == m_lstOpenCalls.Num())
+    {
+        Resolve(FALSE);
+    }
+}
+
+void CProfiler::AddBytes(ULONGLONG ulBytes)
+{
+    if (!m_bEnabled || m_lstOpenCalls.Num() < 1)
+    {
+        return;
+    }
+    m_lstRegions[m_lstOpenCalls[m_lstOpenCalls.Num() - 1].m_iRegion].m_ulBytes += ulBytes;
+}
+
+void CProfiler::Resolve(UBOOL bWait)
+{
+    //the calls are finished in the order of the stop events
+    INT iResolved = 0;
+    for (; iResolved < m_lstFinishedCalls.Num(); ++iResolved)
+    {
+        const SProfilerCall& call = m_lstFinishedCalls[iResolved];
+        if (bWait)
+        {
+            checkCudaErrors(cudaEventSynchronize(call.m_pStop));
+        }
+        else if (cudaErrorNotReady == cudaEventQuery(call.m_pStop))
+        {
+            break;
+        }
+
+        FLOAT fDeviceStart = 0.0f;
+        FLOAT fDeviceTime = 0.0f;
+        checkCudaErrors(cudaEventElapsedTime(&fDeviceStart, m_pReference, call.m_pStart));
+        checkCudaErrors(cudaEventElapsedTime(&fDeviceTime, call.m_pStart, call.m_pStop));
+        const DOUBLE fHostTime = (call.m_ulHostEnd - call.m_ulHostStart) * 0.000001;
+
+        SProfilerRegion& region = m_lstRegions[call.m_iRegion];
+        ++region.m_uiCount;
+        region.m_fHostTime += fHostTime;
+        region.m_fDeviceTime += fDeviceTime;
+
+        if (static_cast<UINT>(m_lstTrace.Num()) < m_uiMaxTrace)
+        {
+            SProfilerTrace trace;
+            trace.m_iRegion = call.m_iRegion;
+            trace.m_fHostStart = call.m_ulHostStart * 0.001;
+            trace.m_fHostDuration = fHostTime * 1000.0;
+            trace.m_fDeviceStart = fDeviceStart * 1000.0;
+            trace.m_fDeviceDuration = fDeviceTime * 1000.0;
+            m_lstTrace.AddItem(trace);
+        }
+        else
+        {
+            ++m_uiDroppedTrace;
+        }
+
+        m_lstFreeEvents.AddItem(call.m_pStart);
+        m_lstFreeEvents.AddItem(call.m_pStop);
+    }
+
+    if (iResolved > 0)
+    {
+        m_lstFinishedCalls.RemoveAt(0, iResolved);
+    }
+}
+
+void CProfiler::ReportRegion(INT iParent, DOUBLE fParentTime) const
+{
+    for (INT i = 0; i < m_lstRegions.Num(); ++i)
+    {
+        const SProfilerRegion& region = m_lstRegions[i];
+        if (region.m_iParent != iParent)
+        {
+            continue;
+        }
+
+        CCString sName;
+        for (INT j = 0; j < region.m_iDepth; ++j)
+        {
+            sName = sName + _T("  ");
+        }
+        sName = sName + region.m_sName;
+
+        const DOUBLE fTime = region.m_fDeviceTime > region.m_fHostTime ? region.m_fDeviceTime : region.m_fHostTime;
+        const DOUBLE fPercent = fParentTime > 0.0 ? (100.0 * fTime / fParentTime) : 100.0;
+        const DOUBLE fBandwidth = (region.m_ulBytes > 0 && region.m_fDeviceTime > 0.0)
+            ? (region.m_ulBytes / (region.m_fDeviceTime * 1000000.0)) : 0.0;
+
+        appGeneral(_T("%-48s %10d %14.3f %12.4f %14.3f %8.2f%% %10.2f\n"),
+            sName.c_str(),
+            region.m_uiCount,
+            region.m_fHostTime,
+            region.m_uiCount > 0 ? (region.m_fHostTime / region.m_uiCount) : 0.0,
+            region.m_fDeviceTime,
+            fPercent,
+            fBandwidth);
+
+        ReportRegion(i, fTime);
+    }
+}
+
+void CProfiler::WriteTrace() const
+{
+    OFSTREAM file(m_sTraceFile.c_str());
+    if (!file.good())
+    {
+        appCrucial(_T("CProfiler: cannot open %s\n"), m_sTraceFile.c_str());
+        return;
+    }
+
+    //tid 0 is the host and tid 1 is the device, "X" is a complete event, with ts and dur in us
+    file << _T("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    file << _T("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":0,\"args\":{\"name\":\"host\"}},\n");
+    file << _T("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":1,\"args\":{\"name\":\"device\"}}");
+    TCHAR buff[1024];
+    for (INT i = 0; i < m_lstTrace.Num(); ++i)
+    {
+        const SProfilerTrace& trace = m_lstTrace[i];
+        const TCHAR* sName = m_lstRegions[trace.m_iRegion].m_sName;
+        appSprintf(buff, 1024,
+            _T(",\n{\"name\":\"%s\",\"cat\":\"host\",\"ph\":\"X\",\"pid\":0,\"tid\":0,\"ts\":%.3f,\"dur\":%.3f}")
+            _T(",\n{\"name\":\"%s\",\"cat\":\"device\",\"ph\":\"X\",\"pid\":0,\"tid\":1,\"ts\":%.3f,\"dur\":%.3f}"),
+            sName, trace.m_fHostStart, trace.m_fHostDuration,
+            sName, trace.m_fDeviceStart, trace.m_fDeviceDuration);
+        file << buff;
+    }
+    file << _T("\n]}\n");
+    file.flush();
+    file.close();
+}
+
+void CProfiler::Release()
+{
+    for (INT i = 0; i < m_lstOpenCalls.Num(); ++i)
+    {
+        cudaEventDestroy(m_lstOpenCalls[i].m_pStart);
+        cudaEventDestroy(m_lstOpenCalls[i].m_pStop);
+    }
+    m_lstOpenCalls.RemoveAll();
+    for (INT i = 0; i < m_lstFinishedCalls.Num(); ++i)
+    {
+        cudaEventDestroy(m_lstFinishedCalls[i].m_pStart);
+        cudaEventDestroy(m_lstFinishedCalls[i].m_pStop);
+    }
+    m_lstFinishedCalls.RemoveAll();
+    for (INT i = 0; i < m_lstFreeEvents.Num(); ++i)
+    {
+        cudaEventDestroy(m_lstFreeEvents[i]);
+    }
+    m_lstFreeEvents.RemoveAll();
+    if (NULL != m_pReference)
+    {
+        cudaEventDestroy(m_pReference);
+        m_pReference = NULL;
+    }
+    m_bEnabled = FALSE;
+}
+
+void CProfiler::Report()
+{
+    if (!m_bEnabled)
+    {
+        return;
+    }
+
+    if (m_lstOpenCalls.Num() > 0)
+    {
+        appGeneral(_T("CProfiler: %d regions are not closed and ignored.\n"), m_lstOpenCalls.Num());
+    }
+    Resolve(TRUE);
+
+    appGeneral(_T("\n============================== Profile =============================\n"));
+    appGeneral(_T("%-48s %10s %14s %12s %14s %9s %10s\n"),
+        _T("Region"), _T("Count"), _T("Host(ms)"), _T("Avg(ms)"), _T("Device(ms)"), _T("Parent"), _T("GB/s"));
+    ReportRegion(-1, 0.0);
+    appGeneral(_T("====================================================================\n"));
+
+    if (!m_sTraceFile.IsEmpty())
+    {
+        WriteTrace();
+        appGeneral(_T("Profile trace written to %s (%d regions, %d dropped)\n"), m_sTraceFile.c_str(), m_lstTrace.Num(), m_uiDroppedTrace);
+    }
+
+    Release();
+}
+
+__END_NAMESPACE
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
@@ -0,0 +1,174 @@
+//=============================================================================
+// FILENAME : Profiler.h
+//
+// DESCRIPTION:
+// This is the hierarchical scoped profiler
+//
+// Use appProfile(name) at the beginning of a scope, the region is closed
+// when leaving the scope. Regions opened inside another region are children.
+// The name must be a literal or a class name (the pointer is kept).
+//
+// For each region, host time (steady clock) and device time (cuda events
+// recorded on the default stream) are recorded, with call count and bytes
+// added by appProfileBytes.
+// The device events are resolved lazily, so no synchronization is added.
+//
+// It is enabled by "Profile : 1" in the parameters, and
+// at appQuitCLG(), a summary table is printed and
+// a chrome trace (chrome://tracing or perfetto) is written to "ProfileOutput".
+//
+// Build with _CLG_PROFILE = 0 to compile all regions out.
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#ifndef _PROFILER_H_
+#define _PROFILER_H_
+
+__BEGIN_NAMESPACE
+
+struct CLGAPI SProfilerRegion
+{
+    const TCHAR* m_sName;
+    INT m_iParent;
+    INT m_iDepth;
+    UINT m_uiCount;
+    //in ms
+    DOUBLE m_fHostTime;
+    DOUBLE m_fDeviceTime;
+    ULONGLONG m_ulBytes;
+};
+
+struct CLGAPI SProfilerCall
+{
+    INT m_iRegion;
+    //in ns, since the profiler is initialed
+    ULONGLONG m_ulHostStart;
+    ULONGLONG m_ulHostEnd;
+    cudaEvent_t m_pStart;
+    cudaEvent_t m_pStop;
+};
+
+struct CLGAPI SProfilerTrace
+{
+    INT m_iRegion;
+    //in us, since the profiler is initialed
+    DOUBLE m_fHostStart;
+    DOUBLE m_fHostDuration;
+    DOUBLE m_fDeviceStart;
+    DOUBLE m_fDeviceDuration;
+};
+
+class CLGAPI CProfiler
+{
+public:
+    CProfiler()
+        : m_bEnabled(FALSE)
+        , m_uiMaxTrace(100000)
+        , m_pReference(NULL)
+        , m_uiDroppedTrace(0)
+    {
+    }
+
+    ~CProfiler()
+    {
+    }
+
+    void Initial(const CCString& sTraceFile, UINT uiMaxTrace);
+    inline UBOOL IsEnabled() const { return m_bEnabled; }
+
+    void BeginRegion(const TCHAR* sName);
+    void EndRegion();
+    void AddBytes(ULONGLONG ulBytes);
+
+    /**
+    * Resolve all events, print the summary, write the trace and disable the profiler.
+    * Must be called before the device is reset.
+    */
+    void Report();
+
+protected:
+
+    ULONGLONG GetHostTime() const;
+    cudaEvent_t GetEvent();
+    INT FindRegion(INT iParent, const TCHAR* sName);
+
+    /**
+    * Move the finished calls to statistics and trace.
+    * If bWait is FALSE, stop at the first call which is still running on device.
+    */
+    void Resolve(UBOOL bWait);
+    void ReportRegion(INT iParent, DOUBLE fParentTime) const;
+    void WriteTrace() const;
+    void Release();
+
+    UBOOL m_bEnabled;
+    UINT m_uiMaxTrace;
+    CCString m_sTraceFile;
+    std::chrono::steady_clock::time_point m_kHostStart;
+    cudaEvent_t m_pReference;
+
+    TArray<SProfilerRegion> m_lstRegions;
+    TArray<SProfilerCall> m_lstOpenCalls;
+    TArray<SProfilerCall> m_lstFinishedCalls;
+    TArray<SProfilerTrace> m_lstTrace;
+    TArray<cudaEvent_t> m_lstFreeEvents;
+    UINT m_uiDroppedTrace;
+};
+
+extern CLGAPI CProfiler GProfiler;
+
+class CLGAPI CProfilerScope
+{
+public:
+    CProfilerScope(const TCHAR* sName)
+        : m_bStarted(GProfiler.IsEnabled())
+    {
+        if (m_bStarted)
+        {
+            GProfiler.BeginRegion(sName);
+        }
+    }
+
+    ~CProfilerScope()
+    {
+        if (m_bStarted)
+        {
+            GProfiler.EndRegion();
+        }
+    }
+
+private:
+
+    UBOOL m_bStarted;
+};
+
+inline void appInitialProfiler(const CCString& sTraceFile, UINT uiMaxTrace)
+{
+    GProfiler.Initial(sTraceFile, uiMaxTrace);
+}
+
+inline void appProfilerReport()
+{
+    GProfiler.Report();
+}
+
+#define __CLG_PROFILE_NAME2(a, b) a##b
+#define __CLG_PROFILE_NAME(a, b) __CLG_PROFILE_NAME2(a, b)
+
+#if _CLG_PROFILE
+#   define appProfile(name) CProfilerScope __CLG_PROFILE_NAME(__profilerScope, __LINE__)(name)
+#   define appProfileBytes(bytes) { if (GProfiler.IsEnabled()) { GProfiler.AddBytes(static_cast<ULONGLONG>(bytes)); } }
+#else
+#   define appProfile(name)
+#   define appProfileBytes(bytes)
+#endif
+
+__END_NAMESPACE
+
+#endif //#ifndef _PROFILER_H_
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
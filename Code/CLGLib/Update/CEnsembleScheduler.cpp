@@ -0,0 +1,119 @@
+//=============================================================================
+// FILENAME : CEnsembleScheduler.cpp
+//
+// DESCRIPTION:
+// This is the class to interleave several independent Markov chains in one process
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+#include "CLGLib_Private.h"
+
+__BEGIN_NAMESPACE
+
+void CEnsembleScheduler::Initial(CParameters& params)
+{
+    INT iValue = 1;
+    params.FetchValueINT(_T("TrajectoriesPerTurn"), iValue);
+    SetTrajectoriesPerTurn(iValue > 0 ? static_cast<UINT>(iValue) : 1);
+
+    iValue = 0;
+    params.FetchValueINT(_T("ChainCount"), iValue);
+    for (INT i = 1; i <= iValue; ++i)
+    {
+        CCString sChainName;
+        sChainName.Format(_T("Chain%d"), i);
+        if (!params.Exist(sChainName))
+        {
+            appCrucial(_T("CEnsembleScheduler: %s not found!\n"), sChainName.c_str());
+            continue;
+        }
+        CParameters chain = params.GetParameter(sChainName);
+        INT iTrajectories = 0;
+        chain.FetchValueINT(_T("Trajectories"), iTrajectories);
+        INT iMeasure = 0;
+        chain.FetchValueINT(_T("Measure"), iMeasure);
+        AddChain(chain, iTrajectories > 0 ? static_cast<UINT>(iTrajectories) : 0, 0 != iMeasure);
+    }
+}
+
+INT CEnsembleScheduler::AddChain(CParameters& params, UINT uiTrajectories, UBOOL bMeasure)
+{
+    CLatticeContext* pCurrent = appGetLatticeContext();
+    CLatticeContext* pContext = appCreateLatticeContext(params);
+    if (NULL == pContext || NULL == pContext->m_pLatticeData->m_pUpdator)
+    {
+        appCrucial(_T("CEnsembleScheduler: failed to create chain %d, an updator is required!\n"), m_lstChains.Num() + 1);
+        appReleaseLatticeContext(pContext);
+        appSetLatticeContext(pCurrent);
+        return -1;
+    }
+    if (NULL != pCurrent)
+    {
+        appSetLatticeContext(pCurrent);
+    }
+
+    SEnsembleChain newChain;
+    newChain.m_pContext = pContext;
+    newChain.m_uiTrajectories = uiTrajectories;
+    newChain.m_uiFinished = 0;
+    newChain.m_bMeasure = bMeasure;
+    return m_lstChains.AddItem(newChain);
+}
+
+UBOOL CEnsembleScheduler::RunTurn()
+{
+    CLatticeContext* pCurrent = appGetLatticeContext();
+    UBOOL bRunning = FALSE;
+    for (INT i = 0; i < m_lstChains.Num(); ++i)
+    {
+        SEnsembleChain& chain = m_lstChains[i];
+        if (chain.m_uiFinished >= chain.m_uiTrajectories)
+        {
+            continue;
+        }
+
+        const UINT uiLeft = chain.m_uiTrajectories - chain.m_uiFinished;
+        const UINT uiSteps = uiLeft < m_uiTrajectoriesPerTurn ? uiLeft : m_uiTrajectoriesPerTurn;
+        appSetLatticeContext(chain.m_pContext);
+        appGetLattice()->m_pUpdator->Update(uiSteps, chain.m_bMeasure);
+        chain.m_uiFinished += uiSteps;
+        if (chain.m_uiFinished < chain.m_uiTrajectories)
+        {
+            bRunning = TRUE;
+        }
+    }
+
+    if (NULL != pCurrent)
+    {
+        appSetLatticeContext(pCurrent);
+    }
+    return bRunning;
+}
+
+void CEnsembleScheduler::Run()
+{
+    UINT uiTurn = 0;
+    while (RunTurn())
+    {
+        ++uiTurn;
+        appGeneral(_T("CEnsembleScheduler: turn %d finished\n"), uiTurn);
+    }
+    appGeneral(_T("CEnsembleScheduler: all %d chains finished\n"), m_lstChains.Num());
+}
+
+void CEnsembleScheduler::Release()
+{
+    //the contexts may be already released by appQuitCLG, release will ignore them
+    for (INT i = 0; i < m_lstChains.Num(); ++i)
+    {
+        appReleaseLatticeContext(m_lstChains[i].m_pContext);
+    }
+    m_lstChains.RemoveAll();
+}
+
+__END_NAMESPACE
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
@@ -0,0 +1,99 @@
+//=============================================================================
+// FILENAME : CEnsembleScheduler.h
+//
+// DESCRIPTION:
+// This is the class to interleave several independent Markov chains in one process
+//
+// Each chain is a CLatticeContext (with its own beta, omega, seed...),
+// the scheduler runs "TrajectoriesPerTurn" trajectories of each chain in
+// turn. It only saves the start-up of one process per point of a scan,
+// it is NOT the concurrent multi-stream execution of the chains, and a
+// small lattice leaves the device as idle as running the chains one by one.
+//
+// The chains cannot overlap on the device yet: the lattice constants,
+// random and index are in __constant__ memory, copied by
+// appSetLatticeContext when switching the chain, and preparethread, the BLAS
+// and the reductions all use the default stream. Running them concurrently
+// needs a cudaStream_t and a copy of the constants for each context, passed
+// to every kernel.
+//
+// Parameters:
+//  TrajectoriesPerTurn : 1
+//  ChainCount : 2
+//  Chain1 : a lattice parameter block as for appInitialCLG, with
+//      Trajectories : 100
+//      Measure : 0
+//  Chain2 : ...
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#ifndef _CENSEMBLESCHEDULER_H_
+#define _CENSEMBLESCHEDULER_H_
+
+__BEGIN_NAMESPACE
+
+struct CLGAPI SEnsembleChain
+{
+    class CLatticeContext* m_pContext;
+    UINT m_uiTrajectories;
+    UINT m_uiFinished;
+    UBOOL m_bMeasure;
+};
+
+class CLGAPI CEnsembleScheduler
+{
+public:
+    CEnsembleScheduler()
+        : m_uiTrajectoriesPerTurn(1)
+    {
+    }
+
+    ~CEnsembleScheduler()
+    {
+        Release();
+    }
+
+    void Initial(class CParameters& params);
+
+    /**
+    * Create the context of the chain, the current context is not changed
+    * return the index of the chain, or -1 if failed
+    */
+    INT AddChain(class CParameters& params, UINT uiTrajectories, UBOOL bMeasure);
+
+    /**
+    * Run one turn of all unfinished chains
+    * return FALSE if all chains are finished
+    */
+    UBOOL RunTurn();
+
+    /**
+    * Run until all chains are finished
+    */
+    void Run();
+
+    /**
+    * Release the contexts of all chains
+    */
+    void Release();
+
+    void SetTrajectoriesPerTurn(UINT uiTrajectories) { m_uiTrajectoriesPerTurn = uiTrajectories > 0 ? uiTrajectories : 1; }
+    INT GetChainCount() const { return m_lstChains.Num(); }
+    class CLatticeContext* GetContext(INT iChain) const { return m_lstChains[iChain].m_pContext; }
+    UINT GetFinishedTrajectories(INT iChain) const { return m_lstChains[iChain].m_uiFinished; }
+
+protected:
+
+    TArray<SEnsembleChain> m_lstChains;
+    UINT m_uiTrajectoriesPerTurn;
+};
+
+__END_NAMESPACE
+
+#endif //#ifndef _CENSEMBLESCHEDULER_H_
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
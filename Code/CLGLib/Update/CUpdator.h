@@ -17,6 +17,7 @@ __BEGIN_NAMESPACE
 
 __DEFINE_ENUM(EUpdatorType,
     EUT_HMC,
+    EUT_Heatbath,
     EUT_Max,
 
     EUT_ForceDWORD = 0x7fffffff,
@@ -62,6 +63,12 @@ public:
 
     virtual void SetAutoCorrection(UBOOL bAutoCorrection) = 0;
 
+    void ClearHDiff()
+    {
+        m_lstHDiff.RemoveAll();
+        m_lstH.RemoveAll();
+    }
+
 #if !_CLG_DOUBLEFLOAT
 
     Real GetHDiff() const
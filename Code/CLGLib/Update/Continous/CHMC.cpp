@@ -16,7 +16,9 @@ __CLGIMPLEMENT_CLASS(CHMC)
 
 CHMC::~CHMC()
 {
+    WaitCheckpointWriter();
     appSafeDelete(m_pIntegrator);
+    appSafeDelete(m_pTuner);
 }
 
 void CHMC::Initial(class CLatticeData* pOwner, const CParameters& params)
@@ -47,6 +49,25 @@ void CHMC::Initial(class CLatticeData* pOwner, const CParameters& params)
         m_sConfigurationPrefix.Format(_T("%s_%d"), m_sConfigurationPrefix.c_str(), appGetTimeStamp());
     }
 
+    INT iCheckpoint = 0;
+    params.FetchValueINT(_T("Checkpoint"), iCheckpoint);
+    m_bCheckpoint = (0 != iCheckpoint);
+    INT iCheckpointInterval = 10;
+    params.FetchValueINT(_T("CheckpointInterval"), iCheckpointInterval);
+    m_uiCheckpointInterval = iCheckpointInterval > 0 ? static_cast<UINT>(iCheckpointInterval) : 1;
+    params.FetchStringValue(_T("CheckpointFile"), m_sCheckpointFile);
+    INT iResume = 0;
+    params.FetchValueINT(_T("Resume"), iResume);
+    m_bResumePending = (0 != iResume);
+
+    INT iTune = 0;
+    params.FetchValueINT(_T("TuneIntegrator"), iTune);
+    if (0 != iTune)
+    {
+        m_pTuner = new CIntegratorTuner();
+        m_pTuner->Initial(params);
+    }
+
     if (m_bAdaptiveUpdate)
     {
         TArray<INT> minMax;
@@ -75,6 +96,24 @@ void CHMC::Initial(class CLatticeData* pOwner, const CParameters& params)
 
 UINT CHMC::Update(UINT iSteps, UBOOL bMeasure)
 {
+    if (m_bResumePending)
+    {
+        //the measurement is created after the updator, so resume here
+        m_bResumePending = FALSE;
+        if (CFileSystem::IsFileExist(m_sCheckpointFile))
+        {
+            if (!Resume(m_sCheckpointFile))
+            {
+                appCrucial(_T("HMC: failed to resume from %s\n"), m_sCheckpointFile.c_str());
+                _FAIL_EXIT;
+            }
+        }
+        else
+        {
+            appGeneral(_T("HMC: %s not found, start a new chain\n"), m_sCheckpointFile.c_str());
+        }
+    }
+
     ++m_uiUpdateCall;
     UBOOL bAccepted = FALSE;
 
@@ -88,15 +127,27 @@ UINT CHMC::Update(UINT iSteps, UBOOL bMeasure)
 
     for (UINT i = 0; i < iSteps; ++i)
     {
+        appProfile(_T("Trajectory"));
+        m_pOwner->m_pRandom->NextTrajectory();
         m_pIntegrator->Prepare(bAccepted, i);
         m_pOwner->FixAllFieldBoundary();
-        if (m_bMetropolis || m_bTestHDiff)
+        const UBOOL bTuning = (NULL != m_pTuner) && m_pTuner->IsTuning();
+        if (m_bMetropolis || m_bTestHDiff || bTuning)
         {
+            appProfile(_T("Energy"));
             fEnergy = m_pIntegrator->GetEnergy(TRUE);
         }
-        m_pIntegrator->Evaluate();
-        if (m_bMetropolis || m_bTestHDiff)
+        if (bTuning)
+        {
+            m_pTuner->MeasureBrackets(m_pIntegrator);
+        }
+        {
+            appProfile(_T("Evaluate"));
+            m_pIntegrator->Evaluate();
+        }
+        if (m_bMetropolis || m_bTestHDiff || bTuning)
         {
+            appProfile(_T("Energy"));
             fEnergyNew = m_pIntegrator->GetEnergy(FALSE);
         }
 
@@ -108,7 +159,7 @@ UINT CHMC::Update(UINT iSteps, UBOOL bMeasure)
         Real rand = F(0.0);
 #endif
 
-        if (m_bMetropolis || m_bTestHDiff)
+        if (m_bMetropolis || m_bTestHDiff || bTuning)
         {
 #if !_CLG_DOUBLEFLOAT
             DOUBLE fDiff = fEnergy - fEnergyNew;
@@ -121,7 +172,7 @@ UINT CHMC::Update(UINT iSteps, UBOOL bMeasure)
                 m_lstH.AddItem(fEnergy);
             }
 
-            if (!m_bTestHDiff)
+            if (m_bMetropolis && !m_bTestHDiff)
             {
 #if !_CLG_DOUBLEFLOAT
                 diff_H = _hostexpd(fDiff);  // Delta H (SA)
@@ -154,6 +205,11 @@ UINT CHMC::Update(UINT iSteps, UBOOL bMeasure)
                 fEnergyNew,
                 0 == byUpdateChange ? _T("") : (1 == byUpdateChange ? _T(", step++") : _T(", step--"))
                 );
+
+            if (bTuning)
+            {
+                m_pTuner->AddDeltaH(m_pIntegrator, static_cast<DOUBLE>(-fDiff));
+            }
         }
 
         if (rand <= diff_H)
@@ -182,6 +238,17 @@ UINT CHMC::Update(UINT iSteps, UBOOL bMeasure)
         {
             SaveConfiguration(i + 1);
         }
+
+        ++m_uiTrajectoryCount;
+        if (m_bCheckpoint && 0 == (m_uiTrajectoryCount % m_uiCheckpointInterval))
+        {
+            SaveCheckpoint();
+        }
+    }
+
+    if (m_bCheckpoint && m_uiCheckpointTrajectory != m_uiTrajectoryCount)
+    {
+        SaveCheckpoint();
     }
 
     checkCudaErrors(cudaGetLastError());
@@ -195,6 +262,206 @@ UINT CHMC::Update(UINT iSteps, UBOOL bMeasure)
     return m_iAcceptedConfigurationCount;
 }
 
+#pragma region Checkpoint
+
+enum { _kCheckpointMagic = 0x4B484C43, _kCheckpointVersion = 2, };
+
+static void _appendCheckpoint(TArray<BYTE>& buffer, const void* pData, UINT uiSize)
+{
+    const INT iStart = buffer.AddSize(static_cast<INT>(uiSize));
+    memcpy(buffer.GetData() + iStart, pData, uiSize);
+}
+
+static UBOOL _readCheckpoint(const BYTE* byData, UINT uiSize, UINT& uiOffset, void* pOut, UINT uiCount)
+{
+    if (uiOffset + uiCount > uiSize)
+    {
+        return FALSE;
+    }
+    memcpy(pOut, byData + uiOffset, uiCount);
+    uiOffset += uiCount;
+    return TRUE;
+}
+
+static void _writeCheckpoint(CCString sFileName, BYTE* byData, UINT uiSize)
+{
+    if (!CFileSystem::WriteAllBytesAtomic(sFileName.c_str(), byData, uiSize))
+    {
+        appCrucial(_T("HMC: failed to write checkpoint %s\n"), sFileName.c_str());
+    }
+    free(byData);
+}
+
+void CHMC::WaitCheckpointWriter()
+{
+    if (NULL != m_pCheckpointWriter)
+    {
+        m_pCheckpointWriter->join();
+        appSafeDelete(m_pCheckpointWriter);
+    }
+}
+
+/**
+* magic, version, sizeof(Real)
+* update call, accepted count, trajectory count, accepted count of measurement
+* level count, steps of levels, step length, 2 lambda
+* number of H, H diff list, H list
+* size of measurement, accumulated data of measurement (see CMeasurementManager::SaveAccumulators)
+* size of gauge, gauge
+* size of random, random
+*/
+void CHMC::SaveCheckpoint()
+{
+    checkCudaErrors(cudaDeviceSynchronize());
+    TArray<BYTE> buffer;
+    const UINT header[7] = {
+        _kCheckpointMagic, _kCheckpointVersion, static_cast<UINT>(sizeof(Real)),
+        m_uiUpdateCall, m_iAcceptedConfigurationCount, m_uiTrajectoryCount,
+        (NULL == m_pOwner->m_pMeasurements) ? 0 : m_pOwner->m_pMeasurements->GetAcceptedConfigurationCount() };
+    _appendCheckpoint(buffer, header, sizeof(UINT) * 7);
+
+    TArray<UINT> steps;
+    m_pIntegrator->GetLevelSteps(steps);
+    const UINT uiLevelCount = static_cast<UINT>(steps.Num());
+    _appendCheckpoint(buffer, &uiLevelCount, sizeof(UINT));
+    _appendCheckpoint(buffer, steps.GetData(), sizeof(UINT) * uiLevelCount);
+    const Real fStepLength = m_pIntegrator->GetStepLength();
+    const Real f2Lambda = m_pIntegrator->GetOmelyan2Lambda();
+    _appendCheckpoint(buffer, &fStepLength, sizeof(Real));
+    _appendCheckpoint(buffer, &f2Lambda, sizeof(Real));
+
+    const UINT uiHCount = static_cast<UINT>(m_lstHDiff.Num());
+    _appendCheckpoint(buffer, &uiHCount, sizeof(UINT));
+    _appendCheckpoint(buffer, m_lstHDiff.GetData(), static_cast<UINT>(sizeof(m_lstHDiff[0])) * uiHCount);
+    _appendCheckpoint(buffer, m_lstH.GetData(), static_cast<UINT>(sizeof(m_lstH[0])) * uiHCount);
+
+    TArray<BYTE> measurement;
+    if (NULL != m_pOwner->m_pMeasurements)
+    {
+        m_pOwner->m_pMeasurements->SaveAccumulators(measurement);
+    }
+    const UINT uiMeasurementSize = static_cast<UINT>(measurement.Num());
+    _appendCheckpoint(buffer, &uiMeasurementSize, sizeof(UINT));
+    _appendCheckpoint(buffer, measurement.GetData(), uiMeasurementSize);
+
+    UINT uiGaugeSize = 0;
+    BYTE* byGauge = m_pOwner->m_pGaugeField->CopyDataOut(uiGaugeSize);
+    _appendCheckpoint(buffer, &uiGaugeSize, sizeof(UINT));
+    _appendCheckpoint(buffer, byGauge, uiGaugeSize);
+    free(byGauge);
+
+    UINT uiRandomSize = 0;
+    BYTE* byRandom = m_pOwner->m_pRandom->CopyStateOut(uiRandomSize);
+    _appendCheckpoint(buffer, &uiRandomSize, sizeof(UINT));
+    _appendCheckpoint(buffer, byRandom, uiRandomSize);
+    free(byRandom);
+
+    //the writer frees the data
+    const UINT uiSize = static_cast<UINT>(buffer.Num());
+    BYTE* byToSave = (BYTE*)malloc(static_cast<size_t>(uiSize));
+    memcpy(byToSave, buffer.GetData(), uiSize);
+    WaitCheckpointWriter();
+    m_pCheckpointWriter = new std::thread(_writeCheckpoint, m_sCheckpointFile, byToSave, uiSize);
+    m_uiCheckpointTrajectory = m_uiTrajectoryCount;
+    appGeneral(_T("HMC: checkpoint of trajectory %d to %s\n"), m_uiTrajectoryCount, m_sCheckpointFile.c_str());
+}
+
+UBOOL CHMC::Resume(const CCString& sFileName)
+{
+    WaitCheckpointWriter();
+    UINT uiSize = 0;
+    BYTE* byData = appGetFileSystem()->ReadAllBytes(sFileName.c_str(), uiSize);
+    if (NULL == byData)
+    {
+        appCrucial(_T("HMC: cannot read checkpoint %s\n"), sFileName.c_str());
+        return FALSE;
+    }
+
+    UBOOL bOk = TRUE;
+    UINT uiOffset = 0;
+    UINT header[7];
+    bOk = bOk && _readCheckpoint(byData, uiSize, uiOffset, header, sizeof(UINT) * 7);
+    bOk = bOk && (_kCheckpointMagic == header[0]) && (_kCheckpointVersion == header[1]) && (sizeof(Real) == header[2]);
+
+    UINT uiLevelCount = 0;
+    TArray<UINT> steps;
+    bOk = bOk && _readCheckpoint(byData, uiSize, uiOffset, &uiLevelCount, sizeof(UINT));
+    bOk = bOk && (static_cast<INT>(uiLevelCount) == m_pIntegrator->GetLevelCount());
+    if (bOk)
+    {
+        steps.SetSize(static_cast<INT>(uiLevelCount));
+        bOk = _readCheckpoint(byData, uiSize, uiOffset, steps.GetData(), sizeof(UINT) * uiLevelCount);
+    }
+    Real fStepLength = F(0.0);
+    Real f2Lambda = F(1.0);
+    bOk = bOk && _readCheckpoint(byData, uiSize, uiOffset, &fStepLength, sizeof(Real));
+    bOk = bOk && _readCheckpoint(byData, uiSize, uiOffset, &f2Lambda, sizeof(Real));
+
+    UINT uiHCount = 0;
+    bOk = bOk && _readCheckpoint(byData, uiSize, uiOffset, &uiHCount, sizeof(UINT));
+    if (bOk)
+    {
+        m_lstHDiff.SetSize(static_cast<INT>(uiHCount));
+        m_lstH.SetSize(static_cast<INT>(uiHCount));
+        bOk = _readCheckpoint(byData, uiSize, uiOffset, m_lstHDiff.GetData(), static_cast<UINT>(sizeof(m_lstHDiff[0])) * uiHCount)
+           && _readCheckpoint(byData, uiSize, uiOffset, m_lstH.GetData(), static_cast<UINT>(sizeof(m_lstH[0])) * uiHCount);
+    }
+
+    UINT uiMeasurementSize = 0;
+    bOk = bOk && _readCheckpoint(byData, uiSize, uiOffset, &uiMeasurementSize, sizeof(UINT));
+    bOk = bOk && (uiOffset + uiMeasurementSize <= uiSize);
+    if (bOk && NULL != m_pOwner->m_pMeasurements)
+    {
+        bOk = m_pOwner->m_pMeasurements->LoadAccumulators(byData + uiOffset, uiMeasurementSize);
+    }
+    uiOffset += uiMeasurementSize;
+
+    UINT uiGaugeSize = 0;
+    bOk = bOk && _readCheckpoint(byData, uiSize, uiOffset, &uiGaugeSize, sizeof(UINT));
+    const UINT uiGaugeOffset = uiOffset;
+    bOk = bOk && (uiOffset + uiGaugeSize <= uiSize);
+    uiOffset += uiGaugeSize;
+
+    UINT uiRandomSize = 0;
+    bOk = bOk && _readCheckpoint(byData, uiSize, uiOffset, &uiRandomSize, sizeof(UINT));
+    bOk = bOk && (uiOffset + uiRandomSize == uiSize);
+    bOk = bOk && m_pOwner->m_pRandom->InitialStateWithByte(byData + uiOffset, uiRandomSize);
+
+    if (!bOk)
+    {
+        appCrucial(_T("HMC: checkpoint %s does not match this build or lattice\n"), sFileName.c_str());
+        free(byData);
+        return FALSE;
+    }
+
+    m_pOwner->m_pGaugeField->InitialWithByte(byData + uiGaugeOffset);
+    free(byData);
+
+    m_uiUpdateCall = header[3];
+    m_iAcceptedConfigurationCount = header[4];
+    m_uiTrajectoryCount = header[5];
+    m_uiCheckpointTrajectory = m_uiTrajectoryCount;
+    if (NULL != m_pOwner->m_pMeasurements)
+    {
+        m_pOwner->m_pMeasurements->SetAcceptedConfigurationCount(header[6]);
+    }
+    //SetLevelSteps keeps step length x step count, so the step length is set first,
+    //such that the trajectory length is the one in the checkpoint
+    m_pIntegrator->SetStepLength(fStepLength * steps[0] / m_pIntegrator->GetStepCount());
+    m_pIntegrator->SetLevelSteps(steps);
+    if (m_pIntegrator->HasOmelyanLambda())
+    {
+        m_pIntegrator->SetOmelyan2Lambda(f2Lambda);
+    }
+    m_pOwner->FixAllFieldBoundary();
+    checkCudaErrors(cudaDeviceSynchronize());
+
+    appGeneral(_T("HMC: resumed from %s at trajectory %d\n"), sFileName.c_str(), m_uiTrajectoryCount);
+    return TRUE;
+}
+
+#pragma endregion
+
 CCString CHMC::GetInfos(const CCString &tab) const
 {
     CCString sRet;
@@ -202,6 +469,11 @@ CCString CHMC::GetInfos(const CCString &tab) const
     sRet = sRet + tab + _T("Integrator : \n");
     sRet = sRet + m_pIntegrator->GetInfos(tab + _T("    "));
     sRet = sRet + tab + _T("Metropolis : ") + (m_bMetropolis ? _T("1\n") : _T("0\n"));
+    if (NULL != m_pTuner)
+    {
+        sRet = sRet + tab + _T("TuneIntegrator : 1\n");
+        sRet = sRet + m_pTuner->GetInfos(tab + _T("    "));
+    }
     return sRet;
 }
 
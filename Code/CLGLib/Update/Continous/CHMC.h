@@ -4,6 +4,11 @@
 // DESCRIPTION:
 // This is the class for hibrid Monte Carlo
 //
+// With "Checkpoint : 1", every "CheckpointInterval" trajectories and at the end of Update,
+// the gauge field, random states, counters, step counts and H lists are written to "CheckpointFile"
+// The file is written by a background thread, to a temp file then renamed.
+// With "Resume : 1", the chain continues from "CheckpointFile" (if exist) at the first Update.
+//
 // REVISION:
 //  [12/7/2018 nbale]
 //=============================================================================
@@ -21,7 +26,21 @@ class CLGAPI CHMC : public CUpdator
 
 public:
 
-    CHMC() : CUpdator(), m_pIntegrator(NULL), m_bMetropolis(FALSE) {  }
+    CHMC() 
+        : CUpdator()
+        , m_pIntegrator(NULL)
+        , m_bMetropolis(FALSE)
+        , m_pTuner(NULL)
+        , m_bCheckpoint(FALSE)
+        , m_uiCheckpointInterval(10)
+        , m_sCheckpointFile(_T("Checkpoint.chk"))
+        , m_bResumePending(FALSE)
+        , m_uiTrajectoryCount(0)
+        , m_uiCheckpointTrajectory(0)
+        , m_pCheckpointWriter(NULL)
+    {
+    }
+
     ~CHMC();
     UINT Update(UINT iSteps, UBOOL bMeasure) override;
     Real CalculateEnergy() override { return 0.0f; }
@@ -34,9 +53,45 @@ public:
 
     void SetAutoCorrection(UBOOL bAutoCorrection) override { m_bMetropolis = bAutoCorrection; }
 
+    void SetCheckpoint(UBOOL bCheckpoint, const CCString& sFileName)
+    {
+        m_bCheckpoint = bCheckpoint;
+        m_sCheckpointFile = sFileName;
+    }
+
+    /**
+    * Write the checkpoint in background
+    */
+    void SaveCheckpoint();
+
+    /**
+    * Restore the chain from a checkpoint, call after appInitialCLG and before Update
+    */
+    UBOOL Resume(const CCString& sFileName);
+
+    /**
+    * NULL if "TuneIntegrator : 0"
+    */
+    const class CIntegratorTuner* GetTuner() const { return m_pTuner; }
+
 protected:
 
     UBOOL m_bMetropolis;
+
+    /**
+    * Created when "TuneIntegrator : 1"
+    */
+    class CIntegratorTuner* m_pTuner;
+
+    void WaitCheckpointWriter();
+
+    UBOOL m_bCheckpoint;
+    UINT m_uiCheckpointInterval;
+    CCString m_sCheckpointFile;
+    UBOOL m_bResumePending;
+    UINT m_uiTrajectoryCount;
+    UINT m_uiCheckpointTrajectory;
+    std::thread* m_pCheckpointWriter;
 };
 
 __END_NAMESPACE
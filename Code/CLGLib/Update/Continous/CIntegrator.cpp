@@ -17,6 +17,7 @@ CIntegrator::~CIntegrator()
     appSafeDelete(m_pForceField);
     appSafeDelete(m_pMomentumField);
     appSafeDelete(m_pStapleField);
+    appSafeDelete(m_pActionForceField);
 }
 
 /**
@@ -44,6 +45,19 @@ void CIntegrator::Initial(class CHMC* pOwner, class CLatticeData* pLattice, cons
     params.FetchValueINT(_T("BindDir"), iBindDir);
     m_byBindDir = static_cast<BYTE>(iBindDir);
 
+    INT iInstrument = 0;
+    params.FetchValueINT(_T("Instrument"), iInstrument);
+    m_bInstrument = (0 != iInstrument);
+    m_sInstrumentFile = _T("");
+    params.FetchStringValue(_T("InstrumentFile"), m_sInstrumentFile);
+    m_uiTrajectory = 0;
+    m_lstActionStatistics.RemoveAll();
+    m_lstLevelStatistics.RemoveAll();
+    for (INT i = 0; i < m_lstActions.Num(); ++i)
+    {
+        m_lstActionStatistics.AddItem(SForceStatistics());
+    }
+
     m_pGaugeField = dynamic_cast<CFieldGauge*>(appCreate(pLattice->m_pGaugeField->GetClass()->GetName()));
     m_pGaugeField->m_pOwner = pLattice;
     m_pGaugeField->InitialField(EFIT_Zero);
@@ -66,6 +80,13 @@ void CIntegrator::Initial(class CHMC* pOwner, class CLatticeData* pLattice, cons
     {
         m_pStapleField = NULL;
     }
+
+    if (m_bInstrument)
+    {
+        m_pActionForceField = dynamic_cast<CFieldGauge*>(appCreate(pLattice->m_pGaugeField->GetClass()->GetName()));
+        m_pActionForceField->m_pOwner = pLattice;
+        m_pActionForceField->InitialField(EFIT_Zero);
+    }
 }
 
 void CIntegrator::Prepare(UBOOL bLastAccepted, UINT uiStep)
@@ -79,12 +100,14 @@ void CIntegrator::Prepare(UBOOL bLastAccepted, UINT uiStep)
         checkCudaErrors(cudaDeviceSynchronize());
     }
 
+    m_pLattice->m_pRandom->SetPurpose(ERP_PseudoFermion);
     for (INT i = 0; i < m_lstActions.Num(); ++i)
     {
         m_lstActions[i]->PrepareForHMC(m_pGaugeField, uiStep);
     }
 
     //generate a random momentum field to start
+    m_pLattice->m_pRandom->SetPurpose(ERP_Momentum);
     m_pMomentumField->MakeRandomGenerator();
     m_pMomentumField->SetOneDirectionZero(m_byBindDir);
     checkCudaErrors(cudaDeviceSynchronize());
@@ -92,6 +115,10 @@ void CIntegrator::Prepare(UBOOL bLastAccepted, UINT uiStep)
 
 void CIntegrator::OnFinishTrajectory(UBOOL bAccepted)
 {
+    if (m_bInstrument)
+    {
+        ReportInstrument(bAccepted);
+    }
     if (bAccepted)
     {
         m_pGaugeField->CopyTo(m_pLattice->m_pGaugeField);
@@ -105,6 +132,9 @@ void CIntegrator::OnFinishTrajectory(UBOOL bAccepted)
 
 void CIntegrator::UpdateU(Real fStep) const
 {
+    appProfile(_T("UpdateU"));
+    //exp(i e P) U reads P, U and writes U
+    appProfileBytes(3 * static_cast<ULONGLONG>(_HC_LinkCount) * GetGaugeElementSize());
     m_pMomentumField->SetOneDirectionZero(m_byBindDir);
 
     //U(k) = exp (i e P) U(k-1)
@@ -117,6 +147,9 @@ void CIntegrator::UpdateU(Real fStep) const
 
 void CIntegrator::UpdateP(Real fStep, UBOOL bCacheStaple, ESolverPhase ePhase)
 {
+    appProfile(_T("UpdateP"));
+    //P = P + e F reads P, F and writes P
+    appProfileBytes(3 * static_cast<ULONGLONG>(_HC_LinkCount) * GetGaugeElementSize());
     // recalc force
     m_pForceField->Zero();
     checkCudaErrors(cudaDeviceSynchronize());
@@ -126,15 +159,16 @@ void CIntegrator::UpdateP(Real fStep, UBOOL bCacheStaple, ESolverPhase ePhase)
     for (INT i = 0; i < m_lstActions.Num(); ++i)
     {
         //this is accumulate
-        m_lstActions[i]->CalculateForceOnGauge(m_pGaugeField, m_pForceField, (0 == i && bCacheStaple) ? m_pStapleField : NULL, ePhase);
+        CalculateActionForce(i, 0, (0 == i && bCacheStaple) ? m_pStapleField : NULL, ePhase);
         checkCudaErrors(cudaDeviceSynchronize());
     }
 
     m_pForceField->SetOneDirectionZero(m_byBindDir);
+    RecordLevelForce(0);
     
     //P = P + e F
     m_bStapleCached = CCommonData::m_bStoreStaple && bCacheStaple;
-    m_pMomentumField->Axpy(fStep, m_pForceField);
+    appFieldAssign(m_pMomentumField, appField(m_pMomentumField) + fStep * appField(m_pForceField));
     m_pMomentumField->SetOneDirectionZero(m_byBindDir);
 
     checkCudaErrors(cudaDeviceSynchronize());
@@ -146,6 +180,164 @@ void CIntegrator::FinishEvaluate() const
     m_pGaugeField->SetOneDirectionUnity(m_byBindDir);
 }
 
+UBOOL CIntegrator::CalculateActionForce(INT iAction, INT iLevel, CFieldGauge* pStaple, ESolverPhase ePhase)
+{
+    appProfile(m_lstActions[iAction]->GetClass()->GetName());
+    if (!m_bInstrument)
+    {
+        return m_lstActions[iAction]->CalculateForceOnGauge(m_pGaugeField, m_pForceField, pStaple, ePhase);
+    }
+
+    UINT uiSolveBefore = 0;
+    UINT uiIterationBefore = 0;
+    FLOAT fSolveTimeBefore = 0.0f;
+    GetSolverStatistics(uiSolveBefore, uiIterationBefore, fSolveTimeBefore);
+
+    m_pActionForceField->Zero();
+    checkCudaErrors(cudaDeviceSynchronize());
+    CTimer timer;
+    timer.Start();
+    const UBOOL bRet = m_lstActions[iAction]->CalculateForceOnGauge(m_pGaugeField, m_pActionForceField, pStaple, ePhase);
+    checkCudaErrors(cudaDeviceSynchronize());
+    timer.Stop();
+
+    UINT uiSolve = 0;
+    UINT uiIteration = 0;
+    FLOAT fSolveTime = 0.0f;
+    GetSolverStatistics(uiSolve, uiIteration, fSolveTime);
+    uiSolve = uiSolve - uiSolveBefore;
+    uiIteration = uiIteration - uiIterationBefore;
+    fSolveTime = fSolveTime - fSolveTimeBefore;
+    const FLOAT fKernelTime = timer.Elapsed() > fSolveTime ? (timer.Elapsed() - fSolveTime) : 0.0f;
+
+    const DOUBLE fForce = sqrt(m_pActionForceField->Dot(m_pActionForceField).x / _HC_LinkCount);
+    appFieldAssign(m_pForceField, appField(m_pForceField) + appField(m_pActionForceField));
+
+    m_lstActionStatistics[iAction].AddForce(fForce);
+    m_lstActionStatistics[iAction].AddCost(uiSolve, uiIteration, fSolveTime, fKernelTime);
+    while (m_lstLevelStatistics.Num() <= iLevel)
+    {
+        m_lstLevelStatistics.AddItem(SForceStatistics());
+    }
+    m_lstLevelStatistics[iLevel].AddCost(uiSolve, uiIteration, fSolveTime, fKernelTime);
+    return bRet;
+}
+
+UINT CIntegrator::GetGaugeElementSize() const
+{
+    switch (m_pGaugeField->GetFieldType())
+    {
+    case EFT_GaugeU1:
+        return sizeof(CLGComplex);
+    case EFT_GaugeReal:
+    case EFT_GaugeU1Angle:
+        return sizeof(Real);
+    default:
+        return sizeof(deviceSU3);
+    }
+}
+
+void CIntegrator::RecordLevelForce(INT iLevel)
+{
+    if (!m_bInstrument)
+    {
+        return;
+    }
+
+    while (m_lstLevelStatistics.Num() <= iLevel)
+    {
+        m_lstLevelStatistics.AddItem(SForceStatistics());
+    }
+    m_lstLevelStatistics[iLevel].AddForce(sqrt(m_pForceField->Dot(m_pForceField).x / _HC_LinkCount));
+}
+
+void CIntegrator::GetSolverStatistics(UINT& uiSolve, UINT& uiIteration, FLOAT& fSolveTime) const
+{
+    uiSolve = 0;
+    uiIteration = 0;
+    fSolveTime = 0.0f;
+    for (UINT i = 0; i < kMaxFieldCount; ++i)
+    {
+        if (NULL != m_pLattice->m_pFermionSolver[i])
+        {
+            uiSolve += m_pLattice->m_pFermionSolver[i]->GetSolveCount();
+            uiIteration += m_pLattice->m_pFermionSolver[i]->GetIterationCount();
+            fSolveTime += m_pLattice->m_pFermionSolver[i]->GetSolveTime();
+        }
+        if (NULL != m_pLattice->m_pFermionMultiShiftSolver[i])
+        {
+            uiSolve += m_pLattice->m_pFermionMultiShiftSolver[i]->GetSolveCount();
+            uiIteration += m_pLattice->m_pFermionMultiShiftSolver[i]->GetIterationCount();
+            fSolveTime += m_pLattice->m_pFermionMultiShiftSolver[i]->GetSolveTime();
+        }
+    }
+}
+
+/**
+* One trajectory is one block of yaml, appended to InstrumentFile
+*/
+void CIntegrator::ReportInstrument(UBOOL bAccepted)
+{
+    ++m_uiTrajectory;
+    CCString sRet;
+    sRet.Format(_T("Trajectory%d:\n    Accepted : %d\n"), m_uiTrajectory, bAccepted ? 1 : 0);
+    for (INT i = 0; i < m_lstActionStatistics.Num(); ++i)
+    {
+        sRet = sRet + _T("    Action") + appIntToString(static_cast<INT>(m_lstActions[i]->GetActionId()))
+             + _T(" : ") + m_lstActionStatistics[i].GetInfos() + _T("\n");
+        m_lstActionStatistics[i].Reset();
+    }
+    for (INT i = 0; i < m_lstLevelStatistics.Num(); ++i)
+    {
+        sRet = sRet + _T("    Level") + appIntToString(i) + _T(" : ") + m_lstLevelStatistics[i].GetInfos() + _T("\n");
+        m_lstLevelStatistics[i].Reset();
+    }
+
+    appGeneral(_T("%s"), sRet.c_str());
+    if (!m_sInstrumentFile.IsEmpty())
+    {
+        CFileSystem::AppendAllText(m_sInstrumentFile.c_str(), sRet);
+    }
+}
+
+void CIntegrator::CalculateLevelForce(INT )
+{
+    m_pForceField->Zero();
+    checkCudaErrors(cudaDeviceSynchronize());
+
+    m_pGaugeField->SetOneDirectionUnity(m_byBindDir);
+
+    for (INT i = 0; i < m_lstActions.Num(); ++i)
+    {
+        //this is accumulate
+        m_lstActions[i]->CalculateForceOnGauge(m_pGaugeField, m_pForceField, NULL, ESP_Once);
+        checkCudaErrors(cudaDeviceSynchronize());
+    }
+
+    m_pForceField->SetOneDirectionZero(m_byBindDir);
+}
+
+void CIntegrator::GetLevelSteps(TArray<UINT>& steps) const
+{
+    steps.RemoveAll();
+    steps.AddItem(m_uiStepCount);
+}
+
+/**
+* The trajectory length is unchanged
+*/
+void CIntegrator::SetLevelSteps(const TArray<UINT>& steps)
+{
+    const Real fTau = m_fEStep * m_uiStepCount;
+    m_uiStepCount = steps[0];
+    m_fEStep = fTau / m_uiStepCount;
+}
+
+CCString CIntegrator::GetLevelStepInfo(const CCString& sTab) const
+{
+    return sTab + _T("IntegratorStep : ") + appIntToString(static_cast<INT>(m_uiStepCount)) + _T("\n");
+}
+
 #if !_CLG_DOUBLEFLOAT
 DOUBLE CIntegrator::GetEnergy(UBOOL bBeforeEvolution) const
 #else
@@ -221,12 +413,13 @@ void CNestedIntegrator::UpdatePF(Real fStep, ESolverPhase ePhase)
     for (INT i = 1; i < m_lstActions.Num(); ++i)
     {
         //this is accumulate
-        m_lstActions[i]->CalculateForceOnGauge(m_pGaugeField, m_pForceField, NULL, ePhase);
+        CalculateActionForce(i, 0, NULL, ePhase);
         checkCudaErrors(cudaDeviceSynchronize());
     }
+    RecordLevelForce(0);
 
     //P = P + e F
-    m_pMomentumField->Axpy(fStep, m_pForceField);
+    appFieldAssign(m_pMomentumField, appField(m_pMomentumField) + fStep * appField(m_pForceField));
     checkCudaErrors(cudaDeviceSynchronize());
 
     if (m_bDebugForce)
@@ -246,12 +439,13 @@ void CNestedIntegrator::UpdatePG(Real fStep, UBOOL bCacheStaple)
     m_pForceField->Zero();
     checkCudaErrors(cudaDeviceSynchronize());
 
-    m_lstActions[0]->CalculateForceOnGauge(m_pGaugeField, m_pForceField, bCacheStaple ? m_pStapleField : NULL, ESP_Once);
+    CalculateActionForce(0, 1, bCacheStaple ? m_pStapleField : NULL, ESP_Once);
     checkCudaErrors(cudaDeviceSynchronize());
+    RecordLevelForce(1);
 
     //P = P + e F
     m_bStapleCached = CCommonData::m_bStoreStaple && bCacheStaple;
-    m_pMomentumField->Axpy(fStep, m_pForceField);
+    appFieldAssign(m_pMomentumField, appField(m_pMomentumField) + fStep * appField(m_pForceField));
     checkCudaErrors(cudaDeviceSynchronize());
 
     if (m_bDebugForce)
@@ -288,6 +482,49 @@ void CNestedIntegrator::NestedEvaluateLeapfrog(UBOOL bLast)
     }
 }
 
+void CNestedIntegrator::CalculateLevelForce(INT iLevel)
+{
+    m_pForceField->Zero();
+    checkCudaErrors(cudaDeviceSynchronize());
+
+    if (0 == iLevel)
+    {
+        for (INT i = 1; i < m_lstActions.Num(); ++i)
+        {
+            //this is accumulate
+            m_lstActions[i]->CalculateForceOnGauge(m_pGaugeField, m_pForceField, NULL, ESP_Once);
+            checkCudaErrors(cudaDeviceSynchronize());
+        }
+        return;
+    }
+
+    m_lstActions[0]->CalculateForceOnGauge(m_pGaugeField, m_pForceField, NULL, ESP_Once);
+    checkCudaErrors(cudaDeviceSynchronize());
+}
+
+void CNestedIntegrator::GetLevelSteps(TArray<UINT>& steps) const
+{
+    CIntegrator::GetLevelSteps(steps);
+    steps.AddItem(m_uiNestedStep);
+}
+
+/**
+* Some integrators use half nested step length, keep the ratio
+*/
+void CNestedIntegrator::SetLevelSteps(const TArray<UINT>& steps)
+{
+    const Real fNestedRatio = m_fNestedStepLength * m_uiNestedStep / m_fEStep;
+    CIntegrator::SetLevelSteps(steps);
+    m_uiNestedStep = steps[1];
+    m_fNestedStepLength = fNestedRatio * m_fEStep / m_uiNestedStep;
+}
+
+CCString CNestedIntegrator::GetLevelStepInfo(const CCString& sTab) const
+{
+    return CIntegrator::GetLevelStepInfo(sTab)
+         + sTab + _T("NestedStep : ") + appIntToString(static_cast<INT>(m_uiNestedStep)) + _T("\n");
+}
+
 void CMultiLevelNestedIntegrator::Initial(class CHMC* pOwner, class CLatticeData* pLattice, const CParameters& params)
 {
     CIntegrator::Initial(pOwner, pLattice, params);
@@ -383,8 +620,49 @@ CCString CMultiLevelNestedIntegrator::GetNestedInfo(const CCString& sTab) const
     return sRet;
 }
 
-void CMultiLevelNestedIntegrator::UpdateP(Real fStep, TArray<UINT> actionList, ESolverPhase ePhase, UBOOL bCacheStaple, UBOOL bUpdateP)
+void CMultiLevelNestedIntegrator::GetLevelSteps(TArray<UINT>& steps) const
+{
+    CIntegrator::GetLevelSteps(steps);
+    for (INT i = 0; i < m_uiNestedStep.Num(); ++i)
+    {
+        steps.AddItem(m_uiNestedStep[i]);
+    }
+}
+
+void CMultiLevelNestedIntegrator::SetLevelSteps(const TArray<UINT>& steps)
+{
+    m_uiStepCount = steps[0];
+    m_fEStep = m_fTotalStepLength / m_uiStepCount;
+    m_fNestedStepLengths.RemoveAll();
+    m_fNestedStepLengths.AddItem(m_fEStep);
+    Real fStep = m_fEStep;
+    for (INT i = 0; i < m_uiNestedStep.Num(); ++i)
+    {
+        m_uiNestedStep[i] = steps[i + 1];
+        fStep = fStep / m_uiNestedStep[i];
+        m_fNestedStepLengths.AddItem(fStep);
+    }
+}
+
+CCString CMultiLevelNestedIntegrator::GetLevelStepInfo(const CCString& sTab) const
+{
+    CCString sSteps = _T("[");
+    for (INT i = 0; i < m_uiNestedStep.Num(); ++i)
+    {
+        sSteps = sSteps + appIntToString(static_cast<INT>(m_uiNestedStep[i]));
+        if (i != m_uiNestedStep.Num() - 1)
+        {
+            sSteps = sSteps + _T(", ");
+        }
+    }
+    sSteps = sSteps + _T("]");
+    return CIntegrator::GetLevelStepInfo(sTab)
+         + sTab + _T("NestedSteps : ") + sSteps + _T("\n");
+}
+
+void CMultiLevelNestedIntegrator::UpdateP(Real fStep, TArray<UINT> actionList, INT iLevel, ESolverPhase ePhase, UBOOL bCacheStaple, UBOOL bUpdateP)
 {
+    appProfile(_T("UpdateP"));
     m_pForceField->Zero();
     checkCudaErrors(cudaDeviceSynchronize());
 
@@ -394,21 +672,23 @@ void CMultiLevelNestedIntegrator::UpdateP(Real fStep, TArray<UINT> actionList, E
         const CAction* pAction = m_lstActions[actionList[i]];
         if (pAction->IsFermion())
         {
-            pAction->CalculateForceOnGauge(m_pGaugeField, m_pForceField, NULL, ePhase);
+            CalculateActionForce(static_cast<INT>(actionList[i]), iLevel, NULL, ePhase);
         }
         else
         {
-            pAction->CalculateForceOnGauge(m_pGaugeField, m_pForceField, bCacheStaple ? m_pStapleField : NULL, ESP_Once);
+            CalculateActionForce(static_cast<INT>(actionList[i]), iLevel, bCacheStaple ? m_pStapleField : NULL, ESP_Once);
             m_bStapleCached = CCommonData::m_bStoreStaple && bCacheStaple;
         }
         
         checkCudaErrors(cudaDeviceSynchronize());
     }
+    RecordLevelForce(iLevel);
 
     //P = P + e F
     if (bUpdateP)
     {
-        m_pMomentumField->Axpy(fStep, m_pForceField);
+        appProfileBytes(3 * static_cast<ULONGLONG>(_HC_LinkCount) * GetGaugeElementSize());
+        appFieldAssign(m_pMomentumField, appField(m_pMomentumField) + fStep * appField(m_pForceField));
     }
     checkCudaErrors(cudaDeviceSynchronize());
 }
@@ -21,6 +21,73 @@ __DEFINE_ENUM(EIntegratorType,
     EIT_ForceDWORD = 0x7fffffff,
     )
 
+/**
+* Force statistics of one action or one level in one trajectory, used when "Instrument : 1"
+* Force is |F| per link, time is in ms
+* KernelTime is the time of the force calculation excluding the solver
+*/
+struct CLGAPI SForceStatistics
+{
+    SForceStatistics()
+        : m_uiForceCount(0)
+        , m_fMaxForce(0.0)
+        , m_fSumForce(0.0)
+        , m_uiSolveCount(0)
+        , m_uiIterationCount(0)
+        , m_fSolveTime(0.0f)
+        , m_fKernelTime(0.0f)
+    {
+    }
+
+    void Reset()
+    {
+        m_uiForceCount = 0;
+        m_fMaxForce = 0.0;
+        m_fSumForce = 0.0;
+        m_uiSolveCount = 0;
+        m_uiIterationCount = 0;
+        m_fSolveTime = 0.0f;
+        m_fKernelTime = 0.0f;
+    }
+
+    void AddForce(DOUBLE fForce)
+    {
+        ++m_uiForceCount;
+        m_fMaxForce = fForce > m_fMaxForce ? fForce : m_fMaxForce;
+        m_fSumForce += fForce;
+    }
+
+    void AddCost(UINT uiSolve, UINT uiIteration, FLOAT fSolveTime, FLOAT fKernelTime)
+    {
+        m_uiSolveCount += uiSolve;
+        m_uiIterationCount += uiIteration;
+        m_fSolveTime += fSolveTime;
+        m_fKernelTime += fKernelTime;
+    }
+
+    CCString GetInfos() const
+    {
+        CCString sRet;
+        sRet.Format(_T("{Force : %d, MaxForce : %f, MeanForce : %f, Solve : %d, Iteration : %d, SolverTime : %f, KernelTime : %f}"),
+            m_uiForceCount,
+            m_fMaxForce,
+            0 == m_uiForceCount ? 0.0 : (m_fSumForce / m_uiForceCount),
+            m_uiSolveCount,
+            m_uiIterationCount,
+            m_fSolveTime,
+            m_fKernelTime);
+        return sRet;
+    }
+
+    UINT m_uiForceCount;
+    DOUBLE m_fMaxForce;
+    DOUBLE m_fSumForce;
+    UINT m_uiSolveCount;
+    UINT m_uiIterationCount;
+    FLOAT m_fSolveTime;
+    FLOAT m_fKernelTime;
+};
+
 class CLGAPI CIntegrator : public CBase
 {
 public:
@@ -31,6 +98,9 @@ public:
         , m_bDebugForce(FALSE)
         , m_bStapleCached(FALSE)
         , m_fUpdateResultEnery(F(0.0))
+        , m_bInstrument(FALSE)
+        , m_uiTrajectory(0)
+        , m_pActionForceField(NULL)
         , m_pOwner(NULL)
         , m_pLattice(NULL)
         , m_pGaugeField(NULL)
@@ -70,6 +140,37 @@ public:
     }
     UINT GetStepCount() const { return m_uiStepCount; }
 
+    /**
+    * Used by checkpoint, the step length changed by ChangeStepCount is not exactly tau / step count
+    */
+    Real GetStepLength() const { return m_fEStep; }
+    void SetStepLength(Real fEStep) { m_fEStep = fEStep; }
+
+    /**
+    * Used by CIntegratorTuner, level 0 is the outer most level
+    * CalculateLevelForce calculate the force of actions on that level into m_pForceField, the momentum is not changed
+    * GetLevelStepLength is the step length of one integrator step on that level
+    * GetLevelStepInfo is the parameters of step counts in the form of yaml
+    */
+    virtual INT GetLevelCount() const { return 1; }
+    virtual void CalculateLevelForce(INT iLevel);
+    virtual void GetLevelSteps(TArray<UINT>& steps) const;
+    virtual void SetLevelSteps(const TArray<UINT>& steps);
+    virtual Real GetLevelStepLength(INT iLevel) const { return m_fEStep; }
+    virtual CCString GetLevelStepInfo(const CCString& sTab) const;
+
+    /**
+    * The error of H is O(epsilon^{order}), it is 2 for leap-frog and Omelyan, 4 for force gradient
+    */
+    virtual UINT GetErrorOrder() const { return 2; }
+
+    /**
+    * Leap-frog is same as Omelyan with 2 lambda = 1
+    */
+    virtual UBOOL HasOmelyanLambda() const { return FALSE; }
+    virtual Real GetOmelyan2Lambda() const { return F(1.0); }
+    virtual void SetOmelyan2Lambda(Real f2Lambda) { }
+
 protected:
 
     BYTE m_byBindDir;
@@ -80,6 +181,28 @@ protected:
 
     Real m_fUpdateResultEnery;
 
+    /**
+    * Force of one action is accumulated into m_pForceField
+    * When instrumented, the force and cost are recorded for the action and the level
+    * The force of the level is recorded by RecordLevelForce after all actions of the level
+    */
+    UBOOL CalculateActionForce(INT iAction, INT iLevel, CFieldGauge* pStaple, ESolverPhase ePhase);
+    void RecordLevelForce(INT iLevel);
+    void ReportInstrument(UBOOL bAccepted);
+    void GetSolverStatistics(UINT& uiSolve, UINT& uiIteration, FLOAT& fSolveTime) const;
+
+    /**
+    * Size of one link, for the bytes recorded by the profiler
+    */
+    UINT GetGaugeElementSize() const;
+
+    UBOOL m_bInstrument;
+    CCString m_sInstrumentFile;
+    UINT m_uiTrajectory;
+    CFieldGauge* m_pActionForceField;
+    TArray<SForceStatistics> m_lstActionStatistics;
+    TArray<SForceStatistics> m_lstLevelStatistics;
+
     class CHMC* m_pOwner;
     CLatticeData* m_pLattice;
     TArray<class CAction*> m_lstActions;
@@ -119,6 +242,13 @@ public:
         m_fNestedStepLength = m_fEStep / m_uiNestedStep;
     }
 
+    INT GetLevelCount() const override { return 2; }
+    void CalculateLevelForce(INT iLevel) override;
+    void GetLevelSteps(TArray<UINT>& steps) const override;
+    void SetLevelSteps(const TArray<UINT>& steps) override;
+    Real GetLevelStepLength(INT iLevel) const override { return (0 == iLevel) ? m_fEStep : m_fNestedStepLength; }
+    CCString GetLevelStepInfo(const CCString& sTab) const override;
+
 protected:
 
     void NestedEvaluateLeapfrog(UBOOL bLast);
@@ -154,14 +284,40 @@ public:
         }
     }
 
+    INT GetLevelCount() const override { return m_uiNestedStep.Num() + 1; }
+    void CalculateLevelForce(INT iLevel) override
+    {
+        UpdateP(F(0.0), iLevel, ESP_Once, FALSE, FALSE);
+    }
+    void GetLevelSteps(TArray<UINT>& steps) const override;
+    void SetLevelSteps(const TArray<UINT>& steps) override;
+
+    /**
+    * The inner level is called twice with half step length, except for the inner leap-frog
+    */
+    Real GetLevelStepLength(INT iLevel) const override
+    {
+        Real fStep = m_fEStep;
+        for (INT i = 0; i < iLevel; ++i)
+        {
+            fStep = fStep / m_uiNestedStep[i];
+            if (0 == i || !m_bInnerLeapFrog)
+            {
+                fStep = F(0.5) * fStep;
+            }
+        }
+        return fStep;
+    }
+    CCString GetLevelStepInfo(const CCString& sTab) const override;
+
     /**
      * In force gradiant, sometimes we only cauclate pForce, but not update Momentum
      * So there is a 'bUpdateP'
      */
-    void UpdateP(Real fStep, TArray<UINT> actionList, ESolverPhase ePhase, UBOOL bCacheStaple, UBOOL bUpdateP);
+    void UpdateP(Real fStep, TArray<UINT> actionList, INT iLevel, ESolverPhase ePhase, UBOOL bCacheStaple, UBOOL bUpdateP);
     void UpdateP(Real fStep, INT iLevel, ESolverPhase ePhase, UBOOL bCacheStaple, UBOOL bUpdateP)
     {
-        UpdateP(fStep, m_iNestedActionId[iLevel], ePhase, bCacheStaple, bUpdateP);
+        UpdateP(fStep, m_iNestedActionId[iLevel], iLevel, ePhase, bCacheStaple, bUpdateP);
     }
 
 protected:
@@ -46,9 +46,10 @@ void CIntegratorForceGradient::Evaluate()
         for (INT i = 0; i < m_lstActions.Num(); ++i)
         {
             //this is accumulate
-            m_lstActions[i]->CalculateForceOnGauge(m_pGaugeField, m_pForceField, NULL, ESP_InTrajectory);
+            CalculateActionForce(i, 0, NULL, ESP_InTrajectory);
             checkCudaErrors(cudaDeviceSynchronize());
         }
+        RecordLevelForce(0);
 
         m_pGaugeField->CopyTo(m_pUPrime);
         m_pForceField->ExpMult(f1Over24EstepSq, m_pGaugeField);
@@ -28,6 +28,7 @@ public:
 
     void Evaluate() override;
     CCString GetInfos(const CCString& sTab) const override;
+    UINT GetErrorOrder() const override { return 4; }
 
 protected:
 
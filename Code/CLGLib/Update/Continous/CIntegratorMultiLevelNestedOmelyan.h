@@ -33,6 +33,10 @@ public:
     void Evaluate() override;
     CCString GetInfos(const CCString& sTab) const override;
 
+    UBOOL HasOmelyanLambda() const override { return TRUE; }
+    Real GetOmelyan2Lambda() const override { return m_f2Lambda; }
+    void SetOmelyan2Lambda(Real f2Lambda) override { m_f2Lambda = f2Lambda; }
+
 protected:
 
     void NestedEvaluate(INT iLevel, Real fNestedStepLength, UBOOL bFirst, UBOOL bLast);
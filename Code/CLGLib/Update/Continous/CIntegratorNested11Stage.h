@@ -53,6 +53,7 @@ public:
     }
 
     CCString GetInfos(const CCString& sTab) const override;
+    UINT GetErrorOrder() const override { return 4; }
 
 protected:
 
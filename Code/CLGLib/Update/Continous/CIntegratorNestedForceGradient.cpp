@@ -59,9 +59,10 @@ void CIntegratorNestedForceGradient::Evaluate()
         for (INT i = 1; i < m_lstActions.Num(); ++i)
         {
             //this is accumulate
-            m_lstActions[i]->CalculateForceOnGauge(m_pGaugeField, m_pForceField, NULL, ESP_InTrajectory);
+            CalculateActionForce(i, 0, NULL, ESP_InTrajectory);
             checkCudaErrors(cudaDeviceSynchronize());
         }
+        RecordLevelForce(0);
 
         m_pGaugeField->CopyTo(m_pUPrime);
         m_pForceField->ExpMult(f1Over24EstepSq, m_pGaugeField);
@@ -123,7 +124,8 @@ void CIntegratorNestedForceGradient::NestedEvaluate(UBOOL bLast)
         // middle step
         m_pForceField->Zero();
         checkCudaErrors(cudaDeviceSynchronize());
-        m_lstActions[0]->CalculateForceOnGauge(m_pGaugeField, m_pForceField, NULL, ESP_Once);
+        CalculateActionForce(0, 1, NULL, ESP_Once);
+        RecordLevelForce(1);
 
         m_pGaugeField->CopyTo(m_pUPrime);
         m_pForceField->ExpMult(f1Over24EstepSq, m_pGaugeField);
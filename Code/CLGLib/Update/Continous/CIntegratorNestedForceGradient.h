@@ -31,6 +31,7 @@ public:
     void NestedEvaluate(UBOOL bLast);
 
     CCString GetInfos(const CCString& sTab) const override;
+    UINT GetErrorOrder() const override { return 4; }
 
     void ChangeStepCount(UBOOL bGrow) override
     {
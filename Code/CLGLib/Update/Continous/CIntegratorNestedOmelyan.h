@@ -31,6 +31,10 @@ public:
 
     CCString GetInfos(const CCString& sTab) const override;
 
+    UBOOL HasOmelyanLambda() const override { return TRUE; }
+    Real GetOmelyan2Lambda() const override { return m_f2Lambda; }
+    void SetOmelyan2Lambda(Real f2Lambda) override { m_f2Lambda = f2Lambda; }
+
     void ChangeStepCount(UBOOL bGrow) override
     {
         CNestedIntegrator::ChangeStepCount(bGrow);
@@ -56,6 +56,10 @@ public:
 
     CCString GetInfos(const CCString& sTab) const override;
 
+    UBOOL HasOmelyanLambda() const override { return TRUE; }
+    Real GetOmelyan2Lambda() const override { return m_f2Lambda; }
+    void SetOmelyan2Lambda(Real f2Lambda) override { m_f2Lambda = f2Lambda; }
+
 protected:
 
     Real m_f2Lambda;
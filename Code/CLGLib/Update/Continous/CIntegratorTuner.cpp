@@ -0,0 +1,326 @@
+//=============================================================================
+// FILENAME : CIntegratorTuner.cpp
+//
+// DESCRIPTION:
+// This is the auto-tuner of integrator parameters, used by CHMC
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+#include "CLGLib_Private.h"
+
+__BEGIN_NAMESPACE
+
+CIntegratorTuner::~CIntegratorTuner()
+{
+    appSafeDelete(m_pGaugeBackup);
+}
+
+void CIntegratorTuner::Initial(const CParameters& params)
+{
+    INT iValue = 10;
+    params.FetchValueINT(_T("TuneTrajectory"), iValue);
+    m_uiTrajectoryPerRound = iValue > 1 ? static_cast<UINT>(iValue) : 2;
+
+    iValue = 3;
+    params.FetchValueINT(_T("TuneRound"), iValue);
+    m_uiMaxRound = iValue > 0 ? static_cast<UINT>(iValue) : 1;
+
+    iValue = 100;
+    params.FetchValueINT(_T("TuneMaxStep"), iValue);
+    m_uiMaxStep = iValue > 0 ? static_cast<UINT>(iValue) : 1;
+
+    iValue = 10;
+    params.FetchValueINT(_T("TuneMaxNestedStep"), iValue);
+    m_uiMaxNestedStep = iValue > 0 ? static_cast<UINT>(iValue) : 1;
+
+    m_fTargetAcceptance = F(0.8);
+    params.FetchValueReal(_T("TuneTargetAcceptance"), m_fTargetAcceptance);
+    if (m_fTargetAcceptance <= F(0.0) || m_fTargetAcceptance >= F(1.0))
+    {
+        appCrucial(_T("TuneTargetAcceptance must in (0, 1), but set to be %f!\n"), m_fTargetAcceptance);
+        m_fTargetAcceptance = F(0.8);
+    }
+
+    m_fBracketStep = F(0.01);
+    params.FetchValueReal(_T("TuneBracketStep"), m_fBracketStep);
+
+    m_sOutputFile = _T("");
+    params.FetchStringValue(_T("TuneOutput"), m_sOutputFile);
+
+    m_uiRound = 0;
+    Reset(0);
+}
+
+void CIntegratorTuner::Reset(INT iLevelCount)
+{
+    m_uiTrajectory = 0;
+    m_uiBracketCount = 0;
+    m_fDeltaHSq = 0.0;
+    m_lstA2.RemoveAll();
+    m_lstAB.RemoveAll();
+    m_lstB2.RemoveAll();
+    m_lstForceTime.RemoveAll();
+    for (INT i = 0; i < iLevelCount; ++i)
+    {
+        m_lstA2.AddItem(0.0);
+        m_lstAB.AddItem(0.0);
+        m_lstB2.AddItem(0.0);
+        m_lstForceTime.AddItem(0.0);
+    }
+}
+
+void CIntegratorTuner::MeasureBrackets(CIntegrator* pIntegrator)
+{
+    const INT iLevelCount = pIntegrator->GetLevelCount();
+    if (m_lstA2.Num() != iLevelCount)
+    {
+        Reset(iLevelCount);
+    }
+
+    if (NULL == m_pGaugeBackup)
+    {
+        m_pGaugeBackup = dynamic_cast<CFieldGauge*>(pIntegrator->m_pGaugeField->GetCopy());
+    }
+    pIntegrator->m_pGaugeField->CopyTo(m_pGaugeBackup);
+
+    for (INT i = 0; i < iLevelCount; ++i)
+    {
+        CTimer timer;
+        timer.Start();
+        pIntegrator->CalculateLevelForce(i);
+        timer.Stop();
+        const DOUBLE fA = pIntegrator->m_pForceField->Dot(pIntegrator->m_pForceField).x;
+        const DOUBLE fPF0 = pIntegrator->m_pMomentumField->Dot(pIntegrator->m_pForceField).x;
+
+        //U = exp(i h P) U
+        pIntegrator->m_pMomentumField->ExpMult(m_fBracketStep, pIntegrator->m_pGaugeField);
+        checkCudaErrors(cudaDeviceSynchronize());
+        timer.Start();
+        pIntegrator->CalculateLevelForce(i);
+        timer.Stop();
+        const DOUBLE fPF1 = pIntegrator->m_pMomentumField->Dot(pIntegrator->m_pForceField).x;
+        m_pGaugeBackup->CopyTo(pIntegrator->m_pGaugeField);
+        checkCudaErrors(cudaDeviceSynchronize());
+
+        //F = - dS/dU, so P.F(h) - P.F(0) = - h {T,{S,T}}
+        const DOUBLE fB = (fPF0 - fPF1) / m_fBracketStep;
+        m_lstA2[i] += fA * fA;
+        m_lstAB[i] += fA * fB;
+        m_lstB2[i] += fB * fB;
+        m_lstForceTime[i] += F(0.5) * timer.Elapsed();
+
+        appDetailed(_T(" Tuner: level %d, {S,{S,T}} = %f, {T,{S,T}} = %f\n"), i, fA, fB);
+    }
+    ++m_uiBracketCount;
+}
+
+void CIntegratorTuner::AddDeltaH(CIntegrator* pIntegrator, DOUBLE fDeltaH)
+{
+    m_fDeltaHSq += fDeltaH * fDeltaH;
+    ++m_uiTrajectory;
+    if (m_uiTrajectory >= m_uiTrajectoryPerRound)
+    {
+        Tune(pIntegrator);
+        ++m_uiRound;
+        Reset(pIntegrator->GetLevelCount());
+    }
+}
+
+DOUBLE CIntegratorTuner::ShadowError(UINT uiOrder, DOUBLE f2Lambda, const TArray<DOUBLE>& epsilons) const
+{
+    const DOUBLE fLambda = 0.5 * f2Lambda;
+    const DOUBLE fAlpha = (6.0 * fLambda * fLambda - 6.0 * fLambda + 1.0) / 12.0;
+    const DOUBLE fBeta = (1.0 - 6.0 * fLambda) / 24.0;
+    DOUBLE fRet = 0.0;
+    for (INT i = 0; i < epsilons.Num(); ++i)
+    {
+        //for 4-th order, the brackets are not known, |F|^2 is used as an estimation
+        const DOUBLE fBracketSq = (uiOrder > 2)
+            ? m_lstA2[i]
+            : (fAlpha * fAlpha * m_lstA2[i] + 2.0 * fAlpha * fBeta * m_lstAB[i] + fBeta * fBeta * m_lstB2[i]);
+        DOUBLE fEpsilon = 1.0;
+        for (UINT j = 0; j < 2 * uiOrder; ++j)
+        {
+            fEpsilon = fEpsilon * epsilons[i];
+        }
+        fRet += fEpsilon * fBracketSq;
+    }
+    return fRet / m_uiBracketCount;
+}
+
+void CIntegratorTuner::Tune(CIntegrator* pIntegrator)
+{
+    const INT iLevelCount = pIntegrator->GetLevelCount();
+    if (0 == m_uiBracketCount || m_lstA2.Num() != iLevelCount)
+    {
+        appGeneral(_T(" Tuner: no bracket measured, skip tuning.\n"));
+        return;
+    }
+
+    const UINT uiOrder = pIntegrator->GetErrorOrder();
+    TArray<UINT> oldSteps;
+    pIntegrator->GetLevelSteps(oldSteps);
+    TArray<DOUBLE> oldEpsilons;
+    for (INT i = 0; i < iLevelCount; ++i)
+    {
+        oldEpsilons.AddItem(static_cast<DOUBLE>(pIntegrator->GetLevelStepLength(i)));
+    }
+
+    //<dH> = <dH^2> / 2 for small dH
+    const DOUBLE fMeasuredDH = 0.5 * m_fDeltaHSq / m_uiTrajectory;
+    if (m_fPredictedDH > _CLG_FLT_MIN_)
+    {
+        m_fPredictionRatio = fMeasuredDH / m_fPredictedDH;
+        appGeneral(_T(" Tuner: predicted <dH> = %f, measured <dH> = %f, ratio = %f\n"), m_fPredictedDH, fMeasuredDH, m_fPredictionRatio);
+    }
+    const DOUBLE fOld2Lambda = static_cast<DOUBLE>(pIntegrator->GetOmelyan2Lambda());
+    const DOUBLE fModelDH = ShadowError(uiOrder, fOld2Lambda, oldEpsilons);
+    if (fMeasuredDH < _CLG_FLT_MIN_ || fModelDH < _CLG_FLT_MIN_)
+    {
+        appGeneral(_T(" Tuner: <dH> = %f, model = %f, skip tuning.\n"), fMeasuredDH, fModelDH);
+        return;
+    }
+    const DOUBLE fNormalize = fMeasuredDH / fModelDH;
+
+    //Omelyan lambda, scan 0 < lambda < 1/2
+    DOUBLE fNew2Lambda = fOld2Lambda;
+    if (pIntegrator->HasOmelyanLambda() && 2 == uiOrder)
+    {
+        DOUBLE fMinError = ShadowError(uiOrder, fOld2Lambda, oldEpsilons);
+        for (INT i = 1; i < 1000; ++i)
+        {
+            const DOUBLE f2Lambda = i * 0.001;
+            const DOUBLE fError = ShadowError(uiOrder, f2Lambda, oldEpsilons);
+            if (fError < fMinError)
+            {
+                fMinError = fError;
+                fNew2Lambda = f2Lambda;
+            }
+        }
+    }
+
+    //acceptance = erfc(sqrt(<dH>) / 2), solve x = sqrt(<dH>) / 2 by bisection
+    DOUBLE fLeft = 0.0;
+    DOUBLE fRight = 10.0;
+    for (INT i = 0; i < 100; ++i)
+    {
+        const DOUBLE fMid = 0.5 * (fLeft + fRight);
+        if (erfc(fMid) > m_fTargetAcceptance)
+        {
+            fLeft = fMid;
+        }
+        else
+        {
+            fRight = fMid;
+        }
+    }
+    const DOUBLE fTargetDH = 4.0 * fLeft * fLeft;
+
+    //if one level is too fast to be timed, treat all levels equally
+    UBOOL bTimed = TRUE;
+    for (INT i = 0; i < iLevelCount; ++i)
+    {
+        if (m_lstForceTime[i] <= 0.0)
+        {
+            bTimed = FALSE;
+        }
+    }
+
+    //search all step counts, cost = sum _i time_i / epsilon_i
+    TArray<UINT> steps;
+    TArray<UINT> bestSteps = oldSteps;
+    TArray<DOUBLE> epsilons = oldEpsilons;
+    for (INT i = 0; i < iLevelCount; ++i)
+    {
+        steps.AddItem(1);
+    }
+    DOUBLE fBestCost = -1.0;
+    DOUBLE fBestError = -1.0;
+    UBOOL bFound = FALSE;
+    while (TRUE)
+    {
+        DOUBLE fRatio = 1.0;
+        DOUBLE fCost = 0.0;
+        for (INT i = 0; i < iLevelCount; ++i)
+        {
+            fRatio = fRatio * oldSteps[i] / steps[i];
+            epsilons[i] = oldEpsilons[i] * fRatio;
+            fCost += (bTimed ? m_lstForceTime[i] : 1.0) / epsilons[i];
+        }
+        const DOUBLE fError = fNormalize * ShadowError(uiOrder, fNew2Lambda, epsilons);
+        if (fError <= fTargetDH)
+        {
+            if (!bFound || fCost < fBestCost)
+            {
+                bFound = TRUE;
+                fBestCost = fCost;
+                fBestError = fError;
+                bestSteps = steps;
+            }
+        }
+        else if (!bFound && (fBestError < 0.0 || fError < fBestError))
+        {
+            fBestError = fError;
+            bestSteps = steps;
+        }
+
+        //next combination
+        INT iLevel = 0;
+        for (; iLevel < iLevelCount; ++iLevel)
+        {
+            const UINT uiMax = (0 == iLevel) ? m_uiMaxStep : m_uiMaxNestedStep;
+            if (steps[iLevel] < uiMax)
+            {
+                ++steps[iLevel];
+                break;
+            }
+            steps[iLevel] = 1;
+        }
+        if (iLevel == iLevelCount)
+        {
+            break;
+        }
+    }
+
+    pIntegrator->SetLevelSteps(bestSteps);
+    if (pIntegrator->HasOmelyanLambda())
+    {
+        pIntegrator->SetOmelyan2Lambda(static_cast<Real>(fNew2Lambda));
+    }
+    m_fPredictedDH = fBestError;
+
+    CCString sYaml;
+    sYaml.Format(_T("## Tuned: round %d, measured <dH> = %f, target <dH> = %f (acceptance %f), expected <dH> = %f\n"),
+        m_uiRound + 1, fMeasuredDH, fTargetDH, m_fTargetAcceptance, fBestError);
+    sYaml = sYaml + pIntegrator->GetLevelStepInfo(_T(""));
+    if (pIntegrator->HasOmelyanLambda())
+    {
+        sYaml = sYaml + _T("Omelyan2Lambda : ") + appFloatToString(pIntegrator->GetOmelyan2Lambda()) + _T("\n");
+    }
+    appGeneral(_T(" Tuner:\n%s"), sYaml.c_str());
+    if (!bFound)
+    {
+        appGeneral(_T(" Tuner: target acceptance cannot be reached with TuneMaxStep and TuneMaxNestedStep.\n"));
+    }
+
+    if (!m_sOutputFile.IsEmpty())
+    {
+        appGetFileSystem()->WriteAllText(m_sOutputFile.c_str(), sYaml);
+    }
+}
+
+CCString CIntegratorTuner::GetInfos(const CCString& sTab) const
+{
+    CCString sRet;
+    sRet = sRet + sTab + _T("TuneTrajectory : ") + appIntToString(static_cast<INT>(m_uiTrajectoryPerRound)) + _T("\n");
+    sRet = sRet + sTab + _T("TuneRound : ") + appIntToString(static_cast<INT>(m_uiMaxRound)) + _T("\n");
+    sRet = sRet + sTab + _T("TuneTargetAcceptance : ") + appFloatToString(m_fTargetAcceptance) + _T("\n");
+    return sRet;
+}
+
+__END_NAMESPACE
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
@@ -0,0 +1,127 @@
+//=============================================================================
+// FILENAME : CIntegratorTuner.h
+//
+// DESCRIPTION:
+// This is the auto-tuner of integrator parameters, used by CHMC
+//
+// The shadow Hamiltonian of Omelyan (or leap-frog with 2 lambda = 1) is
+// H' = H + sum _i epsilon_i^2 (alpha {S_i,{S_i,T}} + beta {T,{S_i,T}})
+// alpha = (6 lambda^2 - 6 lambda + 1) / 12, beta = (1 - 6 lambda) / 24
+// where i is the level of nested integrator.
+//
+// At the beginning of a trajectory, on each level,
+// {S,{S,T}} = |F|^2 and {T,{S,T}} = - d/dh (P.F(exp(hP)U)) are measured,
+// and the cost of force is measured by the time of calculation.
+//
+// After "TuneTrajectory" trajectories, lambda is chosen to minimize
+// sum _i epsilon_i^4 <(alpha A_i + beta B_i)^2>,
+// then the model is normalized using measured <dH>,
+// and step counts with the minimal cost, such that
+// erfc(sqrt(<dH>) / 2) >= "TuneTargetAcceptance" is chosen.
+//
+// For force gradient, it is epsilon^4 and only step counts are tuned.
+//
+// The <dH> expected for the tuned parameters is compared with the one
+// measured in the next round, see GetPredictionRatio.
+//
+// The tuned parameters are printed and written to "TuneOutput" as yaml.
+// Tuning changes the integrator between trajectories,
+// so it should be used in the thermalization.
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+
+#ifndef _CINTEGRATORTUNER_H_
+#define _CINTEGRATORTUNER_H_
+
+__BEGIN_NAMESPACE
+
+class CLGAPI CIntegratorTuner
+{
+public:
+
+    CIntegratorTuner()
+        : m_uiTrajectoryPerRound(10)
+        , m_uiMaxRound(3)
+        , m_uiMaxStep(100)
+        , m_uiMaxNestedStep(10)
+        , m_fTargetAcceptance(F(0.8))
+        , m_fBracketStep(F(0.01))
+        , m_uiRound(0)
+        , m_uiTrajectory(0)
+        , m_fDeltaHSq(0.0)
+        , m_uiBracketCount(0)
+        , m_fPredictedDH(-1.0)
+        , m_fPredictionRatio(-1.0)
+        , m_pGaugeBackup(NULL)
+    {
+    }
+
+    ~CIntegratorTuner();
+
+    void Initial(const CParameters& params);
+    UBOOL IsTuning() const { return m_uiRound < m_uiMaxRound; }
+
+    /**
+    * Called after the momentum is generated and before the evaluation
+    */
+    void MeasureBrackets(class CIntegrator* pIntegrator);
+
+    /**
+    * fDeltaH = H(after) - H(before), tune when there are enough trajectories
+    */
+    void AddDeltaH(class CIntegrator* pIntegrator, DOUBLE fDeltaH);
+
+    CCString GetInfos(const CCString& sTab) const;
+
+    /**
+    * The <dH> expected by the model for the tuned parameters, -1 if not tuned
+    */
+    DOUBLE GetPredictedDeltaH() const { return m_fPredictedDH; }
+
+    /**
+    * measured <dH> / predicted <dH> of the last round with tuned parameters, -1 if not known
+    * It is used to validate the model (especially the epsilon^8 scaling for 4-th order)
+    */
+    DOUBLE GetPredictionRatio() const { return m_fPredictionRatio; }
+
+protected:
+
+    void Reset(INT iLevelCount);
+    void Tune(class CIntegrator* pIntegrator);
+    DOUBLE ShadowError(UINT uiOrder, DOUBLE f2Lambda, const TArray<DOUBLE>& epsilons) const;
+
+    UINT m_uiTrajectoryPerRound;
+    UINT m_uiMaxRound;
+    UINT m_uiMaxStep;
+    UINT m_uiMaxNestedStep;
+    Real m_fTargetAcceptance;
+    Real m_fBracketStep;
+    CCString m_sOutputFile;
+
+    UINT m_uiRound;
+    UINT m_uiTrajectory;
+    DOUBLE m_fDeltaHSq;
+
+    //<A^2>, <AB>, <B^2> of each level, A = {S,{S,T}}, B = {T,{S,T}}
+    TArray<DOUBLE> m_lstA2;
+    TArray<DOUBLE> m_lstAB;
+    TArray<DOUBLE> m_lstB2;
+    //time of one force calculation of each level
+    TArray<DOUBLE> m_lstForceTime;
+    UINT m_uiBracketCount;
+
+    DOUBLE m_fPredictedDH;
+    DOUBLE m_fPredictionRatio;
+
+    class CFieldGauge* m_pGaugeBackup;
+};
+
+__END_NAMESPACE
+
+#endif //#ifndef _CINTEGRATORTUNER_H_
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
@@ -0,0 +1,532 @@
+//=============================================================================
+// FILENAME : CHeatbath.cu
+//
+// DESCRIPTION:
+// This is the class for heatbath and over-relaxation of pure gauge
+//
+// REVISION:
+//  [10/19/2026 nbale]
+//=============================================================================
+#include "CLGLib_Private.h"
+
+//When the Kennedy-Pendleton (or Best-Fisher) trial keep failing, keep the link
+#define _heatbathMaxTrial 64
+
+__BEGIN_NAMESPACE
+
+__CLGIMPLEMENT_CLASS(CHeatbath)
+
+#pragma region device functions
+
+/**
+ * The staple of one link, same as _kernelCalculateOnlyStaple
+ * so that Re[tr(U S^+)] is the sum of plaquettes containing U
+ */
+static __device__ __inline__ deviceSU3 _deviceHeatbathStapleSU3(
+    const deviceSU3* __restrict__ pDeviceData,
+    const SIndex* __restrict__ pCachedIndex,
+    UINT plaqLength, UINT plaqCount, UINT uiLinkIndex)
+{
+    const UINT plaqLengthm1 = plaqLength - 1;
+    const UINT plaqCountAll = plaqCount * plaqLengthm1;
+    deviceSU3 res = deviceSU3::makeSU3Zero();
+    for (UINT i = 0; i < plaqCount; ++i)
+    {
+        SIndex first = pCachedIndex[i * plaqLengthm1 + uiLinkIndex * plaqCountAll];
+        deviceSU3 toAdd(pDeviceData[_deviceGetLinkIndex(first.m_uiSiteIndex, first.m_byDir)]);
+
+        if (first.NeedToDagger())
+        {
+            toAdd.Dagger();
+        }
+
+        for (UINT j = 1; j < plaqLengthm1; ++j)
+        {
+            SIndex nextlink = pCachedIndex[i * plaqLengthm1 + j + uiLinkIndex * plaqCountAll];
+            deviceSU3 toMul(pDeviceData[_deviceGetLinkIndex(nextlink.m_uiSiteIndex, nextlink.m_byDir)]);
+
+            if (nextlink.NeedToDagger())
+            {
+                toAdd.MulDagger(toMul);
+            }
+            else
+            {
+                toAdd.Mul(toMul);
+            }
+        }
+        res.Add(toAdd);
+    }
+    return res;
+}
+
+static __device__ __inline__ CLGComplex _deviceHeatbathStapleU1(
+    const CLGComplex* __restrict__ pDeviceData,
+    const SIndex* __restrict__ pCachedIndex,
+    UINT plaqLength, UINT plaqCount, UINT uiLinkIndex)
+{
+    const UINT plaqLengthm1 = plaqLength - 1;
+    const UINT plaqCountAll = plaqCount * plaqLengthm1;
+    CLGComplex res = _zeroc;
+    for (UINT i = 0; i < plaqCount; ++i)
+    {
+        SIndex first = pCachedIndex[i * plaqLengthm1 + uiLinkIndex * plaqCountAll];
+        CLGComplex toAdd = pDeviceData[_deviceGetLinkIndex(first.m_uiSiteIndex, first.m_byDir)];
+
+        if (first.NeedToDagger())
+        {
+            toAdd.y = -toAdd.y;
+        }
+
+        for (UINT j = 1; j < plaqLengthm1; ++j)
+        {
+            SIndex nextlink = pCachedIndex[i * plaqLengthm1 + j + uiLinkIndex * plaqCountAll];
+            const CLGComplex& toMul = pDeviceData[_deviceGetLinkIndex(nextlink.m_uiSiteIndex, nextlink.m_byDir)];
+
+            if (nextlink.NeedToDagger())
+            {
+                toAdd = _cuCmulf(toAdd, _cuConjf(toMul));
+            }
+            else
+            {
+                toAdd = _cuCmulf(toAdd, toMul);
+            }
+        }
+        res = _cuCaddf(res, toAdd);
+    }
+    return res;
+}
+
+/**
+ * SU2 element is x0 + i x.sigma
+ *
+ *  x0 + i x3    x2 + i x1
+ * -x2 + i x1    x0 - i x3
+ *
+ * m[p,:], m[q,:] = X (m[p,:], m[q,:])
+ */
+static __device__ __inline__ void _deviceSU2LeftMultiply(
+    deviceSU3& m, BYTE p, BYTE q,
+    Real x0, Real x1, Real x2, Real x3)
+{
+    const CLGComplex x00 = _make_cuComplex(x0, x3);
+    const CLGComplex x01 = _make_cuComplex(x2, x1);
+    const CLGComplex x10 = _make_cuComplex(-x2, x1);
+    const CLGComplex x11 = _make_cuComplex(x0, -x3);
+    for (BYTE c = 0; c < 3; ++c)
+    {
+        const CLGComplex mp = m.m_me[p * 3 + c];
+        const CLGComplex mq = m.m_me[q * 3 + c];
+        m.m_me[p * 3 + c] = _cuCaddf(_cuCmulf(x00, mp), _cuCmulf(x01, mq));
+        m.m_me[q * 3 + c] = _cuCaddf(_cuCmulf(x10, mp), _cuCmulf(x11, mq));
+    }
+}
+
+/**
+ * Update the SU2 subgroup (p,q) of U
+ * w = U S^+, the weight is exp(beta/N Re[tr(X w)])
+ *
+ * The SU2 part of w is k V, V in SU2
+ * Heatbath: Y = X V is sampled using Kennedy-Pendleton, X = Y V^+
+ * Over-relaxation: X = V^+ V^+, so that Re[tr(X V)] = Re[tr(V^+)] = Re[tr(V)]
+ *
+ * Both U and w are updated to X U and X w
+ */
+static __device__ __inline__ void _deviceSU2SubgroupUpdate(
+    deviceSU3& u, deviceSU3& w, BYTE p, BYTE q,
+    UINT uiFatIndex, SRandomDraw& uiDraw, Real fBetaOverN, UBOOL bOverrelaxation)
+{
+    const CLGComplex& wpp = w.m_me[p * 3 + p];
+    const CLGComplex& wpq = w.m_me[p * 3 + q];
+    const CLGComplex& wqp = w.m_me[q * 3 + p];
+    const CLGComplex& wqq = w.m_me[q * 3 + q];
+
+    //V^+ = (a0, -a) / k
+    Real a0 = F(0.5) * (wpp.x + wqq.x);
+    Real a1 = -F(0.5) * (wpq.y + wqp.y);
+    Real a2 = -F(0.5) * (wpq.x - wqp.x);
+    Real a3 = -F(0.5) * (wpp.y - wqq.y);
+    const Real fK = _sqrt(a0 * a0 + a1 * a1 + a2 * a2 + a3 * a3);
+    if (fK < _CLG_FLT_MIN_)
+    {
+        return;
+    }
+    const Real fInvK = __rcp(fK);
+    a0 = a0 * fInvK;
+    a1 = a1 * fInvK;
+    a2 = a2 * fInvK;
+    a3 = a3 * fInvK;
+
+    Real x0, x1, x2, x3;
+    if (bOverrelaxation)
+    {
+        x0 = a0 * a0 - a1 * a1 - a2 * a2 - a3 * a3;
+        x1 = F(2.0) * a0 * a1;
+        x2 = F(2.0) * a0 * a2;
+        x3 = F(2.0) * a0 * a3;
+    }
+    else
+    {
+        //y0 distributed as sqrt(1-y0^2) exp(alpha y0)
+        const Real fInvAlpha = __rcp(F(2.0) * fK * fBetaOverN);
+        Real y0 = F(1.0);
+        UBOOL bAccepted = FALSE;
+        for (BYTE byTrial = 0; byTrial < _heatbathMaxTrial; ++byTrial)
+        {
+            const Real r1 = F(1.0) - _deviceRandomF(uiFatIndex, uiDraw);
+            const Real r2 = _cos(PI2 * _deviceRandomF(uiFatIndex, uiDraw));
+            const Real r3 = F(1.0) - _deviceRandomF(uiFatIndex, uiDraw);
+            const Real r4 = _deviceRandomF(uiFatIndex, uiDraw);
+            const Real fLambda2 = -F(0.5) * fInvAlpha * (_log(r1) + r2 * r2 * _log(r3));
+            if (r4 * r4 <= F(1.0) - fLambda2)
+            {
+                y0 = F(1.0) - F(2.0) * fLambda2;
+                bAccepted = TRUE;
+                break;
+            }
+        }
+
+        if (!bAccepted)
+        {
+            return;
+        }
+
+        //uniform on the sphere with radius sqrt(1-y0^2)
+        const Real fCosTheta = F(2.0) * _deviceRandomF(uiFatIndex, uiDraw) - F(1.0);
+        const Real fPhi = PI2 * _deviceRandomF(uiFatIndex, uiDraw);
+        const Real fSinTheta2 = F(1.0) - fCosTheta * fCosTheta;
+        const Real fR2 = F(1.0) - y0 * y0;
+        const Real fSinTheta = fSinTheta2 > F(0.0) ? _sqrt(fSinTheta2) : F(0.0);
+        const Real fR = fR2 > F(0.0) ? _sqrt(fR2) : F(0.0);
+        const Real y1 = fR * fSinTheta * _cos(fPhi);
+        const Real y2 = fR * fSinTheta * _sin(fPhi);
+        const Real y3 = fR * fCosTheta;
+
+        //X = Y V^+
+        x0 = y0 * a0 - y1 * a1 - y2 * a2 - y3 * a3;
+        x1 = y0 * a1 + a0 * y1 - (y2 * a3 - y3 * a2);
+        x2 = y0 * a2 + a0 * y2 - (y3 * a1 - y1 * a3);
+        x3 = y0 * a3 + a0 * y3 - (y1 * a2 - y2 * a1);
+    }
+
+    _deviceSU2LeftMultiply(u, p, q, x0, x1, x2, x3);
+    _deviceSU2LeftMultiply(w, p, q, x0, x1, x2, x3);
+}
+
+static __device__ __inline__ void _deviceHeatbathLinkSU3(
+    deviceSU3* pDeviceData,
+    const SIndex* __restrict__ pCachedIndex,
+    UINT plaqLength, UINT plaqCount,
+    UINT uiSiteIndex, const SSmallInt4& sSite4, BYTE byDir,
+    Real fBetaOverN, UBOOL bOverrelaxation)
+{
+    if (__idx->_deviceIsBondOnSurface(__idx->_deviceGetBigIndex(sSite4), byDir))
+    {
+        return;
+    }
+
+    const UINT uiLinkIndex = _deviceGetLinkIndex(uiSiteIndex, byDir);
+    const UINT uiFatIndex = _deviceGetFatIndex(uiSiteIndex, byDir + 1);
+    const deviceSU3 staple = _deviceHeatbathStapleSU3(pDeviceData, pCachedIndex, plaqLength, plaqCount, uiLinkIndex);
+    deviceSU3 u(pDeviceData[uiLinkIndex]);
+    deviceSU3 w(u.MulDaggerC(staple));
+
+    SRandomDraw uiDraw;
+    _deviceSU2SubgroupUpdate(u, w, 0, 1, uiFatIndex, uiDraw, fBetaOverN, bOverrelaxation);
+    _deviceSU2SubgroupUpdate(u, w, 0, 2, uiFatIndex, uiDraw, fBetaOverN, bOverrelaxation);
+    _deviceSU2SubgroupUpdate(u, w, 1, 2, uiFatIndex, uiDraw, fBetaOverN, bOverrelaxation);
+
+    u.Norm();
+    pDeviceData[uiLinkIndex] = u;
+}
+
+/**
+ * The weight is exp(beta Re[u s^*]) = exp(beta |s| cos(theta - phi)), s = |s| exp(i phi)
+ * Heatbath: delta = theta - phi is sampled from von Mises using Best-Fisher
+ * Over-relaxation: delta -> -delta, or u = (s/|s|)^2 u^*
+ */
+static __device__ __inline__ void _deviceHeatbathLinkU1(
+    CLGComplex* pDeviceData,
+    const SIndex* __restrict__ pCachedIndex,
+    UINT plaqLength, UINT plaqCount,
+    UINT uiSiteIndex, const SSmallInt4& sSite4, BYTE byDir,
+    Real fBetaOverN, UBOOL bOverrelaxation)
+{
+    if (__idx->_deviceIsBondOnSurface(__idx->_deviceGetBigIndex(sSite4), byDir))
+    {
+        return;
+    }
+
+    const UINT uiLinkIndex = _deviceGetLinkIndex(uiSiteIndex, byDir);
+    const UINT uiFatIndex = _deviceGetFatIndex(uiSiteIndex, byDir + 1);
+    CLGComplex staple = _deviceHeatbathStapleU1(pDeviceData, pCachedIndex, plaqLength, plaqCount, uiLinkIndex);
+    const Real fAbsS = _cuCabsf(staple);
+    if (fAbsS < _CLG_FLT_MIN_)
+    {
+        return;
+    }
+    staple = cuCmulf_cr(staple, __rcp(fAbsS));
+
+    if (bOverrelaxation)
+    {
+        pDeviceData[uiLinkIndex] = _cuCmulf(_cuCmulf(staple, staple), _cuConjf(pDeviceData[uiLinkIndex]));
+        return;
+    }
+
+    const Real fKappa = fBetaOverN * fAbsS;
+    SRandomDraw uiDraw;
+    Real fCos = F(1.0);
+    Real fSin = F(0.0);
+    if (fKappa < _CLG_FLT_EPSILON)
+    {
+        const Real fArg = PI2 * _deviceRandomF(uiFatIndex, uiDraw);
+        fCos = _cos(fArg);
+        fSin = _sin(fArg);
+    }
+    else
+    {
+        const Real fTau = F(1.0) + _sqrt(F(1.0) + F(4.0) * fKappa * fKappa);
+        const Real fRho = (fTau - _sqrt(F(2.0) * fTau)) / (F(2.0) * fKappa);
+        const Real fR = (F(1.0) + fRho * fRho) / (F(2.0) * fRho);
+        UBOOL bAccepted = FALSE;
+        for (BYTE byTrial = 0; byTrial < _heatbathMaxTrial; ++byTrial)
+        {
+            const Real z = _cos(PI * _deviceRandomF(uiFatIndex, uiDraw));
+            const Real u2 = F(1.0) - _deviceRandomF(uiFatIndex, uiDraw);
+            const Real f = (F(1.0) + fR * z) / (fR + z);
+            const Real c = fKappa * (fR - f);
+            if (c * (F(2.0) - c) - u2 > F(0.0) || _log(c / u2) + F(1.0) - c >= F(0.0))
+            {
+                fCos = f;
+                const Real fSin2 = F(1.0) - f * f;
+                fSin = fSin2 > F(0.0) ? _sqrt(fSin2) : F(0.0);
+                if (_deviceRandomF(uiFatIndex, uiDraw) < F(0.5))
+                {
+                    fSin = -fSin;
+                }
+                bAccepted = TRUE;
+                break;
+            }
+        }
+
+        if (!bAccepted)
+        {
+            return;
+        }
+    }
+
+    pDeviceData[uiLinkIndex] = _cuCmulf(staple, _make_cuComplex(fCos, fSin));
+}
+
+#pragma endregion
+
+#pragma region kernels
+
+/**
+ * Only links with direction byDir on even (or odd) sites are updated,
+ * so the staples of them are not changed during the update
+ */
+__global__ void _CLG_LAUNCH_BOUND
+_kernelHeatbathSU3Even(
+    deviceSU3* pDeviceData,
+    const SIndex* __restrict__ pCachedIndex,
+    UINT plaqLength, UINT plaqCount,
+    BYTE byDir, Real fBetaOverN, UBOOL bOverrelaxation)
+{
+    intokernalInt4_even;
+    _deviceHeatbathLinkSU3(pDeviceData, pCachedIndex, plaqLength, plaqCount, uiSiteIndex, sSite4, byDir, fBetaOverN, bOverrelaxation);
+}
+
+__global__ void _CLG_LAUNCH_BOUND
+_kernelHeatbathSU3Odd(
+    deviceSU3* pDeviceData,
+    const SIndex* __restrict__ pCachedIndex,
+    UINT plaqLength, UINT plaqCount,
+    BYTE byDir, Real fBetaOverN, UBOOL bOverrelaxation)
+{
+    intokernalInt4_odd;
+    _deviceHeatbathLinkSU3(pDeviceData, pCachedIndex, plaqLength, plaqCount, uiSiteIndex, sSite4, byDir, fBetaOverN, bOverrelaxation);
+}
+
+__global__ void _CLG_LAUNCH_BOUND
+_kernelHeatbathU1Even(
+    CLGComplex* pDeviceData,
+    const SIndex* __restrict__ pCachedIndex,
+    UINT plaqLength, UINT plaqCount,
+    BYTE byDir, Real fBetaOverN, UBOOL bOverrelaxation)
+{
+    intokernalInt4_even;
+    _deviceHeatbathLinkU1(pDeviceData, pCachedIndex, plaqLength, plaqCount, uiSiteIndex, sSite4, byDir, fBetaOverN, bOverrelaxation);
+}
+
+__global__ void _CLG_LAUNCH_BOUND
+_kernelHeatbathU1Odd(
+    CLGComplex* pDeviceData,
+    const SIndex* __restrict__ pCachedIndex,
+    UINT plaqLength, UINT plaqCount,
+    BYTE byDir, Real fBetaOverN, UBOOL bOverrelaxation)
+{
+    intokernalInt4_odd;
+    _deviceHeatbathLinkU1(pDeviceData, pCachedIndex, plaqLength, plaqCount, uiSiteIndex, sSite4, byDir, fBetaOverN, bOverrelaxation);
+}
+
+#pragma endregion
+
+void CHeatbath::Initial(class CLatticeData* pOwner, const CParameters& params)
+{
+    m_pOwner = pOwner;
+    m_iAcceptedConfigurationCount = 0;
+
+    for (INT i = 0; i < m_pOwner->m_pActionList.Num(); ++i)
+    {
+        CActionGaugePlaquette* pAction = dynamic_cast<CActionGaugePlaquette*>(m_pOwner->m_pActionList[i]);
+        if (NULL == pAction)
+        {
+            appCrucial(_T("CHeatbath: only support pure gauge with CActionGaugePlaquette, but have %s\n"), m_pOwner->m_pActionList[i]->GetClass()->GetName());
+            _FAIL_EXIT;
+        }
+        if (NULL != m_pPlaquetteAction)
+        {
+            appCrucial(_T("CHeatbath: only support one CActionGaugePlaquette\n"));
+            _FAIL_EXIT;
+        }
+        m_pPlaquetteAction = pAction;
+    }
+
+    if (NULL == m_pPlaquetteAction)
+    {
+        appCrucial(_T("CHeatbath: CActionGaugePlaquette not found\n"));
+        _FAIL_EXIT;
+    }
+
+    if (NULL == m_pOwner->m_pGaugeField
+     || (EFT_GaugeSU3 != m_pOwner->m_pGaugeField->GetFieldType() && EFT_GaugeU1 != m_pOwner->m_pGaugeField->GetFieldType()))
+    {
+        appCrucial(_T("CHeatbath: only support CFieldGaugeSU3 and CFieldGaugeU1\n"));
+        _FAIL_EXIT;
+    }
+
+    INT iValue = 1;
+    params.FetchValueINT(_T("HeatbathSweep"), iValue);
+    m_uiHeatbathSweep = iValue > 0 ? static_cast<UINT>(iValue) : 0;
+
+    iValue = 4;
+    params.FetchValueINT(_T("OverrelaxationSweep"), iValue);
+    m_uiOverrelaxationSweep = iValue > 0 ? static_cast<UINT>(iValue) : 0;
+
+    INT iSave = 0;
+    params.FetchValueINT(_T("SaveConfiguration"), iSave);
+    m_bSaveConfigurations = (0 != iSave);
+
+    INT iReport = 1;
+    params.FetchValueINT(_T("ReportMeasure"), iReport);
+    m_bReport = (0 != iReport);
+
+    if (m_bSaveConfigurations)
+    {
+        m_sConfigurationPrefix = _T("Untitled");
+        params.FetchStringValue(_T("ConfigurationFilePrefix"), m_sConfigurationPrefix);
+        m_sConfigurationPrefix.Format(_T("%s_%d"), m_sConfigurationPrefix.c_str(), appGetTimeStamp());
+    }
+}
+
+void CHeatbath::Sweep(UBOOL bOverrelaxation) const
+{
+    preparethread_even;
+    const Real fBetaOverN = static_cast<Real>(m_pPlaquetteAction->GetBetaOverN());
+    const SIndex* pCache = appGetLattice()->m_pIndexCache->m_pStappleCache;
+    const UINT uiPlaqLength = appGetLattice()->m_pIndexCache->m_uiPlaqutteLength;
+    const UINT uiPlaqCount = appGetLattice()->m_pIndexCache->m_uiPlaqutteCountPerLink;
+    assert(NULL != pCache);
+
+    if (EFT_GaugeSU3 == m_pOwner->m_pGaugeField->GetFieldType())
+    {
+        CFieldGaugeSU3* pGauge = dynamic_cast<CFieldGaugeSU3*>(m_pOwner->m_pGaugeField);
+        //each link is updated once in a sweep, so one launch of random for a sweep
+        if (!bOverrelaxation)
+        {
+            m_pOwner->m_pRandom->NextLaunch();
+        }
+        for (BYTE byDir = 0; byDir < static_cast<BYTE>(_HC_Dir); ++byDir)
+        {
+            _kernelHeatbathSU3Even << <block, threads >> > (pGauge->m_pDeviceData, pCache, uiPlaqLength, uiPlaqCount, byDir, fBetaOverN, bOverrelaxation);
+            _kernelHeatbathSU3Odd << <block, threads >> > (pGauge->m_pDeviceData, pCache, uiPlaqLength, uiPlaqCount, byDir, fBetaOverN, bOverrelaxation);
+        }
+        pGauge->IncreaseVersion();
+        return;
+    }
+
+    CFieldGaugeU1* pGauge = dynamic_cast<CFieldGaugeU1*>(m_pOwner->m_pGaugeField);
+    if (!bOverrelaxation)
+    {
+        m_pOwner->m_pRandom->NextLaunch();
+    }
+    for (BYTE byDir = 0; byDir < static_cast<BYTE>(_HC_Dir); ++byDir)
+    {
+        _kernelHeatbathU1Even << <block, threads >> > (pGauge->m_pDeviceData, pCache, uiPlaqLength, uiPlaqCount, byDir, fBetaOverN, bOverrelaxation);
+        _kernelHeatbathU1Odd << <block, threads >> > (pGauge->m_pDeviceData, pCache, uiPlaqLength, uiPlaqCount, byDir, fBetaOverN, bOverrelaxation);
+    }
+    pGauge->IncreaseVersion();
+}
+
+UINT CHeatbath::Update(UINT iSteps, UBOOL bMeasure)
+{
+    ++m_uiUpdateCall;
+
+    for (UINT i = 0; i < iSteps; ++i)
+    {
+        m_pOwner->m_pRandom->NextTrajectory();
+        for (UINT j = 0; j < m_uiHeatbathSweep; ++j)
+        {
+            Sweep(FALSE);
+        }
+        for (UINT j = 0; j < m_uiOverrelaxationSweep; ++j)
+        {
+            Sweep(TRUE);
+        }
+        m_pOwner->FixAllFieldBoundary();
+
+        ++m_iAcceptedConfigurationCount;
+        appGeneral(_T(" Heatbath: step = %d (accepted:%d)\n"), i + 1, m_iAcceptedConfigurationCount);
+
+        if (bMeasure)
+        {
+            m_pOwner->OnUpdatorConfigurationAccepted(m_pOwner->m_pGaugeField, NULL);
+        }
+
+        if (m_bSaveConfigurations)
+        {
+            SaveConfiguration(i + 1);
+        }
+    }
+
+    checkCudaErrors(cudaGetLastError());
+    checkCudaErrors(cudaDeviceSynchronize());
+    checkCudaErrors(cudaGetLastError());
+
+    m_pOwner->OnUpdatorFinished(bMeasure, m_bReport);
+#if !_CLG_DEBUG
+    appFlushLog();
+#endif
+    return m_iAcceptedConfigurationCount;
+}
+
+Real CHeatbath::CalculateEnergy()
+{
+    return static_cast<Real>(m_pOwner->m_pGaugeField->CalculatePlaqutteEnergy(m_pPlaquetteAction->GetBetaOverN()));
+}
+
+CCString CHeatbath::GetInfos(const CCString &tab) const
+{
+    CCString sRet;
+    sRet = sRet + tab + _T("Name : Heatbath\n");
+    sRet = sRet + tab + _T("HeatbathSweep : ") + appIntToString(static_cast<INT>(m_uiHeatbathSweep)) + _T("\n");
+    sRet = sRet + tab + _T("OverrelaxationSweep : ") + appIntToString(static_cast<INT>(m_uiOverrelaxationSweep)) + _T("\n");
+    return sRet;
+}
+
+__END_NAMESPACE
+
+
+//=============================================================================
+// END OF FILE
+//=============================================================================
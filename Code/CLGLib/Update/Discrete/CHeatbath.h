@@ -1,36 +1,72 @@
 //=============================================================================
-// FILENAME : CCommonData.h
-// 
+// FILENAME : CHeatbath.h
+//
 // DESCRIPTION:
-// This is the class for the common data
+// This is the class for heatbath and over-relaxation of pure gauge
+// (only CActionGaugePlaquette)
+//
+// For SU3, Cabibbo-Marinari heatbath is used, each SU2 subgroup is updated
+// using Kennedy-Pendleton. The over-relaxation is microcanonical on
+// each SU2 subgroup.
+// For U1, the angle is sampled using Best-Fisher (von Mises distribution)
+// and over-relaxation is the reflection of the angle.
+//
+// The links are updated with checkerboard, one direction and one parity
+// at a time, the staple is calculated using m_pStappleCache
 //
 // REVISION:
-//  [12/3/2018 nbale]
+//  [10/19/2026 nbale]
 //=============================================================================
 
-#ifndef _CCOMMONDATA_H_
-#define _CCOMMONDATA_H_
+#ifndef _CHEATBATH_H_
+#define _CHEATBATH_H_
 
 __BEGIN_NAMESPACE
 
-class CLGAPI CCommonData
+__CLG_REGISTER_HELPER_HEADER(CHeatbath)
+
+class CLGAPI CHeatbath : public CUpdator
 {
+    __CLGDECLARE_CLASS(CHeatbath)
+
 public:
 
-    static UINT m_iDim;
-    static UINT m_iDir;
-    static STRING m_sGauge;
-    static STRING m_sFermion;
+    CHeatbath()
+        : CUpdator()
+        , m_pPlaquetteAction(NULL)
+        , m_uiHeatbathSweep(1)
+        , m_uiOverrelaxationSweep(4)
+    {
+    }
+
+    UINT Update(UINT iSteps, UBOOL bMeasure) override;
+    Real CalculateEnergy() override;
+    EUpdatorType GetUpdatorType() const override { return EUT_Heatbath; }
 
-    //related with a
-    //related with beta
-    static FLOAT m_fG;
+    void Initial(class CLatticeData* pOwner, const CParameters& params) override;
+    CCString GetInfos(const CCString &tab) const override;
+
+    /**
+     * Heatbath is always exact, there is nothing to correct
+     */
+    void SetAutoCorrection(UBOOL bAutoCorrection) override { }
+
+    /**
+     * One sweep is one update of all links
+     */
+    void Sweep(UBOOL bOverrelaxation) const;
+
+protected:
+
+    class CActionGaugePlaquette* m_pPlaquetteAction;
+    UINT m_uiHeatbathSweep;
+    UINT m_uiOverrelaxationSweep;
 };
 
 __END_NAMESPACE
 
-#endif //#ifndef _CCOMMONDATA_H_
+#endif //#ifndef _CHEATBATH_H_
 
 //=============================================================================
 // END OF FILE
-//=============================================================================
\ No newline at end of file
+//=============================================================================
@@ -10,11 +10,20 @@
 #include "CLGTest.h"
 
 TestList* _testSuits;
+CCString _sTestExecutable;
 
-UINT RunTest(CParameters&params, TestList* pTest)
+UINT RunTest(CParameters&params, TestList* pTest, const TArray<CCString>& overrides)
 {
     appGeneral("\n=========== Testing:%s \n", pTest->m_sParamName);
     CParameters paramForTheTest = params.GetParameter(pTest->m_sParamName);
+    for (INT i = 0; i < overrides.Num(); ++i)
+    {
+        const INT iEqual = overrides[i].Find(_T('='));
+        if (iEqual > 0)
+        {
+            paramForTheTest.SetStringVaule(overrides[i].Left(iEqual), overrides[i].Mid(iEqual + 1));
+        }
+    }
     appGeneral(_T("============= Parameters =============\n"));
     paramForTheTest.Dump(_T(""));
     //Initial
@@ -36,6 +45,11 @@ UINT RunTest(CParameters&params, TestList* pTest)
     return uiErrors;
 }
 
+UINT RunTest(CParameters&params, TestList* pTest)
+{
+    return RunTest(params, pTest, TArray<CCString>());
+}
+
 void ListAllTests(const THashMap<CCString, TArray<TestList*>*>& category)
 {
     TArray<CCString> sKeys = category.GetAllKeys();
@@ -138,6 +152,29 @@ int main(int argc, char * argv[])
         }
     }
 
+    //"CLGTest TestName Key=Value ..." runs one test with the parameters changed, and returns the number of errors.
+    //It is used by the tests running several processes, for example the ranks of TestDomainDecompositionRanks.
+    _sTestExecutable = argv[0];
+    if (argc > 1)
+    {
+        TArray<CCString> overrides;
+        for (INT i = 2; i < argc; ++i)
+        {
+            overrides.AddItem(argv[i]);
+        }
+        UINT uiErrors = 1;
+        for (INT i = 0; i < allTests.Num(); ++i)
+        {
+            if (CCString(allTests[i]->m_sParamName) == CCString(argv[1]))
+            {
+                uiErrors = RunTest(params, allTests[i], overrides);
+                break;
+            }
+        }
+        DeleteAllLists(category);
+        return static_cast<int>(uiErrors);
+    }
+
     //INT inputNumber = -1;
     ListAllTests(category);
     while (TRUE)
@@ -37,6 +37,11 @@ typedef TSimpleDoubleLinkedList<STestSuits> TestList;
 
 extern TestList* _testSuits;
 
+/**
+* argv[0], to start other processes of the tests
+*/
+extern CCString _sTestExecutable;
+
 //=============================================================================
 // END OF FILE
 //=============================================================================
@@ -253,6 +253,7 @@ UINT TestDebugFunction(CParameters&)
 __REGIST_TEST(TestGamma5Hermiticity, Misc, TestGamm5Hermiticity);
 
 __REGIST_TEST(TestAnitiHermiticity, Misc, TestAnitiHermiticity);
+__REGIST_TEST(TestAnitiHermiticity, Misc, TestAnitiHermiticityAsqtad);
 
 __REGIST_TEST(TestDebugFunction, Misc, TestDebug);
 
@@ -351,6 +352,917 @@ UINT TestPlaqutteTable(CParameters&)
 
 __REGIST_TEST(TestPlaqutteTable, Misc, TestPlaqutteTable);
 
+UINT TestLatticeContext(CParameters& sParam)
+{
+    UINT uiErrors = 0;
+    CLatticeContext* pFirst = appGetLatticeContext();
+    const UINT uiFirstVolume = _HC_Volume;
+    const DOUBLE fFirst = static_cast<DOUBLE>(appGetLattice()->m_pGaugeField->CalculatePlaqutteEnergy(F(1.0)));
+
+    CParameters secondParam = sParam.GetParameter(_T("SecondContext"));
+    CLatticeContext* pSecond = appCreateLatticeContext(secondParam);
+    if (NULL == pSecond)
+    {
+        return 1;
+    }
+    const UINT uiSecondVolume = _HC_Volume;
+    const DOUBLE fSecond = static_cast<DOUBLE>(appGetLattice()->m_pGaugeField->CalculatePlaqutteEnergy(F(1.0)));
+
+    appSetLatticeContext(pFirst);
+    const DOUBLE fFirst2 = static_cast<DOUBLE>(appGetLattice()->m_pGaugeField->CalculatePlaqutteEnergy(F(1.0)));
+    appGeneral(_T("first: volume %d, energy %f, after switch: volume %d, energy %f\n"), uiFirstVolume, fFirst, _HC_Volume, fFirst2);
+    if (uiFirstVolume != _HC_Volume || appAbs(fFirst - fFirst2) > 0.000001)
+    {
+        ++uiErrors;
+    }
+
+    appSetLatticeContext(pSecond);
+    const DOUBLE fSecond2 = static_cast<DOUBLE>(appGetLattice()->m_pGaugeField->CalculatePlaqutteEnergy(F(1.0)));
+    appGeneral(_T("second: volume %d, energy %f, after switch: volume %d, energy %f\n"), uiSecondVolume, fSecond, _HC_Volume, fSecond2);
+    if (uiSecondVolume != _HC_Volume || appAbs(fSecond - fSecond2) > 0.000001)
+    {
+        ++uiErrors;
+    }
+
+    appReleaseLatticeContext(pSecond);
+    appSetLatticeContext(pFirst);
+    if (uiFirstVolume != _HC_Volume)
+    {
+        ++uiErrors;
+    }
+
+    return uiErrors;
+}
+
+__REGIST_TEST(TestLatticeContext, Misc, TestLatticeContext);
+
+UINT TestIndexCache(CParameters& sParam)
+{
+    //the first context baked and saved the tables, the second one loads them
+    UINT uiErrors = 0;
+    CLatticeContext* pBaked = appGetLatticeContext();
+    const UINT uiBakedPlaqutte = appGetLattice()->m_pIndex->GetPlaqutteCount();
+    const DOUBLE fBaked = static_cast<DOUBLE>(appGetLattice()->m_pGaugeField->CalculatePlaqutteEnergy(F(1.0)));
+
+    const CCString sCacheFile = appGetLattice()->m_pIndexCache->m_sCacheFile;
+    if (sCacheFile.IsEmpty() || !CFileSystem::IsFileExist(sCacheFile))
+    {
+        appGeneral(_T("index cache file is not written!\n"));
+        return 1;
+    }
+
+    CLatticeContext* pLoaded = appCreateLatticeContext(sParam);
+    if (NULL == pLoaded)
+    {
+        remove(sCacheFile.c_str());
+        appSetLatticeContext(pBaked);
+        return 1;
+    }
+    const UBOOL bLoaded = appGetLattice()->m_pIndexCache->m_bLoadedFromCache;
+    const UINT uiLoadedPlaqutte = appGetLattice()->m_pIndex->GetPlaqutteCount();
+    const DOUBLE fLoaded = static_cast<DOUBLE>(appGetLattice()->m_pGaugeField->CalculatePlaqutteEnergy(F(1.0)));
+    appGeneral(_T("baked: plaqutte %d, energy %f, loaded (%d): plaqutte %d, energy %f\n"), uiBakedPlaqutte, fBaked, bLoaded, uiLoadedPlaqutte, fLoaded);
+    if (!bLoaded)
+    {
+        ++uiErrors;
+    }
+    if (uiBakedPlaqutte != uiLoadedPlaqutte || fBaked != fLoaded)
+    {
+        ++uiErrors;
+    }
+
+    appReleaseLatticeContext(pLoaded);
+    appSetLatticeContext(pBaked);
+
+    //do not leave the cache to the next run, so that the first context always bakes
+    remove(sCacheFile.c_str());
+    return uiErrors;
+}
+
+__REGIST_TEST(TestIndexCache, Misc, TestIndexCache);
+
+UINT TestDirectStencil(CParameters& sParam)
+{
+    //the neighbours computed on torus should give the same result as the baked tables
+    UINT uiErrors = 0;
+    CIndex* pIndex = appGetLattice()->m_pIndex;
+    if (!pIndex->UseDirectStencil(1))
+    {
+        appGeneral(_T("Direct stencil is not used, nothing to compare\n"));
+        return 0;
+    }
+
+    CFieldGaugeSU3* pGauge = dynamic_cast<CFieldGaugeSU3*>(appGetLattice()->m_pGaugeField);
+    CFieldGaugeSU3* pStapleDirect = dynamic_cast<CFieldGaugeSU3*>(pGauge->GetCopy());
+    CFieldGaugeSU3* pStapleTable = dynamic_cast<CFieldGaugeSU3*>(pGauge->GetCopy());
+    CFieldFermionWilsonSquareSU3* pF1 = dynamic_cast<CFieldFermionWilsonSquareSU3*>(appGetLattice()->GetPooledFieldById(2));
+    CFieldFermionWilsonSquareSU3* pF2 = dynamic_cast<CFieldFermionWilsonSquareSU3*>(appGetLattice()->GetPooledFieldById(2));
+    pF1->InitialField(EFIT_RandomGaussian);
+    pF1->CopyTo(pF2);
+
+    const DOUBLE fDirect = static_cast<DOUBLE>(pGauge->CalculatePlaqutteEnergy(F(1.0)));
+    pGauge->CalculateOnlyStaple(pStapleDirect);
+    pF1->D(pGauge);
+
+    pIndex->SetDirectStencil(FALSE);
+    const DOUBLE fTable = static_cast<DOUBLE>(pGauge->CalculatePlaqutteEnergy(F(1.0)));
+    pGauge->CalculateOnlyStaple(pStapleTable);
+    pF2->D(pGauge);
+    pIndex->SetDirectStencil(TRUE);
+
+    pStapleDirect->AxpyMinus(pStapleTable);
+    pF1->AxpyMinus(pF2);
+    const CLGComplex stapleDiff = pStapleDirect->DotReal(pStapleDirect);
+    const CLGComplex fermionDiff = pF1->DotReal(pF1);
+    appGeneral(_T("energy direct %f, table %f, |staple diff|^2 = %f, |D diff|^2 = %f\n"), fDirect, fTable, stapleDiff.x, fermionDiff.x);
+
+    if (appAbs(fDirect - fTable) > 0.000001)
+    {
+        ++uiErrors;
+    }
+    if (stapleDiff.x > F(0.000001))
+    {
+        ++uiErrors;
+    }
+    if (fermionDiff.x > F(0.000001))
+    {
+        ++uiErrors;
+    }
+
+    pF1->Return();
+    pF2->Return();
+    appSafeDelete(pStapleDirect);
+    appSafeDelete(pStapleTable);
+
+    //staggered fermion with anti-periodic t
+    CFieldFermionKSSU3* pKS1 = dynamic_cast<CFieldFermionKSSU3*>(appGetLattice()->GetPooledFieldById(3));
+    CFieldFermionKSSU3* pKS2 = dynamic_cast<CFieldFermionKSSU3*>(appGetLattice()->GetPooledFieldById(3));
+    pKS1->InitialField(EFIT_RandomGaussian);
+    pKS1->CopyTo(pKS2);
+    pKS1->D(pGauge);
+    pIndex->SetDirectStencil(FALSE);
+    pKS2->D(pGauge);
+    pIndex->SetDirectStencil(TRUE);
+    pKS1->AxpyMinus(pKS2);
+    const CLGComplex ksDiff = pKS1->DotReal(pKS1);
+
+    //the time of D, and the memory of the tables not read by the direct stencil
+    INT iRepeat = 100;
+    sParam.FetchValueINT(_T("DirectStencilRepeat"), iRepeat);
+    CTimer timerDirect;
+    CTimer timerTable;
+    timerDirect.Start();
+    for (INT i = 0; i < iRepeat; ++i)
+    {
+        pKS2->D(pGauge);
+    }
+    checkCudaErrors(cudaDeviceSynchronize());
+    timerDirect.Stop();
+    pIndex->SetDirectStencil(FALSE);
+    timerTable.Start();
+    for (INT i = 0; i < iRepeat; ++i)
+    {
+        pKS2->D(pGauge);
+    }
+    checkCudaErrors(cudaDeviceSynchronize());
+    timerTable.Stop();
+    pIndex->SetDirectStencil(TRUE);
+
+    //gauge move: Dir, fermion move: 2 Dir, eta: 1 byte
+    const UINT uiTableBytesPerSite = static_cast<UINT>(sizeof(SIndex)) * 3 * _HC_Dir + 1;
+    appGeneral(_T("KS: |D diff|^2 = %f, time of %d D: direct %f ms, table %f ms, tables not read: %d bytes per site, %d bytes per D\n"),
+        ksDiff.x, iRepeat, timerDirect.Elapsed(), timerTable.Elapsed(), uiTableBytesPerSite, uiTableBytesPerSite * static_cast<UINT>(_HC_Volume));
+    if (ksDiff.x > F(0.000001))
+    {
+        ++uiErrors;
+    }
+
+    pKS1->Return();
+    pKS2->Return();
+
+    //the same lattice without "BakeStencilTables", only the direct stencil reads the neighbours, so the tables are not baked
+    CLatticeContext* pBaked = appGetLatticeContext();
+    CParameters noTableParam = sParam;
+    noTableParam.SetStringVaule(_T("BakeStencilTables"), _T("0"));
+    CLatticeContext* pNoTable = appCreateLatticeContext(noTableParam);
+    if (NULL == pNoTable)
+    {
+        appSetLatticeContext(pBaked);
+        return uiErrors + 1;
+    }
+    const CIndexData* pNoTableCache = appGetLattice()->m_pIndexCache;
+    const UBOOL bTableBaked = NULL != pNoTableCache->m_pStappleCache
+        || NULL != pNoTableCache->m_pPlaqutteCache
+        || NULL != pNoTableCache->m_pGaugeMoveCache[2]
+        || NULL != pNoTableCache->m_pFermionMoveCache[3]
+        || NULL != pNoTableCache->m_pEtaMu;
+    const DOUBLE fNoTable = static_cast<DOUBLE>(appGetLattice()->m_pGaugeField->CalculatePlaqutteEnergy(F(1.0)));
+    appGeneral(_T("without tables: tables baked %d, energy %f\n"), bTableBaked, fNoTable);
+    if (bTableBaked)
+    {
+        ++uiErrors;
+    }
+    //same random seed, same gauge field
+    if (appAbs(fDirect - fNoTable) > 0.000001)
+    {
+        ++uiErrors;
+    }
+    appReleaseLatticeContext(pNoTable);
+    appSetLatticeContext(pBaked);
+
+    return uiErrors;
+}
+
+__REGIST_TEST(TestDirectStencil, Misc, TestDirectStencil);
+
+UINT TestDomainDecomposition(CParameters& sParam)
+{
+    //Two ranks in one process, each holds 4 of the 8 x-planes plus 1 halo plane on each side
+    UINT uiErrors = 0;
+    CLatticeContext* pGlobal = appGetLatticeContext();
+    const UINT uiGlobalLx = _HC_Lx;
+    const UINT uiPlaneSites = _HC_Volume / _HC_Lx;
+    const UINT uiGaugeBytes = static_cast<UINT>(sizeof(deviceSU3)) * _HC_Dir;
+    const UINT uiFermionBytes = static_cast<UINT>(sizeof(deviceWilsonVectorSU3));
+
+    CFieldGaugeSU3* pGauge = dynamic_cast<CFieldGaugeSU3*>(appGetLattice()->m_pGaugeField);
+    CFieldFermionWilsonSquareSU3* pPhi = dynamic_cast<CFieldFermionWilsonSquareSU3*>(appGetLattice()->GetPooledFieldById(2));
+    pPhi->InitialField(EFIT_RandomGaussian);
+    TArray<BYTE> hostGauge;
+    TArray<BYTE> hostPhi;
+    TArray<BYTE> hostDPhi;
+    hostGauge.AddSize(static_cast<INT>(uiGaugeBytes * _HC_Volume));
+    hostPhi.AddSize(static_cast<INT>(uiFermionBytes * _HC_Volume));
+    hostDPhi.AddSize(static_cast<INT>(uiFermionBytes * _HC_Volume));
+    checkCudaErrors(cudaMemcpy(hostGauge.GetData(), pGauge->m_pDeviceData, uiGaugeBytes * _HC_Volume, cudaMemcpyDeviceToHost));
+    checkCudaErrors(cudaMemcpy(hostPhi.GetData(), pPhi->m_pDeviceData, uiFermionBytes * _HC_Volume, cudaMemcpyDeviceToHost));
+    const DOUBLE fGlobalNorm = static_cast<DOUBLE>(pPhi->DotReal(pPhi).x);
+    pPhi->D(pGauge);
+    checkCudaErrors(cudaMemcpy(hostDPhi.GetData(), pPhi->m_pDeviceData, uiFermionBytes * _HC_Volume, cudaMemcpyDeviceToHost));
+    pPhi->Return();
+
+    CCString sDirectory = _T(".");
+    sParam.FetchStringValue(_T("HaloDirectory"), sDirectory);
+    CParameters slabParam = sParam.GetParameter(_T("Slab"));
+    CHaloTransportSharedFile* pTransport[2];
+    CDomainDecomposition* pDecomp[2];
+    CLatticeContext* pSlab[2];
+    CFieldFermionWilsonSquareSU3* pSlabPhi[2];
+    for (UINT i = 0; i < 2; ++i)
+    {
+        pTransport[i] = new CHaloTransportSharedFile(sDirectory, _T("TestDomainDecomposition"), i, 2);
+        pDecomp[i] = new CDomainDecomposition();
+        if (!pDecomp[i]->Initial(pTransport[i], uiGlobalLx, uiPlaneSites, 1, uiGaugeBytes))
+        {
+            return 1;
+        }
+        CParameters rankParam = slabParam;
+        pDecomp[i]->FillLatticeParameters(rankParam);
+        pSlab[i] = appCreateLatticeContext(rankParam);
+        if (NULL == pSlab[i] || pDecomp[i]->GetLocalLx() != _HC_Lx)
+        {
+            return 1;
+        }
+
+        //the interior planes of the slab are the continuous planes of the global lattice
+        const UINT uiGlobalStart = pDecomp[i]->GetGlobalXStart() * uiPlaneSites;
+        const UINT uiLocalStart = pDecomp[i]->GetInteriorSiteStart();
+        const UINT uiCount = pDecomp[i]->GetInteriorSiteCount();
+        CFieldGaugeSU3* pSlabGauge = dynamic_cast<CFieldGaugeSU3*>(appGetLattice()->m_pGaugeField);
+        pSlabPhi[i] = dynamic_cast<CFieldFermionWilsonSquareSU3*>(appGetLattice()->GetPooledFieldById(2));
+        checkCudaErrors(cudaMemcpy((BYTE*)pSlabGauge->m_pDeviceData + uiLocalStart * uiGaugeBytes,
+            hostGauge.GetData() + uiGlobalStart * uiGaugeBytes, uiCount * uiGaugeBytes, cudaMemcpyHostToDevice));
+        checkCudaErrors(cudaMemcpy((BYTE*)pSlabPhi[i]->m_pDeviceData + uiLocalStart * uiFermionBytes,
+            hostPhi.GetData() + uiGlobalStart * uiFermionBytes, uiCount * uiFermionBytes, cudaMemcpyHostToDevice));
+    }
+
+    //the sends do not wait, so both ranks can be driven from one thread
+    for (UINT i = 0; i < 2; ++i)
+    {
+        appSetLatticeContext(pSlab[i]);
+        pDecomp[i]->BeginHaloExchange(dynamic_cast<CFieldGaugeSU3*>(appGetLattice()->m_pGaugeField)->m_pDeviceData, uiGaugeBytes);
+    }
+    for (UINT i = 0; i < 2; ++i)
+    {
+        appSetLatticeContext(pSlab[i]);
+        if (!pDecomp[i]->EndHaloExchange(dynamic_cast<CFieldGaugeSU3*>(appGetLattice()->m_pGaugeField)->m_pDeviceData, uiGaugeBytes))
+        {
+            ++uiErrors;
+        }
+    }
+    for (UINT i = 0; i < 2; ++i)
+    {
+        pDecomp[i]->BeginHaloExchange(pSlabPhi[i]->m_pDeviceData, uiFermionBytes);
+    }
+    for (UINT i = 0; i < 2; ++i)
+    {
+        if (!pDecomp[i]->EndHaloExchange(pSlabPhi[i]->m_pDeviceData, uiFermionBytes))
+        {
+            ++uiErrors;
+        }
+    }
+
+    DOUBLE fLocalNorm[2];
+    for (UINT i = 0; i < 2; ++i)
+    {
+        appSetLatticeContext(pSlab[i]);
+        CFieldFermionWilsonSquareSU3* pCopy = dynamic_cast<CFieldFermionWilsonSquareSU3*>(appGetLattice()->GetPooledFieldById(2));
+        pSlabPhi[i]->CopyTo(pCopy);
+        pDecomp[i]->ZeroHalo(pCopy->m_pDeviceData, uiFermionBytes);
+        fLocalNorm[i] = static_cast<DOUBLE>(pCopy->DotReal(pSlabPhi[i]).x);
+        pCopy->Return();
+
+        pSlabPhi[i]->D(appGetLattice()->m_pGaugeField);
+        const UINT uiGlobalStart = pDecomp[i]->GetGlobalXStart() * uiPlaneSites;
+        const UINT uiCount = pDecomp[i]->GetInteriorSiteCount();
+        const UINT uiRealCount = uiCount * uiFermionBytes / static_cast<UINT>(sizeof(Real));
+        TArray<Real> hostLocal;
+        hostLocal.AddSize(static_cast<INT>(uiRealCount));
+        checkCudaErrors(cudaMemcpy(hostLocal.GetData(), pSlabPhi[i]->m_pDeviceData + pDecomp[i]->GetInteriorSiteStart(),
+            uiCount * uiFermionBytes, cudaMemcpyDeviceToHost));
+        const Real* pExpected = reinterpret_cast<const Real*>(hostDPhi.GetData() + uiGlobalStart * uiFermionBytes);
+        Real fMaxDiff = F(0.0);
+        for (UINT j = 0; j < uiRealCount; ++j)
+        {
+            const Real fDiff = appAbs(hostLocal[j] - pExpected[j]);
+            fMaxDiff = fDiff > fMaxDiff ? fDiff : fMaxDiff;
+        }
+        appGeneral(_T("rank %d: max |D diff| = %f\n"), i, fMaxDiff);
+        if (fMaxDiff > F(0.000001))
+        {
+            ++uiErrors;
+        }
+    }
+
+    //the reduction waits for all ranks, so run the ranks in threads
+    std::thread rank1([&]() { fLocalNorm[1] = pDecomp[1]->AllReduceSum(fLocalNorm[1]); });
+    fLocalNorm[0] = pDecomp[0]->AllReduceSum(fLocalNorm[0]);
+    rank1.join();
+    appGeneral(_T("|phi|^2 global %f, reduced %f, %f\n"), fGlobalNorm, fLocalNorm[0], fLocalNorm[1]);
+    if (appAbs(fLocalNorm[0] - fGlobalNorm) > 0.0001 * fGlobalNorm || fLocalNorm[0] != fLocalNorm[1])
+    {
+        ++uiErrors;
+    }
+
+    for (UINT i = 0; i < 2; ++i)
+    {
+        appSetLatticeContext(pSlab[i]);
+        pSlabPhi[i]->Return();
+        appSafeDelete(pDecomp[i]);
+        appSafeDelete(pTransport[i]);
+        appReleaseLatticeContext(pSlab[i]);
+    }
+    appSetLatticeContext(pGlobal);
+    return uiErrors;
+}
+
+__REGIST_TEST(TestDomainDecomposition, Misc, TestDomainDecomposition);
+
+/**
+* max |local - global| on the interior sites, in unit of Real
+*/
+static Real _MaxInteriorDifference(const CDomainDecomposition* pDecomp, const void* pLocalDevice, const BYTE* pGlobalHost, UINT uiBytesPerSite, UINT uiPlaneSites)
+{
+    const UINT uiCount = pDecomp->GetInteriorSiteCount();
+    const UINT uiRealCount = uiCount * uiBytesPerSite / static_cast<UINT>(sizeof(Real));
+    TArray<Real> hostLocal;
+    hostLocal.AddSize(static_cast<INT>(uiRealCount));
+    checkCudaErrors(cudaMemcpy(hostLocal.GetData(), static_cast<const BYTE*>(pLocalDevice) + pDecomp->GetInteriorSiteStart() * uiBytesPerSite,
+        uiCount * uiBytesPerSite, cudaMemcpyDeviceToHost));
+    const Real* pExpected = reinterpret_cast<const Real*>(pGlobalHost + pDecomp->GetGlobalXStart() * uiPlaneSites * uiBytesPerSite);
+    Real fMaxDiff = F(0.0);
+    for (UINT j = 0; j < uiRealCount; ++j)
+    {
+        const Real fDiff = appAbs(hostLocal[j] - pExpected[j]);
+        fMaxDiff = fDiff > fMaxDiff ? fDiff : fMaxDiff;
+    }
+    return fMaxDiff;
+}
+
+UINT TestDomainDecompositionAttached(CParameters& sParam)
+{
+    //One rank exchanging with itself, the slab is the global lattice with 3 halo planes on both sides,
+    //so the x origin is -3 (odd), the staggered eta, the parity and the center must be shifted.
+    //With the decomposition attached, D, the solver and the energy of the rotating action run on the slab without change.
+    UINT uiErrors = 0;
+    CLatticeContext* pGlobal = appGetLatticeContext();
+    const UINT uiPlaneSites = _HC_Volume / _HC_Lx;
+    const UINT uiGaugeBytes = static_cast<UINT>(sizeof(deviceSU3)) * _HC_Dir;
+    const UINT uiFermionBytes = static_cast<UINT>(sizeof(deviceSU3Vector));
+    const UINT uiGlobalVolume = _HC_Volume;
+    INT iHalo = 3;
+    sParam.FetchValueINT(_T("Halo"), iHalo);
+
+    CFieldGaugeSU3* pGauge = dynamic_cast<CFieldGaugeSU3*>(appGetLattice()->m_pGaugeField);
+    CFieldFermionKSSU3* pPhi = dynamic_cast<CFieldFermionKSSU3*>(appGetLattice()->GetPooledFieldById(2));
+    CFieldFermionKSSU3* pX = dynamic_cast<CFieldFermionKSSU3*>(appGetLattice()->GetPooledFieldById(2));
+    pPhi->InitialField(EFIT_RandomGaussian);
+    pPhi->CopyTo(pX);
+    TArray<BYTE> hostGauge;
+    TArray<BYTE> hostPhi;
+    TArray<BYTE> hostDPhi;
+    TArray<BYTE> hostX;
+    hostGauge.AddSize(static_cast<INT>(uiGaugeBytes * uiGlobalVolume));
+    hostPhi.AddSize(static_cast<INT>(uiFermionBytes * uiGlobalVolume));
+    hostDPhi.AddSize(static_cast<INT>(uiFermionBytes * uiGlobalVolume));
+    hostX.AddSize(static_cast<INT>(uiFermionBytes * uiGlobalVolume));
+    checkCudaErrors(cudaMemcpy(hostGauge.GetData(), pGauge->m_pDeviceData, uiGaugeBytes * uiGlobalVolume, cudaMemcpyDeviceToHost));
+    checkCudaErrors(cudaMemcpy(hostPhi.GetData(), pPhi->m_pDeviceData, uiFermionBytes * uiGlobalVolume, cudaMemcpyDeviceToHost));
+    const DOUBLE fGlobalNorm = static_cast<DOUBLE>(pPhi->DotReal(pPhi).x);
+    const DOUBLE fGlobalEnergy = appGetLattice()->GetActionById(1)->Energy(FALSE, pGauge, NULL);
+    pPhi->D(pGauge);
+    checkCudaErrors(cudaMemcpy(hostDPhi.GetData(), pPhi->m_pDeviceData, uiFermionBytes * uiGlobalVolume, cudaMemcpyDeviceToHost));
+    pX->InverseDDdagger(pGauge);
+    checkCudaErrors(cudaMemcpy(hostX.GetData(), pX->m_pDeviceData, uiFermionBytes * uiGlobalVolume, cudaMemcpyDeviceToHost));
+    const DOUBLE fGlobalSolutionNorm = static_cast<DOUBLE>(pX->DotReal(pX).x);
+    pPhi->Return();
+    pX->Return();
+
+    CCString sDirectory = _T(".");
+    sParam.FetchStringValue(_T("HaloDirectory"), sDirectory);
+    CHaloTransportSharedFile* pTransport = new CHaloTransportSharedFile(sDirectory, _T("TestDomainDecompositionAttached"), 0, 1);
+    CDomainDecomposition* pDecomp = new CDomainDecomposition();
+    if (!pDecomp->Initial(pTransport, _HC_Lx, uiPlaneSites, static_cast<UINT>(iHalo), uiGaugeBytes))
+    {
+        return 1;
+    }
+    CParameters slabParam = sParam.GetParameter(_T("Slab"));
+    pDecomp->FillLatticeParameters(slabParam);
+    CLatticeContext* pSlab = appCreateLatticeContext(slabParam);
+    if (NULL == pSlab || pDecomp->GetLocalLx() != _HC_Lx)
+    {
+        return 1;
+    }
+    pDecomp->Attach();
+
+    CFieldGaugeSU3* pSlabGauge = dynamic_cast<CFieldGaugeSU3*>(appGetLattice()->m_pGaugeField);
+    CFieldFermionKSSU3* pSlabPhi = dynamic_cast<CFieldFermionKSSU3*>(appGetLattice()->GetPooledFieldById(2));
+    CFieldFermionKSSU3* pSlabX = dynamic_cast<CFieldFermionKSSU3*>(appGetLattice()->GetPooledFieldById(2));
+    const UINT uiLocalStart = pDecomp->GetInteriorSiteStart();
+    const UINT uiCount = pDecomp->GetInteriorSiteCount();
+    checkCudaErrors(cudaMemcpy((BYTE*)pSlabGauge->m_pDeviceData + uiLocalStart * uiGaugeBytes,
+        hostGauge.GetData(), uiCount * uiGaugeBytes, cudaMemcpyHostToDevice));
+    checkCudaErrors(cudaMemcpy((BYTE*)pSlabPhi->m_pDeviceData + uiLocalStart * uiFermionBytes,
+        hostPhi.GetData(), uiCount * uiFermionBytes, cudaMemcpyHostToDevice));
+    //the links are changed outside of the field, the version exchanges the halo
+    pSlabGauge->IncreaseVersion();
+    pSlabPhi->CopyTo(pSlabX);
+
+    const DOUBLE fSlabNorm = static_cast<DOUBLE>(pSlabPhi->DotReal(pSlabPhi).x);
+    const DOUBLE fSlabEnergy = appGetLattice()->GetActionById(1)->Energy(FALSE, pSlabGauge, NULL);
+    appGeneral(_T("|phi|^2 global %f, slab %f; rotating energy global %f, slab %f\n"), fGlobalNorm, fSlabNorm, fGlobalEnergy, fSlabEnergy);
+    if (appAbs(fSlabNorm - fGlobalNorm) > 0.0001 * fGlobalNorm)
+    {
+        ++uiErrors;
+    }
+    if (appAbs(fSlabEnergy - fGlobalEnergy) > 0.0001 * appAbs(fGlobalEnergy))
+    {
+        ++uiErrors;
+    }
+
+    pSlabPhi->D(pSlabGauge);
+    const Real fDDiff = _MaxInteriorDifference(pDecomp, pSlabPhi->m_pDeviceData, hostDPhi.GetData(), uiFermionBytes, uiPlaneSites);
+    appGeneral(_T("max |D diff| = %f\n"), fDDiff);
+    if (fDDiff > F(0.000001))
+    {
+        ++uiErrors;
+    }
+
+    pSlabX->InverseDDdagger(pSlabGauge);
+    const Real fXDiff = _MaxInteriorDifference(pDecomp, pSlabX->m_pDeviceData, hostX.GetData(), uiFermionBytes, uiPlaneSites);
+    const DOUBLE fSlabSolutionNorm = static_cast<DOUBLE>(pSlabX->DotReal(pSlabX).x);
+    appGeneral(_T("max |(DD^+)^{-1} diff| = %f, |x|^2 global %f, slab %f\n"), fXDiff, fGlobalSolutionNorm, fSlabSolutionNorm);
+    if (fXDiff > F(0.001) || appAbs(fSlabSolutionNorm - fGlobalSolutionNorm) > 0.001 * fGlobalSolutionNorm)
+    {
+        ++uiErrors;
+    }
+
+    pSlabPhi->Return();
+    pSlabX->Return();
+    pDecomp->Detach();
+    appSafeDelete(pDecomp);
+    appSafeDelete(pTransport);
+    appReleaseLatticeContext(pSlab);
+    appSetLatticeContext(pGlobal);
+    return uiErrors;
+}
+
+__REGIST_TEST(TestDomainDecompositionAttached, Misc, TestDomainDecompositionAttached);
+
+UINT TestDomainDecompositionRanks(CParameters& sParam)
+{
+    //Two processes, this one is rank 0 and starts "CLGTest TestDomainDecompositionRanks Rank=1".
+    //Both build the global lattice with the same seed for the expected results, then run on the slab with the
+    //decomposition attached: D splits into the inner and the boundary planes around the exchange of the fermion,
+    //and the links are exchanged by the version after they are set and after ExpMult.
+    UINT uiErrors = 0;
+    INT iRank = 0;
+    sParam.FetchValueINT(_T("Rank"), iRank);
+    CLatticeContext* pGlobal = appGetLatticeContext();
+    const UINT uiGlobalLx = _HC_Lx;
+    const UINT uiPlaneSites = _HC_Volume / _HC_Lx;
+    const UINT uiGlobalVolume = _HC_Volume;
+    const UINT uiGaugeBytes = static_cast<UINT>(sizeof(deviceSU3)) * _HC_Dir;
+    const UINT uiFermionBytes = static_cast<UINT>(sizeof(deviceSU3Vector));
+    const Real fStep = F(0.1);
+
+    CFieldGaugeSU3* pGauge = dynamic_cast<CFieldGaugeSU3*>(appGetLattice()->m_pGaugeField);
+    CFieldFermionKSSU3* pPhi = dynamic_cast<CFieldFermionKSSU3*>(appGetLattice()->GetPooledFieldById(2));
+    CFieldGaugeSU3* pMomentum = dynamic_cast<CFieldGaugeSU3*>(pGauge->GetCopy());
+    pPhi->InitialField(EFIT_RandomGaussian);
+    pMomentum->MakeRandomGenerator();
+    TArray<BYTE> hostGauge;
+    TArray<BYTE> hostMomentum;
+    TArray<BYTE> hostPhi;
+    TArray<BYTE> hostDPhi;
+    TArray<BYTE> hostDPhiEvolved;
+    hostGauge.AddSize(static_cast<INT>(uiGaugeBytes * uiGlobalVolume));
+    hostMomentum.AddSize(static_cast<INT>(uiGaugeBytes * uiGlobalVolume));
+    hostPhi.AddSize(static_cast<INT>(uiFermionBytes * uiGlobalVolume));
+    hostDPhi.AddSize(static_cast<INT>(uiFermionBytes * uiGlobalVolume));
+    hostDPhiEvolved.AddSize(static_cast<INT>(uiFermionBytes * uiGlobalVolume));
+    checkCudaErrors(cudaMemcpy(hostGauge.GetData(), pGauge->m_pDeviceData, uiGaugeBytes * uiGlobalVolume, cudaMemcpyDeviceToHost));
+    checkCudaErrors(cudaMemcpy(hostMomentum.GetData(), pMomentum->m_pDeviceData, uiGaugeBytes * uiGlobalVolume, cudaMemcpyDeviceToHost));
+    checkCudaErrors(cudaMemcpy(hostPhi.GetData(), pPhi->m_pDeviceData, uiFermionBytes * uiGlobalVolume, cudaMemcpyDeviceToHost));
+    const DOUBLE fGlobalNorm = static_cast<DOUBLE>(pPhi->DotReal(pPhi).x);
+    pPhi->D(pGauge);
+    checkCudaErrors(cudaMemcpy(hostDPhi.GetData(), pPhi->m_pDeviceData, uiFermionBytes * uiGlobalVolume, cudaMemcpyDeviceToHost));
+    checkCudaErrors(cudaMemcpy(pPhi->m_pDeviceData, hostPhi.GetData(), uiFermionBytes * uiGlobalVolume, cudaMemcpyHostToDevice));
+    pMomentum->ExpMult(fStep, pGauge);
+    pPhi->D(pGauge);
+    checkCudaErrors(cudaMemcpy(hostDPhiEvolved.GetData(), pPhi->m_pDeviceData, uiFermionBytes * uiGlobalVolume, cudaMemcpyDeviceToHost));
+    pPhi->Return();
+    appSafeDelete(pMomentum);
+
+    //rank 1 runs the same test in another process
+    INT iRank1Return = 0;
+    std::thread rank1;
+    if (0 == iRank)
+    {
+        CCString sCommand;
+        sCommand.Format(_T("\"%s\" TestDomainDecompositionRanks Rank=1"), _sTestExecutable.c_str());
+        rank1 = std::thread([&]() { iRank1Return = system(sCommand.c_str()); });
+    }
+
+    CCString sDirectory = _T(".");
+    sParam.FetchStringValue(_T("HaloDirectory"), sDirectory);
+    CHaloTransportSharedFile* pTransport = new CHaloTransportSharedFile(sDirectory, _T("TestDomainDecompositionRanks"), static_cast<UINT>(iRank), 2);
+    pTransport->SetTimeOut(120);
+    CDomainDecomposition* pDecomp = new CDomainDecomposition();
+    CLatticeContext* pSlab = NULL;
+    CParameters slabParam = sParam.GetParameter(_T("Slab"));
+    if (pDecomp->Initial(pTransport, uiGlobalLx, uiPlaneSites, 1, uiGaugeBytes))
+    {
+        pDecomp->FillLatticeParameters(slabParam);
+        pSlab = appCreateLatticeContext(slabParam);
+    }
+    if (NULL == pSlab || pDecomp->GetLocalLx() != _HC_Lx)
+    {
+        ++uiErrors;
+    }
+    else
+    {
+        pDecomp->Attach();
+        CFieldGaugeSU3* pSlabGauge = dynamic_cast<CFieldGaugeSU3*>(appGetLattice()->m_pGaugeField);
+        CFieldGaugeSU3* pSlabMomentum = dynamic_cast<CFieldGaugeSU3*>(pSlabGauge->GetCopy());
+        CFieldFermionKSSU3* pSlabPhi = dynamic_cast<CFieldFermionKSSU3*>(appGetLattice()->GetPooledFieldById(2));
+        const UINT uiGlobalStart = pDecomp->GetGlobalXStart() * uiPlaneSites;
+        const UINT uiLocalStart = pDecomp->GetInteriorSiteStart();
+        const UINT uiCount = pDecomp->GetInteriorSiteCount();
+        checkCudaErrors(cudaMemcpy((BYTE*)pSlabGauge->m_pDeviceData + uiLocalStart * uiGaugeBytes,
+            hostGauge.GetData() + uiGlobalStart * uiGaugeBytes, uiCount * uiGaugeBytes, cudaMemcpyHostToDevice));
+        pSlabGauge->IncreaseVersion();
+        checkCudaErrors(cudaMemcpy((BYTE*)pSlabPhi->m_pDeviceData + uiLocalStart * uiFermionBytes,
+            hostPhi.GetData() + uiGlobalStart * uiFermionBytes, uiCount * uiFermionBytes, cudaMemcpyHostToDevice));
+
+        const DOUBLE fSlabNorm = static_cast<DOUBLE>(pSlabPhi->DotReal(pSlabPhi).x);
+        pSlabPhi->D(pSlabGauge);
+        const Real fDDiff = _MaxInteriorDifference(pDecomp, pSlabPhi->m_pDeviceData, hostDPhi.GetData(), uiFermionBytes, uiPlaneSites);
+
+        //the halo of the momentum is zero, so the halo of the evolved links is only right if they are exchanged
+        checkCudaErrors(cudaMemcpy((BYTE*)pSlabMomentum->m_pDeviceData + uiLocalStart * uiGaugeBytes,
+            hostMomentum.GetData() + uiGlobalStart * uiGaugeBytes, uiCount * uiGaugeBytes, cudaMemcpyHostToDevice));
+        pDecomp->ZeroHalo(pSlabMomentum->m_pDeviceData, uiGaugeBytes);
+        pSlabMomentum->ExpMult(fStep, pSlabGauge);
+        checkCudaErrors(cudaMemcpy((BYTE*)pSlabPhi->m_pDeviceData + uiLocalStart * uiFermionBytes,
+            hostPhi.GetData() + uiGlobalStart * uiFermionBytes, uiCount * uiFermionBytes, cudaMemcpyHostToDevice));
+        pSlabPhi->D(pSlabGauge);
+        const Real fEvolvedDiff = _MaxInteriorDifference(pDecomp, pSlabPhi->m_pDeviceData, hostDPhiEvolved.GetData(), uiFermionBytes, uiPlaneSites);
+
+        appGeneral(_T("rank %d: |phi|^2 global %f, slab %f, max |D diff| = %f, after ExpMult %f\n"), iRank, fGlobalNorm, fSlabNorm, fDDiff, fEvolvedDiff);
+        if (appAbs(fSlabNorm - fGlobalNorm) > 0.0001 * fGlobalNorm)
+        {
+            ++uiErrors;
+        }
+        if (fDDiff > F(0.000001) || fEvolvedDiff > F(0.000001))
+        {
+            ++uiErrors;
+        }
+
+        pSlabPhi->Return();
+        appSafeDelete(pSlabMomentum);
+        pDecomp->Detach();
+        appReleaseLatticeContext(pSlab);
+    }
+    appSafeDelete(pDecomp);
+    appSafeDelete(pTransport);
+    appSetLatticeContext(pGlobal);
+
+    if (0 == iRank)
+    {
+        rank1.join();
+        if (0 != iRank1Return)
+        {
+            appGeneral(_T("rank 1 failed: %d\n"), iRank1Return);
+            ++uiErrors;
+        }
+    }
+    return uiErrors;
+}
+
+__REGIST_TEST(TestDomainDecompositionRanks, Misc, TestDomainDecompositionRanks);
+
+UINT TestMeasurementFarm(CParameters& sParam)
+{
+    UINT uiErrors = 0;
+
+    //Without WorkerId, the owners are generated and the workers never take the claims of each other
+    CParameters anonymousParam = sParam;
+    anonymousParam.SetStringVaule(_T("FarmJob"), _T("TestMeasurementFarmAnonymous"));
+    CMeasurementFarm* pAnonymous[2];
+    UINT uiClaimed[3] = { 0, 0, 0 };
+    UBOOL bClaimed[3];
+    for (UINT i = 0; i < 2; ++i)
+    {
+        pAnonymous[i] = new CMeasurementFarm();
+        pAnonymous[i]->Initial(anonymousParam, 1, 2);
+    }
+    bClaimed[0] = pAnonymous[0]->ClaimNext(uiClaimed[0]);
+    bClaimed[1] = pAnonymous[1]->ClaimNext(uiClaimed[1]);
+    bClaimed[2] = pAnonymous[1]->ClaimNext(uiClaimed[2]);
+    appGeneral(_T("anonymous workers %s and %s claimed %d, %d\n"), pAnonymous[0]->GetOwner().c_str(), pAnonymous[1]->GetOwner().c_str(), uiClaimed[0], uiClaimed[1]);
+    if (pAnonymous[0]->GetOwner() == pAnonymous[1]->GetOwner()
+     || !bClaimed[0] || !bClaimed[1] || bClaimed[2] || uiClaimed[0] == uiClaimed[1])
+    {
+        ++uiErrors;
+    }
+    for (UINT i = 0; i < 2; ++i)
+    {
+        remove((pAnonymous[0]->GetPartPrefix(i + 1) + _T(".claim")).c_str());
+        appSafeDelete(pAnonymous[i]);
+    }
+
+    //A claim not refreshed for ClaimTimeOut is taken over, the new owner keeps refreshing it
+    CParameters heartbeatParam = sParam;
+    heartbeatParam.SetStringVaule(_T("FarmJob"), _T("TestMeasurementFarmHeartbeat"));
+    heartbeatParam.SetStringVaule(_T("ClaimHeartbeat"), _T("1"));
+    CMeasurementFarm* pHeartbeat = new CMeasurementFarm();
+    pHeartbeat->Initial(heartbeatParam, 1, 1);
+    const CCString sHeartbeatClaim = pHeartbeat->GetPartPrefix(1) + _T(".claim");
+    appGetFileSystem()->WriteAllText(sHeartbeatClaim.c_str(), _T("crashed 1"));
+    UINT uiTaken = 0;
+    QWORD uiClaimTime[2] = { 0, 0 };
+    const UBOOL bTaken = pHeartbeat->ClaimNext(uiTaken);
+    for (UINT i = 0; i < 2; ++i)
+    {
+        const CCString sClaim = appGetFileSystem()->ReadAllText(sHeartbeatClaim.c_str());
+        const INT iSpace = sClaim.Find(_T(' '), 0);
+        if (iSpace <= 0 || sClaim.Left(iSpace) != pHeartbeat->GetOwner()
+         || 1 != SSCANF(sClaim.c_str() + iSpace + 1, _T("%llu"), &uiClaimTime[i]))
+        {
+            ++uiErrors;
+        }
+        if (0 == i)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(2500));
+        }
+    }
+    appGeneral(_T("stale claim taken %d, refreshed from %llu to %llu\n"), bTaken, uiClaimTime[0], uiClaimTime[1]);
+    if (!bTaken || uiClaimTime[1] <= uiClaimTime[0])
+    {
+        ++uiErrors;
+    }
+    TArray<CCString> lstNoFiles;
+    pHeartbeat->Finish(uiTaken, lstNoFiles, lstNoFiles);
+    remove((pHeartbeat->GetPartPrefix(1) + _T(".done")).c_str());
+    appSafeDelete(pHeartbeat);
+
+    //Two workers share configurations 1...6, worker 1 crashes after claiming one and is restarted
+    CMeasurementFarm* pWorker[2];
+    for (UINT i = 0; i < 2; ++i)
+    {
+        CParameters farmParam = sParam;
+        CCString sId;
+        sId.Format(_T("%d"), i);
+        farmParam.SetStringVaule(_T("WorkerId"), sId);
+        pWorker[i] = new CMeasurementFarm();
+        pWorker[i]->Initial(farmParam, 1, 6);
+    }
+
+    UINT uiCrashed = 0;
+    if (!pWorker[1]->ClaimNext(uiCrashed))
+    {
+        ++uiErrors;
+    }
+    appSafeDelete(pWorker[1]);
+    CParameters restartParam = sParam;
+    restartParam.SetStringVaule(_T("WorkerId"), _T("1"));
+    pWorker[1] = new CMeasurementFarm();
+    pWorker[1]->Initial(restartParam, 1, 6);
+
+    TArray<UINT> lstMeasured;
+    UBOOL bWorking[2] = { TRUE, TRUE };
+    while (bWorking[0] || bWorking[1])
+    {
+        for (UINT i = 0; i < 2; ++i)
+        {
+            UINT uiN = 0;
+            bWorking[i] = bWorking[i] && pWorker[i]->ClaimNext(uiN);
+            if (!bWorking[i])
+            {
+                continue;
+            }
+            lstMeasured.AddItem(uiN);
+            const CCString sPrefix = pWorker[i]->GetPartPrefix(uiN);
+            CCString sValue;
+            sValue.Format(_T("%d"), uiN);
+            TArray<CCString> lstFiles;
+            TArray<CCString> lstShared;
+            lstFiles.AddItem(sPrefix + _T("_value.csv"));
+            lstFiles.AddItem(sPrefix + _T("_row.csv"));
+            lstShared.AddItem(sPrefix + _T("_shared.csv"));
+            appGetFileSystem()->WriteAllText(lstFiles[0].c_str(), sValue);
+            appGetFileSystem()->WriteAllText(lstFiles[1].c_str(), sValue + _T("\n"));
+            appGetFileSystem()->WriteAllText(lstShared[0].c_str(), _T("shared\n"));
+            pWorker[i]->Finish(uiN, lstFiles, lstShared);
+        }
+    }
+
+    appGeneral(_T("measured %d configurations, crashed at %d, finished %d\n"), lstMeasured.Num(), uiCrashed, pWorker[0]->GetFinishedCount());
+    if (6 != lstMeasured.Num() || 6 != pWorker[0]->GetFinishedCount())
+    {
+        ++uiErrors;
+    }
+
+    if (!pWorker[0]->Merge(_T("TestMeasurementFarm")))
+    {
+        ++uiErrors;
+    }
+    const CCString sValues = appGetFileSystem()->ReadAllText(_T("TestMeasurementFarm_value.csv"));
+    const CCString sRows = appGetFileSystem()->ReadAllText(_T("TestMeasurementFarm_row.csv"));
+    const CCString sShared = appGetFileSystem()->ReadAllText(_T("TestMeasurementFarm_shared.csv"));
+    appGeneral(_T("merged: %s | %s | %s\n"), sValues.c_str(), sRows.c_str(), sShared.c_str());
+    if (sValues != _T("1,2,3,4,5,6") || sRows != _T("1\n2\n3\n4\n5\n6\n") || sShared != _T("shared\n"))
+    {
+        ++uiErrors;
+    }
+
+    appSafeDelete(pWorker[0]);
+    appSafeDelete(pWorker[1]);
+    remove(_T("TestMeasurementFarm_value.csv"));
+    remove(_T("TestMeasurementFarm_row.csv"));
+    remove(_T("TestMeasurementFarm_shared.csv"));
+    return uiErrors;
+}
+
+__REGIST_TEST(TestMeasurementFarm, Misc, TestMeasurementFarm);
+
+UINT TestLaunchTune(CParameters& sParam)
+{
+    if (!GLaunchTuner.IsEnabled())
+    {
+        appGeneral(_T("LaunchTune is not enabled!\n"));
+        return 1;
+    }
+
+    UINT uiErrors = 0;
+    CCString sTuneFile = _T("LaunchTune.txt");
+    sParam.FetchStringValue(_T("LaunchTuneFile"), sTuneFile);
+
+    //the tunes are keyed by name, so a copy of the name (not the same pointer) must find them
+    const CCString sKernel = _T("_kernelAxpyPlusFermionKS");
+    CFieldFermionKSSU3* pX = dynamic_cast<CFieldFermionKSSU3*>(appGetLattice()->GetFieldById(2));
+    CFieldFermionKSSU3* pY = dynamic_cast<CFieldFermionKSSU3*>(appGetLattice()->GetPooledFieldById(2));
+    CFieldFermionKSSU3* pRef = dynamic_cast<CFieldFermionKSSU3*>(appGetLattice()->GetPooledFieldById(2));
+
+    //ScalarMultply is not tuned, 2x is the reference
+    pX->CopyTo(pRef);
+    pRef->ScalarMultply(F(2.0));
+    const DOUBLE fRefLength = cuCabs(pRef->Dot(pRef));
+
+    //y = x + x, with every candidate while tuning
+    UINT uiLaunch = 0;
+    DOUBLE fMaxDiff = 0.0;
+    while (uiLaunch < 10000 && !GLaunchTuner.IsTuned(sKernel.c_str()))
+    {
+        pX->CopyTo(pY);
+        pY->AxpyPlus(pX);
+        pY->Axpy(F(-1.0), pRef);
+        const DOUBLE fDiff = cuCabs(pY->Dot(pY));
+        if (fDiff > fMaxDiff)
+        {
+            fMaxDiff = fDiff;
+        }
+        ++uiLaunch;
+    }
+    appGeneral(_T("tuned after %d launches, max diff = %2.12f (|ref|^2 = %f)\n"), uiLaunch, fMaxDiff, fRefLength);
+    if (!GLaunchTuner.IsTuned(sKernel.c_str()) || uiLaunch < 2)
+    {
+        ++uiErrors;
+    }
+    if (fMaxDiff > 0.000001 * fRefLength)
+    {
+        ++uiErrors;
+    }
+
+    //save the tunes and read them again, the kernel is tuned without any launch
+    appInitialLaunchTuner(sTuneFile, 1);
+    const UBOOL bLoaded = GLaunchTuner.IsTuned(sKernel.c_str());
+    pX->CopyTo(pY);
+    pY->AxpyPlus(pX);
+    pY->Axpy(F(-1.0), pRef);
+    const DOUBLE fLoadedDiff = cuCabs(pY->Dot(pY));
+    appGeneral(_T("loaded from %s: %d, diff = %2.12f\n"), sTuneFile.c_str(), bLoaded, fLoadedDiff);
+    if (!bLoaded || fLoadedDiff > 0.000001 * fRefLength)
+    {
+        ++uiErrors;
+    }
+
+    pY->Return();
+    pRef->Return();
+
+    //do not leave the tunes to the next run, so that the kernel is always tuned again
+    appLaunchTunerRelease();
+    remove(sTuneFile.c_str());
+    return uiErrors;
+}
+
+__REGIST_TEST(TestLaunchTune, Misc, TestLaunchTune);
+
+#if _CLG_LARGE_LATTICE
+
+/**
+* Lz = 160 is only accepted with SWORD coordinates (cmake -DCLGLARGELATTICE=1).
+* The coordinates of all sites are checked, and the plaqutte energy should not change
+* when the links are shifted in z across z = 127, 128
+*/
+UINT TestLargeLattice(CParameters& sParam)
+{
+    INT iShift = 67;
+    sParam.FetchValueINT(_T("ShiftZ"), iShift);
+    CFieldGaugeSU3* pGauge = dynamic_cast<CFieldGaugeSU3*>(appGetLattice()->m_pGaugeField);
+    if (NULL == pGauge || _HC_Lz <= 128)
+    {
+        appCrucial(_T("TestLargeLattice needs a SU3 gauge field and Lz > 128\n"));
+        return 1;
+    }
+
+    UINT uiErrors = 0;
+    const UINT uiDir = _HC_Dir;
+    const UINT uiLinks = _HC_Volume * uiDir;
+    TArray<deviceSU3> hostU;
+    TArray<deviceSU3> hostShifted;
+    hostU.SetSize(static_cast<INT>(uiLinks));
+    hostShifted.SetSize(static_cast<INT>(uiLinks));
+    checkCudaErrors(cudaMemcpy(hostU.GetData(), pGauge->m_pDeviceData, sizeof(deviceSU3) * uiLinks, cudaMemcpyDeviceToHost));
+
+    UINT uiWrongCoordinate = 0;
+    for (UINT uiSite = 0; uiSite < _HC_Volume; ++uiSite)
+    {
+        SSmallInt4 coord = __hostSiteIndexToInt4(uiSite);
+        if (coord.z < 0 || static_cast<UINT>(coord.z) >= _HC_Lz || _hostGetSiteIndex(coord) != uiSite)
+        {
+            ++uiWrongCoordinate;
+            continue;
+        }
+        coord.z = static_cast<SCOORD>((coord.z + iShift) % static_cast<INT>(_HC_Lz));
+        const UINT uiShifted = _hostGetSiteIndex(coord);
+        for (UINT uiD = 0; uiD < uiDir; ++uiD)
+        {
+            hostShifted[uiShifted * uiDir + uiD] = hostU[uiSite * uiDir + uiD];
+        }
+    }
+
+    const DOUBLE fEnergy = static_cast<DOUBLE>(pGauge->CalculatePlaqutteEnergy(F(1.0)));
+    checkCudaErrors(cudaMemcpy(pGauge->m_pDeviceData, hostShifted.GetData(), sizeof(deviceSU3) * uiLinks, cudaMemcpyHostToDevice));
+    pGauge->IncreaseVersion();
+    const DOUBLE fShifted = static_cast<DOUBLE>(pGauge->CalculatePlaqutteEnergy(F(1.0)));
+    appGeneral(_T("Lz = %d, wrong coordinates %d, energy %f, shifted by %d: %f\n"), _HC_Lz, uiWrongCoordinate, fEnergy, iShift, fShifted);
+    if (uiWrongCoordinate > 0)
+    {
+        ++uiErrors;
+    }
+    if (appAbs(fEnergy - fShifted) > 1.0e-6 * appAbs(fEnergy))
+    {
+        ++uiErrors;
+    }
+    return uiErrors;
+}
+
+__REGIST_TEST(TestLargeLattice, Misc, TestLargeLattice);
+
+#endif
+
 //=============================================================================
 // END OF FILE
 //=============================================================================
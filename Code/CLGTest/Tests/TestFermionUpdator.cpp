@@ -59,6 +59,24 @@ UINT TestFermionUpdator(CParameters& sParam)
         ++uiError;
     }
 
+    //the solver statistics used by "Instrument : 1"
+    INT iSolverField = 0;
+    sParam.FetchValueINT(_T("CheckSolverStatistics"), iSolverField);
+    if (iSolverField > 0)
+    {
+        const CSLASolver* pSolver = appGetFermionSolver(static_cast<BYTE>(iSolverField));
+        if (NULL == pSolver)
+        {
+            return uiError + 1;
+        }
+        appGeneral(_T("solver %s : solve %d, iteration %d, time %f (ms)\n"),
+            pSolver->GetClass()->GetName(), pSolver->GetSolveCount(), pSolver->GetIterationCount(), pSolver->GetSolveTime());
+        if (0 == pSolver->GetSolveCount() || pSolver->GetIterationCount() < pSolver->GetSolveCount())
+        {
+            ++uiError;
+        }
+    }
+
     return uiError;
 #endif
 }
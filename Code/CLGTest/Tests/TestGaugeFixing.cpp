@@ -22,6 +22,130 @@ UINT TestFFT(CParameters&)
     return 0;
 }
 
+/**
+ * The device FFT (with plan cache and components) against the host DFT
+ */
+UINT TestFFTHost(CParameters&)
+{
+    UINT uiError = 0;
+    const UINT uiComponents = sizeof(deviceSU3) / sizeof(CLGComplex);
+    const UINT uiSize = _HC_Volume * uiComponents;
+    CLGComplex* hSource = (CLGComplex*)malloc(uiSize * sizeof(CLGComplex));
+    CLGComplex* hHost = (CLGComplex*)malloc(uiSize * sizeof(CLGComplex));
+    CLGComplex* hDevice = (CLGComplex*)malloc(uiSize * sizeof(CLGComplex));
+    CLGComplex* dDevice = NULL;
+    checkCudaErrors(cudaMalloc((void**)&dDevice, uiSize * sizeof(CLGComplex)));
+    for (UINT i = 0; i < uiSize; ++i)
+    {
+        hSource[i] = _make_cuComplex(GetRandomReal() - F(0.5), GetRandomReal() - F(0.5));
+    }
+
+    for (INT iTest = 0; iTest < 4; ++iTest)
+    {
+        const UBOOL b4D = (1 == (iTest & 1));
+        const UINT uiTestComponents = (iTest > 1) ? uiComponents : 1;
+        const UINT uiTestSize = _HC_Volume * uiTestComponents;
+        memcpy(hHost, hSource, uiTestSize * sizeof(CLGComplex));
+        checkCudaErrors(cudaMemcpy(dDevice, hSource, uiTestSize * sizeof(CLGComplex), cudaMemcpyHostToDevice));
+        if (b4D)
+        {
+            CCLGFFTHelper::FFT4DComponents(dDevice, uiTestComponents, TRUE, ES_1OverSqrtNBoth);
+            CCLGFFTHelper::FFT4DHost(hHost, uiTestComponents, TRUE, ES_1OverSqrtNBoth);
+        }
+        else
+        {
+            CCLGFFTHelper::FFT3DComponents(dDevice, uiTestComponents, TRUE, ES_1OverSqrtNBoth);
+            CCLGFFTHelper::FFT3DHost(hHost, uiTestComponents, TRUE, ES_1OverSqrtNBoth);
+        }
+        checkCudaErrors(cudaMemcpy(hDevice, dDevice, uiTestSize * sizeof(CLGComplex), cudaMemcpyDeviceToHost));
+
+        Real fMaxDiff = F(0.0);
+        for (UINT i = 0; i < uiTestSize; ++i)
+        {
+            //padding of SU3 is not compared
+            if (uiTestComponents > 1 && (i % uiTestComponents) >= 9)
+            {
+                continue;
+            }
+            fMaxDiff = appMax(fMaxDiff, _cuCabsf(_cuCsubf(hDevice[i], hHost[i])));
+        }
+        appGeneral(_T("%s components = %d, max |device - host| = %2.12f\n"), b4D ? _T("4D") : _T("3D"), uiTestComponents, fMaxDiff);
+        if (fMaxDiff > F(0.0001))
+        {
+            ++uiError;
+        }
+    }
+
+    //The plans are reused
+    const UINT uiPlanCount = CCLGFFTHelper::GetPlanCount();
+    CCLGFFTHelper::FFT4DComponents(dDevice, 1, TRUE);
+    CCLGFFTHelper::FFT4DComponents(dDevice, 1, FALSE);
+    CCLGFFTHelper::FFT4DSU3((deviceSU3*)dDevice, TRUE);
+    appGeneral(_T("plan count = %d, after more FFT = %d\n"), uiPlanCount, CCLGFFTHelper::GetPlanCount());
+    if (uiPlanCount != CCLGFFTHelper::GetPlanCount())
+    {
+        ++uiError;
+    }
+
+    //The same device interface with the host backend
+    for (INT iBackend = 0; iBackend < 2; ++iBackend)
+    {
+        CCLGFFTHelper::SetBackend(0 == iBackend ? EFFTB_Device : EFFTB_Host);
+        checkCudaErrors(cudaMemcpy(dDevice, hSource, uiSize * sizeof(CLGComplex), cudaMemcpyHostToDevice));
+        CCLGFFTHelper::FFT4DComponents(dDevice, uiComponents, TRUE, ES_1OverSqrtNBoth);
+        checkCudaErrors(cudaMemcpy(0 == iBackend ? hDevice : hHost, dDevice, uiSize * sizeof(CLGComplex), cudaMemcpyDeviceToHost));
+    }
+    Real fMaxDiff = F(0.0);
+    for (UINT i = 0; i < uiSize; ++i)
+    {
+        if ((i % uiComponents) < 9)
+        {
+            fMaxDiff = appMax(fMaxDiff, _cuCabsf(_cuCsubf(hDevice[i], hHost[i])));
+        }
+    }
+    appGeneral(_T("EFFTB_Device - EFFTB_Host: max diff = %2.12f\n"), fMaxDiff);
+    if (fMaxDiff > F(0.0001))
+    {
+        ++uiError;
+    }
+
+    //R2C and C2R with the host backend, C2R(R2C(f)) = V f
+    TArray<INT> xyz;
+    xyz.AddItem(static_cast<INT>(_HC_Lx));
+    xyz.AddItem(static_cast<INT>(_HC_Ly));
+    xyz.AddItem(static_cast<INT>(_HC_Lz));
+    Real* hReal = (Real*)malloc(_HC_Volume_xyz * sizeof(Real));
+    Real* dReal = NULL;
+    checkCudaErrors(cudaMalloc((void**)&dReal, _HC_Volume_xyz * sizeof(Real)));
+    for (UINT i = 0; i < _HC_Volume_xyz; ++i)
+    {
+        hReal[i] = hSource[i].x;
+    }
+    checkCudaErrors(cudaMemcpy(dReal, hReal, _HC_Volume_xyz * sizeof(Real), cudaMemcpyHostToDevice));
+    CCLGFFTHelper::FFT3DWithXYZR2C(dReal, dDevice, xyz);
+    CCLGFFTHelper::FFT3DWithXYZC2R(dDevice, dReal, xyz);
+    checkCudaErrors(cudaMemcpy(hReal, dReal, _HC_Volume_xyz * sizeof(Real), cudaMemcpyDeviceToHost));
+    fMaxDiff = F(0.0);
+    for (UINT i = 0; i < _HC_Volume_xyz; ++i)
+    {
+        fMaxDiff = appMax(fMaxDiff, appAbs(hReal[i] / _HC_Volume_xyz - hSource[i].x));
+    }
+    appGeneral(_T("EFFTB_Host R2C and C2R: max diff = %2.12f\n"), fMaxDiff);
+    if (fMaxDiff > F(0.0001))
+    {
+        ++uiError;
+    }
+    CCLGFFTHelper::SetBackend(EFFTB_Device);
+    free(hReal);
+    checkCudaErrors(cudaFree(dReal));
+
+    free(hSource);
+    free(hHost);
+    free(hDevice);
+    checkCudaErrors(cudaFree(dDevice));
+    return uiError;
+}
+
 UINT TestGaugeFixingLandau(CParameters&)
 {
     CFieldGaugeSU3* pGauge = dynamic_cast<CFieldGaugeSU3*>(appGetLattice()->GetFieldById(1)->GetCopy());
@@ -50,6 +174,84 @@ UINT TestGaugeFixingLandau(CParameters&)
     return uiError;
 }
 
+/**
+ * The best copy should be fixed, and has the largest functional
+ */
+UINT TestGaugeFixingCopies(CParameters&)
+{
+    UINT uiError = 0;
+    CGaugeFixingCopies* pCopies = dynamic_cast<CGaugeFixingCopies*>(appGetLattice()->m_pGaugeFixing);
+    if (NULL == pCopies)
+    {
+        return 1;
+    }
+    CFieldGaugeSU3* pGauge = dynamic_cast<CFieldGaugeSU3*>(appGetLattice()->GetFieldById(1)->GetCopy());
+    CActionGaugePlaquette* pAction1 = dynamic_cast<CActionGaugePlaquette*>(appGetLattice()->GetActionById(1));
+    const Real fBeforeEnergy1 = static_cast<Real>(pAction1->Energy(FALSE, pGauge, NULL));
+
+    pCopies->GaugeFixing(pGauge);
+    const Real fDivation = static_cast<Real>(pCopies->CheckRes(pGauge));
+    const Real fAfterEnergy1 = static_cast<Real>(pAction1->Energy(FALSE, pGauge, NULL));
+    const Real fFunctional = static_cast<Real>(pCopies->Functional(pGauge));
+
+    if (fDivation > F(0.00005))
+    {
+        ++uiError;
+    }
+    if (appAbs(fBeforeEnergy1 - fAfterEnergy1) > F(0.005))
+    {
+        ++uiError;
+    }
+    if (pCopies->m_lstFunctional.Num() != static_cast<INT>(pCopies->m_uiCopies))
+    {
+        ++uiError;
+    }
+    if (pCopies->IsCoulomb() && pCopies->m_lstBestCopyOfSlice.Num() != static_cast<INT>(_HC_Lt))
+    {
+        ++uiError;
+    }
+    for (INT i = 0; i < pCopies->m_lstFunctional.Num(); ++i)
+    {
+        appGeneral(_T("copy %d : functional = %f\n"), i, static_cast<Real>(pCopies->m_lstFunctional[i]));
+        if (static_cast<Real>(pCopies->m_lstFunctional[i]) > fFunctional + F(0.00001))
+        {
+            ++uiError;
+        }
+    }
+
+    //for Coulomb gauge, each slice of the result is the best copy of that slice
+    if (pCopies->IsCoulomb())
+    {
+        const UINT uiCopies = pCopies->m_uiCopies;
+        if (pCopies->m_lstFunctionalOfSlice.Num() != static_cast<INT>(_HC_Lt * uiCopies))
+        {
+            ++uiError;
+        }
+        else
+        {
+            for (SCOORD uiT = 0; uiT < static_cast<SCOORD>(_HC_Lt); ++uiT)
+            {
+                const Real fSlice = static_cast<Real>(pCopies->FunctionalTimeSlice(pGauge, uiT));
+                Real fBestOfSlice = static_cast<Real>(pCopies->m_lstFunctionalOfSlice[uiT * uiCopies]);
+                for (UINT i = 1; i < uiCopies; ++i)
+                {
+                    fBestOfSlice = appMax(fBestOfSlice, static_cast<Real>(pCopies->m_lstFunctionalOfSlice[uiT * uiCopies + i]));
+                }
+                appGeneral(_T("t = %d : functional = %f, best of copies = %f (copy %d)\n"), uiT, fSlice, fBestOfSlice, pCopies->m_lstBestCopyOfSlice[uiT]);
+                if (appAbs(fSlice - fBestOfSlice) > F(0.00001))
+                {
+                    ++uiError;
+                }
+            }
+        }
+    }
+    appGeneral(_T("Gauge fixing with divation = %f, functional = %f (copy %d), Before Energy = %f, After Energy = %f\n"),
+        fDivation, fFunctional, pCopies->m_uiBestCopy, fBeforeEnergy1, fAfterEnergy1);
+
+    appSafeDelete(pGauge);
+    return uiError;
+}
+
 UINT TestGaugeFixingCoulombDR(CParameters&)
 {
     UINT uiError = 0;
@@ -342,14 +544,25 @@ UINT TestGaugeFixingCoulombPorjectivePlane2(CParameters&)
 
 __REGIST_TEST(TestFFT, Misc, TestFFT);
 
+__REGIST_TEST(TestFFTHost, Misc, TestFFTHost);
+
 __REGIST_TEST(TestGaugeFixingLandau, Misc, TestGaugeFixingLandauCornell);
 
 __REGIST_TEST(TestGaugeFixingLandau, Misc, TestGaugeFixingCoulombCornell);
 
+__REGIST_TEST(TestGaugeFixingLandau, Misc, TestGaugeFixingLandauCornellHostFFT);
+
+__REGIST_TEST(TestGaugeFixingLandau, Misc, TestGaugeFixingCoulombCornellHostFFT);
+
 __REGIST_TEST(TestGaugeFixingLandau, Misc, TestGaugeFixingLandauLosAlamos);
 
 __REGIST_TEST(TestGaugeFixingLandau, Misc, TestGaugeFixingCoulombLosAlamos);
 
+__REGIST_TEST(TestGaugeFixingLandau, Misc, TestGaugeFixingLandauStochastic);
+
+__REGIST_TEST(TestGaugeFixingCopies, Misc, TestGaugeFixingLandauCopies);
+__REGIST_TEST(TestGaugeFixingCopies, Misc, TestGaugeFixingCoulombCopies);
+
 #if _CLG_DOUBLEFLOAT
 __REGIST_TEST(TestGaugeFixingCoulombDR, Misc, TestGaugeFixingCoulombCornellDR);
 #endif
@@ -48,6 +48,112 @@ UINT TestRandom(CParameters& sParam)
     {
         ++uiError;
     }
+
+    //Fill the buffers, with more than one number per thread (odd count for the Box-Muller pairs)
+    const UINT uiFillCount = static_cast<UINT>(_HC_Volume) * 3 + 1;
+    Real* pHostFill = (Real*)malloc(sizeof(Real) * uiFillCount);
+    Real* pDeviceFill = NULL;
+    checkCudaErrors(cudaMalloc((void**)&pDeviceFill, sizeof(Real) * uiFillCount));
+
+    appGetLattice()->m_pRandom->FillRandomGaussF(pHostFill, uiFillCount);
+    Real fHostMean = F(0.0);
+    Real fHostVar = F(0.0);
+    for (UINT i = 0; i < uiFillCount; ++i)
+    {
+        fHostMean += pHostFill[i];
+        fHostVar += pHostFill[i] * pHostFill[i];
+    }
+    fHostMean = fHostMean / uiFillCount;
+    fHostVar = fHostVar / uiFillCount - fHostMean * fHostMean;
+
+    appGetLattice()->m_pRandom->FillDeviceRandomGaussF(pDeviceFill, uiFillCount);
+    checkCudaErrors(cudaMemcpy(pHostFill, pDeviceFill, sizeof(Real) * uiFillCount, cudaMemcpyDeviceToHost));
+    Real fDeviceMean = F(0.0);
+    Real fDeviceVar = F(0.0);
+    for (UINT i = 0; i < uiFillCount; ++i)
+    {
+        fDeviceMean += pHostFill[i];
+        fDeviceVar += pHostFill[i] * pHostFill[i];
+    }
+    fDeviceMean = fDeviceMean / uiFillCount;
+    fDeviceVar = fDeviceVar / uiFillCount - fDeviceMean * fDeviceMean;
+
+    appGetLattice()->m_pRandom->FillDeviceRandomF(pDeviceFill, uiFillCount);
+    checkCudaErrors(cudaMemcpy(pHostFill, pDeviceFill, sizeof(Real) * uiFillCount, cudaMemcpyDeviceToHost));
+    Real fDeviceUniform = F(0.0);
+    for (UINT i = 0; i < uiFillCount; ++i)
+    {
+        fDeviceUniform += pHostFill[i];
+    }
+    fDeviceUniform = fDeviceUniform / uiFillCount;
+
+    checkCudaErrors(cudaFree(pDeviceFill));
+    free(pHostFill);
+
+    appGeneral(_T("------- Fill gaussian host (mean, var) = (%f, %f), device (mean, var) = (%f, %f) (should be (0, 0.5)), device uniform = %f\n"),
+        fHostMean, fHostVar, fDeviceMean, fDeviceVar, fDeviceUniform);
+    if (appAbs(fHostMean) > accuracy * F(5.0) || appAbs(fHostVar - F(0.5)) > accuracy * F(5.0))
+    {
+        ++uiError;
+    }
+    if (appAbs(fDeviceMean) > accuracy * F(5.0) || appAbs(fDeviceVar - F(0.5)) > accuracy * F(5.0))
+    {
+        ++uiError;
+    }
+    if (appAbs(fDeviceUniform - F(0.5)) > accuracy * F(5.0))
+    {
+        ++uiError;
+    }
+    return uiError;
+}
+
+UINT TestRandomCounter(CParameters& sParam)
+{
+    UINT uiError = TestRandom(sParam);
+
+    //The numbers of a trajectory only depend on the trajectory
+    CRandom* pRandom = appGetLattice()->m_pRandom;
+    pRandom->SetTrajectory(5);
+    TArray<Real> firstRun;
+    for (INT i = 0; i < 16; ++i)
+    {
+        firstRun.AddItem(GetRandomReal());
+    }
+    pRandom->SetTrajectory(6);
+    GetRandomReal();
+    pRandom->SetTrajectory(5);
+    for (INT i = 0; i < 16; ++i)
+    {
+        if (firstRun[i] != GetRandomReal())
+        {
+            appGeneral(_T("------- Replay of trajectory failed at %d\n"), i);
+            ++uiError;
+            break;
+        }
+    }
+
+    //The device numbers only depend on (trajectory, launch, site, draw), there is no state on device
+    if (NULL != appGetLattice()->m_pGaugeField)
+    {
+        CFieldGauge* pFirst = dynamic_cast<CFieldGauge*>(appGetLattice()->m_pGaugeField->GetCopy());
+        CFieldGauge* pSecond = dynamic_cast<CFieldGauge*>(appGetLattice()->m_pGaugeField->GetCopy());
+        pRandom->SetTrajectory(5);
+        pFirst->MakeRandomGenerator();
+        pRandom->SetTrajectory(6);
+        pSecond->MakeRandomGenerator();
+        pSecond->MakeRandomGenerator();
+        pRandom->SetTrajectory(5);
+        pSecond->MakeRandomGenerator();
+        pSecond->AxpyMinus(pFirst);
+        const DOUBLE fDiff = pSecond->Dot(pSecond).x;
+        appGeneral(_T("------- Replay of device random, |difference|^2 = %f\n"), fDiff);
+        if (fDiff > 0.0)
+        {
+            ++uiError;
+        }
+        appSafeDelete(pFirst);
+        appSafeDelete(pSecond);
+    }
     return uiError;
 }
 
@@ -63,6 +169,8 @@ __REGIST_TEST(TestRandom, Random, TestRandomSOBOL32);
 
 __REGIST_TEST(TestRandom, Random, TestRandomScrambledSOBOL32);
 
+__REGIST_TEST(TestRandomCounter, Random, TestRandomPhiloxCounter);
+
 //=============================================================================
 // END OF FILE
 //=============================================================================
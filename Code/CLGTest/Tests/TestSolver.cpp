@@ -101,6 +101,545 @@ UINT TestSolver(CParameters& params)
     return uiError;
 }
 
+UINT TestOperatorFusion(CParameters& params)
+{
+    UINT uiError = 0;
+    Real fMaxError = F(0.00001);
+    params.FetchValueReal(_T("ExpectedErr"), fMaxError);
+
+    const CField* pGauge = appGetLattice()->m_pGaugeField;
+    const CField* pFermion = appGetLattice()->GetFieldById(2);
+    CField* pB = pFermion->GetCopy();
+    pB->ApplyOperator(EFO_F_D, pGauge);
+    CField* pFused = pFermion->GetCopy();
+    CField* pExpected = pFermion->GetCopy();
+
+    const EFieldOperator ops[4] = { EFO_F_D, EFO_F_Ddagger, EFO_F_DD, EFO_F_DDdagger };
+    for (INT i = 0; i < 4; ++i)
+    {
+        //y = b - 0.5 D x, and |y|^2
+        pFermion->CopyTo(pFused);
+        SOperatorFusion fusion1(EOF_BMinus | EOF_Norm, pB);
+        pFused->ApplyOperatorFused(ops[i], pGauge, fusion1, EOCT_Real, F(0.5));
+
+        pFermion->CopyTo(pExpected);
+        pExpected->ApplyOperator(ops[i], pGauge, EOCT_Real, F(-0.5));
+        pExpected->AxpyPlus(pB);
+        const Real fNorm1 = pExpected->DotReal(pExpected).x;
+        const Real fError1 = appAbs(static_cast<Real>(fusion1.m_fNorm) - fNorm1) / fNorm1;
+        pExpected->AxpyMinus(pFused);
+        const Real fError2 = pExpected->DotReal(pExpected).x / fNorm1;
+
+        //y = i D x, <x, y> and |y|^2
+        pFermion->CopyTo(pFused);
+        SOperatorFusion fusion2(EOF_DotSource | EOF_Norm);
+        pFused->ApplyOperatorFused(ops[i], pGauge, fusion2, EOCT_Complex, F(0.0), F(1.0));
+
+        pFermion->CopyTo(pExpected);
+        pExpected->ApplyOperator(ops[i], pGauge, EOCT_Complex, F(0.0), F(1.0));
+        const CLGComplex cDot = pFermion->DotReal(pExpected);
+        const Real fNorm2 = pExpected->DotReal(pExpected).x;
+#if !_CLG_DOUBLEFLOAT
+        const CLGComplex cFusedDot = _cToFloat(fusion2.m_cDot);
+#else
+        const CLGComplex cFusedDot = fusion2.m_cDot;
+#endif
+        const Real fError3 = _cuCabsf(_cuCsubf(cFusedDot, cDot)) / fNorm2;
+        const Real fError4 = appAbs(static_cast<Real>(fusion2.m_fNorm) - fNorm2) / fNorm2;
+        pExpected->AxpyMinus(pFused);
+        const Real fError5 = pExpected->DotReal(pExpected).x / fNorm2;
+
+        appGeneral(_T("%s: b - D x: |y|^2 error = %2.12f, y error = %2.12f\n"), __ENUM_TO_STRING(EFieldOperator, ops[i]).c_str(), fError1, fError2);
+        appGeneral(_T("%s: D x: <x,y> error = %2.12f, |y|^2 error = %2.12f, y error = %2.12f\n"), __ENUM_TO_STRING(EFieldOperator, ops[i]).c_str(), fError3, fError4, fError5);
+        if (fError1 > fMaxError || fError2 > fMaxError || fError3 > fMaxError || fError4 > fMaxError || fError5 > fMaxError)
+        {
+            ++uiError;
+        }
+    }
+
+    appSafeDelete(pB);
+    appSafeDelete(pFused);
+    appSafeDelete(pExpected);
+    return uiError;
+}
+
+UINT TestFieldExpression(CParameters& params)
+{
+    UINT uiError = 0;
+    Real fMaxError = F(0.00001);
+    params.FetchValueReal(_T("ExpectedErr"), fMaxError);
+
+    const CField* pGauge = appGetLattice()->m_pGaugeField;
+    const CField* pFermion = appGetLattice()->GetFieldById(2);
+    CField* pX = pFermion->GetCopy();
+    CField* pY = pFermion->GetCopy();
+    CField* pZ = pFermion->GetCopy();
+    pY->ApplyOperator(EFO_F_D, pGauge);
+    pZ->ApplyOperator(EFO_F_Ddagger, pGauge);
+    CField* pRes = pFermion->GetCopy();
+    CField* pExpected = pFermion->GetCopy();
+
+    const CLGComplex a = _make_cuComplex(F(0.3), F(-1.2));
+    const CLGComplex b = _make_cuComplex(F(-0.7), F(0.4));
+    const Real c = F(2.5);
+
+    //res = a x + b y - c z
+    appFieldAssign(pRes, a * appField(pX) + b * appField(pY) - c * appField(pZ));
+    pX->CopyTo(pExpected);
+    pExpected->ScalarMultply(a);
+    pExpected->Axpy(b, pY);
+    pExpected->Axpy(-c, pZ);
+    const Real fNorm1 = pExpected->DotReal(pExpected).x;
+    pExpected->AxpyMinus(pRes);
+    const Real fError1 = pExpected->DotReal(pExpected).x / fNorm1;
+
+    //x = b (y - a x) + x, x is on both sides
+    pX->CopyTo(pExpected);
+    pExpected->ScalarMultply(_cuCsubf(_make_cuComplex(F(1.0), F(0.0)), _cuCmulf(a, b)));
+    pExpected->Axpy(b, pY);
+    appFieldAssign(pX, b * (appField(pY) - a * appField(pX)) + appField(pX));
+    const Real fNorm2 = pExpected->DotReal(pExpected).x;
+    pExpected->AxpyMinus(pX);
+    const Real fError2 = pExpected->DotReal(pExpected).x / fNorm2;
+
+    appGeneral(_T("a x + b y - c z error = %2.12f, b (y - a x) + x error = %2.12f\n"), fError1, fError2);
+    if (fError1 > fMaxError || fError2 > fMaxError)
+    {
+        ++uiError;
+    }
+
+    //the momentum update of the integrators, P = P + e F, on the gauge fields
+    CFieldGauge* pP = dynamic_cast<CFieldGauge*>(pGauge->GetCopy());
+    CFieldGauge* pF = dynamic_cast<CFieldGauge*>(pGauge->GetCopy());
+    CFieldGauge* pPExpected = dynamic_cast<CFieldGauge*>(pGauge->GetCopy());
+    pF->MakeRandomGenerator();
+    pP->CopyTo(pPExpected);
+    pPExpected->Axpy(c, pF);
+    const UINT uiVersion = pP->GetVersion();
+    appFieldAssign(pP, appField(pP) + c * appField(pF));
+    const Real fNorm3 = pPExpected->DotReal(pPExpected).x;
+    pPExpected->AxpyMinus(pP);
+    const Real fError3 = pPExpected->DotReal(pPExpected).x / fNorm3;
+    appGeneral(_T("P + c F error = %2.12f, version %d -> %d\n"), fError3, uiVersion, pP->GetVersion());
+    if (fError3 > fMaxError || uiVersion == pP->GetVersion())
+    {
+        ++uiError;
+    }
+
+    appSafeDelete(pX);
+    appSafeDelete(pY);
+    appSafeDelete(pZ);
+    appSafeDelete(pRes);
+    appSafeDelete(pExpected);
+    appSafeDelete(pP);
+    appSafeDelete(pF);
+    appSafeDelete(pPExpected);
+    return uiError;
+}
+
+/**
+* The host reference of the staggered D on torus, the fermion is anti-periodic in t, the gauge field is periodic
+* N = 3 for SU3, N = 1 for U1, the links are stored with the phase U(n,mu) exp(i phase(n,mu))
+*/
+class CKSHostReference
+{
+public:
+
+    struct SMatrix
+    {
+        CLGComplex m_me[9];
+    };
+
+    CKSHostReference(const CLGComplex* pGauge, UINT uiGaugeStride, const CLGComplex* pFermion, UINT uiFermionStride, UINT uiN)
+        : m_uiN(uiN)
+    {
+        m_iL[0] = static_cast<INT>(_HC_Lx);
+        m_iL[1] = static_cast<INT>(_HC_Ly);
+        m_iL[2] = static_cast<INT>(_HC_Lz);
+        m_iL[3] = static_cast<INT>(_HC_Lt);
+        const UINT uiLinkCount = _HC_Volume * _HC_Dir;
+        m_lstU.AddSize(static_cast<INT>(uiLinkCount));
+        for (UINT uiLink = 0; uiLink < uiLinkCount; ++uiLink)
+        {
+            for (UINT i = 0; i < m_uiN * m_uiN; ++i)
+            {
+                m_lstU[uiLink].m_me[i] = pGauge[uiLink * uiGaugeStride + i];
+            }
+        }
+        m_lstPhi.AddSize(static_cast<INT>(_HC_Volume * m_uiN));
+        for (UINT uiSite = 0; uiSite < _HC_Volume; ++uiSite)
+        {
+            for (UINT i = 0; i < m_uiN; ++i)
+            {
+                m_lstPhi[uiSite * m_uiN + i] = pFermion[uiSite * uiFermionStride + i];
+            }
+        }
+    }
+
+    void MulPhase(UINT uiLink, Real fPhase)
+    {
+        const CLGComplex cPhase = _make_cuComplex(cos(fPhase), sin(fPhase));
+        for (UINT i = 0; i < m_uiN * m_uiN; ++i)
+        {
+            m_lstU[uiLink].m_me[i] = _cuCmulf(m_lstU[uiLink].m_me[i], cPhase);
+        }
+    }
+
+    /**
+    * The site index of n on torus, fSign = -1 when n is out of the lattice in t by an odd number of times
+    */
+    UINT Site(const INT* n, Real& fSign) const
+    {
+        INT wrapped[4];
+        fSign = F(1.0);
+        for (INT i = 0; i < 4; ++i)
+        {
+            wrapped[i] = ((n[i] % m_iL[i]) + m_iL[i]) % m_iL[i];
+            if (3 == i && (((n[i] - wrapped[i]) / m_iL[i]) & 1))
+            {
+                fSign = F(-1.0);
+            }
+        }
+        return static_cast<UINT>(wrapped[0] * _HC_MultX + wrapped[1] * _HC_MultY + wrapped[2] * _HC_MultZ + wrapped[3]);
+    }
+
+    static UBOOL EtaOdd(const INT* n, INT iDir)
+    {
+        INT iSum = 0;
+        for (INT i = 0; i < iDir; ++i)
+        {
+            iSum += n[i];
+        }
+        return 0 != (iSum & 1);
+    }
+
+    SMatrix Zero() const
+    {
+        SMatrix ret;
+        for (UINT i = 0; i < 9; ++i)
+        {
+            ret.m_me[i] = _make_cuComplex(F(0.0), F(0.0));
+        }
+        return ret;
+    }
+
+    SMatrix Mul(const SMatrix& a, const SMatrix& b) const
+    {
+        SMatrix ret = Zero();
+        for (UINT r = 0; r < m_uiN; ++r)
+        {
+            for (UINT c = 0; c < m_uiN; ++c)
+            {
+                for (UINT k = 0; k < m_uiN; ++k)
+                {
+                    ret.m_me[r * m_uiN + c] = _cuCaddf(ret.m_me[r * m_uiN + c], _cuCmulf(a.m_me[r * m_uiN + k], b.m_me[k * m_uiN + c]));
+                }
+            }
+        }
+        return ret;
+    }
+
+    /**
+    * One step of a path, iDir = mu + 1 for n -> n + mu, iDir = - mu - 1 for n -> n - mu, n is moved
+    */
+    SMatrix Step(INT* n, INT iDir) const
+    {
+        Real fSign = F(1.0);
+        if (iDir > 0)
+        {
+            const SMatrix& u = m_lstU[Site(n, fSign) * _HC_Dir + iDir - 1];
+            n[iDir - 1] = n[iDir - 1] + 1;
+            return u;
+        }
+        n[-iDir - 1] = n[-iDir - 1] - 1;
+        const SMatrix& u = m_lstU[Site(n, fSign) * _HC_Dir - iDir - 1];
+        SMatrix ret;
+        for (UINT r = 0; r < m_uiN; ++r)
+        {
+            for (UINT c = 0; c < m_uiN; ++c)
+            {
+                ret.m_me[r * m_uiN + c] = _cuConjf(u.m_me[c * m_uiN + r]);
+            }
+        }
+        return ret;
+    }
+
+    /**
+    * fFactor x the sum of the paths from n, each path has 3 steps
+    */
+    SMatrix SumPaths(const INT* n, const INT (*pPaths)[3], UINT uiCount, Real fFactor) const
+    {
+        SMatrix ret = Zero();
+        for (UINT uiPath = 0; uiPath < uiCount; ++uiPath)
+        {
+            INT site[4] = { n[0], n[1], n[2], n[3] };
+            SMatrix path = Step(site, pPaths[uiPath][0]);
+            path = Mul(path, Step(site, pPaths[uiPath][1]));
+            path = Mul(path, Step(site, pPaths[uiPath][2]));
+            for (UINT i = 0; i < m_uiN * m_uiN; ++i)
+            {
+                ret.m_me[i] = _cuCaddf(ret.m_me[i], Scale(path.m_me[i], fFactor));
+            }
+        }
+        return ret;
+    }
+
+    /**
+    * res(n) += fFactor U phi(target), target is n moved by the path
+    */
+    void AddHop(TArray<CLGComplex>& res, UINT uiSite, const SMatrix& u, const INT* target, Real fFactor) const
+    {
+        Real fSign = F(1.0);
+        const UINT uiTarget = Site(target, fSign);
+        for (UINT r = 0; r < m_uiN; ++r)
+        {
+            CLGComplex v = _make_cuComplex(F(0.0), F(0.0));
+            for (UINT k = 0; k < m_uiN; ++k)
+            {
+                v = _cuCaddf(v, _cuCmulf(u.m_me[r * m_uiN + k], m_lstPhi[uiTarget * m_uiN + k]));
+            }
+            res[uiSite * m_uiN + r] = _cuCaddf(res[uiSite * m_uiN + r], Scale(v, fFactor * fSign));
+        }
+    }
+
+    /**
+    * 2am phi(n) + (-) sum _mu eta_mu(n) (U_mu(n) phi(n+mu) - U^+_mu(n-mu) phi(n-mu))
+    */
+    void D(TArray<CLGComplex>& res, Real f2am, UBOOL bDagger) const
+    {
+        res.RemoveAll();
+        res.AddSize(m_lstPhi.Num());
+        for (INT i = 0; i < m_lstPhi.Num(); ++i)
+        {
+            res[i] = Scale(m_lstPhi[i], f2am);
+        }
+        for (UINT uiSite = 0; uiSite < _HC_Volume; ++uiSite)
+        {
+            const SSmallInt4 sSite4 = __hostSiteIndexToInt4(uiSite);
+            const INT n[4] = { sSite4.x, sSite4.y, sSite4.z, sSite4.w };
+            for (INT mu = 0; mu < 4; ++mu)
+            {
+                const Real fEta = (EtaOdd(n, mu) ? F(-1.0) : F(1.0)) * (bDagger ? F(-1.0) : F(1.0));
+                INT site[4] = { n[0], n[1], n[2], n[3] };
+                SMatrix u = Step(site, mu + 1);
+                AddHop(res, uiSite, u, site, fEta);
+                site[mu] = n[mu];
+                u = Step(site, -mu - 1);
+                AddHop(res, uiSite, u, site, -fEta);
+            }
+        }
+    }
+
+    /**
+    * The rotation terms, see _kernelDFermionKSRotationXYT and _kernelDFermionKSRotationXYTauT
+    */
+    void Rotation(TArray<CLGComplex>& res, Real fOmega, const SSmallInt4& sCenter, UBOOL bDagger) const
+    {
+        const Real fDagger = bDagger ? F(-1.0) : F(1.0);
+        for (UINT uiSite = 0; uiSite < _HC_Volume; ++uiSite)
+        {
+            const SSmallInt4 sSite4 = __hostSiteIndexToInt4(uiSite);
+            const INT n[4] = { sSite4.x, sSite4.y, sSite4.z, sSite4.w };
+
+            //x partial_y and y partial_x, from n to n +- 2 mu +- tau
+            for (UINT idx = 0; idx < 8; ++idx)
+            {
+                const UBOOL bPlusMu = 0 != (idx & 2);
+                const UBOOL bPlusTau = 0 != (idx & 4);
+                const INT iXorY = static_cast<INT>(idx & 1);
+                const INT iYorX = 1 - iXorY;
+                const INT iMu = bPlusMu ? (iYorX + 1) : (-iYorX - 1);
+                const INT iTau = bPlusTau ? 4 : -4;
+                INT target[4] = { n[0], n[1], n[2], n[3] };
+                target[iYorX] += bPlusMu ? 2 : -2;
+                target[3] += bPlusTau ? 1 : -1;
+                Real fSign = F(1.0);
+                const SSmallInt4 sTarget4 = __hostSiteIndexToInt4(Site(target, fSign));
+
+                //eta_tau, x partial_y is '-', -2mu is '-'
+                INT iEta = (bPlusTau ? (n[0] + n[1] + n[2]) : (sTarget4.x + sTarget4.y + sTarget4.z)) + iYorX;
+                if (!bPlusMu)
+                {
+                    ++iEta;
+                }
+
+                const INT paths[3][3] = { { iMu, iTau, iMu }, { iTau, iMu, iMu }, { iMu, iMu, iTau } };
+                const SMatrix v = SumPaths(n, paths, 3, F(1.0) / F(3.0));
+
+                const Real fCoord = static_cast<Real>(n[iXorY] - sCenter.m_byData4[iXorY]) + F(0.5);
+                AddHop(res, uiSite, v, target, ((iEta & 1) ? F(-1.0) : F(1.0)) * fCoord * F(0.25) * fOmega * fDagger);
+            }
+
+            //the polarization term, from n to n +- x +- y +- tau
+            for (UINT idx = 0; idx < 8; ++idx)
+            {
+                const UBOOL bPlusX = 0 != (idx & 1);
+                const UBOOL bPlusY = 0 != (idx & 2);
+                const UBOOL bPlusT = 0 != (idx & 4);
+                const INT iX = bPlusX ? 1 : -1;
+                const INT iY = bPlusY ? 2 : -2;
+                const INT iT = bPlusT ? 4 : -4;
+                const INT paths[6][3] = { { iX, iY, iT }, { iY, iX, iT }, { iX, iT, iY }, { iT, iX, iY }, { iY, iT, iX }, { iT, iY, iX } };
+                INT target[4] = { n[0] + (bPlusX ? 1 : -1), n[1] + (bPlusY ? 1 : -1), n[2], n[3] + (bPlusT ? 1 : -1) };
+                Real fSign = F(1.0);
+                const SSmallInt4 sTarget4 = __hostSiteIndexToInt4(Site(target, fSign));
+                const INT iEta = bPlusT ? (n[1] + n[2]) : (sTarget4.y + sTarget4.z + 1);
+                AddHop(res, uiSite, SumPaths(n, paths, 6, F(1.0) / F(6.0)), target, ((iEta & 1) ? F(-1.0) : F(1.0)) * F(0.125) * fOmega * fDagger);
+            }
+        }
+    }
+
+    static CLGComplex Scale(const CLGComplex& c, Real r)
+    {
+        return _make_cuComplex(c.x * r, c.y * r);
+    }
+
+    UINT m_uiN;
+    INT m_iL[4];
+    TArray<SMatrix> m_lstU;
+    TArray<CLGComplex> m_lstPhi;
+};
+
+/**
+* Compare the D of TFermionKSKernel.h with the host reference CKSHostReference
+*/
+UINT TestFermionKSTemplated(CParameters& params)
+{
+    UINT uiError = 0;
+    Real fMaxError = F(0.00001);
+    params.FetchValueReal(_T("ExpectedErr"), fMaxError);
+
+    //the rotating fermions read omega and center from CCommonData
+    Real fOmega = F(0.0);
+    if (params.FetchValueReal(_T("Omega"), fOmega))
+    {
+        CCommonData::m_fOmega = fOmega;
+    }
+    TArray<INT> centerArray;
+    params.FetchValueArrayINT(_T("Center"), centerArray);
+    if (centerArray.Num() > 3)
+    {
+        SSmallInt4 sCenter;
+        sCenter.x = static_cast<SCOORD>(centerArray[0] - _HC_XOrigin);
+        sCenter.y = static_cast<SCOORD>(centerArray[1]);
+        sCenter.z = static_cast<SCOORD>(centerArray[2]);
+        sCenter.w = static_cast<SCOORD>(centerArray[3]);
+        CCommonData::m_sCenter = sCenter;
+    }
+
+    const CField* pGauge = appGetLattice()->m_pGaugeField;
+    const CFieldFermionKS* pFermion = dynamic_cast<const CFieldFermionKS*>(appGetLattice()->GetFieldById(2));
+    if (NULL == pFermion)
+    {
+        appCrucial(_T("TestFermionKSTemplated: field 2 is not a staggered fermion!\n"));
+        return 1;
+    }
+
+    //the device data and the layout of the fields
+    const UBOOL bU1 = (NULL != dynamic_cast<const CFieldFermionKSU1*>(pFermion));
+    const UINT uiN = bU1 ? 1 : 3;
+    const UINT uiGaugeStride = bU1 ? 1 : static_cast<UINT>(sizeof(deviceSU3) / sizeof(CLGComplex));
+    const UINT uiFermionStride = bU1 ? 1 : static_cast<UINT>(sizeof(deviceSU3Vector) / sizeof(CLGComplex));
+    const void* pGaugeData = bU1
+        ? static_cast<const void*>(dynamic_cast<const CFieldGaugeU1*>(pGauge)->m_pDeviceData)
+        : static_cast<const void*>(dynamic_cast<const CFieldGaugeSU3*>(pGauge)->m_pDeviceData);
+    const void* pFermionData = bU1
+        ? static_cast<const void*>(dynamic_cast<const CFieldFermionKSU1*>(pFermion)->m_pDeviceData)
+        : static_cast<const void*>(dynamic_cast<const CFieldFermionKSSU3*>(pFermion)->m_pDeviceData);
+
+    TArray<CLGComplex> hostGauge;
+    TArray<CLGComplex> hostFermion;
+    hostGauge.AddSize(static_cast<INT>(_HC_Volume * _HC_Dir * uiGaugeStride));
+    hostFermion.AddSize(static_cast<INT>(_HC_Volume * uiFermionStride));
+    checkCudaErrors(cudaMemcpy(hostGauge.GetData(), pGaugeData, sizeof(CLGComplex) * hostGauge.Num(), cudaMemcpyDeviceToHost));
+    checkCudaErrors(cudaMemcpy(hostFermion.GetData(), pFermionData, sizeof(CLGComplex) * hostFermion.Num(), cudaMemcpyDeviceToHost));
+    CKSHostReference reference(hostGauge.GetData(), uiGaugeStride, hostFermion.GetData(), uiFermionStride, uiN);
+
+    //the phases
+    const CFieldFermionKSSU3EM* pEM = dynamic_cast<const CFieldFermionKSSU3EM*>(pFermion);
+    const CFieldFermionKSSU3GammaEM* pGammaEM = dynamic_cast<const CFieldFermionKSSU3GammaEM*>(pFermion);
+    const CFieldFermionKSSU3REM* pREM = dynamic_cast<const CFieldFermionKSSU3REM*>(pFermion);
+    if (NULL != pEM)
+    {
+        //qBz: u_y = exp(i qBz x), u_x(L_x) = exp(-i qBz Lx y), qEz: u_t = exp(- i qEz z), u_z(L_z) = exp(i qEz Lz t)
+        const Real fqEz = CCommonData::m_fEz * pEM->GetQ();
+        const Real fqBz = CCommonData::m_fBz * pEM->GetQ();
+        const SSmallInt4 sCenter = CCommonData::m_sCenter;
+        for (UINT uiSite = 0; uiSite < _HC_Volume; ++uiSite)
+        {
+            const SSmallInt4 sSite4 = __hostSiteIndexToInt4(uiSite);
+            if (sSite4.x == static_cast<INT>(_HC_Lx) - 1)
+            {
+                reference.MulPhase(uiSite * _HC_Dir, -static_cast<Real>(sSite4.y - sCenter.y) * _HC_Lx * fqBz);
+            }
+            reference.MulPhase(uiSite * _HC_Dir + 1, static_cast<Real>(sSite4.x - sCenter.x) * fqBz);
+            if (sSite4.z == static_cast<INT>(_HC_Lz) - 1)
+            {
+                reference.MulPhase(uiSite * _HC_Dir + 2, static_cast<Real>(sSite4.w - sCenter.w) * _HC_Lz * fqEz);
+            }
+            reference.MulPhase(uiSite * _HC_Dir + 3, -static_cast<Real>(sSite4.z - sCenter.z) * fqEz);
+        }
+    }
+    if (NULL != pGammaEM || NULL != pREM)
+    {
+        const BYTE byEMFieldId = (NULL != pGammaEM) ? pGammaEM->m_byEMFieldID : pREM->m_byEMFieldID;
+        const Real fCharge = (NULL != pGammaEM) ? pGammaEM->m_fCharge : pREM->m_fQ;
+        const CFieldGaugeU1Real* pU1 = dynamic_cast<const CFieldGaugeU1Real*>(appGetLattice()->GetFieldById(byEMFieldId));
+        TArray<Real> hostU1;
+        hostU1.AddSize(static_cast<INT>(_HC_Volume * _HC_Dir));
+        checkCudaErrors(cudaMemcpy(hostU1.GetData(), pU1->m_pDeviceData, sizeof(Real) * hostU1.Num(), cudaMemcpyDeviceToHost));
+        for (INT i = 0; i < hostU1.Num(); ++i)
+        {
+            reference.MulPhase(static_cast<UINT>(i), hostU1[i] * fCharge);
+        }
+    }
+    const UBOOL bRotation = (NULL != pREM)
+        || (NULL != dynamic_cast<const CFieldFermionKSSU3R*>(pFermion))
+        || (NULL != dynamic_cast<const CFieldFermionKSU1R*>(pFermion));
+
+    CFieldFermionKS* pLibrary = dynamic_cast<CFieldFermionKS*>(pFermion->GetCopy());
+    const void* pLibraryData = bU1
+        ? static_cast<const void*>(dynamic_cast<const CFieldFermionKSU1*>(pLibrary)->m_pDeviceData)
+        : static_cast<const void*>(dynamic_cast<const CFieldFermionKSSU3*>(pLibrary)->m_pDeviceData);
+    const EFieldOperator ops[2] = { EFO_F_D, EFO_F_Ddagger };
+    for (INT i = 0; i < 2; ++i)
+    {
+        pFermion->CopyTo(pLibrary);
+        pLibrary->ApplyOperator(ops[i], pGauge);
+        checkCudaErrors(cudaMemcpy(hostFermion.GetData(), pLibraryData, sizeof(CLGComplex) * hostFermion.Num(), cudaMemcpyDeviceToHost));
+
+        TArray<CLGComplex> expected;
+        reference.D(expected, pFermion->m_f2am, EFO_F_Ddagger == ops[i]);
+        if (bRotation)
+        {
+            reference.Rotation(expected, static_cast<Real>(CCommonData::m_fOmega), CCommonData::m_sCenter, EFO_F_Ddagger == ops[i]);
+        }
+
+        DOUBLE fNorm = 0.0;
+        DOUBLE fDiff = 0.0;
+        for (UINT uiSite = 0; uiSite < _HC_Volume; ++uiSite)
+        {
+            for (UINT k = 0; k < uiN; ++k)
+            {
+                const CLGComplex& cExpected = expected[uiSite * uiN + k];
+                const CLGComplex cDiff = _cuCsubf(hostFermion[uiSite * uiFermionStride + k], cExpected);
+                fNorm += cExpected.x * cExpected.x + cExpected.y * cExpected.y;
+                fDiff += cDiff.x * cDiff.x + cDiff.y * cDiff.y;
+            }
+        }
+        const Real fError = static_cast<Real>(fDiff / fNorm);
+
+        appGeneral(_T("%s: |D - D_host|^2 / |D_host|^2 = %2.12f\n"), __ENUM_TO_STRING(EFieldOperator, ops[i]).c_str(), fError);
+        if (fError > fMaxError)
+        {
+            ++uiError;
+        }
+    }
+
+    appSafeDelete(pLibrary);
+    return uiError;
+}
+
 __REGIST_TEST(TestSolver, Solver, TestSolverBiCGStab);
 
 __REGIST_TEST(TestSolver, Solver, TestSolverGMRES);
@@ -134,6 +673,28 @@ __REGIST_TEST(TestSolver, Solver, TestEOSolverBiCGStabDR);
 
 __REGIST_TEST(TestSolver, Solver, TestEOSolverGMRESDR);
 
+__REGIST_TEST(TestOperatorFusion, Solver, TestOperatorFusion);
+
+__REGIST_TEST(TestOperatorFusion, Solver, TestOperatorFusionKS);
+
+__REGIST_TEST(TestFieldExpression, Solver, TestFieldExpression);
+
+__REGIST_TEST(TestFieldExpression, Solver, TestFieldExpressionKS);
+
+__REGIST_TEST(TestFermionKSTemplated, Solver, TestFermionKSTemplatedSU3);
+
+__REGIST_TEST(TestFermionKSTemplated, Solver, TestFermionKSTemplatedU1);
+
+__REGIST_TEST(TestFermionKSTemplated, Solver, TestFermionKSTemplatedEM);
+
+__REGIST_TEST(TestFermionKSTemplated, Solver, TestFermionKSTemplatedChemical);
+
+__REGIST_TEST(TestFermionKSTemplated, Solver, TestFermionKSTemplatedR);
+
+__REGIST_TEST(TestFermionKSTemplated, Solver, TestFermionKSTemplatedU1R);
+
+__REGIST_TEST(TestFermionKSTemplated, Solver, TestFermionKSTemplatedREM);
+
 //=============================================================================
 // END OF FILE
 //=============================================================================
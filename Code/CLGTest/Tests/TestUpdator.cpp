@@ -65,10 +65,187 @@ __REGIST_TEST(TestUpdator, Updator, TestUpdatorLeapFrog);
 
 __REGIST_TEST(TestUpdator, Updator, TestUpdatorOmelyan);
 
+__REGIST_TEST(TestUpdator, Updator, TestUpdatorOmelyanTune);
+
 __REGIST_TEST(TestUpdator, Updator, TestUpdatorForceGradient);
 
 __REGIST_TEST(TestUpdator, Updator, TestUpdatorForceGradient3D);
 
+__REGIST_TEST(TestUpdator, Updator, TestUpdatorHeatbath);
+
+__REGIST_TEST(TestUpdator, Updator, TestUpdatorHeatbathU1);
+
+UINT TestUpdatorCheckpoint(CParameters& sParam)
+{
+    CHMC* pHMC = dynamic_cast<CHMC*>(appGetLattice()->m_pUpdator);
+    if (NULL == pHMC)
+    {
+        return 1;
+    }
+    CCString sFileName = _T("TestUpdatorCheckpoint.chk");
+    sParam.FetchStringValue(_T("CheckpointFile"), sFileName);
+
+    CMeasurePlaqutteEnergy* pMeasure = dynamic_cast<CMeasurePlaqutteEnergy*>(appGetLattice()->m_pMeasurements->GetMeasureById(1));
+    if (NULL == pMeasure)
+    {
+        return 1;
+    }
+
+    //checkpoint is written at the end of Update
+    pHMC->SetCheckpoint(TRUE, sFileName);
+    pHMC->Update(3, TRUE);
+    pHMC->SetCheckpoint(FALSE, sFileName);
+
+    pHMC->Update(3, TRUE);
+    const DOUBLE fFirst = static_cast<DOUBLE>(appGetLattice()->m_pGaugeField->CalculatePlaqutteEnergy(F(1.0)));
+    const UINT uiFirstAccept = pHMC->GetConfigurationCount();
+    const INT iFirstMeasureCount = pMeasure->m_lstData.Num();
+    const Real fFirstMeasure = pMeasure->m_fLastRealResult;
+    const UINT uiFirstStep = pHMC->m_pIntegrator->GetStepCount();
+    const Real fFirstStepLength = pHMC->m_pIntegrator->GetStepLength();
+
+    if (!pHMC->Resume(sFileName))
+    {
+        return 1;
+    }
+    pHMC->Update(3, TRUE);
+    const DOUBLE fSecond = static_cast<DOUBLE>(appGetLattice()->m_pGaugeField->CalculatePlaqutteEnergy(F(1.0)));
+    const UINT uiSecondAccept = pHMC->GetConfigurationCount();
+    const INT iSecondMeasureCount = pMeasure->m_lstData.Num();
+    const Real fSecondMeasure = pMeasure->m_fLastRealResult;
+    const UINT uiSecondStep = pHMC->m_pIntegrator->GetStepCount();
+    const Real fSecondStepLength = pHMC->m_pIntegrator->GetStepLength();
+
+    appGeneral(_T("plaquette energy : %2.18f, resumed : %2.18f, accepted : %d, resumed : %d\n"), fFirst, fSecond, uiFirstAccept, uiSecondAccept);
+    appGeneral(_T("measured : %d (%2.12f), resumed : %d (%2.12f), step : %d (%f), resumed : %d (%f)\n"),
+        iFirstMeasureCount, fFirstMeasure, iSecondMeasureCount, fSecondMeasure,
+        uiFirstStep, fFirstStepLength, uiSecondStep, fSecondStepLength);
+    UINT uiError = 0;
+    if (fFirst != fSecond)
+    {
+        ++uiError;
+    }
+    if (uiFirstAccept != uiSecondAccept)
+    {
+        ++uiError;
+    }
+    //the measures before the checkpoint are restored
+    if (iFirstMeasureCount != iSecondMeasureCount || fFirstMeasure != fSecondMeasure)
+    {
+        ++uiError;
+    }
+    if (uiFirstStep != uiSecondStep || appAbs(fFirstStepLength - fSecondStepLength) > F(0.000001))
+    {
+        ++uiError;
+    }
+    return uiError;
+}
+
+__REGIST_TEST(TestUpdatorCheckpoint, Updator, TestUpdatorCheckpoint);
+
+UINT TestIntegratorTuner(CParameters& sParam)
+{
+    CHMC* pHMC = dynamic_cast<CHMC*>(appGetLattice()->m_pUpdator);
+    if (NULL == pHMC || NULL == pHMC->GetTuner())
+    {
+        return 1;
+    }
+
+    //The shadow Hamiltonian error of Omelyan is alpha {S,{S,T}} + beta {T,{S,T}} with
+    //alpha = (6 lambda^2 - 6 lambda + 1) / 12, beta = (1 - 6 lambda) / 24.
+    //0.1932 minimizes alpha^2 + beta^2, i.e. both brackets weighted equally.
+    //If {T,{S,T}} is negligible the optimum cancels alpha, lambda = (3 - sqrt(3)) / 6 = 0.2113,
+    //if {S,{S,T}} is negligible it cancels beta, lambda = 1 / 6.
+    //With <{S,{S,T}} {T,{S,T}}> >= 0 the tuned lambda is in between, 2 lambda in [0.3333, 0.4226]
+    Real fExpected2Lambda = F(0.378);
+    Real fTolerance = F(0.047);
+    Real fRatioTolerance = F(3.0);
+    INT iTrajectory = 30;
+    sParam.FetchValueReal(_T("Expected2Lambda"), fExpected2Lambda);
+    sParam.FetchValueReal(_T("Expected2LambdaTolerance"), fTolerance);
+    sParam.FetchValueReal(_T("ExpectedDHRatio"), fRatioTolerance);
+    sParam.FetchValueINT(_T("Trajectory"), iTrajectory);
+
+    //thermalize before the tuning rounds end
+    pHMC->Update(static_cast<UINT>(iTrajectory), FALSE);
+
+    UINT uiError = 0;
+    const CIntegratorTuner* pTuner = pHMC->GetTuner();
+    if (pTuner->IsTuning())
+    {
+        appGeneral(_T("Tuner is not finished after %d trajectories\n"), iTrajectory);
+        ++uiError;
+    }
+
+    const Real f2Lambda = pHMC->m_pIntegrator->GetOmelyan2Lambda();
+    appGeneral(_T("tuned 2 lambda : %f, expected : %f +- %f\n"), f2Lambda, fExpected2Lambda, fTolerance);
+    if (pHMC->m_pIntegrator->HasOmelyanLambda() && appAbs(f2Lambda - fExpected2Lambda) > fTolerance)
+    {
+        ++uiError;
+    }
+
+    //the model is normalized by measured <dH> in each round, the prediction is checked using the next round
+    const DOUBLE fRatio = pTuner->GetPredictionRatio();
+    appGeneral(_T("measured <dH> / predicted <dH> : %f, expected in [%f, %f]\n"), fRatio, F(1.0) / fRatioTolerance, fRatioTolerance);
+    if (fRatio < 0.0 || fRatio * fRatioTolerance < 1.0 || fRatio > fRatioTolerance)
+    {
+        ++uiError;
+    }
+
+    return uiError;
+}
+
+__REGIST_TEST(TestIntegratorTuner, Updator, TestIntegratorTuner);
+
+__REGIST_TEST(TestIntegratorTuner, Updator, TestIntegratorTunerForceGradient);
+
+UINT TestEnsembleScheduler(CParameters& sParam)
+{
+    CEnsembleScheduler scheduler;
+    scheduler.Initial(sParam);
+    if (2 != scheduler.GetChainCount())
+    {
+        return 1;
+    }
+    scheduler.Run();
+
+    //run the first chain alone, the result should be same as the interleaved one
+    CParameters chain1 = sParam.GetParameter(_T("Chain1"));
+    INT iTrajectories = 0;
+    chain1.FetchValueINT(_T("Trajectories"), iTrajectories);
+    CLatticeContext* pCurrent = appGetLatticeContext();
+    CLatticeContext* pAlone = appCreateLatticeContext(chain1);
+    appGetLattice()->m_pUpdator->Update(static_cast<UINT>(iTrajectories), FALSE);
+    const DOUBLE fAlone = static_cast<DOUBLE>(appGetLattice()->m_pGaugeField->CalculatePlaqutteEnergy(F(1.0)));
+    const UINT uiAloneAccept = appGetLattice()->m_pUpdator->GetConfigurationCount();
+
+    appSetLatticeContext(scheduler.GetContext(0));
+    const DOUBLE fInterleaved = static_cast<DOUBLE>(appGetLattice()->m_pGaugeField->CalculatePlaqutteEnergy(F(1.0)));
+    const UINT uiInterleavedAccept = appGetLattice()->m_pUpdator->GetConfigurationCount();
+
+    appGeneral(_T("plaquette energy : %2.18f, interleaved : %2.18f, accepted : %d, interleaved : %d\n"), fAlone, fInterleaved, uiAloneAccept, uiInterleavedAccept);
+    UINT uiError = 0;
+    if (fAlone != fInterleaved)
+    {
+        ++uiError;
+    }
+    if (uiAloneAccept != uiInterleavedAccept)
+    {
+        ++uiError;
+    }
+    if (static_cast<UINT>(iTrajectories) != scheduler.GetFinishedTrajectories(0))
+    {
+        ++uiError;
+    }
+
+    appReleaseLatticeContext(pAlone);
+    scheduler.Release();
+    appSetLatticeContext(pCurrent);
+    return uiError;
+}
+
+__REGIST_TEST(TestEnsembleScheduler, Updator, TestEnsembleScheduler);
+
 
 UINT TestWilsonLoop(CParameters& sParam)
 {
@@ -129,6 +306,233 @@ UINT TestWilsonLoop(CParameters& sParam)
 
 __REGIST_TEST(TestWilsonLoop, Updator, TestWilsonLoop);
 
+UINT TestGaugePathTable(CParameters& sParam)
+{
+    UINT uiError = 0;
+    CActionGaugePlaquette* pPlaqutte = dynamic_cast<CActionGaugePlaquette*>(appGetLattice()->GetActionById(1));
+    CActionGaugePathTable* pTable = dynamic_cast<CActionGaugePathTable*>(appGetLattice()->GetActionById(2));
+    if (NULL == pPlaqutte || NULL == pTable)
+    {
+        return 1;
+    }
+
+    //6 plaquttes and 12 rectangles per site in 4D
+    CGaugePathTable rectangles;
+    TArray<INT> rectangle;
+    rectangle.AddItem(1);
+    rectangle.AddItem(1);
+    rectangle.AddItem(2);
+    rectangle.AddItem(-1);
+    rectangle.AddItem(-1);
+    rectangle.AddItem(-2);
+    rectangles.AddSymmetricLoops(rectangle, F(1.0));
+    appGeneral(_T("plaqutte count = %d (6), rectangle count = %d (12)\n"), pTable->m_cTable.GetLoopCount(), rectangles.GetLoopCount());
+    if (6 != pTable->m_cTable.GetLoopCount() || 12 != rectangles.GetLoopCount())
+    {
+        ++uiError;
+    }
+
+    CFieldGauge* pGauge = appGetLattice()->m_pGaugeField;
+    const DOUBLE fEnergy1 = static_cast<DOUBLE>(pPlaqutte->Energy(FALSE, pGauge));
+    const DOUBLE fEnergy2 = static_cast<DOUBLE>(pTable->Energy(FALSE, pGauge));
+    appGeneral(_T("Energy plaqutte = %f, path table = %f\n"), fEnergy1, fEnergy2);
+    if (appAbs(fEnergy1 - fEnergy2) > F(0.0001) * appAbs(fEnergy1))
+    {
+        ++uiError;
+    }
+
+    CFieldGauge* pForce1 = dynamic_cast<CFieldGauge*>(pGauge->GetCopy());
+    CFieldGauge* pForce2 = dynamic_cast<CFieldGauge*>(pGauge->GetCopy());
+    CFieldGauge* pStaple = dynamic_cast<CFieldGauge*>(pGauge->GetCopy());
+    pForce1->Zero();
+    pForce2->Zero();
+    pPlaqutte->CalculateForceOnGauge(pGauge, pForce1, pStaple, ESP_Once);
+    pTable->CalculateForceOnGauge(pGauge, pForce2, NULL, ESP_Once);
+    const DOUBLE fForce = cuCabs(pForce1->Dot(pForce1));
+    pForce1->AxpyMinus(pForce2);
+    const DOUBLE fDiff = cuCabs(pForce1->Dot(pForce1));
+    appGeneral(_T("Force |F|^2 = %f, |F1 - F2|^2 = %2.12f\n"), fForce, fDiff);
+    if (fDiff > F(0.000001) * fForce)
+    {
+        ++uiError;
+    }
+
+    appSafeDelete(pForce1);
+    appSafeDelete(pForce2);
+    appSafeDelete(pStaple);
+    return uiError;
+}
+
+__REGIST_TEST(TestGaugePathTable, Updator, TestGaugePathTable);
+
+/**
+* The actions using CGaugePathTable, the energy and the force are consistent if the H diff is O(epsilon^2),
+* so it should be 1/4 when the step count is doubled
+*/
+UINT TestGaugePathTableMigrated(CParameters& sParam)
+{
+    Real fExpectedRatio = F(2.0);
+    Real fHdiff = F(0.3);
+    INT iTrajectory = 5;
+    sParam.FetchValueReal(_T("ExpectedRatio"), fExpectedRatio);
+    sParam.FetchValueReal(_T("ExpectedHdiff"), fHdiff);
+    sParam.FetchValueINT(_T("Trajectory"), iTrajectory);
+
+    CHMC* pHMC = dynamic_cast<CHMC*>(appGetLattice()->m_pUpdator);
+    if (NULL == pHMC || NULL == pHMC->m_pIntegrator)
+    {
+        return 1;
+    }
+
+    pHMC->SetAutoCorrection(FALSE);
+    pHMC->Update(3, FALSE);
+    pHMC->SetTestHdiff(TRUE);
+
+    CFieldGauge* pStart = dynamic_cast<CFieldGauge*>(appGetLattice()->m_pGaugeField->GetCopy());
+    TArray<UINT> steps;
+    pHMC->m_pIntegrator->GetLevelSteps(steps);
+
+    pHMC->ClearHDiff();
+    pHMC->Update(static_cast<UINT>(iTrajectory), FALSE);
+    const Real fHdiff1 = pHMC->GetHDiff();
+
+    pStart->CopyTo(appGetLattice()->m_pGaugeField);
+    for (INT i = 0; i < steps.Num(); ++i)
+    {
+        steps[i] = steps[i] * 2;
+    }
+    pHMC->m_pIntegrator->SetLevelSteps(steps);
+    pHMC->ClearHDiff();
+    pHMC->Update(static_cast<UINT>(iTrajectory), FALSE);
+    const Real fHdiff2 = pHMC->GetHDiff();
+    appSafeDelete(pStart);
+
+    const Real fRatio = fHdiff1 / fHdiff2;
+    appGeneral(_T("HDiff : %f, doubled steps : %f, ratio : %f (expected about 4 and > %f)\n"), fHdiff1, fHdiff2, fRatio, fExpectedRatio);
+
+    UINT uiError = 0;
+    if (fRatio < fExpectedRatio)
+    {
+        ++uiError;
+    }
+    if (fHdiff1 > fHdiff)
+    {
+        ++uiError;
+    }
+    return uiError;
+}
+
+__REGIST_TEST(TestGaugePathTableMigrated, Updator, TestGaugePathTableRotating);
+__REGIST_TEST(TestGaugePathTableMigrated, Updator, TestGaugePathTableAcceleration);
+__REGIST_TEST(TestGaugePathTableMigrated, Updator, TestGaugePathTableBoost);
+__REGIST_TEST(TestGaugePathTableMigrated, Updator, TestGaugePathTableBetaGradient);
+__REGIST_TEST(TestGaugePathTableMigrated, Updator, TestGaugePathTableRotatingU1);
+__REGIST_TEST(TestGaugePathTableMigrated, Updator, TestRotatingU1AngleShifted);
+
+UINT TestU1Angle(CParameters& sParam)
+{
+    UINT uiError = 0;
+    CFieldGaugeU1Angle* pGauge = dynamic_cast<CFieldGaugeU1Angle*>(appGetLattice()->m_pGaugeField);
+    if (NULL == pGauge)
+    {
+        return 1;
+    }
+
+    //compare with the complex U1 on the same configuration
+    CFieldGaugeU1* pU1 = new CFieldGaugeU1();
+    pU1->InitialField(EFIT_Random);
+    pGauge->InitialWithU1(pU1);
+
+    const DOUBLE fEnergy1 = static_cast<DOUBLE>(pU1->CalculatePlaqutteEnergy(F(1.0)));
+    const DOUBLE fEnergy2 = static_cast<DOUBLE>(pGauge->CalculatePlaqutteEnergy(F(1.0)));
+    appGeneral(_T("Energy U1 = %f, angle = %f\n"), fEnergy1, fEnergy2);
+    if (appAbs(fEnergy1 - fEnergy2) > F(0.0001) * appAbs(fEnergy1))
+    {
+        ++uiError;
+    }
+
+    CFieldGaugeU1* pForce1 = dynamic_cast<CFieldGaugeU1*>(pU1->GetCopy());
+    CFieldGaugeU1* pStaple1 = dynamic_cast<CFieldGaugeU1*>(pU1->GetCopy());
+    CFieldGaugeU1Angle* pForce2 = dynamic_cast<CFieldGaugeU1Angle*>(pGauge->GetCopy());
+    CFieldGaugeU1Angle* pStaple2 = dynamic_cast<CFieldGaugeU1Angle*>(pGauge->GetCopy());
+    pForce1->Zero();
+    pForce2->Zero();
+    pU1->CalculateForceAndStaple(pForce1, pStaple1, F(1.0));
+    pGauge->CalculateForceAndStaple(pForce2, pStaple2, F(1.0));
+    const DOUBLE fForce1 = cuCabs(pForce1->Dot(pForce1));
+    const DOUBLE fForce2 = cuCabs(pForce2->Dot(pForce2));
+    appGeneral(_T("Force |F|^2 U1 = %f, angle = %f\n"), fForce1, fForce2);
+    if (appAbs(fForce1 - fForce2) > F(0.0001) * fForce1)
+    {
+        ++uiError;
+    }
+
+    //site by site, the force of U1 is i F
+    CFieldGaugeU1Angle* pForce3 = dynamic_cast<CFieldGaugeU1Angle*>(pGauge->GetCopy());
+    pForce3->Zero();
+    checkCudaErrors(cudaMemcpy(pForce3->PrepareU1Force(), pForce1->m_pDeviceData, sizeof(CLGComplex) * _HC_LinkCount, cudaMemcpyDeviceToDevice));
+    pForce3->AcceptU1Force();
+    pForce3->AxpyMinus(pForce2);
+    const DOUBLE fForceDiff = cuCabs(pForce3->Dot(pForce3));
+    appGeneral(_T("Force |F(U1) - F(angle)|^2 = %2.12f\n"), fForceDiff);
+    if (fForceDiff > F(0.00000001) * fForce1)
+    {
+        ++uiError;
+    }
+
+    //staggered fermion on the angles uses the cached exp(i theta)
+    CFieldFermionKSU1* pFermion = dynamic_cast<CFieldFermionKSU1*>(appGetLattice()->GetFieldById(2));
+    CFieldFermionKSU1* pFermion1 = dynamic_cast<CFieldFermionKSU1*>(pFermion->GetCopy());
+    CFieldFermionKSU1* pFermion2 = dynamic_cast<CFieldFermionKSU1*>(pFermion->GetCopy());
+    pFermion1->D(pU1);
+    pFermion2->D(pGauge);
+    pFermion2->AxpyMinus(pFermion1);
+    const DOUBLE fFermionDiff = cuCabs(pFermion2->Dot(pFermion2));
+    const DOUBLE fFermion = cuCabs(pFermion1->Dot(pFermion1));
+    appGeneral(_T("|D(U1) phi - D(angle) phi|^2 = %2.12f, |D phi|^2 = %f\n"), fFermionDiff, fFermion);
+    if (fFermionDiff > F(0.00000001) * fFermion)
+    {
+        ++uiError;
+    }
+
+    const DOUBLE fEnergy3 = static_cast<DOUBLE>(pGauge->CalculatePlaqutteEnergyUsingStable(F(1.0), pStaple2));
+    appGeneral(_T("Energy using staple = %f, expected = %f\n"), fEnergy3, fEnergy2);
+    if (appAbs(fEnergy3 - fEnergy2) > F(0.0001) * appAbs(fEnergy2))
+    {
+        ++uiError;
+    }
+
+    appSafeDelete(pU1);
+    appSafeDelete(pForce1);
+    appSafeDelete(pStaple1);
+    appSafeDelete(pForce2);
+    appSafeDelete(pStaple2);
+    appSafeDelete(pForce3);
+    appSafeDelete(pFermion1);
+    appSafeDelete(pFermion2);
+
+    //HMC on the angles
+    appGetLattice()->m_pUpdator->Update(10, FALSE);
+    appGetLattice()->m_pUpdator->SetTestHdiff(TRUE);
+    appGetLattice()->m_pUpdator->Update(20, TRUE);
+
+    const UINT uiAccept = appGetLattice()->m_pUpdator->GetConfigurationCount();
+    const Real fHDiff = static_cast<Real>(appGetLattice()->m_pUpdator->GetHDiff());
+    appGeneral(_T("accept (%d/30) : expected >= 27. HDiff = %f : expected < 0.1\n"), uiAccept, fHDiff);
+    if (uiAccept < 27)
+    {
+        ++uiError;
+    }
+    if (fHDiff > F(0.1))
+    {
+        ++uiError;
+    }
+
+    return uiError;
+}
+
+__REGIST_TEST(TestU1Angle, Updator, TestU1Angle);
+
 //=============================================================================
 // END OF FILE
 //=============================================================================
@@ -101,6 +101,11 @@ namespace CLGMakeWriter
             sContent += "  add_definitions(-D_CLG_DOUBLEFLOAT=0)\n";
             sContent += "  MESSAGE(\"Note: double float is disabled, arch is ${CUDA_CMP} and ${CUDA_SM}.\")\n";
             sContent += "endif()\n";
+            sContent += "# to use 16-bit coordinates for the lattice lengths larger than 126 (and run TestLargeLattice):\n";
+            sContent += "if (DEFINED CLGLARGELATTICE)\n";
+            sContent += "  add_definitions(-D_CLG_LARGE_LATTICE=1)\n";
+            sContent += "  MESSAGE(\"Note: large lattice is enabled, the coordinates are 16-bit.\")\n";
+            sContent += "endif()\n";
 
             sContent += "MESSAGE(\"CMAKE_CUDA_FLAGS flag = ${CMAKE_CUDA_FLAGS}\")\n";
             sContent += "MESSAGE(\"CMAKE_CXX_FLAGS flag = ${CMAKE_CXX_FLAGS}\")\n\n";
@@ -167,6 +172,30 @@ set_target_properties( CLGLib
 
             #endregion
 
+            #region Add CLGBench
+
+            CProjFile clgBench = excutables["CLGBench"];
+
+            sContent += "\n\n\n# ==================== \n# CLGBench \n# =================\n\n";
+
+            sContent += "include_directories(${PROJECT_SOURCE_DIR}/CLGBench)\n";
+
+            sContent += "add_executable(CLGBench \n    ";
+            foreach (string sFileName in clgBench.m_lstAllHeaderFiles)
+            {
+                sContent += "${PROJECT_SOURCE_DIR}/CLGBench/" + sFileName + "\n    ";
+            }
+            foreach (string sFileName in clgBench.m_lstAllCppFiles)
+            {
+                sContent += "${PROJECT_SOURCE_DIR}/CLGBench/" + sFileName + "\n    ";
+            }
+            sContent += ")\n\n";
+
+            sContent += "target_compile_features(CLGBench PUBLIC cxx_std_14)\n";
+            sContent += "target_link_libraries(CLGBench CLGLib)\n";
+
+            #endregion
+
             #region Add Applications
 
             if (m_bHasWilsonDiracRotation)
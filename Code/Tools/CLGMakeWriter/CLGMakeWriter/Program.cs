@@ -28,11 +28,15 @@ namespace CLGMakeWriter
             string projCLGTestFilePath = Path.Combine(new[] { System.AppDomain.CurrentDomain.BaseDirectory, "../../../../../../CLGTest/CLGTest.vcxproj" });
             string projCLGTestFilterPath = Path.Combine(new[] { System.AppDomain.CurrentDomain.BaseDirectory, "../../../../../../CLGTest/CLGTest.vcxproj.filters" });
 
+            string projCLGBenchPath = Path.Combine(new[] { System.AppDomain.CurrentDomain.BaseDirectory, "../../../../../../CLGBench" });
+            string projCLGBenchFilePath = Path.Combine(new[] { System.AppDomain.CurrentDomain.BaseDirectory, "../../../../../../CLGBench/CLGBench.vcxproj" });
+
             if (!File.Exists(projSolFilePath)
              || !File.Exists(projCLGLibFilePath)
              || !File.Exists(projCLGLibFilterPath)
              || !File.Exists(projCLGTestFilePath)
-             || !File.Exists(projCLGTestFilterPath))
+             || !File.Exists(projCLGTestFilterPath)
+             || !File.Exists(projCLGBenchFilePath))
             {
                 Console.WriteLine("Failed...path incorrect...");
                 return;
@@ -47,6 +51,7 @@ namespace CLGMakeWriter
             CMakeWritter writer = new CMakeWritter();
             Dictionary<string, CProjFile> apps = new Dictionary<string, CProjFile>();
             apps.Add("CLGTest", new CProjFile("CLGTest", projCLGTestFilePath, projCLGTestPath));
+            apps.Add("CLGBench", new CProjFile("CLGBench", projCLGBenchFilePath, projCLGBenchPath));
             apps.Add("RotatingReproduce", new CProjFile("RotatingReproduce"));
             apps.Add("MatchingRho", new CProjFile("MatchingRho"));
             apps.Add("ConfigurationCompresser", new CProjFile("ConfigurationCompresser"));